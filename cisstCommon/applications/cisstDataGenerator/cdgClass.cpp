@@ -5,7 +5,7 @@
   Author(s):  Anton Deguet
   Created on: 2010-09-06
 
-  (C) Copyright 2010-2018 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2010-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
   --- begin cisst license - do not edit ---
 
@@ -286,6 +286,34 @@ void cdgClass::GenerateDataMethodsHeader(std::ostream & outputStream) const
                  << "    void DeSerializeTextJSON(const Json::Value & jsonValue) CISST_THROW(std::runtime_error);" << std::endl
                  << "#endif // CISST_HAS_JSON" << std::endl
                  << std::endl;
+
+    // binary size known at compile time if all data members and base classes have a fixed size
+    size_t index;
+    std::stringstream isFixed, byteSize;
+    isFixed << "true";
+    byteSize << "0";
+    for (index = 0; index < BaseClasses.size(); index++) {
+        if (BaseClasses[index]->GetFieldValue("is-data") == "true") {
+            const std::string type = BaseClasses[index]->GetFieldValue("type");
+            isFixed << " && cmnDataBinaryFixedSize<" << type << " >::IS_FIXED";
+            byteSize << " + cmnDataBinaryFixedSize<" << type << " >::BYTE_SIZE";
+        }
+    }
+    for (index = 0; index < Members.size(); index++) {
+        if (Members[index]->GetFieldValue("is-data") == "true") {
+            const std::string type = Members[index]->GetFieldValue("type");
+            isFixed << " && cmnDataBinaryFixedSize<" << type << " >::IS_FIXED";
+            byteSize << " + cmnDataBinaryFixedSize<" << type << " >::BYTE_SIZE";
+        }
+    }
+    outputStream << "    /* binary serialization for fixed size data, see cmnDataBinaryFixedSize */" << std::endl
+                 << " public:" << std::endl
+                 << "    enum {BINARY_IS_FIXED_SIZE = " << isFixed.str() << "};" << std::endl
+                 << "    enum {BINARY_FIXED_SIZE = BINARY_IS_FIXED_SIZE ? (" << byteSize.str() << ") : 0};" << std::endl
+                 << "    char * SerializeBinaryFixedSize(char * buffer) const;" << std::endl
+                 << "    const char * DeSerializeBinaryFixedSize(const char * buffer);" << std::endl
+                 << "    static const cmnDataBinaryLayout & BinaryLayout(void);" << std::endl
+                 << std::endl;
 }
 
 
@@ -506,6 +534,17 @@ void cdgClass::GenerateDataFunctionsHeader(std::ostream & outputStream) const
     const std::string name = this->ClassWithNamespace();
     const std::string attribute = this->GetFieldValue("attribute");
     outputStream << "/* data functions */" << std::endl
+                 << "template <> class cmnDataBinaryFixedSize<" << name << " > {" << std::endl
+                 << "public:" << std::endl
+                 << "    enum {IS_FIXED = " << name << "::BINARY_IS_FIXED_SIZE};" << std::endl
+                 << "    enum {BYTE_SIZE = " << name << "::BINARY_FIXED_SIZE};" << std::endl
+                 << "    inline static char * SerializeBinary(const " << name << " & data, char * buffer) {" << std::endl
+                 << "        return data.SerializeBinaryFixedSize(buffer);" << std::endl
+                 << "    }" << std::endl
+                 << "    inline static const char * DeSerializeBinary(" << name << " & data, const char * buffer) {" << std::endl
+                 << "        return data.DeSerializeBinaryFixedSize(buffer);" << std::endl
+                 << "    }" << std::endl
+                 << "};" << std::endl
                  << "template <> class cmnData<" << name << " > {" << std::endl
                  << "public: " << std::endl
                  << "    enum {IS_SPECIALIZED = 1};" << std::endl
@@ -522,6 +561,15 @@ void cdgClass::GenerateDataFunctionsHeader(std::ostream & outputStream) const
                  << "    static void DeSerializeBinary(DataType & data, std::istream & inputStream, const cmnDataFormat & localFormat, const cmnDataFormat & remoteFormat) CISST_THROW(std::runtime_error) {" << std::endl
                  << "        data.DeSerializeBinary(inputStream, localFormat, remoteFormat);" << std::endl
                  << "    }" << std::endl
+                 << "    static size_t SerializeBinaryByteSize(const DataType & data) {" << std::endl
+                 << "        return cmnDataBinaryFixedSizeDispatch<DataType>::SerializeBinaryByteSize(data);" << std::endl
+                 << "    }" << std::endl
+                 << "    static size_t SerializeBinary(const DataType & data, char * buffer, size_t bufferSize) {" << std::endl
+                 << "        return cmnDataBinaryFixedSizeDispatch<DataType>::SerializeBinary(data, buffer, bufferSize);" << std::endl
+                 << "    }" << std::endl
+                 << "    static size_t DeSerializeBinary(DataType & data, const char * buffer, size_t bufferSize, const cmnDataFormat & localFormat, const cmnDataFormat & remoteFormat) {" << std::endl
+                 << "        return cmnDataBinaryFixedSizeDispatch<DataType>::DeSerializeBinary(data, buffer, bufferSize, localFormat, remoteFormat);" << std::endl
+                 << "    }" << std::endl
                  << "    static void SerializeText(const DataType & data, std::ostream & outputStream, const char delimiter = ',') CISST_THROW(std::runtime_error) {" << std::endl
                  << "        data.SerializeText(outputStream, delimiter);" << std::endl
                  << "    }" << std::endl
@@ -597,6 +645,10 @@ void cdgClass::GenerateDataFunctionsCode(std::ostream & outputStream) const
 
 
     outputStream << "void " << className << "::SerializeBinary(std::ostream & " << CMN_UNUSED_wrapped("outputStream__cdg") << ") const CISST_THROW(std::runtime_error) {" << std::endl;
+    outputStream << SkipIfEmpty("    if (BINARY_IS_FIXED_SIZE) {\n"
+                                "        cmnDataBinaryFixedSizeDispatch<" + className + " >::SerializeBinary(*this, outputStream__cdg);\n"
+                                "        return;\n"
+                                "    }\n");
     for (index = 0; index < BaseClasses.size(); index++) {
         if (BaseClasses[index]->GetFieldValue("is-data") == "true") {
             type = BaseClasses[index]->GetFieldValue("type");
@@ -617,6 +669,11 @@ void cdgClass::GenerateDataFunctionsCode(std::ostream & outputStream) const
     outputStream << "void " << className << "::DeSerializeBinary(std::istream & " << CMN_UNUSED_wrapped("inputStream__cdg") << "," << std::endl
                  << "                                            const cmnDataFormat & " << CMN_UNUSED_wrapped("localFormat") << "," << std::endl
                  << "                                            const cmnDataFormat & " << CMN_UNUSED_wrapped("remoteFormat") << ") CISST_THROW(std::runtime_error) {"<< std::endl;
+    // memcpy only if the data has been serialized with the same format (endianness and size of size_t)
+    outputStream << SkipIfEmpty("    if (BINARY_IS_FIXED_SIZE && cmnDataBinaryFixedSizeCompatible(localFormat, remoteFormat)) {\n"
+                                "        cmnDataBinaryFixedSizeDispatch<" + className + " >::DeSerializeBinary(*this, inputStream__cdg);\n"
+                                "        return;\n"
+                                "    }\n");
     for (index = 0; index < BaseClasses.size(); index++) {
         if (BaseClasses[index]->GetFieldValue("is-data") == "true") {
             type = BaseClasses[index]->GetFieldValue("type");
@@ -638,6 +695,64 @@ void cdgClass::GenerateDataFunctionsCode(std::ostream & outputStream) const
 
 
 
+    outputStream << "char * " << className << "::SerializeBinaryFixedSize(char * buffer__cdg) const {" << std::endl;
+    for (index = 0; index < BaseClasses.size(); index++) {
+        if (BaseClasses[index]->GetFieldValue("is-data") == "true") {
+            type = BaseClasses[index]->GetFieldValue("type");
+            outputStream << "    buffer__cdg = cmnDataBinaryFixedSizeDispatch<" << type << " >::SerializeBinary(*this, buffer__cdg);" << std::endl;
+        }
+    }
+    for (index = 0; index < Members.size(); index++) {
+        if (Members[index]->GetFieldValue("is-data") == "true") {
+            type = Members[index]->GetFieldValue("type");
+            name = Members[index]->MemberName;
+            outputStream << "    buffer__cdg = cmnDataBinaryFixedSizeDispatch<" << type << " >::SerializeBinary(this->" << name << ", buffer__cdg);" << std::endl;
+        }
+    }
+    outputStream << "    return buffer__cdg;" << std::endl
+                 << "}" << std::endl;
+
+    outputStream << "const char * " << className << "::DeSerializeBinaryFixedSize(const char * buffer__cdg) {" << std::endl;
+    for (index = 0; index < BaseClasses.size(); index++) {
+        if (BaseClasses[index]->GetFieldValue("is-data") == "true") {
+            type = BaseClasses[index]->GetFieldValue("type");
+            outputStream << "    buffer__cdg = cmnDataBinaryFixedSizeDispatch<" << type << " >::DeSerializeBinary(*this, buffer__cdg);" << std::endl;
+        }
+    }
+    for (index = 0; index < Members.size(); index++) {
+        if (Members[index]->GetFieldValue("is-data") == "true") {
+            type = Members[index]->GetFieldValue("type");
+            name = Members[index]->MemberName;
+            outputStream << "    buffer__cdg = cmnDataBinaryFixedSizeDispatch<" << type << " >::DeSerializeBinary(this->" << name << ", buffer__cdg);" << std::endl;
+        }
+    }
+    outputStream << "    return buffer__cdg;" << std::endl
+                 << "}" << std::endl;
+
+    // layout is empty if the size is not fixed
+    outputStream << "const cmnDataBinaryLayout & " << className << "::BinaryLayout(void) {" << std::endl
+                 << "    static const cmnDataBinaryLayout layout__cdg = !BINARY_IS_FIXED_SIZE ? cmnDataBinaryLayout() :" << std::endl
+                 << "        cmnDataBinaryLayout()";
+    for (index = 0; index < BaseClasses.size(); index++) {
+        if (BaseClasses[index]->GetFieldValue("is-data") == "true") {
+            type = BaseClasses[index]->GetFieldValue("type");
+            outputStream << std::endl
+                         << "        .Add(\"" << type << "\", \"" << type << "\", cmnDataBinaryFixedSize<" << type << " >::BYTE_SIZE)";
+        }
+    }
+    for (index = 0; index < Members.size(); index++) {
+        if (Members[index]->GetFieldValue("is-data") == "true") {
+            type = Members[index]->GetFieldValue("type");
+            outputStream << std::endl
+                         << "        .Add(\"" << Members[index]->GetFieldValue("name") << "\", \"" << type << "\", cmnDataBinaryFixedSize<" << type << " >::BYTE_SIZE)";
+        }
+    }
+    outputStream << ";" << std::endl
+                 << "    return layout__cdg;" << std::endl
+                 << "}" << std::endl;
+
+
+
     outputStream << "void " << className << "::SerializeText(std::ostream & " << CMN_UNUSED_wrapped("outputStream__cdg")
                  << ", const char " << CMN_UNUSED_wrapped("delimiter__cdg") << ") const CISST_THROW(std::runtime_error) {" << std::endl;
     outputStream << SkipIfEmpty("    bool someData__cdg = false;\n");
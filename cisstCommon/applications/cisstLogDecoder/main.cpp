@@ -0,0 +1,78 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+
+*/
+
+#include <cisstCommon/cmnCommandLineOptions.h>
+#include <cisstCommon/cmnLogBinary.h>
+
+#include <fstream>
+#include <iostream>
+
+int main(int argc, char * argv[])
+{
+    cmnCommandLineOptions options;
+    std::string inputName;
+    options.AddOptionOneValue("i", "input", "binary log file",
+                              cmnCommandLineOptions::REQUIRED_OPTION, &inputName);
+    std::string outputName;
+    options.AddOptionOneValue("o", "output", "output file, standard output if not specified",
+                              cmnCommandLineOptions::OPTIONAL_OPTION, &outputName);
+    options.AddOptionNoValue("j", "json", "JSON output, one object per message");
+
+    std::string errorMessage;
+    if (!options.Parse(argc, argv, errorMessage)) {
+        std::cerr << "Error: " << errorMessage << std::endl;
+        options.PrintUsage(std::cerr);
+        return -1;
+    }
+
+    std::ifstream input(inputName.c_str(), std::ios::in | std::ios::binary);
+    if (!input.is_open()) {
+        std::cerr << "Error, can't open file (read mode) \"" << inputName << "\"" << std::endl;
+        return -1;
+    }
+
+    std::ofstream outputFile;
+    if (!outputName.empty()) {
+        outputFile.open(outputName.c_str());
+        if (!outputFile.is_open()) {
+            std::cerr << "Error, can't open file (write mode) \"" << outputName << "\"" << std::endl;
+            return -1;
+        }
+    }
+    std::ostream & output = outputName.empty() ? std::cout : outputFile;
+
+    const cmnLogBinaryDecoder::OutputFormatType format =
+        options.IsSet("json") ? cmnLogBinaryDecoder::JSON : cmnLogBinaryDecoder::TEXT;
+    cmnLogBinaryDecoder decoder(input);
+    if (!decoder.IsValid()) {
+        std::cerr << "Error, \"" << inputName << "\": " << decoder.GetError() << std::endl;
+        return -1;
+    }
+    cmnLogBinaryDecoder::Message message;
+    size_t numberOfMessages = 0;
+    while (decoder.Next(message)) {
+        cmnLogBinaryDecoder::ToStream(output, message, format);
+        numberOfMessages++;
+    }
+    if (!decoder.GetError().empty()) {
+        std::cerr << "Error, \"" << inputName << "\": " << decoder.GetError()
+                  << " after " << numberOfMessages << " message(s)" << std::endl;
+        return -1;
+    }
+    return 0;
+}
@@ -6,7 +6,7 @@
   Author(s):  Alvin Liem, Anton Deguet
   Created on: 2002-08-01
 
-  (C) Copyright 2002-2010 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2002-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -37,6 +37,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <sstream>
 #include <string>
 #include <map>
+#include <vector>
 #include <typeinfo>
 #include <fstream>
 
@@ -87,6 +88,14 @@ http://www.cisst.org/cisst/license.txt.
   implemented as a map of pointers to the cmnClassServices objects
   that exist.
 
+  Each class also gets a class identifier when registered (see
+  cmnClassServicesBase::GetClassId).  The identifiers are interned
+  indices in a table of class services so finding the class services
+  from an identifier is an array lookup.  Lookups by name or
+  std::type_info use hash indices built at registration time and
+  don't depend on the number of classes registered.  The class
+  identifiers are used by cmnSerializer and cmnDeSerializer.
+
   It is important to note that all classes to be registered will be
   registered by the time the <code>main()</code> function is called.
   Since we rely on the creation of global static objects for the
@@ -114,6 +123,34 @@ class CISST_EXPORT cmnClassRegister {
     /*! List of class services registered. */
     ServicesContainerType ServicesContainer;
 
+    /*! Class services indexed by class identifier, the first element
+      is null as 0 is not a valid identifier. */
+    typedef std::vector<cmnClassServicesBase *> ServicesByIdType;
+    ServicesByIdType ServicesById;
+
+    /*! Open addressing hash indices for the class names and the
+      type_info.  Each slot contains a class identifier or 0 if the
+      slot is empty.  The size of the indices is a power of 2 and
+      they are rebuilt when more than half full. */
+    //@{
+    typedef std::vector<size_t> IndexType;
+    IndexType NameIndex;
+    IndexType TypeInfoIndex;
+    //@}
+
+    /*! Names (keys of ServicesContainer) and hashes of the names
+      indexed by class identifier */
+    //@{
+    std::vector<const std::string *> NamesById;
+    std::vector<size_t> NameHashes;
+    //@}
+
+    /*! Add a class to the hash indices */
+    void AddToIndices(size_t classId);
+
+    /*! Rebuild the hash indices with the given number of slots */
+    void ResizeIndices(size_t numberOfSlots);
+
  public:
     /*!
       Instance specific implementation of FindClassServices.
@@ -129,6 +166,19 @@ class CISST_EXPORT cmnClassRegister {
     */
     cmnClassServicesBase * FindClassServicesInstance(const std::type_info & typeInfo);
 
+    /*!
+      Instance specific implementation of FindClassServices.
+
+      \sa FindClassServices
+    */
+    inline cmnClassServicesBase * FindClassServicesInstance(size_t classId) const {
+        return (classId < ServicesById.size()) ? ServicesById[classId] : 0;
+    }
+
+    /*! Instance specific implementation of GetClassId.
+      \sa GetClassId */
+    size_t GetClassIdInstance(const std::string & className);
+
     /*! Instance specific implementation of Register.
       \sa Register */
     const std::string *
@@ -172,7 +222,11 @@ class CISST_EXPORT cmnClassRegister {
 protected:
     /*! Constructor.  The only constructor must be private in order to
       ensure that the class register is a singleton. */
-    inline cmnClassRegister(void) {};
+    inline cmnClassRegister(void):
+        ServicesById(1, static_cast<cmnClassServicesBase *>(0)),
+        NamesById(1, static_cast<const std::string *>(0)),
+        NameHashes(1, 0)
+    {};
 
  public:
 
@@ -293,6 +347,29 @@ protected:
         return Instance()->FindClassServicesInstance(typeInfo);
     }
 
+    /*! Get the class services by class identifier (see
+      cmnClassServicesBase::GetClassId).  Returns null if the
+      identifier is not valid.
+
+      \param classId The class identifier to look up.
+
+      \return The pointer to the cmnClassServicesBase object
+      corresponding to the class identifier, or null if not
+      registered.
+    */
+    static inline cmnClassServicesBase * FindClassServices(size_t classId) {
+        return Instance()->FindClassServicesInstance(classId);
+    }
+
+    /*! Get the class identifier for a class name.  Returns 0 if the
+      class is not registered.
+
+      \param className The name to look up.
+    */
+    static inline size_t GetClassId(const std::string & className) {
+        return Instance()->GetClassIdInstance(className);
+    }
+
 
     /*! Dynamic creation of objects using the default constructor.
 
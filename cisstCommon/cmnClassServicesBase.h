@@ -6,7 +6,7 @@
   Author(s):  Anton Deguet, Peter Kazanzides
   Created on: 2004-08-18
 
-  (C) Copyright 2004-2012 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -44,6 +44,9 @@ http://www.cisst.org/cisst/license.txt.
 */
 class CISST_EXPORT cmnClassServicesBase
 {
+    /*! The class register sets the class identifier */
+    friend class cmnClassRegister;
+
  public:
      /*! Type used to refer to cmnGenericObject by pointer, convenient to
       pass a pointer by reference */
@@ -147,6 +150,18 @@ class CISST_EXPORT cmnClassServicesBase
     */
     const std::string & GetName(void) const;
 
+    /*! Get the class identifier assigned by the class register.  The
+      identifiers are small integers, starting at 1 and in the order
+      of registration, which can be used to retrieve the class
+      services with cmnClassRegister::FindClassServices.  Returns 0
+      if the class couldn't be registered.
+
+      \return The class identifier.
+    */
+    inline size_t GetClassId(void) const {
+        return ClassIdMember;
+    }
+
     /*!
       Get the type_info corresponding to the registered class.
 
@@ -194,6 +209,9 @@ private:
     /*! The name of the class. */
     const std::string * NameMember;
 
+    /*! The class identifier, 0 until registered. */
+    size_t ClassIdMember;
+
     const std::type_info * TypeInfoMember;
 
     /*! Class services of parent class (0 if no parent, or not known) */
@@ -0,0 +1,253 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#pragma once
+#ifndef _cmnDataBinaryWriter_h
+#define _cmnDataBinaryWriter_h
+
+#include <cisstCommon/cmnPortability.h>
+#include <cisstCommon/cmnDataFunctions.h>
+
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// always include last
+#include <cisstCommon/cmnExport.h>
+
+/*!
+  \brief Scatter/gather buffer for binary serialization
+  \ingroup cisstCommon
+
+  This class collects the binary serialization (see
+  cmnData::SerializeBinary) of multiple data objects as a list of
+  memory segments, similar to the <code>iovec</code> used by
+  <code>writev</code> and <code>sendmsg</code>.  Small values (sizes,
+  scalars, headers...) are serialized in memory blocks owned by the
+  writer.  Large contiguous blocks of native values (e.g. compact
+  vectors and matrices of doubles) are referenced rather than copied.
+  The result can be sent directly using osaSocket::Send or copied to
+  a single buffer.
+
+  \code
+  cmnDataBinaryWriter writer;
+  writer.SerializeBinary(timestamp);
+  writer.SerializeBinary(largeVector); // referenced, not copied
+  socket.Send(writer);
+  writer.Reset(); // memory blocks are kept for the next message
+  \endcode
+
+  The bytes produced are the same as the ones produced by
+  cmnData::SerializeBinary using a std::ostream.  Since referenced
+  data is not copied, the data objects serialized must not be
+  modified or destroyed until the writer has been used (sent or
+  copied) or reset.
+
+  Data types are serialized using cmnDataBinaryGather, the default
+  implementation uses cmnData::SerializeBinaryByteSize and
+  cmnData::SerializeBinary with a char buffer.
+*/
+class CISST_EXPORT cmnDataBinaryWriter
+{
+public:
+    /*! Memory segment */
+    class Segment {
+    public:
+        const char * Data;
+        size_t Size;
+    };
+
+    typedef std::vector<Segment> SegmentsType;
+
+    /*! Constructor.  The block size is the size of the memory blocks
+      used to serialize small values.  Segments smaller than the
+      reference threshold are copied. */
+    cmnDataBinaryWriter(size_t blockSize = 4096, size_t referenceThreshold = 256);
+
+    /*! Destructor, releases the memory blocks */
+    ~cmnDataBinaryWriter();
+
+    /*! Remove all segments.  Memory blocks are kept for reuse. */
+    void Reset(void);
+
+    /*! Allocate some contiguous memory at the end of the writer.
+      The caller must fill the memory before the writer is used. */
+    char * Allocate(size_t size);
+
+    /*! Copy some memory at the end of the writer */
+    inline void Copy(const void * data, size_t size) {
+        if (size > 0) {
+            memcpy(Allocate(size), data, size);
+        }
+    }
+
+    /*! Add a reference to some memory, the memory is copied if its
+      size is below the reference threshold. */
+    void Reference(const void * data, size_t size);
+
+    /*! Serialize a data object in binary format, see
+      cmnDataBinaryGather. */
+    template <class _dataType>
+    inline void SerializeBinary(const _dataType & data);
+
+    /*! Total number of bytes */
+    inline size_t GetSize(void) const {
+        return this->Size;
+    }
+
+    /*! List of segments */
+    inline const SegmentsType & GetSegments(void) const {
+        return this->Segments;
+    }
+
+    /*! Number of bytes referenced, i.e. not copied */
+    inline size_t GetReferencedSize(void) const {
+        return this->ReferencedSize;
+    }
+
+    /*! Copy all segments in a buffer.  Returns the number of bytes
+      copied or 0 if the buffer is too small. */
+    size_t CopyTo(char * buffer, size_t bufferSize) const;
+
+    /*! Copy all segments in a string */
+    void ToString(std::string & result) const;
+
+protected:
+    class Block {
+    public:
+        char * Data;
+        size_t Capacity;
+    };
+    typedef std::vector<Block> BlocksType;
+
+    size_t BlockSize;
+    size_t ReferenceThreshold;
+    BlocksType Blocks;
+    /*! Block used for the next allocation and bytes used in it */
+    size_t CurrentBlock;
+    size_t CurrentBlockUsed;
+    /*! True if the last segment is at the end of the current block */
+    bool LastSegmentInBlock;
+
+    SegmentsType Segments;
+    size_t Size;
+    size_t ReferencedSize;
+
+private:
+    cmnDataBinaryWriter(const cmnDataBinaryWriter & other);
+    cmnDataBinaryWriter & operator = (const cmnDataBinaryWriter & other);
+};
+
+
+/*! \brief Binary serialization of a data type using a cmnDataBinaryWriter
+
+  The default implementation serializes the data object in memory
+  allocated by the writer using cmnData::SerializeBinaryByteSize and
+  cmnData::SerializeBinary with a char buffer.  This class can be
+  specialized for types with a contiguous memory representation to
+  reference the memory instead of copying it (see the specializations
+  for std::vector and the cisstVector containers). */
+template <class _dataType>
+class cmnDataBinaryGather
+{
+public:
+    static void SerializeBinary(cmnDataBinaryWriter & writer, const _dataType & data) {
+        const size_t size = cmnData<_dataType>::SerializeBinaryByteSize(data);
+        if (size > 0) {
+            cmnData<_dataType>::SerializeBinary(data, writer.Allocate(size), size);
+        }
+    }
+};
+
+
+/*! Helper for contiguous containers.  If the elements are native
+  numbers (except bool), the memory is referenced.  Otherwise, each
+  element is serialized using cmnDataBinaryGather. */
+//@{
+template <class _elementType, bool _isRaw = (std::is_arithmetic<_elementType>::value
+                                             && !std::is_same<_elementType, bool>::value)>
+class cmnDataBinaryGatherElements
+{
+public:
+    template <class _iteratorType>
+    static void SerializeBinary(cmnDataBinaryWriter & writer,
+                                _iteratorType begin, const _iteratorType end,
+                                const _elementType * CMN_UNUSED(contiguous)) {
+        for (; begin != end; ++begin) {
+            cmnDataBinaryGather<_elementType>::SerializeBinary(writer, *begin);
+        }
+    }
+};
+
+template <class _elementType>
+class cmnDataBinaryGatherElements<_elementType, true>
+{
+public:
+    /*! Reference the memory if the elements are contiguous (pointer
+      not null), otherwise copy the elements one by one. */
+    template <class _iteratorType>
+    static void SerializeBinary(cmnDataBinaryWriter & writer,
+                                _iteratorType begin, const _iteratorType end,
+                                const _elementType * contiguous) {
+        if (contiguous) {
+            writer.Reference(contiguous, (end - begin) * sizeof(_elementType));
+            return;
+        }
+        _elementType * buffer = reinterpret_cast<_elementType *>(writer.Allocate((end - begin) * sizeof(_elementType)));
+        for (; begin != end; ++begin, ++buffer) {
+            memcpy(buffer, &(*begin), sizeof(_elementType));
+        }
+    }
+};
+//@}
+
+
+template <class _elementType>
+class cmnDataBinaryGather<std::vector<_elementType> >
+{
+public:
+    typedef std::vector<_elementType> DataType;
+    static void SerializeBinary(cmnDataBinaryWriter & writer, const DataType & data) {
+        cmnDataBinaryGather<size_t>::SerializeBinary(writer, data.size());
+        cmnDataBinaryGatherElements<_elementType>::SerializeBinary(writer, data.begin(), data.end(),
+                                                                   data.empty() ? 0 : &(data[0]));
+    }
+};
+
+/*! std::vector<bool> is not contiguous */
+template <>
+class cmnDataBinaryGather<std::vector<bool> >
+{
+public:
+    typedef std::vector<bool> DataType;
+    static void SerializeBinary(cmnDataBinaryWriter & writer, const DataType & data) {
+        cmnDataBinaryGather<size_t>::SerializeBinary(writer, data.size());
+        const size_t size = data.size();
+        for (size_t index = 0; index < size; ++index) {
+            cmnDataBinaryGather<bool>::SerializeBinary(writer, data[index]);
+        }
+    }
+};
+
+
+template <class _dataType>
+inline void cmnDataBinaryWriter::SerializeBinary(const _dataType & data) {
+    cmnDataBinaryGather<_dataType>::SerializeBinary(*this, data);
+}
+
+#endif // _cmnDataBinaryWriter_h
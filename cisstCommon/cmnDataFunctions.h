@@ -5,7 +5,7 @@
   Author(s):  Anton Deguet
   Created on: 2011-06-27
 
-  (C) Copyright 2011-2018 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2011-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -210,4 +210,7 @@ void CISST_EXPORT cmnDataDeSerializeBinary_size_t(size_t & data,
 void CISST_EXPORT cmnDataDeSerializeTextDelimiter(std::istream & inputStream, const char delimiter, const char * className)
     CISST_THROW(std::runtime_error);
 
+// compile time binary size for fixed size types
+#include <cisstCommon/cmnDataFunctionsFixedSize.h>
+
 #endif // _cmnDataFunctions_h
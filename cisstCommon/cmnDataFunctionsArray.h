@@ -5,7 +5,7 @@
   Author(s):  Anton Deguet
   Created on: 2011-06-27
 
-  (C) Copyright 2011-2018 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2011-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -175,4 +175,20 @@ public:
     }
 };
 
+template <class _elementType, size_t _size>
+class cmnDataBinaryFixedSize<_elementType[_size]>
+{
+public:
+    enum {IS_FIXED = cmnDataBinaryFixedSize<_elementType>::IS_FIXED};
+    enum {BYTE_SIZE = _size * cmnDataBinaryFixedSize<_elementType>::BYTE_SIZE};
+
+    static char * SerializeBinary(const _elementType * data, char * buffer) {
+        return cmnDataBinaryFixedSizeElements<_elementType>::SerializeBinary(data, _size, buffer);
+    }
+
+    static const char * DeSerializeBinary(_elementType * data, const char * buffer) {
+        return cmnDataBinaryFixedSizeElements<_elementType>::DeSerializeBinary(data, _size, buffer);
+    }
+};
+
 #endif // _cmnDataFunctionsArray_h
@@ -0,0 +1,337 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#pragma once
+#ifndef _cmnDataFunctionsFixedSize_h
+#define _cmnDataFunctionsFixedSize_h
+
+#include <cisstCommon/cmnDataFunctions.h>
+
+#include <string.h> // for memcpy
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/*!
+  \brief Binary serialization of data types with a fixed size
+  \ingroup cisstCommon
+
+  For some data types, the number of bytes produced by
+  cmnData::SerializeBinary doesn't depend on the content of the data
+  object (native types, fixed size vectors and matrices of native
+  types...).  For these types, this class provides the size at
+  compile time as well as methods to serialize and de-serialize using
+  a char buffer without any size check.  Contiguous blocks of native
+  values are copied using a single memcpy.
+
+  By default, data types don't have a fixed size.  To add a fixed size
+  data type, specialize this class with the enums IS_FIXED and
+  BYTE_SIZE and the static methods:
+  \code
+  static char * SerializeBinary(const DataType & data, char * buffer);
+  static const char * DeSerializeBinary(DataType & data, const char * buffer);
+  \endcode
+  Both methods return the position in the buffer after the data
+  object.  The bytes must be the same as the ones produced by
+  cmnData::SerializeBinary.
+
+  The classes generated by cisstDataGenerator provide a specialization
+  based on their data members and base classes.
+*/
+template <class _dataType>
+class cmnDataBinaryFixedSize
+{
+public:
+    enum {IS_FIXED = 0};
+    enum {BYTE_SIZE = 0};
+};
+
+#define CMN_DATA_BINARY_FIXED_SIZE_NATIVE(_type)                        \
+    template <>                                                         \
+    class cmnDataBinaryFixedSize<_type>                                 \
+    {                                                                   \
+    public:                                                             \
+        enum {IS_FIXED = 1};                                            \
+        enum {BYTE_SIZE = sizeof(_type)};                               \
+        inline static char * SerializeBinary(const _type & data, char * buffer) { \
+            memcpy(buffer, &data, sizeof(_type));                       \
+            return buffer + sizeof(_type);                              \
+        }                                                               \
+        inline static const char * DeSerializeBinary(_type & data, const char * buffer) { \
+            memcpy(&data, buffer, sizeof(_type));                       \
+            return buffer + sizeof(_type);                              \
+        }                                                               \
+    };
+
+CMN_DATA_BINARY_FIXED_SIZE_NATIVE(bool);
+CMN_DATA_BINARY_FIXED_SIZE_NATIVE(char);
+CMN_DATA_BINARY_FIXED_SIZE_NATIVE(unsigned char);
+CMN_DATA_BINARY_FIXED_SIZE_NATIVE(short);
+CMN_DATA_BINARY_FIXED_SIZE_NATIVE(unsigned short);
+CMN_DATA_BINARY_FIXED_SIZE_NATIVE(int);
+CMN_DATA_BINARY_FIXED_SIZE_NATIVE(unsigned int);
+CMN_DATA_BINARY_FIXED_SIZE_NATIVE(long int);
+CMN_DATA_BINARY_FIXED_SIZE_NATIVE(unsigned long int);
+CMN_DATA_BINARY_FIXED_SIZE_NATIVE(long long int);
+CMN_DATA_BINARY_FIXED_SIZE_NATIVE(unsigned long long int);
+CMN_DATA_BINARY_FIXED_SIZE_NATIVE(float);
+CMN_DATA_BINARY_FIXED_SIZE_NATIVE(double);
+
+
+/*! Helper for contiguous elements of a fixed size type.  If the
+  elements are native types, a single memcpy is used. */
+//@{
+template <class _elementType, bool _isNative = std::is_arithmetic<_elementType>::value>
+class cmnDataBinaryFixedSizeElements
+{
+public:
+    static char * SerializeBinary(const _elementType * data, size_t size, char * buffer) {
+        for (size_t index = 0; index < size; ++index) {
+            buffer = cmnDataBinaryFixedSize<_elementType>::SerializeBinary(data[index], buffer);
+        }
+        return buffer;
+    }
+
+    static const char * DeSerializeBinary(_elementType * data, size_t size, const char * buffer) {
+        for (size_t index = 0; index < size; ++index) {
+            buffer = cmnDataBinaryFixedSize<_elementType>::DeSerializeBinary(data[index], buffer);
+        }
+        return buffer;
+    }
+};
+
+template <class _elementType>
+class cmnDataBinaryFixedSizeElements<_elementType, true>
+{
+public:
+    static char * SerializeBinary(const _elementType * data, size_t size, char * buffer) {
+        memcpy(buffer, data, size * sizeof(_elementType));
+        return buffer + size * sizeof(_elementType);
+    }
+
+    static const char * DeSerializeBinary(_elementType * data, size_t size, const char * buffer) {
+        memcpy(data, buffer, size * sizeof(_elementType));
+        return buffer + size * sizeof(_elementType);
+    }
+};
+//@}
+
+
+/*! Returns true if data serialized with the remote format can be
+  de-serialized using a memcpy, i.e. both formats have the same
+  endianness, word size and size of size_t.  If not, the per element
+  de-serialization must be used to swap bytes and convert size_t. */
+inline bool cmnDataBinaryFixedSizeCompatible(const cmnDataFormat & localFormat,
+                                             const cmnDataFormat & remoteFormat)
+{
+    return ((localFormat.GetEndianness() == remoteFormat.GetEndianness())
+            && (localFormat.GetWordSize() == remoteFormat.GetWordSize())
+            && (localFormat.GetSizeTSize() == remoteFormat.GetSizeTSize()));
+}
+
+
+/*! Dispatch between the fixed size implementation and the default
+  cmnData implementation.  The buffer based methods have the same
+  semantic as the cmnData ones.  For types without a fixed size, they
+  use a std::stringstream and cmnData::SerializeBinary.  The stream
+  based methods can only be used with fixed size types and throw an
+  exception otherwise. */
+//@{
+template <class _dataType, bool _isFixed = (cmnDataBinaryFixedSize<_dataType>::IS_FIXED != 0)>
+class cmnDataBinaryFixedSizeDispatch
+{
+public:
+    static char * SerializeBinary(const _dataType & CMN_UNUSED(data), char * CMN_UNUSED(buffer))
+        CISST_THROW(std::runtime_error)
+    {
+        cmnThrow("cmnDataBinaryFixedSizeDispatch::SerializeBinary: data type doesn't have a fixed size");
+        return 0;
+    }
+
+    static const char * DeSerializeBinary(_dataType & CMN_UNUSED(data), const char * CMN_UNUSED(buffer))
+        CISST_THROW(std::runtime_error)
+    {
+        cmnThrow("cmnDataBinaryFixedSizeDispatch::DeSerializeBinary: data type doesn't have a fixed size");
+        return 0;
+    }
+
+    static void SerializeBinary(const _dataType & CMN_UNUSED(data), std::ostream & CMN_UNUSED(outputStream))
+        CISST_THROW(std::runtime_error)
+    {
+        cmnThrow("cmnDataBinaryFixedSizeDispatch::SerializeBinary: data type doesn't have a fixed size");
+    }
+
+    static void DeSerializeBinary(_dataType & CMN_UNUSED(data), std::istream & CMN_UNUSED(inputStream))
+        CISST_THROW(std::runtime_error)
+    {
+        cmnThrow("cmnDataBinaryFixedSizeDispatch::DeSerializeBinary: data type doesn't have a fixed size");
+    }
+
+    static size_t SerializeBinaryByteSize(const _dataType & data) {
+        std::stringstream stream;
+        cmnData<_dataType>::SerializeBinary(data, stream);
+        return stream.str().size();
+    }
+
+    static size_t SerializeBinary(const _dataType & data, char * buffer, size_t bufferSize) {
+        std::stringstream stream;
+        cmnData<_dataType>::SerializeBinary(data, stream);
+        const std::string serialized = stream.str();
+        if (bufferSize < serialized.size()) {
+            return 0;
+        }
+        memcpy(buffer, serialized.data(), serialized.size());
+        return serialized.size();
+    }
+
+    static size_t DeSerializeBinary(_dataType & data, const char * buffer, size_t bufferSize,
+                                    const cmnDataFormat & localFormat,
+                                    const cmnDataFormat & remoteFormat) {
+        std::stringstream stream(std::string(buffer, bufferSize));
+        try {
+            cmnData<_dataType>::DeSerializeBinary(data, stream, localFormat, remoteFormat);
+        } catch (std::runtime_error &) {
+            return 0;
+        }
+        return static_cast<size_t>(stream.tellg());
+    }
+};
+
+template <class _dataType>
+class cmnDataBinaryFixedSizeDispatch<_dataType, true>
+{
+public:
+    typedef cmnDataBinaryFixedSize<_dataType> FixedSizeType;
+
+    inline static char * SerializeBinary(const _dataType & data, char * buffer) {
+        return FixedSizeType::SerializeBinary(data, buffer);
+    }
+
+    inline static const char * DeSerializeBinary(_dataType & data, const char * buffer) {
+        return FixedSizeType::DeSerializeBinary(data, buffer);
+    }
+
+    static void SerializeBinary(const _dataType & data, std::ostream & outputStream)
+        CISST_THROW(std::runtime_error)
+    {
+        char buffer[FixedSizeType::BYTE_SIZE + 1];
+        FixedSizeType::SerializeBinary(data, buffer);
+        outputStream.write(buffer, FixedSizeType::BYTE_SIZE);
+        if (outputStream.fail()) {
+            cmnThrow("cmnDataBinaryFixedSizeDispatch::SerializeBinary: error occured with std::ostream::write");
+        }
+    }
+
+    static void DeSerializeBinary(_dataType & data, std::istream & inputStream)
+        CISST_THROW(std::runtime_error)
+    {
+        char buffer[FixedSizeType::BYTE_SIZE + 1];
+        inputStream.read(buffer, FixedSizeType::BYTE_SIZE);
+        if (inputStream.fail()) {
+            cmnThrow("cmnDataBinaryFixedSizeDispatch::DeSerializeBinary: error occured with std::istream::read");
+        }
+        FixedSizeType::DeSerializeBinary(data, buffer);
+    }
+
+    inline static size_t SerializeBinaryByteSize(const _dataType & CMN_UNUSED(data)) {
+        return FixedSizeType::BYTE_SIZE;
+    }
+
+    static size_t SerializeBinary(const _dataType & data, char * buffer, size_t bufferSize) {
+        if (bufferSize < static_cast<size_t>(FixedSizeType::BYTE_SIZE)) {
+            return 0;
+        }
+        FixedSizeType::SerializeBinary(data, buffer);
+        return FixedSizeType::BYTE_SIZE;
+    }
+
+    static size_t DeSerializeBinary(_dataType & data, const char * buffer, size_t bufferSize,
+                                    const cmnDataFormat & localFormat,
+                                    const cmnDataFormat & remoteFormat) {
+        if (!cmnDataBinaryFixedSizeCompatible(localFormat, remoteFormat)) {
+            return cmnDataBinaryFixedSizeDispatch<_dataType, false>::DeSerializeBinary(data, buffer, bufferSize,
+                                                                                       localFormat, remoteFormat);
+        }
+        if (bufferSize < static_cast<size_t>(FixedSizeType::BYTE_SIZE)) {
+            return 0;
+        }
+        FixedSizeType::DeSerializeBinary(data, buffer);
+        return FixedSizeType::BYTE_SIZE;
+    }
+};
+//@}
+
+
+/*! Description of a field in the binary serialization of a fixed
+  size data type, see cmnDataBinaryLayout */
+class cmnDataBinaryField
+{
+public:
+    std::string Name;
+    std::string Type;
+    /*! Position of the first byte from the beginning of the data
+      object */
+    size_t Offset;
+    size_t Size;
+};
+
+/*! Layout of the binary serialization of a fixed size data type.
+  This allows to read fields directly from a buffer without
+  de-serializing the whole data object.  Fields are stored using the
+  endianness of the sender (see cmnDataFormat).  The classes generated
+  by cisstDataGenerator provide their layout with the static method
+  BinaryLayout.  The layout is empty if the type doesn't have a fixed
+  size. */
+class cmnDataBinaryLayout
+{
+public:
+    typedef std::vector<cmnDataBinaryField> FieldsType;
+
+    inline cmnDataBinaryLayout(void):
+        ByteSize(0)
+    {}
+
+    /*! Add a field after the last one */
+    inline cmnDataBinaryLayout & Add(const std::string & name, const std::string & type, size_t size) {
+        cmnDataBinaryField field;
+        field.Name = name;
+        field.Type = type;
+        field.Offset = ByteSize;
+        field.Size = size;
+        Fields.push_back(field);
+        ByteSize += size;
+        return *this;
+    }
+
+    /*! Find a field by name, returns 0 if not found */
+    inline const cmnDataBinaryField * Find(const std::string & name) const {
+        const FieldsType::const_iterator end = Fields.end();
+        FieldsType::const_iterator field;
+        for (field = Fields.begin(); field != end; ++field) {
+            if (field->Name == name) {
+                return &(*field);
+            }
+        }
+        return 0;
+    }
+
+    FieldsType Fields;
+    size_t ByteSize;
+};
+
+#endif // _cmnDataFunctionsFixedSize_h
@@ -5,7 +5,7 @@
   Author(s):  Anton Deguet
   Created on: 2012-07-09
 
-  (C) Copyright 2012-2018 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2012-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -181,6 +181,39 @@ void cmnDataMatrixSerializeBinary(const _matrixType & data,
     }
 }
 
+template <class _matrixType>
+size_t cmnDataMatrixSerializeBinaryByteSize(const _matrixType & data)
+{
+    typedef typename _matrixType::const_iterator const_iterator;
+    const const_iterator end = data.end();
+    const_iterator iter = data.begin();
+    size_t result = 0;
+    for (; iter != end; ++iter) {
+        result += cmnData<typename _matrixType::value_type>::SerializeBinaryByteSize(*iter);
+    }
+    return result;
+}
+
+template <class _matrixType>
+size_t cmnDataMatrixSerializeBinary(const _matrixType & data,
+                                    char * buffer, size_t bufferSize)
+{
+    typedef typename _matrixType::const_iterator const_iterator;
+    const const_iterator end = data.end();
+    const_iterator iter = data.begin();
+    size_t result = 0;
+    for (; iter != end; ++iter) {
+        const size_t size = cmnData<typename _matrixType::value_type>::SerializeBinary(*iter, buffer, bufferSize);
+        if (size == 0) {
+            return 0;
+        }
+        buffer += size;
+        bufferSize -= size;
+        result += size;
+    }
+    return result;
+}
+
 template <class _matrixType>
 void cmnDataMatrixDeSerializeBinary(_matrixType & data,
                                     std::istream & inputStream,
@@ -5,7 +5,7 @@
   Author(s):  Anton Deguet
   Created on: 2011-06-27
 
-  (C) Copyright 2011-2018 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2011-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -79,6 +79,21 @@ public:
         cmnDataVectorSerializeBinary(data, outputStream);
     }
 
+    static size_t SerializeBinaryByteSize(const DataType & data)
+    {
+        return cmnData<size_t>::SerializeBinaryByteSize(data.size())
+            + cmnDataVectorSerializeBinaryByteSize(data);
+    }
+
+    static size_t SerializeBinary(const DataType & data, char * buffer, size_t bufferSize)
+    {
+        if (bufferSize < SerializeBinaryByteSize(data)) {
+            return 0;
+        }
+        const size_t sizeOfSize = cmnData<size_t>::SerializeBinary(data.size(), buffer, bufferSize);
+        return sizeOfSize + cmnDataVectorSerializeBinary(data, buffer + sizeOfSize, bufferSize - sizeOfSize);
+    }
+
     static void DeSerializeBinary(DataType & data,
                                   std::istream & inputStream,
                                   const cmnDataFormat & localFormat,
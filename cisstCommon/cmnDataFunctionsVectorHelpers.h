@@ -5,7 +5,7 @@
   Author(s):  Anton Deguet
   Created on: 2012-07-09
 
-  (C) Copyright 2012-2018 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2012-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -164,6 +164,39 @@ void cmnDataVectorSerializeBinary(const _vectorType & data,
     }
 }
 
+template <class _vectorType>
+size_t cmnDataVectorSerializeBinaryByteSize(const _vectorType & data)
+{
+    typedef typename _vectorType::const_iterator const_iterator;
+    const const_iterator end = data.end();
+    const_iterator iter = data.begin();
+    size_t result = 0;
+    for (; iter != end; ++iter) {
+        result += cmnData<typename _vectorType::value_type>::SerializeBinaryByteSize(*iter);
+    }
+    return result;
+}
+
+template <class _vectorType>
+size_t cmnDataVectorSerializeBinary(const _vectorType & data,
+                                    char * buffer, size_t bufferSize)
+{
+    typedef typename _vectorType::const_iterator const_iterator;
+    const const_iterator end = data.end();
+    const_iterator iter = data.begin();
+    size_t result = 0;
+    for (; iter != end; ++iter) {
+        const size_t size = cmnData<typename _vectorType::value_type>::SerializeBinary(*iter, buffer, bufferSize);
+        if (size == 0) {
+            return 0;
+        }
+        buffer += size;
+        bufferSize -= size;
+        result += size;
+    }
+    return result;
+}
+
 template <class _vectorType>
 void cmnDataVectorDeSerializeBinary(_vectorType & data,
                                     std::istream & inputStream,
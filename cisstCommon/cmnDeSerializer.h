@@ -6,7 +6,7 @@
   Author(s):  Anton Deguet, Min Yang Jung
   Created on: 2007-04-08
 
-  (C) Copyright 2007-2013 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2007-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -38,6 +38,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <string>
 #include <fstream>
 #include <map>
+#include <vector>
 #include <cstddef>
 
 #include <cisstCommon/cmnExport.h>
@@ -165,9 +166,13 @@ inline void cmnDeSerializeRaw(std::istream & inputStream, std::vector<_elementTy
   cmnSerializer.
 
   As each object serialized is identified by a unique class identifer
-  defined at runtime (address of the object cmnClassServices), this
+  defined at runtime (see cmnClassServicesBase::GetClassId), this
   class maintains a table of equivalence between the remote class
-  identifiers and local class identifiers.  This class can be used to
+  identifiers and local class services.  The remote identifiers are
+  small integers so the table is an array indexed by remote
+  identifier and the class name is only looked up once per class.
+  Large identifiers (older versions used the address of the
+  cmnClassServices object) are stored in a map.  This class can be used to
   read both the class information and objects in any order as long as
   the class information for a specific object has been received before
   the object itself.
@@ -241,12 +246,10 @@ public:
                 this->DeSerialize(object);
             }
         } else {
-            const const_iterator end = ServicesContainer.end();
-            const const_iterator iterator = ServicesContainer.find(typeId);
-            if (iterator == end) {
+            cmnClassServicesBase * servicesPointerLocal = this->FindServices(typeId);
+            if (servicesPointerLocal == 0) {
                 cmnThrow("DeSerialize: Can't find corresponding class information");
             } else {
-                cmnClassServicesBase * servicesPointerLocal = iterator->second;
                 if (servicesPointerLocal != object.Services()) {
                     CMN_LOG_CLASS_RUN_ERROR << "DeSerialize: Object types don't match, local class = "
                         << servicesPointerLocal->GetName() << ", object class = " << object.Services()->GetName()
@@ -278,8 +281,25 @@ public:
      */
     void DeSerializeServices(void) CISST_THROW(std::runtime_error);
 
+    /*! Find the local class services for a remote type identifier,
+      returns 0 if the class information hasn't been received. */
+    inline cmnClassServicesBase * FindServices(const TypeId typeId) const {
+        if ((typeId > 0) && (typeId < MAXIMUM_INDEXED_TYPE_ID)) {
+            return (typeId < static_cast<TypeId>(ServicesById.size())) ? ServicesById[static_cast<size_t>(typeId)] : 0;
+        }
+        const const_iterator iterator = ServicesContainer.find(typeId);
+        return (iterator == ServicesContainer.end()) ? 0 : iterator->second;
+    }
+
     std::istream & InputStream;
 
+    /*! Remote identifiers smaller than this are stored in
+      ServicesById, others in ServicesContainer */
+    enum {MAXIMUM_INDEXED_TYPE_ID = 65536};
+
+    typedef std::vector<cmnClassServicesBase *> ServicesByIdType;
+    ServicesByIdType ServicesById;
+
     typedef std::map<TypeId, cmnClassServicesBase *> ServicesContainerType;
     typedef ServicesContainerType::value_type EntryType;
 
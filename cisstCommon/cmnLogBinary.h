@@ -0,0 +1,374 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Compact binary log records and decoder
+  \ingroup cisstCommon
+*/
+#pragma once
+
+#ifndef _cmnLogBinary_h
+#define _cmnLogBinary_h
+
+#include <cisstCommon/cmnPortability.h>
+#include <cisstCommon/cmnLogLoD.h>
+#include <cisstCommon/cmnLogger.h>
+
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+// Always include last
+#include <cisstCommon/cmnExport.h>
+
+/*! This macro is used to log a message in binary format.  The format
+  string follows the printf syntax and the arguments can be numbers,
+  characters, strings (const char * or std::string) and pointers:
+
+  \code
+  CMN_LOG_BINARY(CMN_LOG_LEVEL_RUN_DEBUG, "joint %d: position %f", index, position);
+  \endcode
+
+  Each call site is described once by a static cmnLogBinarySite
+  (file, line, level of detail and format) and the records only
+  contain the raw bytes of the arguments.  The text is never formatted
+  by the caller, it is created offline using cmnLogBinaryDecoder (see
+  the cisstLogDecoder application).
+
+  The message is filtered using the overall and function masks (see
+  #CMN_LOG) and is only sent if a binary sink has been provided to
+  cmnLogger (see cmnLogger::SetBinarySink and
+  osaAsynchronousLogger::OpenBinaryFile). */
+#define CMN_LOG_BINARY(lod, format, ...)                                \
+    do {                                                                \
+        cmnLogBinarySink * _cmnLogBinarySink = cmnLogger::GetBinarySink(); \
+        if (_cmnLogBinarySink                                           \
+            && (cmnLogger::GetMask() & cmnLogger::GetMaskFunction() & lod)) { \
+            static const cmnLogBinarySite _cmnLogBinarySite = {__FILE__, __LINE__, lod, format}; \
+            cmnLogBinaryWrite(*_cmnLogBinarySink, _cmnLogBinarySite, ##__VA_ARGS__); \
+        }                                                               \
+    } while (0)
+
+/*! Same as #CMN_LOG_BINARY for a registered class, the message is
+  filtered using the overall and class masks (see #CMN_LOG_CLASS). */
+#define CMN_LOG_CLASS_BINARY(lod, format, ...)                          \
+    do {                                                                \
+        cmnLogBinarySink * _cmnLogBinarySink = cmnLogger::GetBinarySink(); \
+        if (_cmnLogBinarySink                                           \
+            && (cmnLogger::GetMask() & this->Services()->GetLogMask() & lod)) { \
+            static const cmnLogBinarySite _cmnLogBinarySite = {__FILE__, __LINE__, lod, format}; \
+            cmnLogBinaryWrite(*_cmnLogBinarySink, _cmnLogBinarySite, ##__VA_ARGS__); \
+        }                                                               \
+    } while (0)
+
+
+/*! Static description of a binary log call site */
+struct cmnLogBinarySite {
+    const char * File;
+    int Line;
+    cmnLogLevel Level;
+    const char * Format;
+};
+
+
+/*! \brief Arguments of a binary log message
+
+  Each argument is stored as a one byte type tag followed by its
+  value in native byte order.  Integers are stored on 8 bytes and
+  strings are stored as their length (4 bytes) followed by the
+  characters.  Arguments that don't fit in the fixed size buffer are
+  dropped and the message is marked as truncated. */
+class CISST_EXPORT cmnLogBinaryArguments
+{
+public:
+    enum {MAXIMUM_SIZE = 512};
+
+    typedef enum {
+        INTEGER = 'i',
+        UNSIGNED_INTEGER = 'u',
+        DOUBLE = 'd',
+        CHARACTER = 'c',
+        BOOLEAN = 'b',
+        POINTER = 'p',
+        STRING = 's',
+        TRUNCATED = 't'
+    } TagType;
+
+    char Data[MAXIMUM_SIZE];
+    size_t Size;
+    bool Truncated;
+
+    inline cmnLogBinaryArguments(void):
+        Size(0),
+        Truncated(false)
+    {}
+
+    inline void Add(const bool value) {
+        Add(BOOLEAN, static_cast<char>(value ? 1 : 0));
+    }
+    inline void Add(const char value) {
+        Add(CHARACTER, value);
+    }
+    inline void Add(const signed char value) {
+        AddInteger(value);
+    }
+    inline void Add(const unsigned char value) {
+        AddUnsignedInteger(value);
+    }
+    inline void Add(const short value) {
+        AddInteger(value);
+    }
+    inline void Add(const unsigned short value) {
+        AddUnsignedInteger(value);
+    }
+    inline void Add(const int value) {
+        AddInteger(value);
+    }
+    inline void Add(const unsigned int value) {
+        AddUnsignedInteger(value);
+    }
+    inline void Add(const long value) {
+        AddInteger(value);
+    }
+    inline void Add(const unsigned long value) {
+        AddUnsignedInteger(value);
+    }
+    inline void Add(const long long value) {
+        AddInteger(value);
+    }
+    inline void Add(const unsigned long long value) {
+        AddUnsignedInteger(value);
+    }
+    inline void Add(const float value) {
+        Add(DOUBLE, static_cast<double>(value));
+    }
+    inline void Add(const double value) {
+        Add(DOUBLE, value);
+    }
+    inline void Add(const void * value) {
+        Add(POINTER, static_cast<unsigned long long>(reinterpret_cast<size_t>(value)));
+    }
+    inline void Add(const char * value) {
+        AddString(value, value ? strlen(value) : 0);
+    }
+    inline void Add(const std::string & value) {
+        AddString(value.data(), value.size());
+    }
+
+protected:
+    inline void AddInteger(const long long value) {
+        Add(INTEGER, value);
+    }
+
+    inline void AddUnsignedInteger(const unsigned long long value) {
+        Add(UNSIGNED_INTEGER, value);
+    }
+
+    /*! Check if the buffer has space for the given size, one byte is
+      always kept for the truncation tag */
+    inline bool Reserve(const size_t size) {
+        if (Truncated) {
+            return false;
+        }
+        if (Size + size < MAXIMUM_SIZE) {
+            return true;
+        }
+        Data[Size] = static_cast<char>(TRUNCATED);
+        Size++;
+        Truncated = true;
+        return false;
+    }
+
+    template <class _valueType>
+    inline void Add(const TagType tag, const _valueType & value) {
+        if (Reserve(1 + sizeof(_valueType))) {
+            Data[Size] = static_cast<char>(tag);
+            memcpy(Data + Size + 1, &value, sizeof(_valueType));
+            Size += 1 + sizeof(_valueType);
+        }
+    }
+
+    void AddString(const char * value, size_t length);
+};
+
+
+/*! \brief Destination for binary log messages
+
+  A sink receives the call site and arguments of each message sent
+  with #CMN_LOG_BINARY, it is responsible for adding the time and the
+  thread and writing the records using cmnLogBinaryFormat (see
+  osaAsynchronousLogger). */
+class CISST_EXPORT cmnLogBinarySink
+{
+public:
+    virtual ~cmnLogBinarySink() {}
+
+    /*! Called by the thread sending the message */
+    virtual void Write(const cmnLogBinarySite & site,
+                       const char * arguments, size_t size) = 0;
+};
+
+
+#ifndef SWIG
+/*! Encode the arguments and send the message to the sink, used by
+  #CMN_LOG_BINARY */
+template <class... _argumentTypes>
+inline void cmnLogBinaryWrite(cmnLogBinarySink & sink, const cmnLogBinarySite & site,
+                              const _argumentTypes & ... arguments)
+{
+    cmnLogBinaryArguments buffer;
+    const int expand[] = {0, (buffer.Add(arguments), 0)...};
+    (void)expand;
+    sink.Write(site, buffer.Data, buffer.Size);
+}
+#endif
+
+
+/*! \brief Binary log file format
+
+  A binary log file starts with a header (magic string, version and
+  byte order) followed by records.  Each record starts with its type
+  (one byte) and the size of its content (4 bytes).  Call sites are
+  written once, the first time they are used, and messages refer to
+  them using an index.  All values are written in the byte order of
+  the computer which wrote the file. */
+class CISST_EXPORT cmnLogBinaryFormat
+{
+public:
+    enum {VERSION = 1};
+
+    typedef enum {SITE = 1, MESSAGE = 2} RecordType;
+
+    /*! Write the file header */
+    static void WriteHeader(std::ostream & output);
+
+    /*! Write the description of a call site */
+    static void WriteSite(std::ostream & output, unsigned int siteIndex,
+                          const cmnLogBinarySite & site);
+
+    /*! Write a message, the arguments are the encoded arguments
+      created by cmnLogBinaryArguments */
+    static void WriteMessage(std::ostream & output, unsigned int siteIndex,
+                             double time, unsigned int thread,
+                             const char * arguments, size_t size);
+};
+
+
+/*! \brief Decoder for binary log files
+
+  Reads the records of a binary log file and creates the messages
+  text using the call sites' format.  The messages can be converted
+  to text (one line per message, similar to cmnLogger's output) or to
+  JSON (one object per line).
+
+  \code
+  std::ifstream input("log.bin", std::ios::binary);
+  cmnLogBinaryDecoder decoder(input);
+  cmnLogBinaryDecoder::Message message;
+  while (decoder.Next(message)) {
+      std::cout << message.Text << std::endl;
+  }
+  \endcode
+*/
+class CISST_EXPORT cmnLogBinaryDecoder
+{
+public:
+    /*! Value of an argument */
+    class Argument {
+    public:
+        char Tag;
+        long long Integer;
+        unsigned long long UnsignedInteger;
+        double Double;
+        std::string String;
+    };
+
+    /*! Decoded message */
+    class Message {
+    public:
+        double Time;
+        unsigned int Thread;
+        cmnLogLevel Level;
+        std::string File;
+        int Line;
+        std::string Format;
+        std::vector<Argument> Arguments;
+        bool Truncated;
+        std::string Text;
+    };
+
+    typedef enum {TEXT, JSON} OutputFormatType;
+
+    /*! Constructor, reads the file header */
+    cmnLogBinaryDecoder(std::istream & input);
+
+    /*! Check if the file header is valid */
+    inline bool IsValid(void) const {
+        return this->Valid;
+    }
+
+    /*! Error found while reading the header or the last record */
+    inline const std::string & GetError(void) const {
+        return this->Error;
+    }
+
+    /*! Read the next message, returns false at the end of the file or
+      if the file is corrupted (see GetError). */
+    bool Next(Message & message);
+
+    /*! Write the message in the given format, followed by a new line */
+    static void ToStream(std::ostream & output, const Message & message,
+                         OutputFormatType format = TEXT);
+
+    /*! Create the text of a message using a printf format string.
+      Conversions are adapted to the type of the arguments stored. */
+    static std::string Format(const std::string & format,
+                              const std::vector<Argument> & arguments,
+                              bool truncated = false);
+
+    /*! Decode all messages from the input, returns false if the file
+      is corrupted. */
+    static bool Convert(std::istream & input, std::ostream & output,
+                        OutputFormatType format = TEXT);
+
+protected:
+    std::istream & Input;
+    bool Valid;
+    std::string Error;
+
+    class Site {
+    public:
+        cmnLogLevel Level;
+        std::string File;
+        int Line;
+        std::string Format;
+    };
+    typedef std::map<unsigned int, Site> SitesType;
+    SitesType Sites;
+
+    bool DecodeMessage(const std::string & record, Message & message);
+
+private:
+    cmnLogBinaryDecoder(const cmnLogBinaryDecoder & other);
+    cmnLogBinaryDecoder & operator = (const cmnLogBinaryDecoder & other);
+};
+
+#endif // _cmnLogBinary_h
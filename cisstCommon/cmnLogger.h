@@ -5,7 +5,7 @@
   Author(s):  Anton Deguet
   Created on: 2004-08-31
 
-  (C) Copyright 2004-2018 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -37,9 +37,12 @@ http://www.cisst.org/cisst/license.txt.
 #include <string>
 #include <vector>
 #include <fstream>
+#include <atomic>
 
 #include <cisstCommon/cmnExport.h>
 
+class cmnLogBinarySink;
+
 // MJ: some thirdparty drivers on QNX make CMN_LOG macro throw exceptions
 // (e.g., std::bad_cast) and the following preprocessor can be used to bypass
 // this issue by replacing CMN_LOG with std::cout.
@@ -276,6 +279,10 @@ class CISST_EXPORT cmnLogger {
     /*! Single multiplexer used to stream the log out */
     StreamBufType LoDMultiplexerStreambuf;
 
+    /*! Destination of binary log messages, see #CMN_LOG_BINARY.
+      Read by all logging threads without lock. */
+    std::atomic<cmnLogBinarySink *> BinarySink;
+
     /*! Default filename (possibly including path) for default log.
         Normally, cisstLog.txt in current directory. */
     static std::string DefaultLogFileName;
@@ -492,6 +499,31 @@ class CISST_EXPORT cmnLogger {
 
     /*! Returns true if cmnLogger instance has been created (i.e., constructor called). */
     static bool IsCreated() { return InstanceCreated; }
+
+    /*! Set the destination of binary log messages (see
+      #CMN_LOG_BINARY and cmnLogBinary.h).  Binary messages are
+      ignored if no sink is provided (default).  The sink is not
+      owned by the logger.
+
+      Logging threads read the sink and then use it without any lock
+      so a thread might still use a sink after it has been replaced
+      or removed.  The sink must outlive every thread that can log
+      binary messages. */
+    static inline void SetBinarySink(cmnLogBinarySink * sink) {
+        Instance()->BinarySink.store(sink, std::memory_order_release);
+    }
+
+    /*! Remove the destination of binary log messages only if it is
+      the sink provided.  Returns true if the sink was removed.  See
+      SetBinarySink regarding the sink's lifetime. */
+    static inline bool RemoveBinarySink(cmnLogBinarySink * sink) {
+        return Instance()->BinarySink.compare_exchange_strong(sink, 0);
+    }
+
+    /*! Get the destination of binary log messages, 0 if none */
+    static inline cmnLogBinarySink * GetBinarySink(void) {
+        return Instance()->BinarySink.load(std::memory_order_acquire);
+    }
 };
 
 
@@ -5,7 +5,7 @@
   Author(s):  Anton Deguet, Min Yang Jung
   Created on: 2007-04-08
 
-  (C) Copyright 2007-2018 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2007-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -149,8 +149,10 @@ inline void cmnSerializeRaw(std::ostream & outputStream, const std::vector<_elem
   preceeded by a 0.  This allows cmnDeSerializer to determine what is
   currently deserialized.
 
-  The unique identifer used is the address of the object
-  cmnClassServices associated to each class.
+  The unique identifer used is the class identifier assigned by the
+  class register (see cmnClassServicesBase::GetClassId).  These are
+  small integers so the class information already sent and the
+  received identifiers (see cmnDeSerializer) can be stored in arrays.
 
   When an object needs to be serialized, the method Serialize will
   first verify that the class information (name and identifier) has
@@ -165,8 +167,9 @@ class CISST_EXPORT cmnSerializer: public cmnGenericObject {
 public:
 
     /*! Type used to identify objects over the network.  It uses the
-      services pointer but as the sender or receiver could be a 32
-      or 64 bits OS, we use a data type that can handle both. */
+      class identifier but as the sender or receiver could be a 32 or
+      64 bits OS, we use a data type that can handle both.  Older
+      versions used the services pointer. */
     typedef unsigned long long int TypeId;
 
     /*! Constructor.
@@ -189,8 +192,8 @@ public:
     /*! Serialize an object.  This method will first verify that the
       information (cmnClassServices) related to the class of the
       object has been serialized using SerializeServices.  Once this
-      is done, it will serialize the class identifier (pointer on the
-      class information, see cmnClassServices and cmnClassRegister)
+      is done, it will serialize the class identifier (see
+      cmnClassServicesBase::GetClassId and cmnClassRegister)
       and finally call the object's method <code>SerializeRaw</code>.
 
       \param object An object of a class derived from cmnGenericObject.  The
@@ -210,10 +213,10 @@ public:
     /*! Serialize the class information if needed.  This method will
       write the class name (as an STL string) and the type identifier
       used on the serialization end to the output stream.  The type
-      identifier used is the address of the class services object
-      (cmnClassServices).  To avoid sending the same information
-      multiple times, this class (cmnSerializer) maintains a list of
-      the class identifier already sent.
+      identifier used is the class identifier assigned by the class
+      register.  To avoid sending the same information multiple
+      times, this class (cmnSerializer) maintains a table of the class
+      identifiers already sent.
 
       It is important to note that a regular user doesn't need to use
       this method as the Serialize method performs this task.  It is
@@ -228,7 +231,9 @@ public:
       <code>object.Services()</code> to retrieve the correct pointer.
 
       \note As this method relies on cmnSerializeRaw, it might throw
-      an exception.
+      an exception.  It also throws if the class is not registered
+      (see cmnClassServicesBase::GetClassId) since the class
+      identifier 0 is used to indicate class information.
     */
     void SerializeServices(const cmnClassServicesBase * servicesPointer);
 
@@ -237,10 +242,8 @@ public:
 
     std::ostream & OutputStream;
 
-    /*! List of types already sent, uses the native pointer type */
-    typedef std::list<const cmnClassServicesBase *> ServicesContainerType;
-    typedef ServicesContainerType::const_iterator const_iterator;
-    typedef ServicesContainerType::iterator iterator;
+    /*! Types already sent, indexed by class identifier */
+    typedef std::vector<bool> ServicesContainerType;
 
     ServicesContainerType ServicesContainer;
 };
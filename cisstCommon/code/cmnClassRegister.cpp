@@ -6,7 +6,7 @@
   Author(s):  Alvin Liem, Anton Deguet
   Created on: 2002-08-01
 
-  (C) Copyright 2002-2018 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2002-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
   --- begin cisst license - do not edit ---
 
@@ -24,6 +24,30 @@
 #include <cisstCommon/cmnClassRegister.h>
 #include <cisstCommon/cmnClassServices.h>
 
+namespace {
+    // FNV-1a hash of the class name
+    inline size_t cmnClassRegisterHash(const std::string & className) {
+        size_t hash = static_cast<size_t>(14695981039346656037ULL);
+        const std::string::const_iterator end = className.end();
+        std::string::const_iterator iter;
+        for (iter = className.begin(); iter != end; ++iter) {
+            hash ^= static_cast<unsigned char>(*iter);
+            hash *= static_cast<size_t>(1099511628211ULL);
+        }
+        return hash;
+    }
+
+    // use linear probing to find the first empty slot
+    inline void cmnClassRegisterInsert(std::vector<size_t> & index, size_t hash, size_t classId) {
+        const size_t mask = index.size() - 1;
+        size_t slot = hash & mask;
+        while (index[slot] != 0) {
+            slot = (slot + 1) & mask;
+        }
+        index[slot] = classId;
+    }
+}
+
 cmnClassRegister* cmnClassRegister::Instance(void) {
     // create a static variable
     static cmnClassRegister instance;
@@ -45,6 +69,13 @@ const std::string * cmnClassRegister::RegisterInstance(cmnClassServicesBase* cla
         EntryType newEntry(className, classServicesPointer);
         insertionResult = ServicesContainer.insert(newEntry);
         if (insertionResult.second) {
+            // intern the class
+            const size_t classId = ServicesById.size();
+            ServicesById.push_back(classServicesPointer);
+            NamesById.push_back(&((*insertionResult.first).first));
+            NameHashes.push_back(cmnClassRegisterHash(className));
+            classServicesPointer->ClassIdMember = classId;
+            AddToIndices(classId);
             if (cmnLogger::IsCreated()) {
                 CMN_LOG_INIT_VERBOSE << "Class cmnClassRegister: Register: class \"" << className
                                      << "\" has been registered with Log LoD \"" << cmnLogMaskToString(classServicesPointer->GetLoD()) << "\"" << std::endl;
@@ -142,32 +173,80 @@ bool cmnClassRegister::SetLogMaskClassMatchingInstance(const std::string & strin
 }
 
 
-cmnClassServicesBase * cmnClassRegister::FindClassServicesInstance(const std::string & className)
+void cmnClassRegister::AddToIndices(size_t classId)
 {
-    const_iterator iterator;
-    const const_iterator end = ServicesContainer.end();
-    cmnClassServicesBase * result = NULL;
-    iterator = ServicesContainer.find(className);
-    if (iterator != end) {
-        result = iterator->second;
+    // keep the indices at most half full
+    const size_t numberOfClasses = ServicesById.size() - 1;
+    if (2 * numberOfClasses > NameIndex.size()) {
+        ResizeIndices((NameIndex.size() == 0) ? 256 : 2 * NameIndex.size());
+        return;
+    }
+    cmnClassRegisterInsert(NameIndex, NameHashes[classId], classId);
+    const std::type_info * typeInfo = ServicesById[classId]->TypeInfoPointer();
+    if (typeInfo) {
+        cmnClassRegisterInsert(TypeInfoIndex, typeInfo->hash_code(), classId);
+    }
+}
+
+
+void cmnClassRegister::ResizeIndices(size_t numberOfSlots)
+{
+    NameIndex.assign(numberOfSlots, 0);
+    TypeInfoIndex.assign(numberOfSlots, 0);
+    // insert in order of registration so the first class registered
+    // is found first
+    const size_t end = ServicesById.size();
+    for (size_t classId = 1; classId < end; ++classId) {
+        cmnClassRegisterInsert(NameIndex, NameHashes[classId], classId);
+        const std::type_info * typeInfo = ServicesById[classId]->TypeInfoPointer();
+        if (typeInfo) {
+            cmnClassRegisterInsert(TypeInfoIndex, typeInfo->hash_code(), classId);
+        }
     }
-    return result;
+}
+
+
+size_t cmnClassRegister::GetClassIdInstance(const std::string & className)
+{
+    if (NameIndex.empty()) {
+        return 0;
+    }
+    const size_t hash = cmnClassRegisterHash(className);
+    const size_t mask = NameIndex.size() - 1;
+    size_t slot = hash & mask;
+    size_t classId;
+    while ((classId = NameIndex[slot]) != 0) {
+        if ((NameHashes[classId] == hash)
+            && (*(NamesById[classId]) == className)) {
+            return classId;
+        }
+        slot = (slot + 1) & mask;
+    }
+    return 0;
+}
+
+
+cmnClassServicesBase * cmnClassRegister::FindClassServicesInstance(const std::string & className)
+{
+    return ServicesById[GetClassIdInstance(className)];
 }
 
 
 cmnClassServicesBase * cmnClassRegister::FindClassServicesInstance(const std::type_info & typeInfo)
 {
-    const_iterator iterator;
-    const const_iterator end = ServicesContainer.end();
-    cmnClassServicesBase * result = NULL;
-    iterator = ServicesContainer.begin();
-    while ((iterator != end) && (result == NULL)) {
-        if (*((iterator->second)->TypeInfoPointer()) == typeInfo) {
-            result = iterator->second;
+    if (TypeInfoIndex.empty()) {
+        return 0;
+    }
+    const size_t mask = TypeInfoIndex.size() - 1;
+    size_t slot = typeInfo.hash_code() & mask;
+    size_t classId;
+    while ((classId = TypeInfoIndex[slot]) != 0) {
+        if (*(ServicesById[classId]->TypeInfoPointer()) == typeInfo) {
+            return ServicesById[classId];
         }
-        iterator++;
+        slot = (slot + 1) & mask;
     }
-    return result;
+    return 0;
 }
 
 
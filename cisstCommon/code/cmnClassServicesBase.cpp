@@ -6,7 +6,7 @@
   Author(s):  Anton Deguet, Peter Kazanzides
   Created on: 2004-08-18
 
-  (C) Copyright 2004-2012 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -27,6 +27,7 @@ cmnClassServicesBase::cmnClassServicesBase(const std::string & className, const
                                            const cmnClassServicesBase * parentServices,
                                            const std::string & libraryName,
                                            cmnLogMask mask):
+    ClassIdMember(0),
     TypeInfoMember(typeInfo),
     ParentServices(parentServices),
     LibraryName(libraryName),
@@ -0,0 +1,128 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstCommon/cmnDataBinaryWriter.h>
+
+
+cmnDataBinaryWriter::cmnDataBinaryWriter(size_t blockSize, size_t referenceThreshold):
+    BlockSize(blockSize),
+    ReferenceThreshold(referenceThreshold),
+    CurrentBlock(0),
+    CurrentBlockUsed(0),
+    LastSegmentInBlock(false),
+    Size(0),
+    ReferencedSize(0)
+{
+}
+
+
+cmnDataBinaryWriter::~cmnDataBinaryWriter()
+{
+    const BlocksType::iterator end = Blocks.end();
+    BlocksType::iterator block;
+    for (block = Blocks.begin(); block != end; ++block) {
+        delete [] block->Data;
+    }
+}
+
+
+void cmnDataBinaryWriter::Reset(void)
+{
+    CurrentBlock = 0;
+    CurrentBlockUsed = 0;
+    LastSegmentInBlock = false;
+    Segments.clear();
+    Size = 0;
+    ReferencedSize = 0;
+}
+
+
+char * cmnDataBinaryWriter::Allocate(size_t size)
+{
+    if (size == 0) {
+        return 0;
+    }
+    // find a block with enough space, starting with the current one
+    while ((CurrentBlock < Blocks.size())
+           && (CurrentBlockUsed + size > Blocks[CurrentBlock].Capacity)) {
+        CurrentBlock++;
+        CurrentBlockUsed = 0;
+        LastSegmentInBlock = false;
+    }
+    if (CurrentBlock == Blocks.size()) {
+        Block block;
+        block.Capacity = (size > BlockSize) ? size : BlockSize;
+        block.Data = new char[block.Capacity];
+        Blocks.push_back(block);
+        CurrentBlockUsed = 0;
+        LastSegmentInBlock = false;
+    }
+    char * result = Blocks[CurrentBlock].Data + CurrentBlockUsed;
+    // extend the last segment if it ends where the new memory starts
+    if (LastSegmentInBlock) {
+        Segments.back().Size += size;
+    } else {
+        Segment segment;
+        segment.Data = result;
+        segment.Size = size;
+        Segments.push_back(segment);
+        LastSegmentInBlock = true;
+    }
+    CurrentBlockUsed += size;
+    Size += size;
+    return result;
+}
+
+
+void cmnDataBinaryWriter::Reference(const void * data, size_t size)
+{
+    if (size < ReferenceThreshold) {
+        Copy(data, size);
+        return;
+    }
+    Segment segment;
+    segment.Data = reinterpret_cast<const char *>(data);
+    segment.Size = size;
+    Segments.push_back(segment);
+    LastSegmentInBlock = false;
+    Size += size;
+    ReferencedSize += size;
+}
+
+
+size_t cmnDataBinaryWriter::CopyTo(char * buffer, size_t bufferSize) const
+{
+    if (bufferSize < Size) {
+        return 0;
+    }
+    const SegmentsType::const_iterator end = Segments.end();
+    SegmentsType::const_iterator segment;
+    for (segment = Segments.begin(); segment != end; ++segment) {
+        memcpy(buffer, segment->Data, segment->Size);
+        buffer += segment->Size;
+    }
+    return Size;
+}
+
+
+void cmnDataBinaryWriter::ToString(std::string & result) const
+{
+    result.resize(Size);
+    if (Size > 0) {
+        CopyTo(&(result[0]), Size);
+    }
+}
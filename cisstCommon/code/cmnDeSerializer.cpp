@@ -6,7 +6,7 @@
   Author(s):  Anton Deguet, Min Yang Jung
   Created on: 2007-04-08
 
-  (C) Copyright 2007-2013 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2007-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -35,6 +35,7 @@ cmnDeSerializer::~cmnDeSerializer()
 
 void cmnDeSerializer::Reset(void)
 {
+    ServicesById.clear();
     ServicesContainer.clear();
 }
 
@@ -50,14 +51,12 @@ cmnGenericObject * cmnDeSerializer::DeSerialize(const bool serializeObject) {
             object = this->DeSerialize();
         }
     } else {
-        const_iterator end = ServicesContainer.end();
-        const_iterator iterator = ServicesContainer.find(typeId);
-        if (iterator == end) {
+        cmnClassServicesBase * servicesPointerLocal = this->FindServices(typeId);
+        if (servicesPointerLocal == 0) {
             CMN_LOG_CLASS_RUN_ERROR << "DeSerialize(dynamic): Can't find class information for typeId = " << typeId 
                               << std::endl;
             cmnThrow("DeSerialize: Can't find corresponding class information");
         } else {
-            cmnClassServicesBase * servicesPointerLocal = iterator->second;
             object = servicesPointerLocal->Create();
             if (object == 0) {
                 cmnThrow("cmnDeSerialize::DeSerialize: Dynamic creation failed");
@@ -83,10 +82,14 @@ void cmnDeSerializer::DeSerializeServices(void) CISST_THROW(std::runtime_error)
     // don't already have it
     TypeId typeId;
     cmnDeSerializeRaw(this->InputStream, typeId);
-    const const_iterator end = ServicesContainer.end();
-    const const_iterator iterator = ServicesContainer.find(typeId);
-    if (iterator != end) {
+    if (this->FindServices(typeId) != 0) {
         CMN_LOG_CLASS_RUN_WARNING << "Class information for " << className << " has already been received" << std::endl;
+    } else if ((typeId > 0) && (typeId < MAXIMUM_INDEXED_TYPE_ID)) {
+        const size_t index = static_cast<size_t>(typeId);
+        if (index >= ServicesById.size()) {
+            ServicesById.resize(index + 1, 0);
+        }
+        ServicesById[index] = servicesPointerLocal;
     } else {
         EntryType newEntry(typeId, servicesPointerLocal);
         ServicesContainer.insert(newEntry);
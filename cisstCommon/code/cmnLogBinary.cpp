@@ -0,0 +1,568 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstCommon/cmnLogBinary.h>
+
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+
+namespace {
+
+    const char MAGIC[] = "cisstLogBinary";
+    const size_t MAGIC_SIZE = sizeof(MAGIC) - 1;
+    const unsigned int BYTE_ORDER_MARKER = 0x01020304;
+    const unsigned int BYTE_ORDER_MARKER_SWAPPED = 0x04030201;
+    const unsigned int MAXIMUM_RECORD_SIZE = 16 * 1024 * 1024;
+
+    template <class _valueType>
+    inline void Write(std::ostream & output, const _valueType & value) {
+        output.write(reinterpret_cast<const char *>(&value), sizeof(_valueType));
+    }
+
+    inline void WriteString(std::ostream & output, const char * value) {
+        const unsigned int length = value ? static_cast<unsigned int>(strlen(value)) : 0;
+        Write(output, length);
+        output.write(value, length);
+    }
+
+    /*! Read values from a record, the position is moved and set past
+      the end if the record is too short */
+    class RecordReader {
+    public:
+        const std::string & Record;
+        size_t Position;
+
+        RecordReader(const std::string & record):
+            Record(record),
+            Position(0)
+        {}
+
+        inline bool IsValid(void) const {
+            return (Position <= Record.size());
+        }
+
+        inline bool AtEnd(void) const {
+            return (Position >= Record.size());
+        }
+
+        template <class _valueType>
+        inline bool Read(_valueType & value) {
+            if (Position + sizeof(_valueType) > Record.size()) {
+                Position = Record.size() + 1;
+                return false;
+            }
+            memcpy(&value, Record.data() + Position, sizeof(_valueType));
+            Position += sizeof(_valueType);
+            return true;
+        }
+
+        inline bool ReadString(std::string & value) {
+            unsigned int length;
+            if (!Read(length) || (Position + length > Record.size())) {
+                Position = Record.size() + 1;
+                return false;
+            }
+            value.assign(Record, Position, length);
+            Position += length;
+            return true;
+        }
+    };
+
+    /*! Append a value formatted with snprintf */
+    template <class _valueType>
+    void AppendFormatted(std::string & result, const std::string & specification, const _valueType value)
+    {
+        char buffer[256];
+        const int length = snprintf(buffer, sizeof(buffer), specification.c_str(), value);
+        if (length < 0) {
+            return;
+        }
+        if (static_cast<size_t>(length) < sizeof(buffer)) {
+            result.append(buffer, length);
+            return;
+        }
+        std::vector<char> large(length + 1);
+        snprintf(&(large[0]), large.size(), specification.c_str(), value);
+        result.append(&(large[0]), length);
+    }
+
+    void FormatArgument(std::string & result, const std::string & flags, const char conversion,
+                        const cmnLogBinaryDecoder::Argument & argument)
+    {
+        const bool integerConversion = (strchr("diouxXc", conversion) != 0);
+        const bool floatingConversion = (strchr("fFeEgGaA", conversion) != 0);
+        const bool unsignedConversion = (strchr("ouxX", conversion) != 0);
+        switch (argument.Tag) {
+        case cmnLogBinaryArguments::INTEGER:
+            if (floatingConversion) {
+                AppendFormatted(result, flags + conversion, static_cast<double>(argument.Integer));
+            } else if (conversion == 'c') {
+                AppendFormatted(result, flags + 'c', static_cast<int>(argument.Integer));
+            } else if (unsignedConversion) {
+                AppendFormatted(result, flags + "ll" + conversion, argument.Integer);
+            } else {
+                AppendFormatted(result, flags + "lld", argument.Integer);
+            }
+            break;
+        case cmnLogBinaryArguments::UNSIGNED_INTEGER:
+            if (floatingConversion) {
+                AppendFormatted(result, flags + conversion, static_cast<double>(argument.UnsignedInteger));
+            } else if (conversion == 'c') {
+                AppendFormatted(result, flags + 'c', static_cast<int>(argument.UnsignedInteger));
+            } else if (unsignedConversion) {
+                AppendFormatted(result, flags + "ll" + conversion, argument.UnsignedInteger);
+            } else {
+                AppendFormatted(result, flags + "llu", argument.UnsignedInteger);
+            }
+            break;
+        case cmnLogBinaryArguments::DOUBLE:
+            if (floatingConversion) {
+                AppendFormatted(result, flags + conversion, argument.Double);
+            } else if (integerConversion) {
+                AppendFormatted(result, flags + "lld", static_cast<long long>(argument.Double));
+            } else {
+                AppendFormatted(result, flags + 'g', argument.Double);
+            }
+            break;
+        case cmnLogBinaryArguments::CHARACTER:
+            if (integerConversion && (conversion != 'c')) {
+                AppendFormatted(result, flags + "lld", argument.Integer);
+            } else {
+                AppendFormatted(result, flags + 'c', static_cast<int>(argument.Integer));
+            }
+            break;
+        case cmnLogBinaryArguments::BOOLEAN:
+            if (integerConversion) {
+                AppendFormatted(result, flags + 'd', static_cast<int>(argument.Integer));
+            } else {
+                AppendFormatted(result, flags + 's', argument.Integer ? "true" : "false");
+            }
+            break;
+        case cmnLogBinaryArguments::POINTER:
+            if (unsignedConversion) {
+                AppendFormatted(result, flags + "ll" + conversion, argument.UnsignedInteger);
+            } else {
+                result.append("0x");
+                AppendFormatted(result, flags + "llx", argument.UnsignedInteger);
+            }
+            break;
+        case cmnLogBinaryArguments::STRING:
+            if (conversion == 's') {
+                AppendFormatted(result, flags + 's', argument.String.c_str());
+            } else {
+                result.append(argument.String);
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    void JSONString(std::ostream & output, const std::string & value)
+    {
+        output << '"';
+        const std::string::const_iterator end = value.end();
+        std::string::const_iterator iter;
+        for (iter = value.begin(); iter != end; ++iter) {
+            const unsigned char character = static_cast<unsigned char>(*iter);
+            switch (character) {
+            case '"':
+                output << "\\\"";
+                break;
+            case '\\':
+                output << "\\\\";
+                break;
+            case '\n':
+                output << "\\n";
+                break;
+            case '\r':
+                output << "\\r";
+                break;
+            case '\t':
+                output << "\\t";
+                break;
+            default:
+                if (character < 0x20) {
+                    char buffer[8];
+                    snprintf(buffer, sizeof(buffer), "\\u%04x", character);
+                    output << buffer;
+                } else {
+                    output << *iter;
+                }
+            }
+        }
+        output << '"';
+    }
+}
+
+
+void cmnLogBinaryArguments::AddString(const char * value, size_t length)
+{
+    if (Truncated) {
+        return;
+    }
+    const size_t header = 1 + sizeof(unsigned int);
+    if (Size + header + length < MAXIMUM_SIZE) {
+        Data[Size] = static_cast<char>(STRING);
+        const unsigned int length32 = static_cast<unsigned int>(length);
+        memcpy(Data + Size + 1, &length32, sizeof(unsigned int));
+        memcpy(Data + Size + header, value, length);
+        Size += header + length;
+        return;
+    }
+    // keep the beginning of the string
+    if (Size + header + 1 < MAXIMUM_SIZE) {
+        const unsigned int length32 = static_cast<unsigned int>(MAXIMUM_SIZE - 1 - Size - header);
+        Data[Size] = static_cast<char>(STRING);
+        memcpy(Data + Size + 1, &length32, sizeof(unsigned int));
+        memcpy(Data + Size + header, value, length32);
+        Size += header + length32;
+    }
+    Data[Size] = static_cast<char>(TRUNCATED);
+    Size++;
+    Truncated = true;
+}
+
+
+void cmnLogBinaryFormat::WriteHeader(std::ostream & output)
+{
+    output.write(MAGIC, MAGIC_SIZE);
+    const unsigned int version = VERSION;
+    Write(output, version);
+    Write(output, BYTE_ORDER_MARKER);
+}
+
+
+void cmnLogBinaryFormat::WriteSite(std::ostream & output, unsigned int siteIndex,
+                                   const cmnLogBinarySite & site)
+{
+    const unsigned char type = SITE;
+    const unsigned int fileLength = site.File ? static_cast<unsigned int>(strlen(site.File)) : 0;
+    const unsigned int formatLength = site.Format ? static_cast<unsigned int>(strlen(site.Format)) : 0;
+    const unsigned int size = static_cast<unsigned int>(sizeof(siteIndex) + sizeof(site.Line) + sizeof(site.Level)
+                                                       + 2 * sizeof(unsigned int) + fileLength + formatLength);
+    Write(output, type);
+    Write(output, size);
+    Write(output, siteIndex);
+    Write(output, site.Line);
+    Write(output, site.Level);
+    WriteString(output, site.File);
+    WriteString(output, site.Format);
+}
+
+
+void cmnLogBinaryFormat::WriteMessage(std::ostream & output, unsigned int siteIndex,
+                                      double time, unsigned int thread,
+                                      const char * arguments, size_t size)
+{
+    const unsigned char type = MESSAGE;
+    const unsigned int recordSize = static_cast<unsigned int>(sizeof(siteIndex) + sizeof(time) + sizeof(thread) + size);
+    Write(output, type);
+    Write(output, recordSize);
+    Write(output, siteIndex);
+    Write(output, time);
+    Write(output, thread);
+    output.write(arguments, size);
+}
+
+
+cmnLogBinaryDecoder::cmnLogBinaryDecoder(std::istream & input):
+    Input(input),
+    Valid(false)
+{
+    char magic[MAGIC_SIZE];
+    unsigned int version = 0, byteOrder = 0;
+    Input.read(magic, MAGIC_SIZE);
+    Input.read(reinterpret_cast<char *>(&version), sizeof(version));
+    Input.read(reinterpret_cast<char *>(&byteOrder), sizeof(byteOrder));
+    if (!Input || (memcmp(magic, MAGIC, MAGIC_SIZE) != 0)) {
+        Error = "not a binary log file";
+        return;
+    }
+    if (byteOrder == BYTE_ORDER_MARKER_SWAPPED) {
+        Error = "binary log file written with a different byte order";
+        return;
+    }
+    if ((byteOrder != BYTE_ORDER_MARKER) || (version != cmnLogBinaryFormat::VERSION)) {
+        std::stringstream error;
+        error << "unsupported binary log file version " << version;
+        Error = error.str();
+        return;
+    }
+    Valid = true;
+}
+
+
+bool cmnLogBinaryDecoder::Next(Message & message)
+{
+    if (!Valid) {
+        return false;
+    }
+    std::string record;
+    while (true) {
+        unsigned char type;
+        unsigned int size;
+        if (!Input.read(reinterpret_cast<char *>(&type), sizeof(type))) {
+            // end of file
+            return false;
+        }
+        if (!Input.read(reinterpret_cast<char *>(&size), sizeof(size))
+            || (size > MAXIMUM_RECORD_SIZE)) {
+            Error = "truncated or corrupted record";
+            return false;
+        }
+        record.resize(size);
+        if ((size > 0) && !Input.read(&(record[0]), size)) {
+            Error = "truncated record";
+            return false;
+        }
+        if (type == cmnLogBinaryFormat::SITE) {
+            RecordReader reader(record);
+            unsigned int index;
+            Site site;
+            reader.Read(index);
+            reader.Read(site.Line);
+            reader.Read(site.Level);
+            reader.ReadString(site.File);
+            reader.ReadString(site.Format);
+            if (!reader.IsValid()) {
+                Error = "corrupted call site record";
+                return false;
+            }
+            Sites[index] = site;
+        } else if (type == cmnLogBinaryFormat::MESSAGE) {
+            if (!DecodeMessage(record, message)) {
+                return false;
+            }
+            return true;
+        }
+        // other record types are ignored for forward compatibility
+    }
+}
+
+
+bool cmnLogBinaryDecoder::DecodeMessage(const std::string & record, Message & message)
+{
+    RecordReader reader(record);
+    unsigned int index;
+    reader.Read(index);
+    reader.Read(message.Time);
+    reader.Read(message.Thread);
+    if (!reader.IsValid()) {
+        Error = "corrupted message record";
+        return false;
+    }
+    const SitesType::const_iterator site = Sites.find(index);
+    if (site == Sites.end()) {
+        Error = "message refers to an unknown call site";
+        return false;
+    }
+    message.Level = site->second.Level;
+    message.File = site->second.File;
+    message.Line = site->second.Line;
+    message.Format = site->second.Format;
+    message.Arguments.clear();
+    message.Truncated = false;
+
+    Argument argument;
+    while (!reader.AtEnd()) {
+        reader.Read(argument.Tag);
+        argument.Integer = 0;
+        argument.UnsignedInteger = 0;
+        argument.Double = 0.0;
+        argument.String.clear();
+        switch (argument.Tag) {
+        case cmnLogBinaryArguments::INTEGER:
+            reader.Read(argument.Integer);
+            break;
+        case cmnLogBinaryArguments::UNSIGNED_INTEGER:
+        case cmnLogBinaryArguments::POINTER:
+            reader.Read(argument.UnsignedInteger);
+            break;
+        case cmnLogBinaryArguments::DOUBLE:
+            reader.Read(argument.Double);
+            break;
+        case cmnLogBinaryArguments::CHARACTER:
+        case cmnLogBinaryArguments::BOOLEAN:
+            {
+                char value;
+                reader.Read(value);
+                argument.Integer = value;
+            }
+            break;
+        case cmnLogBinaryArguments::STRING:
+            reader.ReadString(argument.String);
+            break;
+        case cmnLogBinaryArguments::TRUNCATED:
+            message.Truncated = true;
+            break;
+        default:
+            Error = "unknown argument type in message record";
+            return false;
+        }
+        if (!reader.IsValid()) {
+            Error = "corrupted message record";
+            return false;
+        }
+        if (argument.Tag != cmnLogBinaryArguments::TRUNCATED) {
+            message.Arguments.push_back(argument);
+        }
+    }
+    message.Text = Format(message.Format, message.Arguments, message.Truncated);
+    return true;
+}
+
+
+std::string cmnLogBinaryDecoder::Format(const std::string & format,
+                                        const std::vector<Argument> & arguments,
+                                        bool truncated)
+{
+    std::string result;
+    size_t argumentIndex = 0;
+    const size_t size = format.size();
+    size_t index = 0;
+    while (index < size) {
+        if (format[index] != '%') {
+            result.push_back(format[index]);
+            index++;
+            continue;
+        }
+        if ((index + 1 < size) && (format[index + 1] == '%')) {
+            result.push_back('%');
+            index += 2;
+            continue;
+        }
+        // flags, width and precision are kept, length modifiers are
+        // replaced based on the argument type
+        const size_t start = index;
+        std::string flags("%");
+        index++;
+        while ((index < size) && strchr("-+ #0", format[index])) {
+            flags.push_back(format[index]);
+            index++;
+        }
+        while ((index < size) && (isdigit(static_cast<unsigned char>(format[index])) || (format[index] == '.'))) {
+            flags.push_back(format[index]);
+            index++;
+        }
+        while ((index < size) && strchr("hlLqjzt", format[index])) {
+            index++;
+        }
+        if (index >= size) {
+            result.append(format, start, std::string::npos);
+            break;
+        }
+        const char conversion = format[index];
+        index++;
+        if (argumentIndex < arguments.size()) {
+            FormatArgument(result, flags, conversion, arguments[argumentIndex]);
+            argumentIndex++;
+        } else if (truncated) {
+            result.append("...");
+        } else {
+            result.append(format, start, index - start);
+        }
+    }
+    return result;
+}
+
+
+void cmnLogBinaryDecoder::ToStream(std::ostream & output, const Message & message,
+                                   OutputFormatType format)
+{
+    std::string text = message.Text;
+    if (!text.empty() && (text[text.size() - 1] == '\n')) {
+        text.resize(text.size() - 1);
+    }
+    const std::ios_base::fmtflags flags = output.flags();
+    const std::streamsize precision = output.precision();
+    output << std::fixed << std::setprecision(6);
+    if (format == TEXT) {
+        output << message.Time << " " << cmnLogLevelToString(message.Level)
+               << " T" << message.Thread
+               << " File: " << cmnLogger::ExtractFileName(message.File.c_str())
+               << " Line: " << message.Line << " - " << text << std::endl;
+    } else {
+        output << "{\"time\": " << message.Time
+               << ", \"thread\": " << message.Thread
+               << ", \"level\": ";
+        JSONString(output, cmnLogLevelToString(message.Level));
+        output << ", \"file\": ";
+        JSONString(output, message.File);
+        output << ", \"line\": " << message.Line
+               << ", \"format\": ";
+        JSONString(output, message.Format);
+        output << ", \"arguments\": [";
+        output << std::defaultfloat << std::setprecision(17);
+        for (size_t index = 0; index < message.Arguments.size(); ++index) {
+            const Argument & argument = message.Arguments[index];
+            if (index != 0) {
+                output << ", ";
+            }
+            switch (argument.Tag) {
+            case cmnLogBinaryArguments::INTEGER:
+                output << argument.Integer;
+                break;
+            case cmnLogBinaryArguments::UNSIGNED_INTEGER:
+                output << argument.UnsignedInteger;
+                break;
+            case cmnLogBinaryArguments::DOUBLE:
+                if (std::isfinite(argument.Double)) {
+                    output << argument.Double;
+                } else {
+                    JSONString(output, Format("%g", std::vector<Argument>(1, argument)));
+                }
+                break;
+            case cmnLogBinaryArguments::CHARACTER:
+                JSONString(output, std::string(1, static_cast<char>(argument.Integer)));
+                break;
+            case cmnLogBinaryArguments::BOOLEAN:
+                output << (argument.Integer ? "true" : "false");
+                break;
+            case cmnLogBinaryArguments::POINTER:
+                JSONString(output, Format("%p", std::vector<Argument>(1, argument)));
+                break;
+            default:
+                JSONString(output, argument.String);
+            }
+        }
+        output << "]";
+        if (message.Truncated) {
+            output << ", \"truncated\": true";
+        }
+        output << ", \"message\": ";
+        JSONString(output, text);
+        output << "}" << std::endl;
+    }
+    output.flags(flags);
+    output.precision(precision);
+}
+
+
+bool cmnLogBinaryDecoder::Convert(std::istream & input, std::ostream & output,
+                                  OutputFormatType format)
+{
+    cmnLogBinaryDecoder decoder(input);
+    Message message;
+    while (decoder.Next(message)) {
+        ToStream(output, message, format);
+    }
+    return (decoder.IsValid() && decoder.GetError().empty());
+}
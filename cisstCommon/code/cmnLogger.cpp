@@ -5,7 +5,7 @@
   Author(s):  Anton Deguet
   Created on: 2004-08-31
 
-  (C) Copyright 2004-2018 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -49,7 +49,8 @@ bool cmnLogger::SetDefaultLogFileName(const std::string & defaultLogFileName)
 cmnLogger::cmnLogger(const std::string & defaultLogFileName):
     Mask(CMN_LOG_ALLOW_ALL),
     FunctionMask(CMN_LOG_ALLOW_ERRORS),
-    LoDMultiplexerStreambuf()
+    LoDMultiplexerStreambuf(),
+    BinarySink(0)
 {
     cmnLogger::InstanceCreated = true;
     LoDMultiplexerStreambuf.AddChannel(*(DefaultLogFile(defaultLogFileName)), CMN_LOG_ALLOW_DEFAULT);
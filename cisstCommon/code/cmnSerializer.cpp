@@ -6,7 +6,7 @@
   Author(s):  Anton Deguet, Min Yang Jung
   Created on: 2007-04-08
 
-  (C) Copyright 2007-2013 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2007-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -34,11 +34,9 @@ cmnSerializer::~cmnSerializer()
 }
 
 bool cmnSerializer::ServicesSerialized(const cmnClassServicesBase *servicesPointer) const {
-    // search for services pointer to see if the information has been sent
-    const const_iterator begin = ServicesContainer.begin();
-    const const_iterator end = ServicesContainer.end();
-    const_iterator found = std::find(begin, end, servicesPointer);
-    return (found != end);
+    // use the class identifier to see if the information has been sent
+    const size_t classId = servicesPointer->GetClassId();
+    return ((classId < ServicesContainer.size()) && ServicesContainer[classId]);
 }
 
 void cmnSerializer::Reset(void)
@@ -51,7 +49,7 @@ void cmnSerializer::Serialize(const cmnGenericObject & object, const bool serial
     const cmnClassServicesBase * servicesPointer = object.Services();
     this->SerializeServices(servicesPointer);
     // serialize the object preceeded by its type Id
-    TypeId typeId = reinterpret_cast<TypeId>(servicesPointer);
+    TypeId typeId = servicesPointer->GetClassId();
     cmnSerializeRaw(this->OutputStream, typeId);
     if (serializeObject) {
         object.SerializeRaw(this->OutputStream);
@@ -61,6 +59,14 @@ void cmnSerializer::Serialize(const cmnGenericObject & object, const bool serial
 
 void cmnSerializer::SerializeServices(const cmnClassServicesBase * servicesPointer) {
     if (!ServicesSerialized(servicesPointer)) {
+        // 0 is used to indicate class information, a class without
+        // identifier (e.g. name already registered) can't be sent
+        if (servicesPointer->GetClassId() == 0) {
+            CMN_LOG_CLASS_RUN_ERROR << "SerializeServices: class with type info \""
+                                    << servicesPointer->TypeInfoPointer()->name()
+                                    << "\" is not registered and can't be serialized" << std::endl;
+            cmnThrow("cmnSerializer::SerializeServices: class not registered");
+        }
         // if the class "services" has not yet been sent
         CMN_LOG_CLASS_RUN_VERBOSE << "Sending information related to class " << servicesPointer->GetName() << std::endl;
         // sent the info with null pointer so that reader can
@@ -68,9 +74,13 @@ void cmnSerializer::SerializeServices(const cmnClassServicesBase * servicesPoint
         TypeId invalidClassServices = 0;
         cmnSerializeRaw(this->OutputStream, invalidClassServices);
         cmnSerializeRaw(this->OutputStream, servicesPointer->GetName());
-        TypeId typeId = reinterpret_cast<TypeId>(servicesPointer);
+        const size_t classId = servicesPointer->GetClassId();
+        TypeId typeId = classId;
         cmnSerializeRaw(this->OutputStream, typeId);
-        ServicesContainer.push_back(servicesPointer);
+        if (classId >= ServicesContainer.size()) {
+            ServicesContainer.resize(classId + 1, false);
+        }
+        ServicesContainer[classId] = true;
     }
 }
 
@@ -22,6 +22,10 @@ http://www.cisst.org/cisst/license.txt.
 #include "cmnClassRegisterTestStatic.h"
 #include "cmnClassRegisterTestDynamic.h"
 
+#include <cisstCommon/cmnGenericObjectProxy.h>
+#include <cisstCommon/cmnSerializer.h>
+#include <cisstCommon/cmnDeSerializer.h>
+
 
 CMN_IMPLEMENT_SERVICES(TestA);
 CMN_IMPLEMENT_SERVICES(TestB);
@@ -355,3 +359,106 @@ void cmnClassRegisterTest::TestIterators(void)
     CPPUNIT_ASSERT(foundC2);
 }
 
+
+void cmnClassRegisterTest::TestClassId(void)
+{
+    const size_t classAId = TestA::ClassServices()->GetClassId();
+    const size_t classC2Id = TestC2::ClassServices()->GetClassId();
+    CPPUNIT_ASSERT(classAId != 0);
+    CPPUNIT_ASSERT(classC2Id != 0);
+    CPPUNIT_ASSERT(classAId != classC2Id);
+    CPPUNIT_ASSERT(classAId < cmnClassRegister::size() + 1);
+    CPPUNIT_ASSERT_EQUAL(classAId, cmnClassRegister::GetClassId("TestA"));
+    CPPUNIT_ASSERT(cmnClassRegister::FindClassServices(classAId) == TestA::ClassServices());
+    CPPUNIT_ASSERT(cmnClassRegister::FindClassServices(classC2Id) == TestC2::ClassServices());
+    CPPUNIT_ASSERT(cmnClassRegister::FindClassServices(typeid(TestC2)) == TestC2::ClassServices());
+
+    // not registered
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), cmnClassRegister::GetClassId("TestC1"));
+    CPPUNIT_ASSERT(cmnClassRegister::FindClassServices(typeid(TestC1)) == 0);
+    CPPUNIT_ASSERT(cmnClassRegister::FindClassServices(static_cast<size_t>(0)) == 0);
+    CPPUNIT_ASSERT(cmnClassRegister::FindClassServices(cmnClassRegister::size() + 1) == 0);
+
+    // all classes can be found by name, identifier and type
+    cmnClassRegister::const_iterator iter = cmnClassRegister::begin();
+    const cmnClassRegister::const_iterator end = cmnClassRegister::end();
+    for (; iter != end; ++iter) {
+        const cmnClassServicesBase * services = iter->second;
+        CPPUNIT_ASSERT(cmnClassRegister::FindClassServices(iter->first) == services);
+        CPPUNIT_ASSERT(cmnClassRegister::FindClassServices(services->GetClassId()) == services);
+        CPPUNIT_ASSERT(*(cmnClassRegister::FindClassServices(*(services->TypeInfoPointer()))->TypeInfoPointer())
+                       == *(services->TypeInfoPointer()));
+    }
+}
+
+
+void cmnClassRegisterTest::TestSerializerClassId(void)
+{
+    const cmnDouble value(3.5);
+    std::stringstream stream;
+    cmnSerializer serializer(stream);
+    serializer.Serialize(value);
+    CPPUNIT_ASSERT(serializer.ServicesSerialized(value.Services()));
+    serializer.Serialize(value);
+
+    // class information then two objects
+    cmnSerializer::TypeId typeId;
+    std::string className;
+    std::stringstream copy(stream.str());
+    cmnDeSerializeRaw(copy, typeId);
+    CPPUNIT_ASSERT_EQUAL(0ULL, typeId);
+    cmnDeSerializeRaw(copy, className);
+    CPPUNIT_ASSERT_EQUAL(std::string("cmnDouble"), className);
+    cmnDeSerializeRaw(copy, typeId);
+    CPPUNIT_ASSERT_EQUAL(static_cast<cmnSerializer::TypeId>(value.Services()->GetClassId()), typeId);
+
+    cmnDeSerializer deSerializer(stream);
+    cmnGenericObject * object = deSerializer.DeSerialize();
+    cmnDouble * result = dynamic_cast<cmnDouble *>(object);
+    CPPUNIT_ASSERT(result != 0);
+    CPPUNIT_ASSERT_EQUAL(3.5, result->Data);
+    delete object;
+    cmnDouble other(0.0);
+    deSerializer.DeSerialize(other);
+    CPPUNIT_ASSERT_EQUAL(3.5, other.Data);
+
+    // type identifier using an address, as sent by older versions
+    const cmnDeSerializer::TypeId address = 0x7f0012345678LL;
+    std::stringstream old;
+    cmnSerializeRaw(old, 0LL);
+    cmnSerializeRaw(old, std::string("cmnDouble"));
+    cmnSerializeRaw(old, address);
+    cmnSerializeRaw(old, address);
+    value.SerializeRaw(old);
+    cmnDeSerializer oldDeSerializer(old);
+    other.Data = 0.0;
+    oldDeSerializer.DeSerialize(other);
+    CPPUNIT_ASSERT_EQUAL(3.5, other.Data);
+
+    // unknown identifier
+    std::stringstream unknown;
+    cmnSerializeRaw(unknown, 12LL);
+    cmnDeSerializer unknownDeSerializer(unknown);
+    bool exceptionReceived = false;
+    try {
+        unknownDeSerializer.DeSerialize(other);
+    } catch (std::runtime_error &) {
+        exceptionReceived = true;
+    }
+    CPPUNIT_ASSERT(exceptionReceived);
+
+    // class that can't be registered, name is already used
+    cmnClassServices<CMN_NO_DYNAMIC_CREATION, cmnDouble> duplicate("cmnDouble", &typeid(cmnDouble), 0, "cisstCommonTests");
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), duplicate.GetClassId());
+    std::stringstream notSent;
+    cmnSerializer notSentSerializer(notSent);
+    exceptionReceived = false;
+    try {
+        notSentSerializer.SerializeServices(&duplicate);
+    } catch (std::runtime_error &) {
+        exceptionReceived = true;
+    }
+    CPPUNIT_ASSERT(exceptionReceived);
+    CPPUNIT_ASSERT(notSent.str().empty());
+    CPPUNIT_ASSERT(!notSentSerializer.ServicesSerialized(&duplicate));
+}
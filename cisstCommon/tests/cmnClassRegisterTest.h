@@ -131,6 +131,8 @@ class cmnClassRegisterTest : public CppUnit::TestFixture
     CPPUNIT_TEST(TestLog);
     CPPUNIT_TEST(TestDynamicCreation);
     CPPUNIT_TEST(TestIterators);
+    CPPUNIT_TEST(TestClassId);
+    CPPUNIT_TEST(TestSerializerClassId);
     CPPUNIT_TEST_SUITE_END();
 
  public:
@@ -163,6 +165,14 @@ class cmnClassRegisterTest : public CppUnit::TestFixture
     /*! Test iterators */
     void TestIterators(void);
 
+    /*! Test lookups by class identifier */
+    void TestClassId(void);
+
+    /*! Test that the serializer sends class identifiers and that the
+      deserializer accepts both class identifiers and large type
+      identifiers.  Classes not registered can't be serialized. */
+    void TestSerializerClassId(void);
+
 protected:
     /* add an output stream to check the log */
     std::stringstream OutputStream;
@@ -0,0 +1,144 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+#include "cmnDataBinaryWriterTest.h"
+
+#include <cisstCommon/cmnDataBinaryWriter.h>
+#include <cisstCommon/cmnDataFunctionsString.h>
+#include <cisstCommon/cmnDataFunctionsVector.h>
+
+#include <sstream>
+
+
+void cmnDataBinaryWriterTest::TestAllocate(void)
+{
+    cmnDataBinaryWriter writer(64);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), writer.GetSize());
+    CPPUNIT_ASSERT(writer.GetSegments().empty());
+    CPPUNIT_ASSERT(writer.Allocate(0) == 0);
+
+    // consecutive allocations in the same block
+    const char * first = writer.Allocate(10);
+    const char * second = writer.Allocate(20);
+    CPPUNIT_ASSERT(second == first + 10);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), writer.GetSegments().size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(30), writer.GetSegments()[0].Size);
+
+    // doesn't fit in the first block
+    writer.Allocate(40);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), writer.GetSegments().size());
+    // larger than the block size
+    writer.Allocate(100);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), writer.GetSegments().size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(170), writer.GetSize());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), writer.GetReferencedSize());
+}
+
+
+void cmnDataBinaryWriterTest::TestReference(void)
+{
+    cmnDataBinaryWriter writer(64, 16);
+    const char small[] = "small";
+    const char large[] = "this is large enough to be referenced";
+    writer.Reference(small, sizeof(small));
+    writer.Reference(large, sizeof(large));
+    writer.Reference(small, sizeof(small));
+    const cmnDataBinaryWriter::SegmentsType & segments = writer.GetSegments();
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), segments.size());
+    CPPUNIT_ASSERT(segments[0].Data != small);
+    CPPUNIT_ASSERT(segments[1].Data == large);
+    CPPUNIT_ASSERT(segments[2].Data != small);
+    CPPUNIT_ASSERT_EQUAL(sizeof(large), writer.GetReferencedSize());
+    CPPUNIT_ASSERT_EQUAL(2 * sizeof(small) + sizeof(large), writer.GetSize());
+
+    std::string result;
+    writer.ToString(result);
+    CPPUNIT_ASSERT_EQUAL(std::string(small, sizeof(small)) + std::string(large, sizeof(large))
+                         + std::string(small, sizeof(small)), result);
+
+    // buffer too small
+    char buffer[100];
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), writer.CopyTo(buffer, 10));
+    CPPUNIT_ASSERT_EQUAL(writer.GetSize(), writer.CopyTo(buffer, sizeof(buffer)));
+    CPPUNIT_ASSERT_EQUAL(result, std::string(buffer, writer.GetSize()));
+}
+
+
+void cmnDataBinaryWriterTest::TestReset(void)
+{
+    cmnDataBinaryWriter writer(64);
+    const char * first = writer.Allocate(50);
+    const char * second = writer.Allocate(50);
+    writer.Reset();
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), writer.GetSize());
+    CPPUNIT_ASSERT(writer.GetSegments().empty());
+    // same memory blocks are used
+    CPPUNIT_ASSERT(writer.Allocate(50) == first);
+    CPPUNIT_ASSERT(writer.Allocate(50) == second);
+}
+
+
+void cmnDataBinaryWriterTest::TestSerializeBinary(void)
+{
+    const double value = 3.14;
+    const std::string text = "some text";
+    std::vector<double> doubles(100);
+    std::vector<std::string> strings(3);
+    std::vector<bool> bools(5);
+    for (size_t index = 0; index < doubles.size(); ++index) {
+        doubles[index] = index * 0.5;
+    }
+    strings[1] = "one";
+    strings[2] = "two";
+    bools[1] = true;
+    bools[4] = true;
+
+    std::stringstream stream;
+    cmnData<double>::SerializeBinary(value, stream);
+    cmnData<std::string>::SerializeBinary(text, stream);
+    cmnData<std::vector<double> >::SerializeBinary(doubles, stream);
+    cmnData<std::vector<std::string> >::SerializeBinary(strings, stream);
+    cmnData<std::vector<bool> >::SerializeBinary(bools, stream);
+
+    cmnDataBinaryWriter writer;
+    writer.SerializeBinary(value);
+    writer.SerializeBinary(text);
+    writer.SerializeBinary(doubles);
+    writer.SerializeBinary(strings);
+    writer.SerializeBinary(bools);
+
+    std::string result;
+    writer.ToString(result);
+    CPPUNIT_ASSERT_EQUAL(stream.str(), result);
+    // the vector of doubles is not copied
+    CPPUNIT_ASSERT_EQUAL(doubles.size() * sizeof(double), writer.GetReferencedSize());
+
+    // buffer API for std::vector
+    const size_t size = cmnData<std::vector<double> >::SerializeBinaryByteSize(doubles);
+    CPPUNIT_ASSERT_EQUAL(sizeof(size_t) + doubles.size() * sizeof(double), size);
+    std::vector<char> buffer(size);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0),
+                         cmnData<std::vector<double> >::SerializeBinary(doubles, &(buffer[0]), size - 1));
+    CPPUNIT_ASSERT_EQUAL(size,
+                         cmnData<std::vector<double> >::SerializeBinary(doubles, &(buffer[0]), size));
+    std::stringstream vectorStream;
+    cmnData<std::vector<double> >::SerializeBinary(doubles, vectorStream);
+    CPPUNIT_ASSERT_EQUAL(vectorStream.str(), std::string(&(buffer[0]), size));
+}
+
+CPPUNIT_TEST_SUITE_REGISTRATION(cmnDataBinaryWriterTest);
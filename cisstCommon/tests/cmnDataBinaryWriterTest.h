@@ -0,0 +1,52 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class cmnDataBinaryWriterTest : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(cmnDataBinaryWriterTest);
+    {
+        CPPUNIT_TEST(TestAllocate);
+        CPPUNIT_TEST(TestReference);
+        CPPUNIT_TEST(TestReset);
+        CPPUNIT_TEST(TestSerializeBinary);
+    }
+    CPPUNIT_TEST_SUITE_END();
+
+ public:
+    void setUp(void) {
+    }
+
+    void tearDown(void) {
+    }
+
+    /*! Consecutive allocations are merged in a single segment */
+    void TestAllocate(void);
+
+    /*! Large blocks are referenced, small ones copied */
+    void TestReference(void);
+
+    /*! Memory blocks are reused after reset */
+    void TestReset(void);
+
+    /*! Compare to cmnData::SerializeBinary with a stream */
+    void TestSerializeBinary(void);
+};
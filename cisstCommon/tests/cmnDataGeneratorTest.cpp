@@ -138,6 +138,94 @@ void cmnDataGeneratorTest::TestBinarySerialization(void)
     }
 }
 
+void cmnDataGeneratorTest::TestBinaryFixedSize(void)
+{
+    typedef cmnDataGeneratorTestFixedSize FixedType;
+    typedef cmnDataGeneratorTestFixedSizeDerived DerivedType;
+    const size_t expectedSize = sizeof(double) + sizeof(int) + sizeof(bool) + sizeof(size_t) + 3 * sizeof(double);
+    CPPUNIT_ASSERT(cmnDataBinaryFixedSize<FixedType>::IS_FIXED);
+    CPPUNIT_ASSERT_EQUAL(expectedSize, static_cast<size_t>(cmnDataBinaryFixedSize<FixedType>::BYTE_SIZE));
+    CPPUNIT_ASSERT(cmnDataBinaryFixedSize<DerivedType>::IS_FIXED);
+    CPPUNIT_ASSERT_EQUAL(expectedSize + sizeof(char), static_cast<size_t>(cmnDataBinaryFixedSize<DerivedType>::BYTE_SIZE));
+    // strings and std::vector don't have a fixed size
+    CPPUNIT_ASSERT(!cmnDataBinaryFixedSize<cmnDataGeneratorTestC>::IS_FIXED);
+
+    DerivedType source, destination;
+    source.Double = 1.5;
+    source.Int = -3;
+    source.Bool = true;
+    source.Size = 12345;
+    for (size_t index = 0; index < 3; ++index) {
+        source.CArray[index] = index + 10.0;
+    }
+    source.Char = 'z';
+
+    // same bytes as member by member serialization
+    std::stringstream expected;
+    cmnData<double>::SerializeBinary(source.Double, expected);
+    cmnData<int>::SerializeBinary(source.Int, expected);
+    cmnData<bool>::SerializeBinary(source.Bool, expected);
+    cmnData<size_t>::SerializeBinary(source.Size, expected);
+    cmnData<double[3]>::SerializeBinary(source.CArray, expected);
+    cmnData<char>::SerializeBinary(source.Char, expected);
+    std::stringstream stream;
+    cmnData<DerivedType>::SerializeBinary(source, stream);
+    CPPUNIT_ASSERT_EQUAL(expected.str(), stream.str());
+
+    cmnDataFormat local, remote;
+    CPPUNIT_ASSERT(cmnDataBinaryFixedSizeCompatible(local, remote));
+    cmnData<DerivedType>::DeSerializeBinary(destination, stream, local, remote);
+    CPPUNIT_ASSERT_EQUAL(source.Double, destination.Double);
+    CPPUNIT_ASSERT_EQUAL(source.Int, destination.Int);
+    CPPUNIT_ASSERT_EQUAL(source.Bool, destination.Bool);
+    CPPUNIT_ASSERT_EQUAL(source.Size, destination.Size);
+    for (size_t index = 0; index < 3; ++index) {
+        CPPUNIT_ASSERT_EQUAL(source.CArray[index], destination.CArray[index]);
+    }
+    CPPUNIT_ASSERT_EQUAL(source.Char, destination.Char);
+
+    // buffer
+    const size_t size = cmnData<DerivedType>::SerializeBinaryByteSize(source);
+    CPPUNIT_ASSERT_EQUAL(expectedSize + sizeof(char), size);
+    std::string buffer(size, ' ');
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), cmnData<DerivedType>::SerializeBinary(source, &(buffer[0]), size - 1));
+    CPPUNIT_ASSERT_EQUAL(size, cmnData<DerivedType>::SerializeBinary(source, &(buffer[0]), size));
+    CPPUNIT_ASSERT_EQUAL(expected.str(), buffer);
+    destination.Int = 0;
+    CPPUNIT_ASSERT_EQUAL(size, cmnData<DerivedType>::DeSerializeBinary(destination, buffer.data(), size, local, remote));
+    CPPUNIT_ASSERT_EQUAL(source.Int, destination.Int);
+
+    // buffer with a type without fixed size
+    cmnDataGeneratorTestC sourceC, destinationC;
+    sourceC.StringA() = "not fixed";
+    sourceC.StdVector.resize(3, 4);
+    std::stringstream streamC;
+    cmnData<cmnDataGeneratorTestC>::SerializeBinary(sourceC, streamC);
+    const size_t sizeC = cmnData<cmnDataGeneratorTestC>::SerializeBinaryByteSize(sourceC);
+    CPPUNIT_ASSERT_EQUAL(streamC.str().size(), sizeC);
+    std::string bufferC(sizeC, ' ');
+    CPPUNIT_ASSERT_EQUAL(sizeC, cmnData<cmnDataGeneratorTestC>::SerializeBinary(sourceC, &(bufferC[0]), sizeC));
+    CPPUNIT_ASSERT_EQUAL(streamC.str(), bufferC);
+    CPPUNIT_ASSERT_EQUAL(sizeC, cmnData<cmnDataGeneratorTestC>::DeSerializeBinary(destinationC, bufferC.data(), sizeC, local, remote));
+    CPPUNIT_ASSERT_EQUAL(sourceC.StringA(), destinationC.StringA());
+
+    // layout
+    const cmnDataBinaryLayout & layout = DerivedType::BinaryLayout();
+    CPPUNIT_ASSERT_EQUAL(size, layout.ByteSize);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), layout.Fields.size());
+    CPPUNIT_ASSERT_EQUAL(std::string("cmnDataGeneratorTestFixedSize"), layout.Fields[0].Type);
+    const cmnDataBinaryField * field = layout.Find("Char");
+    CPPUNIT_ASSERT(field);
+    CPPUNIT_ASSERT_EQUAL(expectedSize, field->Offset);
+    CPPUNIT_ASSERT_EQUAL('z', buffer[field->Offset]);
+    field = FixedType::BinaryLayout().Find("Size");
+    CPPUNIT_ASSERT(field);
+    CPPUNIT_ASSERT_EQUAL(sizeof(double) + sizeof(int) + sizeof(bool), field->Offset);
+    CPPUNIT_ASSERT_EQUAL(sizeof(size_t), field->Size);
+    CPPUNIT_ASSERT(!FixedType::BinaryLayout().Find("Unknown"));
+    CPPUNIT_ASSERT(cmnDataGeneratorTestC::BinaryLayout().Fields.empty());
+}
+
 void cmnDataGeneratorTest::TestTextSerialization(void)
 {
     cmnDataGeneratorTestC source, destination;
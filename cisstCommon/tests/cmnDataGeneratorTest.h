@@ -32,6 +32,7 @@ class cmnDataGeneratorTest : public CppUnit::TestFixture
         CPPUNIT_TEST(TestAccessors);
         CPPUNIT_TEST(TestCopy);
         CPPUNIT_TEST(TestBinarySerialization);
+        CPPUNIT_TEST(TestBinaryFixedSize);
         CPPUNIT_TEST(TestTextSerialization);
         CPPUNIT_TEST(TestScalars);
     }
@@ -48,6 +49,7 @@ class cmnDataGeneratorTest : public CppUnit::TestFixture
     void TestAccessors(void);
     void TestCopy(void);
     void TestBinarySerialization(void);
+    void TestBinaryFixedSize(void);
     void TestTextSerialization(void);
     void TestScalars(void);
 };
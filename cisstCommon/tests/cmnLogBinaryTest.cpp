@@ -0,0 +1,293 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+#include "cmnLogBinaryTest.h"
+
+#include <cisstCommon/cmnLogBinary.h>
+
+#include <iomanip>
+#include <sstream>
+
+
+namespace {
+    // decode arguments encoded by cmnLogBinaryArguments
+    std::vector<cmnLogBinaryDecoder::Argument> cmnLogBinaryTestDecode(const cmnLogBinaryArguments & arguments,
+                                                                      bool & truncated)
+    {
+        static const cmnLogBinarySite site = {"test.cpp", 1, CMN_LOG_LEVEL_RUN_ERROR, ""};
+        std::stringstream stream;
+        cmnLogBinaryFormat::WriteHeader(stream);
+        cmnLogBinaryFormat::WriteSite(stream, 0, site);
+        cmnLogBinaryFormat::WriteMessage(stream, 0, 0.0, 0, arguments.Data, arguments.Size);
+        cmnLogBinaryDecoder decoder(stream);
+        cmnLogBinaryDecoder::Message message;
+        CPPUNIT_ASSERT(decoder.Next(message));
+        truncated = message.Truncated;
+        return message.Arguments;
+    }
+}
+
+
+void cmnLogBinaryTest::TestArguments(void)
+{
+    cmnLogBinaryArguments arguments;
+    arguments.Add(-3);
+    arguments.Add(4u);
+    arguments.Add(2.5);
+    arguments.Add('x');
+    arguments.Add(true);
+    arguments.Add("text");
+    arguments.Add(std::string("string"));
+    CPPUNIT_ASSERT(!arguments.Truncated);
+    CPPUNIT_ASSERT_EQUAL(static_cast<char>(cmnLogBinaryArguments::INTEGER), arguments.Data[0]);
+    // tag and value on 8 bytes
+    CPPUNIT_ASSERT_EQUAL(static_cast<char>(cmnLogBinaryArguments::UNSIGNED_INTEGER), arguments.Data[9]);
+
+    bool truncated;
+    const std::vector<cmnLogBinaryDecoder::Argument> decoded = cmnLogBinaryTestDecode(arguments, truncated);
+    CPPUNIT_ASSERT(!truncated);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(7), decoded.size());
+    CPPUNIT_ASSERT_EQUAL(-3LL, decoded[0].Integer);
+    CPPUNIT_ASSERT_EQUAL(4ULL, decoded[1].UnsignedInteger);
+    CPPUNIT_ASSERT_EQUAL(2.5, decoded[2].Double);
+    CPPUNIT_ASSERT_EQUAL(static_cast<long long>('x'), decoded[3].Integer);
+    CPPUNIT_ASSERT_EQUAL(static_cast<char>(cmnLogBinaryArguments::BOOLEAN), decoded[4].Tag);
+    CPPUNIT_ASSERT_EQUAL(1LL, decoded[4].Integer);
+    CPPUNIT_ASSERT_EQUAL(std::string("text"), decoded[5].String);
+    CPPUNIT_ASSERT_EQUAL(std::string("string"), decoded[6].String);
+}
+
+
+void cmnLogBinaryTest::TestTruncation(void)
+{
+    // long string, the beginning is kept
+    cmnLogBinaryArguments arguments;
+    arguments.Add(1);
+    arguments.Add(std::string(1000, 'a'));
+    arguments.Add(2);
+    CPPUNIT_ASSERT(arguments.Truncated);
+    CPPUNIT_ASSERT(arguments.Size <= static_cast<size_t>(cmnLogBinaryArguments::MAXIMUM_SIZE));
+    bool truncated;
+    std::vector<cmnLogBinaryDecoder::Argument> decoded = cmnLogBinaryTestDecode(arguments, truncated);
+    CPPUNIT_ASSERT(truncated);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), decoded.size());
+    CPPUNIT_ASSERT_EQUAL(1LL, decoded[0].Integer);
+    CPPUNIT_ASSERT(decoded[1].String.size() > 400);
+    CPPUNIT_ASSERT_EQUAL(std::string::npos, decoded[1].String.find_first_not_of('a'));
+
+    // too many numbers
+    cmnLogBinaryArguments numbers;
+    for (int index = 0; index < 100; ++index) {
+        numbers.Add(index);
+    }
+    CPPUNIT_ASSERT(numbers.Truncated);
+    CPPUNIT_ASSERT(numbers.Size <= static_cast<size_t>(cmnLogBinaryArguments::MAXIMUM_SIZE));
+    decoded = cmnLogBinaryTestDecode(numbers, truncated);
+    CPPUNIT_ASSERT(truncated);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>((cmnLogBinaryArguments::MAXIMUM_SIZE - 1) / 9), decoded.size());
+    CPPUNIT_ASSERT_EQUAL(10LL, decoded[10].Integer);
+}
+
+
+void cmnLogBinaryTest::TestFormat(void)
+{
+    cmnLogBinaryArguments arguments;
+    arguments.Add(42);
+    arguments.Add(3.14159);
+    arguments.Add("name");
+    arguments.Add(static_cast<unsigned short>(255));
+    arguments.Add(false);
+    bool truncated;
+    const std::vector<cmnLogBinaryDecoder::Argument> decoded = cmnLogBinaryTestDecode(arguments, truncated);
+
+    CPPUNIT_ASSERT_EQUAL(std::string("value 42, 3.14, name, ff, false"),
+                         cmnLogBinaryDecoder::Format("value %d, %.2f, %s, %x, %s", decoded));
+    // length modifiers are replaced and flags are kept
+    CPPUNIT_ASSERT_EQUAL(std::string("[   42] [3.1416] [name  ] [00ff] 100%"),
+                         cmnLogBinaryDecoder::Format("[%5ld] [%.4lf] [%-6s] [%04hx] 100%%", decoded));
+    // missing arguments
+    CPPUNIT_ASSERT_EQUAL(std::string("42 3.14159 name 255 false %d"),
+                         cmnLogBinaryDecoder::Format("%d %g %s %u %s %d", decoded));
+    CPPUNIT_ASSERT_EQUAL(std::string("42 3.14159 name 255 false ..."),
+                         cmnLogBinaryDecoder::Format("%d %g %s %u %s %d", decoded, true));
+}
+
+
+void cmnLogBinaryTest::TestRoundTrip(void)
+{
+    static const cmnLogBinarySite first = {"/path/to/first.cpp", 10, CMN_LOG_LEVEL_INIT_WARNING, "joint %d: %f"};
+    static const cmnLogBinarySite second = {"second.cpp", 20, CMN_LOG_LEVEL_RUN_DEBUG, "no argument"};
+    std::stringstream stream;
+    cmnLogBinaryFormat::WriteHeader(stream);
+    cmnLogBinaryFormat::WriteSite(stream, 0, first);
+    cmnLogBinaryFormat::WriteSite(stream, 1, second);
+    for (int index = 0; index < 3; ++index) {
+        cmnLogBinaryArguments arguments;
+        arguments.Add(index);
+        arguments.Add(index * 0.5);
+        cmnLogBinaryFormat::WriteMessage(stream, 0, 1.0 + index, 7, arguments.Data, arguments.Size);
+    }
+    cmnLogBinaryFormat::WriteMessage(stream, 1, 5.0, 8, 0, 0);
+
+    cmnLogBinaryDecoder decoder(stream);
+    CPPUNIT_ASSERT(decoder.IsValid());
+    cmnLogBinaryDecoder::Message message;
+    for (int index = 0; index < 3; ++index) {
+        CPPUNIT_ASSERT(decoder.Next(message));
+        CPPUNIT_ASSERT_EQUAL(1.0 + index, message.Time);
+        CPPUNIT_ASSERT_EQUAL(7u, message.Thread);
+        CPPUNIT_ASSERT_EQUAL(CMN_LOG_LEVEL_INIT_WARNING, message.Level);
+        CPPUNIT_ASSERT_EQUAL(std::string("/path/to/first.cpp"), message.File);
+        CPPUNIT_ASSERT_EQUAL(10, message.Line);
+        std::stringstream expected;
+        expected << "joint " << index << ": " << std::fixed << std::setprecision(6) << index * 0.5;
+        CPPUNIT_ASSERT_EQUAL(expected.str(), message.Text);
+    }
+    CPPUNIT_ASSERT(decoder.Next(message));
+    CPPUNIT_ASSERT_EQUAL(std::string("no argument"), message.Text);
+    CPPUNIT_ASSERT_EQUAL(CMN_LOG_LEVEL_RUN_DEBUG, message.Level);
+    CPPUNIT_ASSERT(!decoder.Next(message));
+    CPPUNIT_ASSERT(decoder.GetError().empty());
+
+    // text output
+    std::stringstream output;
+    cmnLogBinaryDecoder::ToStream(output, message);
+    CPPUNIT_ASSERT(output.str().find("File: second.cpp Line: 20 - no argument\n") != std::string::npos);
+
+    // truncated file
+    std::string truncatedFile = stream.str();
+    truncatedFile.resize(truncatedFile.size() - 2);
+    std::stringstream truncatedStream(truncatedFile);
+    std::stringstream truncatedOutput;
+    CPPUNIT_ASSERT(!cmnLogBinaryDecoder::Convert(truncatedStream, truncatedOutput));
+    // first three messages are decoded
+    size_t numberOfLines = 0;
+    std::string line;
+    while (std::getline(truncatedOutput, line)) {
+        numberOfLines++;
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), numberOfLines);
+}
+
+
+void cmnLogBinaryTest::TestJSON(void)
+{
+    static const cmnLogBinarySite site = {"json.cpp", 3, CMN_LOG_LEVEL_RUN_ERROR, "say \"%s\" %d"};
+    cmnLogBinaryArguments arguments;
+    arguments.Add("hi\n");
+    arguments.Add(-1);
+    std::stringstream stream;
+    cmnLogBinaryFormat::WriteHeader(stream);
+    cmnLogBinaryFormat::WriteSite(stream, 0, site);
+    cmnLogBinaryFormat::WriteMessage(stream, 0, 0.5, 2, arguments.Data, arguments.Size);
+
+    std::stringstream output;
+    CPPUNIT_ASSERT(cmnLogBinaryDecoder::Convert(stream, output, cmnLogBinaryDecoder::JSON));
+    const std::string json = output.str();
+    CPPUNIT_ASSERT_EQUAL('{', json[0]);
+    CPPUNIT_ASSERT_EQUAL(std::string("}\n"), json.substr(json.size() - 2));
+    CPPUNIT_ASSERT(json.find("\"file\": \"json.cpp\"") != std::string::npos);
+    CPPUNIT_ASSERT(json.find("\"line\": 3") != std::string::npos);
+    CPPUNIT_ASSERT(json.find("\"thread\": 2") != std::string::npos);
+    CPPUNIT_ASSERT(json.find("\"message\": \"say \\\"hi\\n\\\" -1\"") != std::string::npos);
+    CPPUNIT_ASSERT(json.find("\"truncated\"") == std::string::npos);
+}
+
+
+void cmnLogBinaryTest::TestInvalid(void)
+{
+    std::stringstream empty;
+    cmnLogBinaryDecoder emptyDecoder(empty);
+    CPPUNIT_ASSERT(!emptyDecoder.IsValid());
+    CPPUNIT_ASSERT(!emptyDecoder.GetError().empty());
+
+    std::stringstream text("this is not a binary log file at all");
+    cmnLogBinaryDecoder textDecoder(text);
+    CPPUNIT_ASSERT(!textDecoder.IsValid());
+    cmnLogBinaryDecoder::Message message;
+    CPPUNIT_ASSERT(!textDecoder.Next(message));
+
+    // message referring to a site never written
+    std::stringstream stream;
+    cmnLogBinaryFormat::WriteHeader(stream);
+    cmnLogBinaryFormat::WriteMessage(stream, 4, 0.0, 0, 0, 0);
+    cmnLogBinaryDecoder decoder(stream);
+    CPPUNIT_ASSERT(decoder.IsValid());
+    CPPUNIT_ASSERT(!decoder.Next(message));
+    CPPUNIT_ASSERT(!decoder.GetError().empty());
+}
+
+
+namespace {
+    class cmnLogBinaryTestSink: public cmnLogBinarySink
+    {
+    public:
+        std::stringstream Stream;
+        unsigned int NumberOfMessages;
+
+        cmnLogBinaryTestSink(void):
+            NumberOfMessages(0)
+        {
+            cmnLogBinaryFormat::WriteHeader(Stream);
+        }
+
+        void Write(const cmnLogBinarySite & site, const char * arguments, size_t size) {
+            cmnLogBinaryFormat::WriteSite(Stream, NumberOfMessages, site);
+            cmnLogBinaryFormat::WriteMessage(Stream, NumberOfMessages, 0.0, 0, arguments, size);
+            NumberOfMessages++;
+        }
+    };
+}
+
+
+void cmnLogBinaryTest::TestSink(void)
+{
+    cmnLogBinarySink * previousSink = cmnLogger::GetBinarySink();
+    const cmnLogMask previousMask = cmnLogger::GetMask();
+    const cmnLogMask previousMaskFunction = cmnLogger::GetMaskFunction();
+    cmnLogger::SetMask(CMN_LOG_ALLOW_ALL);
+    cmnLogger::SetMaskFunction(CMN_LOG_ALLOW_ERRORS);
+
+    // no sink, nothing sent
+    cmnLogBinaryTestSink sink;
+    cmnLogger::SetBinarySink(0);
+    CMN_LOG_BINARY(CMN_LOG_LEVEL_RUN_ERROR, "ignored %d", 1);
+
+    cmnLogger::SetBinarySink(&sink);
+    CMN_LOG_BINARY(CMN_LOG_LEVEL_RUN_ERROR, "sent %d %s", 2, "times");
+    CMN_LOG_BINARY(CMN_LOG_LEVEL_RUN_VERBOSE, "filtered %d", 3);
+    CMN_LOG_BINARY(CMN_LOG_LEVEL_INIT_ERROR, "no argument");
+    CPPUNIT_ASSERT_EQUAL(2u, sink.NumberOfMessages);
+
+    cmnLogger::SetBinarySink(previousSink);
+    cmnLogger::SetMask(previousMask);
+    cmnLogger::SetMaskFunction(previousMaskFunction);
+
+    cmnLogBinaryDecoder decoder(sink.Stream);
+    cmnLogBinaryDecoder::Message message;
+    CPPUNIT_ASSERT(decoder.Next(message));
+    CPPUNIT_ASSERT_EQUAL(std::string("sent 2 times"), message.Text);
+    CPPUNIT_ASSERT(message.File.find("cmnLogBinaryTest.cpp") != std::string::npos);
+    CPPUNIT_ASSERT(decoder.Next(message));
+    CPPUNIT_ASSERT_EQUAL(std::string("no argument"), message.Text);
+    CPPUNIT_ASSERT_EQUAL(CMN_LOG_LEVEL_INIT_ERROR, message.Level);
+    CPPUNIT_ASSERT(!decoder.Next(message));
+}
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(cmnLogBinaryTest);
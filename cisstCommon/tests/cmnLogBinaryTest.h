@@ -0,0 +1,64 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+
+class cmnLogBinaryTest : public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(cmnLogBinaryTest);
+    {
+        CPPUNIT_TEST(TestArguments);
+        CPPUNIT_TEST(TestTruncation);
+        CPPUNIT_TEST(TestFormat);
+        CPPUNIT_TEST(TestRoundTrip);
+        CPPUNIT_TEST(TestJSON);
+        CPPUNIT_TEST(TestInvalid);
+        CPPUNIT_TEST(TestSink);
+    }
+    CPPUNIT_TEST_SUITE_END();
+
+ public:
+    void setUp(void) {
+    }
+
+    void tearDown(void) {
+    }
+
+    /*! Encode arguments and check the tags */
+    void TestArguments(void);
+
+    /*! Check that arguments which don't fit are dropped */
+    void TestTruncation(void);
+
+    /*! Create text from format and decoded arguments */
+    void TestFormat(void);
+
+    /*! Write records to a stream and decode them */
+    void TestRoundTrip(void);
+
+    /*! Check the JSON output */
+    void TestJSON(void);
+
+    /*! Decode a stream which is not a binary log */
+    void TestInvalid(void);
+
+    /*! Use the macro with a sink */
+    void TestSink(void);
+};
@@ -5,7 +5,7 @@
   Author(s):  Anton Deguet
   Created on: 2010-03-19
 
-  (C) Copyright 2010-2017 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2010-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -36,6 +36,9 @@ CMN_IMPLEMENT_SERVICES_DERIVED(mtsCollectorEvent, mtsCollectorBase)   // derives
 #include <cisstMultiTask/mtsCollectorState.h>
 CMN_IMPLEMENT_SERVICES_DERIVED(mtsCollectorState, mtsCollectorBase)   // derives from mtsTaskFromSignal
 
+#include <cisstMultiTask/mtsCollectorReplay.h>
+CMN_IMPLEMENT_SERVICES_DERIVED(mtsCollectorReplay, mtsTaskContinuous)
+
 #include <cisstMultiTask/mtsCollectorFactory.h>
 CMN_IMPLEMENT_SERVICES(mtsCollectorFactory)
 
@@ -6,7 +6,7 @@
   Author(s):  Min Yang Jung, Anton Deguet
   Created on: 2009-03-20
 
-  (C) Copyright 2009-2011 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -106,6 +106,7 @@ void mtsCollectorBase::SetOutput(const std::string & fileName,
 {
     CMN_LOG_CLASS_INIT_DEBUG << "SetOutput: file \"" << fileName
                              << "\" using file format \"" << fileFormat << "\"" << std::endl;
+    this->FlushOutput();
     // test if there was a file opened before
     if (this->OutputFile) {
         CMN_LOG_CLASS_INIT_VERBOSE << "SetOutput: closing file \"" << this->OutputFileName << "\"" << std::endl;
@@ -144,6 +145,9 @@ void mtsCollectorBase::SetOutput(const std::string & fileName,
         case COLLECTOR_FILE_FORMAT_PLAIN_TEXT:
             ext = ".txt";
             break;
+        case COLLECTOR_FILE_FORMAT_BINARY_COLUMNAR:
+            ext = ".ccol";
+            break;
         default:
             ext = ".cdat";
             break;
@@ -179,6 +183,7 @@ void mtsCollectorBase::SetOutput(const std::string & fileName,
 
 void mtsCollectorBase::CloseOutput(void)
 {
+    this->FlushOutput();
     if (this->FileOpened) {
         CMN_LOG_CLASS_INIT_VERBOSE << "CloseOutput: closing file \"" << this->OutputFileName << "\"" << std::endl;
         this->OutputFile->close();
@@ -213,6 +218,12 @@ void mtsCollectorBase::OpenFileIfNeeded(void)
         this->OutputHeaderFile->open(this->OutputHeaderFileName.c_str(), std::ios::trunc);
         this->FileOpened = true;
         break;
+    case COLLECTOR_FILE_FORMAT_BINARY_COLUMNAR:
+        // data file is created by the derived class, only open the header file
+        CMN_LOG_CLASS_INIT_VERBOSE << "SetOutput: opening header file \"" << this->OutputHeaderFileName << "\" for columnar output" << std::endl;
+        this->OutputHeaderFile->open(this->OutputHeaderFileName.c_str(), std::ios::trunc);
+        this->FileOpened = true;
+        break;
     default:
         CMN_LOG_CLASS_INIT_ERROR << "SetOutput: unexpected file format.";
         break;
@@ -233,6 +244,8 @@ void mtsCollectorBase::SetOutputToDefault(const CollectorFileFormat fileFormat)
         suffix = "txt";
     } else if (fileFormat == COLLECTOR_FILE_FORMAT_CSV) {
         suffix = "csv";
+    } else if (fileFormat == COLLECTOR_FILE_FORMAT_BINARY_COLUMNAR) {
+        suffix = "ccol";
     } else {
         suffix = "cdat"; // for cisst dat
     }
@@ -267,6 +280,11 @@ void mtsCollectorBase::SetOutputToDefault(void)
 void mtsCollectorBase::SetOutput(std::ostream & outputStream, const CollectorFileFormat fileFormat)
 {
     CMN_LOG_CLASS_INIT_DEBUG << "SetOutput: using user provided output stream with file format \"" << fileFormat << "\"" << std::endl;
+    if (fileFormat == COLLECTOR_FILE_FORMAT_BINARY_COLUMNAR) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetOutput: columnar format requires a file name, can't use a stream" << std::endl;
+        return;
+    }
+    this->FlushOutput();
     // test if there was a file opened before
     if (this->OutputFile) {
         CMN_LOG_CLASS_INIT_VERBOSE << "SetOutput: closing file \"" << this->OutputFileName << "\"" << std::endl;
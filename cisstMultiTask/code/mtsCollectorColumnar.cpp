@@ -0,0 +1,191 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstMultiTask/mtsCollectorColumnar.h>
+
+
+const char * mtsCollectorColumnar::Magic(void)
+{
+    static const char magic[MAGIC_SIZE + 1] = "cisstCOL";
+    return magic;
+}
+
+
+size_t mtsCollectorColumnar::ColumnDirectoryEntrySize(void)
+{
+    // encoding, stride, offset, stored size, raw size
+    return 2 * sizeof(unsigned int) + 3 * sizeof(unsigned long long);
+}
+
+
+size_t mtsCollectorColumnar::ChunkHeaderSize(void)
+{
+    // magic, number of rows, first/last ticks, first/last times,
+    // data size, number of columns, reserved
+    return 2 * sizeof(unsigned int) + 2 * sizeof(unsigned long long) + 2 * sizeof(double)
+        + sizeof(unsigned long long) + 2 * sizeof(unsigned int);
+}
+
+
+size_t mtsCollectorColumnar::ChunkIndexEntrySize(void)
+{
+    // file offset, first row, number of rows, first/last ticks, first/last times
+    return 5 * sizeof(unsigned long long) + 2 * sizeof(double);
+}
+
+
+size_t mtsCollectorColumnar::FooterTrailerSize(void)
+{
+    // index offset, number of chunks, magic
+    return sizeof(unsigned long long) + 2 * sizeof(unsigned int);
+}
+
+
+void mtsCollectorColumnar::Append(std::vector<char> & buffer, const std::string & value)
+{
+    const unsigned int length = static_cast<unsigned int>(value.size());
+    Append(buffer, length);
+    buffer.insert(buffer.end(), value.begin(), value.end());
+}
+
+
+bool mtsCollectorColumnar::Read(const char * & data, const char * end, std::string & value)
+{
+    unsigned int length;
+    if (!Read(data, end, length)) {
+        return false;
+    }
+    if (static_cast<size_t>(end - data) < length) {
+        return false;
+    }
+    value.assign(data, length);
+    data += length;
+    return true;
+}
+
+
+bool mtsCollectorColumnar::Encode(const char * input, const size_t size, const size_t stride,
+                                  std::vector<char> & output)
+{
+    if ((stride == 0) || (size == 0) || (size % stride != 0)) {
+        return false;
+    }
+    const size_t numberOfRecords = size / stride;
+
+    // group bytes by position in record and xor with previous byte
+    std::vector<unsigned char> transformed(size);
+    unsigned char previous = 0;
+    size_t position = 0;
+    for (size_t byte = 0; byte < stride; ++byte) {
+        const unsigned char * source = reinterpret_cast<const unsigned char *>(input) + byte;
+        for (size_t record = 0; record < numberOfRecords; ++record) {
+            const unsigned char current = source[record * stride];
+            transformed[position] = current ^ previous;
+            previous = current;
+            ++position;
+        }
+    }
+
+    // encode runs, control byte < 0x80 for literals, >= 0x80 for zeros
+    output.clear();
+    output.reserve(size);
+    size_t index = 0;
+    while (index < size) {
+        if (output.size() >= size) {
+            return false; // no gain
+        }
+        if (transformed[index] == 0) {
+            size_t run = 1;
+            while ((index + run < size) && (transformed[index + run] == 0) && (run < 128)) {
+                ++run;
+            }
+            output.push_back(static_cast<char>(0x80 + (run - 1)));
+            index += run;
+        } else {
+            // literal until two consecutive zeros
+            size_t run = 1;
+            while ((index + run < size) && (run < 128)
+                   && !((transformed[index + run] == 0)
+                        && ((index + run + 1 >= size) || (transformed[index + run + 1] == 0)))) {
+                ++run;
+            }
+            output.push_back(static_cast<char>(run - 1));
+            output.insert(output.end(),
+                          reinterpret_cast<const char *>(&(transformed[index])),
+                          reinterpret_cast<const char *>(&(transformed[index])) + run);
+            index += run;
+        }
+    }
+    return (output.size() < size);
+}
+
+
+bool mtsCollectorColumnar::Decode(const char * input, const size_t inputSize,
+                                  const size_t size, const size_t stride,
+                                  std::vector<char> & output)
+{
+    if ((stride == 0) || (size % stride != 0)) {
+        return false;
+    }
+    const size_t numberOfRecords = size / stride;
+
+    // decode runs
+    std::vector<unsigned char> transformed(size);
+    const unsigned char * data = reinterpret_cast<const unsigned char *>(input);
+    const unsigned char * end = data + inputSize;
+    size_t position = 0;
+    while (data < end) {
+        const unsigned char control = *data;
+        ++data;
+        if (control >= 0x80) {
+            const size_t run = static_cast<size_t>(control - 0x80) + 1;
+            if (position + run > size) {
+                return false;
+            }
+            memset(&(transformed[position]), 0, run);
+            position += run;
+        } else {
+            const size_t run = static_cast<size_t>(control) + 1;
+            if ((position + run > size) || (static_cast<size_t>(end - data) < run)) {
+                return false;
+            }
+            memcpy(&(transformed[position]), data, run);
+            position += run;
+            data += run;
+        }
+    }
+    if (position != size) {
+        return false;
+    }
+
+    // undo xor and put bytes back in records
+    output.resize(size);
+    if (size == 0) {
+        return true;
+    }
+    unsigned char previous = 0;
+    position = 0;
+    for (size_t byte = 0; byte < stride; ++byte) {
+        unsigned char * destination = reinterpret_cast<unsigned char *>(&(output[0])) + byte;
+        for (size_t record = 0; record < numberOfRecords; ++record) {
+            previous = transformed[position] ^ previous;
+            destination[record * stride] = previous;
+            ++position;
+        }
+    }
+    return true;
+}
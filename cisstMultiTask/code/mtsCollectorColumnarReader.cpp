@@ -0,0 +1,596 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstCommon/cmnPortability.h>
+#include <cisstCommon/cmnLogger.h>
+#include <cisstCommon/cmnClassRegister.h>
+#include <cisstMultiTask/mtsCollectorColumnarReader.h>
+
+#include <cstdio>
+#include <istream>
+#include <streambuf>
+
+#if (CISST_OS != CISST_WINDOWS)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+
+namespace {
+    /*! Read only stream buffer on a memory block, used to deserialize
+      records without copying them. */
+    class mtsCollectorColumnarMemoryBuffer: public std::streambuf {
+    public:
+        mtsCollectorColumnarMemoryBuffer(const char * data, const size_t size) {
+            char * begin = const_cast<char *>(data);
+            this->setg(begin, begin, begin + size);
+        }
+    };
+
+    inline unsigned long long mtsCollectorColumnarGetOffset(const char * offsets, const size_t index) {
+        unsigned long long offset;
+        memcpy(&offset, offsets + index * sizeof(unsigned long long), sizeof(unsigned long long));
+        return offset;
+    }
+}
+
+
+mtsCollectorColumnarReader::mtsCollectorColumnarReader(void):
+    Data(0),
+    Size(0),
+    Mapped(false),
+    TimeOrigin(0.0),
+    HeaderSize(0),
+    NumberOfRows(0),
+    IndexRecovered(false),
+    CachedChunk(0)
+{}
+
+
+mtsCollectorColumnarReader::~mtsCollectorColumnarReader(void)
+{
+    this->Close();
+}
+
+
+bool mtsCollectorColumnarReader::Map(void)
+{
+#if (CISST_OS != CISST_WINDOWS)
+    const int fileDescriptor = open(this->FileName.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorColumnarReader::Map: unable to open \"" << this->FileName << "\"" << std::endl;
+        return false;
+    }
+    struct stat status;
+    if ((fstat(fileDescriptor, &status) == 0) && (status.st_size > 0)) {
+        void * address = mmap(0, status.st_size, PROT_READ, MAP_SHARED, fileDescriptor, 0);
+        if (address != MAP_FAILED) {
+            close(fileDescriptor);
+            this->Data = static_cast<const char *>(address);
+            this->Size = status.st_size;
+            this->Mapped = true;
+            return true;
+        }
+    }
+    close(fileDescriptor);
+#endif
+    // load the whole file if it can't be mapped
+    FILE * file = fopen(this->FileName.c_str(), "rb");
+    if (!file) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorColumnarReader::Map: unable to open \"" << this->FileName << "\"" << std::endl;
+        return false;
+    }
+    this->Loaded.clear();
+    char buffer[64 * 1024];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        this->Loaded.insert(this->Loaded.end(), buffer, buffer + read);
+    }
+    fclose(file);
+    if (this->Loaded.empty()) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorColumnarReader::Map: file \"" << this->FileName << "\" is empty" << std::endl;
+        return false;
+    }
+    this->Data = &(this->Loaded[0]);
+    this->Size = this->Loaded.size();
+    this->Mapped = false;
+    return true;
+}
+
+
+void mtsCollectorColumnarReader::Unmap(void)
+{
+#if (CISST_OS != CISST_WINDOWS)
+    if (this->Mapped && this->Data) {
+        munmap(const_cast<char *>(this->Data), this->Size);
+    }
+#endif
+    std::vector<char>().swap(this->Loaded);
+    this->Data = 0;
+    this->Size = 0;
+    this->Mapped = false;
+}
+
+
+bool mtsCollectorColumnarReader::Open(const std::string & fileName)
+{
+    this->Close();
+    this->FileName = fileName;
+    if (!this->Map()) {
+        return false;
+    }
+    if (!this->ReadHeader()) {
+        this->Close();
+        return false;
+    }
+    if (!this->ReadFooter()) {
+        CMN_LOG_INIT_WARNING << "mtsCollectorColumnarReader::Open: index not found in \"" << fileName
+                             << "\", scanning chunks" << std::endl;
+        this->RebuildIndex();
+    }
+    CMN_LOG_INIT_VERBOSE << "mtsCollectorColumnarReader::Open: file \"" << fileName << "\" contains "
+                         << this->NumberOfRows << " row(s) in " << this->Chunks.size() << " chunk(s)" << std::endl;
+    return true;
+}
+
+
+void mtsCollectorColumnarReader::Close(void)
+{
+    this->Unmap();
+    this->ComponentName.clear();
+    this->StateTableName.clear();
+    this->DateTime.clear();
+    this->TimeOrigin = 0.0;
+    this->SignalNames.clear();
+    this->SignalClassNames.clear();
+    this->HeaderSize = 0;
+    this->Chunks.clear();
+    this->NumberOfRows = 0;
+    this->IndexRecovered = false;
+    this->Columns.clear();
+    this->CachedChunk = 0;
+}
+
+
+bool mtsCollectorColumnarReader::ReadHeader(void)
+{
+    const char * data = this->Data;
+    const char * end = this->Data + this->Size;
+    if ((this->Size < mtsCollectorColumnar::MAGIC_SIZE)
+        || (memcmp(data, mtsCollectorColumnar::Magic(), mtsCollectorColumnar::MAGIC_SIZE) != 0)) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorColumnarReader::ReadHeader: \"" << this->FileName
+                           << "\" is not a columnar log file" << std::endl;
+        return false;
+    }
+    data += mtsCollectorColumnar::MAGIC_SIZE;
+    unsigned int version, endianness, bodySize;
+    if (!mtsCollectorColumnar::Read(data, end, version)
+        || !mtsCollectorColumnar::Read(data, end, endianness)
+        || !mtsCollectorColumnar::Read(data, end, bodySize)) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorColumnarReader::ReadHeader: header truncated in \"" << this->FileName << "\"" << std::endl;
+        return false;
+    }
+    if (version != mtsCollectorColumnar::VERSION) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorColumnarReader::ReadHeader: unsupported version " << version
+                           << " in \"" << this->FileName << "\"" << std::endl;
+        return false;
+    }
+    if (endianness != mtsCollectorColumnar::ENDIANNESS_MARKER) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorColumnarReader::ReadHeader: \"" << this->FileName
+                           << "\" has been created on a platform with a different byte order" << std::endl;
+        return false;
+    }
+    if (static_cast<size_t>(end - data) < bodySize) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorColumnarReader::ReadHeader: header truncated in \"" << this->FileName << "\"" << std::endl;
+        return false;
+    }
+    end = data + bodySize;
+    this->HeaderSize = end - this->Data;
+    unsigned int numberOfSignals;
+    if (!mtsCollectorColumnar::Read(data, end, this->ComponentName)
+        || !mtsCollectorColumnar::Read(data, end, this->StateTableName)
+        || !mtsCollectorColumnar::Read(data, end, this->DateTime)
+        || !mtsCollectorColumnar::Read(data, end, this->TimeOrigin)
+        || !mtsCollectorColumnar::Read(data, end, numberOfSignals)) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorColumnarReader::ReadHeader: invalid header in \"" << this->FileName << "\"" << std::endl;
+        return false;
+    }
+    this->SignalNames.resize(numberOfSignals);
+    this->SignalClassNames.resize(numberOfSignals);
+    for (unsigned int signal = 0; signal < numberOfSignals; ++signal) {
+        if (!mtsCollectorColumnar::Read(data, end, this->SignalNames[signal])
+            || !mtsCollectorColumnar::Read(data, end, this->SignalClassNames[signal])) {
+            CMN_LOG_INIT_ERROR << "mtsCollectorColumnarReader::ReadHeader: invalid signal description in \""
+                               << this->FileName << "\"" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+
+bool mtsCollectorColumnarReader::ReadFooter(void)
+{
+    const size_t trailerSize = mtsCollectorColumnar::FooterTrailerSize();
+    if (this->Size < this->HeaderSize + trailerSize) {
+        return false;
+    }
+    const char * data = this->Data + this->Size - trailerSize;
+    const char * end = this->Data + this->Size;
+    unsigned long long indexOffset;
+    unsigned int numberOfChunks, magic;
+    mtsCollectorColumnar::Read(data, end, indexOffset);
+    mtsCollectorColumnar::Read(data, end, numberOfChunks);
+    mtsCollectorColumnar::Read(data, end, magic);
+    if ((magic != mtsCollectorColumnar::FOOTER_MAGIC)
+        || (indexOffset < this->HeaderSize)
+        || (indexOffset + static_cast<unsigned long long>(numberOfChunks) * mtsCollectorColumnar::ChunkIndexEntrySize()
+            != this->Size - trailerSize)) {
+        return false;
+    }
+    data = this->Data + indexOffset;
+    end = this->Data + this->Size - trailerSize;
+    this->Chunks.resize(numberOfChunks);
+    this->NumberOfRows = 0;
+    for (unsigned int chunk = 0; chunk < numberOfChunks; ++chunk) {
+        ChunkInfo & info = this->Chunks[chunk];
+        mtsCollectorColumnar::Read(data, end, info.FileOffset);
+        mtsCollectorColumnar::Read(data, end, info.FirstRow);
+        mtsCollectorColumnar::Read(data, end, info.NumberOfRows);
+        mtsCollectorColumnar::Read(data, end, info.FirstTick);
+        mtsCollectorColumnar::Read(data, end, info.LastTick);
+        mtsCollectorColumnar::Read(data, end, info.FirstTime);
+        mtsCollectorColumnar::Read(data, end, info.LastTime);
+        if ((info.FirstRow != this->NumberOfRows) || (info.FileOffset >= indexOffset)) {
+            this->Chunks.clear();
+            this->NumberOfRows = 0;
+            return false;
+        }
+        this->NumberOfRows += info.NumberOfRows;
+    }
+    return true;
+}
+
+
+bool mtsCollectorColumnarReader::ReadChunkHeader(const unsigned long long fileOffset, ChunkInfo & info,
+                                                 unsigned long long & totalSize) const
+{
+    if (fileOffset >= this->Size) {
+        return false;
+    }
+    const char * data = this->Data + fileOffset;
+    const char * end = this->Data + this->Size;
+    unsigned int magic, numberOfRows, numberOfColumns, reserved;
+    unsigned long long dataSize;
+    if (!mtsCollectorColumnar::Read(data, end, magic)
+        || (magic != mtsCollectorColumnar::CHUNK_MAGIC)
+        || !mtsCollectorColumnar::Read(data, end, numberOfRows)
+        || !mtsCollectorColumnar::Read(data, end, info.FirstTick)
+        || !mtsCollectorColumnar::Read(data, end, info.LastTick)
+        || !mtsCollectorColumnar::Read(data, end, info.FirstTime)
+        || !mtsCollectorColumnar::Read(data, end, info.LastTime)
+        || !mtsCollectorColumnar::Read(data, end, dataSize)
+        || !mtsCollectorColumnar::Read(data, end, numberOfColumns)
+        || !mtsCollectorColumnar::Read(data, end, reserved)) {
+        return false;
+    }
+    if (numberOfColumns != mtsCollectorColumnar::FIRST_SIGNAL_COLUMN + this->SignalNames.size()) {
+        return false;
+    }
+    info.FileOffset = fileOffset;
+    info.NumberOfRows = numberOfRows;
+    totalSize = mtsCollectorColumnar::ChunkHeaderSize()
+        + numberOfColumns * mtsCollectorColumnar::ColumnDirectoryEntrySize()
+        + dataSize;
+    return (fileOffset + totalSize <= this->Size);
+}
+
+
+void mtsCollectorColumnarReader::RebuildIndex(void)
+{
+    this->IndexRecovered = true;
+    this->Chunks.clear();
+    this->NumberOfRows = 0;
+    unsigned long long fileOffset = this->HeaderSize;
+    ChunkInfo info;
+    unsigned long long totalSize;
+    while (this->ReadChunkHeader(fileOffset, info, totalSize)) {
+        info.FirstRow = this->NumberOfRows;
+        this->Chunks.push_back(info);
+        this->NumberOfRows += info.NumberOfRows;
+        fileOffset += totalSize;
+    }
+}
+
+
+bool mtsCollectorColumnarReader::LoadChunk(const size_t chunkIndex)
+{
+    if (!this->Columns.empty() && (this->CachedChunk == chunkIndex)) {
+        return true;
+    }
+    this->Columns.clear();
+    ChunkInfo info;
+    unsigned long long totalSize;
+    if (!this->ReadChunkHeader(this->Chunks[chunkIndex].FileOffset, info, totalSize)) {
+        CMN_LOG_RUN_ERROR << "mtsCollectorColumnarReader::LoadChunk: invalid chunk " << chunkIndex
+                          << " in \"" << this->FileName << "\"" << std::endl;
+        return false;
+    }
+    const size_t numberOfColumns = mtsCollectorColumnar::FIRST_SIGNAL_COLUMN + this->SignalNames.size();
+    const char * directory = this->Data + info.FileOffset + mtsCollectorColumnar::ChunkHeaderSize();
+    const char * directoryEnd = directory + numberOfColumns * mtsCollectorColumnar::ColumnDirectoryEntrySize();
+    const char * chunkData = directoryEnd;
+    const unsigned long long dataSize = totalSize - (directoryEnd - (this->Data + info.FileOffset));
+    std::vector<Column> columns(numberOfColumns);
+    for (size_t index = 0; index < numberOfColumns; ++index) {
+        unsigned int encoding, stride;
+        unsigned long long offset, storedSize, rawSize;
+        mtsCollectorColumnar::Read(directory, directoryEnd, encoding);
+        mtsCollectorColumnar::Read(directory, directoryEnd, stride);
+        mtsCollectorColumnar::Read(directory, directoryEnd, offset);
+        mtsCollectorColumnar::Read(directory, directoryEnd, storedSize);
+        mtsCollectorColumnar::Read(directory, directoryEnd, rawSize);
+        Column & column = columns[index];
+        if (offset + storedSize > dataSize) {
+            CMN_LOG_RUN_ERROR << "mtsCollectorColumnarReader::LoadChunk: invalid column " << index
+                              << " in chunk " << chunkIndex << " of \"" << this->FileName << "\"" << std::endl;
+            return false;
+        }
+        const char * stored = chunkData + offset;
+        column.Stride = stride;
+        column.Offsets = 0;
+        if (stride == 0) {
+            // offsets table followed by records
+            const size_t offsetsSize = (info.NumberOfRows + 1) * sizeof(unsigned long long);
+            if (storedSize < offsetsSize) {
+                CMN_LOG_RUN_ERROR << "mtsCollectorColumnarReader::LoadChunk: invalid offsets for column " << index
+                                  << " in chunk " << chunkIndex << " of \"" << this->FileName << "\"" << std::endl;
+                return false;
+            }
+            column.Offsets = stored;
+            column.Data = stored + offsetsSize;
+            column.Size = storedSize - offsetsSize;
+        } else if (encoding == mtsCollectorColumnar::ENCODING_SHUFFLE_XOR_RLE) {
+            if (!mtsCollectorColumnar::Decode(stored, storedSize, rawSize, stride, column.Decoded)) {
+                CMN_LOG_RUN_ERROR << "mtsCollectorColumnarReader::LoadChunk: failed to decode column " << index
+                                  << " in chunk " << chunkIndex << " of \"" << this->FileName << "\"" << std::endl;
+                return false;
+            }
+            column.Data = column.Decoded.empty() ? 0 : &(column.Decoded[0]);
+            column.Size = column.Decoded.size();
+        } else {
+            column.Data = stored;
+            column.Size = storedSize;
+        }
+        if ((stride != 0) && (column.Size != info.NumberOfRows * stride)) {
+            CMN_LOG_RUN_ERROR << "mtsCollectorColumnarReader::LoadChunk: unexpected size for column " << index
+                              << " in chunk " << chunkIndex << " of \"" << this->FileName << "\"" << std::endl;
+            return false;
+        }
+    }
+    this->Columns.swap(columns);
+    // decoded data pointers must be updated after the swap
+    for (size_t index = 0; index < numberOfColumns; ++index) {
+        Column & column = this->Columns[index];
+        if (!column.Decoded.empty()) {
+            column.Data = &(column.Decoded[0]);
+        }
+    }
+    this->CachedChunk = chunkIndex;
+    return true;
+}
+
+
+bool mtsCollectorColumnarReader::LoadRow(const unsigned long long row, size_t & rowInChunk)
+{
+    if (row >= this->NumberOfRows) {
+        CMN_LOG_RUN_ERROR << "mtsCollectorColumnarReader::LoadRow: row " << row
+                          << " out of range, file \"" << this->FileName << "\" contains "
+                          << this->NumberOfRows << " row(s)" << std::endl;
+        return false;
+    }
+    // binary search for last chunk with first row less or equal to row
+    size_t low = 0;
+    size_t high = this->Chunks.size();
+    while (high - low > 1) {
+        const size_t middle = (low + high) / 2;
+        if (this->Chunks[middle].FirstRow <= row) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+    if (!this->LoadChunk(low)) {
+        return false;
+    }
+    rowInChunk = static_cast<size_t>(row - this->Chunks[low].FirstRow);
+    return true;
+}
+
+
+unsigned long long mtsCollectorColumnarReader::LowerBound(const double time, const bool strict)
+{
+    // find chunk using the index, then row using the time column
+    size_t chunk = 0;
+    size_t chunkEnd = this->Chunks.size();
+    while (chunk < chunkEnd) {
+        const size_t middle = (chunk + chunkEnd) / 2;
+        const double lastTime = this->Chunks[middle].LastTime;
+        if (strict ? (lastTime <= time) : (lastTime < time)) {
+            chunk = middle + 1;
+        } else {
+            chunkEnd = middle;
+        }
+    }
+    if (chunk == this->Chunks.size()) {
+        return this->NumberOfRows;
+    }
+    unsigned long long low = this->Chunks[chunk].FirstRow;
+    unsigned long long high = low + this->Chunks[chunk].NumberOfRows;
+    double rowTime;
+    while (low < high) {
+        const unsigned long long middle = (low + high) / 2;
+        if (!this->GetTime(middle, rowTime)) {
+            return this->NumberOfRows;
+        }
+        if (strict ? (rowTime <= time) : (rowTime < time)) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+
+const std::string & mtsCollectorColumnarReader::GetSignalName(const size_t signal) const
+{
+    return this->SignalNames.at(signal);
+}
+
+
+const std::string & mtsCollectorColumnarReader::GetSignalClassName(const size_t signal) const
+{
+    return this->SignalClassNames.at(signal);
+}
+
+
+bool mtsCollectorColumnarReader::GetSignalIndex(const std::string & signalName, size_t & signal) const
+{
+    for (signal = 0; signal < this->SignalNames.size(); ++signal) {
+        if (this->SignalNames[signal] == signalName) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
+bool mtsCollectorColumnarReader::FindRows(const double startTime, const double endTime,
+                                          unsigned long long & firstRow, unsigned long long & endRow)
+{
+    firstRow = this->LowerBound(startTime, false);
+    endRow = this->LowerBound(endTime, true);
+    if (endRow < firstRow) {
+        endRow = firstRow;
+    }
+    return (firstRow < endRow);
+}
+
+
+bool mtsCollectorColumnarReader::GetTicks(const unsigned long long row, unsigned long long & ticks)
+{
+    size_t rowInChunk;
+    if (!this->LoadRow(row, rowInChunk)) {
+        return false;
+    }
+    memcpy(&ticks, this->Columns[mtsCollectorColumnar::COLUMN_TICKS].Data + rowInChunk * sizeof(ticks), sizeof(ticks));
+    return true;
+}
+
+
+bool mtsCollectorColumnarReader::GetTime(const unsigned long long row, double & time)
+{
+    size_t rowInChunk;
+    if (!this->LoadRow(row, rowInChunk)) {
+        return false;
+    }
+    memcpy(&time, this->Columns[mtsCollectorColumnar::COLUMN_TIME].Data + rowInChunk * sizeof(time), sizeof(time));
+    return true;
+}
+
+
+bool mtsCollectorColumnarReader::GetSignalRaw(const size_t signal, const unsigned long long row,
+                                              const char * & data, size_t & size)
+{
+    if (signal >= this->SignalNames.size()) {
+        CMN_LOG_RUN_ERROR << "mtsCollectorColumnarReader::GetSignalRaw: signal " << signal
+                          << " out of range, file \"" << this->FileName << "\" contains "
+                          << this->SignalNames.size() << " signal(s)" << std::endl;
+        return false;
+    }
+    size_t rowInChunk;
+    if (!this->LoadRow(row, rowInChunk)) {
+        return false;
+    }
+    const Column & column = this->Columns[mtsCollectorColumnar::FIRST_SIGNAL_COLUMN + signal];
+    if (column.Stride != 0) {
+        data = column.Data + rowInChunk * column.Stride;
+        size = column.Stride;
+        return true;
+    }
+    const unsigned long long begin = mtsCollectorColumnarGetOffset(column.Offsets, rowInChunk);
+    const unsigned long long end = mtsCollectorColumnarGetOffset(column.Offsets, rowInChunk + 1);
+    if ((begin > end) || (end > column.Size)) {
+        CMN_LOG_RUN_ERROR << "mtsCollectorColumnarReader::GetSignalRaw: invalid offsets for row " << row
+                          << " in \"" << this->FileName << "\"" << std::endl;
+        return false;
+    }
+    data = column.Data + begin;
+    size = static_cast<size_t>(end - begin);
+    return true;
+}
+
+
+bool mtsCollectorColumnarReader::GetSignal(const size_t signal, const unsigned long long row,
+                                           mtsGenericObject & object)
+{
+    const char * data;
+    size_t size;
+    if (!this->GetSignalRaw(signal, row, data, size)) {
+        return false;
+    }
+    if (object.Services()->GetName() != this->SignalClassNames[signal]) {
+        CMN_LOG_RUN_ERROR << "mtsCollectorColumnarReader::GetSignal: type mismatch for signal \""
+                          << this->SignalNames[signal] << "\", expected " << this->SignalClassNames[signal]
+                          << ", received " << object.Services()->GetName() << std::endl;
+        return false;
+    }
+    mtsCollectorColumnarMemoryBuffer buffer(data, size);
+    std::istream stream(&buffer);
+    try {
+        object.DeSerializeRaw(stream);
+    } catch (std::exception & exception) {
+        CMN_LOG_RUN_ERROR << "mtsCollectorColumnarReader::GetSignal: failed to deserialize signal \""
+                          << this->SignalNames[signal] << "\" for row " << row << ": "
+                          << exception.what() << std::endl;
+        return false;
+    }
+    return !stream.fail();
+}
+
+
+mtsGenericObject * mtsCollectorColumnarReader::CreateSignalObject(const size_t signal) const
+{
+    if (signal >= this->SignalClassNames.size()) {
+        return 0;
+    }
+    const cmnClassServicesBase * services = cmnClassRegister::FindClassServices(this->SignalClassNames[signal]);
+    if (!services) {
+        CMN_LOG_RUN_ERROR << "mtsCollectorColumnarReader::CreateSignalObject: class \""
+                          << this->SignalClassNames[signal] << "\" is not registered" << std::endl;
+        return 0;
+    }
+    cmnGenericObject * object = services->Create();
+    mtsGenericObject * result = dynamic_cast<mtsGenericObject *>(object);
+    if (!result) {
+        delete object;
+    }
+    return result;
+}
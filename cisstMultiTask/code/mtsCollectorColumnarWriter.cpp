@@ -0,0 +1,457 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstCommon/cmnLogger.h>
+#include <cisstMultiTask/mtsCollectorColumnarWriter.h>
+
+#include <ostream>
+#include <streambuf>
+
+
+/*! Stream buffer appending characters to a vector, used to serialize
+  elements directly in a column without intermediate string. */
+class mtsCollectorColumnarWriter::ColumnStreamBuffer: public std::streambuf
+{
+public:
+    std::vector<char> * Column;
+
+    ColumnStreamBuffer(void):
+        Column(0)
+    {}
+
+protected:
+    int_type overflow(int_type character) {
+        if (character != traits_type::eof()) {
+            Column->push_back(static_cast<char>(character));
+        }
+        return traits_type::not_eof(character);
+    }
+
+    std::streamsize xsputn(const char * data, std::streamsize size) {
+        Column->insert(Column->end(), data, data + size);
+        return size;
+    }
+};
+
+
+mtsCollectorColumnarWriter::Chunk::Chunk(void):
+    NumberOfRows(0),
+    FirstTick(0),
+    LastTick(0),
+    FirstTime(0.0),
+    LastTime(0.0)
+{}
+
+
+void mtsCollectorColumnarWriter::Chunk::Resize(const size_t numberOfColumns)
+{
+    Columns.resize(numberOfColumns);
+    Offsets.resize(numberOfColumns);
+    Strides.resize(numberOfColumns);
+    Clear();
+}
+
+
+void mtsCollectorColumnarWriter::Chunk::Clear(void)
+{
+    NumberOfRows = 0;
+    // clear keeps the capacity so memory is reused for the next chunk
+    for (size_t column = 0; column < Columns.size(); ++column) {
+        Columns[column].clear();
+        Offsets[column].clear();
+        Strides[column] = 0;
+    }
+    if (Strides.size() > mtsCollectorColumnar::COLUMN_TIME) {
+        Strides[mtsCollectorColumnar::COLUMN_TICKS] = sizeof(unsigned long long);
+        Strides[mtsCollectorColumnar::COLUMN_TIME] = sizeof(double);
+    }
+}
+
+
+mtsCollectorColumnarWriter::mtsCollectorColumnarWriter(void):
+    File(0),
+    Compression(true),
+    ChunkSize(1024),
+    NumberOfSignals(0),
+    NumberOfRows(0),
+    FileOffset(0),
+    Error(false),
+    Filling(&(Chunks[0])),
+    Writing(&(Chunks[1])),
+    CurrentSignal(0),
+    NumberOfChunks(0),
+    ThreadRunning(false),
+    ChunkPending(false),
+    StopRequested(false),
+    NumberOfRowsWritten(0)
+{
+    StreamBuffer = new ColumnStreamBuffer;
+    Stream = new std::ostream(StreamBuffer);
+}
+
+
+mtsCollectorColumnarWriter::~mtsCollectorColumnarWriter(void)
+{
+    if (this->File) {
+        this->Close();
+    }
+    delete Stream;
+    delete StreamBuffer;
+}
+
+
+void mtsCollectorColumnarWriter::SetChunkSize(const size_t numberOfRows)
+{
+    if (this->File) {
+        CMN_LOG_RUN_ERROR << "mtsCollectorColumnarWriter::SetChunkSize: can't change chunk size, file \""
+                          << this->FileName << "\" is already opened" << std::endl;
+        return;
+    }
+    this->ChunkSize = (numberOfRows > 0) ? numberOfRows : 1;
+}
+
+
+void mtsCollectorColumnarWriter::SetCompression(const bool compression)
+{
+    this->Compression = compression;
+}
+
+
+bool mtsCollectorColumnarWriter::Open(const std::string & fileName,
+                                      const std::string & componentName,
+                                      const std::string & stateTableName,
+                                      const std::string & dateTime,
+                                      const double timeOrigin,
+                                      const std::vector<std::string> & signalNames,
+                                      const std::vector<std::string> & signalClassNames)
+{
+    if (this->File) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorColumnarWriter::Open: file \"" << this->FileName
+                           << "\" is already opened" << std::endl;
+        return false;
+    }
+    if (signalNames.size() != signalClassNames.size()) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorColumnarWriter::Open: number of signal names and class names don't match" << std::endl;
+        return false;
+    }
+    this->File = fopen(fileName.c_str(), "wb");
+    if (!this->File) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorColumnarWriter::Open: unable to create file \"" << fileName << "\"" << std::endl;
+        return false;
+    }
+    this->FileName = fileName;
+    this->NumberOfSignals = signalNames.size();
+    this->NumberOfRows = 0;
+    this->NumberOfRowsWritten = 0;
+    this->FileOffset = 0;
+    this->Error = false;
+    this->NumberOfChunks = 0;
+    this->ChunkIndex.clear();
+    this->CurrentSignal = 0;
+    const size_t numberOfColumns = mtsCollectorColumnar::FIRST_SIGNAL_COLUMN + this->NumberOfSignals;
+    this->Chunks[0].Resize(numberOfColumns);
+    this->Chunks[1].Resize(numberOfColumns);
+
+    // header
+    std::vector<char> body;
+    mtsCollectorColumnar::Append(body, componentName);
+    mtsCollectorColumnar::Append(body, stateTableName);
+    mtsCollectorColumnar::Append(body, dateTime);
+    mtsCollectorColumnar::Append(body, timeOrigin);
+    mtsCollectorColumnar::Append(body, static_cast<unsigned int>(this->NumberOfSignals));
+    for (size_t signal = 0; signal < this->NumberOfSignals; ++signal) {
+        mtsCollectorColumnar::Append(body, signalNames[signal]);
+        mtsCollectorColumnar::Append(body, signalClassNames[signal]);
+    }
+    std::vector<char> header(mtsCollectorColumnar::Magic(),
+                             mtsCollectorColumnar::Magic() + mtsCollectorColumnar::MAGIC_SIZE);
+    mtsCollectorColumnar::Append(header, static_cast<unsigned int>(mtsCollectorColumnar::VERSION));
+    mtsCollectorColumnar::Append(header, static_cast<unsigned int>(mtsCollectorColumnar::ENDIANNESS_MARKER));
+    mtsCollectorColumnar::Append(header, static_cast<unsigned int>(body.size()));
+    header.insert(header.end(), body.begin(), body.end());
+    if (!this->WriteBytes(&(header[0]), header.size())) {
+        CMN_LOG_INIT_ERROR << "mtsCollectorColumnarWriter::Open: unable to write header in \"" << fileName << "\"" << std::endl;
+        fclose(this->File);
+        this->File = 0;
+        return false;
+    }
+
+    // start writer thread
+    this->ChunkPending = false;
+    this->StopRequested = false;
+    this->Thread.Create<mtsCollectorColumnarWriter, int>(this, &mtsCollectorColumnarWriter::WriterThread,
+                                                         0, "ColWriter");
+    this->ThreadRunning = true;
+    CMN_LOG_INIT_VERBOSE << "mtsCollectorColumnarWriter::Open: file \"" << fileName << "\" created for "
+                         << this->NumberOfSignals << " signal(s)" << std::endl;
+    return true;
+}
+
+
+void mtsCollectorColumnarWriter::BeginRow(const unsigned long long ticks, const double time)
+{
+    Chunk & chunk = *(this->Filling);
+    if (chunk.NumberOfRows == 0) {
+        chunk.FirstTick = ticks;
+        chunk.FirstTime = time;
+    }
+    chunk.LastTick = ticks;
+    chunk.LastTime = time;
+    mtsCollectorColumnar::Append(chunk.Columns[mtsCollectorColumnar::COLUMN_TICKS], ticks);
+    mtsCollectorColumnar::Append(chunk.Columns[mtsCollectorColumnar::COLUMN_TIME], time);
+    this->CurrentSignal = 0;
+}
+
+
+void mtsCollectorColumnarWriter::AddElement(const mtsGenericObject & element)
+{
+    if (this->CurrentSignal >= this->NumberOfSignals) {
+        CMN_LOG_RUN_ERROR << "mtsCollectorColumnarWriter::AddElement: too many elements for row, file \""
+                          << this->FileName << "\" expects " << this->NumberOfSignals << " signal(s)" << std::endl;
+        return;
+    }
+    Chunk & chunk = *(this->Filling);
+    const size_t column = mtsCollectorColumnar::FIRST_SIGNAL_COLUMN + this->CurrentSignal;
+    std::vector<char> & data = chunk.Columns[column];
+    const size_t offset = data.size();
+    chunk.Offsets[column].push_back(offset);
+    this->StreamBuffer->Column = &data;
+    element.SerializeRaw(*(this->Stream));
+    // keep stride only if all records have the same size
+    const size_t size = data.size() - offset;
+    if (chunk.NumberOfRows == 0) {
+        chunk.Strides[column] = size;
+    } else if (chunk.Strides[column] != size) {
+        chunk.Strides[column] = 0;
+    }
+    this->CurrentSignal++;
+}
+
+
+void mtsCollectorColumnarWriter::EndRow(void)
+{
+    if (this->CurrentSignal != this->NumberOfSignals) {
+        CMN_LOG_RUN_ERROR << "mtsCollectorColumnarWriter::EndRow: expected " << this->NumberOfSignals
+                          << " element(s) but received " << this->CurrentSignal
+                          << " for file \"" << this->FileName << "\"" << std::endl;
+        // complete the row with empty records so columns remain aligned
+        Chunk & chunk = *(this->Filling);
+        for (; this->CurrentSignal < this->NumberOfSignals; ++(this->CurrentSignal)) {
+            const size_t column = mtsCollectorColumnar::FIRST_SIGNAL_COLUMN + this->CurrentSignal;
+            chunk.Offsets[column].push_back(chunk.Columns[column].size());
+            chunk.Strides[column] = 0;
+        }
+    }
+    this->Filling->NumberOfRows++;
+    this->NumberOfRows++;
+    if (this->Filling->NumberOfRows >= this->ChunkSize) {
+        this->HandOffChunk();
+    }
+}
+
+
+void mtsCollectorColumnarWriter::Flush(void)
+{
+    if (!this->File) {
+        return;
+    }
+    if (this->Filling->NumberOfRows > 0) {
+        this->HandOffChunk();
+    }
+    this->WaitForPendingChunk();
+    fflush(this->File);
+}
+
+
+bool mtsCollectorColumnarWriter::Close(void)
+{
+    if (!this->File) {
+        return false;
+    }
+    this->Flush();
+
+    // stop writer thread
+    if (this->ThreadRunning) {
+        this->Mutex.Lock();
+        this->StopRequested = true;
+        this->Mutex.Unlock();
+        this->ChunkReadySignal.Raise();
+        this->Thread.Wait();
+        this->ThreadRunning = false;
+    }
+
+    // footer
+    const unsigned long long indexOffset = this->FileOffset;
+    std::vector<char> trailer;
+    mtsCollectorColumnar::Append(trailer, indexOffset);
+    mtsCollectorColumnar::Append(trailer, this->NumberOfChunks);
+    mtsCollectorColumnar::Append(trailer, static_cast<unsigned int>(mtsCollectorColumnar::FOOTER_MAGIC));
+    if (!this->ChunkIndex.empty()) {
+        this->WriteBytes(&(this->ChunkIndex[0]), this->ChunkIndex.size());
+    }
+    this->WriteBytes(&(trailer[0]), trailer.size());
+
+    if (fclose(this->File) != 0) {
+        this->Error = true;
+    }
+    this->File = 0;
+    CMN_LOG_INIT_VERBOSE << "mtsCollectorColumnarWriter::Close: file \"" << this->FileName << "\" closed, "
+                         << this->NumberOfRows << " row(s) in " << this->NumberOfChunks << " chunk(s)" << std::endl;
+    return !this->Error;
+}
+
+
+void mtsCollectorColumnarWriter::WaitForPendingChunk(void)
+{
+    this->Mutex.Lock();
+    while (this->ChunkPending) {
+        this->Mutex.Unlock();
+        this->ChunkWrittenSignal.Wait();
+        this->Mutex.Lock();
+    }
+    this->Mutex.Unlock();
+}
+
+
+void mtsCollectorColumnarWriter::HandOffChunk(void)
+{
+    // only blocks if the writer thread is late
+    this->WaitForPendingChunk();
+    Chunk * full = this->Filling;
+    this->Filling = this->Writing;
+    this->Writing = full;
+    this->Filling->Clear();
+    this->Mutex.Lock();
+    this->ChunkPending = true;
+    this->Mutex.Unlock();
+    this->ChunkReadySignal.Raise();
+}
+
+
+void * mtsCollectorColumnarWriter::WriterThread(int CMN_UNUSED(data))
+{
+    bool pending, stop;
+    do {
+        this->ChunkReadySignal.Wait();
+        this->Mutex.Lock();
+        pending = this->ChunkPending;
+        stop = this->StopRequested;
+        this->Mutex.Unlock();
+        if (pending) {
+            const bool result = this->WriteChunk(*(this->Writing));
+            this->Mutex.Lock();
+            if (!result) {
+                this->Error = true;
+            }
+            this->ChunkPending = false;
+            this->Mutex.Unlock();
+            this->ChunkWrittenSignal.Raise();
+        }
+    } while (!stop);
+    return 0;
+}
+
+
+bool mtsCollectorColumnarWriter::WriteBytes(const char * data, const size_t size)
+{
+    if (fwrite(data, 1, size, this->File) != size) {
+        CMN_LOG_RUN_ERROR << "mtsCollectorColumnarWriter::WriteBytes: failed to write " << size
+                          << " byte(s) in \"" << this->FileName << "\"" << std::endl;
+        return false;
+    }
+    this->FileOffset += size;
+    return true;
+}
+
+
+bool mtsCollectorColumnarWriter::WriteChunk(const Chunk & chunk)
+{
+    const size_t numberOfColumns = chunk.Columns.size();
+    const size_t headerSize = mtsCollectorColumnar::ChunkHeaderSize()
+        + numberOfColumns * mtsCollectorColumnar::ColumnDirectoryEntrySize();
+
+    // directory is filled after the columns have been encoded
+    std::vector<char> & buffer = this->ChunkBuffer;
+    buffer.resize(headerSize);
+    std::vector<char> directory;
+    directory.reserve(numberOfColumns * mtsCollectorColumnar::ColumnDirectoryEntrySize());
+
+    for (size_t column = 0; column < numberOfColumns; ++column) {
+        const std::vector<char> & data = chunk.Columns[column];
+        const size_t stride = chunk.Strides[column];
+        const unsigned long long offset = buffer.size() - headerSize;
+        unsigned int encoding = mtsCollectorColumnar::ENCODING_RAW;
+        unsigned long long rawSize;
+        if (stride != 0) {
+            rawSize = data.size();
+            if (this->Compression
+                && mtsCollectorColumnar::Encode(data.empty() ? 0 : &(data[0]), data.size(), stride,
+                                                this->EncodedColumn)) {
+                encoding = mtsCollectorColumnar::ENCODING_SHUFFLE_XOR_RLE;
+                buffer.insert(buffer.end(), this->EncodedColumn.begin(), this->EncodedColumn.end());
+            } else {
+                buffer.insert(buffer.end(), data.begin(), data.end());
+            }
+        } else {
+            // variable size records, offsets first (including end of last record)
+            const std::vector<unsigned long long> & offsets = chunk.Offsets[column];
+            for (size_t row = 0; row < offsets.size(); ++row) {
+                mtsCollectorColumnar::Append(buffer, offsets[row]);
+            }
+            mtsCollectorColumnar::Append(buffer, static_cast<unsigned long long>(data.size()));
+            buffer.insert(buffer.end(), data.begin(), data.end());
+            rawSize = (buffer.size() - headerSize) - offset;
+        }
+        const unsigned long long storedSize = (buffer.size() - headerSize) - offset;
+        mtsCollectorColumnar::Append(directory, encoding);
+        mtsCollectorColumnar::Append(directory, static_cast<unsigned int>(stride));
+        mtsCollectorColumnar::Append(directory, offset);
+        mtsCollectorColumnar::Append(directory, storedSize);
+        mtsCollectorColumnar::Append(directory, rawSize);
+    }
+
+    // chunk header
+    std::vector<char> header;
+    header.reserve(mtsCollectorColumnar::ChunkHeaderSize());
+    mtsCollectorColumnar::Append(header, static_cast<unsigned int>(mtsCollectorColumnar::CHUNK_MAGIC));
+    mtsCollectorColumnar::Append(header, static_cast<unsigned int>(chunk.NumberOfRows));
+    mtsCollectorColumnar::Append(header, chunk.FirstTick);
+    mtsCollectorColumnar::Append(header, chunk.LastTick);
+    mtsCollectorColumnar::Append(header, chunk.FirstTime);
+    mtsCollectorColumnar::Append(header, chunk.LastTime);
+    mtsCollectorColumnar::Append(header, static_cast<unsigned long long>(buffer.size() - headerSize));
+    mtsCollectorColumnar::Append(header, static_cast<unsigned int>(numberOfColumns));
+    mtsCollectorColumnar::Append(header, static_cast<unsigned int>(0)); // reserved
+    memcpy(&(buffer[0]), &(header[0]), header.size());
+    memcpy(&(buffer[header.size()]), &(directory[0]), directory.size());
+
+    // index entry
+    const unsigned long long chunkOffset = this->FileOffset;
+    if (!this->WriteBytes(&(buffer[0]), buffer.size())) {
+        return false;
+    }
+    mtsCollectorColumnar::Append(this->ChunkIndex, chunkOffset);
+    mtsCollectorColumnar::Append(this->ChunkIndex, this->NumberOfRowsWritten);
+    mtsCollectorColumnar::Append(this->ChunkIndex, static_cast<unsigned long long>(chunk.NumberOfRows));
+    mtsCollectorColumnar::Append(this->ChunkIndex, chunk.FirstTick);
+    mtsCollectorColumnar::Append(this->ChunkIndex, chunk.LastTick);
+    mtsCollectorColumnar::Append(this->ChunkIndex, chunk.FirstTime);
+    mtsCollectorColumnar::Append(this->ChunkIndex, chunk.LastTime);
+    this->NumberOfRowsWritten += chunk.NumberOfRows;
+    this->NumberOfChunks++;
+    return true;
+}
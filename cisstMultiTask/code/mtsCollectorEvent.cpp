@@ -6,7 +6,7 @@
   Author(s):  Anton Deguet
   Created on: 2010-02-12
 
-  (C) Copyright 2010-2011 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2010-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -102,7 +102,9 @@ mtsCollectorEvent::mtsCollectorEvent(const std::string & collectorName,
     Collecting(false),
     ScheduledStartTime(0.0),
     ScheduledStopTime(0.0),
-    TimeServer(0)
+    TimeServer(0),
+    ColumnarWriter(0),
+    NumberOfEventsWritten(0)
 {
     this->SetOutputToDefault(fileFormat);
     this->ObservedComponents.SetOwner(*this);
@@ -112,6 +114,7 @@ mtsCollectorEvent::mtsCollectorEvent(const std::string & collectorName,
 
 mtsCollectorEvent::~mtsCollectorEvent()
 {
+    this->FlushOutput();
 }
 
 
@@ -482,8 +485,13 @@ void mtsCollectorEvent::SaveEventVoid(const CollectorEventVoid * event)
             this->OpenFileIfNeeded();
             this->PrintHeader(this->FileFormat);
         }
-        *(this->OutputStream) << mtsTaskManager::GetInstance()->GetTimeServer().GetRelativeTime()
-                              << this->Delimiter << event->EventId << std::endl;
+        if (this->FileFormat == COLLECTOR_FILE_FORMAT_BINARY_COLUMNAR) {
+            this->SaveEventColumnar(this->TimeServer->GetRelativeTime(),
+                                    event->ComponentName, event->InterfaceName, event->EventName, 0);
+        } else {
+            *(this->OutputStream) << mtsTaskManager::GetInstance()->GetTimeServer().GetRelativeTime()
+                                  << this->Delimiter << event->EventId << std::endl;
+        }
         this->SampleCounter++;
         this->SampleCounterForEvent++;
     }
@@ -499,10 +507,15 @@ void mtsCollectorEvent::SaveEventWrite(const CollectorEventWrite * event, const
             this->OpenFileIfNeeded();
             this->PrintHeader(this->FileFormat);
         }
-        *(this->OutputStream) << mtsTaskManager::GetInstance()->GetTimeServer().GetRelativeTime()
-                              << this->Delimiter << event->EventId << this->Delimiter;
-        payload.ToStreamRaw(*(this->OutputStream), this->Delimiter);
-        *(this->OutputStream) << std::endl;
+        if (this->FileFormat == COLLECTOR_FILE_FORMAT_BINARY_COLUMNAR) {
+            this->SaveEventColumnar(this->TimeServer->GetRelativeTime(),
+                                    event->ComponentName, event->InterfaceName, event->EventName, &payload);
+        } else {
+            *(this->OutputStream) << mtsTaskManager::GetInstance()->GetTimeServer().GetRelativeTime()
+                                  << this->Delimiter << event->EventId << this->Delimiter;
+            payload.ToStreamRaw(*(this->OutputStream), this->Delimiter);
+            *(this->OutputStream) << std::endl;
+        }
         this->SampleCounter++;
         this->SampleCounterForEvent++;
     }
@@ -514,30 +527,39 @@ void mtsCollectorEvent::PrintHeader(const CollectorFileFormat & fileFormat)
     std::string currentDateTime;
     osaGetDateTimeString(currentDateTime);
 
-    if (this->OutputStream) {
+    // for the columnar format, the data file is created by the
+    // columnar writer so the description goes in the header file
+    std::ostream * outputStream = this->OutputStream;
+    if (fileFormat == COLLECTOR_FILE_FORMAT_BINARY_COLUMNAR) {
+        outputStream = this->OutputHeaderStream;
+    }
+
+    if (outputStream) {
         // Print out some information on the state table.
 
         // All lines in the header should be preceded by '#' which represents
         // the line contains header information rather than collected data.
-        *(this->OutputStream) << "# Date & time        : " << currentDateTime << std::endl;
-        *(this->OutputStream) << "# Total event count : " << (this->EventCounter - 1) << std::endl;
-        *(this->OutputStream) << "# Data format        : ";
+        *outputStream << "# Date & time        : " << currentDateTime << std::endl;
+        *outputStream << "# Total event count : " << (this->EventCounter - 1) << std::endl;
+        *outputStream << "# Data format        : ";
         if (fileFormat == COLLECTOR_FILE_FORMAT_PLAIN_TEXT) {
-            *(this->OutputStream) << "Text";
+            *outputStream << "Text";
         } else if (fileFormat == COLLECTOR_FILE_FORMAT_CSV) {
-            *(this->OutputStream) << "Text (CSV)";
+            *outputStream << "Text (CSV)";
+        } else if (fileFormat == COLLECTOR_FILE_FORMAT_BINARY_COLUMNAR) {
+            *outputStream << "Columnar";
         } else {
-            *(this->OutputStream) << "Binary";
+            *outputStream << "Binary";
         }
-        *(this->OutputStream) << std::endl;
-        *(this->OutputStream) << "#" << std::endl;
+        *outputStream << std::endl;
+        *outputStream << "#" << std::endl;
 
         size_t index;
         for (index = 0; index < this->EventsVoid.size(); index++) {
-            (this->EventsVoid[index])->PrintHeader(*(this->OutputStream), fileFormat);
+            (this->EventsVoid[index])->PrintHeader(*outputStream, fileFormat);
         }
         for (index = 0; index < this->EventsWrite.size(); index++) {
-            (this->EventsWrite[index])->PrintHeader(*(this->OutputStream), fileFormat);
+            (this->EventsWrite[index])->PrintHeader(*outputStream, fileFormat);
         }
 
         // In case of using binary format
@@ -548,10 +570,84 @@ void mtsCollectorEvent::PrintHeader(const CollectorFileFormat & fileFormat)
         CMN_LOG_CLASS_RUN_ERROR << "PrintHeader: output stream for collector \""
                                 << this->GetName() << "\" is not available." << std::endl;
     }
+    if (fileFormat == COLLECTOR_FILE_FORMAT_BINARY_COLUMNAR) {
+        this->OpenColumnarWriter();
+    }
     this->FirstRunningFlag = false;
 }
 
 
+bool mtsCollectorEvent::OpenColumnarWriter(void)
+{
+    this->FlushOutput();
+    std::string currentDateTime;
+    osaGetDateTimeString(currentDateTime);
+    osaAbsoluteTime origin;
+    this->TimeServer->GetTimeOrigin(origin);
+    std::vector<std::string> signalNames, signalClassNames;
+    signalNames.push_back("Component");
+    signalNames.push_back("Interface");
+    signalNames.push_back("Event");
+    signalClassNames.resize(signalNames.size(), mtsStdString::ClassServices()->GetName());
+    signalNames.push_back("Payload");
+    signalClassNames.push_back(mtsStdCharVecProxy::ClassServices()->GetName());
+    this->ColumnarWriter = new mtsCollectorColumnarWriter;
+    this->NumberOfEventsWritten = 0;
+    if (!this->ColumnarWriter->Open(this->OutputFileName, this->GetName(), "Events",
+                                    currentDateTime, origin.ToSeconds(),
+                                    signalNames, signalClassNames)) {
+        CMN_LOG_CLASS_INIT_ERROR << "OpenColumnarWriter: unable to create columnar file \""
+                                 << this->OutputFileName << "\" for collector \"" << this->GetName() << "\"" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+void mtsCollectorEvent::FlushOutput(void)
+{
+    if (this->ColumnarWriter) {
+        if (this->ColumnarWriter->IsOpen() && !this->ColumnarWriter->Close()) {
+            CMN_LOG_CLASS_RUN_ERROR << "FlushOutput: failed to write columnar file \""
+                                    << this->OutputFileName << "\"" << std::endl;
+        }
+        delete this->ColumnarWriter;
+        this->ColumnarWriter = 0;
+    }
+}
+
+
+void mtsCollectorEvent::SaveEventColumnar(const double time,
+                                          const std::string & componentName,
+                                          const std::string & interfaceName,
+                                          const std::string & eventName,
+                                          const mtsGenericObject * payload)
+{
+    if (!(this->ColumnarWriter && this->ColumnarWriter->IsOpen())) {
+        CMN_LOG_CLASS_RUN_ERROR << "SaveEventColumnar: columnar output for collector \""
+                                << this->GetName() << "\" is not available." << std::endl;
+        return;
+    }
+    this->ComponentElement.Data = componentName;
+    this->InterfaceElement.Data = interfaceName;
+    this->EventElement.Data = eventName;
+    this->PayloadElement.Data.clear();
+    if (payload) {
+        this->PayloadStream.str("");
+        payload->SerializeRaw(this->PayloadStream);
+        const std::string serialized = this->PayloadStream.str();
+        this->PayloadElement.Data.assign(serialized.begin(), serialized.end());
+    }
+    this->ColumnarWriter->BeginRow(this->NumberOfEventsWritten, time);
+    this->ColumnarWriter->AddElement(this->ComponentElement);
+    this->ColumnarWriter->AddElement(this->InterfaceElement);
+    this->ColumnarWriter->AddElement(this->EventElement);
+    this->ColumnarWriter->AddElement(this->PayloadElement);
+    this->ColumnarWriter->EndRow();
+    this->NumberOfEventsWritten++;
+}
+
+
 void mtsCollectorEvent::StartCollection(const mtsDouble & delay)
 {
     const double currentTime = this->TimeServer->GetRelativeTime();
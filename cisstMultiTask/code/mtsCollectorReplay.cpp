@@ -0,0 +1,511 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstCommon/cmnUnits.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstOSAbstraction/osaSleep.h>
+#include <cisstMultiTask/mtsCollectorReplay.h>
+#include <cisstMultiTask/mtsStateTable.h>
+#include <cisstMultiTask/mtsInterfaceProvided.h>
+#include <cisstMultiTask/mtsManagerLocal.h>
+#include <cisstMultiTask/mtsMulticastCommandVoid.h>
+#include <cisstMultiTask/mtsMulticastCommandWriteBase.h>
+
+#include <limits>
+
+
+mtsCollectorReplay::Source::Source(void):
+    StateTable(0),
+    ComponentSignal(0),
+    InterfaceSignal(0),
+    EventSignal(0),
+    PayloadSignal(0),
+    NextRow(0),
+    NextTime(0.0)
+{
+}
+
+
+mtsCollectorReplay::Source::~Source()
+{
+    EventTargetsType::iterator target;
+    for (target = EventTargets.begin(); target != EventTargets.end(); ++target) {
+        delete target->second.Argument;
+    }
+}
+
+
+mtsCollectorReplay::mtsCollectorReplay(const std::string & name):
+    mtsTaskContinuous(name),
+    Rate(0.0),
+    Playing(false),
+    FinishedTriggered(false),
+    VirtualTime(0.0),
+    WallStart(0.0),
+    VirtualStart(0.0),
+    BatchSize(1000),
+    NumberOfRowsReplayed(0)
+{
+    SetupControlInterface();
+}
+
+
+mtsCollectorReplay::~mtsCollectorReplay()
+{
+    for (size_t index = 0; index < this->Sources.size(); ++index) {
+        delete this->Sources[index];
+    }
+}
+
+
+void mtsCollectorReplay::SetupControlInterface(void)
+{
+    mtsInterfaceProvided * interfaceProvided = AddInterfaceProvided("Control");
+    if (interfaceProvided) {
+        interfaceProvided->AddCommandVoid(&mtsCollectorReplay::Play, this, "Play");
+        interfaceProvided->AddCommandVoid(&mtsCollectorReplay::Pause, this, "Pause");
+        interfaceProvided->AddCommandVoid(&mtsCollectorReplay::StepCommand, this, "Step");
+        interfaceProvided->AddCommandWrite(&mtsCollectorReplay::SetRateCommand, this, "SetRate");
+        interfaceProvided->AddCommandWrite(&mtsCollectorReplay::SeekCommand, this, "Seek");
+        interfaceProvided->AddCommandRead(&mtsCollectorReplay::GetVirtualTimeCommand, this, "GetVirtualTime");
+        interfaceProvided->AddEventWrite(this->SteppedEvent, "Stepped", mtsDouble());
+        interfaceProvided->AddEventVoid(this->FinishedEvent, "Finished");
+    }
+}
+
+
+bool mtsCollectorReplay::AddSource(const std::string & fileName,
+                                   const std::string & componentName,
+                                   const std::string & stateTableName)
+{
+    Source * source = new Source;
+    source->FileName = fileName;
+    if (!source->Reader.Open(fileName)) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddSource: failed to open \"" << fileName << "\"" << std::endl;
+        delete source;
+        return false;
+    }
+    const std::string component = componentName.empty() ? source->Reader.GetComponentName() : componentName;
+    const std::string table = stateTableName.empty() ? source->Reader.GetStateTableName() : stateTableName;
+
+    mtsComponent * target = mtsManagerLocal::GetInstance()->GetComponent(component);
+    if (!target) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddSource: can't find component \"" << component
+                                 << "\" for file \"" << fileName << "\"" << std::endl;
+        delete source;
+        return false;
+    }
+    if (!target->GetReplayMode()) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddSource: component \"" << component
+                                 << "\" is not in replay mode" << std::endl;
+        delete source;
+        return false;
+    }
+    source->StateTable = target->GetStateTable(table);
+    if (!source->StateTable) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddSource: can't find state table \"" << table
+                                 << "\" in component \"" << component << "\"" << std::endl;
+        delete source;
+        return false;
+    }
+
+    // match logged signals and state table elements, Toc, Tic and
+    // Period are computed by the state table itself
+    for (size_t signal = 0; signal < source->Reader.GetNumberOfSignals(); ++signal) {
+        const std::string & signalName = source->Reader.GetSignalName(signal);
+        if ((signalName == "Toc") || (signalName == "Tic") || (signalName == "Period")) {
+            continue;
+        }
+        const int id = source->StateTable->GetStateVectorID(signalName);
+        mtsGenericObject * element = (id < 0) ? 0 : source->StateTable->GetStateVectorElement(id);
+        if (!element) {
+            CMN_LOG_CLASS_INIT_WARNING << "AddSource: signal \"" << signalName << "\" from \"" << fileName
+                                       << "\" not found in state table \"" << table << "\", it will be ignored" << std::endl;
+            continue;
+        }
+        if (element->Services()->GetName() != source->Reader.GetSignalClassName(signal)) {
+            CMN_LOG_CLASS_INIT_WARNING << "AddSource: signal \"" << signalName << "\" from \"" << fileName
+                                       << "\" has type \"" << source->Reader.GetSignalClassName(signal)
+                                       << "\" but state table element is \"" << element->Services()->GetName()
+                                       << "\", it will be ignored" << std::endl;
+            continue;
+        }
+        source->Signals.push_back(std::make_pair(signal, static_cast<size_t>(id)));
+    }
+    if (source->Signals.empty()) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddSource: no signal from \"" << fileName
+                                 << "\" matches state table \"" << table << "\"" << std::endl;
+        delete source;
+        return false;
+    }
+
+    // replayed data keeps the logged timestamps
+    source->StateTable->SetAutomaticAdvance(false);
+    for (size_t index = 0; index < source->StateTable->GetNumberOfElements(); ++index) {
+        mtsGenericObject * element = source->StateTable->GetStateVectorElement(index);
+        if (element) {
+            element->SetAutomaticTimestamp(false);
+        }
+    }
+
+    source->NextRow = 0;
+    UpdateNextTime(*source);
+    this->Sources.push_back(source);
+    this->FinishedTriggered = false;
+    CMN_LOG_CLASS_INIT_VERBOSE << "AddSource: replaying " << source->Signals.size() << " signal(s) and "
+                               << source->Reader.GetNumberOfRows() << " row(s) from \"" << fileName
+                               << "\" in state table \"" << table << "\" of component \""
+                               << component << "\"" << std::endl;
+    return true;
+}
+
+
+bool mtsCollectorReplay::AddEventSource(const std::string & fileName)
+{
+    Source * source = new Source;
+    source->FileName = fileName;
+    if (!source->Reader.Open(fileName)) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddEventSource: failed to open \"" << fileName << "\"" << std::endl;
+        delete source;
+        return false;
+    }
+
+    // check that all signals saved by mtsCollectorEvent are present
+    const std::string stringClassName = mtsStdString::ClassServices()->GetName();
+    const std::string payloadClassName = mtsStdCharVecProxy::ClassServices()->GetName();
+    if (!(source->Reader.GetSignalIndex("Component", source->ComponentSignal)
+          && source->Reader.GetSignalIndex("Interface", source->InterfaceSignal)
+          && source->Reader.GetSignalIndex("Event", source->EventSignal)
+          && source->Reader.GetSignalIndex("Payload", source->PayloadSignal)
+          && (source->Reader.GetSignalClassName(source->ComponentSignal) == stringClassName)
+          && (source->Reader.GetSignalClassName(source->InterfaceSignal) == stringClassName)
+          && (source->Reader.GetSignalClassName(source->EventSignal) == stringClassName)
+          && (source->Reader.GetSignalClassName(source->PayloadSignal) == payloadClassName))) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddEventSource: \"" << fileName
+                                 << "\" is not an event log created by mtsCollectorEvent" << std::endl;
+        delete source;
+        return false;
+    }
+
+    source->NextRow = 0;
+    UpdateNextTime(*source);
+    this->Sources.push_back(source);
+    this->FinishedTriggered = false;
+    CMN_LOG_CLASS_INIT_VERBOSE << "AddEventSource: replaying " << source->Reader.GetNumberOfRows()
+                               << " event(s) from \"" << fileName << "\"" << std::endl;
+    return true;
+}
+
+
+void mtsCollectorReplay::FindEventTarget(EventTarget & target, const bool isVoid)
+{
+    target.EventVoid = 0;
+    target.EventWrite = 0;
+    target.Argument = 0;
+    const std::string & componentName = this->ComponentElement.Data;
+    const std::string & interfaceName = this->InterfaceElement.Data;
+    const std::string & eventName = this->EventElement.Data;
+
+    mtsComponent * component = mtsManagerLocal::GetInstance()->GetComponent(componentName);
+    if (!component) {
+        CMN_LOG_CLASS_RUN_WARNING << "FindEventTarget: can't find component \"" << componentName
+                                  << "\", its events will be ignored" << std::endl;
+        return;
+    }
+    if (!component->GetReplayMode()) {
+        CMN_LOG_CLASS_RUN_WARNING << "FindEventTarget: component \"" << componentName
+                                  << "\" is not in replay mode, its events will be ignored" << std::endl;
+        return;
+    }
+    mtsInterfaceProvided * interfaceProvided = component->GetInterfaceProvided(interfaceName);
+    if (!interfaceProvided) {
+        CMN_LOG_CLASS_RUN_WARNING << "FindEventTarget: can't find provided interface \"" << interfaceName
+                                  << "\" in component \"" << componentName << "\", its events will be ignored" << std::endl;
+        return;
+    }
+    if (isVoid) {
+        target.EventVoid = interfaceProvided->GetEventVoid(eventName);
+    } else {
+        target.EventWrite = interfaceProvided->GetEventWrite(eventName);
+        if (target.EventWrite && target.EventWrite->GetArgumentPrototype()) {
+            target.Argument =
+                dynamic_cast<mtsGenericObject *>(target.EventWrite->GetArgumentPrototype()->Services()->Create());
+        }
+        if (!target.Argument) {
+            target.EventWrite = 0;
+        }
+    }
+    if (!(target.EventVoid || target.EventWrite)) {
+        CMN_LOG_CLASS_RUN_WARNING << "FindEventTarget: can't find event " << (isVoid ? "void" : "write")
+                                  << " \"" << eventName << "\" in interface \"" << interfaceName
+                                  << "\" of component \"" << componentName << "\", it will be ignored" << std::endl;
+    }
+}
+
+
+void mtsCollectorReplay::ReplayEvent(Source & source)
+{
+    if (!(source.Reader.GetSignal(source.ComponentSignal, source.NextRow, this->ComponentElement)
+          && source.Reader.GetSignal(source.InterfaceSignal, source.NextRow, this->InterfaceElement)
+          && source.Reader.GetSignal(source.EventSignal, source.NextRow, this->EventElement)
+          && source.Reader.GetSignal(source.PayloadSignal, source.NextRow, this->PayloadElement))) {
+        CMN_LOG_CLASS_RUN_WARNING << "ReplayEvent: failed to read event for row " << source.NextRow
+                                  << " of \"" << source.FileName << "\"" << std::endl;
+        return;
+    }
+
+    // void events are logged with an empty payload
+    const bool isVoid = this->PayloadElement.Data.empty();
+    const std::string key = this->ComponentElement.Data + "::" + this->InterfaceElement.Data
+        + "::" + this->EventElement.Data + (isVoid ? "()" : "(payload)");
+    Source::EventTargetsType::iterator found = source.EventTargets.find(key);
+    if (found == source.EventTargets.end()) {
+        found = source.EventTargets.insert(std::make_pair(key, EventTarget())).first;
+        FindEventTarget(found->second, isVoid);
+    }
+    EventTarget & target = found->second;
+
+    if (target.EventVoid) {
+        target.EventVoid->Execute(MTS_NOT_BLOCKING);
+    } else if (target.EventWrite) {
+        this->PayloadStream.clear();
+        this->PayloadStream.str(std::string(this->PayloadElement.Data.begin(), this->PayloadElement.Data.end()));
+        target.Argument->DeSerializeRaw(this->PayloadStream);
+        if (this->PayloadStream.fail()) {
+            CMN_LOG_CLASS_RUN_WARNING << "ReplayEvent: failed to de-serialize payload of event \""
+                                      << this->EventElement.Data << "\" for row " << source.NextRow
+                                      << " of \"" << source.FileName << "\"" << std::endl;
+            return;
+        }
+        target.EventWrite->Execute(*(target.Argument), MTS_NOT_BLOCKING);
+    }
+}
+
+
+void mtsCollectorReplay::UpdateNextTime(Source & source)
+{
+    if (!source.Reader.GetTime(source.NextRow, source.NextTime)) {
+        source.NextRow = source.Reader.GetNumberOfRows();
+    }
+}
+
+
+size_t mtsCollectorReplay::NextSource(void) const
+{
+    const size_t numberOfSources = this->Sources.size();
+    size_t result = numberOfSources;
+    for (size_t index = 0; index < numberOfSources; ++index) {
+        const Source * source = this->Sources[index];
+        if (source->NextRow < source->Reader.GetNumberOfRows()) {
+            // strict comparison so ties go to the first source added
+            if ((result == numberOfSources)
+                || (source->NextTime < this->Sources[result]->NextTime)) {
+                result = index;
+            }
+        }
+    }
+    return result;
+}
+
+
+bool mtsCollectorReplay::IsFinished(void) const
+{
+    return (NextSource() == this->Sources.size());
+}
+
+
+bool mtsCollectorReplay::Step(void)
+{
+    const size_t index = NextSource();
+    if (index == this->Sources.size()) {
+        this->Playing = false;
+        if (!this->FinishedTriggered) {
+            this->FinishedTriggered = true;
+            this->FinishedEvent();
+        }
+        return false;
+    }
+
+    Source & source = *(this->Sources[index]);
+    const double time = source.NextTime;
+    if (source.StateTable) {
+        mtsStateTable & table = *(source.StateTable);
+        const Source::SignalsType::const_iterator end = source.Signals.end();
+        Source::SignalsType::const_iterator signal;
+        for (signal = source.Signals.begin(); signal != end; ++signal) {
+            if (!source.Reader.GetSignal(signal->first, source.NextRow,
+                                         *(table.GetStateVectorElement(signal->second)))) {
+                CMN_LOG_CLASS_RUN_WARNING << "Step: failed to read signal \"" << source.Reader.GetSignalName(signal->first)
+                                          << "\" for row " << source.NextRow << " of \"" << source.FileName << "\"" << std::endl;
+            }
+        }
+        table.ReplayStart(time);
+        table.Advance();
+    } else {
+        ReplayEvent(source);
+    }
+
+    source.NextRow++;
+    UpdateNextTime(source);
+    this->VirtualTime = time;
+    this->NumberOfRowsReplayed++;
+    this->SteppedEvent(mtsDouble(time));
+    return true;
+}
+
+
+size_t mtsCollectorReplay::StepUntil(const double time)
+{
+    size_t result = 0;
+    size_t index = NextSource();
+    while ((index != this->Sources.size())
+           && (this->Sources[index]->NextTime <= time)) {
+        Step();
+        ++result;
+        index = NextSource();
+    }
+    return result;
+}
+
+
+bool mtsCollectorReplay::Seek(const double time)
+{
+    bool result = false;
+    for (size_t index = 0; index < this->Sources.size(); ++index) {
+        Source & source = *(this->Sources[index]);
+        unsigned long long endRow;
+        if (source.Reader.FindRows(time, std::numeric_limits<double>::max(),
+                                   source.NextRow, endRow)) {
+            result = true;
+        } else {
+            source.NextRow = source.Reader.GetNumberOfRows();
+        }
+        UpdateNextTime(source);
+    }
+    this->VirtualTime = time;
+    this->FinishedTriggered = false;
+    ResetPacing();
+    return result;
+}
+
+
+void mtsCollectorReplay::SetRate(const double rate)
+{
+    this->Rate = (rate > 0.0) ? rate : 0.0;
+    ResetPacing();
+}
+
+
+void mtsCollectorReplay::Play(void)
+{
+    if (this->NumberOfRowsReplayed == 0) {
+        // start from the first row without waiting
+        const size_t index = NextSource();
+        if (index != this->Sources.size()) {
+            this->VirtualTime = this->Sources[index]->NextTime;
+        }
+    }
+    this->Playing = true;
+    ResetPacing();
+}
+
+
+void mtsCollectorReplay::Pause(void)
+{
+    this->Playing = false;
+}
+
+
+void mtsCollectorReplay::ResetPacing(void)
+{
+    this->WallStart = osaGetTime();
+    this->VirtualStart = this->VirtualTime;
+}
+
+
+void mtsCollectorReplay::StepCommand(void)
+{
+    Step();
+}
+
+
+void mtsCollectorReplay::SetRateCommand(const mtsDouble & rate)
+{
+    SetRate(rate.Data);
+}
+
+
+void mtsCollectorReplay::SeekCommand(const mtsDouble & time)
+{
+    Seek(time.Data);
+}
+
+
+void mtsCollectorReplay::GetVirtualTimeCommand(mtsDouble & time) const
+{
+    time = this->VirtualTime;
+}
+
+
+void mtsCollectorReplay::Startup(void)
+{
+}
+
+
+void mtsCollectorReplay::Run(void)
+{
+    ProcessQueuedCommands();
+    if (!this->Playing) {
+        osaSleep(1.0 * cmn_ms);
+        return;
+    }
+
+    size_t rows = 0;
+    if (this->Rate == 0.0) {
+        while ((rows < this->BatchSize) && Step()) {
+            ++rows;
+        }
+        return;
+    }
+
+    // replay all rows up to the current virtual time
+    const double virtualNow = this->VirtualStart + (osaGetTime() - this->WallStart) * this->Rate;
+    size_t index = NextSource();
+    while ((rows < this->BatchSize)
+           && (index != this->Sources.size())
+           && (this->Sources[index]->NextTime <= virtualNow)) {
+        Step();
+        ++rows;
+        index = NextSource();
+    }
+    if (index == this->Sources.size()) {
+        Step(); // triggers finished event
+    } else if (rows == 0) {
+        // wait for the next row, keep processing commands regularly
+        double wait = (this->Sources[index]->NextTime - virtualNow) / this->Rate;
+        if (wait > 1.0 * cmn_ms) {
+            wait = 1.0 * cmn_ms;
+        }
+        osaSleep(wait);
+    }
+}
+
+
+void mtsCollectorReplay::Cleanup(void)
+{
+    this->Playing = false;
+}
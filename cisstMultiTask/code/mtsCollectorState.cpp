@@ -6,7 +6,7 @@
   Author(s):  Min Yang Jung, Anton Deguet
   Created on: 2009-03-20
 
-  (C) Copyright 2009-2011 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -47,7 +47,8 @@ mtsCollectorState::mtsCollectorState(const std::string & collectorName):
     mtsCollectorBase(collectorName,
                      COLLECTOR_FILE_FORMAT_UNDEFINED),
     TargetComponent(0),
-    TargetStateTable(0)
+    TargetStateTable(0),
+    ColumnarWriter(0)
 {
     this->Initialize();
 }
@@ -59,7 +60,8 @@ mtsCollectorState::mtsCollectorState(const std::string & targetComponentName,
     mtsCollectorBase(std::string("StateCollectorFor") + targetComponentName + targetStateTableName,
                      fileFormat),
     TargetComponent(0),
-    TargetStateTable(0)
+    TargetStateTable(0),
+    ColumnarWriter(0)
 {
     this->SetStateTable(targetComponentName, targetStateTableName);
     this->SetOutputToDefault(fileFormat);
@@ -69,6 +71,11 @@ mtsCollectorState::mtsCollectorState(const std::string & targetComponentName,
 
 mtsCollectorState::~mtsCollectorState()
 {
+    this->FlushOutput();
+    RegisteredSignalElementType::iterator it = RegisteredSignalElements.begin();
+    for (; it != RegisteredSignalElements.end(); ++it) {
+        delete it->Buffer;
+    }
     // serializer was created for a binary output
     if (this->Serializer) {
         delete this->Serializer;
@@ -336,6 +343,12 @@ bool mtsCollectorState::AddSignalElement(const std::string & signalName, const u
     SignalElement element;
     element.Name = signalName;
     element.ID = signalID;
+    element.Buffer = TargetStateTable->StateVector[signalID]->CreateElement();
+    if (!element.Buffer) {
+        CMN_LOG_CLASS_INIT_ERROR << "AddSignalElement: collector \"" << this->GetName()
+                                 << "\", can't create element for signal \"" << signalName << "\"" << std::endl;
+        return false;
+    }
 
     RegisteredSignalElements.push_back(element);
 
@@ -357,6 +370,9 @@ void mtsCollectorState::BatchCollect(const mtsStateTable::IndexRange & range)
     if (FirstRunningFlag) {
         this->OpenFileIfNeeded();
         PrintHeader(this->FileFormat);
+        if (this->FileFormat == COLLECTOR_FILE_FORMAT_BINARY_COLUMNAR) {
+            this->OpenColumnarWriter();
+        }
     }
 
     const size_t startIndex = range.First.Ticks() % TableHistoryLength;
@@ -398,8 +414,8 @@ void mtsCollectorState::PrintHeader(const CollectorFileFormat & fileFormat)
         RegisteredSignalElementType::const_iterator it = RegisteredSignalElements.begin();
         for (; it != RegisteredSignalElements.end(); ++it) {
             out << this->Delimiter;
-            (*(TargetStateTable->StateVector[it->ID]))[0].ToStreamRaw(*((std::ostream*) &out), this->Delimiter, true,
-                                                                      TargetStateTable->StateVectorDataNames[it->ID]);
+            TargetStateTable->StateVector[it->ID]->Element(0, *(it->Buffer)).ToStreamRaw(*((std::ostream*) &out), this->Delimiter, true,
+                                                                                          TargetStateTable->StateVectorDataNames[it->ID]);
         }
         out << std::endl;
 
@@ -434,6 +450,8 @@ void mtsCollectorState::PrintHeader(const CollectorFileFormat & fileFormat)
             *(this->OutputHeaderStream) << "Text" << std::endl ;
         } else if (fileFormat == COLLECTOR_FILE_FORMAT_CSV) {
             *(this->OutputHeaderStream) << "CSV" << std::endl ;
+        } else if (fileFormat == COLLECTOR_FILE_FORMAT_BINARY_COLUMNAR) {
+            *(this->OutputHeaderStream) << "Columnar" << std::endl ;
         } else {
             *(this->OutputHeaderStream) << "Binary" << std::endl;
         }
@@ -490,8 +508,8 @@ void mtsCollectorState::PrintHeader(const CollectorFileFormat & fileFormat)
         RegisteredSignalElementType::const_iterator it = RegisteredSignalElements.begin();
         for (; it != RegisteredSignalElements.end(); ++it) {
             *(this->OutputStream) << this->Delimiter;
-            (*(TargetStateTable->StateVector[it->ID]))[0].ToStreamRaw(*(this->OutputStream), this->Delimiter, true,
-                                                                      TargetStateTable->StateVectorDataNames[it->ID]);
+            TargetStateTable->StateVector[it->ID]->Element(0, *(it->Buffer)).ToStreamRaw(*(this->OutputStream), this->Delimiter, true,
+                                                                                          TargetStateTable->StateVectorDataNames[it->ID]);
         }
 
         *(this->OutputStream) << std::endl;
@@ -515,6 +533,45 @@ void mtsCollectorState::PrintHeader(const CollectorFileFormat & fileFormat)
 }
 
 
+bool mtsCollectorState::OpenColumnarWriter(void)
+{
+    this->FlushOutput();
+    std::string currentDateTime;
+    osaGetDateTimeString(currentDateTime);
+    osaAbsoluteTime origin;
+    mtsTaskManager::GetInstance()->GetTimeServer().GetTimeOrigin(origin);
+    std::vector<std::string> signalNames, signalClassNames;
+    RegisteredSignalElementType::const_iterator it = RegisteredSignalElements.begin();
+    for (; it != RegisteredSignalElements.end(); ++it) {
+        signalNames.push_back(it->Name);
+        signalClassNames.push_back(it->Buffer->Services()->GetName());
+    }
+    this->ColumnarWriter = new mtsCollectorColumnarWriter;
+    if (!this->ColumnarWriter->Open(this->OutputFileName,
+                                    TargetComponent->GetName(), TargetStateTable->GetName(),
+                                    currentDateTime, origin.ToSeconds(),
+                                    signalNames, signalClassNames)) {
+        CMN_LOG_CLASS_INIT_ERROR << "OpenColumnarWriter: unable to create columnar file \""
+                                 << this->OutputFileName << "\" for collector \"" << this->GetName() << "\"" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+
+void mtsCollectorState::FlushOutput(void)
+{
+    if (this->ColumnarWriter) {
+        if (this->ColumnarWriter->IsOpen() && !this->ColumnarWriter->Close()) {
+            CMN_LOG_CLASS_RUN_ERROR << "FlushOutput: failed to write columnar file \""
+                                    << this->OutputFileName << "\"" << std::endl;
+        }
+        delete this->ColumnarWriter;
+        this->ColumnarWriter = 0;
+    }
+}
+
+
 void mtsCollectorState::MarkHeaderEnd(std::ostream & output)
 {
     for (int i = 0; i < END_OF_HEADER_SIZE; ++i) {
@@ -539,6 +596,27 @@ bool mtsCollectorState::FetchStateTableData(const mtsStateTable * table,
                                             const size_t startIndex,
                                             const size_t endIndex)
 {
+    if (FileFormat == COLLECTOR_FILE_FORMAT_BINARY_COLUMNAR) {
+        if (!(this->ColumnarWriter && this->ColumnarWriter->IsOpen())) {
+            CMN_LOG_CLASS_RUN_ERROR << "FetchStateTableData: columnar output for collector \"" << this->GetName() << "\" is not available." << std::endl;
+            return true;
+        }
+        // rows are only copied in the writer's chunk, encoding and
+        // writing to disk are performed by the writer thread
+        mtsDouble tic;
+        size_t i, j;
+        for (i = startIndex; i <= endIndex; i += SamplingInterval) {
+            table->StateVector[table->TicId]->Get(i, tic);
+            this->ColumnarWriter->BeginRow(TargetStateTable->Ticks[i], tic.Data);
+            for (j = 0; j < RegisteredSignalElements.size(); ++j) {
+                const SignalElement & signal = RegisteredSignalElements[j];
+                this->ColumnarWriter->AddElement(table->StateVector[signal.ID]->Element(i, *(signal.Buffer)));
+            }
+            this->ColumnarWriter->EndRow();
+        }
+        OffsetForNextRead = (i - endIndex == 0 ? SamplingInterval : i - endIndex);
+        return true;
+    }
     if (this->OutputStream) {
         if (this->OutputStream->good()) {
             if (FileFormat == COLLECTOR_FILE_FORMAT_BINARY) {
@@ -552,7 +630,8 @@ bool mtsCollectorState::FetchStateTableData(const mtsStateTable * table,
 
                     for (j = 0; j < RegisteredSignalElements.size(); ++j) {
                         StringStreamBufferForSerialization.str("");
-                        Serializer->Serialize((*table->StateVector[RegisteredSignalElements[j].ID])[i]);
+                        const SignalElement & signal = RegisteredSignalElements[j];
+                        Serializer->Serialize(table->StateVector[signal.ID]->Element(i, *(signal.Buffer)));
                         *(this->OutputStream) << StringStreamBufferForSerialization.str();
                     }
                 }
@@ -563,7 +642,8 @@ bool mtsCollectorState::FetchStateTableData(const mtsStateTable * table,
                     *(this->OutputStream) << TargetStateTable->Ticks[i];
                     for (j = 0; j < RegisteredSignalElements.size(); ++j) {
                         *(this->OutputStream) << this->Delimiter;
-                        (*table->StateVector[RegisteredSignalElements[j].ID])[i].ToStreamRaw(*(this->OutputStream), this->Delimiter);
+                        const SignalElement & signal = RegisteredSignalElements[j];
+                        table->StateVector[signal.ID]->Element(i, *(signal.Buffer)).ToStreamRaw(*(this->OutputStream), this->Delimiter);
                     }
                     *(this->OutputStream) << std::endl;
                 }
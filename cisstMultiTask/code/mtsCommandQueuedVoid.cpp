@@ -6,7 +6,7 @@
   Author(s):  Ankur Kapoor, Peter Kazanzides, Anton Deguet
   Created on: 2005-05-02
 
-  (C) Copyright 2005-2014 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2005-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -23,7 +23,8 @@ http://www.cisst.org/cisst/license.txt.
 
 mtsCommandQueuedVoid::mtsCommandQueuedVoid(void):
     BaseType(),
-    MailBox(0)
+    MailBox(0),
+    ActualCommand()
 {}
 
 
@@ -34,7 +35,8 @@ mtsCommandQueuedVoid::mtsCommandQueuedVoid(mtsCallableVoidBase * callable,
     BaseType(callable, name),
     MailBox(mailBox),
     BlockingFlagQueue(size, MTS_NOT_BLOCKING),
-    FinishedEventQueue()
+    FinishedEventQueue(),
+    ActualCommand(callable, name)
 {
     mtsCommandWriteBase *cmd = 0;
     FinishedEventQueue.SetSize(size, cmd);
@@ -5,7 +5,7 @@
   Author(s):  Ankur Kapoor, Peter Kazanzides, Anton Deguet
   Created on: 2005-05-02
 
-  (C) Copyright 2005-2017 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2005-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -18,6 +18,20 @@ http://www.cisst.org/cisst/license.txt.
 
 
 #include <cisstMultiTask/mtsCommandQueuedWrite.h>
+#include <cisstMultiTask/mtsSharedArgument.h>
+
+#include <typeinfo>
+
+
+mtsCommandQueuedWriteBase::~mtsCommandQueuedWriteBase()
+{
+    mtsSharedArgument ** shared;
+    while ((shared = this->SharedArgumentsQueue.Get())) {
+        if (*shared) {
+            (*shared)->Release();
+        }
+    }
+}
 
 
 void mtsCommandQueuedWriteBase::ToStream(std::ostream & outputStream) const {
@@ -38,6 +52,72 @@ mtsExecutionResult mtsCommandQueuedWriteBase::Execute(const mtsGenericObject & a
     return Execute(argument, blocking, 0);
 }
 
+void mtsCommandQueuedWriteBase::AllocateQueues(size_t size)
+{
+    BlockingFlagQueue.SetSize(size, MTS_NOT_BLOCKING);
+    mtsCommandWriteBase *cmd = 0;
+    FinishedEventQueue.SetSize(size, cmd);
+    mtsSharedArgument *shared = 0;
+    SharedArgumentsQueue.SetSize(size, shared);
+}
+
+
+mtsExecutionResult mtsCommandQueuedWriteBase::ExecuteShared(mtsSharedArgument & argument)
+{
+    return this->Execute(argument.GetArgument(), MTS_NOT_BLOCKING, 0);
+}
+
+
+mtsExecutionResult mtsCommandQueuedWriteBase::EnqueueShared(mtsSharedArgument & argument)
+{
+    // check if this command is enabled
+    if (!this->IsEnabled()) {
+        return mtsExecutionResult::COMMAND_DISABLED;
+    }
+    // check if there is a mailbox (i.e. if the command is associated to an interface)
+    if (!MailBox) {
+        CMN_LOG_RUN_ERROR << "Class mtsCommandQueuedWriteBase: ExecuteShared: no mailbox for \""
+                          << this->Name << "\"" << std::endl;
+        return mtsExecutionResult::COMMAND_HAS_NO_MAILBOX;
+    }
+    // check if all queues have some space
+    if (SharedArgumentsQueue.IsFull() || BlockingFlagQueue.IsFull() || FinishedEventQueue.IsFull() || MailBox->IsFull()) {
+        CMN_LOG_RUN_WARNING << "Class mtsCommandQueuedWriteBase: ExecuteShared: Queue full for \""
+                            << this->Name << "\" ["
+                            << SharedArgumentsQueue.IsFull() << "|"
+                            << BlockingFlagQueue.IsFull() << "|"
+                            << FinishedEventQueue.IsFull() << "|"
+                            << MailBox->IsFull() << "]"
+                            << std::endl;
+        return mtsExecutionResult::COMMAND_ARGUMENT_QUEUE_FULL;
+    }
+    // the reference is released by the mailbox after execution
+    argument.AddReference();
+    mtsSharedArgument * shared = &argument;
+    if (!SharedArgumentsQueue.Put(shared)
+        || !BlockingFlagQueue.Put(MTS_NOT_BLOCKING)
+        || !FinishedEventQueue.Put(0)) {
+        // not possible with a single caller, space was checked before
+        CMN_LOG_RUN_ERROR << "Class mtsCommandQueuedWriteBase: ExecuteShared: failed to queue for \""
+                          << this->Name << "\"" << std::endl;
+        argument.Release();
+        cmnThrow("mtsCommandQueuedWriteBase: ExecuteShared: Put failed");
+        return mtsExecutionResult::UNDEFINED;
+    }
+    if (!MailBox->Write(this)) {
+        CMN_LOG_RUN_ERROR << "Class mtsCommandQueuedWriteBase: ExecuteShared: MailBox.Write failed for \""
+                          << this->Name << "\"" << std::endl;
+        SharedArgumentsQueue.Get();  // Remove the shared argument, blocking flag and finished event handler
+        BlockingFlagQueue.Get();
+        FinishedEventQueue.Get();
+        argument.Release();
+        cmnThrow("mtsCommandQueuedWriteBase: ExecuteShared: MailBox.Write failed");
+        return mtsExecutionResult::UNDEFINED;
+    }
+    return mtsExecutionResult::COMMAND_QUEUED;
+}
+
+
 mtsBlockingType mtsCommandQueuedWriteBase::BlockingFlagGet(void)
 {
     return *(this->BlockingFlagQueue.Get());
@@ -48,6 +128,12 @@ mtsCommandWriteBase *mtsCommandQueuedWriteBase::FinishedEventGet(void)
     return *(this->FinishedEventQueue.Get());
 }
 
+mtsSharedArgument * mtsCommandQueuedWriteBase::SharedArgumentGet(void)
+{
+    mtsSharedArgument ** shared = this->SharedArgumentsQueue.Get();
+    return shared ? *shared : 0;
+}
+
 
 mtsCommandQueuedWriteGeneric::mtsCommandQueuedWriteGeneric(mtsMailBox * mailBox, mtsCommandWriteBase * actualCommand, size_t size):
     BaseType(mailBox, actualCommand, size),
@@ -60,9 +146,7 @@ mtsCommandQueuedWriteGeneric::mtsCommandQueuedWriteGeneric(mtsMailBox * mailBox,
     const mtsGenericObject * argumentPrototype = dynamic_cast<const mtsGenericObject *>(this->GetArgumentPrototype());
     if (argumentPrototype) {
         ArgumentsQueue.SetSize(size, *argumentPrototype);
-        BlockingFlagQueue.SetSize(size, MTS_NOT_BLOCKING);
-        mtsCommandWriteBase *cmd = 0;
-        FinishedEventQueue.SetSize(size, cmd);
+        this->AllocateQueues(size);
     } else {
         CMN_LOG_INIT_DEBUG << "Class mtsCommandQueuedWriteGeneric: constructor: can't find argument prototype from actual command \""
                            << this->GetName() << "\"" << std::endl;
@@ -80,9 +164,7 @@ void mtsCommandQueuedWriteGeneric::Allocate(size_t size)
         const mtsGenericObject * argumentPrototype = dynamic_cast<const mtsGenericObject *>(this->GetArgumentPrototype());
         if (argumentPrototype) {
             ArgumentsQueue.SetSize(size, *argumentPrototype);
-            BlockingFlagQueue.SetSize(size, MTS_NOT_BLOCKING);
-            mtsCommandWriteBase *cmd = 0;
-            FinishedEventQueue.SetSize(size, cmd);
+            this->AllocateQueues(size);
         } else {
             CMN_LOG_INIT_ERROR << "Class mtsCommandQueuedWriteGeneric: Allocate: can't find argument prototype from actual command \""
                                << this->GetName() << "\"" << std::endl;
@@ -94,6 +176,34 @@ void mtsCommandQueuedWriteGeneric::Allocate(size_t size)
 mtsExecutionResult mtsCommandQueuedWriteGeneric::Execute(const mtsGenericObject & argument,
                                                          mtsBlockingType blocking,
                                                          mtsCommandWriteBase *finishedEventHandler)
+{
+    return this->Enqueue(argument, 0, blocking, finishedEventHandler);
+}
+
+
+mtsExecutionResult mtsCommandQueuedWriteGeneric::ExecuteSwap(mtsGenericObject & argument,
+                                                             mtsBlockingType blocking,
+                                                             mtsCommandWriteBase * finishedEventHandler)
+{
+    return this->Enqueue(argument, &argument, blocking, finishedEventHandler);
+}
+
+
+mtsExecutionResult mtsCommandQueuedWriteGeneric::ExecuteShared(mtsSharedArgument & argument)
+{
+    // derived classes might process the argument in Execute (filters,
+    // proxies, latest value only), let them copy the argument
+    if (typeid(*this) != typeid(ThisType)) {
+        return BaseType::ExecuteShared(argument);
+    }
+    return this->EnqueueShared(argument);
+}
+
+
+mtsExecutionResult mtsCommandQueuedWriteGeneric::Enqueue(const mtsGenericObject & argument,
+                                                         mtsGenericObject * handoff,
+                                                         mtsBlockingType blocking,
+                                                         mtsCommandWriteBase * finishedEventHandler)
 {
     // check if this command is enabled
     if (!this->IsEnabled()) {
@@ -106,18 +216,20 @@ mtsExecutionResult mtsCommandQueuedWriteGeneric::Execute(const mtsGenericObject
         return mtsExecutionResult::COMMAND_HAS_NO_MAILBOX;
     }
     // check if all queues have some space
-    if (ArgumentsQueue.IsFull() || BlockingFlagQueue.IsFull() || FinishedEventQueue.IsFull() || MailBox->IsFull()) {
+    if (ArgumentsQueue.IsFull() || BlockingFlagQueue.IsFull() || FinishedEventQueue.IsFull()
+        || SharedArgumentsQueue.IsFull() || MailBox->IsFull()) {
         CMN_LOG_RUN_WARNING << "Class mtsCommandQueuedWriteGeneric: Execute: Queue full for \""
                             << this->Name << "\" ["
                             << ArgumentsQueue.IsFull() << "|"
                             << BlockingFlagQueue.IsFull() << "|"
                             << FinishedEventQueue.IsFull() << "|"
+                            << SharedArgumentsQueue.IsFull() << "|"
                             << MailBox->IsFull() << "]"
                             << std::endl;
         return mtsExecutionResult::COMMAND_ARGUMENT_QUEUE_FULL;
     }
-    // copy the argument to the local storage.
-    if (!ArgumentsQueue.Put(argument)) {
+    // copy or hand off the argument to the local storage.
+    if (!(handoff ? ArgumentsQueue.PutSwap(*handoff) : ArgumentsQueue.Put(argument))) {
         CMN_LOG_RUN_ERROR << "Class mtsCommandQueuedWriteGeneric: Execute: ArgumentsQueue.Put failed for \""
                           << this->Name << "\"" << std::endl;
         cmnThrow("mtsCommandQueuedWriteGeneric: Execute: ArgumentsQueue.Put failed");
@@ -140,6 +252,17 @@ mtsExecutionResult mtsCommandQueuedWriteGeneric::Execute(const mtsGenericObject
         cmnThrow("mtsCommandQueuedWriteGeneric: Execute: FinishedEventQueue.Put failed");
         return mtsExecutionResult::UNDEFINED;
     }
+    // the argument is not shared, it is in the argument queue
+    mtsSharedArgument * shared = 0;
+    if (!SharedArgumentsQueue.Put(shared)) {
+        CMN_LOG_RUN_ERROR << "Class mtsCommandQueuedWriteGeneric: Execute: SharedArgumentsQueue.Put failed for \""
+                          << this->Name << "\"" << std::endl;
+        ArgumentsQueue.Get();       // Remove the argument that was already queued
+        BlockingFlagQueue.Get();    // Remove the blocking flag that was already queued
+        FinishedEventQueue.Get();   // Remove the finished event handler that was already queued
+        cmnThrow("mtsCommandQueuedWriteGeneric: Execute: SharedArgumentsQueue.Put failed");
+        return mtsExecutionResult::UNDEFINED;
+    }
     // finally try to queue to mailbox
     if (!MailBox->Write(this)) {
         CMN_LOG_RUN_ERROR << "Class mtsCommandQueuedWriteGeneric: Execute: MailBox.Write failed for \""
@@ -147,6 +270,7 @@ mtsExecutionResult mtsCommandQueuedWriteGeneric::Execute(const mtsGenericObject
         ArgumentsQueue.Get();      // Remove the argument that was already queued
         BlockingFlagQueue.Get();   // Remove the blocking flag that was already queued
         FinishedEventQueue.Get();  // Remove the finished event handler that was already queued
+        SharedArgumentsQueue.Get();
         cmnThrow("mtsCommandQueuedWriteGeneric: Execute: MailBox.Write failed");
         return mtsExecutionResult::UNDEFINED;
     }
@@ -0,0 +1,194 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+#include <cisstMultiTask/mtsCommandQueuedWriteLatest.h>
+
+
+mtsCommandQueuedWriteLatest::mtsCommandQueuedWriteLatest(mtsMailBox * mailBox, mtsCommandWriteBase * actualCommand):
+    BaseType(mailBox, actualCommand, 0),
+    BackIndex(0),
+    MiddleIndex(1),
+    FrontIndex(2),
+    FrontIsNew(false),
+    Pending(false),
+    NumberOfConflated(0)
+{
+    for (size_t index = 0; index < 3; ++index) {
+        this->Slots[index] = 0;
+        this->SlotsBlocking[index] = MTS_NOT_BLOCKING;
+        this->SlotsFinishedEvent[index] = 0;
+    }
+    this->AllocateSlots();
+}
+
+
+mtsCommandQueuedWriteLatest::~mtsCommandQueuedWriteLatest()
+{
+    for (size_t index = 0; index < 3; ++index) {
+        if (this->Slots[index]) {
+            delete this->Slots[index];
+        }
+    }
+}
+
+
+mtsCommandQueuedWriteLatest * mtsCommandQueuedWriteLatest::Clone(mtsMailBox * mailBox, size_t CMN_UNUSED(size)) const
+{
+    return new mtsCommandQueuedWriteLatest(mailBox, this->ActualCommand);
+}
+
+
+void mtsCommandQueuedWriteLatest::AllocateSlots(void)
+{
+    if (this->Slots[0]) {
+        return;
+    }
+    const mtsGenericObject * argumentPrototype = this->GetArgumentPrototype();
+    if (!argumentPrototype) {
+        CMN_LOG_INIT_DEBUG << "Class mtsCommandQueuedWriteLatest: AllocateSlots: can't find argument prototype from actual command \""
+                           << this->GetName() << "\"" << std::endl;
+        return;
+    }
+    for (size_t index = 0; index < 3; ++index) {
+        this->Slots[index] = dynamic_cast<mtsGenericObject *>(argumentPrototype->Services()->Create(*argumentPrototype));
+        if (!this->Slots[index]) {
+            CMN_LOG_INIT_ERROR << "Class mtsCommandQueuedWriteLatest: AllocateSlots: failed to create argument for \""
+                               << this->GetName() << "\"" << std::endl;
+        }
+    }
+}
+
+
+void mtsCommandQueuedWriteLatest::Allocate(size_t CMN_UNUSED(size))
+{
+    this->AllocateSlots();
+}
+
+
+void mtsCommandQueuedWriteLatest::ToStream(std::ostream & outputStream) const
+{
+    outputStream << "mtsCommandQueuedWriteLatest: MailBox \"";
+    if (this->MailBox) {
+        outputStream << this->MailBox->GetName();
+    } else {
+        outputStream << "Undefined";
+    }
+    outputStream << "\" for command " << *(this->ActualCommand)
+                 << " currently " << (this->IsEnabled() ? "enabled" : "disabled")
+                 << ", " << this->GetNumberOfConflated() << " argument(s) conflated";
+}
+
+
+mtsExecutionResult mtsCommandQueuedWriteLatest::Execute(const mtsGenericObject & argument,
+                                                        mtsBlockingType blocking,
+                                                        mtsCommandWriteBase * finishedEventHandler)
+{
+    return this->Conflate(argument, 0, blocking, finishedEventHandler);
+}
+
+
+mtsExecutionResult mtsCommandQueuedWriteLatest::ExecuteSwap(mtsGenericObject & argument,
+                                                            mtsBlockingType blocking,
+                                                            mtsCommandWriteBase * finishedEventHandler)
+{
+    return this->Conflate(argument, &argument, blocking, finishedEventHandler);
+}
+
+
+mtsExecutionResult mtsCommandQueuedWriteLatest::Conflate(const mtsGenericObject & argument,
+                                                         mtsGenericObject * handoff,
+                                                         mtsBlockingType blocking,
+                                                         mtsCommandWriteBase * finishedEventHandler)
+{
+    if (!this->IsEnabled()) {
+        return mtsExecutionResult::COMMAND_DISABLED;
+    }
+    if (!this->MailBox) {
+        CMN_LOG_RUN_ERROR << "Class mtsCommandQueuedWriteLatest: Execute: no mailbox for \""
+                          << this->Name << "\"" << std::endl;
+        return mtsExecutionResult::COMMAND_HAS_NO_MAILBOX;
+    }
+    mtsGenericObject * slot = this->Slots[this->BackIndex];
+    if (!slot) {
+        CMN_LOG_RUN_ERROR << "Class mtsCommandQueuedWriteLatest: Execute: no argument allocated for \""
+                          << this->Name << "\"" << std::endl;
+        return mtsExecutionResult::ARGUMENT_DYNAMIC_CREATION_FAILED;
+    }
+    // copy or hand off the argument to the back slot
+    if (!handoff
+        || (slot->Services() != handoff->Services())
+        || !slot->Swap(*handoff)) {
+        if (!slot->Services()->Create(slot, argument)) {
+            CMN_LOG_RUN_ERROR << "Class mtsCommandQueuedWriteLatest: Execute: failed to copy argument of type \""
+                              << argument.Services()->GetName() << "\" for \"" << this->Name << "\"" << std::endl;
+            return mtsExecutionResult::INVALID_INPUT_TYPE;
+        }
+    }
+    this->SlotsBlocking[this->BackIndex] = blocking;
+    this->SlotsFinishedEvent[this->BackIndex] = finishedEventHandler;
+
+    // publish, the previous middle slot becomes the back slot
+    const unsigned int previous = this->MiddleIndex.exchange(this->BackIndex | LATEST_NEW);
+    this->BackIndex = previous & LATEST_INDEX_MASK;
+    if (previous & LATEST_NEW) {
+        this->NumberOfConflated.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // add to mailbox only if not already pending
+    if (!this->Pending.exchange(true)) {
+        if (!this->MailBox->Write(this)) {
+            this->Pending.store(false);
+            CMN_LOG_RUN_WARNING << "Class mtsCommandQueuedWriteLatest: Execute: mailbox full for \""
+                                << this->Name << "\"" << std::endl;
+            return mtsExecutionResult::INTERFACE_COMMAND_MAILBOX_FULL;
+        }
+    }
+    return mtsExecutionResult::COMMAND_QUEUED;
+}
+
+
+mtsBlockingType mtsCommandQueuedWriteLatest::BlockingFlagGet(void)
+{
+    // clear pending first so a newer argument always leads to a new
+    // mailbox entry, that entry might find the argument already taken
+    this->Pending.store(false);
+    const unsigned int previous = this->MiddleIndex.exchange(this->FrontIndex);
+    this->FrontIndex = previous & LATEST_INDEX_MASK;
+    this->FrontIsNew = ((previous & LATEST_NEW) != 0);
+    return this->FrontIsNew ? this->SlotsBlocking[this->FrontIndex] : MTS_NOT_BLOCKING;
+}
+
+
+mtsCommandWriteBase * mtsCommandQueuedWriteLatest::FinishedEventGet(void)
+{
+    return this->FrontIsNew ? this->SlotsFinishedEvent[this->FrontIndex] : 0;
+}
+
+
+const mtsGenericObject * mtsCommandQueuedWriteLatest::ArgumentPeek(void) const
+{
+    return this->FrontIsNew ? this->Slots[this->FrontIndex] : 0;
+}
+
+
+mtsGenericObject * mtsCommandQueuedWriteLatest::ArgumentGet(void)
+{
+    mtsGenericObject * result = this->FrontIsNew ? this->Slots[this->FrontIndex] : 0;
+    this->FrontIsNew = false;
+    return result;
+}
@@ -0,0 +1,594 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstCommon/cmnLogger.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstOSAbstraction/osaMutex.h>
+#include <cisstMultiTask/mtsCommandTracer.h>
+#include <cisstMultiTask/mtsCommandBase.h>
+
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+std::atomic<bool> mtsCommandTracer::Enabled(false);
+
+namespace {
+
+    enum {NAME_SIZE = 48};
+
+    class Record {
+    public:
+        double Time;
+        const mtsCommandBase * Command;
+        int Phase;
+        char Name[NAME_SIZE];
+    };
+
+    /*! Ring buffer, written by its thread only.  The record at index
+      Written is the one being written, readers check Written again
+      after copying to skip records that might have been overwritten
+      in the meantime.  InUse is cleared when the thread ends so the
+      buffer can be reused by another thread. */
+    class Buffer {
+    public:
+        std::vector<Record> Records;
+        std::atomic<unsigned long long> Written;
+        std::atomic<bool> InUse;
+        std::string ThreadName;
+        Buffer(const size_t size, const std::string & threadName):
+            Records(size),
+            Written(0),
+            InUse(true),
+            ThreadName(threadName)
+        {}
+    };
+
+    class Buffers {
+    public:
+        osaMutex Mutex;
+        std::vector<Buffer *> List;
+        size_t RecordsPerThread;
+        Buffers(void):
+            RecordsPerThread(65536)
+        {}
+        ~Buffers() {
+            for (size_t index = 0; index < List.size(); ++index) {
+                delete List[index];
+            }
+        }
+    };
+
+    Buffers & GetBuffers(void) {
+        static Buffers buffers;
+        return buffers;
+    }
+
+    /*! Buffer used by the current thread, released when the thread
+      ends */
+    class ThreadBuffer {
+    public:
+        Buffer * Current;
+
+        ThreadBuffer(void):
+            Current(0)
+        {}
+
+        ~ThreadBuffer() {
+            if (Current) {
+                Current->InUse.store(false, std::memory_order_release);
+                Current = 0;
+            }
+        }
+    };
+
+    thread_local ThreadBuffer CurrentBuffer;
+
+    /*! Name set before the buffer is created, the buffer is only
+      allocated when the thread records its first phase */
+    thread_local std::string CurrentThreadName;
+
+    Buffer * GetCurrentBuffer(void) {
+        if (!CurrentBuffer.Current) {
+            Buffers & buffers = GetBuffers();
+            buffers.Mutex.Lock();
+            // reuse a buffer released by a thread that ended, its
+            // records are discarded
+            size_t index;
+            for (index = 0; index < buffers.List.size(); ++index) {
+                bool inUse = false;
+                if (buffers.List[index]->InUse.compare_exchange_strong(inUse, true)) {
+                    break;
+                }
+            }
+            std::stringstream name;
+            if (!CurrentThreadName.empty()) {
+                name << CurrentThreadName;
+            } else {
+                name << "Thread " << index;
+            }
+            if (index < buffers.List.size()) {
+                buffers.List[index]->Written.store(0);
+                buffers.List[index]->ThreadName = name.str();
+            } else {
+                buffers.List.push_back(new Buffer(buffers.RecordsPerThread, name.str()));
+            }
+            CurrentBuffer.Current = buffers.List[index];
+            buffers.Mutex.Unlock();
+        }
+        return CurrentBuffer.Current;
+    }
+
+    /*! Record with the index of the thread that wrote it */
+    class ThreadRecord {
+    public:
+        Record Data;
+        size_t Thread;
+    };
+
+    /*! Copy all records merged in time order.  Records of a given
+      thread stay in order, records with the same time from different
+      threads are sorted by phase so an enqueue is always seen before
+      the corresponding dequeue. */
+    void CollectRecords(std::vector<ThreadRecord> & records, std::vector<std::string> & threadNames)
+    {
+        Buffers & buffers = GetBuffers();
+        std::vector<std::vector<ThreadRecord> > perThread;
+        buffers.Mutex.Lock();
+        perThread.resize(buffers.List.size());
+        threadNames.resize(buffers.List.size());
+        for (size_t thread = 0; thread < buffers.List.size(); ++thread) {
+            const Buffer * buffer = buffers.List[thread];
+            threadNames[thread] = buffer->ThreadName;
+            const unsigned long long size = buffer->Records.size();
+            const unsigned long long written = buffer->Written.load(std::memory_order_acquire);
+            const unsigned long long first = (written > size) ? (written - size) : 0;
+            std::vector<ThreadRecord> & copy = perThread[thread];
+            for (unsigned long long index = first; index < written; ++index) {
+                ThreadRecord record;
+                record.Data = buffer->Records[index % size];
+                record.Thread = thread;
+                copy.push_back(record);
+            }
+            // the writer might have moved on while copying, drop
+            // records whose slot has been reused since
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const unsigned long long writtenAfter = buffer->Written.load(std::memory_order_relaxed);
+            if (writtenAfter >= first + size) {
+                const unsigned long long valid = writtenAfter - size + 1;
+                const size_t overwritten = static_cast<size_t>((valid < written) ? (valid - first) : copy.size());
+                copy.erase(copy.begin(), copy.begin() + overwritten);
+            }
+        }
+        buffers.Mutex.Unlock();
+
+        records.clear();
+        std::vector<size_t> heads(perThread.size(), 0);
+        while (true) {
+            size_t next = perThread.size();
+            for (size_t thread = 0; thread < perThread.size(); ++thread) {
+                if (heads[thread] == perThread[thread].size()) {
+                    continue;
+                }
+                if (next == perThread.size()) {
+                    next = thread;
+                    continue;
+                }
+                const Record & candidate = perThread[thread][heads[thread]].Data;
+                const Record & best = perThread[next][heads[next]].Data;
+                if ((candidate.Time < best.Time)
+                    || ((candidate.Time == best.Time) && (candidate.Phase < best.Phase))) {
+                    next = thread;
+                }
+            }
+            if (next == perThread.size()) {
+                break;
+            }
+            records.push_back(perThread[next][heads[next]]);
+            heads[next]++;
+        }
+    }
+
+    /*! Event for Chrome trace, X for slices, s and f for flows and i
+      for instants */
+    class TraceEvent {
+    public:
+        char Type;
+        const char * Category;
+        std::string Name;
+        size_t Thread;
+        double Time;
+        double Duration;
+        unsigned long long Id;
+    };
+
+    /*! Match records and compute statistics and trace events */
+    void Analyze(const std::vector<ThreadRecord> & records,
+                 mtsCommandTracer::StatisticsType & statistics,
+                 std::vector<TraceEvent> * events)
+    {
+        typedef std::pair<const mtsCommandBase *, size_t> CommandThreadType;
+        class Queued {
+        public:
+            double Time;
+            unsigned long long Id;
+            size_t Thread;
+            size_t Event; // index in events, if any
+        };
+        std::map<CommandThreadType, std::vector<double> > calls;
+        std::map<const mtsCommandBase *, std::deque<Queued> > queued;
+        std::map<CommandThreadType, double> executing;
+        std::map<const mtsCommandBase *, double> finished;
+        unsigned long long flowId = 0;
+        TraceEvent event;
+        event.Duration = 0.0;
+        event.Id = 0;
+
+        const std::vector<ThreadRecord>::const_iterator end = records.end();
+        std::vector<ThreadRecord>::const_iterator iter;
+        for (iter = records.begin(); iter != end; ++iter) {
+            const Record & record = iter->Data;
+            const CommandThreadType key(record.Command, iter->Thread);
+            mtsCommandTracer::CommandStatistics & commandStatistics = statistics[record.Name];
+            event.Name = record.Name;
+            event.Thread = iter->Thread;
+            event.Time = record.Time;
+            switch (record.Phase) {
+            case mtsCommandTracer::FUNCTION_BEGIN:
+                calls[key].push_back(record.Time);
+                break;
+            case mtsCommandTracer::FUNCTION_END:
+                {
+                    std::vector<double> & stack = calls[key];
+                    if (stack.empty()) {
+                        break;
+                    }
+                    const double begin = stack.back();
+                    stack.pop_back();
+                    commandStatistics.Call.Add(record.Time - begin);
+                    std::map<const mtsCommandBase *, double>::iterator finishedIter = finished.find(record.Command);
+                    if ((finishedIter != finished.end()) && (finishedIter->second >= begin)) {
+                        commandStatistics.Return.Add(record.Time - finishedIter->second);
+                        finished.erase(finishedIter);
+                    }
+                    if (events) {
+                        event.Type = 'X';
+                        event.Category = "function";
+                        event.Time = begin;
+                        event.Duration = record.Time - begin;
+                        events->push_back(event);
+                    }
+                }
+                break;
+            case mtsCommandTracer::ENQUEUE:
+                {
+                    Queued entry;
+                    entry.Time = record.Time;
+                    entry.Id = ++flowId;
+                    entry.Thread = iter->Thread;
+                    entry.Event = events ? events->size() : 0;
+                    queued[record.Command].push_back(entry);
+                    if (events) {
+                        event.Type = 's';
+                        event.Category = "queue";
+                        event.Id = entry.Id;
+                        events->push_back(event);
+                    }
+                }
+                break;
+            case mtsCommandTracer::ENQUEUE_FAILED:
+                {
+                    // discard the last ENQUEUE from this thread, it
+                    // will never be dequeued
+                    commandStatistics.QueueFull++;
+                    std::deque<Queued> & pending = queued[record.Command];
+                    std::deque<Queued>::iterator entry = pending.end();
+                    while (entry != pending.begin()) {
+                        --entry;
+                        if (entry->Thread == iter->Thread) {
+                            if (events) {
+                                TraceEvent & flowStart = (*events)[entry->Event];
+                                flowStart.Type = 'i';
+                                flowStart.Category = "queue full";
+                            }
+                            pending.erase(entry);
+                            break;
+                        }
+                    }
+                }
+                break;
+            case mtsCommandTracer::DEQUEUE:
+                {
+                    executing[key] = record.Time;
+                    std::deque<Queued> & pending = queued[record.Command];
+                    if (pending.empty()) {
+                        break;
+                    }
+                    const Queued entry = pending.front();
+                    pending.pop_front();
+                    commandStatistics.Queue.Add(record.Time - entry.Time);
+                    if (events) {
+                        event.Type = 'f';
+                        event.Category = "queue";
+                        event.Id = entry.Id;
+                        events->push_back(event);
+                    }
+                }
+                break;
+            case mtsCommandTracer::COMPLETE:
+                {
+                    std::map<CommandThreadType, double>::iterator executingIter = executing.find(key);
+                    if (executingIter == executing.end()) {
+                        break;
+                    }
+                    const double begin = executingIter->second;
+                    executing.erase(executingIter);
+                    commandStatistics.Execution.Add(record.Time - begin);
+                    if (events) {
+                        event.Type = 'X';
+                        event.Category = "execute";
+                        event.Time = begin;
+                        event.Duration = record.Time - begin;
+                        events->push_back(event);
+                    }
+                }
+                break;
+            case mtsCommandTracer::FINISHED_EVENT:
+                finished[record.Command] = record.Time;
+                if (events) {
+                    event.Type = 'i';
+                    event.Category = "finished";
+                    events->push_back(event);
+                }
+                break;
+            default:
+                break;
+            }
+        }
+    }
+
+    void JSONString(std::ostream & outputStream, const std::string & value)
+    {
+        outputStream << '"';
+        for (size_t index = 0; index < value.size(); ++index) {
+            const char c = value[index];
+            if ((c == '"') || (c == '\\')) {
+                outputStream << '\\' << c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                outputStream << ' ';
+            } else {
+                outputStream << c;
+            }
+        }
+        outputStream << '"';
+    }
+
+}
+
+
+void mtsCommandTracer::Start(const size_t recordsPerThread)
+{
+    Buffers & buffers = GetBuffers();
+    buffers.Mutex.Lock();
+    buffers.RecordsPerThread = (recordsPerThread > 0) ? recordsPerThread : 1;
+    buffers.Mutex.Unlock();
+    Enabled.store(true);
+}
+
+
+void mtsCommandTracer::Stop(void)
+{
+    Enabled.store(false);
+}
+
+
+void mtsCommandTracer::Record(const PhaseType phase, const mtsCommandBase * command)
+{
+    Buffer * buffer = GetCurrentBuffer();
+    const unsigned long long index = buffer->Written.load(std::memory_order_relaxed);
+    // readers who see part of this record will also see that Written
+    // reached index, i.e. that the slot is being reused
+    std::atomic_thread_fence(std::memory_order_release);
+    ::Record & record = buffer->Records[index % buffer->Records.size()];
+    record.Time = osaGetTime();
+    record.Command = command;
+    record.Phase = phase;
+    const std::string & name = command->GetName();
+    const size_t length = (name.size() < NAME_SIZE) ? name.size() : (NAME_SIZE - 1);
+    memcpy(record.Name, name.data(), length);
+    record.Name[length] = '\0';
+    buffer->Written.store(index + 1, std::memory_order_release);
+}
+
+
+void mtsCommandTracer::SetThreadName(const std::string & name)
+{
+    // don't allocate a buffer for threads that might never record
+    if (!CurrentBuffer.Current) {
+        CurrentThreadName = name;
+        return;
+    }
+    Buffers & buffers = GetBuffers();
+    buffers.Mutex.Lock();
+    CurrentBuffer.Current->ThreadName = name;
+    buffers.Mutex.Unlock();
+}
+
+
+void mtsCommandTracer::Clear(void)
+{
+    Buffers & buffers = GetBuffers();
+    buffers.Mutex.Lock();
+    for (size_t index = 0; index < buffers.List.size(); ++index) {
+        buffers.List[index]->Written.store(0);
+    }
+    buffers.Mutex.Unlock();
+}
+
+
+size_t mtsCommandTracer::GetNumberOfBuffers(void)
+{
+    Buffers & buffers = GetBuffers();
+    buffers.Mutex.Lock();
+    const size_t result = buffers.List.size();
+    buffers.Mutex.Unlock();
+    return result;
+}
+
+
+size_t mtsCommandTracer::GetNumberOfRecords(void)
+{
+    size_t result = 0;
+    Buffers & buffers = GetBuffers();
+    buffers.Mutex.Lock();
+    for (size_t index = 0; index < buffers.List.size(); ++index) {
+        const unsigned long long written = buffers.List[index]->Written.load();
+        const unsigned long long size = buffers.List[index]->Records.size();
+        result += static_cast<size_t>((written > size) ? size : written);
+    }
+    buffers.Mutex.Unlock();
+    return result;
+}
+
+
+unsigned long long mtsCommandTracer::GetNumberOfDropped(void)
+{
+    unsigned long long result = 0;
+    Buffers & buffers = GetBuffers();
+    buffers.Mutex.Lock();
+    for (size_t index = 0; index < buffers.List.size(); ++index) {
+        const unsigned long long written = buffers.List[index]->Written.load();
+        const unsigned long long size = buffers.List[index]->Records.size();
+        if (written > size) {
+            result += written - size;
+        }
+    }
+    buffers.Mutex.Unlock();
+    return result;
+}
+
+
+void mtsCommandTracer::ExportChromeTrace(std::ostream & outputStream)
+{
+    std::vector<ThreadRecord> records;
+    std::vector<std::string> threadNames;
+    CollectRecords(records, threadNames);
+    StatisticsType statistics;
+    std::vector<TraceEvent> events;
+    Analyze(records, statistics, &events);
+
+    // times in microseconds from the first record
+    const double origin = records.empty() ? 0.0 : records.front().Data.Time;
+    outputStream << "{\"traceEvents\":[" << std::endl;
+    bool first = true;
+    for (size_t thread = 0; thread < threadNames.size(); ++thread) {
+        outputStream << (first ? "" : ",\n")
+                     << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread
+                     << ",\"args\":{\"name\":";
+        JSONString(outputStream, threadNames[thread]);
+        outputStream << "}}";
+        first = false;
+    }
+    outputStream << std::fixed << std::setprecision(3);
+    const std::vector<TraceEvent>::const_iterator end = events.end();
+    std::vector<TraceEvent>::const_iterator event;
+    for (event = events.begin(); event != end; ++event) {
+        outputStream << (first ? "" : ",\n") << "{\"name\":";
+        JSONString(outputStream, event->Name);
+        outputStream << ",\"cat\":\"" << event->Category << "\",\"ph\":\"" << event->Type
+                     << "\",\"pid\":1,\"tid\":" << event->Thread
+                     << ",\"ts\":" << (event->Time - origin) * 1.0e6;
+        switch (event->Type) {
+        case 'X':
+            outputStream << ",\"dur\":" << event->Duration * 1.0e6;
+            break;
+        case 's':
+            outputStream << ",\"id\":" << event->Id;
+            break;
+        case 'f':
+            outputStream << ",\"id\":" << event->Id << ",\"bp\":\"e\"";
+            break;
+        case 'i':
+            outputStream << ",\"s\":\"t\"";
+            break;
+        default:
+            break;
+        }
+        outputStream << "}";
+        first = false;
+    }
+    outputStream << std::endl << "],\"displayTimeUnit\":\"ms\"}" << std::endl;
+}
+
+
+bool mtsCommandTracer::ExportChromeTrace(const std::string & fileName)
+{
+    std::ofstream outputStream(fileName.c_str());
+    if (!outputStream.good()) {
+        CMN_LOG_INIT_ERROR << "mtsCommandTracer::ExportChromeTrace: failed to open \"" << fileName << "\"" << std::endl;
+        return false;
+    }
+    ExportChromeTrace(outputStream);
+    outputStream.close();
+    return !outputStream.fail();
+}
+
+
+void mtsCommandTracer::GetStatistics(StatisticsType & statistics)
+{
+    std::vector<ThreadRecord> records;
+    std::vector<std::string> threadNames;
+    CollectRecords(records, threadNames);
+    statistics.clear();
+    Analyze(records, statistics, 0);
+}
+
+
+void mtsCommandTracer::ToStreamSummary(std::ostream & outputStream)
+{
+    StatisticsType statistics;
+    GetStatistics(statistics);
+    outputStream << std::left << std::setw(32) << "command"
+                 << std::right
+                 << std::setw(8) << "calls" << std::setw(12) << "call avg" << std::setw(12) << "call max"
+                 << std::setw(8) << "queued" << std::setw(12) << "queue avg" << std::setw(12) << "queue max"
+                 << std::setw(12) << "exec avg" << std::setw(12) << "exec max"
+                 << std::setw(12) << "return avg" << std::setw(12) << "return max"
+                 << std::setw(8) << "full" << std::endl;
+    outputStream << std::fixed << std::setprecision(1);
+    const StatisticsType::const_iterator end = statistics.end();
+    StatisticsType::const_iterator iter;
+    for (iter = statistics.begin(); iter != end; ++iter) {
+        const CommandStatistics & command = iter->second;
+        outputStream << std::left << std::setw(32) << iter->first
+                     << std::right
+                     << std::setw(8) << command.Call.Count
+                     << std::setw(12) << command.Call.Average() * 1.0e6
+                     << std::setw(12) << command.Call.Max * 1.0e6
+                     << std::setw(8) << command.Queue.Count
+                     << std::setw(12) << command.Queue.Average() * 1.0e6
+                     << std::setw(12) << command.Queue.Max * 1.0e6
+                     << std::setw(12) << command.Execution.Average() * 1.0e6
+                     << std::setw(12) << command.Execution.Max * 1.0e6
+                     << std::setw(12) << command.Return.Average() * 1.0e6
+                     << std::setw(12) << command.Return.Max * 1.0e6
+                     << std::setw(8) << command.QueueFull << std::endl;
+    }
+}
@@ -6,7 +6,7 @@
   Author(s):  Ankur Kapoor, Peter Kazanzides, Anton Deguet, Min Yang Jung
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2015 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -67,6 +67,8 @@ void mtsComponent::Initialize(void)
     this->StateTables.SetOwner(*this);
 
     InterfaceProvidedToManager = 0;
+    MailBoxReadyList = 0;
+    InterfacesRevision = 0;
 
     ReplayMode = false;
 }
@@ -86,6 +88,10 @@ mtsComponent::~mtsComponent()
     if (ManagerComponentServices) {
         delete ManagerComponentServices;
     }
+
+    if (MailBoxReadyList) {
+        delete MailBoxReadyList;
+    }
 }
 
 
@@ -259,6 +265,7 @@ mtsInterfaceProvided * mtsComponent::AddInterfaceProvidedWithoutSystemEvents(con
     }
     if (interfaceProvided) {
         if (InterfacesProvided.AddItem(interfaceProvidedName, interfaceProvided, CMN_LOG_LEVEL_INIT_ERROR)) {
+            InterfacesRevision++;
             return interfaceProvided;
         }
         CMN_LOG_CLASS_INIT_ERROR << "AddInterfaceProvided: component " << this->GetName() << " unable to add interface \""
@@ -382,6 +389,7 @@ bool mtsComponent::RemoveInterfaceProvided(const std::string & interfaceProvided
                                 << interfaceProvidedName << "\"" << std::endl;
         return false;
     }
+    InterfacesRevision++;
 
     delete interfaceProvided;
     CMN_LOG_CLASS_RUN_VERBOSE << "RemoveInterfaceProvided: removed provided interface \""
@@ -458,6 +466,7 @@ bool mtsComponent::RemoveInterfaceRequired(const std::string & interfaceRequired
                                 << interfaceRequiredName << "\"" << std::endl;
         return false;
     }
+    InterfacesRevision++;
 
     delete interfaceRequired;
     CMN_LOG_CLASS_RUN_VERBOSE << "RemoveInterfaceRequired: removed required interface \""
@@ -475,6 +484,7 @@ mtsInterfaceRequired * mtsComponent::AddInterfaceRequiredExisting(const std::str
         return 0;
     }
     if (InterfacesRequired.AddItem(interfaceRequiredName, interfaceRequired)) {
+        InterfacesRevision++;
         return interfaceRequired;
     }
     return 0;
@@ -493,6 +503,7 @@ mtsInterfaceRequired * mtsComponent::AddInterfaceRequiredUsingMailbox(const std:
     mtsInterfaceRequired * interfaceRequired = new mtsInterfaceRequired(interfaceRequiredName, this, mailBox, required);
     if (interfaceRequired) {
         if (InterfacesRequired.AddItem(interfaceRequiredName, interfaceRequired)) {
+            InterfacesRevision++;
             return interfaceRequired;
         }
         CMN_LOG_CLASS_INIT_ERROR << "AddInterfaceRequired: unable to add interface \""
@@ -551,6 +562,7 @@ mtsInterfaceInput * mtsComponent::AddInterfaceInputExisting(const std::string &
         return 0;
     }
     if (InterfacesInput.AddItem(interfaceInputName, interfaceInput)) {
+        InterfacesRevision++;
         return interfaceInput;
     }
     CMN_LOG_CLASS_INIT_ERROR << "AddInterfaceInputExisting: component \"" << this->GetName()
@@ -568,6 +580,7 @@ mtsInterfaceOutput * mtsComponent::AddInterfaceOutputExisting(const std::string
         return 0;
     }
     if (InterfacesOutput.AddItem(interfaceOutputName, interfaceOutput)) {
+        InterfacesRevision++;
         return interfaceOutput;
     }
     CMN_LOG_CLASS_INIT_ERROR << "AddInterfaceOutputExisting: component \"" << this->GetName()
@@ -670,6 +683,9 @@ bool mtsComponent::AddStateTable(mtsStateTable * existingStateTable, bool addInt
         providedInterface->AddCommandRead(&mtsStateTable::GetIndexReader,
                                           existingStateTable,
                                           "GetIndexReader");
+        providedInterface->AddCommandVoid(&mtsStateTable::FlightRecorderTrigger,
+                                          existingStateTable,
+                                          "TriggerFlightRecorder");
         providedInterface->AddEventWrite(existingStateTable->DataCollection.BatchReady,
                                          "BatchReady", mtsStateTable::IndexRange());
         providedInterface->AddEventVoid(existingStateTable->DataCollection.CollectionStarted,
@@ -693,12 +709,18 @@ bool mtsComponent::AddStateTable(mtsStateTable * existingStateTable, bool addInt
 size_t mtsComponent::ProcessMailBoxes(InterfacesProvidedMapType & interfaces)
 {
     size_t numberOfCommands = 0;
+    // only mailboxes with pending commands if ready list is used
+    if (this->MailBoxReadyList) {
+        numberOfCommands += this->MailBoxReadyList->ExecuteAll();
+    }
     InterfacesProvidedMapType::iterator iterator = interfaces.begin();
     const InterfacesProvidedMapType::iterator end = interfaces.end();
     for (;
          iterator != end;
          ++iterator) {
-        numberOfCommands += iterator->second->ProcessMailBoxes();
+        if (!iterator->second->GetMailBoxReadyList()) {
+            numberOfCommands += iterator->second->ProcessMailBoxes();
+        }
     }
     return numberOfCommands;
 }
@@ -818,6 +840,12 @@ bool mtsComponent::IsRunning(void) const
 }
 
 
+const void * mtsComponent::GetExecutionContext(void) const
+{
+    return 0;
+}
+
+
 bool mtsComponent::IsStarted(void) const
 {
     return (this->State >= mtsComponentState::READY);
@@ -167,13 +167,15 @@ mtsCommandWriteBase *mtsEventReceiverWrite::GetCommand()
 
 void mtsEventReceiverWrite::EventHandler(const mtsGenericObject &arg)
 {
-    if (Waiting)
-        EventSignal->Raise();
+    // Copy before raising the signal, the waiting thread resets ArgPtr as
+    // soon as it wakes up and the object pointed to might not exist anymore.
     if (ArgPtr && !ArgPtr->Services()->Create(ArgPtr, arg)) {
         CMN_LOG_RUN_ERROR << "mtsEventReceiverWrite: could not copy from " << arg.Services()->GetName()
                           << " to " << ArgPtr->Services()->GetName() << std::endl;
         ArgPtr = 0; // Set this to signal an error
     }
+    if (Waiting)
+        EventSignal->Raise();
     if (UserHandler)
         UserHandler->Execute(arg, MTS_NOT_BLOCKING);
 }
@@ -5,7 +5,7 @@
 
   Author(s):  Peter Kazanzides, Anton Deguet
 
-  (C) Copyright 2007-2014 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2007-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -20,6 +20,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstMultiTask/mtsFunctionQualifiedRead.h>
 #include <cisstMultiTask/mtsCommandQualifiedRead.h>
 #include <cisstMultiTask/mtsEventReceiver.h>
+#include <cisstMultiTask/mtsCommandTracer.h>
 
 
 mtsFunctionQualifiedRead::mtsFunctionQualifiedRead(void):
@@ -60,6 +61,7 @@ bool mtsFunctionQualifiedRead::Bind(CommandType * command) {
 mtsExecutionResult mtsFunctionQualifiedRead::ExecuteGeneric(const mtsGenericObject & qualifier,
                                                             mtsGenericObject & argument) const
 {
+    mtsCommandTracer::Scope trace(Command);
     if (!Command)
         return mtsExecutionResult::FUNCTION_NOT_BOUND;
 #if CISST_MTS_HAS_ICE
@@ -5,7 +5,7 @@
 
   Author(s):  Peter Kazanzides, Anton Deguet
 
-  (C) Copyright 2007-2014 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2007-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -20,6 +20,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstMultiTask/mtsFunctionRead.h>
 #include <cisstMultiTask/mtsCommandRead.h>
 #include <cisstMultiTask/mtsEventReceiver.h>
+#include <cisstMultiTask/mtsCommandTracer.h>
 
 
 mtsFunctionRead::mtsFunctionRead(void):
@@ -58,6 +59,7 @@ bool mtsFunctionRead::Bind(CommandType * command) {
 
 mtsExecutionResult mtsFunctionRead::ExecuteGeneric(mtsGenericObject & argument) const
 {
+    mtsCommandTracer::Scope trace(Command);
     if (!Command)
         return mtsExecutionResult::FUNCTION_NOT_BOUND;
     mtsExecutionResult executionResult;
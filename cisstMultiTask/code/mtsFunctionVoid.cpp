@@ -5,7 +5,7 @@
 
   Author(s):  Peter Kazanzides, Anton Deguet
 
-  (C) Copyright 2007-2014 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2007-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -20,11 +20,15 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstMultiTask/mtsFunctionVoid.h>
 #include <cisstMultiTask/mtsCommandVoid.h>
 #include <cisstMultiTask/mtsEventReceiver.h>
+#include <cisstMultiTask/mtsCommandTracer.h>
+#include <cisstMultiTask/mtsComponent.h>
 
 
 mtsFunctionVoid::mtsFunctionVoid(const bool isProxy):
     mtsFunctionBase(isProxy),
-    Command(0)
+    Command(0),
+    DirectCommand(0),
+    DirectCommandComponent(0)
 {}
 
 
@@ -36,6 +40,8 @@ bool mtsFunctionVoid::Detach(void)
 {
     if (this->IsValid()) {
         this->Command = 0;
+        this->DirectCommand = 0;
+        this->DirectCommandComponent = 0;
         return true;
     }
     return false;
@@ -49,11 +55,25 @@ bool mtsFunctionVoid::IsValid(void) const
 
 
 bool mtsFunctionVoid::Bind(CommandType * command)
+{
+    return Bind(command, 0, 0);
+}
+
+
+bool mtsFunctionVoid::Bind(CommandType * command, CommandType * directCommand,
+                           const mtsComponent * directCommandComponent)
 {
     if (this->Command) {
         CMN_LOG_INIT_WARNING << "Class mtsFunctionVoid: Bind called on already bound function:" << this << std::endl;
     }
     this->Command = command;
+    if (command && directCommand && directCommandComponent) {
+        this->DirectCommand = directCommand;
+        this->DirectCommandComponent = directCommandComponent;
+    } else {
+        this->DirectCommand = 0;
+        this->DirectCommandComponent = 0;
+    }
 #if !CISST_MTS_HAS_ICE
     if (this->Command)
         InitCompletionCommand(this->Command->GetName() + "Blocking");
@@ -62,18 +82,32 @@ bool mtsFunctionVoid::Bind(CommandType * command)
 }
 
 
+mtsFunctionVoid::CommandType * mtsFunctionVoid::CurrentCommand(void) const
+{
+    // commands can't be executed directly before the component is started
+    if (DirectCommand && DirectCommandComponent->IsRunning()) {
+        return DirectCommand;
+    }
+    return Command;
+}
+
+
 mtsExecutionResult mtsFunctionVoid::Execute(void) const
 {
-    return Command ? Command->Execute(MTS_NOT_BLOCKING) : mtsExecutionResult::FUNCTION_NOT_BOUND;
+    CommandType * command = CurrentCommand();
+    mtsCommandTracer::Scope trace(command);
+    return command ? command->Execute(MTS_NOT_BLOCKING) : mtsExecutionResult::FUNCTION_NOT_BOUND;
 }
 
 
 mtsExecutionResult mtsFunctionVoid::ExecuteBlocking(void) const
 {
-    if (!Command)
+    CommandType * command = CurrentCommand();
+    mtsCommandTracer::Scope trace(command);
+    if (!command)
         return mtsExecutionResult::FUNCTION_NOT_BOUND;
 #if CISST_MTS_HAS_ICE
-    mtsExecutionResult executionResult = Command->Execute(MTS_BLOCKING);
+    mtsExecutionResult executionResult = command->Execute(MTS_BLOCKING);
     if (executionResult.GetResult() == mtsExecutionResult::COMMAND_QUEUED
         && !this->IsProxy) {
         this->ThreadSignalWait();
@@ -82,7 +116,7 @@ mtsExecutionResult mtsFunctionVoid::ExecuteBlocking(void) const
 #else
     // If Command is valid (not NULL), then CompletionCommand should also be valid
     CMN_ASSERT(CompletionCommand);
-    mtsExecutionResult executionResult = Command->Execute(MTS_BLOCKING, CompletionCommand->GetCommand());
+    mtsExecutionResult executionResult = command->Execute(MTS_BLOCKING, CompletionCommand->GetCommand());
     if (executionResult.GetResult() == mtsExecutionResult::COMMAND_QUEUED)
         executionResult = WaitForResult();
 #endif
@@ -91,7 +125,7 @@ mtsExecutionResult mtsFunctionVoid::ExecuteBlocking(void) const
 
 
 mtsCommandVoid * mtsFunctionVoid::GetCommand(void) const {
-    return Command;
+    return CurrentCommand();
 }
 
 
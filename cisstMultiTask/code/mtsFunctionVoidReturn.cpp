@@ -6,7 +6,7 @@
   Author(s): Anton Deguet
   Created on: 2005-05-02
 
-  (C) Copyright 2010-2014 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2010-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -21,6 +21,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstMultiTask/mtsFunctionVoidReturn.h>
 #include <cisstMultiTask/mtsCommandVoidReturn.h>
 #include <cisstMultiTask/mtsEventReceiver.h>
+#include <cisstMultiTask/mtsCommandTracer.h>
 
 
 mtsFunctionVoidReturn::mtsFunctionVoidReturn(const bool isProxy):
@@ -65,6 +66,7 @@ bool mtsFunctionVoidReturn::Bind(CommandType * command)
 
 mtsExecutionResult mtsFunctionVoidReturn::ExecuteGeneric(mtsGenericObject & result) const
 {
+    mtsCommandTracer::Scope trace(Command);
     if (!Command)
         return mtsExecutionResult::FUNCTION_NOT_BOUND;
 #if CISST_MTS_HAS_ICE
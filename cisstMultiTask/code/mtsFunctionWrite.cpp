@@ -5,7 +5,7 @@
 
   Author(s):  Peter Kazanzides, Anton Deguet
 
-  (C) Copyright 2007-2014 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2007-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -20,11 +20,15 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstMultiTask/mtsFunctionWrite.h>
 #include <cisstMultiTask/mtsCommandWriteBase.h>
 #include <cisstMultiTask/mtsEventReceiver.h>
+#include <cisstMultiTask/mtsCommandTracer.h>
+#include <cisstMultiTask/mtsComponent.h>
 
 
 mtsFunctionWrite::mtsFunctionWrite(const bool isProxy):
     mtsFunctionBase(isProxy),
-    Command(0)
+    Command(0),
+    DirectCommand(0),
+    DirectCommandComponent(0)
 {}
 
 
@@ -35,6 +39,8 @@ mtsFunctionWrite::~mtsFunctionWrite()
 bool mtsFunctionWrite::Detach(void) {
     if (this->IsValid()) {
         Command = 0;
+        DirectCommand = 0;
+        DirectCommandComponent = 0;
         return true;
     }
     return false;
@@ -47,7 +53,20 @@ bool mtsFunctionWrite::IsValid(void) const {
 
 
 bool mtsFunctionWrite::Bind(CommandType * command) {
+    return Bind(command, 0, 0);
+}
+
+
+bool mtsFunctionWrite::Bind(CommandType * command, CommandType * directCommand,
+                            const mtsComponent * directCommandComponent) {
     Command = command;
+    if (command && directCommand && directCommandComponent) {
+        DirectCommand = directCommand;
+        DirectCommandComponent = directCommandComponent;
+    } else {
+        DirectCommand = 0;
+        DirectCommandComponent = 0;
+    }
 #if !CISST_MTS_HAS_ICE
     if (Command)
         InitCompletionCommand(Command->GetName() + "Blocking");
@@ -56,18 +75,40 @@ bool mtsFunctionWrite::Bind(CommandType * command) {
 }
 
 
+mtsFunctionWrite::CommandType * mtsFunctionWrite::CurrentCommand(void) const
+{
+    // commands can't be executed directly before the component is started
+    if (DirectCommand && DirectCommandComponent->IsRunning()) {
+        return DirectCommand;
+    }
+    return Command;
+}
+
+
 mtsExecutionResult mtsFunctionWrite::ExecuteGeneric(const mtsGenericObject & argument) const
 {
-    return Command ? Command->Execute(argument, MTS_NOT_BLOCKING) : mtsExecutionResult::FUNCTION_NOT_BOUND;
+    CommandType * command = CurrentCommand();
+    mtsCommandTracer::Scope trace(command);
+    return command ? command->Execute(argument, MTS_NOT_BLOCKING) : mtsExecutionResult::FUNCTION_NOT_BOUND;
+}
+
+
+mtsExecutionResult mtsFunctionWrite::ExecuteSwap(mtsGenericObject & argument) const
+{
+    CommandType * command = CurrentCommand();
+    mtsCommandTracer::Scope trace(command);
+    return command ? command->ExecuteSwap(argument, MTS_NOT_BLOCKING, 0) : mtsExecutionResult::FUNCTION_NOT_BOUND;
 }
 
 
 mtsExecutionResult mtsFunctionWrite::ExecuteBlockingGeneric(const mtsGenericObject & argument) const
 {
-    if (!Command)
+    CommandType * command = CurrentCommand();
+    mtsCommandTracer::Scope trace(command);
+    if (!command)
         return mtsExecutionResult::FUNCTION_NOT_BOUND;
 #if CISST_MTS_HAS_ICE
-    mtsExecutionResult executionResult = Command->Execute(argument, MTS_BLOCKING);
+    mtsExecutionResult executionResult = command->Execute(argument, MTS_BLOCKING);
     if (executionResult.GetResult() == mtsExecutionResult::COMMAND_QUEUED
         && !this->IsProxy) {
         this->ThreadSignalWait();
@@ -76,7 +117,7 @@ mtsExecutionResult mtsFunctionWrite::ExecuteBlockingGeneric(const mtsGenericObje
 #else
     // If Command is valid (not NULL), then CompletionCommand should also be valid
     CMN_ASSERT(CompletionCommand);
-    mtsExecutionResult executionResult = Command->Execute(argument, MTS_BLOCKING, CompletionCommand->GetCommand());
+    mtsExecutionResult executionResult = command->Execute(argument, MTS_BLOCKING, CompletionCommand->GetCommand());
     if (executionResult.GetResult() == mtsExecutionResult::COMMAND_QUEUED)
         executionResult = WaitForResult();
 #endif
@@ -85,7 +126,7 @@ mtsExecutionResult mtsFunctionWrite::ExecuteBlockingGeneric(const mtsGenericObje
 
 
 mtsFunctionWrite::CommandType * mtsFunctionWrite::GetCommand(void) const {
-    return Command;
+    return CurrentCommand();
 }
 
 
@@ -5,7 +5,7 @@
   Author(s):  Anton Deguet
   Created on: 2009-04-13
 
-  (C) Copyright 2009-2018 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -20,6 +20,7 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <iostream>
 #include <iomanip>
+#include <utility>
 
 bool mtsGenericObject::SetTimestampIfAutomatic(double timestamp) {
     if (this->AutomaticTimestampMember) {
@@ -101,6 +102,20 @@ void mtsGenericObject::DeSerializeRaw(std::istream & inputStream) {
 }
 
 
+bool mtsGenericObject::Swap(mtsGenericObject & CMN_UNUSED(other))
+{
+    return false;
+}
+
+
+void mtsGenericObject::SwapGenericObject(mtsGenericObject & other)
+{
+    std::swap(this->TimestampMember, other.TimestampMember);
+    std::swap(this->AutomaticTimestampMember, other.AutomaticTimestampMember);
+    std::swap(this->ValidMember, other.ValidMember);
+}
+
+
 size_t mtsGenericObject::ScalarNumber(void) const
 {
     return cmnData<mtsGenericObject>::ScalarNumber(*this);
@@ -5,7 +5,7 @@
   Author(s):  Ankur Kapoor, Peter Kazanzides, Anton Deguet, Min Yang Jung
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2017 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -23,6 +23,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstMultiTask/mtsCommandQueuedVoid.h>
 #include <cisstMultiTask/mtsCommandQueuedVoidReturn.h>
 #include <cisstMultiTask/mtsCommandQueuedWrite.h>
+#include <cisstMultiTask/mtsCommandQueuedWriteLatest.h>
 #include <cisstMultiTask/mtsCommandQueuedWriteReturn.h>
 #include <cisstMultiTask/mtsCommandFilteredWrite.h>
 #include <cisstMultiTask/mtsCommandFilteredQueuedWrite.h>
@@ -40,6 +41,7 @@ mtsInterfaceProvided::mtsInterfaceProvided(const std::string & name, mtsComponen
     IsProxy(isProxy),
     MailBox(0),
     QueueingPolicy(queueingPolicy),
+    MailBoxReadyList(0),
     ArgumentQueuesSize(DEFAULT_MAIL_BOX_AND_ARGUMENT_QUEUES_SIZE),
     BlockingCommandExecuted(0),
     BlockingCommandReturnExecuted(0),
@@ -119,6 +121,7 @@ mtsInterfaceProvided::mtsInterfaceProvided(mtsInterfaceProvided * originalInterf
     MailBox(0),
     QueueingPolicy(MTS_COMMANDS_SHOULD_BE_QUEUED),
     MailBoxSize(mailBoxSize),
+    MailBoxReadyList(originalInterface->MailBoxReadyList),
     ArgumentQueuesSize(argumentQueuesSize),
     BlockingCommandExecuted(0),
     BlockingCommandReturnExecuted(0),
@@ -153,6 +156,9 @@ mtsInterfaceProvided::mtsInterfaceProvided(mtsInterfaceProvided * originalInterf
         MailBox = new mtsMailBox(this->GetName(),
                                  mailBoxSize,
                                  this->PostCommandQueuedCallable);
+        if (this->MailBoxReadyList) {
+            MailBox->SetReadyList(this->MailBoxReadyList);
+        }
 
         // clone void commands
         CloneCommands<CommandVoidMapType, mtsCommandQueuedVoid>("void", originalInterface->CommandsVoid, CommandsVoid);
@@ -285,6 +291,38 @@ mtsMailBox * mtsInterfaceProvided::GetMailBox(void)
 }
 
 
+void mtsInterfaceProvided::SetMailBoxReadyList(mtsMailBoxReadyList * readyList)
+{
+    if (this->EndUserInterface) {
+        CMN_LOG_CLASS_INIT_ERROR << "SetMailBoxReadyList: called on end user interface for "
+                                 << this->GetFullName() << std::endl;
+        return;
+    }
+    this->MailBoxReadyList = readyList;
+    // update existing end users, this is not thread safe and should
+    // be done before commands are queued
+    InterfaceProvidedCreatedListType::iterator iterator = InterfacesProvidedCreated.begin();
+    const InterfaceProvidedCreatedListType::iterator end = InterfacesProvidedCreated.end();
+    mtsMailBox * mailBox;
+    for (; iterator != end; ++iterator) {
+        iterator->second->MailBoxReadyList = readyList;
+        mailBox = iterator->second->GetMailBox();
+        if (mailBox) {
+            mailBox->SetReadyList(readyList);
+            if (readyList && !mailBox->IsEmpty()) {
+                readyList->Schedule(mailBox);
+            }
+        }
+    }
+}
+
+
+mtsMailBoxReadyList * mtsInterfaceProvided::GetMailBoxReadyList(void) const
+{
+    return this->MailBoxReadyList;
+}
+
+
 bool mtsInterfaceProvided::UseQueueBasedOnInterfacePolicy(mtsCommandQueueingPolicy queueingPolicy,
                                                           const std::string & methodName,
                                                           const std::string & commandName)
@@ -314,7 +352,7 @@ bool mtsInterfaceProvided::UseQueueBasedOnInterfacePolicy(mtsCommandQueueingPoli
         }
         return false;
     }
-    if (queueingPolicy == MTS_COMMAND_QUEUED) {
+    if ((queueingPolicy == MTS_COMMAND_QUEUED) || (queueingPolicy == MTS_COMMAND_QUEUED_LATEST)) {
         // send error if the interface has no mailbox, can not queue
         if (this->QueueingPolicy == MTS_COMMANDS_SHOULD_BE_QUEUED) {
             // send message to tell explicit queueing policy is useless
@@ -467,7 +505,11 @@ mtsCommandWriteBase * mtsInterfaceProvided::AddCommandWrite(mtsCommandWriteBase
             bool wasCreated = false;
             if (!queuedCommand) {
                 // if not already queued, create with no mailbox
-                queuedCommand = new mtsCommandQueuedWriteGeneric(0, command, 0);
+                if (queueingPolicy == MTS_COMMAND_QUEUED_LATEST) {
+                    queuedCommand = new mtsCommandQueuedWriteLatest(0, command);
+                } else {
+                    queuedCommand = new mtsCommandQueuedWriteGeneric(0, command, 0);
+                }
                 wasCreated = true;
             }
             if (!CommandsWrite.AddItem(command->GetName(), queuedCommand, CMN_LOG_LEVEL_INIT_ERROR)) {
@@ -759,6 +801,10 @@ mtsInterfaceProvided * mtsInterfaceProvided::RemoveEndUserInterface(mtsInterface
                                       << "\" removing copy (#" << iterator->first
                                       << ") for user \"" << userName << "\"" << std::endl;
             InterfacesProvidedCreated.erase(iterator);
+            // make sure the mailbox is not processed anymore
+            if (interfaceProvided->MailBox) {
+                interfaceProvided->MailBox->SetReadyList(0);
+            }
             delete interfaceProvided;
             return 0;
         }
@@ -5,7 +5,7 @@
   Author(s):  Peter Kazanzides, Anton Deguet
   Created on: 2008-11-13
 
-  (C) Copyright 2008-2017 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2008-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -25,6 +25,9 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstMultiTask/mtsFunctionRead.h>
 #include <cisstMultiTask/mtsFunctionQualifiedRead.h>
 #include <cisstMultiTask/mtsEventReceiver.h>
+#include <cisstMultiTask/mtsComponent.h>
+#include <cisstMultiTask/mtsCommandQueuedVoid.h>
+#include <cisstMultiTask/mtsCommandQueuedWriteBase.h>
 
 #include <cisstCommon/cmnSerializer.h>
 #include <cisstMultiTask/mtsInterfaceProvided.h>
@@ -154,7 +157,7 @@ bool mtsInterfaceRequired::UseQueueBasedOnInterfacePolicy(mtsEventQueueingPolicy
             return true;
         }
     } else {
-        if (queueingPolicy == MTS_EVENT_QUEUED) {
+        if ((queueingPolicy == MTS_EVENT_QUEUED) || (queueingPolicy == MTS_EVENT_QUEUED_LATEST)) {
             CMN_LOG_CLASS_INIT_ERROR  << methodName << ": event handler for \"" << eventName
                                       << "\" has been added as queued while the corresponding required interface \""
                                       << this->GetFullName() << "\" has been created without a mailbox." << std::endl;
@@ -408,6 +411,23 @@ void mtsInterfaceRequired::BlockingCommandReturnExecutedHandler(void)
 }
 
 
+bool mtsInterfaceRequired::SharesExecutionContext(const mtsInterfaceProvided * interfaceProvided) const
+{
+    const mtsComponent * client = this->GetComponent();
+    const mtsComponent * server = interfaceProvided->GetComponent();
+    if (!client || !server) {
+        return false;
+    }
+    // a component calling itself would run the command from within
+    // its own command or Run, keep the queue
+    if (client == server) {
+        return false;
+    }
+    const void * context = client->GetExecutionContext();
+    return (context && (context == server->GetExecutionContext()));
+}
+
+
 bool mtsInterfaceRequired::BindCommands(const mtsInterfaceProvided * interfaceProvided)
 {
     bool success = true;
@@ -431,6 +451,17 @@ bool mtsInterfaceRequired::BindCommands(const mtsInterfaceProvided * interfacePr
     // not considered connected until after the command binding is
     // done (though event receivers/handlers have yet to be set up).
 
+    // If both components are executed by the same thread, void and
+    // write functions use the non queued commands once the component
+    // providing them is running (see mtsComponent::GetExecutionContext)
+    const bool directCall = SharesExecutionContext(interfaceProvided);
+    if (directCall) {
+        CMN_LOG_CLASS_INIT_VERBOSE << "BindCommands: \"" << this->GetFullName() << "\" and \""
+                                   << interfaceProvided->GetFullName()
+                                   << "\" share the same execution context, void and write commands will not be queued once the provider is running"
+                                   << std::endl;
+    }
+
     FunctionInfoMapType::iterator iter;
     mtsFunctionVoid * functionVoid;
     for (iter = FunctionsVoid.begin();
@@ -448,7 +479,14 @@ bool mtsInterfaceRequired::BindCommands(const mtsInterfaceProvided * interfacePr
                                          << typeid(iter->second->Pointer).name() << "\")" << std::endl;
                 result = false;
             } else {
-                result = functionVoid->Bind(interfaceProvided->GetCommandVoid(iter->first, iter->second->Required));
+                mtsCommandVoid * command = interfaceProvided->GetCommandVoid(iter->first, iter->second->Required);
+                mtsCommandQueuedVoid * queuedCommand = dynamic_cast<mtsCommandQueuedVoid *>(command);
+                if (directCall && queuedCommand) {
+                    result = functionVoid->Bind(command, queuedCommand->GetActualCommand(),
+                                                interfaceProvided->GetComponent());
+                } else {
+                    result = functionVoid->Bind(command);
+                }
                 if (!result) {
                     if (iter->second->Required == MTS_OPTIONAL) {
                         CMN_LOG_CLASS_INIT_VERBOSE << "BindCommands: couldn't find optional void command \""
@@ -534,7 +572,14 @@ bool mtsInterfaceRequired::BindCommands(const mtsInterfaceProvided * interfacePr
                                          << typeid(iter->second->Pointer).name() << "\")" << std::endl;
                 result = false;
             } else {
-                result = functionWrite->Bind(interfaceProvided->GetCommandWrite(iter->first, iter->second->Required));
+                mtsCommandWriteBase * command = interfaceProvided->GetCommandWrite(iter->first, iter->second->Required);
+                mtsCommandQueuedWriteBase * queuedCommand = dynamic_cast<mtsCommandQueuedWriteBase *>(command);
+                if (directCall && queuedCommand) {
+                    result = functionWrite->Bind(command, queuedCommand->GetActualCommand(),
+                                                 interfaceProvided->GetComponent());
+                } else {
+                    result = functionWrite->Bind(command);
+                }
                 if (!result) {
                     if (iter->second->Required == MTS_OPTIONAL) {
                         CMN_LOG_CLASS_INIT_VERBOSE << "BindCommands: couldn't find optional write command \""
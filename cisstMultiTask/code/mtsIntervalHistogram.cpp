@@ -0,0 +1,118 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstMultiTask/mtsIntervalHistogram.h>
+
+#include <string.h>
+#include <cmath>
+
+
+mtsIntervalHistogram::mtsIntervalHistogram(void)
+{
+    Reset();
+}
+
+
+void mtsIntervalHistogram::Reset(void)
+{
+    memset(Counts, 0, sizeof(Counts));
+    NumberOfSamples = 0;
+    MinValue = 0;
+    MaxValue = 0;
+}
+
+
+size_t mtsIntervalHistogram::BucketIndex(const ValueType value)
+{
+    if (value < SUB_BUCKET_COUNT) {
+        return static_cast<size_t>(value);
+    }
+    // position of most significant bit
+    ValueType remaining = value;
+    unsigned int msb = 0;
+    if (remaining >= (1ULL << 32)) { remaining >>= 32; msb += 32; }
+    if (remaining >= (1ULL << 16)) { remaining >>= 16; msb += 16; }
+    if (remaining >= (1ULL << 8))  { remaining >>= 8;  msb += 8; }
+    if (remaining >= (1ULL << 4))  { remaining >>= 4;  msb += 4; }
+    if (remaining >= (1ULL << 2))  { remaining >>= 2;  msb += 2; }
+    if (remaining >= (1ULL << 1))  { msb += 1; }
+    // keep SUB_BUCKET_BITS significant bits, first one is always set
+    const unsigned int shift = msb - (SUB_BUCKET_BITS - 1);
+    if (shift > MAXIMUM_SHIFT) {
+        return NUMBER_OF_BUCKETS - 1;
+    }
+    const size_t subBucket = static_cast<size_t>(value >> shift) - SUB_BUCKET_HALF_COUNT;
+    return SUB_BUCKET_COUNT + (shift - 1) * SUB_BUCKET_HALF_COUNT + subBucket;
+}
+
+
+mtsIntervalHistogram::ValueType mtsIntervalHistogram::BucketUpperBound(const size_t index)
+{
+    if (index < SUB_BUCKET_COUNT) {
+        return static_cast<ValueType>(index);
+    }
+    const size_t offset = index - SUB_BUCKET_COUNT;
+    const unsigned int shift = static_cast<unsigned int>(offset / SUB_BUCKET_HALF_COUNT) + 1;
+    const ValueType subBucket = static_cast<ValueType>(offset % SUB_BUCKET_HALF_COUNT) + SUB_BUCKET_HALF_COUNT;
+    return ((subBucket + 1) << shift) - 1;
+}
+
+
+void mtsIntervalHistogram::Add(const double valueInSeconds)
+{
+    ValueType value = 0;
+    if (valueInSeconds > 0.0) {
+        value = static_cast<ValueType>(valueInSeconds * 1.0e9 + 0.5);
+    }
+    if ((NumberOfSamples == 0) || (value < MinValue)) {
+        MinValue = value;
+    }
+    if (value > MaxValue) {
+        MaxValue = value;
+    }
+    Counts[BucketIndex(value)]++;
+    NumberOfSamples++;
+}
+
+
+double mtsIntervalHistogram::Percentile(const double percentage) const
+{
+    if (NumberOfSamples == 0) {
+        return 0.0;
+    }
+    // rank of the sample we are looking for, starting at 1
+    double rank = std::ceil(percentage * static_cast<double>(NumberOfSamples) / 100.0);
+    if (rank < 1.0) {
+        rank = 1.0;
+    }
+    unsigned int count = 0;
+    size_t index = 0;
+    for (; index < NUMBER_OF_BUCKETS - 1; ++index) {
+        count += Counts[index];
+        if (static_cast<double>(count) >= rank) {
+            break;
+        }
+    }
+    ValueType value = BucketUpperBound(index);
+    if (value > MaxValue) {
+        value = MaxValue;
+    }
+    if (value < MinValue) {
+        value = MinValue;
+    }
+    return static_cast<double>(value) * 1.0e-9;
+}
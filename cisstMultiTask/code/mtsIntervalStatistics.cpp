@@ -5,7 +5,7 @@
   Author(s): Marcin Balicki, Anton Deguet
   Created on: 2010-03-31
 
-  (C) Copyright 2004-2019 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -42,9 +42,18 @@ mtsIntervalStatistics::mtsIntervalStatistics():
     mComputeTimeStdDev(0.0),
     mComputeTimeMin(0.0),
     mComputeTimeMax(0.0),
+    mPeriodP50(0.0),
+    mPeriodP90(0.0),
+    mPeriodP99(0.0),
+    mPeriodP999(0.0),
+    mComputeTimeP50(0.0),
+    mComputeTimeP90(0.0),
+    mComputeTimeP99(0.0),
+    mComputeTimeP999(0.0),
     mNumberOfSamples(0),
     mNumberOfOverruns(0),
-    mStatisticsInterval(1.0)
+    mStatisticsInterval(1.0),
+    mPercentilesEnabled(false)
 {
     // Get a pointer to the time server
     mTimeServer = &mtsTaskManager::GetInstance()->GetTimeServer();
@@ -65,6 +74,17 @@ void mtsIntervalStatistics::ToStream(std::ostream & outputStream) const
                  << " NumberOfSamples: " << mNumberOfSamples // 10
                  << " NumberOfOverruns: " << mNumberOfOverruns
                  << " StatisticsInterval: " << mStatisticsInterval;
+    if (!mPercentilesEnabled) {
+        return;
+    }
+    outputStream << " PeriodP50: " << mPeriodP50
+                 << " PeriodP90: " << mPeriodP90 // 15
+                 << " PeriodP99: " << mPeriodP99
+                 << " PeriodP999: " << mPeriodP999
+                 << " ComputeTimeP50: " << mComputeTimeP50
+                 << " ComputeTimeP90: " << mComputeTimeP90
+                 << " ComputeTimeP99: " << mComputeTimeP99 // 20
+                 << " ComputeTimeP999: " << mComputeTimeP999;
 }
 
 
@@ -86,6 +106,18 @@ void mtsIntervalStatistics::ToStreamRaw(std::ostream & outputStream, const char
                      << headerPrefix << "-NumberOfSamples" << delimiter // 10
                      << headerPrefix << "-NumberOfOverruns" << delimiter
                      << headerPrefix << "-StatisticsInterval";
+        if (!mPercentilesEnabled) {
+            return;
+        }
+        outputStream << delimiter
+                     << headerPrefix << "-PeriodP50" << delimiter
+                     << headerPrefix << "-PeriodP90" << delimiter // 15
+                     << headerPrefix << "-PeriodP99" << delimiter
+                     << headerPrefix << "-PeriodP999" << delimiter
+                     << headerPrefix << "-ComputeTimeP50" << delimiter
+                     << headerPrefix << "-ComputeTimeP90" << delimiter
+                     << headerPrefix << "-ComputeTimeP99" << delimiter // 20
+                     << headerPrefix << "-ComputeTimeP999";
     } else {
         outputStream << this->TimestampMember << delimiter // 1
                      << this->mPeriodAvg << delimiter
@@ -99,6 +131,18 @@ void mtsIntervalStatistics::ToStreamRaw(std::ostream & outputStream, const char
                      << this->mNumberOfSamples << delimiter // 10
                      << this->mNumberOfOverruns << delimiter
                      << this->mStatisticsInterval;
+        if (!mPercentilesEnabled) {
+            return;
+        }
+        outputStream << delimiter
+                     << this->mPeriodP50 << delimiter
+                     << this->mPeriodP90 << delimiter // 15
+                     << this->mPeriodP99 << delimiter
+                     << this->mPeriodP999 << delimiter
+                     << this->mComputeTimeP50 << delimiter
+                     << this->mComputeTimeP90 << delimiter
+                     << this->mComputeTimeP99 << delimiter // 20
+                     << this->mComputeTimeP999;
     }
 }
 
@@ -116,7 +160,22 @@ void mtsIntervalStatistics::SerializeRaw(std::ostream & outputStream) const
     cmnSerializeRaw(outputStream, mComputeTimeMax);
     cmnSerializeRaw(outputStream, mNumberOfSamples); // 10
     cmnSerializeRaw(outputStream, mNumberOfOverruns);
+    if (!mPercentilesEnabled) {
+        cmnSerializeRaw(outputStream, mStatisticsInterval);
+        return;
+    }
+    // NaN can't be a valid interval, used as tag so the receiver
+    // knows the interval and percentiles follow
+    cmnSerializeRaw(outputStream, cmnTypeTraits<double>::NaN());
     cmnSerializeRaw(outputStream, mStatisticsInterval);
+    cmnSerializeRaw(outputStream, mPeriodP50);
+    cmnSerializeRaw(outputStream, mPeriodP90); // 15
+    cmnSerializeRaw(outputStream, mPeriodP99);
+    cmnSerializeRaw(outputStream, mPeriodP999);
+    cmnSerializeRaw(outputStream, mComputeTimeP50);
+    cmnSerializeRaw(outputStream, mComputeTimeP90);
+    cmnSerializeRaw(outputStream, mComputeTimeP99); // 20
+    cmnSerializeRaw(outputStream, mComputeTimeP999);
 }
 
 void mtsIntervalStatistics::DeSerializeRaw(std::istream & inputStream)
@@ -133,8 +192,38 @@ void mtsIntervalStatistics::DeSerializeRaw(std::istream & inputStream)
     cmnDeSerializeRaw(inputStream, mNumberOfSamples); // 10
     cmnDeSerializeRaw(inputStream, mNumberOfOverruns);
     cmnDeSerializeRaw(inputStream, mStatisticsInterval);
+    mPercentilesEnabled = cmnTypeTraits<double>::IsNaN(mStatisticsInterval);
+    if (!mPercentilesEnabled) {
+        mPeriodP50 = mPeriodP90 = mPeriodP99 = mPeriodP999 = 0.0;
+        mComputeTimeP50 = mComputeTimeP90 = mComputeTimeP99 = mComputeTimeP999 = 0.0;
+        return;
+    }
+    cmnDeSerializeRaw(inputStream, mStatisticsInterval);
+    cmnDeSerializeRaw(inputStream, mPeriodP50);
+    cmnDeSerializeRaw(inputStream, mPeriodP90); // 15
+    cmnDeSerializeRaw(inputStream, mPeriodP99);
+    cmnDeSerializeRaw(inputStream, mPeriodP999);
+    cmnDeSerializeRaw(inputStream, mComputeTimeP50);
+    cmnDeSerializeRaw(inputStream, mComputeTimeP90);
+    cmnDeSerializeRaw(inputStream, mComputeTimeP99); // 20
+    cmnDeSerializeRaw(inputStream, mComputeTimeP999);
 }
 
+void mtsIntervalStatistics::SetPercentilesEnabled(const bool enabled)
+{
+    mPercentilesEnabled = enabled;
+    if (mPercentilesEnabled) {
+        // allocate histograms now so Update doesn't allocate memory
+        mHistograms.Allocate();
+        mHistograms.Period->Reset();
+        mHistograms.ComputeTime->Reset();
+    } else {
+        mPeriodP50 = mPeriodP90 = mPeriodP99 = mPeriodP999 = 0.0;
+        mComputeTimeP50 = mComputeTimeP90 = mComputeTimeP99 = mComputeTimeP999 = 0.0;
+    }
+}
+
+
 void mtsIntervalStatistics::Update(const double period, const double computeTime)
 {
     // update number of samples
@@ -164,6 +253,15 @@ void mtsIntervalStatistics::Update(const double period, const double computeTime
     mComputeTimeSum += computeTime;
     mComputeTimeSumSquares += computeTime * computeTime;
 
+    // for percentiles, histograms are not copied with the object
+    if (mPercentilesEnabled) {
+        if (!mHistograms.Period) {
+            mHistograms.Allocate();
+        }
+        mHistograms.Period->Add(period);
+        mHistograms.ComputeTime->Add(computeTime);
+    }
+
     // count overruns compared to previous average, use number of
     // samples to see if an average has already be calculated
     if ((mNumberOfSamples > 0)
@@ -196,6 +294,20 @@ void mtsIntervalStatistics::Update(const double period, const double computeTime
         mComputeTimeMin = mComputeTimeRunningMin;
         mComputeTimeMax = mComputeTimeRunningMax;
 
+        // percentiles
+        if (mPercentilesEnabled) {
+            mPeriodP50 = mHistograms.Period->Percentile(50.0);
+            mPeriodP90 = mHistograms.Period->Percentile(90.0);
+            mPeriodP99 = mHistograms.Period->Percentile(99.0);
+            mPeriodP999 = mHistograms.Period->Percentile(99.9);
+            mComputeTimeP50 = mHistograms.ComputeTime->Percentile(50.0);
+            mComputeTimeP90 = mHistograms.ComputeTime->Percentile(90.0);
+            mComputeTimeP99 = mHistograms.ComputeTime->Percentile(99.0);
+            mComputeTimeP999 = mHistograms.ComputeTime->Percentile(99.9);
+            mHistograms.Period->Reset();
+            mHistograms.ComputeTime->Reset();
+        }
+
         // timestamp this data
         this->Valid() = true;
         this->Timestamp() = currentTime;
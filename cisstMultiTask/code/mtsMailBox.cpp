@@ -5,7 +5,7 @@
   Author(s):  Peter Kazanzides, Anton Deguet
   Created on: 2007-09-05
 
-  (C) Copyright 2007-2016 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2007-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -25,6 +25,8 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstMultiTask/mtsCommandQueuedVoidReturn.h>
 #include <cisstMultiTask/mtsCommandQueuedWrite.h>
 #include <cisstMultiTask/mtsCommandQueuedWriteReturn.h>
+#include <cisstMultiTask/mtsCommandTracer.h>
+#include <cisstMultiTask/mtsSharedArgument.h>
 
 
 mtsMailBox::mtsMailBox(const std::string & name,
@@ -33,6 +35,9 @@ mtsMailBox::mtsMailBox(const std::string & name,
     CommandQueue(size, 0),
     Name(name),
     PostCommandQueuedCallable(postCommandQueuedCallable),
+    ReadyList(0),
+    ReadyScheduled(false),
+    ReadyNext(0),
     PostCommandDequeuedCommand(0),
     PostCommandReturnDequeuedCommand(0)
 {}
@@ -51,14 +56,40 @@ const std::string & mtsMailBox::GetName(void) const
 bool mtsMailBox::Write(mtsCommandBase * command)
 {
     bool result;
+    if (mtsCommandTracer::IsEnabled()) {
+        mtsCommandTracer::Record(mtsCommandTracer::ENQUEUE, command);
+    }
     result = (CommandQueue.Put(command) != 0);
-    if (this->PostCommandQueuedCallable) {
+    if (!result && mtsCommandTracer::IsEnabled()) {
+        mtsCommandTracer::Record(mtsCommandTracer::ENQUEUE_FAILED, command);
+    }
+    if (this->ReadyList) {
+        // nothing to process if the queue was full
+        if (result) {
+            this->ReadyList->Schedule(this);
+        }
+    } else if (this->PostCommandQueuedCallable) {
         this->PostCommandQueuedCallable->Execute();
     }
     return result;
 }
 
 
+void mtsMailBox::SetReadyList(mtsMailBoxReadyList * readyList)
+{
+    if (this->ReadyList && (this->ReadyList != readyList)) {
+        this->ReadyList->Remove(this);
+    }
+    this->ReadyList = readyList;
+}
+
+
+mtsMailBoxReadyList * mtsMailBox::GetReadyList(void) const
+{
+    return this->ReadyList;
+}
+
+
 // return false if nothing to execute; true otherwise.
 bool mtsMailBox::ExecuteNext(void)
 {
@@ -69,6 +100,13 @@ bool mtsMailBox::ExecuteNext(void)
        return false;
    }
 
+   // keep a copy, the queue slot can be reused once the command is removed
+   mtsCommandBase * tracedCommand = 0;
+   if (mtsCommandTracer::IsEnabled()) {
+       tracedCommand = *command;
+       mtsCommandTracer::Record(mtsCommandTracer::DEQUEUE, tracedCommand);
+   }
+
    mtsCommandQueuedVoid * commandVoid;
    mtsCommandQueuedWriteBase * commandWrite;
    mtsCommandQueuedVoidReturn * commandVoidReturn;
@@ -97,14 +135,33 @@ bool mtsMailBox::ExecuteNext(void)
                if (commandWrite) {
                    isBlocking = (commandWrite->BlockingFlagGet() == MTS_BLOCKING);
                    finishedEvent = commandWrite->FinishedEventGet();
-                   try {
-                       result = commandWrite->GetActualCommand()->Execute(*(commandWrite->ArgumentPeek()), MTS_NOT_BLOCKING);
-                   }
-                   catch (...) {
+                   // argument shared with other commands, i.e. multicast event
+                   mtsSharedArgument * sharedArgument = commandWrite->SharedArgumentGet();
+                   if (sharedArgument) {
+                       try {
+                           result = commandWrite->GetActualCommand()->Execute(sharedArgument->GetArgument(), MTS_NOT_BLOCKING);
+                       }
+                       catch (...) {
+                           sharedArgument->Release();
+                           throw;
+                       }
+                       sharedArgument->Release();
+                   } else {
+                       try {
+                           // commands keeping only the latest argument might have nothing new to process
+                           const mtsGenericObject * argument = commandWrite->ArgumentPeek();
+                           if (argument) {
+                               result = commandWrite->GetActualCommand()->Execute(*argument, MTS_NOT_BLOCKING);
+                           } else {
+                               result = mtsExecutionResult::COMMAND_SUCCEEDED;
+                           }
+                       }
+                       catch (...) {
+                           commandWrite->ArgumentGet();  // Remove from parameter queue
+                           throw;
+                       }
                        commandWrite->ArgumentGet();  // Remove from parameter queue
-                       throw;
                    }
-                   commandWrite->ArgumentGet();  // Remove from parameter queue
                }
                else {
                    // For the Read command, NumberOfArguments() is 1, and Returns() is false.
@@ -173,6 +230,7 @@ bool mtsMailBox::ExecuteNext(void)
        CMN_LOG_RUN_WARNING << "mtsMailbox \"" << GetName() << "\": ExecuteNext for command \"" << (*command)->GetName()
                            << "\" caught exception \"" << exceptionCaught.what() << "\"" << std::endl;
        this->TriggerPostQueuedCommandIfNeeded(isBlocking, isBlockingReturn);
+       this->TraceCompletion(tracedCommand, finishedEvent);
        CommandQueue.Get();  // Remove command from mailbox queue
        if (resultPointer || isBlocking)
           TriggerFinishedEventIfNeeded((*command)->GetName(), finishedEvent, resultPointer, result);
@@ -182,6 +240,7 @@ bool mtsMailBox::ExecuteNext(void)
        CMN_LOG_RUN_WARNING << "mtsMailbox \"" << GetName() << "\": ExecuteNext for command \"" << (*command)->GetName()
                            << "\" caught exception, blocking = " << isBlocking << std::endl;
        this->TriggerPostQueuedCommandIfNeeded(isBlocking, isBlockingReturn);
+       this->TraceCompletion(tracedCommand, finishedEvent);
        CommandQueue.Get();  // Remove command from mailbox queue
        if (resultPointer || isBlocking)
            TriggerFinishedEventIfNeeded((*command)->GetName(), finishedEvent, resultPointer, result);
@@ -192,6 +251,7 @@ bool mtsMailBox::ExecuteNext(void)
        CMN_LOG_RUN_WARNING << "mtsMailbox \"" << GetName() << "\": ExecuteNext for command \"" << (*command)->GetName()
                            << "\" failed, execution result is \"" << result << "\"" << std::endl;
    }
+   this->TraceCompletion(tracedCommand, finishedEvent);
    CommandQueue.Get();  // Remove command from mailbox queue
    if (resultPointer || isBlocking)
        TriggerFinishedEventIfNeeded((*command)->GetName(), finishedEvent, resultPointer, result);
@@ -199,6 +259,17 @@ bool mtsMailBox::ExecuteNext(void)
 }
 
 
+void mtsMailBox::TraceCompletion(const mtsCommandBase * command, const mtsCommandWriteBase * finishedEvent) const
+{
+   if (command) {
+       mtsCommandTracer::Record(mtsCommandTracer::COMPLETE, command);
+       if (finishedEvent) {
+           mtsCommandTracer::Record(mtsCommandTracer::FINISHED_EVENT, command);
+       }
+   }
+}
+
+
 void mtsMailBox::TriggerPostQueuedCommandIfNeeded(bool isBlocking, bool isBlockingReturn)
 {
 #if CISST_MTS_HAS_ICE
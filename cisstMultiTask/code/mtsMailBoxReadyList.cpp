@@ -0,0 +1,198 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstMultiTask/mtsMailBoxReadyList.h>
+#include <cisstMultiTask/mtsMailBox.h>
+#include <cisstMultiTask/mtsCallableVoidBase.h>
+
+namespace {
+    // ready list processed by ExecuteAll on the current thread, used
+    // to detect calls to Remove from a command being executed
+    thread_local mtsMailBoxReadyList * ExecutingReadyList = 0;
+}
+
+mtsMailBoxReadyList::mtsMailBoxReadyList(const std::string & name,
+                                         mtsCallableVoidBase * doorBellCallable):
+    Top(0),
+    Name(name),
+    DoorBellCallable(doorBellCallable),
+    Pending(0)
+{}
+
+
+mtsMailBoxReadyList::~mtsMailBoxReadyList(void)
+{}
+
+
+const std::string & mtsMailBoxReadyList::GetName(void) const
+{
+    return this->Name;
+}
+
+
+void mtsMailBoxReadyList::SetDoorBellCallable(mtsCallableVoidBase * doorBellCallable)
+{
+    this->DoorBellCallable = doorBellCallable;
+}
+
+
+bool mtsMailBoxReadyList::Schedule(mtsMailBox * mailBox)
+{
+    // acquire/release exchange pairs with the one in ExecuteAll so
+    // the consumer either sees the command just queued or the
+    // mailbox gets scheduled again
+    if (mailBox->ReadyScheduled.exchange(true, std::memory_order_acq_rel)) {
+        return false; // already scheduled, consumer will find the command
+    }
+    mtsMailBox * top = this->Top.load(std::memory_order_relaxed);
+    do {
+        mailBox->ReadyNext = top;
+    } while (!this->Top.compare_exchange_weak(top, mailBox,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed));
+    // ring only if the list was empty, otherwise consumer has already been notified
+    if ((top == 0) && this->DoorBellCallable) {
+        this->DoorBellCallable->Execute();
+    }
+    return true;
+}
+
+
+mtsMailBox * mtsMailBoxReadyList::TakeAll(void)
+{
+    mtsMailBox * current = this->Top.exchange(0, std::memory_order_acquire);
+    // stack is in reverse scheduling order
+    mtsMailBox * reversed = 0;
+    mtsMailBox * next;
+    while (current) {
+        next = current->ReadyNext;
+        current->ReadyNext = reversed;
+        reversed = current;
+        current = next;
+    }
+    return reversed;
+}
+
+
+void mtsMailBoxReadyList::PushAll(mtsMailBox * first)
+{
+    if (!first) {
+        return;
+    }
+    // reverse so the next TakeAll preserves the current order
+    mtsMailBox * last = first;
+    mtsMailBox * reversed = 0;
+    mtsMailBox * next;
+    while (first) {
+        next = first->ReadyNext;
+        first->ReadyNext = reversed;
+        reversed = first;
+        first = next;
+    }
+    mtsMailBox * top = this->Top.load(std::memory_order_relaxed);
+    do {
+        last->ReadyNext = top;
+    } while (!this->Top.compare_exchange_weak(top, reversed,
+                                              std::memory_order_release,
+                                              std::memory_order_relaxed));
+}
+
+
+size_t mtsMailBoxReadyList::ExecuteAll(void)
+{
+    size_t numberOfCommands = 0;
+    this->ConsumerMutex.Lock();
+    mtsMailBoxReadyList * previousReadyList = ExecutingReadyList;
+    ExecutingReadyList = this;
+    // pending list is kept as a data member so Remove can update it
+    this->Pending = this->TakeAll();
+    mtsMailBox * mailBox;
+    while (this->Pending) {
+        mailBox = this->Pending;
+        this->Pending = mailBox->ReadyNext;
+        mailBox->ReadyNext = 0;
+        // clear flag before emptying the mailbox, any command queued
+        // after this point will re-schedule the mailbox
+        mailBox->ReadyScheduled.exchange(false, std::memory_order_acq_rel);
+        try {
+            while (mailBox->ExecuteNext()) {
+                numberOfCommands++;
+            }
+        } catch (...) {
+            // make sure remaining commands and mailboxes are not lost,
+            // current mailbox might have been re-scheduled by a client
+            if (!mailBox->ReadyScheduled.exchange(true, std::memory_order_acq_rel)) {
+                mailBox->ReadyNext = this->Pending;
+                this->Pending = mailBox;
+            }
+            this->PushAll(this->Pending);
+            this->Pending = 0;
+            ExecutingReadyList = previousReadyList;
+            this->ConsumerMutex.Unlock();
+            throw;
+        }
+    }
+    ExecutingReadyList = previousReadyList;
+    this->ConsumerMutex.Unlock();
+    return numberOfCommands;
+}
+
+
+mtsMailBox * mtsMailBoxReadyList::Unlink(mtsMailBox * first, mtsMailBox * mailBox)
+{
+    mtsMailBox * current = first;
+    mtsMailBox * kept = 0;
+    mtsMailBox * keptLast = 0;
+    mtsMailBox * next;
+    while (current) {
+        next = current->ReadyNext;
+        current->ReadyNext = 0;
+        if (current == mailBox) {
+            current->ReadyScheduled.store(false, std::memory_order_release);
+        } else {
+            if (keptLast) {
+                keptLast->ReadyNext = current;
+            } else {
+                kept = current;
+            }
+            keptLast = current;
+        }
+        current = next;
+    }
+    return kept;
+}
+
+
+void mtsMailBoxReadyList::Remove(mtsMailBox * mailBox)
+{
+    // already locked if called by a command executed by ExecuteAll
+    const bool lock = (ExecutingReadyList != this);
+    if (lock) {
+        this->ConsumerMutex.Lock();
+    }
+    this->Pending = Unlink(this->Pending, mailBox);
+    this->PushAll(Unlink(this->TakeAll(), mailBox));
+    if (lock) {
+        this->ConsumerMutex.Unlock();
+    }
+}
+
+
+bool mtsMailBoxReadyList::IsEmpty(void) const
+{
+    return (this->Top.load(std::memory_order_acquire) == 0);
+}
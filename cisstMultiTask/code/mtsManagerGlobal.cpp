@@ -6,7 +6,7 @@
   Author(s):  Min Yang Jung
   Created on: 2009-11-12
 
-  (C) Copyright 2009-2019 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -351,21 +351,12 @@ mtsConnection * mtsManagerGlobal::GetConnectionInformation(const ConnectionIDTyp
 ConnectionIDType mtsManagerGlobal::GetConnectionID(const std::string & clientProcessName,
         const std::string & clientComponentName, const std::string & interfaceName) const
 {
-    ConnectionMapType::const_iterator it = ConnectionMap.begin();
-    const ConnectionMapType::const_iterator itEnd = ConnectionMap.end();
-
-    mtsDescriptionConnection description;
-    for (; it != itEnd; ++it) {
-        it->second.GetDescriptionConnection(description);
-        if ((description.Client.ProcessName == clientProcessName) &&
-            (description.Client.ComponentName == clientComponentName) &&
-            (description.Client.InterfaceName == interfaceName))
-        {
-            return description.ConnectionID;
-        }
+    const ConnectionByClientMapType::const_iterator it =
+        ConnectionByClient.find(GetInterfaceUID(clientProcessName, clientComponentName, interfaceName));
+    if (it == ConnectionByClient.end()) {
+        return InvalidConnectionID;
     }
-
-    return InvalidConnectionID;
+    return it->second;
 }
 
 bool mtsManagerGlobal::IsAlreadyConnected(const mtsDescriptionConnection & description) const
@@ -1541,6 +1532,7 @@ ConnectionIDType mtsManagerGlobal::Connect(const std::string & requestProcessNam
     mtsConnection connection(description, requestProcessName);
 
     ConnectionMap.insert(std::make_pair(thisConnectionID, connection));
+    ConnectionByClient[GetInterfaceUID(clientProcessName, clientComponentNameActual, clientInterfaceNameActual)] = thisConnectionID;
 
     // STEP 5. Post-processings
     //
@@ -2006,6 +1998,7 @@ void mtsManagerGlobal::DisconnectInternal(void)
         ConnectionMapChange.Lock();
         ConnectionMapType::iterator itConnectionMap = ConnectionMap.find(connectionID);
         ConnectionMap.erase(itConnectionMap);
+        ConnectionByClient.erase(GetInterfaceUID(clientProcessName, clientComponentName, clientInterfaceName));
         ConnectionMapChange.Unlock();
 
         // Step 5. Enqueue the disconnected id to the disconnected queue
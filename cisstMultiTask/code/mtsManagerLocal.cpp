@@ -5,7 +5,7 @@
   Author(s):  Min Yang Jung
   Created on: 2009-12-07
 
-  (C) Copyright 2009-2019 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -44,6 +44,8 @@ http://www.cisst.org/cisst/license.txt.
 #include "mtsManagerProxyServer.h"
 #endif
 
+#include <set>
+
 // Time server used by all tasks
 osaTimeServer TimeServer;
 bool TimeServerOriginSet = false;
@@ -1398,6 +1400,7 @@ bool mtsManagerLocal::AddComponent(mtsComponent * component)
             {
                 // Create InterfaceComponent's required interface which will be connected
                 // to connect user component's InterfaceInternal's provided interface.
+                const unsigned int managerRevision = managerComponent->GetInterfacesRevision();
                 if (!managerComponent->AddNewClientComponent(componentName)) {
                     CMN_LOG_CLASS_INIT_ERROR << "AddComponent: "
                         << "failed to add InterfaceComponent's required interface to MCC: "
@@ -1405,6 +1408,17 @@ bool mtsManagerLocal::AddComponent(mtsComponent * component)
                     return false;
                 }
 
+                // Register the new required interface now so the connection below
+                // doesn't have to register all the MCC's interfaces again
+                if (!RegisterInterfaceRequired(managerComponent,
+                                               mtsManagerComponentBase::GetNameOfInterfaceComponentRequiredFor(componentName),
+                                               managerRevision)) {
+                    CMN_LOG_CLASS_INIT_ERROR << "AddComponent: "
+                        << "failed to register InterfaceComponent's required interface for: "
+                        << "\"" << componentName << "\"" << std::endl;
+                    return false;
+                }
+
                 // Connect user component to the manager component client.  If a component
                 // has InterfaceInternal's required interface which provides dynamic
                 // component control services, the required interface gets connected to
@@ -1493,6 +1507,10 @@ bool mtsManagerLocal::RemoveComponent(const std::string & componentName, const b
         CMN_LOG_CLASS_INIT_VERBOSE << "RemoveComponent: removed component: " << componentName << std::endl;
     }
 
+    InterfacesRegisteredChange.Lock();
+    InterfacesRegistered.erase(componentName);
+    InterfacesRegisteredChange.Unlock();
+
     return true;
 }
 
@@ -2068,14 +2086,89 @@ bool mtsManagerLocal::WaitForStateAll(mtsComponentState desiredState, double tim
 }
 
 
-void mtsManagerLocal::CreateAll(void)
+void mtsManagerLocal::GetComponentsInStartupOrder(std::vector<mtsComponent *> & components) const
 {
-    ComponentMapChange.Lock();
+    // number of servers not yet added to the list for each component
+    typedef std::map<const mtsComponent *, size_t> CounterMapType;
+    CounterMapType numberOfServers;
+    // clients of each server
+    typedef std::multimap<const mtsComponent *, mtsComponent *> ClientMapType;
+    ClientMapType clients;
+
+    components.clear();
+    components.reserve(ComponentMap.size());
 
+    mtsComponent * component;
+    const mtsComponent * server;
+    const mtsInterfaceProvided * interfaceProvided;
     ComponentMapType::const_iterator iterator = ComponentMap.begin();
     const ComponentMapType::const_iterator end = ComponentMap.end();
     for (; iterator != end; ++iterator) {
-        iterator->second->Create();
+        component = iterator->second;
+        std::set<const mtsComponent *> servers;
+        // manager components are connected to all components
+        if (!mtsManagerComponentBase::IsManagerComponentServer(iterator->first)
+            && !mtsManagerComponentBase::IsManagerComponentClient(iterator->first)) {
+            mtsComponent::InterfacesRequiredMapType::const_iterator required = component->InterfacesRequired.begin();
+            const mtsComponent::InterfacesRequiredMapType::const_iterator requiredEnd = component->InterfacesRequired.end();
+            for (; required != requiredEnd; ++required) {
+                interfaceProvided = required->second->GetConnectedInterface();
+                if (!interfaceProvided) {
+                    continue;
+                }
+                server = interfaceProvided->GetComponent();
+                if (!server || (server == component)
+                    || mtsManagerComponentBase::IsManagerComponentServer(server->GetName())
+                    || mtsManagerComponentBase::IsManagerComponentClient(server->GetName())
+                    || (ComponentMap.GetItem(server->GetName(), CMN_LOG_LEVEL_NONE) != server)) {
+                    continue;
+                }
+                if (servers.insert(server).second) {
+                    clients.insert(std::make_pair(server, component));
+                }
+            }
+        }
+        numberOfServers[component] = servers.size();
+        if (servers.empty()) {
+            components.push_back(component);
+        }
+    }
+
+    // components is also used as queue, a client is added once all
+    // its servers have been added
+    ClientMapType::const_iterator client, clientEnd;
+    for (size_t index = 0; index < components.size(); ++index) {
+        client = clients.lower_bound(components[index]);
+        clientEnd = clients.upper_bound(components[index]);
+        for (; client != clientEnd; ++client) {
+            if (--numberOfServers[client->second] == 0) {
+                components.push_back(client->second);
+            }
+        }
+    }
+
+    // remaining components have circular dependencies
+    if (components.size() != ComponentMap.size()) {
+        for (iterator = ComponentMap.begin(); iterator != end; ++iterator) {
+            if (numberOfServers[iterator->second] != 0) {
+                CMN_LOG_CLASS_INIT_VERBOSE << "GetComponentsInStartupOrder: component \"" << iterator->first
+                                           << "\" has circular dependencies, it will be started after the others" << std::endl;
+                components.push_back(iterator->second);
+            }
+        }
+    }
+}
+
+
+void mtsManagerLocal::CreateAll(void)
+{
+    ComponentMapChange.Lock();
+
+    std::vector<mtsComponent *> components;
+    GetComponentsInStartupOrder(components);
+    const size_t numberOfComponents = components.size();
+    for (size_t index = 0; index < numberOfComponents; ++index) {
+        components[index]->Create();
     }
 
     ComponentMapChange.Unlock();
@@ -2099,58 +2192,61 @@ void mtsManagerLocal::StartAll(void)
     }
 
     mtsTask * componentTask;
+    mtsComponent * component;
+    mtsComponent * lastTask = 0;
 
     ComponentMapChange.Lock();
 
-    ComponentMapType::const_iterator iterator = ComponentMap.begin();
-    const ComponentMapType::const_iterator end = ComponentMap.end();
-    ComponentMapType::const_iterator lastTask = ComponentMap.end();
+    std::vector<mtsComponent *> components;
+    GetComponentsInStartupOrder(components);
+    const size_t numberOfComponents = components.size();
 
-    for (; iterator != end; ++iterator) {
+    for (size_t index = 0; index < numberOfComponents; ++index) {
+        component = components[index];
         // look for component
-        componentTask = dynamic_cast<mtsTask*>(iterator->second);
+        componentTask = dynamic_cast<mtsTask*>(component);
         if (componentTask) {
             // Check if the task will use the current thread.
             if (componentTask->Thread.GetId() == threadId) {
-                if (dynamic_cast<mtsTaskFromCallback*>(iterator->second)) {
-                    CMN_LOG_CLASS_INIT_VERBOSE << "StartAll: component \"" << iterator->first
+                if (dynamic_cast<mtsTaskFromCallback*>(component)) {
+                    CMN_LOG_CLASS_INIT_VERBOSE << "StartAll: component \"" << component->GetName()
                                                << "\" uses current thread, but is a callback task;"
                                                << " expect that it will be called by dispatcher." << std::endl;
-                    iterator->second->Start();
+                    component->Start();
                 }
                 else {
-                    CMN_LOG_CLASS_INIT_WARNING << "StartAll: component \"" << iterator->first
+                    CMN_LOG_CLASS_INIT_WARNING << "StartAll: component \"" << component->GetName()
                                                << "\" uses current thread, will be started last." << std::endl;
-                    if (lastTask != end) {
+                    if (lastTask) {
                         CMN_LOG_CLASS_INIT_ERROR << "StartAll: found another task using current thread (\""
-                                                 << iterator->first << "\"), only first will be started (\""
-                                                 << lastTask->first << "\")." << std::endl;
+                                                 << component->GetName() << "\"), only first will be started (\""
+                                                 << lastTask->GetName() << "\")." << std::endl;
                         // PK: I don't think this task should be started if it uses the current thread
-                        iterator->second->Start();
+                        component->Start();
                     } else {
-                        // set iterator to last task to be started
-                        lastTask = iterator;
+                        // set pointer to last task to be started
+                        lastTask = component;
                     }
                 }
             } else {
-                CMN_LOG_CLASS_INIT_DEBUG << "StartAll: starting task \"" << iterator->first << "\"" << std::endl;
+                CMN_LOG_CLASS_INIT_DEBUG << "StartAll: starting task \"" << component->GetName() << "\"" << std::endl;
                 if (componentTask->Thread.GetId() == MainThreadId) {
                     if (dynamic_cast<mtsTaskContinuous *>(componentTask)) {
-                        CMN_LOG_CLASS_INIT_WARNING << "StartAll: is the main task really " << iterator->first << "???" << std::endl;
+                        CMN_LOG_CLASS_INIT_WARNING << "StartAll: is the main task really " << component->GetName() << "???" << std::endl;
                     }
                 }
-                iterator->second->Start();  // If task will not use current thread, start it immediately.
+                component->Start();  // If task will not use current thread, start it immediately.
             }
         } else {
-            CMN_LOG_CLASS_INIT_DEBUG << "StartAll: starting component \"" << iterator->first << "\"" << std::endl;
-            iterator->second->Start();  // this is a component, it doesn't have a thread
+            CMN_LOG_CLASS_INIT_DEBUG << "StartAll: starting component \"" << component->GetName() << "\"" << std::endl;
+            component->Start();  // this is a component, it doesn't have a thread
         }
     }
 
     ComponentMapChange.Unlock();
 
-    if (lastTask != end) {
-        lastTask->second->Start();
+    if (lastTask) {
+        lastTask->Start();
     }
 }
 
@@ -2610,6 +2706,20 @@ bool mtsManagerLocal::RegisterInterfaces(mtsComponent * component)
     const std::string componentName = component->GetName();
     std::vector<std::string> interfaceNames;
 
+    // Nothing to do if no interface has been added or removed since
+    // last registration.  This is called for both components on each
+    // connection, including the manager component client which has a
+    // required interface per component.
+    const unsigned int revision = component->GetInterfacesRevision();
+    InterfacesRegisteredChange.Lock();
+    InterfacesRegisteredMapType::const_iterator registered = InterfacesRegistered.find(componentName);
+    const bool upToDate = ((registered != InterfacesRegistered.end())
+                           && (registered->second == revision));
+    InterfacesRegisteredChange.Unlock();
+    if (upToDate) {
+        return true;
+    }
+
     mtsInterfaceProvided * interfaceProvided;
     interfaceNames = component->GetNamesOfInterfacesProvided();
     for (size_t i = 0; i < interfaceNames.size(); ++i) {
@@ -2697,6 +2807,35 @@ bool mtsManagerLocal::RegisterInterfaces(mtsComponent * component)
         }
     }
 
+    InterfacesRegisteredChange.Lock();
+    InterfacesRegistered[componentName] = revision;
+    InterfacesRegisteredChange.Unlock();
+
+    return true;
+}
+
+
+bool mtsManagerLocal::RegisterInterfaceRequired(mtsComponent * component, const std::string & interfaceName,
+                                                const unsigned int previousRevision)
+{
+    const std::string componentName = component->GetName();
+    if (!ManagerGlobal->FindInterfaceRequiredOrInput(ProcessName, componentName, interfaceName)) {
+        if (!ManagerGlobal->AddInterfaceRequiredOrInput(ProcessName, componentName, interfaceName)) {
+            CMN_LOG_CLASS_INIT_ERROR << "RegisterInterfaceRequired: failed to add required interface: "
+                                     << componentName << ":" << interfaceName << std::endl;
+            return false;
+        }
+    }
+
+    // if this is the only change since last registration, all interfaces are registered
+    InterfacesRegisteredChange.Lock();
+    InterfacesRegisteredMapType::iterator registered = InterfacesRegistered.find(componentName);
+    if ((registered != InterfacesRegistered.end())
+        && (registered->second == previousRevision)
+        && (component->GetInterfacesRevision() == (previousRevision + 1))) {
+        registered->second = previousRevision + 1;
+    }
+    InterfacesRegisteredChange.Unlock();
     return true;
 }
 
@@ -6,7 +6,7 @@
   Author(s):  Ankur Kapoor, Peter Kazanzides, Anton Deguet
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2014 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -21,6 +21,16 @@ http://www.cisst.org/cisst/license.txt.
 #include <algorithm>
 #include <cisstMultiTask/mtsMulticastCommandWriteBase.h>
 #include <cisstMultiTask/mtsCommandWrite.h>
+#include <cisstMultiTask/mtsCommandQueuedWriteBase.h>
+#include <cisstMultiTask/mtsSharedArgument.h>
+
+mtsMulticastCommandWriteBase::~mtsMulticastCommandWriteBase()
+{
+    SharedArgumentsType::iterator iter;
+    for (iter = SharedArguments.begin(); iter != SharedArguments.end(); ++iter) {
+        (*iter)->Release();
+    }
+}
 
 bool mtsMulticastCommandWriteBase::AddCommand(BaseType * command) {
     if (command) {
@@ -45,6 +55,10 @@ bool mtsMulticastCommandWriteBase::AddCommand(BaseType * command) {
                 this->GetArgumentPrototype()->Services()->Create(const_cast<mtsGenericObject *>(command->GetArgumentPrototype()), *(this->GetArgumentPrototype()));
                 // Add the command to the list
                 this->Commands.push_back(command);
+                this->QueuedCommands.push_back(dynamic_cast<mtsCommandQueuedWriteBase *>(command));
+                if (this->QueuedCommands.back()) {
+                    this->NumberOfQueuedCommands++;
+                }
                 return true;
             }
         } else {
@@ -52,6 +66,10 @@ bool mtsMulticastCommandWriteBase::AddCommand(BaseType * command) {
             command->SetArgumentPrototype(reinterpret_cast<const mtsGenericObject *>(this->GetArgumentPrototype()->Services()->Create(*(this->GetArgumentPrototype()))));
             // Add the command to the list
             this->Commands.push_back(command);
+            this->QueuedCommands.push_back(dynamic_cast<mtsCommandQueuedWriteBase *>(command));
+            if (this->QueuedCommands.back()) {
+                this->NumberOfQueuedCommands++;
+            }
             return true;
         }
     }
@@ -63,6 +81,11 @@ bool mtsMulticastCommandWriteBase::RemoveCommand(BaseType * command) {
     if (command) {
         VectorType::iterator it = std::find(Commands.begin(), Commands.end(), command);
         if (it != Commands.end()) {
+            QueuedVectorType::iterator queued = QueuedCommands.begin() + (it - Commands.begin());
+            if (*queued) {
+                NumberOfQueuedCommands--;
+            }
+            QueuedCommands.erase(queued);
             Commands.erase(it);
             return true;
         }
@@ -76,6 +99,53 @@ bool mtsMulticastCommandWriteBase::RemoveCommand(BaseType * command) {
     return false;
 }
 
+mtsSharedArgument * mtsMulticastCommandWriteBase::GetSharedArgument(const mtsGenericObject & argument)
+{
+    // look for an argument only referenced by this multicast command,
+    // start after the last one used since older ones are more likely
+    // to have been processed
+    const size_t size = SharedArguments.size();
+    size_t count;
+    for (count = 0; count < size; count++) {
+        SharedArgumentsIndex = (SharedArgumentsIndex + 1) % size;
+        mtsSharedArgument * shared = SharedArguments[SharedArgumentsIndex];
+        if (shared->GetReferenceCount() == 1) {
+            if (shared->Set(argument)) {
+                return shared;
+            }
+            break;
+        }
+    }
+    mtsSharedArgument * shared = new mtsSharedArgument(argument);
+    if (!shared->IsValid()) {
+        shared->Release();
+        return 0;
+    }
+    SharedArguments.push_back(shared);
+    SharedArgumentsIndex = SharedArguments.size() - 1;
+    return shared;
+}
+
+
+void mtsMulticastCommandWriteBase::ExecuteAll(const mtsGenericObject & argument)
+{
+    // copy once for all queued commands
+    mtsSharedArgument * shared = 0;
+    if (NumberOfQueuedCommands > 1) {
+        shared = this->GetSharedArgument(argument);
+    }
+    size_t index;
+    const size_t commandsSize = Commands.size();
+    for (index = 0; index < commandsSize; index++) {
+        if (shared && QueuedCommands[index]) {
+            QueuedCommands[index]->ExecuteShared(*shared);
+        } else {
+            Commands[index]->Execute(argument, MTS_NOT_BLOCKING);
+        }
+    }
+}
+
+
 void mtsMulticastCommandWriteBase::ToStream(std::ostream & outputStream) const {
     outputStream << "mtsMulticastCommandWrite: \"" << this->Name << "\"";
     if (Commands.size() != 0) {
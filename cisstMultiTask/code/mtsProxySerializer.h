@@ -6,7 +6,7 @@
   Author(s):  Min Yang Jung
   Created on: 2009-09-01
 
-  (C) Copyright 2009-2014 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -38,6 +38,17 @@ http://www.cisst.org/cisst/license.txt.
 */
 class mtsProxySerializer {
 private:
+    /*! Stream buffer writing in a fixed size array */
+    class ArrayBuffer: public std::streambuf {
+    public:
+        ArrayBuffer(char * buffer, size_t size) {
+            setp(buffer, buffer + size);
+        }
+        size_t Size(void) const {
+            return static_cast<size_t>(pptr() - pbase());
+        }
+    };
+
     /*! Internal buffer for serialization and deserialization. */
     std::stringstream SerializationBuffer;
     std::stringstream DeSerializationBuffer;
@@ -80,6 +91,32 @@ public:
         return true;
     }
 
+    /*! Serialize in a pre-allocated buffer (e.g. shared memory) and
+      set length to the number of bytes used.  This is only possible
+      once the class services have been serialized, since the
+      serializer state can't be restored if the buffer is too small.
+      Returns false if the services have not been sent or the buffer
+      is too small, the caller should then use the std::string
+      version. */
+    bool Serialize(const mtsGenericObject & originalObject, char * buffer, size_t size, size_t & length) {
+        if (!Serializer->ServicesSerialized(originalObject.Services())) {
+            return false;
+        }
+        ArrayBuffer arrayBuffer(buffer, size);
+        std::streambuf * previous = SerializationBuffer.std::ios::rdbuf(&arrayBuffer);
+        bool result = true;
+        try {
+            Serializer->Serialize(originalObject);
+        } catch (const std::runtime_error &) {
+            result = false;
+        }
+        result = result && !SerializationBuffer.fail();
+        length = arrayBuffer.Size();
+        SerializationBuffer.std::ios::rdbuf(previous);
+        SerializationBuffer.clear();
+        return result;
+    }
+
     bool SerializeStart(const mtsGenericObject & originalObject) {
         try {
             SerializationBuffer.str("");
@@ -141,6 +178,44 @@ public:
         return true;
     }
 
+    /*! Serialize the object's data only (no class services), used for
+      compact events once the client and server agreed on the type.
+      The result doesn't depend on the serializer's state. */
+    bool SerializeRaw(const mtsGenericObject & originalObject, std::string & serializedObject) {
+        try {
+            SerializationBuffer.str("");
+            originalObject.SerializeRaw(SerializationBuffer);
+            serializedObject = SerializationBuffer.str();
+        } catch (const std::runtime_error &e) {
+            CMN_LOG_RUN_ERROR << "Raw serialization failed: " << originalObject.ToString() << std::endl;
+            CMN_LOG_RUN_ERROR << e.what() << std::endl;
+            serializedObject = "";
+            return false;
+        }
+        return true;
+    }
+
+    /*! DeSerialize data created by SerializeRaw */
+    bool DeSerializeRaw(const char * serializedObject, size_t length, mtsGenericObject & originalObject) {
+        try {
+            DeSerializationBuffer.str(std::string(serializedObject, length));
+            DeSerializationBuffer.clear();
+            originalObject.DeSerializeRaw(DeSerializationBuffer);
+        }  catch (const std::runtime_error &e) {
+            originalObject.SetValid(false);
+            DeSerializationBuffer.clear();
+            CMN_LOG_RUN_ERROR << "Raw deserialization failed: " << e.what() << std::endl;
+            return false;
+        }
+        if (DeSerializationBuffer.fail()) {
+            originalObject.SetValid(false);
+            DeSerializationBuffer.clear();
+            CMN_LOG_RUN_ERROR << "Raw deserialization failed: not enough data" << std::endl;
+            return false;
+        }
+        return true;
+    }
+
     // MJ: This method internally allocates memory. Caller should deallocate it.
     mtsGenericObject * DeSerialize(const std::string & serializedObject) {
         cmnGenericObject * deserializedObject = 0;
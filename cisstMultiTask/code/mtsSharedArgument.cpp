@@ -0,0 +1,55 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstMultiTask/mtsSharedArgument.h>
+
+
+mtsSharedArgument::mtsSharedArgument(const mtsGenericObject & argument):
+    ReferenceCount(1),
+    Argument(0)
+{
+    this->Argument = dynamic_cast<mtsGenericObject *>(argument.Services()->Create(argument));
+    if (!this->Argument) {
+        CMN_LOG_RUN_ERROR << "mtsSharedArgument: failed to create copy of argument of type \""
+                          << argument.Services()->GetName() << "\"" << std::endl;
+    }
+}
+
+
+mtsSharedArgument::~mtsSharedArgument()
+{
+    if (this->Argument) {
+        delete this->Argument;
+    }
+}
+
+
+bool mtsSharedArgument::Set(const mtsGenericObject & argument)
+{
+    if (!this->Argument) {
+        return false;
+    }
+    return this->Argument->Services()->Create(this->Argument, argument);
+}
+
+
+void mtsSharedArgument::Release(void)
+{
+    if (this->ReferenceCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete this;
+    }
+}
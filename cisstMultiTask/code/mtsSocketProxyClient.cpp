@@ -5,7 +5,7 @@
   Author(s):  Peter Kazanzides
   Created on: 2013-08-06
 
-  (C) Copyright 2013-2016 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2013-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -23,6 +23,8 @@ http://www.cisst.org/cisst/license.txt.
 // For now, many of the "helper" proxy classes are defined in this file. In the future,
 // they could be moved to separate classes.
 
+#include <algorithm>
+
 #include <cisstCommon/cmnAssert.h>
 #include <cisstMultiTask/mtsSocketProxyClient.h>
 #include <cisstMultiTask/mtsInterfaceProvided.h>
@@ -189,14 +191,13 @@ public:
 // The implementation uses classes because there is data that needs to be associated with each class instance.
 // The CommandWrapperBase class contains the data that is needed by all derived classes:
 //    Name:           name of command
-//    Socket:         reference to mtsSocketProxyClient::Socket (single socket shared by all)
 //    Handle:         "handle" for this command (see mtsSocketProxyCommon); basically, this is the address of
 //                    the command object, preceeded by some identifying data (space, command type)
 //    Receiver:       An instance of the EventReceiverWriteProxy, which is used to receive return events from the Server
 //    receiveHandler: A (write) command object that is used to call EventReceiverWriteProxy::ExecuteSerialized; this is
 //                    sent to the Server (as a recv_handle)
-//    Proxy:          A pointer to mtsSocketProxyClient; these classes use it to access the Serializer and a few
-//                    methods; it could also be used to access the Socket
+//    Proxy:          A pointer to mtsSocketProxyClient; these classes use it to access the Serializer and to
+//                    send messages to the server (using the socket or shared memory, see SendToServer)
 //
 // These classes include a Clone method because some items, such as the Receiver and receiveHandler, should
 // be distinct within each provided interface instance (end-user interface).
@@ -204,14 +205,13 @@ public:
 class CommandWrapperBase {
 protected:
     std::string Name;
-    osaSocket   &Socket;
     char        Handle[CommandHandle::COMMAND_HANDLE_STRING_SIZE];
     EventReceiverWriteProxy *Receiver;
     mtsCommandWriteBase     *receiveHandler;
     mtsSocketProxyClient    *Proxy;
 public:
-    CommandWrapperBase(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy)
-        : Name(name), Socket(socket), Proxy(proxy)
+    CommandWrapperBase(const std::string &name, mtsSocketProxyClient *proxy)
+        : Name(name), Proxy(proxy)
     {
         Handle[0] = 0;
         Receiver = new EventReceiverWriteProxy(Proxy->Serializer);
@@ -219,8 +219,8 @@ public:
                                                                                    Receiver, name+"Receiver", std::string());
     }
 
-    CommandWrapperBase(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy, const char *handle)
-        : Name(name), Socket(socket), Proxy(proxy)
+    CommandWrapperBase(const std::string &name, mtsSocketProxyClient *proxy, const char *handle)
+        : Name(name), Proxy(proxy)
     {
         SetHandle(handle);
         Receiver = new EventReceiverWriteProxy(Proxy->Serializer);
@@ -254,15 +254,15 @@ public:
 
 class CommandWrapperVoid : public CommandWrapperBase {
 public:
-    CommandWrapperVoid(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy)
-        : CommandWrapperBase(name, socket, proxy) {}
-    CommandWrapperVoid(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy, const char *handle)
-        : CommandWrapperBase(name, socket, proxy, handle) {}
+    CommandWrapperVoid(const std::string &name, mtsSocketProxyClient *proxy)
+        : CommandWrapperBase(name, proxy) {}
+    CommandWrapperVoid(const std::string &name, mtsSocketProxyClient *proxy, const char *handle)
+        : CommandWrapperBase(name, proxy, handle) {}
     ~CommandWrapperVoid() {}
 
     CommandWrapperVoid *Clone(void) const
     {
-        return new CommandWrapperVoid(Name, Socket, Proxy, Handle);
+        return new CommandWrapperVoid(Name, Proxy, Handle);
     }
 
     // This is called just before the Method is called via the command object
@@ -281,7 +281,7 @@ public:
             sendBuffer[1] = 'v';
         CommandHandle recv_handle('W', receiveHandler);
         recv_handle.ToString(sendBuffer+CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-        Socket.Send(sendBuffer, sizeof(sendBuffer));
+        Proxy->SendToServer(sendBuffer, sizeof(sendBuffer));
         // Now return to the caller. If this is a blocking command, the caller will
         // wait on a thread signal, which will be raised in the Receiver object.
     }
@@ -289,15 +289,15 @@ public:
 
 class CommandWrapperWrite : public CommandWrapperBase {
 public:
-    CommandWrapperWrite(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy)
-        : CommandWrapperBase(name, socket, proxy) {}
-    CommandWrapperWrite(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy, const char *handle)
-        : CommandWrapperBase(name, socket, proxy, handle) {}
+    CommandWrapperWrite(const std::string &name, mtsSocketProxyClient *proxy)
+        : CommandWrapperBase(name, proxy) {}
+    CommandWrapperWrite(const std::string &name, mtsSocketProxyClient *proxy, const char *handle)
+        : CommandWrapperBase(name, proxy, handle) {}
     ~CommandWrapperWrite() {}
 
     CommandWrapperWrite *Clone(void) const
     {
-        return new CommandWrapperWrite(Name, Socket, Proxy, Handle);
+        return new CommandWrapperWrite(Name, Proxy, Handle);
     }
 
     // This is called just before the Method is called via the command object
@@ -309,20 +309,16 @@ public:
             CMN_LOG_RUN_ERROR << "CommandWrapperWrite: invalid handle = " << Handle[1] << std::endl;
             return;
         }
-        std::string sendBuffer;
         Receiver->SetArg(0);
-        if (Proxy->Serialize(arg, sendBuffer)) {
-            char cmdBuffer[2*CommandHandle::COMMAND_HANDLE_STRING_SIZE];
-            memcpy(cmdBuffer, Handle, sizeof(Handle));
-            if (Receiver->IsBlocking())
-                cmdBuffer[1] = 'w';
-            CommandHandle recv_handle('W', receiveHandler);
-            recv_handle.ToString(cmdBuffer+CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-            sendBuffer.insert(0, cmdBuffer, sizeof(cmdBuffer));
-            Socket.SendAsPackets(sendBuffer, mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.05);
-            // Now return to the caller. If this is a blocking command, the caller will
-            // wait on a thread signal, which will be raised in the Receiver object.
-        }
+        char cmdBuffer[2*CommandHandle::COMMAND_HANDLE_STRING_SIZE];
+        memcpy(cmdBuffer, Handle, sizeof(Handle));
+        if (Receiver->IsBlocking())
+            cmdBuffer[1] = 'w';
+        CommandHandle recv_handle('W', receiveHandler);
+        recv_handle.ToString(cmdBuffer+CommandHandle::COMMAND_HANDLE_STRING_SIZE);
+        Proxy->SendToServer(cmdBuffer, sizeof(cmdBuffer), arg);
+        // Now return to the caller. If this is a blocking command, the caller will
+        // wait on a thread signal, which will be raised in the Receiver object.
     }
 };
 
@@ -330,16 +326,16 @@ class CommandWrapperRead : public CommandWrapperBase {
 public:
     typedef mtsCallableReadMethodGeneric<CommandWrapperRead> CallableType;
 
-    CommandWrapperRead(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy)
-        : CommandWrapperBase(name, socket, proxy) { }
-    CommandWrapperRead(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy, const char *handle)
-        : CommandWrapperBase(name, socket, proxy, handle) { }
+    CommandWrapperRead(const std::string &name, mtsSocketProxyClient *proxy)
+        : CommandWrapperBase(name, proxy) { }
+    CommandWrapperRead(const std::string &name, mtsSocketProxyClient *proxy, const char *handle)
+        : CommandWrapperBase(name, proxy, handle) { }
 
     ~CommandWrapperRead() { }
 
     CommandWrapperRead *Clone(void) const
     {
-        return new CommandWrapperRead(Name, Socket, Proxy, Handle);
+        return new CommandWrapperRead(Name, Proxy, Handle);
     }
 
     bool Method(mtsGenericObject &arg) const
@@ -353,7 +349,7 @@ public:
         memcpy(sendBuffer, Handle, sizeof(Handle));
         CommandHandle recv_handle('W', receiveHandler);
         recv_handle.ToString(sendBuffer+CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-        return (Socket.Send(sendBuffer, sizeof(sendBuffer)) > 0);
+        return Proxy->SendToServer(sendBuffer, sizeof(sendBuffer));
     }
 };
 
@@ -361,15 +357,15 @@ class CommandWrapperQualifiedRead : public CommandWrapperBase {
 public:
     typedef mtsCallableQualifiedReadMethodGeneric<CommandWrapperQualifiedRead> CallableType;
 
-    CommandWrapperQualifiedRead(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy)
-        : CommandWrapperBase(name, socket, proxy) {}
-    CommandWrapperQualifiedRead(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy, const char *handle)
-        : CommandWrapperBase(name, socket, proxy, handle) {}
+    CommandWrapperQualifiedRead(const std::string &name, mtsSocketProxyClient *proxy)
+        : CommandWrapperBase(name, proxy) {}
+    CommandWrapperQualifiedRead(const std::string &name, mtsSocketProxyClient *proxy, const char *handle)
+        : CommandWrapperBase(name, proxy, handle) {}
     ~CommandWrapperQualifiedRead() {}
 
     CommandWrapperQualifiedRead *Clone(void) const
     {
-        return new CommandWrapperQualifiedRead(Name, Socket, Proxy, Handle);
+        return new CommandWrapperQualifiedRead(Name, Proxy, Handle);
     }
 
     bool Method(const mtsGenericObject &arg1, mtsGenericObject &arg2) const
@@ -379,16 +375,11 @@ public:
             return false;
         }
         Receiver->SetArg(&arg2);
-        std::string sendBuffer;
-        if (Proxy->Serialize(arg1, sendBuffer)) {
-            char cmdBuffer[2*CommandHandle::COMMAND_HANDLE_STRING_SIZE];
-            memcpy(cmdBuffer, Handle, sizeof(Handle));
-            CommandHandle recv_handle('W', receiveHandler);
-            recv_handle.ToString(cmdBuffer+CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-            sendBuffer.insert(0, cmdBuffer, sizeof(cmdBuffer));
-            return (Socket.SendAsPackets(sendBuffer, mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.05) > 0);
-        }
-        return false;
+        char cmdBuffer[2*CommandHandle::COMMAND_HANDLE_STRING_SIZE];
+        memcpy(cmdBuffer, Handle, sizeof(Handle));
+        CommandHandle recv_handle('W', receiveHandler);
+        recv_handle.ToString(cmdBuffer+CommandHandle::COMMAND_HANDLE_STRING_SIZE);
+        return Proxy->SendToServer(cmdBuffer, sizeof(cmdBuffer), arg1);
     }
 };
 
@@ -396,16 +387,16 @@ class CommandWrapperVoidReturn : public CommandWrapperBase {
 public:
     typedef mtsCallableVoidReturnMethodGeneric<CommandWrapperVoidReturn> CallableType;
 
-    CommandWrapperVoidReturn(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy)
-        : CommandWrapperBase(name, socket, proxy) { }
-    CommandWrapperVoidReturn(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy, const char *handle)
-        : CommandWrapperBase(name, socket, proxy, handle) { }
+    CommandWrapperVoidReturn(const std::string &name, mtsSocketProxyClient *proxy)
+        : CommandWrapperBase(name, proxy) { }
+    CommandWrapperVoidReturn(const std::string &name, mtsSocketProxyClient *proxy, const char *handle)
+        : CommandWrapperBase(name, proxy, handle) { }
 
     ~CommandWrapperVoidReturn() { }
 
     CommandWrapperVoidReturn *Clone(void) const
     {
-        return new CommandWrapperVoidReturn(Name, Socket, Proxy, Handle);
+        return new CommandWrapperVoidReturn(Name, Proxy, Handle);
     }
 
     void Method(mtsGenericObject &arg)
@@ -419,7 +410,7 @@ public:
         memcpy(sendBuffer, Handle, sizeof(Handle));
         CommandHandle recv_handle('W', receiveHandler);
         recv_handle.ToString(sendBuffer+CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-        Socket.Send(sendBuffer, sizeof(sendBuffer));
+        Proxy->SendToServer(sendBuffer, sizeof(sendBuffer));
         // Now return to the caller. The caller will wait on a thread signal, which
         // will be raised in the Receiver object.
     }
@@ -429,16 +420,16 @@ class CommandWrapperWriteReturn : public CommandWrapperBase {
 public:
     typedef mtsCallableWriteReturnMethodGeneric<CommandWrapperWriteReturn> CallableType;
 
-    CommandWrapperWriteReturn(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy)
-        : CommandWrapperBase(name, socket, proxy) { }
-    CommandWrapperWriteReturn(const std::string &name, osaSocket &socket, mtsSocketProxyClient *proxy, const char *handle)
-        : CommandWrapperBase(name, socket, proxy, handle) { }
+    CommandWrapperWriteReturn(const std::string &name, mtsSocketProxyClient *proxy)
+        : CommandWrapperBase(name, proxy) { }
+    CommandWrapperWriteReturn(const std::string &name, mtsSocketProxyClient *proxy, const char *handle)
+        : CommandWrapperBase(name, proxy, handle) { }
 
     ~CommandWrapperWriteReturn() { }
 
     CommandWrapperWriteReturn *Clone(void) const
     {
-        return new CommandWrapperWriteReturn(Name, Socket, Proxy, Handle);
+        return new CommandWrapperWriteReturn(Name, Proxy, Handle);
     }
 
     void Method(const mtsGenericObject &arg1, mtsGenericObject &arg2)
@@ -448,17 +439,13 @@ public:
             return;
         }
         Receiver->SetArg(&arg2);
-        std::string sendBuffer;
-        if (Proxy->Serialize(arg1, sendBuffer)) {
-            char cmdBuffer[2*CommandHandle::COMMAND_HANDLE_STRING_SIZE];
-            memcpy(cmdBuffer, Handle, sizeof(Handle));
-            CommandHandle recv_handle('W', receiveHandler);
-            recv_handle.ToString(cmdBuffer+CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-            sendBuffer.insert(0, cmdBuffer, sizeof(cmdBuffer));
-            Socket.SendAsPackets(sendBuffer, mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.05);
-            // Now return to the caller. The caller will wait on a thread signal, which
-            // will be raised in the Receiver object.
-        }
+        char cmdBuffer[2*CommandHandle::COMMAND_HANDLE_STRING_SIZE];
+        memcpy(cmdBuffer, Handle, sizeof(Handle));
+        CommandHandle recv_handle('W', receiveHandler);
+        recv_handle.ToString(cmdBuffer+CommandHandle::COMMAND_HANDLE_STRING_SIZE);
+        Proxy->SendToServer(cmdBuffer, sizeof(cmdBuffer), arg1);
+        // Now return to the caller. The caller will wait on a thread signal, which
+        // will be raised in the Receiver object.
     }
 };
 
@@ -703,6 +690,9 @@ public:
     }
 
     mtsExecutionResult ExecuteSerialized(const std::string &inputArgSerialized, mtsBlockingType blocking);
+
+    // Execute a compact event, i.e. argument serialized without class services
+    mtsExecutionResult ExecuteRaw(const char *inputArgSerialized, size_t length, mtsBlockingType blocking);
 };
 
 MulticastCommandWriteProxy::MulticastCommandWriteProxy(const std::string &name, const std::string &argPrototypeSerialized,
@@ -746,7 +736,8 @@ bool MulticastCommandWriteProxy::AddCommand(mtsMulticastCommandWriteBase::BaseTy
             CommandHandle handle('W', this);
             char handleBuf[CommandHandle::COMMAND_HANDLE_STRING_SIZE];
             handle.ToString(handleBuf);
-            Proxy->EventEnable(GetName(), handleBuf);
+            // The argument type is used by the server to decide if compact events can be sent
+            Proxy->EventEnable(GetName(), handleBuf, arg ? arg->Services()->GetName() : "");
         }
         return true;
     }
@@ -794,19 +785,36 @@ mtsExecutionResult MulticastCommandWriteProxy::ExecuteSerialized(const std::stri
     return ret;
 }
 
+mtsExecutionResult MulticastCommandWriteProxy::ExecuteRaw(const char *inputArgSerialized, size_t length,
+                                                          mtsBlockingType blocking)
+{
+    // arg has been created when the event was enabled, otherwise compact events are not used
+    if (!arg)
+        return mtsExecutionResult::ARGUMENT_DYNAMIC_CREATION_FAILED;
+    if (!Proxy->DeSerializeRaw(inputArgSerialized, length, *arg))
+        return mtsExecutionResult::DESERIALIZATION_ERROR;
+    return Execute(*arg, blocking);
+}
+
 //************************************ mtsSocketProxyClient class ******************************************
 //
 // This class has a provided interface for the client component to connect to.
 // It creates a socket connection to the mtsSocketProxyServer object (server proxy)
 // at the specified IP and port
 
-mtsSocketProxyClient::mtsSocketProxyClient(const std::string & proxyName, const std::string & ip, short port) :
+mtsSocketProxyClient::mtsSocketProxyClient(const std::string & proxyName, const std::string & ip, short port,
+                                           bool useSharedMemory) :
     mtsTaskContinuous(proxyName),
     Socket(osaSocket::UDP),
     Serializer(0),
+    UseSharedMemory(useSharedMemory),
+    SharedMemoryClientId(0),
     localUnblockingCommand(0),
     EventEnableCommand(0),
-    EventDisableCommand(0)
+    EventDisableCommand(0),
+    EventEnableCompactCommand(0),
+    CompactEventsSequence(0),
+    CompactEventsReceived(false)
 {
     Socket.SetDestination(ip, port);
     CreateClientProxy("Provided");
@@ -816,9 +824,14 @@ mtsSocketProxyClient::mtsSocketProxyClient(const mtsSocketProxyClientConstructor
     mtsTaskContinuous(arg.Name),
     Socket(osaSocket::UDP),
     Serializer(0),
+    UseSharedMemory(true),
+    SharedMemoryClientId(0),
     localUnblockingCommand(0),
     EventEnableCommand(0),
-    EventDisableCommand(0)
+    EventDisableCommand(0),
+    EventEnableCompactCommand(0),
+    CompactEventsSequence(0),
+    CompactEventsReceived(false)
 {
     Socket.SetDestination(arg.IP, arg.Port);
     CreateClientProxy("Provided");
@@ -837,6 +850,7 @@ mtsSocketProxyClient::~mtsSocketProxyClient()
     // delete EventDisableCommand->ClassInstantiation;
     delete EventEnableCommand;
     delete EventDisableCommand;
+    delete EventEnableCompactCommand;
 }
 
 void mtsSocketProxyClient::Startup(void)
@@ -853,9 +867,16 @@ void mtsSocketProxyClient::Run(void)
 void mtsSocketProxyClient::CheckForEvents(double timeoutInSec)
 {
     std::string inputArgString;
-    char packetBuffer[mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE];
-    int bytesRead = Socket.ReceiveAsPackets(inputArgString, packetBuffer, sizeof(packetBuffer), timeoutInSec, 0.5);
-    if (bytesRead > 0) {
+    bool received;
+    if (SharedMemoryClientId != 0)
+        received = SharedMemoryResponses.Receive(inputArgString, timeoutInSec);
+    else {
+        char packetBuffer[mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE];
+        received = (Socket.ReceiveAsPackets(inputArgString, packetBuffer, sizeof(packetBuffer), timeoutInSec, 0.5) > 0);
+    }
+    if (received && !inputArgString.empty() && (inputArgString[0] == mtsSocketProxy::SOCKET_PROXY_COMPACT_EVENTS))
+        ProcessCompactEvents(inputArgString);
+    else if (received) {
         size_t pos = inputArgString.find(' ');
         if ((pos == 0) && (inputArgString.size() >= CommandHandle::COMMAND_HANDLE_STRING_SIZE)) {
             CommandHandle handle(inputArgString);
@@ -905,6 +926,41 @@ void mtsSocketProxyClient::CheckForEvents(double timeoutInSec)
     }
 }
 
+void mtsSocketProxyClient::ProcessCompactEvents(const std::string &message)
+{
+    // Message starts with SOCKET_PROXY_COMPACT_EVENTS, followed by one or more events (CompactEventHeader
+    // and argument); data smaller than a header at the end of the message is padding.
+    size_t pos = 1;
+    CompactEventHeader header;
+    while (header.FromString(message.data() + pos, message.size() - pos) != 0) {
+        pos += CompactEventHeader::COMPACT_EVENT_HEADER_SIZE;
+        if (header.length > message.size() - pos) {
+            CMN_LOG_CLASS_RUN_ERROR << "ProcessCompactEvents: invalid length " << header.length
+                                    << " for event " << header.eventId << std::endl;
+            return;
+        }
+        if (CompactEventsReceived && (header.sequence != CompactEventsSequence)) {
+            CMN_LOG_CLASS_RUN_WARNING << "ProcessCompactEvents: lost "
+                                      << static_cast<unsigned short>(header.sequence - CompactEventsSequence)
+                                      << " event(s)" << std::endl;
+        }
+        CompactEventsSequence = header.sequence + 1;
+        CompactEventsReceived = true;
+        if (header.eventId < CompactEvents.size()) {
+            MulticastCommandVoidProxy *commandVoid = dynamic_cast<MulticastCommandVoidProxy *>(CompactEvents[header.eventId]);
+            MulticastCommandWriteProxy *commandWrite = dynamic_cast<MulticastCommandWriteProxy *>(CompactEvents[header.eventId]);
+            if (commandVoid)
+                commandVoid->Execute(MTS_NOT_BLOCKING);
+            else if (commandWrite)
+                commandWrite->ExecuteRaw(message.data() + pos, header.length, MTS_NOT_BLOCKING);
+        }
+        else {
+            CMN_LOG_CLASS_RUN_ERROR << "ProcessCompactEvents: invalid event identifier " << header.eventId << std::endl;
+        }
+        pos += header.length;
+    }
+}
+
 bool mtsSocketProxyClient::Serialize(const mtsGenericObject & originalObject, std::string & serializedObject)
 {
      return Serializer->Serialize(originalObject, serializedObject);
@@ -920,8 +976,120 @@ mtsGenericObject * mtsSocketProxyClient::DeSerialize(const std::string & seriali
     return Serializer->DeSerialize(serializedObject);
 }
 
+bool mtsSocketProxyClient::DeSerializeRaw(const char * serializedObject, size_t length, mtsGenericObject & originalObject)
+{
+    return Serializer->DeSerializeRaw(serializedObject, length, originalObject);
+}
+
+bool mtsSocketProxyClient::SendToServer(const char *buffer, size_t length)
+{
+    if (SharedMemoryClientId == 0)
+        return (Socket.Send(buffer, static_cast<unsigned int>(length)) > 0);
+    const size_t idSize = mtsSocketProxy::SOCKET_PROXY_SHARED_MEMORY_ID_SIZE;
+    char *message = SharedMemoryRequests.Reserve(idSize + length, 0.05);
+    if (!message) {
+        CMN_LOG_CLASS_RUN_ERROR << "SendToServer: failed to send " << length << " bytes using shared memory" << std::endl;
+        return false;
+    }
+    memcpy(message, &SharedMemoryClientId, idSize);
+    memcpy(message + idSize, buffer, length);
+    SharedMemoryRequests.Commit(idSize + length);
+    return true;
+}
+
+bool mtsSocketProxyClient::SendToServer(const std::string &buffer)
+{
+    if (SharedMemoryClientId == 0)
+        return (Socket.SendAsPackets(buffer, mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.05) > 0);
+    return SendToServer(buffer.data(), buffer.size());
+}
+
+bool mtsSocketProxyClient::SendToServer(const char *header, size_t headerLength, const mtsGenericObject &arg)
+{
+    if (SharedMemoryClientId != 0) {
+        // Try to serialize in place, this requires the class services to have been sent
+        // and the serialized argument to fit in the space reserved; otherwise use a string
+        const size_t idSize = mtsSocketProxy::SOCKET_PROXY_SHARED_MEMORY_ID_SIZE;
+        const size_t reserved = 8 * mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE;
+        if (Serializer->ServicesSerialized(arg.Services())) {
+            char *message = SharedMemoryRequests.Reserve(idSize + headerLength + reserved, 0.05);
+            if (message) {
+                size_t length;
+                if (Serializer->Serialize(arg, message + idSize + headerLength, reserved, length)) {
+                    memcpy(message, &SharedMemoryClientId, idSize);
+                    memcpy(message + idSize, header, headerLength);
+                    SharedMemoryRequests.Commit(idSize + headerLength + length);
+                    return true;
+                }
+                SharedMemoryRequests.Cancel();
+            }
+        }
+    }
+    std::string sendBuffer;
+    if (!Serializer->Serialize(arg, sendBuffer))
+        return false;
+    sendBuffer.insert(0, header, headerLength);
+    return SendToServer(sendBuffer);
+}
+
+bool mtsSocketProxyClient::AttachSharedMemory(void)
+{
+    if (!UseSharedMemory || !osaSharedMemoryRing::IsSupported()
+        || (ServerData.InterfaceVersion() < 1) || (ServerData.SharedMemoryName()[0] == 0))
+        return false;
+
+    // Only use shared memory if the server is on this computer
+    std::string ip;
+    unsigned short port;
+    Socket.GetDestination(ip, port);
+    bool isLocal = (ip == "127.0.0.1") || (ip == "localhost");
+    if (!isLocal) {
+        std::vector<std::string> localIPs;
+        osaSocket::GetLocalhostIP(localIPs);
+        isLocal = (std::find(localIPs.begin(), localIPs.end(), ip) != localIPs.end());
+    }
+    if (!isLocal)
+        return false;
+
+    if (!SharedMemoryRequests.Open(ServerData.SharedMemoryName()))
+        return false;
+    if (!SharedMemoryResponses.Create(osaSharedMemoryRing::GetUniqueName("cisstSocketProxyClient"),
+                                      mtsSocketProxy::SOCKET_PROXY_SHARED_MEMORY_SIZE)) {
+        SharedMemoryRequests.Close();
+        return false;
+    }
+    // Client identifier is 0 until the server assigns one
+    std::string message(mtsSocketProxy::SOCKET_PROXY_SHARED_MEMORY_ID_SIZE, '\0');
+    message.append("SharedMemoryAttach ");
+    message.append(SharedMemoryResponses.GetName());
+    std::string reply;
+    const std::string attached("SharedMemoryAttached ");
+    if (SharedMemoryRequests.Send(message.data(), message.size(), 0.1)
+        && SharedMemoryResponses.Receive(reply, 1.0)
+        && (reply.size() == attached.size() + sizeof(SharedMemoryClientId))
+        && (reply.compare(0, attached.size(), attached) == 0)) {
+        memcpy(&SharedMemoryClientId, reply.data() + attached.size(), sizeof(SharedMemoryClientId));
+        // The server uses a new serializer for this connection
+        Serializer->Reset();
+        CMN_LOG_CLASS_INIT_VERBOSE << "AttachSharedMemory: using shared memory " << ServerData.SharedMemoryName()
+                                   << " to communicate with server" << std::endl;
+        return true;
+    }
+    CMN_LOG_CLASS_INIT_WARNING << "AttachSharedMemory: no response from server, using socket" << std::endl;
+    SharedMemoryRequests.Close();
+    SharedMemoryResponses.Close();
+    SharedMemoryClientId = 0;
+    return false;
+}
+
 void mtsSocketProxyClient::Cleanup(void)
 {
+    if (SharedMemoryClientId != 0) {
+        SendToServer("SharedMemoryDetach", strlen("SharedMemoryDetach"));
+        SharedMemoryClientId = 0;
+    }
+    SharedMemoryRequests.Close();
+    SharedMemoryResponses.Close();
     Socket.Close();
 }
 
@@ -963,7 +1131,7 @@ bool mtsSocketProxyClient::CreateClientProxy(const std::string & providedInterfa
     localUnblockingCommand = new mtsCommandWriteGeneric<mtsSocketProxyClient>(&mtsSocketProxyClient::LocalUnblockingHandler, this,
                                                                               "UnblockingCommand", 0);
 
-    CommandWrapperRead GetInitData("GetInitData", Socket, this);
+    CommandWrapperRead GetInitData("GetInitData", this);
     GetInitData.SetHandle(" I        ");
     GetInitData.SetCallerEvent(localUnblockingCommand);
     LocalWaiting = true;
@@ -982,23 +1150,34 @@ bool mtsSocketProxyClient::CreateClientProxy(const std::string & providedInterfa
         return false;
     }
 
+    // Use shared memory for the other messages if the server is on this computer
+    AttachSharedMemory();
+
     // Set up local commands for enabling and disabling events. These write commands are not queued because they are
     // called internally. In particular, mtsInterfaceProvided::AddObserver and RemoveObserver call the AddCommand
     // and RemoveCommand methods of the multicast command (write and void) proxies, which may call these commands
     // to enable or disable sending of events on the server. If thread safety is required, it would be better to
     // make AddObserver and RemoveObserver available as queued commands.
     mtsStdString arg;
-    CommandWrapperWrite *eventEnableWrapper = new CommandWrapperWrite("EventEnable", Socket, this, ServerData.EventEnable());
+    CommandWrapperWrite *eventEnableWrapper = new CommandWrapperWrite("EventEnable", this, ServerData.EventEnable());
     EventEnableCommand = new mtsCommandWriteGeneric<CommandWrapperWrite>(&CommandWrapperWrite::Method, eventEnableWrapper,
                                                                          "EventEnable", &arg);
-    CommandWrapperWrite *eventDisableWrapper = new CommandWrapperWrite("EventDisable", Socket, this, ServerData.EventDisable());
+    CommandWrapperWrite *eventDisableWrapper = new CommandWrapperWrite("EventDisable", this, ServerData.EventDisable());
     EventDisableCommand = new mtsCommandWriteGeneric<CommandWrapperWrite>(&CommandWrapperWrite::Method, eventDisableWrapper,
                                                                           "EventDisable", &arg);
+    // Compact events are available since version 2
+    if ((ServerData.InterfaceVersion() >= 2) && (ServerData.EventEnableCompact()[0] != 0)) {
+        CommandWrapperWrite *eventEnableCompactWrapper = new CommandWrapperWrite("EventEnableCompact", this,
+                                                                                 ServerData.EventEnableCompact());
+        EventEnableCompactCommand = new mtsCommandWriteGeneric<CommandWrapperWrite>(&CommandWrapperWrite::Method,
+                                                                                    eventEnableCompactWrapper,
+                                                                                    "EventEnableCompact", &arg);
+    }
 
 
     // Create the client proxy based on the provided interface description obtained from the server proxy.
     mtsGenericObjectProxy<mtsInterfaceProvidedDescription> descProxy;
-    CommandWrapperRead GetInterfaceDescription("GetInterfaceDescription", Socket, this, ServerData.GetInterfaceDescription());
+    CommandWrapperRead GetInterfaceDescription("GetInterfaceDescription", this, ServerData.GetInterfaceDescription());
     GetInterfaceDescription.SetCallerEvent(localUnblockingCommand);
     LocalWaiting = true;
     if (!GetInterfaceDescription.Method(descProxy) || !WaitForResponse(3.0)) {
@@ -1019,11 +1198,11 @@ bool mtsSocketProxyClient::CreateClientProxy(const std::string & providedInterfa
     mtsStdString handleSerialized;
 
     // Create Void command proxies
-    CommandWrapperQualifiedRead GetHandleVoid("GetHandleVoid", Socket, this, ServerData.GetHandleVoid());
+    CommandWrapperQualifiedRead GetHandleVoid("GetHandleVoid", this, ServerData.GetHandleVoid());
     GetHandleVoid.SetCallerEvent(localUnblockingCommand);
     for (i = 0; i < providedInterfaceDescription.CommandsVoid.size(); ++i) {
         std::string commandName = providedInterfaceDescription.CommandsVoid[i].Name;
-        CommandWrapperVoid *wrapper = new CommandWrapperVoid(commandName, Socket, this);
+        CommandWrapperVoid *wrapper = new CommandWrapperVoid(commandName, this);
         LocalWaiting = true;
         if (GetHandleVoid.Method(mtsStdString(commandName), handleSerialized) && WaitForResponse(2.0))
             wrapper->SetHandle(handleSerialized);
@@ -1035,11 +1214,11 @@ bool mtsSocketProxyClient::CreateClientProxy(const std::string & providedInterfa
     }
 
     // Create Write command proxies
-    CommandWrapperQualifiedRead GetHandleWrite("GetHandleWrite", Socket, this, ServerData.GetHandleWrite());
+    CommandWrapperQualifiedRead GetHandleWrite("GetHandleWrite", this, ServerData.GetHandleWrite());
     GetHandleWrite.SetCallerEvent(localUnblockingCommand);
     for (i = 0; i < providedInterfaceDescription.CommandsWrite.size(); ++i) {
         const mtsCommandWriteDescription &cmd = providedInterfaceDescription.CommandsWrite[i];
-        CommandWrapperWrite *wrapper = new CommandWrapperWrite(cmd.Name, Socket, this);
+        CommandWrapperWrite *wrapper = new CommandWrapperWrite(cmd.Name, this);
         LocalWaiting = true;
         if (GetHandleWrite.Method(mtsStdString(cmd.Name), handleSerialized) && WaitForResponse(2.0))
             wrapper->SetHandle(handleSerialized);
@@ -1061,11 +1240,11 @@ bool mtsSocketProxyClient::CreateClientProxy(const std::string & providedInterfa
     }
 
     // Create Read command proxies
-    CommandWrapperQualifiedRead GetHandleRead("GetHandleRead", Socket, this, ServerData.GetHandleRead());
+    CommandWrapperQualifiedRead GetHandleRead("GetHandleRead", this, ServerData.GetHandleRead());
     GetHandleRead.SetCallerEvent(localUnblockingCommand);
     for (i = 0; i < providedInterfaceDescription.CommandsRead.size(); ++i) {
         const mtsCommandReadDescription &cmd = providedInterfaceDescription.CommandsRead[i];
-        CommandWrapperRead *wrapper = new CommandWrapperRead(cmd.Name, Socket, this);
+        CommandWrapperRead *wrapper = new CommandWrapperRead(cmd.Name, this);
         LocalWaiting = true;
         if (GetHandleRead.Method(mtsStdString(cmd.Name), handleSerialized) && WaitForResponse(2.0))
             wrapper->SetHandle(handleSerialized);
@@ -1087,11 +1266,11 @@ bool mtsSocketProxyClient::CreateClientProxy(const std::string & providedInterfa
     }
 
     // Create QualifiedRead command proxies
-    CommandWrapperQualifiedRead GetHandleQualifiedRead("GetHandleQualifiedRead", Socket, this, ServerData.GetHandleQualifiedRead());
+    CommandWrapperQualifiedRead GetHandleQualifiedRead("GetHandleQualifiedRead", this, ServerData.GetHandleQualifiedRead());
     GetHandleQualifiedRead.SetCallerEvent(localUnblockingCommand);
     for (i = 0; i < providedInterfaceDescription.CommandsQualifiedRead.size(); ++i) {
         const mtsCommandQualifiedReadDescription &cmd = providedInterfaceDescription.CommandsQualifiedRead[i];
-        CommandWrapperQualifiedRead *wrapper = new CommandWrapperQualifiedRead(cmd.Name, Socket, this);
+        CommandWrapperQualifiedRead *wrapper = new CommandWrapperQualifiedRead(cmd.Name, this);
         LocalWaiting = true;
         if (GetHandleQualifiedRead.Method(mtsStdString(cmd.Name), handleSerialized) && WaitForResponse(2.0))
             wrapper->SetHandle(handleSerialized);
@@ -1116,11 +1295,11 @@ bool mtsSocketProxyClient::CreateClientProxy(const std::string & providedInterfa
     }
 
     // Create VoidReturn command proxies
-    CommandWrapperQualifiedRead GetHandleVoidReturn("GetHandleVoidReturn", Socket, this, ServerData.GetHandleVoidReturn());
+    CommandWrapperQualifiedRead GetHandleVoidReturn("GetHandleVoidReturn", this, ServerData.GetHandleVoidReturn());
     GetHandleVoidReturn.SetCallerEvent(localUnblockingCommand);
     for (i = 0; i < providedInterfaceDescription.CommandsVoidReturn.size(); ++i) {
         const mtsCommandVoidReturnDescription &cmd = providedInterfaceDescription.CommandsVoidReturn[i];
-        CommandWrapperVoidReturn *wrapper = new CommandWrapperVoidReturn(cmd.Name, Socket, this);
+        CommandWrapperVoidReturn *wrapper = new CommandWrapperVoidReturn(cmd.Name, this);
         LocalWaiting = true;
         if (GetHandleVoidReturn.Method(mtsStdString(cmd.Name), handleSerialized) && WaitForResponse(2.0))
             wrapper->SetHandle(handleSerialized);
@@ -1142,11 +1321,11 @@ bool mtsSocketProxyClient::CreateClientProxy(const std::string & providedInterfa
     }
 
     // Create WriteReturn command proxies
-    CommandWrapperQualifiedRead GetHandleWriteReturn("GetHandleWriteReturn", Socket, this, ServerData.GetHandleWriteReturn());
+    CommandWrapperQualifiedRead GetHandleWriteReturn("GetHandleWriteReturn", this, ServerData.GetHandleWriteReturn());
     GetHandleWriteReturn.SetCallerEvent(localUnblockingCommand);
     for (i = 0; i < providedInterfaceDescription.CommandsWriteReturn.size(); ++i) {
         const mtsCommandWriteReturnDescription &cmd = providedInterfaceDescription.CommandsWriteReturn[i];
-        CommandWrapperWriteReturn *wrapper = new CommandWrapperWriteReturn(cmd.Name, Socket, this);
+        CommandWrapperWriteReturn *wrapper = new CommandWrapperWriteReturn(cmd.Name, this);
         LocalWaiting = true;
         if (GetHandleWriteReturn.Method(mtsStdString(cmd.Name), handleSerialized) && WaitForResponse(2.0))
             wrapper->SetHandle(handleSerialized);
@@ -1200,8 +1379,30 @@ bool mtsSocketProxyClient::CreateClientProxy(const std::string & providedInterfa
 //     eventNameSerialized is the name of the event being enabled or disabled
 // TODO: merge with AddObserver and RemoveObserver in mtsInterfaceProvided (i.e., AddObserver and RemoveObserver
 //     should also be command objects in provided interface)
-void mtsSocketProxyClient::EventEnable(const std::string &eventName, const char *handle)
+//
+// If the server supports compact events, EventEnableCompact is used instead of EventEnable.
+// Format of packet: "opHandle|Handle|EventId|ArgumentClassName EventName"
+// where EventId is the index in CompactEvents (2 bytes) and ArgumentClassName is empty for void events.
+void mtsSocketProxyClient::EventEnable(const std::string &eventName, const char *handle,
+                                       const std::string &argumentClassName)
 {
+    // Write events can only use compact events if the argument type is known
+    if (EventEnableCompactCommand && ((handle[1] == 'V') || !argumentClassName.empty())) {
+        mtsCommandBase *command = reinterpret_cast<mtsCommandBase *>(CommandHandle(handle).addr);
+        std::vector<mtsCommandBase *>::iterator it = std::find(CompactEvents.begin(), CompactEvents.end(), command);
+        if ((it != CompactEvents.end()) || (CompactEvents.size() <= 0xffff)) {
+            unsigned short eventId = static_cast<unsigned short>(it - CompactEvents.begin());
+            if (it == CompactEvents.end())
+                CompactEvents.push_back(command);
+            std::string request(handle, CommandHandle::COMMAND_HANDLE_STRING_SIZE);
+            request.append(reinterpret_cast<const char *>(&eventId), sizeof(eventId));
+            request.append(argumentClassName);
+            request.append(" ");
+            request.append(eventName);
+            EventEnableCompactCommand->Execute(mtsStdString(request), MTS_NOT_BLOCKING);
+            return;
+        }
+    }
     std::string handleAndName(handle, CommandHandle::COMMAND_HANDLE_STRING_SIZE);
     handleAndName.append(eventName);
     if (EventEnableCommand)
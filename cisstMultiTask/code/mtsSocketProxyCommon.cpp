@@ -6,7 +6,7 @@
   Author(s):  Peter Kazanzides
   Created on: 2013-09-08
 
-  (C) Copyright 2013-2014 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2013-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -92,6 +92,24 @@ bool CommandHandle::operator != (const CommandHandle &other) const
     return !(*this == other);
 }
 
+int CompactEventHeader::ToString(char *str) const
+{
+    memcpy(str, &eventId, sizeof(eventId));
+    memcpy(str + sizeof(eventId), &sequence, sizeof(sequence));
+    memcpy(str + sizeof(eventId) + sizeof(sequence), &length, sizeof(length));
+    return COMPACT_EVENT_HEADER_SIZE;
+}
+
+int CompactEventHeader::FromString(const char *str, size_t size)
+{
+    if (size < COMPACT_EVENT_HEADER_SIZE)
+        return 0;
+    memcpy(&eventId, str, sizeof(eventId));
+    memcpy(&sequence, str + sizeof(eventId), sizeof(sequence));
+    memcpy(&length, str + sizeof(eventId) + sizeof(sequence), sizeof(length));
+    return COMPACT_EVENT_HEADER_SIZE;
+}
+
 CMN_IMPLEMENT_SERVICES(mtsSocketProxyInitData)
 
 mtsSocketProxyInitData::mtsSocketProxyInitData() : mtsGenericObject(), 
@@ -106,14 +124,18 @@ mtsSocketProxyInitData::mtsSocketProxyInitData() : mtsGenericObject(),
     getHandleWriteReturn[0] = 0;
     eventEnable[0] = 0;
     eventDisable[0] = 0;
+    sharedMemoryName[0] = 0;
+    eventEnableCompact[0] = 0;
 }
 
 mtsSocketProxyInitData::mtsSocketProxyInitData(unsigned int psize, mtsFunctionRead *gid, mtsFunctionQualifiedRead *ghv,
                         mtsFunctionQualifiedRead *ghr, mtsFunctionQualifiedRead *ghw, mtsFunctionQualifiedRead *ghqr,
                         mtsFunctionQualifiedRead *ghvr, mtsFunctionQualifiedRead *ghwr,
-                        mtsFunctionWrite *ee, mtsFunctionWrite *ed)
+                        mtsFunctionWrite *ee, mtsFunctionWrite *ed, mtsFunctionWrite *eec)
                         : mtsGenericObject(), version(mtsSocketProxy::SOCKET_PROXY_VERSION), packetSize(psize)
 {
+    sharedMemoryName[0] = 0;
+    eventEnableCompact[0] = 0;
     CommandHandle handle('R', gid);
     handle.ToString(getInterfaceDescription);
     handle = CommandHandle('Q', ghv);
@@ -132,6 +154,16 @@ mtsSocketProxyInitData::mtsSocketProxyInitData(unsigned int psize, mtsFunctionRe
     handle.ToString(eventEnable);
     handle = CommandHandle('W', ed);
     handle.ToString(eventDisable);
+    if (eec) {
+        handle = CommandHandle('W', eec);
+        handle.ToString(eventEnableCompact);
+    }
+}
+
+void mtsSocketProxyInitData::SetSharedMemoryName(const std::string &name)
+{
+    strncpy(sharedMemoryName, name.c_str(), sizeof(sharedMemoryName));
+    sharedMemoryName[sizeof(sharedMemoryName)-1] = 0;
 }
 
 void mtsSocketProxyInitData::SerializeRaw(std::ostream & outputStream) const
@@ -148,6 +180,8 @@ void mtsSocketProxyInitData::SerializeRaw(std::ostream & outputStream) const
     outputStream.write(getHandleWriteReturn, sizeof(getHandleWriteReturn));
     outputStream.write(eventEnable, sizeof(eventEnable));
     outputStream.write(eventDisable, sizeof(eventDisable));
+    outputStream.write(sharedMemoryName, sizeof(sharedMemoryName));
+    outputStream.write(eventEnableCompact, sizeof(eventEnableCompact));
 }
 
 void mtsSocketProxyInitData::DeSerializeRaw(std::istream & inputStream)
@@ -164,6 +198,17 @@ void mtsSocketProxyInitData::DeSerializeRaw(std::istream & inputStream)
     inputStream.read(getHandleWriteReturn, sizeof(getHandleWriteReturn));
     inputStream.read(eventEnable, sizeof(eventEnable));
     inputStream.read(eventDisable, sizeof(eventDisable));
+    // Servers using version 0 don't send the shared memory name
+    if (version >= 1)
+        inputStream.read(sharedMemoryName, sizeof(sharedMemoryName));
+    else
+        sharedMemoryName[0] = 0;
+    sharedMemoryName[sizeof(sharedMemoryName)-1] = 0;
+    // Compact events are available since version 2
+    if (version >= 2)
+        inputStream.read(eventEnableCompact, sizeof(eventEnableCompact));
+    else
+        eventEnableCompact[0] = 0;
 }
 
 void mtsSocketProxyInitData::ToStream(std::ostream & outputStream) const
@@ -5,7 +5,7 @@
   Author(s):  Peter Kazanzides
   Created on: 2013-08-06
 
-  (C) Copyright 2013-2016 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2013-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -33,6 +33,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstMultiTask/mtsCommandQueuedVoidReturn.h>
 #include <cisstMultiTask/mtsCommandQueuedWriteReturn.h>
 #include <cisstMultiTask/mtsCommandFilteredQueuedWrite.h>
+#include <cisstOSAbstraction/osaGetTime.h>
 #include "mtsProxySerializer.h"
 
 //************************ mtsSocketProxyServerConstructorArg *********************************
@@ -102,18 +103,24 @@ bool mtsSocketProxyServerConstructorArg::FromStreamRaw(std::istream & inputStrea
 // a list of clients (ClientInfo) which has the IP+port, event handle (from the client), and a pointer
 // to the serializer for that client (maintained by mtsSocketProxyServer). The AddClient and RemoveClient
 // methods are called by the mtsSocketProxyServer EventEnable and EventDisable methods, respectively.
+// Events are sent using mtsSocketProxyServer::SendToClient, which selects the socket or shared memory.
+// Clients that negotiated compact events (EventEnableCompact) receive a CompactEventHeader followed by
+// the raw argument instead; the argument is serialized once for all these clients.
 
 class mtsEventSenderBase {
 protected:
-    osaSocket   &Socket;
+    mtsSocketProxyServer *Proxy;
 
     struct ClientInfo {
         osaIPandPort IP_Port;
         char Handle[CommandHandle::COMMAND_HANDLE_STRING_SIZE];
         mtsProxySerializer *Serializer;   // Only used by mtsEventSenderWrite
+        bool Compact;                     // Send compact events, see SOCKET_PROXY_VERSION 2
+        unsigned short CompactId;         // Event identifier chosen by the client
 
-        ClientInfo(const osaIPandPort &ip_port, const char *handle, mtsProxySerializer *serializer) : IP_Port(ip_port),
-                                                                                                      Serializer(serializer)
+        ClientInfo(const osaIPandPort &ip_port, const char *handle, mtsProxySerializer *serializer,
+                   bool compact, unsigned short compactId) : IP_Port(ip_port), Serializer(serializer),
+                                                             Compact(compact), CompactId(compactId)
         {
             memcpy(Handle, handle, sizeof(Handle));
         }
@@ -124,21 +131,25 @@ protected:
 
 public:
 
-    mtsEventSenderBase(osaSocket &socket) : Socket(socket) {}
+    mtsEventSenderBase(mtsSocketProxyServer *proxy) : Proxy(proxy) {}
     ~mtsEventSenderBase() {}
 
-    bool AddClient(const osaIPandPort &ip_port, const char *handle, mtsProxySerializer *serializer);
+    bool AddClient(const osaIPandPort &ip_port, const char *handle, mtsProxySerializer *serializer,
+                   bool compact = false, unsigned short compactId = 0);
     bool RemoveClient(const osaIPandPort &ip_port, const char *handle);
+    // Remove the client for all handles, used when the client is gone
+    void RemoveClient(const osaIPandPort &ip_port);
 };
 
-bool mtsEventSenderBase::AddClient(const osaIPandPort &ip_port, const char *handle, mtsProxySerializer *serializer)
+bool mtsEventSenderBase::AddClient(const osaIPandPort &ip_port, const char *handle, mtsProxySerializer *serializer,
+                                   bool compact, unsigned short compactId)
 {
     std::vector<ClientInfo>::iterator it;
     for (it = ClientList.begin(); it != ClientList.end(); it++) {
         if (it->IP_Port == ip_port)
             return false;
     }
-    ClientList.push_back(ClientInfo(ip_port, handle, serializer));
+    ClientList.push_back(ClientInfo(ip_port, handle, serializer, compact, compactId));
     return true;
 }
 
@@ -155,31 +166,54 @@ bool mtsEventSenderBase::RemoveClient(const osaIPandPort &ip_port, const char *h
     return false;
 }
 
+void mtsEventSenderBase::RemoveClient(const osaIPandPort &ip_port)
+{
+    std::vector<ClientInfo>::iterator it = ClientList.begin();
+    while (it != ClientList.end()) {
+        if (it->IP_Port == ip_port)
+            it = ClientList.erase(it);
+        else
+            it++;
+    }
+}
+
 class mtsEventSenderVoid : public mtsEventSenderBase {
 public:
-    mtsEventSenderVoid(osaSocket &socket) : mtsEventSenderBase(socket) {}
+    mtsEventSenderVoid(mtsSocketProxyServer *proxy) : mtsEventSenderBase(proxy) {}
     ~mtsEventSenderVoid() {}
     void Method(void)
     {
         std::vector<ClientInfo>::const_iterator it;
         for (it = ClientList.begin(); it != ClientList.end(); it++) {
-            Socket.SetDestination(it->IP_Port);
-            Socket.Send(it->Handle, sizeof(it->Handle));
+            if (it->Compact)
+                Proxy->SendCompactEvent(it->IP_Port, it->CompactId, 0, 0);
+            else
+                Proxy->SendToClient(it->IP_Port, it->Handle, sizeof(it->Handle), 0.05);
         }
     }
 };
 
 class mtsEventSenderWrite : public mtsEventSenderBase {
+    // Name of the argument class, compared to the one provided by clients enabling compact events
+    std::string ArgumentClassName;
 public:
-    mtsEventSenderWrite(osaSocket &socket) : mtsEventSenderBase(socket) {}
+    mtsEventSenderWrite(mtsSocketProxyServer *proxy, const std::string &argumentClassName) :
+        mtsEventSenderBase(proxy), ArgumentClassName(argumentClassName) {}
     ~mtsEventSenderWrite() {}
+    const std::string &GetArgumentClassName(void) const { return ArgumentClassName; }
     void Method(const mtsGenericObject &arg)
     {
         std::string sendBuffer;
         std::string sendBufferWithServices;
+        std::string sendBufferRaw;
         std::vector<ClientInfo>::const_iterator it;
         for (it = ClientList.begin(); it != ClientList.end(); it++) {
-            if (it->Serializer->ServicesSerialized(arg.Services())) {
+            if (it->Compact) {
+                if (sendBufferRaw.empty() && !it->Serializer->SerializeRaw(arg, sendBufferRaw))
+                    continue;
+                Proxy->SendCompactEvent(it->IP_Port, it->CompactId, sendBufferRaw.data(), sendBufferRaw.size());
+            }
+            else if (it->Serializer->ServicesSerialized(arg.Services())) {
                 if (sendBuffer.empty()) {
                     if (it->Serializer->Serialize(arg, sendBuffer))
                         sendBuffer.insert(0, it->Handle, CommandHandle::COMMAND_HANDLE_STRING_SIZE);
@@ -187,8 +221,7 @@ public:
                 else
                     sendBuffer.replace(0, CommandHandle::COMMAND_HANDLE_STRING_SIZE,
                                        it->Handle,CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-                Socket.SetDestination(it->IP_Port);
-                Socket.SendAsPackets(sendBuffer, mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.05);
+                Proxy->SendToClient(it->IP_Port, sendBuffer, 0.05);
             }
             else {
                 if (sendBufferWithServices.empty()) {
@@ -198,8 +231,7 @@ public:
                 else
                     sendBufferWithServices.replace(0, CommandHandle::COMMAND_HANDLE_STRING_SIZE,
                                                it->Handle,CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-                Socket.SetDestination(it->IP_Port);
-                Socket.SendAsPackets(sendBufferWithServices, mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.05);
+                Proxy->SendToClient(it->IP_Port, sendBufferWithServices, 0.05);
             }
         }
     }
@@ -213,18 +245,18 @@ public:
 // this RecvHandle is really a pointer to a write command on the client, which acts as an event handler
 // for the "finished event".  After the server dequeues and executes the command from the mailbox,
 // it calls the finished event proxy (this class), which then serializes the argument and passes it,
-// along with the RecvHandle, to the client via the socket.
+// along with the RecvHandle, to the client via the socket (or shared memory).
 
 class FinishedEventEntry {
-    osaSocket *Socket;
+    mtsSocketProxyServer *Proxy;
     osaIPandPort IP_Port;
     char RecvHandle[CommandHandle::COMMAND_HANDLE_STRING_SIZE];
     mtsProxySerializer *Serializer;
     bool Used;
 public:
-    FinishedEventEntry() : Socket(0), Serializer(0), Used(false) {}
-    FinishedEventEntry(osaSocket *socket, const osaIPandPort &ip_port, const std::string &recv_handle, mtsProxySerializer *serializer) :
-        Socket(socket), IP_Port(ip_port), Serializer(serializer), Used(true)
+    FinishedEventEntry() : Proxy(0), Serializer(0), Used(false) {}
+    FinishedEventEntry(mtsSocketProxyServer *proxy, const osaIPandPort &ip_port, const std::string &recv_handle, mtsProxySerializer *serializer) :
+        Proxy(proxy), IP_Port(ip_port), Serializer(serializer), Used(true)
     {
         // Make sure recv_handle string is big enough (should be exactly COMMAND_HANDLE_STRING_SIZE)
         CMN_ASSERT(recv_handle.size() >= sizeof(CommandHandle::COMMAND_HANDLE_STRING_SIZE));
@@ -233,6 +265,7 @@ public:
     ~FinishedEventEntry() {}
 
     bool IsUsed(void) const { return Used; }
+    const mtsProxySerializer *GetSerializer(void) const { return Serializer; }
     bool IsAvailable(void) const { return !IsUsed(); }
 
     void Free(void) { Used = false; }
@@ -263,12 +296,11 @@ void FinishedEventEntry::Method(const mtsStdString &argSerialized)
     if (!Used) {
         CMN_LOG_RUN_WARNING << "FinishedEventEntry: attempt to execute unused entry" << std::endl;
     }
-    CMN_ASSERT(Socket);
+    CMN_ASSERT(Proxy);
     CMN_ASSERT(Serializer);
     std::string sendBuffer(RecvHandle, sizeof(RecvHandle));
     sendBuffer.append(argSerialized.GetData());
-    Socket->SetDestination(IP_Port);
-    Socket->SendAsPackets(sendBuffer, mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.05);
+    Proxy->SendToClient(IP_Port, sendBuffer, 0.05);
     Used = false;
 }
 
@@ -287,10 +319,13 @@ public:
     FinishedEventList(size_t size, mtsMailBox *mbox, size_t mbox_size);
     ~FinishedEventList();
 
-    mtsCommandWriteBase *AllocateEntry(osaSocket *socket, const osaIPandPort &ip_port,
+    mtsCommandWriteBase *AllocateEntry(mtsSocketProxyServer *proxy, const osaIPandPort &ip_port,
                                        const std::string &recv_handle, mtsProxySerializer *serializer);
 
     bool FreeEntry(mtsCommandWriteBase *cmd);
+
+    // Check if a finished event still has to be sent using this serializer
+    bool UsesSerializer(const mtsProxySerializer *serializer) const;
 };
 
 FinishedEventList::FinishedEventList(size_t size, mtsMailBox *mbox, size_t mbox_size) :
@@ -318,12 +353,12 @@ FinishedEventList::~FinishedEventList()
     }
 }
 
-mtsCommandWriteBase *FinishedEventList::AllocateEntry(osaSocket *socket, const osaIPandPort &ip_port,
+mtsCommandWriteBase *FinishedEventList::AllocateEntry(mtsSocketProxyServer *proxy, const osaIPandPort &ip_port,
                                                       const std::string &recv_handle, mtsProxySerializer *serializer)
 {
     for (size_t i = 0; i < List.size(); i++) {
         if (List[i].IsAvailable()) {
-            List[i] = FinishedEventEntry(socket, ip_port, recv_handle, serializer);
+            List[i] = FinishedEventEntry(proxy, ip_port, recv_handle, serializer);
             return Cmd[i];
         }
     }
@@ -344,6 +379,15 @@ bool FinishedEventList::FreeEntry(mtsCommandWriteBase *cmd)
     return false;
 }
 
+bool FinishedEventList::UsesSerializer(const mtsProxySerializer *serializer) const
+{
+    for (size_t i = 0; i < List.size(); i++) {
+        if (List[i].IsUsed() && (List[i].GetSerializer() == serializer))
+            return true;
+    }
+    return false;
+}
+
 //************************************** Function Proxies *************************************************
 //
 // These are proxies for the mtsFunctionXXXX objects. Their input data comes from the socket, therefore
@@ -746,12 +790,15 @@ mtsSocketProxyServer::mtsSocketProxyServer(const std::string & proxyName, const
     FunctionWriteReturnProxyMap("FunctionWriteReturnProxyMap"),
     EventGeneratorVoidProxyMap("EventGeneratorVoidProxyMap"),
     EventGeneratorWriteProxyMap("EventGeneratorWriteProxyMap"),
+    SharedMemoryNextClient(1),
+    EventCoalescingWindow(0.0),
     FinishedEvents(0)
 {
     if (Init(componentName, providedInterfaceName)) {
         CMN_LOG_CLASS_INIT_VERBOSE << "Created required interface in " << proxyName << std::endl;
     }
-    Socket.AssignPort(port);
+    if (Socket.AssignPort(port))
+        InitSharedMemory(port);
 }
 
 mtsSocketProxyServer::mtsSocketProxyServer(const mtsSocketProxyServerConstructorArg &arg) :
@@ -765,21 +812,29 @@ mtsSocketProxyServer::mtsSocketProxyServer(const mtsSocketProxyServerConstructor
     FunctionWriteReturnProxyMap("FunctionWriteReturnProxyMap"),
     EventGeneratorVoidProxyMap("EventGeneratorVoidProxyMap"),
     EventGeneratorWriteProxyMap("EventGeneratorWriteProxyMap"),
+    SharedMemoryNextClient(1),
+    EventCoalescingWindow(0.0),
     FinishedEvents(0)
 {
     if (Init(arg.ComponentName, arg.ProvidedInterfaceName)) {
         CMN_LOG_CLASS_INIT_VERBOSE << "Created required interface in " << arg.Name << std::endl;
     }
-    Socket.AssignPort(arg.Port);
+    if (Socket.AssignPort(arg.Port))
+        InitSharedMemory(arg.Port);
 }
 
 mtsSocketProxyServer::~mtsSocketProxyServer()
 {
+    CloseSharedMemory();
+
     // Clear map of connected clients
     ClientMapType::iterator it;
     for (it = ClientMap.begin(); it != ClientMap.end(); it++)
         delete it->second;  // free memory for mtsProxySerializer
     ClientMap.clear();
+    for (size_t i = 0; i < DetachedSerializers.size(); i++)
+        delete DetachedSerializers[i];
+    DetachedSerializers.clear();
 
     FunctionVoidProxyMap.DeleteAll();
     FunctionWriteProxyMap.DeleteAll();
@@ -805,300 +860,439 @@ void mtsSocketProxyServer::Run(void)
     ProcessQueuedCommands();
     ProcessQueuedEvents();
 
+    if (!DetachedSerializers.empty())
+        DeleteDetachedSerializers();
+
+    // Send compact events for which the coalescing window has expired
+    if (!CompactEventBuffers.empty()) {
+        double now = osaGetTime();
+        CompactEventBufferMapType::iterator it;
+        for (it = CompactEventBuffers.begin(); it != CompactEventBuffers.end(); it++) {
+            if (!it->second.Data.empty() && (now - it->second.StartTime >= EventCoalescingWindow))
+                FlushCompactEvents(it->first, it->second);
+        }
+    }
+
+    // Check shared memory first since it is used by clients on the same computer;
+    // if it is available, the socket is only polled
+    double timeout = 0.001;
+    if (SharedMemory.IsOpen()) {
+        size_t length;
+        const char *message = SharedMemory.Peek(length, timeout);
+        if (message)
+            ProcessSharedMemoryMessage(message, length);
+        timeout = 0.0;
+    }
+
     std::string inputArgString;
     char packetBuffer[mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE];
-    int bytesRead = Socket.ReceiveAsPackets(inputArgString, packetBuffer, sizeof(packetBuffer), 0.001, 0.1);
+    int bytesRead = Socket.ReceiveAsPackets(inputArgString, packetBuffer, sizeof(packetBuffer), timeout, 0.1);
     if (bytesRead > 0) {
+        Socket.GetDestination(CurrentClient);
+        ProcessRequest(inputArgString);
+    }
+}
+
+void mtsSocketProxyServer::ProcessSharedMemoryMessage(const char *message, size_t length)
+{
+    // Each message starts with the client identifier (0 before the client is attached),
+    // the message is copied so the ring can be released before processing the command
+    const size_t idSize = mtsSocketProxy::SOCKET_PROXY_SHARED_MEMORY_ID_SIZE;
+    if (length < idSize) {
+        CMN_LOG_CLASS_RUN_ERROR << "Received invalid shared memory message, size = " << length << std::endl;
+        SharedMemory.Release();
+        return;
+    }
+    unsigned long long id;
+    memcpy(&id, message, idSize);
+    std::string inputArgString(message + idSize, length - idSize);
+    SharedMemory.Release();
+
+    const std::string attach("SharedMemoryAttach ");
+    if (inputArgString.compare(0, attach.size(), attach) == 0) {
+        // Client sends the name of its ring, used for responses and events
+        std::string ringName = inputArgString.substr(attach.size());
+        osaSharedMemoryRing *ring = new osaSharedMemoryRing;
+        if (!ring->Open(ringName)) {
+            CMN_LOG_CLASS_RUN_ERROR << "Failed to open shared memory for client " << ringName << std::endl;
+            delete ring;
+            return;
+        }
+        id = SharedMemoryNextClient++;
+        std::stringstream address;
+        address << "shm:" << id;
+        SharedMemoryClient &client = SharedMemoryClients[id];
+        client.Ring = ring;
+        client.Address = osaIPandPort(address.str(), 0);
+        std::string reply("SharedMemoryAttached ");
+        reply.append(reinterpret_cast<const char *>(&id), sizeof(id));
+        ring->Send(reply.data(), reply.size(), 0.1);
+        CMN_LOG_CLASS_RUN_VERBOSE << "Client " << ringName << " attached using shared memory as "
+                                  << client.Address.IP << std::endl;
+        return;
+    }
 
-        // Process the input string. The code currently supports two protocols, which
-        // are distinguished by looking at the first byte. If it is a space, then
-        // we are using a CommandHandle (#1 below); otherwise, we are using a
-        // CommandString (#2 below). The CommandHandle protocol is more run-time
-        // efficient because there is no string lookup.
-        //
-        // 1) CommandHandle protocol: The first 10 bytes are the CommandHandle, where
-        //    the first byte is a space, the second byte is a character that designates
-        //    the type of command (e.g., 'V', 'R', 'W', 'Q'), and the last 8 bytes are a 64-bit
-        //    address of the mtsFunctionXXXX object to be invoked. The next 10 bytes
-        //    are the EventReceiverHandle; this is also a CommandHandle, but is actually
-        //    the address of the client's EventReceiverWriteProxy object. The serialized command
-        //    argument (e.g., for Write, QualifiedRead, and WriteReturn commands) immediately
-        //    follows the EventReceiverHandle.
-        //
-        // 2) CommandString protocol: All characters up to the first delimiter (space, or end
-        //    of string) designate the command name. If there is a space, then it is assumed
-        //    that the serialized command argument immediately follows the space. Since
-        //    this protocol requires a string lookup to find the address of the mtsFunctionXXXX
-        //    object, some efficiency is obtained by splitting the code between the commands
-        //    that do not use an argument (Void, Read, VoidReturn) and those that do (Write,
-        //    QualifiedRead, WriteReturn). NOTE: This protocol is currently broken, since
-        //    it does not provide a proper return value. This can be fixed by passing a symbolic
-        //    name (string) for the return value; the server proxy can then send a message (event)
-        //    that is identified by this symbolic name.
-        //
-        // There is currently only one protocol for the response packet. It begins with the
-        // EventReceiverHandle (which is an empty string for the CommandString protocol), followed by
-        // the serialized serialized return value (for read, qualified read, void return, write return)
-        // or by the serialized mtsExecutionResult (for blocking void and write).
-
-        mtsExecutionResult ret;
-        std::string        RecvHandle;
-        std::string        outputArgString;
-
-        osaIPandPort ip_port;
-        Socket.GetDestination(ip_port);
-        mtsProxySerializer *serializer = GetSerializerForClient(ip_port);
-        // Most commands are blocking
-        bool isBlocking = true;
-        // Event sender command
-        mtsCommandWriteBase *eventSenderCommand = 0;
-
-        size_t pos = inputArgString.find(' ');
-        if ((pos == 0) && (inputArgString.size() >= 2*CommandHandle::COMMAND_HANDLE_STRING_SIZE)) {
-            CommandHandle handle(inputArgString);
-            RecvHandle = inputArgString.substr(CommandHandle::COMMAND_HANDLE_STRING_SIZE,
-                                               CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-            inputArgString.erase(0, 2*CommandHandle::COMMAND_HANDLE_STRING_SIZE);
-            // Since we know the command type (handle.cmdType) we could reinterpret_cast directly to
-            // the correct mtsFunctionXXXX type, but to be safe we first reinterpret_cast to the base
-            // type, mtsFunctionBase, and then do a dynamic_cast to the expected type. If the address
-            // (handle.addr) is corrupted, this would lead to either a dynamic_cast failure (i.e.,
-            // a null pointer) or possibly a runtime exception.
-            mtsFunctionBase *functionBase = reinterpret_cast<mtsFunctionBase *>(handle.addr);
-            try {
-                FunctionVoidProxy *functionVoid;
-                FunctionReadProxy *functionReadProxy;
-                FunctionWriteProxy *functionWriteProxy;
-                FunctionQualifiedReadProxy *functionQualifiedReadProxy;
+    SharedMemoryClientMapType::iterator it = SharedMemoryClients.find(id);
+    if (it == SharedMemoryClients.end()) {
+        CMN_LOG_CLASS_RUN_ERROR << "Received shared memory message from unknown client " << id << std::endl;
+        return;
+    }
+    if (inputArgString == "SharedMemoryDetach") {
+        CMN_LOG_CLASS_RUN_VERBOSE << "Client " << it->second.Address.IP << " detached" << std::endl;
+        RemoveClient(it->second.Address);
+        CompactEventBuffers.erase(it->second.Address);
+        delete it->second.Ring;
+        SharedMemoryClients.erase(it);
+        return;
+    }
+    CurrentClient = it->second.Address;
+    ProcessRequest(inputArgString);
+}
+
+void mtsSocketProxyServer::RemoveClient(const osaIPandPort &ip_port)
+{
+    EventGeneratorVoidProxyMapType::iterator itVoid;
+    for (itVoid = EventGeneratorVoidProxyMap.begin(); itVoid != EventGeneratorVoidProxyMap.end(); itVoid++)
+        itVoid->second->RemoveClient(ip_port);
+    EventGeneratorWriteProxyMapType::iterator itWrite;
+    for (itWrite = EventGeneratorWriteProxyMap.begin(); itWrite != EventGeneratorWriteProxyMap.end(); itWrite++)
+        itWrite->second->RemoveClient(ip_port);
+    // Finished events already queued might still use the serializer
+    ClientMapType::iterator it = ClientMap.find(ip_port);
+    if (it != ClientMap.end()) {
+        DetachedSerializers.push_back(it->second);
+        ClientMap.erase(it);
+        DeleteDetachedSerializers();
+    }
+}
+
+void mtsSocketProxyServer::DeleteDetachedSerializers(void)
+{
+    std::vector<mtsProxySerializer *>::iterator it = DetachedSerializers.begin();
+    while (it != DetachedSerializers.end()) {
+        if (FinishedEvents && FinishedEvents->UsesSerializer(*it))
+            it++;
+        else {
+            delete *it;
+            it = DetachedSerializers.erase(it);
+        }
+    }
+}
+
+void mtsSocketProxyServer::ProcessRequest(std::string &inputArgString)
+{
+    // Process the input string. The code currently supports two protocols, which
+    // are distinguished by looking at the first byte. If it is a space, then
+    // we are using a CommandHandle (#1 below); otherwise, we are using a
+    // CommandString (#2 below). The CommandHandle protocol is more run-time
+    // efficient because there is no string lookup.
+    //
+    // 1) CommandHandle protocol: The first 10 bytes are the CommandHandle, where
+    //    the first byte is a space, the second byte is a character that designates
+    //    the type of command (e.g., 'V', 'R', 'W', 'Q'), and the last 8 bytes are a 64-bit
+    //    address of the mtsFunctionXXXX object to be invoked. The next 10 bytes
+    //    are the EventReceiverHandle; this is also a CommandHandle, but is actually
+    //    the address of the client's EventReceiverWriteProxy object. The serialized command
+    //    argument (e.g., for Write, QualifiedRead, and WriteReturn commands) immediately
+    //    follows the EventReceiverHandle.
+    //
+    // 2) CommandString protocol: All characters up to the first delimiter (space, or end
+    //    of string) designate the command name. If there is a space, then it is assumed
+    //    that the serialized command argument immediately follows the space. Since
+    //    this protocol requires a string lookup to find the address of the mtsFunctionXXXX
+    //    object, some efficiency is obtained by splitting the code between the commands
+    //    that do not use an argument (Void, Read, VoidReturn) and those that do (Write,
+    //    QualifiedRead, WriteReturn). NOTE: This protocol is currently broken, since
+    //    it does not provide a proper return value. This can be fixed by passing a symbolic
+    //    name (string) for the return value; the server proxy can then send a message (event)
+    //    that is identified by this symbolic name.
+    //
+    // There is currently only one protocol for the response packet. It begins with the
+    // EventReceiverHandle (which is an empty string for the CommandString protocol), followed by
+    // the serialized serialized return value (for read, qualified read, void return, write return)
+    // or by the serialized mtsExecutionResult (for blocking void and write).
+
+    mtsExecutionResult ret;
+    std::string        RecvHandle;
+    std::string        outputArgString;
+
+    mtsProxySerializer *serializer = GetSerializerForClient(CurrentClient);
+    // Most commands are blocking
+    bool isBlocking = true;
+    // Event sender command
+    mtsCommandWriteBase *eventSenderCommand = 0;
+
+    size_t pos = inputArgString.find(' ');
+    if ((pos == 0) && (inputArgString.size() >= 2*CommandHandle::COMMAND_HANDLE_STRING_SIZE)) {
+        CommandHandle handle(inputArgString);
+        RecvHandle = inputArgString.substr(CommandHandle::COMMAND_HANDLE_STRING_SIZE,
+                                           CommandHandle::COMMAND_HANDLE_STRING_SIZE);
+        inputArgString.erase(0, 2*CommandHandle::COMMAND_HANDLE_STRING_SIZE);
+        // Since we know the command type (handle.cmdType) we could reinterpret_cast directly to
+        // the correct mtsFunctionXXXX type, but to be safe we first reinterpret_cast to the base
+        // type, mtsFunctionBase, and then do a dynamic_cast to the expected type. If the address
+        // (handle.addr) is corrupted, this would lead to either a dynamic_cast failure (i.e.,
+        // a null pointer) or possibly a runtime exception.
+        mtsFunctionBase *functionBase = reinterpret_cast<mtsFunctionBase *>(handle.addr);
+        try {
+            FunctionVoidProxy *functionVoid;
+            FunctionReadProxy *functionReadProxy;
+            FunctionWriteProxy *functionWriteProxy;
+            FunctionQualifiedReadProxy *functionQualifiedReadProxy;
 				FunctionVoidReturnProxy *functionVoidReturnProxy;
 				FunctionWriteReturnProxy *functionWriteReturnProxy;
-                switch (handle.cmdType) {
-                  case 'I':
-                      ret = GetInitData(outputArgString, serializer);
-                      break;
-                  case 'V':
-                      isBlocking = false;
-                      functionVoid = dynamic_cast<FunctionVoidProxy *>(functionBase);
-                      if (functionVoid)
-                          ret = functionVoid->ExecuteSerialized(MTS_NOT_BLOCKING, 0);
-                      else {
-                          CMN_LOG_CLASS_RUN_ERROR << "FunctionVoidProxy dynamic cast failed" << std::endl;
-                          ret = mtsExecutionResult::INVALID_COMMAND_ID;
-                      }
-                      break;
-                  case 'v':   // blocking
-                      functionVoid = dynamic_cast<FunctionVoidProxy *>(functionBase);
-                      if (functionVoid) {
-                          eventSenderCommand = AllocateFinishedEvent(RecvHandle);
-                          if (eventSenderCommand)
-                              ret = functionVoid->ExecuteSerialized(MTS_BLOCKING, eventSenderCommand);
-                          else
-                              ret = mtsExecutionResult::NO_FINISHED_EVENT;
-                      }
-                      else {
-                          CMN_LOG_CLASS_RUN_ERROR << "FunctionVoidProxy(blocking) dynamic cast failed" << std::endl;
-                          ret = mtsExecutionResult::INVALID_COMMAND_ID;
-                      }
-                      break;
-                  case 'R':
-                      functionReadProxy = dynamic_cast<FunctionReadProxy *>(functionBase);
-                      if (functionReadProxy) {
-                          eventSenderCommand = AllocateFinishedEvent(RecvHandle);
-                          if (eventSenderCommand)
-                              ret = functionReadProxy->ExecuteSerialized(outputArgString, eventSenderCommand);
-                          else
-                              ret = mtsExecutionResult::NO_FINISHED_EVENT;
-                      }
-                      else {
-                          CMN_LOG_CLASS_RUN_ERROR << "FunctionReadProxy dynamic cast failed" << std::endl;
-                          ret = mtsExecutionResult::INVALID_COMMAND_ID;
-                      }
-                      break;
-                  case 'W':
-                      isBlocking = false;
-                      functionWriteProxy = dynamic_cast<FunctionWriteProxy *>(functionBase);
-                      if (functionWriteProxy)
-                          ret = functionWriteProxy->ExecuteSerialized(inputArgString, MTS_NOT_BLOCKING, 0);
-                      else {
-                          CMN_LOG_CLASS_RUN_ERROR << "FunctionWriteProxy dynamic cast failed" << std::endl;
-                          ret = mtsExecutionResult::INVALID_COMMAND_ID;
-                      }
-                      break;
-                  case 'w':   // blocking
-                      functionWriteProxy = dynamic_cast<FunctionWriteProxy *>(functionBase);
-                      if (functionWriteProxy) {
-                          eventSenderCommand = AllocateFinishedEvent(RecvHandle);
-                          if (eventSenderCommand)
-                              ret = functionWriteProxy->ExecuteSerialized(inputArgString, MTS_BLOCKING, eventSenderCommand);
-                          else
-                              ret = mtsExecutionResult::NO_FINISHED_EVENT;
-                      }
-                      else {
-                          CMN_LOG_CLASS_RUN_ERROR << "FunctionWriteProxy dynamic cast failed" << std::endl;
-                          ret = mtsExecutionResult::INVALID_COMMAND_ID;
-                      }
-                      break;
-                  case 'Q':
-                      functionQualifiedReadProxy = dynamic_cast<FunctionQualifiedReadProxy *>(functionBase);
-                      if (functionQualifiedReadProxy) {
-                          eventSenderCommand = AllocateFinishedEvent(RecvHandle);
-                          if (eventSenderCommand)
-                              ret = functionQualifiedReadProxy->ExecuteSerialized(inputArgString, outputArgString, eventSenderCommand);
-                          else
-                              ret = mtsExecutionResult::NO_FINISHED_EVENT;
-                      }
-                      else {
-                          CMN_LOG_CLASS_RUN_ERROR << "FunctionQualifiedReadProxy dynamic cast failed" << std::endl;
-                          ret = mtsExecutionResult::INVALID_COMMAND_ID;
-                      }
-                      break;
-                  case 'r':
-                      functionVoidReturnProxy = dynamic_cast<FunctionVoidReturnProxy *>(functionBase);
-                      if (functionVoidReturnProxy) {
-                          eventSenderCommand = AllocateFinishedEvent(RecvHandle);
-                          if (eventSenderCommand)
-                              ret = functionVoidReturnProxy->ExecuteSerialized(eventSenderCommand);
-                          else
-                              ret = mtsExecutionResult::NO_FINISHED_EVENT;
-                      }
-                      else {
-                          CMN_LOG_CLASS_RUN_ERROR << "FunctionVoidReturnProxy dynamic cast failed" << std::endl;
-                          ret = mtsExecutionResult::INVALID_COMMAND_ID;
-                      }
-                      break;
-                  case 'q':
-                      functionWriteReturnProxy = dynamic_cast<FunctionWriteReturnProxy *>(functionBase);
-                      if (functionWriteReturnProxy) {
-                          eventSenderCommand = AllocateFinishedEvent(RecvHandle);
-                          if (eventSenderCommand)
-                              ret = functionWriteReturnProxy->ExecuteSerialized(inputArgString, eventSenderCommand);
-                          else
-                              ret = mtsExecutionResult::NO_FINISHED_EVENT;
-                      }
-                      else {
-                          CMN_LOG_CLASS_RUN_ERROR << "FunctionWriteReturnProxy dynamic cast failed" << std::endl;
-                          ret = mtsExecutionResult::INVALID_COMMAND_ID;
-                      }
-                      break;
-                default:
-                    CMN_LOG_CLASS_RUN_ERROR << "Invalid command type: " << handle.cmdType << std::endl;
-                }
-            }
-            catch (const std::runtime_error &e) {
-                CMN_LOG_CLASS_RUN_ERROR << "Exception while using command handle for type " << handle.cmdType
-                                        << ", addr = " << std::hex << handle.addr << ": " << e.what() << std::endl;
-                ret = mtsExecutionResult::INVALID_COMMAND_ID;
-            }
-            if (!ret.IsOK()) {
-                CMN_LOG_CLASS_RUN_WARNING << "Command type: " << handle.cmdType << ", result = " << ret << std::endl;
+            switch (handle.cmdType) {
+              case 'I':
+                  ret = GetInitData(outputArgString, serializer);
+                  break;
+              case 'V':
+                  isBlocking = false;
+                  functionVoid = dynamic_cast<FunctionVoidProxy *>(functionBase);
+                  if (functionVoid)
+                      ret = functionVoid->ExecuteSerialized(MTS_NOT_BLOCKING, 0);
+                  else {
+                      CMN_LOG_CLASS_RUN_ERROR << "FunctionVoidProxy dynamic cast failed" << std::endl;
+                      ret = mtsExecutionResult::INVALID_COMMAND_ID;
+                  }
+                  break;
+              case 'v':   // blocking
+                  functionVoid = dynamic_cast<FunctionVoidProxy *>(functionBase);
+                  if (functionVoid) {
+                      eventSenderCommand = AllocateFinishedEvent(RecvHandle);
+                      if (eventSenderCommand)
+                          ret = functionVoid->ExecuteSerialized(MTS_BLOCKING, eventSenderCommand);
+                      else
+                          ret = mtsExecutionResult::NO_FINISHED_EVENT;
+                  }
+                  else {
+                      CMN_LOG_CLASS_RUN_ERROR << "FunctionVoidProxy(blocking) dynamic cast failed" << std::endl;
+                      ret = mtsExecutionResult::INVALID_COMMAND_ID;
+                  }
+                  break;
+              case 'R':
+                  functionReadProxy = dynamic_cast<FunctionReadProxy *>(functionBase);
+                  if (functionReadProxy) {
+                      eventSenderCommand = AllocateFinishedEvent(RecvHandle);
+                      if (eventSenderCommand)
+                          ret = functionReadProxy->ExecuteSerialized(outputArgString, eventSenderCommand);
+                      else
+                          ret = mtsExecutionResult::NO_FINISHED_EVENT;
+                  }
+                  else {
+                      CMN_LOG_CLASS_RUN_ERROR << "FunctionReadProxy dynamic cast failed" << std::endl;
+                      ret = mtsExecutionResult::INVALID_COMMAND_ID;
+                  }
+                  break;
+              case 'W':
+                  isBlocking = false;
+                  functionWriteProxy = dynamic_cast<FunctionWriteProxy *>(functionBase);
+                  if (functionWriteProxy)
+                      ret = functionWriteProxy->ExecuteSerialized(inputArgString, MTS_NOT_BLOCKING, 0);
+                  else {
+                      CMN_LOG_CLASS_RUN_ERROR << "FunctionWriteProxy dynamic cast failed" << std::endl;
+                      ret = mtsExecutionResult::INVALID_COMMAND_ID;
+                  }
+                  break;
+              case 'w':   // blocking
+                  functionWriteProxy = dynamic_cast<FunctionWriteProxy *>(functionBase);
+                  if (functionWriteProxy) {
+                      eventSenderCommand = AllocateFinishedEvent(RecvHandle);
+                      if (eventSenderCommand)
+                          ret = functionWriteProxy->ExecuteSerialized(inputArgString, MTS_BLOCKING, eventSenderCommand);
+                      else
+                          ret = mtsExecutionResult::NO_FINISHED_EVENT;
+                  }
+                  else {
+                      CMN_LOG_CLASS_RUN_ERROR << "FunctionWriteProxy dynamic cast failed" << std::endl;
+                      ret = mtsExecutionResult::INVALID_COMMAND_ID;
+                  }
+                  break;
+              case 'Q':
+                  functionQualifiedReadProxy = dynamic_cast<FunctionQualifiedReadProxy *>(functionBase);
+                  if (functionQualifiedReadProxy) {
+                      eventSenderCommand = AllocateFinishedEvent(RecvHandle);
+                      if (eventSenderCommand)
+                          ret = functionQualifiedReadProxy->ExecuteSerialized(inputArgString, outputArgString, eventSenderCommand);
+                      else
+                          ret = mtsExecutionResult::NO_FINISHED_EVENT;
+                  }
+                  else {
+                      CMN_LOG_CLASS_RUN_ERROR << "FunctionQualifiedReadProxy dynamic cast failed" << std::endl;
+                      ret = mtsExecutionResult::INVALID_COMMAND_ID;
+                  }
+                  break;
+              case 'r':
+                  functionVoidReturnProxy = dynamic_cast<FunctionVoidReturnProxy *>(functionBase);
+                  if (functionVoidReturnProxy) {
+                      eventSenderCommand = AllocateFinishedEvent(RecvHandle);
+                      if (eventSenderCommand)
+                          ret = functionVoidReturnProxy->ExecuteSerialized(eventSenderCommand);
+                      else
+                          ret = mtsExecutionResult::NO_FINISHED_EVENT;
+                  }
+                  else {
+                      CMN_LOG_CLASS_RUN_ERROR << "FunctionVoidReturnProxy dynamic cast failed" << std::endl;
+                      ret = mtsExecutionResult::INVALID_COMMAND_ID;
+                  }
+                  break;
+              case 'q':
+                  functionWriteReturnProxy = dynamic_cast<FunctionWriteReturnProxy *>(functionBase);
+                  if (functionWriteReturnProxy) {
+                      eventSenderCommand = AllocateFinishedEvent(RecvHandle);
+                      if (eventSenderCommand)
+                          ret = functionWriteReturnProxy->ExecuteSerialized(inputArgString, eventSenderCommand);
+                      else
+                          ret = mtsExecutionResult::NO_FINISHED_EVENT;
+                  }
+                  else {
+                      CMN_LOG_CLASS_RUN_ERROR << "FunctionWriteReturnProxy dynamic cast failed" << std::endl;
+                      ret = mtsExecutionResult::INVALID_COMMAND_ID;
+                  }
+                  break;
+            default:
+                CMN_LOG_CLASS_RUN_ERROR << "Invalid command type: " << handle.cmdType << std::endl;
             }
         }
+        catch (const std::runtime_error &e) {
+            CMN_LOG_CLASS_RUN_ERROR << "Exception while using command handle for type " << handle.cmdType
+                                    << ", addr = " << std::hex << handle.addr << ": " << e.what() << std::endl;
+            ret = mtsExecutionResult::INVALID_COMMAND_ID;
+        }
+        if (!ret.IsOK()) {
+            CMN_LOG_CLASS_RUN_WARNING << "Command type: " << handle.cmdType << ", result = " << ret << std::endl;
+        }
+    }
+    else {
+        // PK TODO: RecvHandle is not handled
+        std::string commandName;
+        if (pos != std::string::npos) {
+            commandName = inputArgString.substr(0, pos);
+            inputArgString.erase(0, pos+1);
+        }
         else {
-            // PK TODO: RecvHandle is not handled
-            std::string commandName;
-            if (pos != std::string::npos) {
-                commandName = inputArgString.substr(0, pos);
-                inputArgString.erase(0, pos+1);
-            }
-            else {
-                commandName = inputArgString;
-                inputArgString.clear();
-            }
+            commandName = inputArgString;
+            inputArgString.clear();
+        }
 
-            if (commandName == "GetInitData")
-                ret = GetInitData(outputArgString, serializer);
-            else if (inputArgString.empty()) {
-                // Void, Read, or VoidReturn
-                FunctionVoidProxy *functionVoid = FunctionVoidProxyMap.GetItem(commandName);
-                if (functionVoid)
-                    ret = functionVoid->Execute();
+        if (commandName == "GetInitData")
+            ret = GetInitData(outputArgString, serializer);
+        else if (inputArgString.empty()) {
+            // Void, Read, or VoidReturn
+            FunctionVoidProxy *functionVoid = FunctionVoidProxyMap.GetItem(commandName);
+            if (functionVoid)
+                ret = functionVoid->Execute();
+            else {
+                FunctionReadProxy *functionRead = FunctionReadProxyMap.GetItem(commandName);
+                if (functionRead) {
+                    eventSenderCommand = AllocateFinishedEvent(RecvHandle);
+                    if (eventSenderCommand)
+                        ret = functionRead->ExecuteSerialized(outputArgString, eventSenderCommand);
+                    else
+                        ret = mtsExecutionResult::NO_FINISHED_EVENT;
+                }
                 else {
-                    FunctionReadProxy *functionRead = FunctionReadProxyMap.GetItem(commandName);
-                    if (functionRead) {
+                    FunctionVoidReturnProxy *functionVoidReturn = FunctionVoidReturnProxyMap.GetItem(commandName);
+                    if (functionVoidReturn) {
                         eventSenderCommand = AllocateFinishedEvent(RecvHandle);
                         if (eventSenderCommand)
-                            ret = functionRead->ExecuteSerialized(outputArgString, eventSenderCommand);
+                            ret = functionVoidReturn->ExecuteSerialized(eventSenderCommand);
                         else
                             ret = mtsExecutionResult::NO_FINISHED_EVENT;
                     }
-                    else {
-                        FunctionVoidReturnProxy *functionVoidReturn = FunctionVoidReturnProxyMap.GetItem(commandName);
-                        if (functionVoidReturn) {
-                            eventSenderCommand = AllocateFinishedEvent(RecvHandle);
-                            if (eventSenderCommand)
-                                ret = functionVoidReturn->ExecuteSerialized(eventSenderCommand);
-                            else
-                                ret = mtsExecutionResult::NO_FINISHED_EVENT;
-                        }
-                    }
                 }
             }
+        }
+        else {
+            // Write, QualifiedRead, or WriteReturn
+            FunctionWriteProxy *functionWrite = FunctionWriteProxyMap.GetItem(commandName);
+            if (functionWrite)
+                ret = functionWrite->ExecuteSerialized(inputArgString, MTS_NOT_BLOCKING, 0);
             else {
-                // Write, QualifiedRead, or WriteReturn
-                FunctionWriteProxy *functionWrite = FunctionWriteProxyMap.GetItem(commandName);
-                if (functionWrite)
-                    ret = functionWrite->ExecuteSerialized(inputArgString, MTS_NOT_BLOCKING, 0);
+                FunctionQualifiedReadProxy *functionQualifiedRead = FunctionQualifiedReadProxyMap.GetItem(commandName);
+                if (functionQualifiedRead) {
+                    eventSenderCommand = AllocateFinishedEvent(RecvHandle);
+                    if (eventSenderCommand)
+                        ret = functionQualifiedRead->ExecuteSerialized(inputArgString, outputArgString, eventSenderCommand);
+                    else
+                        ret = mtsExecutionResult::NO_FINISHED_EVENT;
+                }
                 else {
-                    FunctionQualifiedReadProxy *functionQualifiedRead = FunctionQualifiedReadProxyMap.GetItem(commandName);
-                    if (functionQualifiedRead) {
+                    FunctionWriteReturnProxy *functionWriteReturn = FunctionWriteReturnProxyMap.GetItem(commandName);
+                    if (functionWriteReturn) {
                         eventSenderCommand = AllocateFinishedEvent(RecvHandle);
                         if (eventSenderCommand)
-                            ret = functionQualifiedRead->ExecuteSerialized(inputArgString, outputArgString, eventSenderCommand);
+                            ret = functionWriteReturn->ExecuteSerialized(inputArgString, eventSenderCommand);
                         else
                             ret = mtsExecutionResult::NO_FINISHED_EVENT;
                     }
-                    else {
-                        FunctionWriteReturnProxy *functionWriteReturn = FunctionWriteReturnProxyMap.GetItem(commandName);
-                        if (functionWriteReturn) {
-                            eventSenderCommand = AllocateFinishedEvent(RecvHandle);
-                            if (eventSenderCommand)
-                                ret = functionWriteReturn->ExecuteSerialized(inputArgString, eventSenderCommand);
-                            else
-                                ret = mtsExecutionResult::NO_FINISHED_EVENT;
-                        }
-                    }
                 }
             }
-            if (!ret.IsOK()) {
-                CMN_LOG_CLASS_RUN_WARNING << "Command: " << commandName << ", result = " << ret << std::endl;
-            }
         }
+        if (!ret.IsOK()) {
+            CMN_LOG_CLASS_RUN_WARNING << "Command: " << commandName << ", result = " << ret << std::endl;
+        }
+    }
 
-        // If this was a blocking command, but was not queued, we need to send a response now.  If it was
-        // queued, we can rely on mtsMailBox::ExeuteNext to send the response via an event.
-        if (isBlocking && (ret.Value() != mtsExecutionResult::COMMAND_QUEUED)) {
-            // If the command failed, send the execution result instead
-            if (ret.Value() != mtsExecutionResult::COMMAND_SUCCEEDED) {
-                outputArgString.clear();
-                CMN_LOG_CLASS_RUN_WARNING << "Returning failed execution result: "
-                                          << mtsExecutionResult::ToString(ret.Value()) << std::endl;
-            }
-            if (outputArgString.empty()) {
-                if (!serializer->Serialize(mtsExecutionResultProxy(ret), outputArgString)) {
-                    CMN_LOG_CLASS_RUN_ERROR << "Failed to serialize execution result for blocking command" << std::endl;
-                }
+    // If this was a blocking command, but was not queued, we need to send a response now.  If it was
+    // queued, we can rely on mtsMailBox::ExeuteNext to send the response via an event.
+    if (isBlocking && (ret.Value() != mtsExecutionResult::COMMAND_QUEUED)) {
+        // If the command failed, send the execution result instead
+        if (ret.Value() != mtsExecutionResult::COMMAND_SUCCEEDED) {
+            outputArgString.clear();
+            CMN_LOG_CLASS_RUN_WARNING << "Returning failed execution result: "
+                                      << mtsExecutionResult::ToString(ret.Value()) << std::endl;
+        }
+        if (outputArgString.empty()) {
+            if (!serializer->Serialize(mtsExecutionResultProxy(ret), outputArgString)) {
+                CMN_LOG_CLASS_RUN_ERROR << "Failed to serialize execution result for blocking command" << std::endl;
             }
-            // We won't be using the eventSender, so free it
-            if (eventSenderCommand)
-                FinishedEvents->FreeEntry(eventSenderCommand);
-            // Send a reply to the caller with the following format:
-            //    RecvHandle | outputString
-            outputArgString.insert(0, RecvHandle);
-
-            size_t nBytes = outputArgString.size();
-            // If the packet size is an exact multiple of SOCKET_PROXY_PACKET_SIZE (nBytes == 0), then we
-            // send an extra byte so that the receiver does not have to rely on a timeout to figure out
-            // when a packet stream is finished.
-            if ((nBytes%mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE) == 0)
-                outputArgString.append(" ");
-            Socket.SendAsPackets(outputArgString, mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, 0.1);
         }
+        // We won't be using the eventSender, so free it
+        if (eventSenderCommand)
+            FinishedEvents->FreeEntry(eventSenderCommand);
+        // Send a reply to the caller with the following format:
+        //    RecvHandle | outputString
+        outputArgString.insert(0, RecvHandle);
+
+        size_t nBytes = outputArgString.size();
+        // If the packet size is an exact multiple of SOCKET_PROXY_PACKET_SIZE (nBytes == 0), then we
+        // send an extra byte so that the receiver does not have to rely on a timeout to figure out
+        // when a packet stream is finished.
+        if ((nBytes%mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE) == 0)
+            outputArgString.append(" ");
+        SendToClient(CurrentClient, outputArgString, 0.1);
     }
 }
 
 void mtsSocketProxyServer::Cleanup(void)
 {
     Socket.Close();
+    CloseSharedMemory();
+}
+
+void mtsSocketProxyServer::InitSharedMemory(unsigned short port)
+{
+    if (!osaSharedMemoryRing::IsSupported())
+        return;
+    // The port is unique on this computer since it is assigned to the socket
+    std::stringstream name;
+    name << "cisstSocketProxy" << port;
+    if (SharedMemory.Create(name.str(), mtsSocketProxy::SOCKET_PROXY_SHARED_MEMORY_SIZE)) {
+        CMN_LOG_CLASS_INIT_VERBOSE << "Created shared memory " << SharedMemory.GetName()
+                                   << " for clients on this computer" << std::endl;
+    }
+    else {
+        CMN_LOG_CLASS_INIT_WARNING << "Failed to create shared memory, clients will use socket" << std::endl;
+    }
+}
+
+void mtsSocketProxyServer::CloseSharedMemory(void)
+{
+    SharedMemoryClientMapType::iterator it;
+    for (it = SharedMemoryClients.begin(); it != SharedMemoryClients.end(); it++)
+        delete it->second.Ring;
+    SharedMemoryClients.clear();
+    SharedMemory.Close();
 }
 
 bool mtsSocketProxyServer::Init(const std::string &componentName, const std::string &providedInterfaceName)
@@ -1245,7 +1439,7 @@ bool mtsSocketProxyServer::CreateServerProxy(const std::string & requiredInterfa
     for (i = 0; i < InterfaceDescription.EventsVoid.size(); ++i) {
         const mtsEventVoidDescription &evt = InterfaceDescription.EventsVoid[i];
         if (!mtsInterfaceProvided::IsSystemEventVoid(evt.Name)) {
-            mtsEventSenderVoid *eventSender = new mtsEventSenderVoid(Socket);
+            mtsEventSenderVoid *eventSender = new mtsEventSenderVoid(this);
             success = false;
             if (requiredInterfaceProxy->AddEventHandlerVoid(&mtsEventSenderVoid::Method, eventSender, evt.Name))
                 success = EventGeneratorVoidProxyMap.AddItem(evt.Name, eventSender);
@@ -1260,7 +1454,6 @@ bool mtsSocketProxyServer::CreateServerProxy(const std::string & requiredInterfa
     // Create EventWrite proxies
     for (i = 0; i < InterfaceDescription.EventsWrite.size(); ++i) {
         const mtsEventWriteDescription &evt = InterfaceDescription.EventsWrite[i];
-        mtsEventSenderWrite *eventSender = new mtsEventSenderWrite(Socket);
         success = false;
         std::stringstream argStream(evt.ArgumentPrototypeSerialized);
         cmnDeSerializer deserializer(argStream);
@@ -1271,6 +1464,7 @@ bool mtsSocketProxyServer::CreateServerProxy(const std::string & requiredInterfa
                                          << evt.Name << std::endl;
                 return false;
             }
+            mtsEventSenderWrite *eventSender = new mtsEventSenderWrite(this, argPrototype->Services()->GetName());
             if (requiredInterfaceProxy->AddEventHandlerWriteGeneric(&mtsEventSenderWrite::Method, eventSender, evt.Name,
                                                                     MTS_INTERFACE_EVENT_POLICY, argPrototype))
                 success = EventGeneratorWriteProxyMap.AddItem(evt.Name, eventSender);
@@ -1294,9 +1488,8 @@ void mtsSocketProxyServer::AddSpecialCommands(void)
 {
     std::stringstream outputStream;
     cmnSerializer serializer(outputStream);
-    mtsStdString *stringProxy = new mtsStdString;
-    // mtsCommandQualifiedRead destructor will delete the following
-    serializer.Serialize(*stringProxy);
+    mtsStdString stringProxy;
+    serializer.Serialize(stringProxy);
     std::string stringSerialized = outputStream.str();
     outputStream.str("");
     // mtsCommandRead destructor will delete the following
@@ -1321,6 +1514,7 @@ void mtsSocketProxyServer::AddSpecialCommands(void)
     FunctionQualifiedReadProxy *functionQualifiedReadProxy;
     mtsCallableQualifiedReadBase *callableQualifiedRead;
     mtsCommandQualifiedRead *commandQualifiedRead;
+    mtsStdString *stringPrototype;
     struct {
         std::string name;
         mtsCallableQualifiedReadMethod<mtsSocketProxyServer, std::string, std::string>::ActionType action;
@@ -1333,7 +1527,9 @@ void mtsSocketProxyServer::AddSpecialCommands(void)
     for (int i = 0; i < 6; i++) {
         //InterfaceDescription.CommandsQualifiedRead.push_back(CommandQualifiedReadElement(GetHandleInfo[i].name, stringSerialized, stringSerialized));
         callableQualifiedRead = new mtsCallableQualifiedReadMethod<mtsSocketProxyServer, std::string, std::string>(GetHandleInfo[i].action, this);
-        commandQualifiedRead = new mtsCommandQualifiedRead(callableQualifiedRead, GetHandleInfo[i].name, stringProxy, stringProxy);
+        // mtsCommandQualifiedRead destructor will delete the following, one per command
+        stringPrototype = new mtsStdString;
+        commandQualifiedRead = new mtsCommandQualifiedRead(callableQualifiedRead, GetHandleInfo[i].name, stringPrototype, stringPrototype);
         SpecialCommands.push_back(commandQualifiedRead);
         functionQualifiedReadProxy = new FunctionQualifiedReadProxy(this, stringSerialized, stringSerialized);
         functionQualifiedReadProxy->Bind(commandQualifiedRead);
@@ -1358,6 +1554,14 @@ void mtsSocketProxyServer::AddSpecialCommands(void)
     functionWriteProxy = new FunctionWriteProxy(this, stringSerialized);
     functionWriteProxy->Bind(commandWrite);
     FunctionWriteProxyMap.AddItem("EventDisable", functionWriteProxy);
+
+    // EventEnableCompact, see SOCKET_PROXY_VERSION 2
+    commandWrite = new mtsCommandWrite<mtsSocketProxyServer, std::string>(&mtsSocketProxyServer::EventEnableCompact, this,
+                                                                          "EventEnableCompact", mtsStdString());
+    SpecialCommands.push_back(commandWrite);
+    functionWriteProxy = new FunctionWriteProxy(this, stringSerialized);
+    functionWriteProxy->Bind(commandWrite);
+    FunctionWriteProxyMap.AddItem("EventEnableCompact", functionWriteProxy);
 }
 
 mtsExecutionResult mtsSocketProxyServer::GetInitData(std::string &outputArgSerialized, mtsProxySerializer *serializer) const
@@ -1371,7 +1575,11 @@ mtsExecutionResult mtsSocketProxyServer::GetInitData(std::string &outputArgSeria
                                 FunctionQualifiedReadProxyMap.GetItem("GetHandleVoidReturn"),
                                 FunctionQualifiedReadProxyMap.GetItem("GetHandleWriteReturn"),
                                 FunctionWriteProxyMap.GetItem("EventEnable"),
-                                FunctionWriteProxyMap.GetItem("EventDisable"));
+                                FunctionWriteProxyMap.GetItem("EventDisable"),
+                                FunctionWriteProxyMap.GetItem("EventEnableCompact"));
+
+    if (SharedMemory.IsOpen())
+        init.SetSharedMemoryName(SharedMemory.GetName());
 
     mtsExecutionResult ret = mtsExecutionResult::COMMAND_SUCCEEDED;
     // Reset serializer just in case client was previously connected
@@ -1400,19 +1608,81 @@ mtsProxySerializer *mtsSocketProxyServer::GetSerializerForClient(const osaIPandP
 
 mtsProxySerializer *mtsSocketProxyServer::GetSerializerForCurrentClient(void) const
 {
-    // Get IP and Port
-    osaIPandPort ip_port;
-    Socket.GetDestination(ip_port);
-    return GetSerializerForClient(ip_port);
+    return GetSerializerForClient(CurrentClient);
 }
 
 mtsCommandWriteBase *mtsSocketProxyServer::AllocateFinishedEvent(const std::string &eventHandle)
 {
     CMN_ASSERT(FinishedEvents);
-    osaIPandPort ip_port;
-    Socket.GetDestination(ip_port);
-    mtsProxySerializer *serializer = GetSerializerForClient(ip_port);
-    return FinishedEvents->AllocateEntry(&Socket, ip_port, eventHandle, serializer);
+    mtsProxySerializer *serializer = GetSerializerForClient(CurrentClient);
+    return FinishedEvents->AllocateEntry(this, CurrentClient, eventHandle, serializer);
+}
+
+int mtsSocketProxyServer::SendToClient(const osaIPandPort &ip_port, const char *buffer, size_t length, double timeoutSec)
+{
+    // Clients using shared memory have a pseudo address "shm:<identifier>"
+    if (ip_port.IP.compare(0, 4, "shm:") == 0) {
+        unsigned long long id = strtoull(ip_port.IP.c_str() + 4, 0, 10);
+        SharedMemoryClientMapType::iterator it = SharedMemoryClients.find(id);
+        if (it == SharedMemoryClients.end()) {
+            CMN_LOG_CLASS_RUN_WARNING << "SendToClient: client " << ip_port.IP << " is not connected" << std::endl;
+            return -1;
+        }
+        if (!it->second.Ring->Send(buffer, length, timeoutSec)) {
+            CMN_LOG_CLASS_RUN_WARNING << "SendToClient: failed to send " << length << " bytes to " << ip_port.IP << std::endl;
+            return 0;
+        }
+        return static_cast<int>(length);
+    }
+    Socket.SetDestination(ip_port);
+    return Socket.SendAsPackets(buffer, static_cast<unsigned int>(length), mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE, timeoutSec);
+}
+
+int mtsSocketProxyServer::SendToClient(const osaIPandPort &ip_port, const std::string &buffer, double timeoutSec)
+{
+    return SendToClient(ip_port, buffer.data(), buffer.size(), timeoutSec);
+}
+
+void mtsSocketProxyServer::SendCompactEvent(const osaIPandPort &ip_port, unsigned short eventId,
+                                            const char *argument, size_t length)
+{
+    CompactEventBuffer &buffer = CompactEventBuffers[ip_port];
+    const size_t eventSize = CompactEventHeader::COMPACT_EVENT_HEADER_SIZE + length;
+    // Send what has been coalesced so far if this event doesn't fit in the same packet
+    if (!buffer.Data.empty() && (buffer.Data.size() + eventSize > mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE))
+        FlushCompactEvents(ip_port, buffer);
+    if (buffer.Data.empty()) {
+        buffer.Data.push_back(mtsSocketProxy::SOCKET_PROXY_COMPACT_EVENTS);
+        buffer.StartTime = osaGetTime();
+    }
+    char headerString[CompactEventHeader::COMPACT_EVENT_HEADER_SIZE];
+    CompactEventHeader header(eventId, buffer.Sequence++, static_cast<unsigned int>(length));
+    header.ToString(headerString);
+    buffer.Data.append(headerString, sizeof(headerString));
+    if (length > 0)
+        buffer.Data.append(argument, length);
+    if ((EventCoalescingWindow <= 0.0) || (buffer.Data.size() >= mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE))
+        FlushCompactEvents(ip_port, buffer);
+}
+
+void mtsSocketProxyServer::FlushCompactEvents(const osaIPandPort &ip_port, CompactEventBuffer &buffer)
+{
+    // Same as other messages, add a byte if the size is a multiple of the packet size; the
+    // client ignores data smaller than a CompactEventHeader at the end of the message
+    if ((buffer.Data.size()%mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE) == 0)
+        buffer.Data.append(" ");
+    SendToClient(ip_port, buffer.Data, 0.05);
+    buffer.Data.clear();
+}
+
+void mtsSocketProxyServer::SetEventCoalescingWindow(double windowInSeconds)
+{
+    EventCoalescingWindow = windowInSeconds;
+}
+
+double mtsSocketProxyServer::GetEventCoalescingWindow(void) const
+{
+    return EventCoalescingWindow;
 }
 
 bool mtsSocketProxyServer::GetInterfaceDescription(mtsInterfaceProvidedDescription &desc) const
@@ -1493,12 +1763,10 @@ void mtsSocketProxyServer::EventEnable(const std::string &eventHandleAndName)
     else if (handle[1] == 'W')
         eventSender = EventGeneratorWriteProxyMap.GetItem(eventName);
     if (eventSender) {
-        osaIPandPort ip_port;
-        Socket.GetDestination(ip_port);
-        mtsProxySerializer *serializer = GetSerializerForClient(ip_port);
-        if (!eventSender->AddClient(ip_port, handle, serializer)) {
+        mtsProxySerializer *serializer = GetSerializerForClient(CurrentClient);
+        if (!eventSender->AddClient(CurrentClient, handle, serializer)) {
             CMN_LOG_CLASS_RUN_ERROR << "EventEnable " << eventName << " failed for "
-                                    << ip_port.IP << ":" << ip_port.Port << std::endl;
+                                    << CurrentClient.IP << ":" << CurrentClient.Port << std::endl;
         }
     }
     else {
@@ -1506,6 +1774,59 @@ void mtsSocketProxyServer::EventEnable(const std::string &eventHandleAndName)
     }
 }
 
+void mtsSocketProxyServer::EventEnableCompact(const std::string &eventHandleIdAndName)
+{
+    // First 10 characters are handle, followed by the event identifier chosen by the client,
+    // the name of the argument class (empty for void events), a space and the event name
+    const size_t headerSize = CommandHandle::COMMAND_HANDLE_STRING_SIZE + sizeof(unsigned short);
+    size_t pos = eventHandleIdAndName.find(' ', headerSize);
+    if ((eventHandleIdAndName.size() <= headerSize) || (pos == std::string::npos)) {
+        CMN_LOG_CLASS_RUN_ERROR << "EventEnableCompact: invalid request" << std::endl;
+        return;
+    }
+    char handle[CommandHandle::COMMAND_HANDLE_STRING_SIZE];
+    memcpy(handle, eventHandleIdAndName.data(), sizeof(handle));
+    unsigned short eventId;
+    memcpy(&eventId, eventHandleIdAndName.data() + sizeof(handle), sizeof(eventId));
+    std::string argumentClassName = eventHandleIdAndName.substr(headerSize, pos - headerSize);
+    std::string eventName = eventHandleIdAndName.substr(pos + 1);
+    mtsEventSenderBase *eventSender = 0;
+    bool compact = false;
+    if (handle[1] == 'V') {
+        eventSender = EventGeneratorVoidProxyMap.GetItem(eventName);
+        compact = true;
+    }
+    else if (handle[1] == 'W') {
+        mtsEventSenderWrite *eventSenderWrite = EventGeneratorWriteProxyMap.GetItem(eventName);
+        if (eventSenderWrite) {
+            // The raw data can only be used if both sides use the same type
+            compact = (eventSenderWrite->GetArgumentClassName() == argumentClassName);
+            if (!compact) {
+                CMN_LOG_CLASS_RUN_WARNING << "EventEnableCompact " << eventName << ": client argument type "
+                                          << argumentClassName << " differs from "
+                                          << eventSenderWrite->GetArgumentClassName()
+                                          << ", using serialized events" << std::endl;
+            }
+        }
+        eventSender = eventSenderWrite;
+    }
+    if (eventSender) {
+        mtsProxySerializer *serializer = GetSerializerForClient(CurrentClient);
+        if (!eventSender->AddClient(CurrentClient, handle, serializer, compact, eventId)) {
+            CMN_LOG_CLASS_RUN_ERROR << "EventEnableCompact " << eventName << " failed for "
+                                    << CurrentClient.IP << ":" << CurrentClient.Port << std::endl;
+        }
+        else if (compact) {
+            CMN_LOG_CLASS_RUN_VERBOSE << "EventEnableCompact " << eventName << " enabled for "
+                                      << CurrentClient.IP << ":" << CurrentClient.Port
+                                      << " with identifier " << eventId << std::endl;
+        }
+    }
+    else {
+        CMN_LOG_CLASS_RUN_ERROR << "EventEnableCompact " << eventName << " not found" << std::endl;
+    }
+}
+
 void mtsSocketProxyServer::EventDisable(const std::string &eventHandleAndName)
 {
     // First 10 characters are handle
@@ -1518,11 +1839,9 @@ void mtsSocketProxyServer::EventDisable(const std::string &eventHandleAndName)
     else if (handle[1] == 'W')
         eventSender = EventGeneratorWriteProxyMap.GetItem(eventName);
     if (eventSender) {
-        osaIPandPort ip_port;
-        Socket.GetDestination(ip_port);
-        if (!eventSender->RemoveClient(ip_port, handle)) {
+        if (!eventSender->RemoveClient(CurrentClient, handle)) {
             CMN_LOG_CLASS_RUN_ERROR << "EventDisable " << eventName << " failed for "
-                                    << ip_port.IP << ":" << ip_port.Port << std::endl;
+                                    << CurrentClient.IP << ":" << CurrentClient.Port << std::endl;
         }
     }
     else {
@@ -5,7 +5,7 @@
  Author(s):  Ankur Kapoor, Min Yang Jung, Anton Deguet
  Created on: 2004-04-30
 
- (C) Copyright 2004-2018 Johns Hopkins University (JHU), All Rights Reserved.
+ (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -18,9 +18,11 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <cisstCommon/cmnAssert.h>
 #include <cisstOSAbstraction/osaTimeServer.h>
+#include <cisstOSAbstraction/osaSleep.h>
 #include <cisstMultiTask/mtsStateTable.h>
 #include <cisstMultiTask/mtsTaskManager.h>
 #include <cisstMultiTask/mtsCollectorState.h>
+#include <cisstMultiTask/mtsStateTableFlightRecorder.h>
 
 #include <iostream>
 #include <string>
@@ -44,6 +46,7 @@ mtsStateTable::mtsStateTable(size_t size, const std::string & name):
     IndexDelayed(0),
     Delay(0.0),
     AutomaticAdvanceFlag(true),
+    ReplayTimeFlag(false),
     StateVector(0),
     StateVectorDataNames(0),
     Ticks(size, mtsStateIndex::TimeTicksType(0)),
@@ -52,13 +55,16 @@ mtsStateTable::mtsStateTable(size_t size, const std::string & name):
     Period(0.0),
     SumOfPeriods(0.0),
     AveragePeriod(0.0),
-    Name(name)
+    Name(name),
+    FlightRecorder(0),
+    FlightRecorderUsers(0)
 {
     // make sure history length is at least 3
     if (this->HistoryLength < 3) {
         CMN_LOG_CLASS_INIT_VERBOSE << "constructor: history lenght sets to 3 (minimum required)" << std::endl;
         this->HistoryLength = 3;
     }
+    std::vector<std::atomic<unsigned int> >(this->HistoryLength).swap(RowSequences);
 
     // set the default number of elements for data collection batch
     this->DataCollection.BatchSize = this->HistoryLength / 3;
@@ -85,6 +91,7 @@ mtsStateTable::mtsStateTable(size_t size, const std::string & name):
 
 mtsStateTable::~mtsStateTable()
 {
+    this->FlightRecorderDisable();
 }
 
 bool mtsStateTable::SetSize(const size_t size){
@@ -93,6 +100,8 @@ bool mtsStateTable::SetSize(const size_t size){
     }
 
     this->HistoryLength = size;
+    std::vector<std::atomic<unsigned int> >(this->HistoryLength).swap(RowSequences);
+    this->Ticks.resize(this->HistoryLength, mtsStateIndex::TimeTicksType(0));
 
     for (unsigned int j = 0; j < StateVector.size(); j++)  {
         if (StateVector[j]) {
@@ -115,6 +124,55 @@ mtsStateIndex mtsStateTable::GetIndexDelayed(void) const {
     return mtsStateIndex(this->Tic, static_cast<int>(tmp), Ticks[tmp], static_cast<int>(HistoryLength));
 }
 
+bool mtsStateTable::GetSnapshot(const mtsStateIndex & timeIndex,
+                                const std::vector<mtsStateDataId> & ids,
+                                const std::vector<mtsGenericObject *> & data) const
+{
+    if (ids.size() != data.size()) {
+        CMN_LOG_CLASS_RUN_ERROR << "GetSnapshot: number of ids (" << ids.size()
+                                << ") and data objects (" << data.size() << ") don't match" << std::endl;
+        return false;
+    }
+    const size_t index = static_cast<size_t>(timeIndex.Index());
+    if (index >= RowSequences.size()) {
+        return false;
+    }
+    const unsigned int sequence = ReadBegin(timeIndex);
+    // row currently written, data requested is already lost
+    if ((sequence & 1) || !ValidateReadIndex(timeIndex)) {
+        return false;
+    }
+    const size_t numberOfElements = StateVector.size();
+    for (size_t i = 0; i < ids.size(); ++i) {
+        if ((ids[i] < 0)
+            || (static_cast<size_t>(ids[i]) >= numberOfElements)
+            || !StateVector[ids[i]]
+            || !data[i]) {
+            CMN_LOG_CLASS_RUN_ERROR << "GetSnapshot: invalid id or data object for element " << i << std::endl;
+            return false;
+        }
+        if (!StateVector[ids[i]]->Get(index, *(data[i]))) {
+            return false;
+        }
+    }
+    return ReadEnd(timeIndex, sequence);
+}
+
+
+bool mtsStateTable::GetLatestSnapshot(const std::vector<mtsStateDataId> & ids,
+                                      const std::vector<mtsGenericObject *> & data,
+                                      mtsStateIndex & timeIndex) const
+{
+    for (size_t attempt = 0; attempt < SNAPSHOT_MAXIMUM_ATTEMPTS; ++attempt) {
+        timeIndex = GetIndexReader();
+        if (GetSnapshot(timeIndex, ids, data)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+
 size_t mtsStateTable::SetDelay(size_t newDelay) {
     size_t currentDelay = this->Delay;
     this->Delay = newDelay;
@@ -187,6 +245,15 @@ void mtsStateTable::StartIfAutomatic(void) {
 }
 
 
+void mtsStateTable::ReplayStart(const double tic) {
+    this->ReplayTimeFlag = true;
+    mtsDouble oldTic;
+    StateVector[TicId]->Get(IndexReader, oldTic);
+    Tic = tic;
+    Period = (Ticks[IndexWriter] > 0) ? (Tic - oldTic) : 0.0;
+}
+
+
 void mtsStateTable::Advance(void) {
     size_t i;
     size_t tmpIndex;
@@ -220,6 +287,12 @@ void mtsStateTable::Advance(void) {
     */
     tmpIndex = IndexWriter;
 
+    // mark the row as being written, readers will detect the change
+    // of sequence
+    const unsigned int sequence = RowSequences[tmpIndex].load(std::memory_order_relaxed);
+    RowSequences[tmpIndex].store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
     // Write data in the state table from the different state data objects.
     // Note that we start at TicId, which should correspond to the second
     // element in the array (after Toc).
@@ -292,7 +365,9 @@ void mtsStateTable::Advance(void) {
     }
 
     // Get the Toc value and write it to the state table.
-    if (TimeServer) {
+    if (ReplayTimeFlag) {
+        Toc = Tic;
+    } else if (TimeServer) {
         Toc = TimeServer->GetRelativeTime(); // in seconds
     }
 
@@ -300,6 +375,8 @@ void mtsStateTable::Advance(void) {
     PeriodStats.Update(Period.Data, this->Toc - this->Tic);
 
     Write(TocId, Toc);
+    // row is complete
+    RowSequences[tmpIndex].store(sequence + 2, std::memory_order_release);
     // now increment the IndexWriter and set its Tick value
     IndexWriter = newIndexWriter;
     Ticks[IndexWriter] = Ticks[tmpIndex] + 1;
@@ -310,6 +387,15 @@ void mtsStateTable::Advance(void) {
     if (IndexReader > Delay) {
         IndexDelayed = IndexReader - Delay;
     }
+
+    // flight recorder only checks for trigger and end of capture,
+    // FlightRecorderDisable waits until it is not used anymore
+    FlightRecorderUsers.fetch_add(1);
+    mtsStateTableFlightRecorder * flightRecorder = FlightRecorder.load();
+    if (flightRecorder) {
+        flightRecorder->Update();
+    }
+    FlightRecorderUsers.fetch_sub(1, std::memory_order_release);
 }
 
 
@@ -387,13 +473,15 @@ void mtsStateTable::Debug(std::ostream & out, unsigned int * listColumn, unsigne
     }
     out << std::endl;
 
+    std::vector<mtsGenericObject *> buffers;
+    CreateElementBuffers(buffers);
     for (i = 0; i < HistoryLength; i++) {
         out << i << " ";
         out << Ticks[i] << " ";
         for (j = 0; j < number; j++) {
-            if (listColumn[j] < StateVector.size() && StateVector[listColumn[j]]) {
+            if (listColumn[j] < StateVector.size() && buffers[listColumn[j]]) {
                 out << " [" << listColumn[j] << "] "
-                    <<(*StateVector[listColumn[j]])[i] << " : ";
+                    << StateVector[listColumn[j]]->Element(i, *(buffers[listColumn[j]])) << " : ";
             }
         }
         if (i == IndexReader) {
@@ -404,6 +492,27 @@ void mtsStateTable::Debug(std::ostream & out, unsigned int * listColumn, unsigne
         }
         out << std::endl;
     }
+    DeleteElementBuffers(buffers);
+}
+
+
+void mtsStateTable::CreateElementBuffers(std::vector<mtsGenericObject *> & buffers) const
+{
+    buffers.resize(StateVector.size(), 0);
+    for (size_t j = 0; j < StateVector.size(); j++) {
+        if (StateVector[j]) {
+            buffers[j] = StateVector[j]->CreateElement();
+        }
+    }
+}
+
+
+void mtsStateTable::DeleteElementBuffers(std::vector<mtsGenericObject *> & buffers) const
+{
+    for (size_t j = 0; j < buffers.size(); j++) {
+        delete buffers[j];
+    }
+    buffers.clear();
 }
 
 // This method is to dump the state data table in the csv format, allowing easy import into matlab.
@@ -413,37 +522,43 @@ void mtsStateTable::Debug(std::ostream & out, unsigned int * listColumn, unsigne
 // value i.e, those rows that have been written to at least once.
 void mtsStateTable::CSVWrite(std::ostream& out, bool nonZeroOnly) {
     unsigned int i;
+    std::vector<mtsGenericObject *> buffers;
+    CreateElementBuffers(buffers);
     for (i = 0; i < HistoryLength; i++) {
         bool toSave = true;
         if (nonZeroOnly && Ticks[i] ==0) toSave = false;
         if (toSave) {
             out << i << " " << Ticks[i] << " ";
             for (unsigned int j = 0; j < StateVector.size(); j++)  {
-                if (StateVector[j]) {
-                    out << (*StateVector[j])[i] << " ";
+                if (buffers[j]) {
+                    out << StateVector[j]->Element(i, *(buffers[j])) << " ";
                 }
             }
             out << std::endl;
         }
     }
+    DeleteElementBuffers(buffers);
 }
 
 void mtsStateTable::CSVWrite(std::ostream& out, unsigned int *listColumn, unsigned int number, bool nonZeroOnly) {
     unsigned int i, j;
 
+    std::vector<mtsGenericObject *> buffers;
+    CreateElementBuffers(buffers);
     for (i = 0; i < HistoryLength; i++) {
         bool toSave = true;
         if (nonZeroOnly && Ticks[i] ==0) toSave = false;
         if (toSave) {
             out << i << " " << Ticks[i] << " ";
             for (j = 0; j < number; j++) {
-                if (listColumn[j] < StateVector.size() && StateVector[listColumn[j]]) {
-                    out << (*StateVector[listColumn[j]])[i] << " ";
+                if (listColumn[j] < StateVector.size() && buffers[listColumn[j]]) {
+                    out << StateVector[listColumn[j]]->Element(i, *(buffers[listColumn[j]])) << " ";
                 }
             }
             out << std::endl;
         }
     }
+    DeleteElementBuffers(buffers);
 }
 
 void mtsStateTable::CSVWrite(std::ostream& out, mtsGenericObject ** listColumn, unsigned int number, bool nonZeroOnly)
@@ -549,3 +664,67 @@ void mtsStateTable::DataCollectionStop(const mtsDouble & delay)
         }
     }
 }
+
+
+bool mtsStateTable::FlightRecorderEnable(const double preTriggerDuration,
+                                         const double postTriggerDuration,
+                                         const double expectedPeriod,
+                                         const std::string & filePrefix)
+{
+    if ((expectedPeriod <= 0.0) || (preTriggerDuration < 0.0) || (postTriggerDuration < 0.0)) {
+        CMN_LOG_CLASS_INIT_ERROR << "FlightRecorderEnable: invalid durations or period for state table \""
+                                 << this->GetName() << "\"" << std::endl;
+        return false;
+    }
+    this->FlightRecorderDisable();
+
+    // number of rows for each window with some extra rows for jitter
+    const size_t preTriggerRows = static_cast<size_t>(1.1 * preTriggerDuration / expectedPeriod) + 2;
+    const size_t postTriggerRows = static_cast<size_t>(1.1 * postTriggerDuration / expectedPeriod) + 2;
+    // margin used by the dump thread to copy the oldest rows
+    size_t marginRows = preTriggerRows / 2;
+    if (marginRows < 16) {
+        marginRows = 16;
+    }
+    const size_t size = preTriggerRows + postTriggerRows + marginRows;
+    if (size > this->HistoryLength) {
+        CMN_LOG_CLASS_INIT_VERBOSE << "FlightRecorderEnable: resizing state table \"" << this->GetName()
+                                   << "\" from " << this->HistoryLength << " to " << size << " rows" << std::endl;
+        this->SetSize(size);
+    }
+
+    const std::string prefix = filePrefix.empty() ? ("FlightRecorder-" + this->GetName()) : filePrefix;
+    this->FlightRecorder.store(new mtsStateTableFlightRecorder(*this, preTriggerDuration, postTriggerDuration,
+                                                               preTriggerRows, prefix),
+                               std::memory_order_release);
+    return true;
+}
+
+
+void mtsStateTable::FlightRecorderDisable(void)
+{
+    mtsStateTableFlightRecorder * flightRecorder = this->FlightRecorder.exchange(0);
+    if (flightRecorder) {
+        // Advance or FlightRecorderTrigger might still use the old
+        // pointer, they hold a user count while doing so
+        while (this->FlightRecorderUsers.load(std::memory_order_acquire) != 0) {
+            osaSleep(10.0 * cmn_us);
+        }
+        delete flightRecorder;
+    }
+}
+
+
+void mtsStateTable::FlightRecorderTrigger(void)
+{
+    this->FlightRecorderUsers.fetch_add(1);
+    mtsStateTableFlightRecorder * flightRecorder = this->FlightRecorder.load();
+    if (flightRecorder) {
+        flightRecorder->Trigger();
+    } else {
+        // can be called periodically by other components, don't flood the log
+        CMN_LOG_CLASS_RUN_VERBOSE << "FlightRecorderTrigger: flight recorder not enabled for state table \""
+                                  << this->GetName() << "\"" << std::endl;
+    }
+    this->FlightRecorderUsers.fetch_sub(1, std::memory_order_release);
+}
@@ -0,0 +1,228 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstCommon/cmnLogger.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstOSAbstraction/osaTimeServer.h>
+#include <cisstMultiTask/mtsStateTableFlightRecorder.h>
+#include <cisstMultiTask/mtsStateTable.h>
+#include <cisstMultiTask/mtsCollectorColumnarWriter.h>
+
+#include <sstream>
+
+
+mtsStateTableFlightRecorder::mtsStateTableFlightRecorder(mtsStateTable & table,
+                                                         const double preTriggerDuration,
+                                                         const double postTriggerDuration,
+                                                         const size_t preTriggerRows,
+                                                         const std::string & filePrefix):
+    Table(table),
+    PreTriggerDuration(preTriggerDuration),
+    PostTriggerDuration(postTriggerDuration),
+    FilePrefix(filePrefix),
+    TriggerRequested(false),
+    State(IDLE),
+    TriggerTicks(0),
+    TriggerTime(0.0),
+    PreTriggerRows(preTriggerRows),
+    FirstTicks(0),
+    LastTicks(0),
+    NumberOfDumps(0),
+    NumberOfTriggersIgnored(0),
+    NumberOfDumpsTruncated(0),
+    StopRequested(false)
+{
+    this->Thread.Create<mtsStateTableFlightRecorder, int>(this, &mtsStateTableFlightRecorder::DumpThread,
+                                                          0, "FlightRec");
+}
+
+
+mtsStateTableFlightRecorder::~mtsStateTableFlightRecorder()
+{
+    this->StopRequested = true;
+    this->DumpSignal.Raise();
+    this->Thread.Wait();
+}
+
+
+void mtsStateTableFlightRecorder::Trigger(void)
+{
+    if (this->State.load(std::memory_order_acquire) != IDLE) {
+        this->NumberOfTriggersIgnored++;
+        return;
+    }
+    this->TriggerRequested.store(true, std::memory_order_release);
+}
+
+
+void mtsStateTableFlightRecorder::Update(void)
+{
+    const int state = this->State.load(std::memory_order_acquire);
+    if (state == IDLE) {
+        if (this->TriggerRequested.load(std::memory_order_relaxed)
+            && this->TriggerRequested.exchange(false, std::memory_order_acq_rel)) {
+            this->TriggerTicks = this->Table.Ticks[this->Table.IndexReader];
+            this->TriggerTime = this->Table.Tic.Data;
+            this->State.store(TRIGGERED, std::memory_order_release);
+        }
+    } else if (state == TRIGGERED) {
+        if (this->Table.Tic.Data >= this->TriggerTime + this->PostTriggerDuration) {
+            this->LastTicks = this->Table.Ticks[this->Table.IndexReader];
+            this->FirstTicks = (this->TriggerTicks > this->PreTriggerRows) ? (this->TriggerTicks - this->PreTriggerRows) : 0;
+            // oldest row still available, the row after the last one is being written
+            const size_t historyLength = this->Table.HistoryLength;
+            if (this->LastTicks - this->FirstTicks + 2 > historyLength) {
+                this->FirstTicks = this->LastTicks + 2 - historyLength;
+            }
+            this->State.store(DUMPING, std::memory_order_release);
+            this->DumpSignal.Raise();
+        }
+    }
+}
+
+
+bool mtsStateTableFlightRecorder::WaitForIdle(const double timeout)
+{
+    const double end = osaGetTime() + timeout;
+    while (this->GetState() != IDLE) {
+        const double remaining = end - osaGetTime();
+        if (remaining <= 0.0) {
+            return false;
+        }
+        this->DumpDoneSignal.Wait(remaining);
+    }
+    return true;
+}
+
+
+std::string mtsStateTableFlightRecorder::GetLastFileName(void) const
+{
+    this->LastFileNameMutex.Lock();
+    const std::string result = this->LastFileName;
+    this->LastFileNameMutex.Unlock();
+    return result;
+}
+
+
+void * mtsStateTableFlightRecorder::DumpThread(int CMN_UNUSED(data))
+{
+    while (!this->StopRequested) {
+        this->DumpSignal.Wait();
+        if (this->State.load(std::memory_order_acquire) == DUMPING) {
+            this->Dump(this->FirstTicks, this->LastTicks);
+            this->State.store(IDLE, std::memory_order_release);
+            this->DumpDoneSignal.Raise();
+        }
+    }
+    return 0;
+}
+
+
+bool mtsStateTableFlightRecorder::Dump(const TimeTicksType firstTicks, const TimeTicksType lastTicks)
+{
+    mtsStateTable & table = this->Table;
+    const size_t historyLength = table.HistoryLength;
+    const size_t numberOfColumns = table.StateVector.size();
+
+    // objects used to copy rows, columns without dynamic creation are skipped
+    std::vector<mtsGenericObject *> rowData(numberOfColumns, 0);
+    std::vector<std::string> names, classNames;
+    for (size_t column = 0; column < numberOfColumns; ++column) {
+        const cmnClassServicesBase * services = table.StateVector[column]->GetDataClassServices();
+        if (services) {
+            rowData[column] = dynamic_cast<mtsGenericObject *>(services->Create());
+        }
+        if (rowData[column]) {
+            names.push_back(table.StateVectorDataNames[column]);
+            classNames.push_back(services->GetName());
+        } else {
+            CMN_LOG_RUN_WARNING << "mtsStateTableFlightRecorder::Dump: can't create object for \""
+                                << table.StateVectorDataNames[column] << "\" in state table \""
+                                << table.GetName() << "\", column will not be saved" << std::endl;
+        }
+    }
+
+    std::string dateTime;
+    osaGetDateTimeString(dateTime);
+    std::stringstream fileName;
+    fileName << this->FilePrefix << "-" << dateTime << "-" << this->NumberOfDumps.load() << ".ccol";
+    osaAbsoluteTime origin;
+    if (table.TimeServer) {
+        table.TimeServer->GetTimeOrigin(origin);
+    }
+
+    mtsCollectorColumnarWriter writer;
+    bool result = writer.Open(fileName.str(), "", table.GetName(), dateTime, origin.ToSeconds(),
+                              names, classNames);
+    size_t rowsLost = 0;
+    if (result) {
+        const double startTime = this->TriggerTime - this->PreTriggerDuration;
+        mtsDouble * tic = dynamic_cast<mtsDouble *>(rowData[table.TicId]);
+        for (TimeTicksType ticks = firstTicks; ticks <= lastTicks; ++ticks) {
+            const mtsStateIndex timeIndex(0.0, static_cast<int>(ticks % historyLength), ticks,
+                                          static_cast<int>(historyLength));
+            const unsigned int sequence = table.ReadBegin(timeIndex);
+            if ((sequence & 1) || !table.ValidateReadIndex(timeIndex)) {
+                ++rowsLost;
+                continue;
+            }
+            for (size_t column = 0; column < numberOfColumns; ++column) {
+                if (rowData[column]) {
+                    table.StateVector[column]->Get(timeIndex.Index(), *(rowData[column]));
+                }
+            }
+            if (!table.ReadEnd(timeIndex, sequence)) {
+                ++rowsLost;
+                continue;
+            }
+            if (tic && (tic->Data < startTime)) {
+                continue;
+            }
+            writer.BeginRow(ticks, tic ? tic->Data : 0.0);
+            for (size_t column = 0; column < numberOfColumns; ++column) {
+                if (rowData[column]) {
+                    writer.AddElement(*(rowData[column]));
+                }
+            }
+            writer.EndRow();
+        }
+        result = writer.Close();
+    }
+    for (size_t column = 0; column < numberOfColumns; ++column) {
+        delete rowData[column];
+    }
+
+    if (rowsLost > 0) {
+        this->NumberOfDumpsTruncated++;
+        CMN_LOG_RUN_WARNING << "mtsStateTableFlightRecorder::Dump: " << rowsLost
+                            << " row(s) overwritten before they could be saved for state table \""
+                            << table.GetName() << "\", consider increasing the table size" << std::endl;
+    }
+    if (result) {
+        CMN_LOG_RUN_VERBOSE << "mtsStateTableFlightRecorder::Dump: saved " << writer.GetNumberOfRows()
+                            << " row(s) from state table \"" << table.GetName() << "\" in \""
+                            << fileName.str() << "\"" << std::endl;
+        this->LastFileNameMutex.Lock();
+        this->LastFileName = fileName.str();
+        this->LastFileNameMutex.Unlock();
+        this->NumberOfDumps++;
+    } else {
+        CMN_LOG_RUN_ERROR << "mtsStateTableFlightRecorder::Dump: failed to save \""
+                          << fileName.str() << "\" for state table \"" << table.GetName() << "\"" << std::endl;
+    }
+    return result;
+}
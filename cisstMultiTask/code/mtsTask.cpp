@@ -6,7 +6,7 @@
   Author(s):  Ankur Kapoor, Peter Kazanzides, Min Yang Jung
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2013 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
   --- begin cisst license - do not edit ---
 
@@ -19,6 +19,7 @@
 
 #include <cisstCommon/cmnExport.h>
 #include <cisstCommon/cmnPortability.h>
+#include <cisstOSAbstraction/osaAllocationMonitor.h>
 #include <cisstOSAbstraction/osaThread.h>
 #include <cisstOSAbstraction/osaSleep.h>
 #include <cisstOSAbstraction/osaGetTime.h>
@@ -27,6 +28,7 @@
 #include <cisstMultiTask/mtsInterfaceRequired.h>
 #include <cisstMultiTask/mtsInterfaceProvided.h>
 #include <cisstMultiTask/mtsManagerComponentBase.h>
+#include <cisstMultiTask/mtsMailBoxReadyList.h>
 
 #include <iostream>
 
@@ -43,6 +45,8 @@ void mtsTask::DoRunInternal(void)
         // Make sure following is called
         if (InterfaceProvidedToManager)
             InterfaceProvidedToManager->ProcessMailBoxes();
+        // only Run is monitored, End is called when leaving this scope
+        osaAllocationMonitor::Section allocationSection(AllocationMonitor);
         this->Run();
     }
     catch (const std::exception &excp) {
@@ -67,6 +71,12 @@ void mtsTask::RunEventHandler(void)
     }
     else if (this->State == mtsComponentState::ACTIVE)
         DoRunInternal();
+    else if (this->State == mtsComponentState::FINISHING) {
+        // Same as end of RunInternal, cleanup in the thread running the task
+        CMN_LOG_CLASS_RUN_VERBOSE << "RunEventHandler: end of task " << this->GetName() << std::endl;
+        RunEvent();
+        CleanupInternal();
+    }
     else
         RunEvent();
 }
@@ -167,6 +177,12 @@ void mtsTask::CleanupInternal() {
     // Call user-supplied cleanup function
     this->Cleanup();
 
+    // Report allocations performed in Run
+    if (AllocationMonitor && (AllocationMonitor->GetNumberOfSectionsWithAllocations() != 0)) {
+        CMN_LOG_CLASS_INIT_WARNING << "CleanupInternal: heap allocations in Run for task \""
+                                   << this->GetName() << "\", " << *AllocationMonitor << std::endl;
+    }
+
     // Kill each state table
     StateTables.ForEachVoid(&mtsStateTable::Cleanup);
 
@@ -296,6 +312,8 @@ mtsTask::mtsTask(const std::string & name,
     OverranPeriod(false),
     ThreadStartData(0),
     ReturnValue(0),
+    ExecutionContext(0),
+    AllocationMonitor(0),
     RunEventCalled(false)
 {
     this->AddStateTable(&this->StateTable);
@@ -329,6 +347,10 @@ mtsTask::~mtsTask()
         //Should we call the user-supplied Cleanup()?
         CleanupInternal();
     }
+    if (AllocationMonitor) {
+        delete AllocationMonitor;
+        AllocationMonitor = 0;
+    }
 }
 
 
@@ -379,6 +401,9 @@ mtsInterfaceProvided * mtsTask::AddInterfaceProvidedWithoutSystemEvents(const st
         if (interfaceProvidedName == mtsManagerComponentBase::GetNameOfInterfaceInternalProvided())
             postCommandQueuedCallable = InterfaceProvidedToManagerCallable;
         interfaceProvided = new mtsInterfaceProvided(interfaceProvidedName, this, MTS_COMMANDS_SHOULD_BE_QUEUED, postCommandQueuedCallable, isProxy);
+        if (this->MailBoxReadyList && !postCommandQueuedCallable) {
+            interfaceProvided->SetMailBoxReadyList(this->MailBoxReadyList);
+        }
     } else {
         CMN_LOG_CLASS_INIT_WARNING << "AddInterfaceProvided: adding provided interface \"" << interfaceProvidedName
                                    << "\" with policy MTS_COMMANDS_SHOULD_NOT_BE_QUEUED to task \""
@@ -388,6 +413,7 @@ mtsInterfaceProvided * mtsTask::AddInterfaceProvidedWithoutSystemEvents(const st
     }
     if (interfaceProvided) {
         if (InterfacesProvided.AddItem(interfaceProvidedName, interfaceProvided)) {
+            InterfacesRevision++;
             return interfaceProvided;
         }
         CMN_LOG_CLASS_INIT_ERROR << "AddInterfaceProvided: task " << this->GetName() << " unable to add interface \""
@@ -401,6 +427,39 @@ mtsInterfaceProvided * mtsTask::AddInterfaceProvidedWithoutSystemEvents(const st
 }
 
 
+void mtsTask::EnableMailBoxReadyList(void)
+{
+    if (this->MailBoxReadyList) {
+        return;
+    }
+    this->MailBoxReadyList = new mtsMailBoxReadyList(this->GetName() + "ReadyList");
+    // update existing provided interfaces
+    InterfacesProvidedMapType::iterator iterator = InterfacesProvided.begin();
+    const InterfacesProvidedMapType::iterator end = InterfacesProvided.end();
+    for (; iterator != end; ++iterator) {
+        if ((iterator->second != InterfaceProvidedToManager)
+            && (iterator->second->GetMailBoxSize() != 0)) {
+            iterator->second->SetMailBoxReadyList(this->MailBoxReadyList);
+        }
+    }
+    CMN_LOG_CLASS_INIT_VERBOSE << "EnableMailBoxReadyList: task \"" << this->GetName()
+                               << "\" now uses a single ready list for queued commands" << std::endl;
+}
+
+
+void mtsTask::EnableAllocationMonitor(void)
+{
+    if (this->AllocationMonitor) {
+        return;
+    }
+    this->AllocationMonitor = new osaAllocationMonitor(this->GetName() + "Run");
+    if (!osaAllocationMonitor::IsAvailable()) {
+        CMN_LOG_CLASS_INIT_WARNING << "EnableAllocationMonitor: task \"" << this->GetName()
+                                   << "\", allocations can't be detected, cisst must be compiled with CISST_OSA_ALLOCATION_MONITOR" << std::endl;
+    }
+}
+
+
 /********************* Methods for task synchronization ***************/
 
 bool mtsTask::WaitToStart(double timeout)
@@ -456,6 +515,23 @@ bool mtsTask::CheckForOwnThread(void) const
 }
 
 
+const void * mtsTask::GetExecutionContext(void) const
+{
+    // task using the thread of another task
+    if (ExecIn) {
+        const mtsInterfaceProvided * execOut = ExecIn->GetConnectedInterface();
+        if (execOut && execOut->GetComponent()) {
+            return execOut->GetComponent()->GetExecutionContext();
+        }
+    }
+    if (ExecutionContext) {
+        return ExecutionContext;
+    }
+    // task with its own thread
+    return this;
+}
+
+
 void mtsTask::OnStartupException(const std::exception &excp)
 {
     CMN_LOG_CLASS_RUN_WARNING << "Task " << this->GetName() << " caught startup exception: " << excp.what() << std::endl;
@@ -5,7 +5,7 @@
   Author(s):  Peter Kazanzides
   Created on: 2008-09-23
 
-  (C) Copyright 2008-2017 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2008-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -19,6 +19,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstMultiTask/mtsTaskContinuous.h>
 #include <cisstMultiTask/mtsInterfaceRequired.h>
 #include <cisstMultiTask/mtsInterfaceProvided.h>
+#include <cisstMultiTask/mtsCommandTracer.h>
 #include <cisstCommon/cmnUnits.h>
 
 
@@ -33,6 +34,7 @@ void * mtsTaskContinuous::RunInternal(void *data)
 
     if (this->State == mtsComponentState::INITIALIZING) {
         SaveThreadStartData(data);
+        mtsCommandTracer::SetThreadName(this->GetName());
         this->StartupInternal();
         if (CaptureThread)
             return 0;
@@ -5,7 +5,7 @@
   Author(s):  Anton Deguet
   Created on: 2009-12-10
 
-  (C) Copyright 2009-2017 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -20,8 +20,10 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstMultiTask/mtsTaskFromSignal.h>
 #include <cisstMultiTask/mtsInterfaceRequired.h>
 #include <cisstMultiTask/mtsInterfaceProvided.h>
+#include <cisstMultiTask/mtsMailBoxReadyList.h>
 #include <cisstMultiTask/mtsCommandVoid.h>
 #include <cisstMultiTask/mtsManagerComponentBase.h>
+#include <cisstMultiTask/mtsCommandTracer.h>
 
 
 mtsTaskFromSignal::mtsTaskFromSignal(const std::string & name,
@@ -67,6 +69,7 @@ void * mtsTaskFromSignal::RunInternal(void * CMN_UNUSED(data)) {
 
     CMN_LOG_CLASS_INIT_VERBOSE << "RunInternal: begin task " << this->GetName() << std::endl;
     if (this->State == mtsComponentState::INITIALIZING) {
+        mtsCommandTracer::SetThreadName(this->GetName());
         this->StartupInternal();
     }
 
@@ -138,6 +141,9 @@ mtsInterfaceProvided * mtsTaskFromSignal::AddInterfaceProvidedWithoutSystemEvent
         if (interfaceProvidedName == mtsManagerComponentBase::GetNameOfInterfaceInternalProvided())
             postCommandQueuedCallable = InterfaceProvidedToManagerCallable;
         interfaceProvided = new mtsInterfaceProvided(interfaceProvidedName, this, MTS_COMMANDS_SHOULD_BE_QUEUED, postCommandQueuedCallable, isProxy);
+        if (this->MailBoxReadyList && (postCommandQueuedCallable == this->PostCommandQueuedCallable)) {
+            interfaceProvided->SetMailBoxReadyList(this->MailBoxReadyList);
+        }
     } else {
         CMN_LOG_CLASS_INIT_WARNING << "AddInterfaceProvided: adding provided interface \"" << interfaceProvidedName
                                    << "\" with policy MTS_COMMANDS_SHOULD_NOT_BE_QUEUED to task \""
@@ -148,6 +154,7 @@ mtsInterfaceProvided * mtsTaskFromSignal::AddInterfaceProvidedWithoutSystemEvent
     }
     if (interfaceProvided) {
         if (InterfacesProvided.AddItem(interfaceProvidedName, interfaceProvided)) {
+            InterfacesRevision++;
             return interfaceProvided;
         }
         CMN_LOG_CLASS_INIT_ERROR << "AddInterfaceProvided: task \"" << this->GetName() << "\" unable to add interface \""
@@ -159,3 +166,10 @@ mtsInterfaceProvided * mtsTaskFromSignal::AddInterfaceProvidedWithoutSystemEvent
                              << interfaceProvidedName << "\"" << std::endl;
     return 0;
 }
+
+
+void mtsTaskFromSignal::EnableMailBoxReadyList(void)
+{
+    BaseType::EnableMailBoxReadyList();
+    this->MailBoxReadyList->SetDoorBellCallable(this->PostCommandQueuedCallable);
+}
@@ -5,7 +5,7 @@
   Author(s):  Ankur Kapoor, Peter Kazanzides
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2017 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -17,8 +17,10 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 #include <cisstMultiTask/mtsTaskPeriodic.h>
+#include <cisstMultiTask/mtsTaskPeriodicExecutor.h>
 #include <cisstMultiTask/mtsInterfaceRequired.h>
 #include <cisstMultiTask/mtsInterfaceProvided.h>
+#include <cisstMultiTask/mtsCommandTracer.h>
 #include <cisstCommon/cmnUnits.h>
 #include <cisstOSAbstraction/osaThreadBuddy.h>
 #include <cisstOSAbstraction/osaSleep.h>
@@ -35,6 +37,7 @@ void * mtsTaskPeriodic::RunInternal(void *data)
 
     if (this->State == mtsComponentState::INITIALIZING) {
         SaveThreadStartData(data);
+        mtsCommandTracer::SetThreadName(this->GetName());
         this->StartupInternal();
         if (CaptureThread) {
             return 0;
@@ -57,8 +60,29 @@ void * mtsTaskPeriodic::RunInternal(void *data)
     return this->ReturnValue;
 }
 
+void mtsTaskPeriodic::RunFromExecutor(void)
+{
+    if (this->State == mtsComponentState::INITIALIZING) {
+        this->StartupInternal();
+    } else if (this->State == mtsComponentState::ACTIVE) {
+        DoRunInternal();
+        if (StateTable.GetToc() - StateTable.GetTic() > Period) {
+            OverranPeriod = true;
+        }
+    }
+    if (this->State == mtsComponentState::FINISHING) {
+        CMN_LOG_CLASS_RUN_VERBOSE << "RunFromExecutor: end of task " << Name << std::endl;
+        CleanupInternal();
+    }
+}
+
 void mtsTaskPeriodic::StartupInternal(void) {
     CMN_LOG_CLASS_INIT_VERBOSE << "Starting StartupInternal (periodic) for " << Name << std::endl;
+    if (Executor) {
+        // the executor's thread calls Run, nothing to setup
+        BaseType::StartupInternal();
+        return;
+    }
     // user defined initialization, find commands from associated resource interfaces
     ThreadBuddy.Create(GetName().c_str(), AbsoluteTimePeriod); // convert to nano seconds
 
@@ -81,12 +105,23 @@ void mtsTaskPeriodic::StartupInternal(void) {
 
 
 void mtsTaskPeriodic::CleanupInternal() {
+    if (Executor) {
+        BaseType::CleanupInternal();
+        return;
+    }
 
     if (IsHardRealTime) {
         ThreadBuddy.MakeSoftRealTime();
     }
     ThreadBuddy.UnlockStack();
 
+    if (ThreadBuddy.GetNumberOfOverruns() > 0) {
+        CMN_LOG_CLASS_RUN_WARNING << "CleanupInternal: task " << Name << " missed "
+                                  << ThreadBuddy.GetNumberOfOverruns() << " deadline(s), skipped "
+                                  << ThreadBuddy.GetNumberOfSkippedPeriods() << " period(s), maximum lateness "
+                                  << ThreadBuddy.GetMaximumLateness() * 1000.0 << " ms" << std::endl;
+    }
+
     //If the task was waiting on a queue, i.e. semaphore, mailbox,
     //etc, it is removed from such a queue and messaging tasks
     //pending on its message queue are unblocked with an error return.
@@ -97,7 +132,10 @@ void mtsTaskPeriodic::CleanupInternal() {
 
 void mtsTaskPeriodic::StartInternal(void)
 {
-    ThreadBuddy.Resume();
+    // with an executor, the state is checked at each period
+    if (!Executor) {
+        ThreadBuddy.Resume();
+    }
 }
 
 /********************* Task constructor and destructor *****************/
@@ -108,7 +146,10 @@ mtsTaskPeriodic::mtsTaskPeriodic(const std::string & name, double periodicityInS
     mtsTaskContinuous(name, sizeStateTable, newThread),
     ThreadBuddy(),
     Period(periodicityInSeconds),
-    IsHardRealTime(isHardRealTime)
+    IsHardRealTime(isHardRealTime),
+    Executor(0),
+    ExecutorNumberOfOverruns(0),
+    ExecutorNumberOfSkippedPeriods(0)
 {
     AbsoluteTimePeriod.FromSeconds(periodicityInSeconds);
     CMN_ASSERT(GetPeriodicity() > 0);
@@ -123,7 +164,10 @@ mtsTaskPeriodic::mtsTaskPeriodic( const std::string & name,
     ThreadBuddy(),
     Period(period.ToSeconds()),
     AbsoluteTimePeriod(period),
-    IsHardRealTime(isHardRealTime)
+    IsHardRealTime(isHardRealTime),
+    Executor(0),
+    ExecutorNumberOfOverruns(0),
+    ExecutorNumberOfSkippedPeriods(0)
 {
     CMN_ASSERT(GetPeriodicity() > 0);
 }
@@ -132,7 +176,10 @@ mtsTaskPeriodic::mtsTaskPeriodic(const mtsTaskPeriodicConstructorArg &arg):
     mtsTaskContinuous(arg.Name, arg.StateTableSize, true),
     ThreadBuddy(),
     Period(arg.Period),
-    IsHardRealTime(arg.IsHardRealTime)
+    IsHardRealTime(arg.IsHardRealTime),
+    Executor(0),
+    ExecutorNumberOfOverruns(0),
+    ExecutorNumberOfSkippedPeriods(0)
 {
     AbsoluteTimePeriod.FromSeconds(arg.Period);
     CMN_ASSERT(GetPeriodicity() > 0);
@@ -145,6 +192,11 @@ mtsTaskPeriodic::~mtsTaskPeriodic() {
     //pending on its message queue are unblocked with an error return.
 
     Kill();
+    if (Executor) {
+        // make sure the executor doesn't use this task anymore
+        WaitToTerminate(1.0 * cmn_s);
+        Executor->RemoveTask(this);
+    }
     // adeguet1, is this sleep still necessary?
     // Now, wait for 2 periods to see if it was killed
     // osaSleep(2.0 * this->PeriodInSeconds); // all expressed in seconds
@@ -153,11 +205,34 @@ mtsTaskPeriodic::~mtsTaskPeriodic() {
 
 /********************* Methods to change task state ******************/
 
+void mtsTaskPeriodic::Create(void * data)
+{
+    if (!Executor) {
+        BaseType::Create(data);
+        return;
+    }
+    if (this->State != mtsComponentState::CONSTRUCTED) {
+        CMN_LOG_CLASS_INIT_VERBOSE << "Create: task " << this->GetName() << " cannot be created, state = "
+                                   << this->State << std::endl;
+        return;
+    }
+    // executor provides the thread
+    RemoveInterfaceRequired("ExecIn", true);
+    ExecIn = 0;
+    CMN_LOG_CLASS_INIT_VERBOSE << "Create: task " << this->GetName() << " will use executor "
+                               << Executor->GetName() << std::endl;
+    SaveThreadStartData(data);
+    ChangeState(mtsComponentState::INITIALIZING);
+    Executor->Schedule(this);
+}
+
 void mtsTaskPeriodic::Suspend(void)
 {
     if (this->State == mtsComponentState::ACTIVE) {
         BaseType::Suspend();
-        ThreadBuddy.Suspend();
+        if (!Executor) {
+            ThreadBuddy.Suspend();
+        }
         CMN_LOG_CLASS_RUN_DEBUG << "Suspended task " << Name << std::endl;
     }
 }
@@ -174,3 +249,18 @@ bool mtsTaskPeriodic::IsPeriodic(void) const
 {
     return Period > 0.0;
 }
+
+void mtsTaskPeriodic::SetCatchUpPolicy(const osaThreadBuddy::CatchUpPolicyType policy)
+{
+    ThreadBuddy.SetCatchUpPolicy(policy);
+}
+
+unsigned long long mtsTaskPeriodic::GetNumberOfOverruns(void) const
+{
+    return ThreadBuddy.GetNumberOfOverruns() + ExecutorNumberOfOverruns;
+}
+
+unsigned long long mtsTaskPeriodic::GetNumberOfSkippedPeriods(void) const
+{
+    return ThreadBuddy.GetNumberOfSkippedPeriods() + ExecutorNumberOfSkippedPeriods;
+}
@@ -0,0 +1,411 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstCommon/cmnLogger.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstMultiTask/mtsTaskPeriodicExecutor.h>
+#include <cisstMultiTask/mtsTaskPeriodic.h>
+#include <cisstMultiTask/mtsCommandTracer.h>
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+
+mtsTaskPeriodicExecutor::mtsTaskPeriodicExecutor(const std::string & name,
+                                                 const size_t numberOfThreads,
+                                                 const double resolution,
+                                                 const size_t numberOfSlots):
+    Name(name),
+    Resolution((resolution > 0.0) ? resolution : 1.0 * cmn_ms),
+    TimeOrigin(osaGetTime())
+{
+    const size_t threads = (numberOfThreads > 0) ? numberOfThreads : 1;
+    const size_t slots = (numberOfSlots > 0) ? numberOfSlots : 1;
+    for (size_t index = 0; index < threads; ++index) {
+        Worker * worker = new Worker;
+        worker->Executor = this;
+        worker->Slots.resize(slots);
+        worker->Load = 0.0;
+        worker->LastTick = Tick(this->TimeOrigin) - 1;
+        worker->StopRequested = false;
+        this->Workers.push_back(worker);
+        std::stringstream threadName;
+        threadName << "Exec" << index;
+        worker->Thread.Create<Worker, int>(worker, &Worker::Run, static_cast<int>(index),
+                                           threadName.str().c_str());
+    }
+}
+
+
+mtsTaskPeriodicExecutor::~mtsTaskPeriodicExecutor()
+{
+    for (size_t index = 0; index < this->Workers.size(); ++index) {
+        Worker * worker = this->Workers[index];
+        worker->Mutex.Lock();
+        worker->StopRequested = true;
+        worker->Mutex.Unlock();
+        worker->WakeSignal.Raise();
+        worker->Thread.Wait();
+    }
+    for (size_t index = 0; index < this->Workers.size(); ++index) {
+        Worker * worker = this->Workers[index];
+        // tasks still around can't be executed anymore
+        for (size_t task = 0; task < worker->Tasks.size(); ++task) {
+            mtsTaskPeriodic * taskPointer = worker->Tasks[task];
+            if (!taskPointer->IsTerminated()) {
+                CMN_LOG_INIT_WARNING << "mtsTaskPeriodicExecutor: executor \"" << this->Name
+                                     << "\" deleted before task \"" << taskPointer->GetName()
+                                     << "\" was terminated" << std::endl;
+                taskPointer->Kill();
+                if (!taskPointer->IsTerminated()) {
+                    taskPointer->CleanupInternal();
+                }
+            }
+            taskPointer->Executor = 0;
+            taskPointer->SetExecutionContext(0);
+        }
+        for (size_t slot = 0; slot < worker->Slots.size(); ++slot) {
+            for (size_t entry = 0; entry < worker->Slots[slot].size(); ++entry) {
+                delete worker->Slots[slot][entry];
+            }
+        }
+        for (size_t entry = 0; entry < worker->Added.size(); ++entry) {
+            delete worker->Added[entry];
+        }
+        delete worker;
+    }
+}
+
+
+long long mtsTaskPeriodicExecutor::Tick(const double time) const
+{
+    return static_cast<long long>(std::floor((time - this->TimeOrigin) / this->Resolution));
+}
+
+
+mtsTaskPeriodicExecutor::Worker * mtsTaskPeriodicExecutor::FindWorker(const mtsTaskPeriodic * task) const
+{
+    for (size_t index = 0; index < this->Workers.size(); ++index) {
+        Worker * worker = this->Workers[index];
+        worker->Mutex.Lock();
+        const bool found = (std::find(worker->Tasks.begin(), worker->Tasks.end(), task) != worker->Tasks.end());
+        worker->Mutex.Unlock();
+        if (found) {
+            return worker;
+        }
+    }
+    return 0;
+}
+
+
+bool mtsTaskPeriodicExecutor::AddTask(mtsTaskPeriodic * task)
+{
+    if (!task) {
+        return false;
+    }
+    if (task->Executor) {
+        CMN_LOG_INIT_ERROR << "mtsTaskPeriodicExecutor::AddTask: task \"" << task->GetName()
+                           << "\" already uses executor \"" << task->Executor->GetName() << "\"" << std::endl;
+        return false;
+    }
+    if (task->GetState() != mtsComponentState::CONSTRUCTED) {
+        CMN_LOG_INIT_ERROR << "mtsTaskPeriodicExecutor::AddTask: task \"" << task->GetName()
+                           << "\" has already been created" << std::endl;
+        return false;
+    }
+    if (task->IsHardRealTime) {
+        CMN_LOG_INIT_WARNING << "mtsTaskPeriodicExecutor::AddTask: task \"" << task->GetName()
+                             << "\" will not be hard real-time when used with executor \""
+                             << this->Name << "\"" << std::endl;
+    }
+
+    // least loaded worker
+    Worker * worker = this->Workers[0];
+    for (size_t index = 1; index < this->Workers.size(); ++index) {
+        if (this->Workers[index]->Load < worker->Load) {
+            worker = this->Workers[index];
+        }
+    }
+    worker->Mutex.Lock();
+    worker->Tasks.push_back(task);
+    worker->Load += 1.0 / task->GetPeriodicity();
+    worker->Mutex.Unlock();
+    task->Executor = this;
+    // tasks of the same worker can call each other's commands directly
+    task->SetExecutionContext(worker);
+    CMN_LOG_INIT_VERBOSE << "mtsTaskPeriodicExecutor::AddTask: task \"" << task->GetName()
+                         << "\" added to executor \"" << this->Name << "\"" << std::endl;
+    return true;
+}
+
+
+bool mtsTaskPeriodicExecutor::RemoveTask(mtsTaskPeriodic * task)
+{
+    Worker * worker = FindWorker(task);
+    if (!worker) {
+        return false;
+    }
+    worker->Mutex.Lock();
+    worker->Remove(task);
+    worker->Mutex.Unlock();
+    // the task might be running, wait for the end of the batch unless
+    // called by a task of the same worker
+    if (worker->Thread.GetId() != osaGetCurrentThreadId()) {
+        worker->RunMutex.Lock();
+        worker->RunMutex.Unlock();
+    }
+    task->Executor = 0;
+    task->SetExecutionContext(0);
+    return true;
+}
+
+
+bool mtsTaskPeriodicExecutor::Schedule(mtsTaskPeriodic * task)
+{
+    Worker * worker = FindWorker(task);
+    if (!worker) {
+        return false;
+    }
+    Entry * entry = new Entry;
+    entry->Task = task;
+    entry->Period = task->GetPeriodicity();
+    entry->Deadline = 0.0;
+    entry->DeadlineTick = 0;
+    entry->Removed = false;
+    entry->Terminated = false;
+    worker->Mutex.Lock();
+    worker->Added.push_back(entry);
+    worker->Mutex.Unlock();
+    worker->WakeSignal.Raise();
+    return true;
+}
+
+
+size_t mtsTaskPeriodicExecutor::GetNumberOfTasks(void) const
+{
+    size_t result = 0;
+    for (size_t index = 0; index < this->Workers.size(); ++index) {
+        Worker * worker = this->Workers[index];
+        worker->Mutex.Lock();
+        result += worker->Tasks.size();
+        worker->Mutex.Unlock();
+    }
+    return result;
+}
+
+
+bool mtsTaskPeriodicExecutor::Worker::CompareDeadlines(const Entry * first, const Entry * second)
+{
+    return (first->Deadline < second->Deadline);
+}
+
+
+void mtsTaskPeriodicExecutor::Worker::Schedule(Entry * entry)
+{
+    const long long numberOfSlots = static_cast<long long>(this->Slots.size());
+    // deadlines already passed go in the next slot scanned
+    long long tick = entry->DeadlineTick;
+    if (tick <= this->LastTick) {
+        tick = this->LastTick + 1;
+    }
+    this->Slots[static_cast<size_t>(tick % numberOfSlots)].push_back(entry);
+}
+
+
+long long mtsTaskPeriodicExecutor::Worker::NextTick(void) const
+{
+    if (!this->Added.empty()) {
+        return this->LastTick;
+    }
+    const long long numberOfSlots = static_cast<long long>(this->Slots.size());
+    for (long long tick = this->LastTick + 1; tick <= this->LastTick + numberOfSlots; ++tick) {
+        const std::vector<Entry *> & slot = this->Slots[static_cast<size_t>(tick % numberOfSlots)];
+        // entries might be due on a later turn of the wheel, the
+        // worker will just wake up and check again
+        if (!slot.empty()) {
+            return tick;
+        }
+    }
+    return -1;
+}
+
+
+bool mtsTaskPeriodicExecutor::Worker::Remove(const mtsTaskPeriodic * task)
+{
+    bool found = false;
+    std::vector<mtsTaskPeriodic *>::iterator taskIterator = std::find(this->Tasks.begin(), this->Tasks.end(), task);
+    if (taskIterator != this->Tasks.end()) {
+        this->Load -= 1.0 / task->GetPeriodicity();
+        this->Tasks.erase(taskIterator);
+        found = true;
+    }
+    for (size_t slot = 0; slot < this->Slots.size(); ++slot) {
+        std::vector<Entry *> & entries = this->Slots[slot];
+        for (size_t index = 0; index < entries.size(); ) {
+            if (entries[index]->Task == task) {
+                delete entries[index];
+                entries.erase(entries.begin() + index);
+            } else {
+                ++index;
+            }
+        }
+    }
+    for (size_t index = 0; index < this->Added.size(); ) {
+        if (this->Added[index]->Task == task) {
+            delete this->Added[index];
+            this->Added.erase(this->Added.begin() + index);
+        } else {
+            ++index;
+        }
+    }
+    // due entries are used by the worker without the mutex
+    for (size_t index = 0; index < this->Due.size(); ++index) {
+        if (this->Due[index]->Task == task) {
+            this->Due[index]->Removed = true;
+        }
+    }
+    return found;
+}
+
+
+bool mtsTaskPeriodicExecutor::Worker::Execute(Entry * entry, const double now)
+{
+    mtsTaskPeriodic * task = entry->Task;
+    task->RunFromExecutor();
+    if (task->IsTerminated()) {
+        entry->Terminated = true;
+        return false;
+    }
+
+    // next deadline is computed from the previous one to avoid
+    // drifting, see osaThreadBuddy::WaitForRemainingPeriod
+    const double period = entry->Period;
+    entry->Deadline += period;
+    const double end = osaGetTime();
+    if (end >= entry->Deadline) {
+        const double lateness = end - entry->Deadline;
+        task->ExecutorNumberOfOverruns++;
+        switch (task->ThreadBuddy.GetCatchUpPolicy()) {
+        case osaThreadBuddy::CATCH_UP_SKIP:
+            {
+                const unsigned long long missed = static_cast<unsigned long long>(lateness / period) + 1;
+                entry->Deadline += missed * period;
+                task->ExecutorNumberOfSkippedPeriods += missed;
+            }
+            break;
+        case osaThreadBuddy::CATCH_UP_BURST:
+            // deadline is unchanged, task will run on next tick
+            break;
+        case osaThreadBuddy::CATCH_UP_REALIGN:
+            entry->Deadline = (now > end) ? now : end;
+            break;
+        }
+    }
+    entry->DeadlineTick = this->Executor->Tick(entry->Deadline);
+    return true;
+}
+
+
+void * mtsTaskPeriodicExecutor::Worker::Run(int index)
+{
+    std::stringstream threadName;
+    threadName << this->Executor->GetName() << " " << index;
+    mtsCommandTracer::SetThreadName(threadName.str());
+    const long long numberOfSlots = static_cast<long long>(this->Slots.size());
+    this->RunMutex.Lock();
+    this->Mutex.Lock();
+    while (!this->StopRequested) {
+        const double now = osaGetTime();
+        const long long currentTick = this->Executor->Tick(now);
+
+        // newly created tasks start right away
+        for (size_t index = 0; index < this->Added.size(); ++index) {
+            this->Added[index]->Deadline = now;
+            this->Due.push_back(this->Added[index]);
+        }
+        this->Added.clear();
+
+        // collect entries due from the slots elapsed since last tick
+        long long first = this->LastTick + 1;
+        if (currentTick - first >= numberOfSlots) {
+            first = currentTick - numberOfSlots + 1;
+        }
+        for (long long tick = first; tick <= currentTick; ++tick) {
+            std::vector<Entry *> & slot = this->Slots[static_cast<size_t>(tick % numberOfSlots)];
+            for (size_t index = 0; index < slot.size(); ) {
+                if (slot[index]->DeadlineTick <= currentTick) {
+                    this->Due.push_back(slot[index]);
+                    slot[index] = slot.back();
+                    slot.pop_back();
+                } else {
+                    ++index;
+                }
+            }
+        }
+        if (currentTick > this->LastTick) {
+            this->LastTick = currentTick;
+        }
+
+        // earliest deadlines first, the mutex is released while the
+        // tasks run so other threads can add, remove or query tasks
+        std::stable_sort(this->Due.begin(), this->Due.end(), CompareDeadlines);
+        for (size_t index = 0; index < this->Due.size(); ++index) {
+            Entry * entry = this->Due[index];
+            // the task might have been removed by a previous task
+            if (!entry->Removed) {
+                this->Mutex.Unlock();
+                Execute(entry, now);
+                this->Mutex.Lock();
+            }
+        }
+
+        // reschedule, tasks removed while running are deleted
+        for (size_t index = 0; index < this->Due.size(); ++index) {
+            Entry * entry = this->Due[index];
+            if (entry->Removed) {
+                delete entry;
+            } else if (entry->Terminated) {
+                CMN_LOG_RUN_VERBOSE << "mtsTaskPeriodicExecutor: task \"" << entry->Task->GetName()
+                                    << "\" terminated, removed from executor \"" << this->Executor->GetName()
+                                    << "\"" << std::endl;
+                delete entry;
+            } else {
+                Schedule(entry);
+            }
+        }
+        this->Due.clear();
+
+        // sleep until next slot with tasks or until a task is added
+        const long long nextTick = NextTick();
+        this->Mutex.Unlock();
+        this->RunMutex.Unlock();
+        if (nextTick < 0) {
+            this->WakeSignal.Wait();
+        } else {
+            const double wait = this->Executor->TimeOrigin + nextTick * this->Executor->Resolution - osaGetTime();
+            if (wait > 0.0) {
+                this->WakeSignal.Wait(wait);
+            }
+        }
+        this->RunMutex.Lock();
+        this->Mutex.Lock();
+    }
+    this->Mutex.Unlock();
+    this->RunMutex.Unlock();
+    return 0;
+}
@@ -5,7 +5,7 @@
   Author(s):  Anton Deguet
   Created on: 2013-07-13
 
-  (C) Copyright 2013-2018 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2013-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -25,7 +25,7 @@ http://www.cisst.org/cisst/license.txt.
 mtsIntervalStatisticsQtWidget::mtsIntervalStatisticsQtWidget(void):
     QTableWidget()
 {
-    this->setRowCount(3);
+    this->setRowCount(4);
     this->setColumnCount(3);
     this->verticalHeader()->hide();
     this->horizontalHeader()->hide();
@@ -57,6 +57,11 @@ mtsIntervalStatisticsQtWidget::mtsIntervalStatisticsQtWidget(void):
     QTWIPeriodRange->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
     QTWIPeriodRange->setFlags(QTWIPeriodRange->flags() ^ Qt::ItemIsEditable);
     this->setItem(2, colIndex, QTWIPeriodRange);
+    QTWIPeriodPercentiles = new QTableWidgetItem();
+    QTWIPeriodPercentiles->setToolTip("50th/99th/99.9th percentiles of period");
+    QTWIPeriodPercentiles->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    QTWIPeriodPercentiles->setFlags(QTWIPeriodPercentiles->flags() ^ Qt::ItemIsEditable);
+    this->setItem(3, colIndex, QTWIPeriodPercentiles);
 
     colIndex++;
     QTWILoadAverage = new QTableWidgetItem();
@@ -74,6 +79,11 @@ mtsIntervalStatisticsQtWidget::mtsIntervalStatisticsQtWidget(void):
     QTWILoadRange->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
     QTWILoadRange->setFlags(QTWILoadRange->flags() ^ Qt::ItemIsEditable);
     this->setItem(2, colIndex, QTWILoadRange);
+    QTWILoadPercentiles = new QTableWidgetItem();
+    QTWILoadPercentiles->setToolTip("50th/99th/99.9th percentiles of compute time");
+    QTWILoadPercentiles->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    QTWILoadPercentiles->setFlags(QTWILoadPercentiles->flags() ^ Qt::ItemIsEditable);
+    this->setItem(3, colIndex, QTWILoadPercentiles);
 
     colIndex++;
     QTWIInterval = new QTableWidgetItem();
@@ -91,6 +101,11 @@ mtsIntervalStatisticsQtWidget::mtsIntervalStatisticsQtWidget(void):
     QTWINumberOfOverruns->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
     QTWINumberOfOverruns->setFlags(QTWINumberOfOverruns->flags() ^ Qt::ItemIsEditable);
     this->setItem(2, colIndex, QTWINumberOfOverruns);
+    QTWIPercentiles = new QTableWidgetItem("p50/p99/p99.9");
+    QTWIPercentiles->setToolTip("Percentiles displayed for period and compute time");
+    QTWIPercentiles->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    QTWIPercentiles->setFlags(QTWIPercentiles->flags() ^ Qt::ItemIsEditable);
+    this->setItem(3, colIndex, QTWIPercentiles);
 
     // set value to initialize content size
     this->SetValue(mtsIntervalStatistics());
@@ -121,6 +136,14 @@ void mtsIntervalStatisticsQtWidget::SetValue(const mtsIntervalStatistics & newVa
     QTWIPeriodRange->setText(QString("%1/%2ms")
                              .arg(newValue.PeriodMin() * 1000.0, -6, 'f', 3)
                              .arg(newValue.PeriodMax() * 1000.0, -6, 'f', 3));
+    if (newValue.PercentilesEnabled()) {
+        QTWIPeriodPercentiles->setText(QString("%1/%2/%3ms")
+                                       .arg(newValue.PeriodP50() * 1000.0, -6, 'f', 3)
+                                       .arg(newValue.PeriodP99() * 1000.0, -6, 'f', 3)
+                                       .arg(newValue.PeriodP999() * 1000.0, -6, 'f', 3));
+    } else {
+        QTWIPeriodPercentiles->setText("n/a");
+    }
 
     const double loadAvg = newValue.ComputeTimeAvg();
     const double periodPercent = 100.0 / periodAvg;
@@ -131,6 +154,14 @@ void mtsIntervalStatisticsQtWidget::SetValue(const mtsIntervalStatistics & newVa
     QTWILoadRange->setText(QString("%1/%2\%")
                            .arg(newValue.ComputeTimeMin() * periodPercent, -5, 'f', 1)
                            .arg(newValue.ComputeTimeMax() * periodPercent, -5, 'f', 1));
+    if (newValue.PercentilesEnabled()) {
+        QTWILoadPercentiles->setText(QString("%1/%2/%3\%")
+                                     .arg(newValue.ComputeTimeP50() * periodPercent, -5, 'f', 1)
+                                     .arg(newValue.ComputeTimeP99() * periodPercent, -5, 'f', 1)
+                                     .arg(newValue.ComputeTimeP999() * periodPercent, -5, 'f', 1));
+    } else {
+        QTWILoadPercentiles->setText("n/a");
+    }
 
     QTWIInterval->setText(QString("%1s").arg(newValue.StatisticsInterval(), -6, 'f', 3));
     QTWINumberOfSamples->setText(QString("%1 samples").arg(newValue.NumberOfSamples(), 0, 'g', -1, '0'));
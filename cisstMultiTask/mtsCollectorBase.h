@@ -6,7 +6,7 @@
   Author(s):  Min Yang Jung, Anton Deguet
   Created on: 2009-02-25
 
-  (C) Copyright 2009-2012 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -55,7 +55,8 @@ public:
         COLLECTOR_FILE_FORMAT_PLAIN_TEXT,
         COLLECTOR_FILE_FORMAT_BINARY,
         COLLECTOR_FILE_FORMAT_CSV,
-        COLLECTOR_FILE_FORMAT_UNDEFINED
+        COLLECTOR_FILE_FORMAT_UNDEFINED,
+        COLLECTOR_FILE_FORMAT_BINARY_COLUMNAR
     } CollectorFileFormat;
 
     typedef enum {
@@ -201,12 +202,17 @@ protected:
     /*! Create the provided interface for control. */
     void SetupControlInterface(void);
 
+    /*! Called before the output is changed or closed so derived
+      classes using their own writer can flush and close it.  Default
+      implementation does nothing. */
+    virtual void FlushOutput(void) {}
+
 public:
     mtsCollectorBase(const std::string & collectorName, const CollectorFileFormat fileFormat);
 
     virtual ~mtsCollectorBase(void);
 
-    /*! Generate default file name, without the prefix (txt, csv, cdat) */
+    /*! Generate default file name, without the prefix (txt, csv, cdat, ccol) */
     virtual std::string GetDefaultOutputName(void) = 0;
 
     /*! Define the output file and format.  If a file is already in
@@ -0,0 +1,153 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Definitions for the columnar binary log format used by mtsCollectorState
+*/
+
+#ifndef _mtsCollectorColumnar_h
+#define _mtsCollectorColumnar_h
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <string.h>
+
+// Always include last
+#include <cisstMultiTask/mtsExport.h>
+
+/*!
+  \ingroup cisstMultiTask
+
+  Constants and helper functions shared by
+  mtsCollectorColumnarWriter and mtsCollectorColumnarReader.
+
+  A columnar log file is organized as follows, all values use the
+  native byte order of the writer (the reader checks the endianness
+  marker):
+
+  - File header: magic string (8 bytes), version, endianness marker,
+    size of the header body and header body (component and state
+    table names, date, time origin, name and class name of each
+    signal).
+
+  - Chunks: each chunk contains a fixed maximum number of rows.  A
+    chunk header provides the number of rows, the first and last ticks
+    and times, and a directory of columns (encoding, stride, offset
+    and sizes).  Column 0 contains the ticks, column 1 the time (Tic)
+    of each row and the following columns the signals.  Each signal
+    column contains the data serialized with SerializeRaw, one record
+    per row.  If all the records of a chunk have the same size (stride),
+    they are stored back to back, otherwise the column starts with
+    the offsets of all records.
+
+  - Footer: index of all chunks (file offset, first row, number of
+    rows, ticks and time range) followed by the offset of the index,
+    the number of chunks and a magic number.  If the footer is
+    missing (e.g. the application crashed), the reader rebuilds the
+    index by scanning the chunks.
+
+  Fixed stride columns can be compressed using ENCODING_SHUFFLE_XOR_RLE.
+  Bytes at the same position in each record are grouped, xor-ed with
+  the previous byte and the resulting runs of zeros are encoded.
+  Slowly varying signals, timestamps and flags compress very well
+  while encoding and decoding only require a couple of passes on the
+  data.
+*/
+class CISST_EXPORT mtsCollectorColumnar
+{
+public:
+    enum {
+        VERSION = 1,
+        ENDIANNESS_MARKER = 0x01020304,
+        CHUNK_MAGIC = 0x4b4e4843,  // "CHNK"
+        FOOTER_MAGIC = 0x58444943, // "CIDX"
+        MAGIC_SIZE = 8
+    };
+
+    /*! Column encoding */
+    typedef enum {
+        ENCODING_RAW = 0,
+        ENCODING_SHUFFLE_XOR_RLE = 1
+    } EncodingType;
+
+    /*! Index of the columns always present in a chunk */
+    enum {
+        COLUMN_TICKS = 0,
+        COLUMN_TIME = 1,
+        FIRST_SIGNAL_COLUMN = 2
+    };
+
+    /*! Magic string at the beginning of the file */
+    static const char * Magic(void);
+
+    /*! Size in bytes of a column directory entry */
+    static size_t ColumnDirectoryEntrySize(void);
+
+    /*! Size in bytes of a chunk header, without the column directory */
+    static size_t ChunkHeaderSize(void);
+
+    /*! Size in bytes of a chunk index entry in the footer */
+    static size_t ChunkIndexEntrySize(void);
+
+    /*! Size in bytes of the footer trailer (index offset, number of
+      chunks and magic number) */
+    static size_t FooterTrailerSize(void);
+
+    /*! Encode a fixed stride column.  Returns false if the encoded
+      data is not smaller than the input, in which case the content of
+      output is undefined and the column should be stored raw. */
+    static bool Encode(const char * input, const size_t size, const size_t stride,
+                       std::vector<char> & output);
+
+    /*! Decode a column encoded with Encode.  The size and stride are
+      the ones of the raw data.  Returns false if the encoded data is
+      corrupted. */
+    static bool Decode(const char * input, const size_t inputSize,
+                       const size_t size, const size_t stride,
+                       std::vector<char> & output);
+
+    /*! Append a value to a buffer using the native representation */
+    template <class _valueType>
+    inline static void Append(std::vector<char> & buffer, const _valueType & value) {
+        const size_t position = buffer.size();
+        buffer.resize(position + sizeof(_valueType));
+        memcpy(&(buffer[position]), &value, sizeof(_valueType));
+    }
+
+    /*! Append a string preceded by its length */
+    static void Append(std::vector<char> & buffer, const std::string & value);
+
+    /*! Read a value and move the pointer.  Returns false if there is
+      not enough data left. */
+    template <class _valueType>
+    inline static bool Read(const char * & data, const char * end, _valueType & value) {
+        if (static_cast<size_t>(end - data) < sizeof(_valueType)) {
+            return false;
+        }
+        memcpy(&value, data, sizeof(_valueType));
+        data += sizeof(_valueType);
+        return true;
+    }
+
+    /*! Read a string preceded by its length */
+    static bool Read(const char * & data, const char * end, std::string & value);
+};
+
+#endif // _mtsCollectorColumnar_h
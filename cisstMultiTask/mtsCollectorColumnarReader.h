@@ -0,0 +1,215 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Reader for the columnar binary log format
+*/
+
+#ifndef _mtsCollectorColumnarReader_h
+#define _mtsCollectorColumnarReader_h
+
+#include <cisstMultiTask/mtsCollectorColumnar.h>
+#include <cisstMultiTask/mtsGenericObject.h>
+
+#include <string>
+#include <vector>
+
+// Always include last
+#include <cisstMultiTask/mtsExport.h>
+
+/*!
+  \ingroup cisstMultiTask
+
+  Reads a columnar binary log file created by
+  mtsCollectorColumnarWriter (see mtsCollectorColumnar for the file
+  layout).
+
+  The file is memory mapped on POSIX systems, otherwise it is loaded
+  in memory.  Only the header and chunk index are parsed when
+  the file is opened, chunks are decoded on demand when a row is
+  accessed.  The last decoded chunk is cached so accessing rows in
+  sequence only decodes each chunk once.  Columns stored raw are
+  accessed directly in the mapped file.
+
+  If the footer is missing or corrupted (e.g. the application writing
+  the file crashed), the index is rebuilt by scanning the chunks and
+  the last incomplete chunk is ignored.
+
+  This class is not thread safe.
+*/
+class CISST_EXPORT mtsCollectorColumnarReader
+{
+public:
+    /*! Information about a chunk, as found in the file index */
+    class ChunkInfo {
+    public:
+        unsigned long long FileOffset;
+        unsigned long long FirstRow;
+        unsigned long long NumberOfRows;
+        unsigned long long FirstTick, LastTick;
+        double FirstTime, LastTime;
+    };
+
+protected:
+    std::string FileName;
+
+    /*! File content, either mapped or loaded */
+    const char * Data;
+    size_t Size;
+    bool Mapped;
+    std::vector<char> Loaded;
+
+    /*! Header content */
+    std::string ComponentName;
+    std::string StateTableName;
+    std::string DateTime;
+    double TimeOrigin;
+    std::vector<std::string> SignalNames;
+    std::vector<std::string> SignalClassNames;
+    size_t HeaderSize;
+
+    /*! Chunk index */
+    std::vector<ChunkInfo> Chunks;
+    unsigned long long NumberOfRows;
+    bool IndexRecovered;
+
+    /*! Column of the cached chunk */
+    class Column {
+    public:
+        const char * Data;
+        size_t Size;
+        size_t Stride;
+        /*! Offsets table for variable size records, not aligned */
+        const char * Offsets;
+        /*! Used if the column has been decoded */
+        std::vector<char> Decoded;
+    };
+    std::vector<Column> Columns;
+    size_t CachedChunk;
+
+    bool Map(void);
+    void Unmap(void);
+    bool ReadHeader(void);
+    bool ReadFooter(void);
+    void RebuildIndex(void);
+
+    /*! Read a chunk header, returns false if it is incomplete */
+    bool ReadChunkHeader(const unsigned long long fileOffset, ChunkInfo & info,
+                         unsigned long long & totalSize) const;
+
+    /*! Load (decode if needed) the columns of a chunk */
+    bool LoadChunk(const size_t chunkIndex);
+
+    /*! Find the chunk containing a row and load it */
+    bool LoadRow(const unsigned long long row, size_t & rowInChunk);
+
+    /*! Find first row with a time greater or equal to (or strictly
+      greater than if strict is true) a given time. */
+    unsigned long long LowerBound(const double time, const bool strict);
+
+private:
+    /*! Readers can't be copied */
+    mtsCollectorColumnarReader(const mtsCollectorColumnarReader & other);
+    mtsCollectorColumnarReader & operator = (const mtsCollectorColumnarReader & other);
+
+public:
+    mtsCollectorColumnarReader(void);
+
+    ~mtsCollectorColumnarReader(void);
+
+    /*! Open a file, parse the header and index */
+    bool Open(const std::string & fileName);
+
+    void Close(void);
+
+    inline bool IsOpen(void) const {
+        return (this->Data != 0);
+    }
+
+    /*! True if the index has been rebuilt because the footer was
+      missing */
+    inline bool GetIndexRecovered(void) const {
+        return this->IndexRecovered;
+    }
+
+    /*! Content of the file header */
+    //@{
+    inline const std::string & GetComponentName(void) const {
+        return this->ComponentName;
+    }
+    inline const std::string & GetStateTableName(void) const {
+        return this->StateTableName;
+    }
+    inline const std::string & GetDateTime(void) const {
+        return this->DateTime;
+    }
+    inline double GetTimeOrigin(void) const {
+        return this->TimeOrigin;
+    }
+    inline size_t GetNumberOfSignals(void) const {
+        return this->SignalNames.size();
+    }
+    const std::string & GetSignalName(const size_t signal) const;
+    const std::string & GetSignalClassName(const size_t signal) const;
+    //@}
+
+    /*! Find a signal by name, returns false if not found */
+    bool GetSignalIndex(const std::string & signalName, size_t & signal) const;
+
+    inline size_t GetNumberOfChunks(void) const {
+        return this->Chunks.size();
+    }
+    inline const ChunkInfo & GetChunkInfo(const size_t chunk) const {
+        return this->Chunks[chunk];
+    }
+    inline unsigned long long GetNumberOfRows(void) const {
+        return this->NumberOfRows;
+    }
+
+    /*! Find rows with a time in [startTime, endTime].  Rows are
+      returned as a range [firstRow, endRow).  Returns false if no row
+      is found. */
+    bool FindRows(const double startTime, const double endTime,
+                  unsigned long long & firstRow, unsigned long long & endRow);
+
+    /*! Ticks and time of a row */
+    //@{
+    bool GetTicks(const unsigned long long row, unsigned long long & ticks);
+    bool GetTime(const unsigned long long row, double & time);
+    //@}
+
+    /*! Raw serialized data (see SerializeRaw) of a signal for a row.
+      The pointer is valid until another chunk is accessed or the file
+      is closed. */
+    bool GetSignalRaw(const size_t signal, const unsigned long long row,
+                      const char * & data, size_t & size);
+
+    /*! Deserialize the data of a signal for a row.  The object must be
+      of the type used to collect the signal. */
+    bool GetSignal(const size_t signal, const unsigned long long row,
+                   mtsGenericObject & object);
+
+    /*! Create an object of the type used for a signal using the class
+      register.  The caller is responsible for deleting the object.
+      Returns 0 if the class is not registered or can't be dynamically
+      created. */
+    mtsGenericObject * CreateSignalObject(const size_t signal) const;
+};
+
+#endif // _mtsCollectorColumnarReader_h
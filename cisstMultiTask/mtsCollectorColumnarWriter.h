@@ -0,0 +1,212 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Writer for the columnar binary log format
+*/
+
+#ifndef _mtsCollectorColumnarWriter_h
+#define _mtsCollectorColumnarWriter_h
+
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstOSAbstraction/osaThreadSignal.h>
+#include <cisstOSAbstraction/osaMutex.h>
+#include <cisstMultiTask/mtsCollectorColumnar.h>
+#include <cisstMultiTask/mtsGenericObject.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Always include last
+#include <cisstMultiTask/mtsExport.h>
+
+/*!
+  \ingroup cisstMultiTask
+
+  Writes a columnar binary log file (see mtsCollectorColumnar for the
+  file layout).  This is used by mtsCollectorState when the output
+  format is mtsCollectorBase::COLLECTOR_FILE_FORMAT_BINARY_COLUMNAR
+  but can also be used on its own.
+
+  Rows are added by the caller's thread (BeginRow, AddElement and
+  EndRow) in a chunk held in memory.  When the chunk is full, it is
+  swapped with a second chunk owned by a dedicated writer thread which
+  encodes the columns and writes them to disk (double buffering).  The
+  caller only blocks if the writer thread is still busy with the
+  previous chunk.  Memory used for the chunks is reused so, once the
+  first chunks have been filled, adding rows doesn't allocate memory
+  unless the size of the data changes.
+
+  Close flushes the last chunk, writes the chunk index at the end of
+  the file and stops the writer thread.
+*/
+class CISST_EXPORT mtsCollectorColumnarWriter
+{
+public:
+    /*! Chunk of rows, one column per signal */
+    class Chunk {
+    public:
+        size_t NumberOfRows;
+        unsigned long long FirstTick, LastTick;
+        double FirstTime, LastTime;
+        /*! Raw data for ticks, times and each signal */
+        std::vector<std::vector<char> > Columns;
+        /*! Offset of each record for signal columns */
+        std::vector<std::vector<unsigned long long> > Offsets;
+        /*! Size of records for each column if constant, 0 otherwise */
+        std::vector<size_t> Strides;
+
+        Chunk(void);
+        void Resize(const size_t numberOfColumns);
+        void Clear(void);
+    };
+
+protected:
+    std::string FileName;
+    FILE * File;
+    bool Compression;
+    size_t ChunkSize;
+    size_t NumberOfSignals;
+    unsigned long long NumberOfRows;
+    unsigned long long FileOffset;
+    bool Error;
+
+    /*! Chunk being filled by the caller and chunk being written by
+      the writer thread. */
+    Chunk Chunks[2];
+    Chunk * Filling;
+    Chunk * Writing;
+
+    /*! Row currently added, used to check that all signals are added */
+    size_t CurrentSignal;
+
+    /*! Index written in the footer, one entry per chunk */
+    std::vector<char> ChunkIndex;
+    unsigned int NumberOfChunks;
+
+    /*! Writer thread and synchronization */
+    osaThread Thread;
+    osaMutex Mutex;
+    osaThreadSignal ChunkReadySignal;
+    osaThreadSignal ChunkWrittenSignal;
+    bool ThreadRunning;
+    bool ChunkPending;
+    bool StopRequested;
+
+    /*! Number of rows written by the writer thread */
+    unsigned long long NumberOfRowsWritten;
+
+    /*! Stream used to serialize elements directly in the columns */
+    class ColumnStreamBuffer;
+    ColumnStreamBuffer * StreamBuffer;
+    std::ostream * Stream;
+
+    /*! Buffers reused to encode and write chunks */
+    std::vector<char> EncodedColumn;
+    std::vector<char> ChunkBuffer;
+
+    /*! Writer thread main loop */
+    void * WriterThread(int);
+
+    /*! Wait until the writer thread is done with the pending chunk */
+    void WaitForPendingChunk(void);
+
+    /*! Swap the filling chunk with the writer thread's chunk */
+    void HandOffChunk(void);
+
+    /*! Encode and write a chunk, called by the writer thread */
+    bool WriteChunk(const Chunk & chunk);
+
+    /*! Write bytes at the end of the file */
+    bool WriteBytes(const char * data, const size_t size);
+
+private:
+    /*! Writers can't be copied */
+    mtsCollectorColumnarWriter(const mtsCollectorColumnarWriter & other);
+    mtsCollectorColumnarWriter & operator = (const mtsCollectorColumnarWriter & other);
+
+public:
+    mtsCollectorColumnarWriter(void);
+
+    /*! Destructor, closes the file if needed */
+    ~mtsCollectorColumnarWriter(void);
+
+    /*! Set number of rows per chunk, must be called before Open.
+      Default is 1024. */
+    void SetChunkSize(const size_t numberOfRows);
+
+    inline size_t GetChunkSize(void) const {
+        return this->ChunkSize;
+    }
+
+    /*! Enable or disable compression, enabled by default */
+    void SetCompression(const bool compression);
+
+    inline bool GetCompression(void) const {
+        return this->Compression;
+    }
+
+    /*! Create the file, write the header and start the writer
+      thread. */
+    bool Open(const std::string & fileName,
+              const std::string & componentName,
+              const std::string & stateTableName,
+              const std::string & dateTime,
+              const double timeOrigin,
+              const std::vector<std::string> & signalNames,
+              const std::vector<std::string> & signalClassNames);
+
+    /*! Check if a file is opened */
+    inline bool IsOpen(void) const {
+        return (this->File != 0);
+    }
+
+    /*! Start a new row */
+    void BeginRow(const unsigned long long ticks, const double time);
+
+    /*! Add the data for the next signal in the current row.  Signals
+      have to be added in the same order as the signal names provided
+      to Open. */
+    void AddElement(const mtsGenericObject & element);
+
+    /*! End the current row, the chunk is handed to the writer thread
+      if it is full. */
+    void EndRow(void);
+
+    /*! Hand the current chunk to the writer thread even if it is not
+      full and wait until it is written. */
+    void Flush(void);
+
+    /*! Flush, write the index and close the file.  Returns false if
+      any write failed. */
+    bool Close(void);
+
+    /*! Number of rows added since Open */
+    inline unsigned long long GetNumberOfRows(void) const {
+        return this->NumberOfRows;
+    }
+
+    /*! Number of chunks written so far */
+    inline unsigned int GetNumberOfChunks(void) const {
+        return this->NumberOfChunks;
+    }
+};
+
+#endif // _mtsCollectorColumnarWriter_h
@@ -6,7 +6,7 @@
   Author(s):  Anton Deguet
   Created on: 2010-02-12
 
-  (C) Copyright 2010 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2010-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -26,7 +26,10 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstMultiTask/mtsCollectorBase.h>
 #include <cisstMultiTask/mtsCommandVoid.h>
 #include <cisstMultiTask/mtsStateTable.h>
+#include <cisstMultiTask/mtsGenericObjectProxy.h>
+#include <cisstMultiTask/mtsCollectorColumnarWriter.h>
 
+#include <sstream>
 #include <string>
 
 // Always include last
@@ -39,6 +42,16 @@ http://www.cisst.org/cisst/license.txt.
   and interfaces.  It uses a separate thread and subscribes to all
   specified events.  When an event is received, the thread is waken-up
   and the event is recorded.
+
+  With COLLECTOR_FILE_FORMAT_BINARY_COLUMNAR, events are saved in a
+  columnar log file (see mtsCollectorColumnarWriter) which can be
+  replayed with mtsCollectorReplay::AddEventSource.  The file header
+  uses the collector name as component name and "Events" as state
+  table name.  Each row is an event, its time is the time the event
+  was received (relative to the time server's origin) and it contains
+  the signals "Component", "Interface" and "Event" (mtsStdString) as
+  well as "Payload" (mtsStdCharVecProxy), the payload serialized with
+  SerializeRaw or empty for void events.
 */
 class CISST_EXPORT mtsCollectorEvent : public mtsCollectorBase
 {
@@ -134,6 +147,31 @@ class CISST_EXPORT mtsCollectorEvent : public mtsCollectorBase
     /*! Pointer on manager's time server */
     const osaTimeServer * TimeServer;
 
+    /*! Writer used for COLLECTOR_FILE_FORMAT_BINARY_COLUMNAR and
+      elements reused to save each event */
+    //@{
+    mtsCollectorColumnarWriter * ColumnarWriter;
+    unsigned long long NumberOfEventsWritten;
+    mtsStdString ComponentElement, InterfaceElement, EventElement;
+    mtsStdCharVecProxy PayloadElement;
+    std::stringstream PayloadStream;
+    //@}
+
+    /*! Create the columnar file, called when the first event is
+      saved */
+    bool OpenColumnarWriter(void);
+
+    /*! Close the columnar file if any, defined in base class */
+    void FlushOutput(void);
+
+    /*! Save an event in the columnar file, payload is 0 for void
+      events */
+    void SaveEventColumnar(const double time,
+                           const std::string & componentName,
+                           const std::string & interfaceName,
+                           const std::string & eventName,
+                           const mtsGenericObject * payload);
+
  public:
     /*! Thread-related methods */
     void Run(void);
@@ -0,0 +1,261 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Deterministic replay of collected state table data
+*/
+
+#ifndef _mtsCollectorReplay_h
+#define _mtsCollectorReplay_h
+
+#include <cisstMultiTask/mtsTaskContinuous.h>
+#include <cisstMultiTask/mtsGenericObjectProxy.h>
+#include <cisstMultiTask/mtsFunctionVoid.h>
+#include <cisstMultiTask/mtsFunctionWrite.h>
+#include <cisstMultiTask/mtsCollectorColumnarReader.h>
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Always include last
+#include <cisstMultiTask/mtsExport.h>
+
+class mtsStateTable;
+class mtsMulticastCommandVoid;
+class mtsMulticastCommandWriteBase;
+
+/*!
+  \ingroup cisstMultiTask
+
+  Replay of state tables saved in columnar log files (see
+  mtsCollectorState with COLLECTOR_FILE_FORMAT_BINARY_COLUMNAR and
+  mtsStateTableFlightRecorder).
+
+  Each log file (source) is replayed in a state table of an existing
+  component set in replay mode (see mtsComponent::SetReplayMode).  The
+  component should be created as usual so its provided interfaces,
+  read commands and state table elements are identical to the
+  recorded ones, but it should not be started.  Logged signals are
+  matched to the state table elements by name, elements not found in
+  the log keep their current value.  The replay state tables don't
+  advance automatically and their timestamps are not overwritten.
+
+  Events saved by mtsCollectorEvent using the columnar format can also
+  be replayed (see AddEventSource).  For each logged event, the event
+  with the same name is triggered with the logged payload through the
+  provided interface of the component, which must also be in replay
+  mode.  Events of components, interfaces or events that can't be
+  found are ignored.
+
+  Rows from all sources are replayed in order of logged time on a
+  virtual clock, rows with the same time are replayed in order of
+  source (order of AddSource and AddEventSource calls) and then in
+  order of rows in the file so a given set of logs always produces the
+  same sequence of state tables updates and events.  For each state
+  table row, the signals are de-serialized in the state table
+  elements, the table is started with the logged time (see
+  mtsStateTable::ReplayStart) and advanced.  For each event row, the
+  event is triggered.  The event "Stepped" is then triggered with the
+  virtual time.  Observers using a non
+  queued event handler are executed by the replay thread before the
+  next row so they see exactly the same data on every run.
+
+  The replay rate is a multiple of real time, 0 (default) replays as
+  fast as possible.  The replay can be controlled using the methods of
+  this class before the task is started or from the task's thread only
+  (e.g. with the commands of the "Control" provided interface: "Play",
+  "Pause", "Step", "SetRate", "Seek" and "GetVirtualTime").  The event
+  "Finished" is triggered once all rows have been replayed.
+*/
+class CISST_EXPORT mtsCollectorReplay: public mtsTaskContinuous
+{
+    CMN_DECLARE_SERVICES(CMN_NO_DYNAMIC_CREATION, CMN_LOG_ALLOW_DEFAULT);
+
+protected:
+    /*! Event replayed from an event log, pointers are null if the
+      event can't be found */
+    class EventTarget {
+    public:
+        mtsMulticastCommandVoid * EventVoid;
+        mtsMulticastCommandWriteBase * EventWrite;
+        /*! Argument used to de-serialize the payload of write events */
+        mtsGenericObject * Argument;
+    };
+
+    /*! Log file replayed in a state table or event log, StateTable
+      is null for event logs */
+    class Source {
+    public:
+        std::string FileName;
+        mtsCollectorColumnarReader Reader;
+        mtsStateTable * StateTable;
+        /*! Pairs of signal index in file and state table element id */
+        typedef std::vector<std::pair<size_t, size_t> > SignalsType;
+        SignalsType Signals;
+        /*! Signal indices and events found so far for event logs */
+        size_t ComponentSignal, InterfaceSignal, EventSignal, PayloadSignal;
+        typedef std::map<std::string, EventTarget> EventTargetsType;
+        EventTargetsType EventTargets;
+        unsigned long long NextRow;
+        double NextTime;
+
+        Source(void);
+        ~Source();
+    };
+    typedef std::vector<Source *> SourcesType;
+    SourcesType Sources;
+
+    /*! Replay rate, multiple of real time, 0 for as fast as possible */
+    double Rate;
+    bool Playing;
+    bool FinishedTriggered;
+
+    /*! Virtual time, i.e. time of the last row replayed */
+    double VirtualTime;
+
+    /*! Wall and virtual times when playing started or the rate
+      changed, used to pace the replay */
+    double WallStart;
+    double VirtualStart;
+
+    /*! Maximum number of rows replayed per iteration of Run */
+    size_t BatchSize;
+
+    unsigned long long NumberOfRowsReplayed;
+
+    /*! Elements and stream reused to read event logs */
+    //@{
+    mtsStdString ComponentElement, InterfaceElement, EventElement;
+    mtsStdCharVecProxy PayloadElement;
+    std::stringstream PayloadStream;
+    //@}
+
+    mtsFunctionWrite SteppedEvent;
+    mtsFunctionVoid FinishedEvent;
+
+    /*! Read the time of the next row for a source */
+    void UpdateNextTime(Source & source);
+
+    /*! Index of the source with the next row to replay, number of
+      sources if all rows have been replayed */
+    size_t NextSource(void) const;
+
+    /*! Find the event to trigger using the names read for the
+      current event log row */
+    void FindEventTarget(EventTarget & target, const bool isVoid);
+
+    /*! Trigger the event for the next row of an event log */
+    void ReplayEvent(Source & source);
+
+    /*! Reset pacing, used when the rate or virtual time changes */
+    void ResetPacing(void);
+
+    /*! Methods used for the control interface */
+    void StepCommand(void);
+    void SetRateCommand(const mtsDouble & rate);
+    void SeekCommand(const mtsDouble & time);
+    void GetVirtualTimeCommand(mtsDouble & time) const;
+
+    void SetupControlInterface(void);
+
+private:
+    /*! Replay components can't be copied */
+    mtsCollectorReplay(const mtsCollectorReplay & other);
+    mtsCollectorReplay & operator = (const mtsCollectorReplay & other);
+
+public:
+    mtsCollectorReplay(const std::string & name);
+
+    ~mtsCollectorReplay();
+
+    /*! Add a log file to replay.  The component and state table
+      names are read from the file if not provided.  The component must
+      be in replay mode.  Returns false if the file can't be opened, the
+      component or state table can't be found or if none of the logged
+      signals can be matched to the state table elements. */
+    bool AddSource(const std::string & fileName,
+                   const std::string & componentName = "",
+                   const std::string & stateTableName = "");
+
+    /*! Add an event log created by mtsCollectorEvent with the
+      columnar format.  Components, interfaces and events are found
+      when the first event using them is replayed.  Returns false if
+      the file can't be opened or is not an event log. */
+    bool AddEventSource(const std::string & fileName);
+
+    inline size_t GetNumberOfSources(void) const {
+        return this->Sources.size();
+    }
+
+    /*! Set replay rate, i.e. multiple of real time.  Use 0 to replay
+      as fast as possible. */
+    void SetRate(const double rate);
+
+    inline double GetRate(void) const {
+        return this->Rate;
+    }
+
+    void Play(void);
+
+    void Pause(void);
+
+    inline bool IsPlaying(void) const {
+        return this->Playing;
+    }
+
+    /*! Replay the next row, returns false if all rows have been
+      replayed. */
+    bool Step(void);
+
+    /*! Replay all rows up to a given time (included), returns the
+      number of rows replayed. */
+    size_t StepUntil(const double time);
+
+    /*! Position all sources on the first row at or after a given
+      time.  State tables are not modified until the next row is
+      replayed. */
+    bool Seek(const double time);
+
+    /*! True when all rows have been replayed */
+    bool IsFinished(void) const;
+
+    inline double GetVirtualTime(void) const {
+        return this->VirtualTime;
+    }
+
+    inline unsigned long long GetNumberOfRowsReplayed(void) const {
+        return this->NumberOfRowsReplayed;
+    }
+
+    /*! Set the maximum number of rows replayed per iteration, the
+      queued commands are processed between iterations */
+    inline void SetBatchSize(const size_t batchSize) {
+        this->BatchSize = (batchSize > 0) ? batchSize : 1;
+    }
+
+    void Startup(void);
+    void Run(void);
+    void Cleanup(void);
+};
+
+CMN_DECLARE_SERVICES_INSTANTIATION(mtsCollectorReplay)
+
+#endif // _mtsCollectorReplay_h
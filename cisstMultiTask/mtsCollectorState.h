@@ -6,7 +6,7 @@
   Author(s):  Min Yang Jung, Anton Deguet
   Created on: 2009-03-20
 
-  (C) Copyright 2009-2011 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -26,6 +26,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstMultiTask/mtsCollectorBase.h>
 #include <cisstMultiTask/mtsCommandVoid.h>
 #include <cisstMultiTask/mtsStateTable.h>
+#include <cisstMultiTask/mtsCollectorColumnarWriter.h>
 
 #include <string>
 
@@ -37,7 +38,8 @@ http://www.cisst.org/cisst/license.txt.
 
   This class provides a way to collect data in the state table without
   loss and make a log file. The type of a log file can be plain text
-  (ascii), csv, or binary.  A state table of which data is to be
+  (ascii), csv, binary or columnar binary (see
+  mtsCollectorColumnarWriter and mtsCollectorColumnarReader).  A state table of which data is to be
   collected can be specified in the constructor.  This is intended for
   future usage where a task can have more than two state tables.
 */
@@ -53,6 +55,9 @@ class CISST_EXPORT mtsCollectorState : public mtsCollectorBase
     typedef struct {
         std::string Name;
         unsigned int ID;
+        /*! Object used to read elements from the state array, see
+          mtsStateArrayBase::Element(index, buffer) */
+        mtsGenericObject * Buffer;
     } SignalElement;
 
     typedef std::vector<SignalElement> RegisteredSignalElementType;
@@ -74,6 +79,17 @@ class CISST_EXPORT mtsCollectorState : public mtsCollectorBase
     mtsComponent * TargetComponent;
     mtsStateTable * TargetStateTable;
 
+    /*! Writer used for COLLECTOR_FILE_FORMAT_BINARY_COLUMNAR,
+      encoding and disk access are performed by the writer's own
+      thread. */
+    mtsCollectorColumnarWriter * ColumnarWriter;
+
+    /*! Create the columnar file, called on first batch */
+    bool OpenColumnarWriter(void);
+
+    /*! Close the columnar file if any, defined in base class */
+    void FlushOutput(void);
+
     /*! Thread-related methods */
     void Run(void);
 
@@ -6,7 +6,7 @@
   Author(s):  Ankur Kapoor, Peter Kazanzides, Anton Deguet
   Created on: 2005-05-02
 
-  (C) Copyright 2005-2014 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2005-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -53,6 +53,11 @@ class CISST_EXPORT mtsCommandQueuedVoid: public mtsCommandVoid
     /*! Queue for return events (to send result to caller) */
     mtsQueue<mtsCommandWriteBase *> FinishedEventQueue;
 
+    /*! Non queued command using the same callable object, used by
+      functions bound to components sharing the same thread (see
+      mtsComponent::GetExecutionContext) */
+    mtsCommandVoid ActualCommand;
+
  private:
     /*! Private copy constructor to prevent copies */
     mtsCommandQueuedVoid(const ThisType & CMN_UNUSED(other));
@@ -72,6 +77,12 @@ class CISST_EXPORT mtsCommandQueuedVoid: public mtsCommandVoid
 
     inline virtual void Allocate(unsigned int CMN_UNUSED(size)) {}
 
+    /*! Get the non queued command, i.e. a command executing the
+      callable object in the caller's thread. */
+    inline virtual mtsCommandVoid * GetActualCommand(void) {
+        return &ActualCommand;
+    }
+
     /*! For a queued command, Execute means queueing the command.
       This method will return mtsExecutionResult::COMMAND_QUEUED if the command
       has been queued; it doesn't mean that the actual has been
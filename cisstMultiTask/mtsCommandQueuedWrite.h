@@ -6,7 +6,7 @@
   Author(s):  Ankur Kapoor, Peter Kazanzides, Anton Deguet
   Created on: 2005-05-02
 
-  (C) Copyright 2005-2014 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2005-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -29,6 +29,9 @@ http://www.cisst.org/cisst/license.txt.
 #define _mtsCommandQueuedWrite_h
 
 #include <cisstMultiTask/mtsCommandQueuedWriteBase.h>
+#include <cisstMultiTask/mtsSharedArgument.h>
+
+#include <typeinfo>
 
 
 /*!
@@ -79,9 +82,7 @@ public:
         const ArgumentQueueType * argumentPrototype = dynamic_cast<const ArgumentQueueType *>(this->GetArgumentPrototype());
         if (argumentPrototype) {
             ArgumentsQueue.SetSize(size, *argumentPrototype);
-            BlockingFlagQueue.SetSize(size, MTS_NOT_BLOCKING);
-            mtsCommandWriteBase *cmd = 0;
-            FinishedEventQueue.SetSize(size, cmd);
+            this->AllocateQueues(size);
         } else {
             CMN_LOG_INIT_ERROR << "Class mtsCommandQueuedWrite: constructor: can't find argument prototype from actual command."
                                << std::endl;
@@ -109,9 +110,7 @@ public:
             const ArgumentQueueType * argumentPrototype = dynamic_cast<const ArgumentQueueType *>(this->GetArgumentPrototype());
             if (argumentPrototype) {
                 ArgumentsQueue.SetSize(size, *argumentPrototype);
-                BlockingFlagQueue.SetSize(size, MTS_NOT_BLOCKING);
-                mtsCommandWriteBase *cmd = 0;
-                FinishedEventQueue.SetSize(size, cmd);
+                this->AllocateQueues(size);
             } else {
                 CMN_LOG_INIT_ERROR << "Class mtsCommandQueuedWrite: constructor: can't find argument prototype from actual command."
                                    << std::endl;
@@ -138,12 +137,14 @@ public:
             return mtsExecutionResult::INVALID_INPUT_TYPE;
         }
         // check if all queues have some space
-        if (ArgumentsQueue.IsFull() || BlockingFlagQueue.IsFull() || FinishedEventQueue.IsFull() || MailBox->IsFull()) {
+        if (ArgumentsQueue.IsFull() || BlockingFlagQueue.IsFull() || FinishedEventQueue.IsFull()
+            || SharedArgumentsQueue.IsFull() || MailBox->IsFull()) {
             CMN_LOG_RUN_WARNING << "Class mtsCommandQueuedWrite: Execute: Queue full for \""
                                 << this->Name << "\" ["
                                 << ArgumentsQueue.IsFull() << "|"
                                 << BlockingFlagQueue.IsFull() << "|"
                                 << FinishedEventQueue.IsFull() << "|"
+                                << SharedArgumentsQueue.IsFull() << "|"
                                 << MailBox->IsFull() << "]"
                                 << std::endl;
             return mtsExecutionResult::COMMAND_ARGUMENT_QUEUE_FULL;
@@ -172,6 +173,17 @@ public:
             cmnThrow("mtsCommandQueuedWrite: Execute: FinishedEventQueue.Put failed");
             return mtsExecutionResult::UNDEFINED;
         }
+        // the argument is not shared, it is in the argument queue
+        mtsSharedArgument * shared = 0;
+        if (!SharedArgumentsQueue.Put(shared)) {
+            CMN_LOG_RUN_ERROR << "Class mtsCommandQueuedWrite: Execute: SharedArgumentsQueue.Put failed for \""
+                              << this->Name << "\"" << std::endl;
+            ArgumentsQueue.Get();       // Remove the argument that was already queued
+            BlockingFlagQueue.Get();    // Remove the blocking flag that was already queued
+            FinishedEventQueue.Get();   // Remove the finished event handler that was already queued
+            cmnThrow("mtsCommandQueuedWrite: Execute: SharedArgumentsQueue.Put failed");
+            return mtsExecutionResult::UNDEFINED;
+        }
         // finally try to queue to mailbox
         if (!MailBox->Write(this)) {
             CMN_LOG_RUN_ERROR << "Class mtsCommandQueuedWrite: Execute: mailbox full for \""
@@ -179,12 +191,25 @@ public:
             ArgumentsQueue.Get();  // pop argument, blocking flag, and finished event from local storage
             BlockingFlagQueue.Get();
             FinishedEventQueue.Get();
+            SharedArgumentsQueue.Get();
             cmnThrow("mtsCommandQueuedWrite: Execute: MailBox.Write failed");
             return mtsExecutionResult::UNDEFINED;
         }
         return mtsExecutionResult::COMMAND_QUEUED;
     }
 
+    /* commented in base class */
+    mtsExecutionResult ExecuteShared(mtsSharedArgument & argument) {
+        // derived classes might process the argument in Execute
+        if (typeid(*this) != typeid(ThisType)) {
+            return BaseType::ExecuteShared(argument);
+        }
+        if (!dynamic_cast<const ArgumentQueueBaseType *>(&(argument.GetArgument()))) {
+            return mtsExecutionResult::INVALID_INPUT_TYPE;
+        }
+        return this->EnqueueShared(argument);
+    }
+
     /* commented in base class */
     const mtsGenericObject * GetArgumentPrototype(void) const {
         return this->ActualCommand->GetArgumentPrototype();
@@ -216,6 +241,15 @@ class CISST_EXPORT mtsCommandQueuedWriteGeneric: public mtsCommandQueuedWriteBas
     /*! Queue to store arguments */
     mtsQueueGeneric ArgumentsQueue;
 
+    /*! Queue the argument, blocking flag and finished event handler.
+      If handoff is not null, the argument is swapped with a free slot
+      of the argument queue instead of copied (see
+      mtsQueueGeneric::PutSwap). */
+    mtsExecutionResult Enqueue(const mtsGenericObject & argument,
+                               mtsGenericObject * handoff,
+                               mtsBlockingType blocking,
+                               mtsCommandWriteBase * finishedEventHandler);
+
 private:
     /*! Private default constructor to prevent use. */
     inline mtsCommandQueuedWriteGeneric(void);
@@ -260,6 +294,20 @@ public:
                                mtsCommandWriteBase *finishedEventHandler);
 
 
+    /*! Queue the argument without copy, the caller gets back the
+      memory of an argument previously processed so large buffers are
+      recycled.  Types that don't support mtsGenericObject::Swap are
+      copied. */
+    mtsExecutionResult ExecuteSwap(mtsGenericObject & argument,
+                                   mtsBlockingType blocking,
+                                   mtsCommandWriteBase * finishedEventHandler);
+
+
+    /*! Queue a reference on the shared argument, derived classes
+      use the default implementation, i.e. copy. */
+    mtsExecutionResult ExecuteShared(mtsSharedArgument & argument);
+
+
     /* commented in base class */
     const mtsGenericObject * GetArgumentPrototype(void) const {
         return this->ActualCommand->GetArgumentPrototype();
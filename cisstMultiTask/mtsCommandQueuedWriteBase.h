@@ -6,7 +6,7 @@
   Author(s):  Ankur Kapoor, Peter Kazanzides, Anton Deguet
   Created on: 2005-05-02
 
-  (C) Copyright 2005-2014 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2005-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -33,6 +33,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstMultiTask/mtsExport.h>
 
 class mtsCommandWriteBase;
+class mtsSharedArgument;
 
 class CISST_EXPORT mtsCommandQueuedWriteBase: public mtsCommandWriteBase {
 protected:
@@ -49,6 +50,13 @@ protected:
         (previously, this was a BlockingFlagQueue). */
     mtsQueue<mtsCommandWriteBase *> FinishedEventQueue;
 
+    /*! Queue of shared arguments, parallel to the blocking flag
+      queue.  A null pointer indicates that the argument has been
+      copied in the argument queue of the derived class, otherwise the
+      command holds a reference on the shared argument until it is
+      de-queued (see ExecuteShared). */
+    mtsQueue<mtsSharedArgument *> SharedArgumentsQueue;
+
     inline mtsCommandQueuedWriteBase(void):
         BaseType("??"),
         MailBox(0),
@@ -57,8 +65,19 @@ protected:
     {
         mtsCommandWriteBase *cmd = 0;
         FinishedEventQueue.SetSize(0, cmd);
+        mtsSharedArgument *shared = 0;
+        SharedArgumentsQueue.SetSize(0, shared);
     }
 
+    /*! Resize the queues used for the blocking flags, finished
+      events and shared arguments. */
+    void AllocateQueues(size_t size);
+
+    /*! Queue a shared argument, used by ExecuteShared in derived
+      classes which don't process the argument before queueing it.
+      The argument queue of the derived class is not used. */
+    mtsExecutionResult EnqueueShared(mtsSharedArgument & argument);
+
 public:
     inline mtsCommandQueuedWriteBase(mtsMailBox * mailBox, mtsCommandWriteBase * actualCommand, size_t size):
         BaseType(actualCommand->GetName()),
@@ -68,11 +87,14 @@ public:
     {
         mtsCommandWriteBase *cmd = 0;
         FinishedEventQueue.SetSize(size, cmd);
+        mtsSharedArgument *shared = 0;
+        SharedArgumentsQueue.SetSize(size, shared);
         this->SetArgumentPrototype(ActualCommand->GetArgumentPrototype());
     }
 
 
-    inline virtual ~mtsCommandQueuedWriteBase() {}
+    /*! Destructor, releases the shared arguments still queued */
+    virtual ~mtsCommandQueuedWriteBase();
 
 
     inline virtual mtsCommandWriteBase * GetActualCommand(void) {
@@ -99,14 +121,32 @@ public:
                                mtsCommandWriteBase *finishedEventHandler) = 0;
 
 
+    /*! Queue a reference on an argument shared with other commands,
+      the argument is not copied.  This is used by multicast commands
+      to send the same payload to many observers.  The default
+      implementation copies the argument using Execute, derived
+      classes queueing the argument as is can use EnqueueShared. */
+    virtual mtsExecutionResult ExecuteShared(mtsSharedArgument & argument);
+
+
     virtual const mtsGenericObject * ArgumentPeek(void) const = 0;
 
 
     virtual mtsGenericObject * ArgumentGet(void) = 0;
 
-    mtsBlockingType BlockingFlagGet(void);
+    /*! Get the blocking flag and finished event handler for the
+      command being de-queued, the blocking flag is always retrieved
+      first by the mailbox. */
+    virtual mtsBlockingType BlockingFlagGet(void);
+
+    virtual mtsCommandWriteBase *FinishedEventGet(void);
 
-    mtsCommandWriteBase *FinishedEventGet(void);
+    /*! Get the shared argument for the command being de-queued, this
+      is called by the mailbox after the blocking flag and finished
+      event.  If the result is not null, the argument queue is not
+      used and the caller must release the shared argument after
+      execution. */
+    mtsSharedArgument * SharedArgumentGet(void);
 
     inline virtual const std::string GetMailBoxName(void) const {
         return this->MailBox ? this->MailBox->GetName() : "NULL";
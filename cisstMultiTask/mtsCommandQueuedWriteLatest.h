@@ -0,0 +1,143 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Define a queued write command keeping only the latest argument
+*/
+
+
+#ifndef _mtsCommandQueuedWriteLatest_h
+#define _mtsCommandQueuedWriteLatest_h
+
+#include <cisstMultiTask/mtsCommandQueuedWrite.h>
+
+#include <atomic>
+
+// Always include last
+#include <cisstMultiTask/mtsExport.h>
+
+/*!
+  \ingroup cisstMultiTask
+
+  Queued write command conflating its arguments, i.e. only the most
+  recent argument is kept and processed once by the receiver.  This is
+  used for commands and event handlers created with the queueing
+  policies MTS_COMMAND_QUEUED_LATEST and MTS_EVENT_QUEUED_LATEST, for
+  example when a fast producer sends measurements to a slow consumer.
+  Instead of filling the mailbox and processing stale values in order,
+  the receiver always gets the latest value and the memory used is
+  bounded.
+
+  The arguments are stored in a triple buffer: the caller writes in
+  the back slot and exchanges it with the middle slot, the receiver
+  exchanges the middle slot with the front slot when it processes the
+  command.  The command is added to the mailbox only if it is not
+  already pending so it uses at most one entry.  As for other queued
+  commands, there should be a single caller thread.  Blocking calls
+  are supported but a blocking call replaced by a more recent call
+  before being processed would never complete, blocking calls should
+  not be mixed with non blocking calls from other callers.
+ */
+class CISST_EXPORT mtsCommandQueuedWriteLatest: public mtsCommandQueuedWriteGeneric
+{
+public:
+    typedef mtsCommandQueuedWriteGeneric BaseType;
+    typedef mtsCommandQueuedWriteLatest ThisType;
+
+protected:
+    enum {LATEST_INDEX_MASK = 3, LATEST_NEW = 4};
+
+    /*! Triple buffer, slots are created from the argument prototype */
+    mtsGenericObject * Slots[3];
+    mtsBlockingType SlotsBlocking[3];
+    mtsCommandWriteBase * SlotsFinishedEvent[3];
+
+    /*! Slot written by the caller */
+    unsigned int BackIndex;
+
+    /*! Slot exchanged between caller and receiver, LATEST_NEW is set
+      if the slot has not been processed yet */
+    std::atomic<unsigned int> MiddleIndex;
+
+    /*! Slot processed by the receiver and flag set if it contains a
+      new argument */
+    unsigned int FrontIndex;
+    bool FrontIsNew;
+
+    /*! Set when the command is in the mailbox */
+    std::atomic<bool> Pending;
+
+    /*! Number of arguments replaced before being processed */
+    std::atomic<unsigned long long> NumberOfConflated;
+
+    /*! Create the slots from the argument prototype if needed */
+    void AllocateSlots(void);
+
+private:
+    /*! Private copy constructor to prevent copies */
+    mtsCommandQueuedWriteLatest(const ThisType & other);
+    ThisType & operator = (const ThisType & other);
+
+public:
+    /*! Constructor, the argument queue of the base class is not used. */
+    mtsCommandQueuedWriteLatest(mtsMailBox * mailBox, mtsCommandWriteBase * actualCommand);
+
+    virtual ~mtsCommandQueuedWriteLatest();
+
+    /*! The size is ignored, there are always three slots */
+    virtual mtsCommandQueuedWriteLatest * Clone(mtsMailBox * mailBox, size_t size) const;
+
+    virtual void Allocate(size_t size);
+
+    virtual void ToStream(std::ostream & outputStream) const;
+
+    mtsExecutionResult Execute(const mtsGenericObject & argument,
+                               mtsBlockingType blocking,
+                               mtsCommandWriteBase * finishedEventHandler);
+
+    mtsExecutionResult ExecuteSwap(mtsGenericObject & argument,
+                                   mtsBlockingType blocking,
+                                   mtsCommandWriteBase * finishedEventHandler);
+
+    /*! Called first by the mailbox when the command is de-queued,
+      takes the latest argument if any. */
+    virtual mtsBlockingType BlockingFlagGet(void);
+
+    virtual mtsCommandWriteBase * FinishedEventGet(void);
+
+    /*! Latest argument, null pointer if the argument has already been
+      processed (i.e. replaced and taken before this command was
+      de-queued). */
+    virtual const mtsGenericObject * ArgumentPeek(void) const;
+
+    virtual mtsGenericObject * ArgumentGet(void);
+
+    inline unsigned long long GetNumberOfConflated(void) const {
+        return this->NumberOfConflated.load(std::memory_order_relaxed);
+    }
+
+protected:
+    mtsExecutionResult Conflate(const mtsGenericObject & argument,
+                                mtsGenericObject * handoff,
+                                mtsBlockingType blocking,
+                                mtsCommandWriteBase * finishedEventHandler);
+};
+
+
+#endif // _mtsCommandQueuedWriteLatest_h
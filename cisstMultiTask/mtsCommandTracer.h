@@ -0,0 +1,187 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Tracing of command latencies across components
+*/
+
+#ifndef _mtsCommandTracer_h
+#define _mtsCommandTracer_h
+
+#include <atomic>
+#include <iostream>
+#include <map>
+#include <string>
+
+// Always include last
+#include <cisstMultiTask/mtsExport.h>
+
+class mtsCommandBase;
+
+/*!
+  \ingroup cisstMultiTask
+
+  Tracer used to find where time is spent when commands are sent from
+  one component to another.  When enabled (see Start), each call is
+  timestamped:
+
+  - FUNCTION_BEGIN and FUNCTION_END when mtsFunction*::Execute (or
+    ExecuteBlocking) is called and returns, on the caller's thread.
+    For blocking commands, FUNCTION_END is recorded after the
+    finished event has been received.
+  - ENQUEUE when the command is written to the receiver's mailbox.
+    If the mailbox is full, ENQUEUE_FAILED is recorded right after
+    and the ENQUEUE is discarded.
+  - DEQUEUE and COMPLETE when mtsMailBox::ExecuteNext starts and ends
+    executing the command, on the receiver's thread.
+  - FINISHED_EVENT when the receiver sends the finished event back to
+    the caller of a blocking command.
+
+  Records are stored in a ring buffer per thread, only the thread
+  itself writes in its buffer so recording is lock free.  The oldest
+  records are overwritten when a buffer is full.  Buffers of threads
+  that ended are reused by new threads, the records of the thread
+  that ended are then discarded.  Records are
+  correlated using the command's address, a queued command executes
+  its calls in order so the n-th ENQUEUE matches the n-th DEQUEUE.
+  This doesn't hold for commands keeping only the latest argument (see
+  mtsCommandQueuedWriteLatest).
+
+  Records can be exported as a Chrome trace (JSON format used by
+  chrome://tracing and Perfetto), calls are shown as slices on the
+  caller's and receiver's threads with flow arrows for the queueing.
+  Statistics per command name can also be computed.  Export and
+  statistics can be used while tracing, records overwritten while
+  they are being copied are skipped.
+ */
+class CISST_EXPORT mtsCommandTracer
+{
+public:
+    typedef enum {FUNCTION_BEGIN, ENQUEUE, DEQUEUE, COMPLETE, FINISHED_EVENT, FUNCTION_END, ENQUEUE_FAILED} PhaseType;
+
+    /*! Duration statistics, in seconds */
+    class Statistic {
+    public:
+        size_t Count;
+        double Total;
+        double Max;
+        inline Statistic(void):
+            Count(0), Total(0.0), Max(0.0)
+        {}
+        inline void Add(const double duration) {
+            Count++;
+            Total += duration;
+            if (duration > Max) {
+                Max = duration;
+            }
+        }
+        inline double Average(void) const {
+            return (Count == 0) ? 0.0 : (Total / Count);
+        }
+    };
+
+    /*! Statistics for a given command name.  Call is the time spent
+      by the caller in mtsFunction*::Execute, Queue the time between
+      ENQUEUE and DEQUEUE, Execution the time between DEQUEUE and
+      COMPLETE and Return the time between the finished event and the
+      end of a blocking call.  QueueFull is the number of calls
+      rejected because the mailbox was full. */
+    class CommandStatistics {
+    public:
+        Statistic Call;
+        Statistic Queue;
+        Statistic Execution;
+        Statistic Return;
+        size_t QueueFull;
+        inline CommandStatistics(void):
+            QueueFull(0)
+        {}
+    };
+    typedef std::map<std::string, CommandStatistics> StatisticsType;
+
+    /*! Records a begin phase when constructed and an end phase when
+      destroyed, used in mtsFunction*::Execute methods. */
+    class Scope {
+        const mtsCommandBase * Command;
+    public:
+        inline Scope(const mtsCommandBase * command):
+            Command(mtsCommandTracer::IsEnabled() ? command : 0)
+        {
+            if (Command) {
+                mtsCommandTracer::Record(FUNCTION_BEGIN, Command);
+            }
+        }
+        inline ~Scope() {
+            if (Command) {
+                mtsCommandTracer::Record(FUNCTION_END, Command);
+            }
+        }
+    };
+
+protected:
+    static std::atomic<bool> Enabled;
+
+public:
+    /*! Start tracing.  The number of records per thread is used for
+      the buffers created after this call, existing buffers keep their
+      size. */
+    static void Start(const size_t recordsPerThread = 65536);
+
+    /*! Stop tracing, existing records are kept. */
+    static void Stop(void);
+
+    static inline bool IsEnabled(void) {
+        return Enabled.load(std::memory_order_relaxed);
+    }
+
+    /*! Record a phase for a command, the command's name is copied
+      (truncated to 47 characters). */
+    static void Record(const PhaseType phase, const mtsCommandBase * command);
+
+    /*! Name used for the current thread in the trace, tasks set the
+      name to the task's name. */
+    static void SetThreadName(const std::string & name);
+
+    /*! Remove all records, this should be used when tracing is
+      stopped. */
+    static void Clear(void);
+
+    /*! Number of ring buffers allocated, i.e. maximum number of
+      threads that recorded at the same time */
+    static size_t GetNumberOfBuffers(void);
+
+    /*! Number of records available */
+    static size_t GetNumberOfRecords(void);
+
+    /*! Number of records overwritten since the last Clear */
+    static unsigned long long GetNumberOfDropped(void);
+
+    /*! Export the records using the Chrome trace event format. */
+    static void ExportChromeTrace(std::ostream & outputStream);
+    static bool ExportChromeTrace(const std::string & fileName);
+
+    /*! Compute statistics per command name */
+    static void GetStatistics(StatisticsType & statistics);
+
+    /*! Human readable summary per command name, durations in
+      microseconds. */
+    static void ToStreamSummary(std::ostream & outputStream);
+};
+
+#endif // _mtsCommandTracer_h
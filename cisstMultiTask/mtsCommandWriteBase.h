@@ -5,7 +5,7 @@
   Author(s):  Ankur Kapoor, Peter Kazanzides, Anton Deguet
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2014 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -79,6 +79,22 @@ public:
     virtual mtsExecutionResult Execute(const mtsGenericObject & argument, mtsBlockingType blocking,
                                        mtsCommandWriteBase * CMN_UNUSED(finishedEventHandler)) = 0;
 
+    /*! Execute with handoff of the argument.  Queued commands exchange
+      the content of the argument with a recycled slot of their queue
+      instead of copying it, the content of the argument is unspecified
+      after the call.  By default, the argument is not modified and
+      Execute is used.
+
+      \param argument The data passed to the operation method
+      \param blocking Indicates whether caller wishes to block until command finishes
+      \param finishedEventHandler Command object to invoke when blocking command is finished
+
+      \result the execution result (mtsExecutionResult) */
+    virtual mtsExecutionResult ExecuteSwap(mtsGenericObject & argument, mtsBlockingType blocking,
+                                           mtsCommandWriteBase * finishedEventHandler) {
+        return this->Execute(argument, blocking, finishedEventHandler);
+    }
+
     /* documented in base class */
     inline size_t NumberOfArguments(void) const {
         return 1;
@@ -6,7 +6,7 @@
   Author(s):  Ankur Kapoor, Peter Kazanzides, Anton Deguet, Min Yang Jung
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2011 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -165,6 +165,13 @@ class CISST_EXPORT mtsComponent: public cmnGenericObject
     /*! Provided interface for component management. */
     mtsInterfaceProvided *InterfaceProvidedToManager;
 
+    /*! Optional list of mailboxes with pending commands, shared by
+      all provided interfaces of the component (except the internal
+      interface used for component management).  When set,
+      ProcessQueuedCommands only processes the mailboxes found in the
+      list.  See mtsTask::EnableMailBoxReadyList. */
+    mtsMailBoxReadyList * MailBoxReadyList;
+
     /*! Default constructor. Protected to prevent creation of a component
       without a name. */
     mtsComponent(void);
@@ -370,6 +377,12 @@ class CISST_EXPORT mtsComponent: public cmnGenericObject
     /*! Get the total number of input interfaces */
     size_t GetNumberOfInterfacesInput(void) const;
 
+    /*! Revision of the list of interfaces, changes each time an
+      interface is added or removed */
+    inline unsigned int GetInterfacesRevision(void) const {
+        return InterfacesRevision;
+    }
+
     /*! Remove a required interface identified by its name */
     bool RemoveInterfaceRequired(const std::string & interfaceRequiredName, const bool skipDisconnect = false);
 
@@ -442,6 +455,15 @@ class CISST_EXPORT mtsComponent: public cmnGenericObject
     const mtsComponentState & GetState(void) const;
     void GetState(mtsComponentState &state) const;
 
+    /*! Execution context, i.e. opaque pointer identifying the thread
+      running the component and processing its queued commands.
+      Components without their own thread return 0 (unknown).  When
+      two different components have the same non null context, the
+      void and write functions of the required interface use the non
+      queued commands while the component providing the commands is
+      active (see mtsInterfaceRequired::BindCommands). */
+    virtual const void * GetExecutionContext(void) const;
+
  protected:
 
     /*! Helper function to wait on a state change, with specified timeout in seconds. */
@@ -481,6 +503,11 @@ class CISST_EXPORT mtsComponent: public cmnGenericObject
     InterfacesInputMapType InterfacesInput;
     //@}
 
+    /*! Incremented each time an interface is added or removed, used
+      by the component manager to avoid registering the same interfaces
+      over and over (see mtsManagerLocal::RegisterInterfaces). */
+    unsigned int InterfacesRevision;
+
     /*! Map of state tables, includes the default StateTable under the
       name "StateTable" */
     typedef cmnNamedMap<mtsStateTable> StateTableMapType;
@@ -541,6 +568,11 @@ class CISST_EXPORT mtsComponent: public cmnGenericObject
 
     bool SetReplayTime(const double time);
 
+    /*! Check if the component is in replay mode, see SetReplayMode */
+    inline bool GetReplayMode(void) const {
+        return this->ReplayMode;
+    }
+
  protected:
 
     bool ReplayMode;
@@ -6,7 +6,7 @@
   Author(s):	Anton Deguet
   Created on:	2007-10-07
 
-  (C) Copyright 2007-2014 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2007-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -40,13 +40,19 @@ typedef enum {MTS_COMPONENT_POLICY, MTS_COMMANDS_SHOULD_NOT_BE_QUEUED, MTS_COMMA
 
 /*! Queueing policy, i.e. what the user would like to do for
   individual commands added using AddCommandVoid or
-  AddCommandWrite as well as event handlers */
-typedef enum {MTS_INTERFACE_COMMAND_POLICY, MTS_COMMAND_QUEUED, MTS_COMMAND_NOT_QUEUED} mtsCommandQueueingPolicy;
+  AddCommandWrite as well as event handlers.  For write commands,
+  MTS_COMMAND_QUEUED_LATEST queues the command but only keeps the most
+  recent argument (see mtsCommandQueuedWriteLatest), other commands
+  are queued as with MTS_COMMAND_QUEUED. */
+typedef enum {MTS_INTERFACE_COMMAND_POLICY, MTS_COMMAND_QUEUED, MTS_COMMAND_NOT_QUEUED, MTS_COMMAND_QUEUED_LATEST} mtsCommandQueueingPolicy;
 
 /*! Queueing policy, i.e. what the user would like to do for
   individual event handlers added using AddEventHandlerVoid or
-  AddEventHandlerWrite. */
-typedef enum {MTS_INTERFACE_EVENT_POLICY, MTS_EVENT_QUEUED, MTS_EVENT_NOT_QUEUED} mtsEventQueueingPolicy;
+  AddEventHandlerWrite.  For write event handlers,
+  MTS_EVENT_QUEUED_LATEST queues the handler but only keeps the most
+  recent payload (see mtsCommandQueuedWriteLatest), void event
+  handlers are queued as with MTS_EVENT_QUEUED. */
+typedef enum {MTS_INTERFACE_EVENT_POLICY, MTS_EVENT_QUEUED, MTS_EVENT_NOT_QUEUED, MTS_EVENT_QUEUED_LATEST} mtsEventQueueingPolicy;
 
 /*! Type for optional functions and interfaces */
 typedef enum {MTS_OPTIONAL, MTS_REQUIRED} mtsRequiredType;
@@ -131,6 +137,7 @@ class mtsTaskFromSignal;
 
 // containers
 class mtsMailBox;
+class mtsMailBoxReadyList;
 class mtsStateTable;
 
 // data collection class
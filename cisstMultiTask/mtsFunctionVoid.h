@@ -41,6 +41,16 @@ class CISST_EXPORT mtsFunctionVoid: public mtsFunctionBase {
       when interfaces get connected. */
     CommandType * Command;
 
+    /*! Non queued command and component providing it.  Used instead
+      of Command while the component is running, see
+      mtsInterfaceRequired::BindCommands. */
+    CommandType * DirectCommand;
+    const mtsComponent * DirectCommandComponent;
+
+    /*! Command to use for the next call, either Command or
+      DirectCommand. */
+    CommandType * CurrentCommand(void) const;
+
  public:
     /*! Default constructor.  Does nothing, use Bind before using. */
     mtsFunctionVoid(const bool isProxy = false);
@@ -61,6 +71,14 @@ class CISST_EXPORT mtsFunctionVoid: public mtsFunctionBase {
     */
     bool Bind(CommandType * command);
 
+    /*! Bind using a queued command and the non queued command it
+      holds.  The non queued command is used while the component
+      providing it is running, the queued command otherwise.  This is
+      used for components executed by the same thread (see
+      mtsComponent::GetExecutionContext). */
+    bool Bind(CommandType * command, CommandType * directCommand,
+              const mtsComponent * directCommandComponent);
+
     /*! Overloaded operator to enable more intuitive syntax
       e.g., Command() instead of Command->Execute(). */
     mtsExecutionResult operator()(void) const { return Execute(); }
@@ -71,7 +89,8 @@ class CISST_EXPORT mtsFunctionVoid: public mtsFunctionBase {
     /*! Blocking call */
     mtsExecutionResult ExecuteBlocking(void) const;
 
-    /*! Access to underlying command object. */
+    /*! Access to underlying command object, i.e. the command used
+      for the next call. */
     mtsCommandVoid * GetCommand(void) const;
 
     // documented in base class
@@ -5,7 +5,7 @@
 
   Author(s):  Peter Kazanzides, Anton Deguet
 
-  (C) Copyright 2007-2014 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2007-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -43,6 +43,16 @@ protected:
       when interfaces get connected. */
     CommandType * Command;
 
+    /*! Non queued command and component providing it.  Used instead
+      of Command while the component is running, see
+      mtsInterfaceRequired::BindCommands. */
+    CommandType * DirectCommand;
+    const mtsComponent * DirectCommandComponent;
+
+    /*! Command to use for the next call, either Command or
+      DirectCommand. */
+    CommandType * CurrentCommand(void) const;
+
 #ifndef SWIG
     template <typename _userType, bool>
     class ConditionalWrap {
@@ -82,6 +92,14 @@ public:
     */
     bool Bind(CommandType * command);
 
+    /*! Bind using a queued command and the non queued command it
+      holds.  The non queued command is used while the component
+      providing it is running, the queued command otherwise.  This is
+      used for components executed by the same thread (see
+      mtsComponent::GetExecutionContext). */
+    bool Bind(CommandType * command, CommandType * directCommand,
+              const mtsComponent * directCommandComponent);
+
     /*! Overloaded operator to enable more intuitive syntax
       e.g., Command(argument) instead of Command->Execute(argument). */
     mtsExecutionResult operator()(const mtsGenericObject & argument) const
@@ -90,6 +108,15 @@ public:
     mtsExecutionResult ExecuteGeneric(const mtsGenericObject & argument) const;
     mtsExecutionResult ExecuteBlockingGeneric(const mtsGenericObject & argument) const;
 
+    /*! Non blocking execution with handoff of the argument.  If the
+      command is queued, the content of the argument is exchanged with
+      a recycled slot of the command's queue (see
+      mtsGenericObject::Swap) and the handler receives the queued
+      object without further copy.  After the call, the content of the
+      argument is unspecified (it's usually a previously sent value)
+      but its memory can be reused for the next call. */
+    mtsExecutionResult ExecuteSwap(mtsGenericObject & argument) const;
+
 #ifndef SWIG
 	/*! Overloaded operator that accepts different argument types. */
     template <class _userType>
@@ -107,7 +134,8 @@ public:
     }
 #endif
 
-    /*! Access to underlying command object. */
+    /*! Access to underlying command object, i.e. the command used
+      for the next call. */
     CommandType * GetCommand(void) const;
 
     /*! Access to the command argument prototype. */
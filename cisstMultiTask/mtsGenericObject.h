@@ -5,7 +5,7 @@
   Author(s):  Anton Deguet
   Created on: 2009-04-13
 
-  (C) Copyright 2009-2018 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -127,6 +127,17 @@ public:
     /*! Binary deserialization */
     virtual void DeSerializeRaw(std::istream & inputStream);
 
+    /*! Exchange the content of this object with the content of
+      another object of the same type.  This is used to hand off large
+      arguments to queued write commands without copying them (see
+      mtsFunctionWrite::ExecuteSwap).  The default implementation
+      doesn't exchange anything and returns false, the caller should
+      then copy the object.  Derived classes with data that can be
+      swapped cheaply (e.g. dynamic vectors) should re-implement this
+      method, check the type of the other object and call
+      SwapGenericObject. */
+    virtual bool Swap(mtsGenericObject & other);
+
     /* documented in base class */
     size_t ScalarNumber(void) const;
     bool ScalarNumberIsFixed(void) const;
@@ -136,10 +147,38 @@ public:
 
     /* documented in base class */
     std::string ScalarDescription(const size_t index, const std::string & userDescription = "") const CISST_THROW(std::out_of_range);
+
+ protected:
+    /*! Exchange the timestamp, automatic timestamp and valid flags
+      with another object, to be used by derived classes implementing
+      Swap. */
+    void SwapGenericObject(mtsGenericObject & other);
 };
 
 template <> void CISST_EXPORT cmnData<mtsGenericObject>::Copy(mtsGenericObject & data, const mtsGenericObject & source);
 
+/*! Timestamp, automatic timestamp and valid flags, used by derived
+  classes generated with cisstDataGenerator */
+template <>
+class cmnDataBinaryFixedSize<mtsGenericObject>
+{
+public:
+    enum {IS_FIXED = 1};
+    enum {BYTE_SIZE = sizeof(double) + 2 * sizeof(bool)};
+
+    inline static char * SerializeBinary(const mtsGenericObject & data, char * buffer) {
+        buffer = cmnDataBinaryFixedSize<double>::SerializeBinary(data.Timestamp(), buffer);
+        buffer = cmnDataBinaryFixedSize<bool>::SerializeBinary(data.AutomaticTimestamp(), buffer);
+        return cmnDataBinaryFixedSize<bool>::SerializeBinary(data.Valid(), buffer);
+    }
+
+    inline static const char * DeSerializeBinary(mtsGenericObject & data, const char * buffer) {
+        buffer = cmnDataBinaryFixedSize<double>::DeSerializeBinary(data.Timestamp(), buffer);
+        buffer = cmnDataBinaryFixedSize<bool>::DeSerializeBinary(data.AutomaticTimestamp(), buffer);
+        return cmnDataBinaryFixedSize<bool>::DeSerializeBinary(data.Valid(), buffer);
+    }
+};
+
 template <> void CISST_EXPORT cmnData<mtsGenericObject>::SerializeBinary(const mtsGenericObject & data, std::ostream & outputStream) CISST_THROW(std::runtime_error);
 
 template <> void CISST_EXPORT cmnData<mtsGenericObject>::DeSerializeBinary(mtsGenericObject & data, std::istream & inputStream,
@@ -5,7 +5,7 @@
   Author(s):  Ankur Kapoor, Anton Deguet, Peter Kazanzides
   Created on: 2006-05-05
 
-  (C) Copyright 2006-2016 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2006-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -32,6 +32,8 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstMultiTask/mtsForwardDeclarations.h>
 #include <cisstMultiTask/mtsGenericObject.h>
 
+#include <algorithm>
+
 // Always include last!
 #include <cisstMultiTask/mtsExport.h>
 
@@ -443,6 +445,19 @@ public:
         cmnDeSerializeRaw(inputStream, this->Data);
     }
 
+    /*! Exchange content with another proxy of the same type.  Relies
+        on std::swap for the actual type, i.e. no copy for standard
+        containers. */
+    inline bool Swap(mtsGenericObject & other) {
+        ThisType * otherProxy = dynamic_cast<ThisType *>(&other);
+        if (!otherProxy) {
+            return false;
+        }
+        std::swap(this->Data, otherProxy->Data);
+        this->SwapGenericObject(other);
+        return true;
+    }
+
     /*! To stream method.  Uses the default << operator as defined for
         the actual type. */
     inline virtual void ToStream(std::ostream & outputStream) const {
@@ -558,6 +558,16 @@ class CISST_EXPORT mtsInterfaceProvided: public mtsInterface {
       interface for thread safety. */
     size_t ProcessMailBoxes(void);
 
+    /*! Set the ready list used by the mailboxes of all end-user
+      interfaces created after this call.  When a ready list is used,
+      the owner component processes queued commands using the ready
+      list instead of calling ProcessMailBoxes.  See
+      mtsTask::EnableMailBoxReadyList. */
+    void SetMailBoxReadyList(mtsMailBoxReadyList * readyList);
+
+    /*! Get the ready list used by end-user interfaces, 0 if none. */
+    mtsMailBoxReadyList * GetMailBoxReadyList(void) const;
+
     /*! Send a human readable description of the interface. */
     void ToStream(std::ostream & outputStream) const;
 
@@ -639,6 +649,9 @@ protected: // PK TEMP
     /*! Size to be used for mailboxes */
     size_t MailBoxSize;
 
+    /*! Ready list shared by mailboxes of end-user interfaces (optional) */
+    mtsMailBoxReadyList * MailBoxReadyList;
+
     /*! Size to be used for argument queues */
     size_t ArgumentQueuesSize;
 
@@ -6,7 +6,7 @@
   Author(s):  Peter Kazanzides, Anton Deguet
   Created on: 2008-11-13
 
-  (C) Copyright 2008-2013 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2008-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -34,6 +34,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstMultiTask/mtsCommandWrite.h>
 #include <cisstMultiTask/mtsCommandQueuedVoid.h>
 #include <cisstMultiTask/mtsCommandQueuedWrite.h>
+#include <cisstMultiTask/mtsCommandQueuedWriteLatest.h>
 #include <cisstMultiTask/mtsInterfaceCommon.h>
 
 #include <cisstMultiTask/mtsFunctionBase.h>
@@ -241,6 +242,14 @@ class CISST_EXPORT mtsInterfaceRequired: public mtsInterface
     void BlockingCommandExecutedHandler(void);
     void BlockingCommandReturnExecutedHandler(void);
 
+    /*! Check if the components owning this interface and the
+      provided interface are executed by the same thread, see
+      mtsComponent::GetExecutionContext.  Returns false for
+      connections of a component to itself.  The functions check if
+      the component owning the provided interface is running when
+      they are called (see mtsFunctionVoid::Bind). */
+    bool SharesExecutionContext(const mtsInterfaceProvided * interfaceProvided) const;
+
     bool BindCommands(const mtsInterfaceProvided * interfaceProvided);
     bool DetachCommands(void); // used by mtsManagerComponentClient
 
@@ -386,6 +395,10 @@ class CISST_EXPORT mtsInterfaceRequired: public mtsInterface
         return this->AddEventHandlerVoid(callable, eventName, queueingPolicy);
     }
 
+    /*! Add a write event handler.  If the queueing policy is
+      MTS_EVENT_QUEUED_LATEST, only the most recent payload is kept
+      until the handler is executed, older payloads not yet processed
+      are discarded (see mtsCommandQueuedWriteLatest). */
     template <class __classType, class __argumentType>
         inline mtsCommandWriteBase * AddEventHandlerWrite(void (__classType::*method)(const __argumentType &),
                                                           __classType * classInstantiation,
@@ -415,7 +428,9 @@ inline mtsCommandWriteBase * mtsInterfaceRequired::AddEventHandlerWrite(void (__
     mtsCommandWriteBase * actualCommand =
         new mtsCommandWrite<__classType, __argumentType>(method, classInstantiation, eventName, __argumentType());
     if (queued) {
-        if (MailBox)
+        if (MailBox && (queueingPolicy == MTS_EVENT_QUEUED_LATEST))
+            EventHandlersWrite.AddItem(eventName, new mtsCommandQueuedWriteLatest(MailBox, actualCommand));
+        else if (MailBox)
             EventHandlersWrite.AddItem(eventName,  new mtsCommandQueuedWrite<__argumentType>(MailBox, actualCommand, this->ArgumentQueuesSize));
         else
             CMN_LOG_CLASS_INIT_ERROR << "No mailbox for queued event handler write \"" << eventName << "\"" << std::endl;
@@ -441,7 +456,12 @@ inline mtsCommandWriteBase * mtsInterfaceRequired::AddEventHandlerWriteGeneric(v
     if (queued) {
         // PK: check for MailBox overlaps with code in UseQueueBasedOnInterfacePolicy
         if (MailBox) {
-            mtsCommandQueuedWriteGeneric *tmp = new mtsCommandQueuedWriteGeneric(MailBox, actualCommand, this->ArgumentQueuesSize);
+            mtsCommandQueuedWriteGeneric *tmp;
+            if (queueingPolicy == MTS_EVENT_QUEUED_LATEST) {
+                tmp = new mtsCommandQueuedWriteLatest(MailBox, actualCommand);
+            } else {
+                tmp = new mtsCommandQueuedWriteGeneric(MailBox, actualCommand, this->ArgumentQueuesSize);
+            }
             if (argumentPrototype)
                 tmp->SetArgumentPrototype(argumentPrototype);
             EventHandlersWrite.AddItem(eventName,  tmp);
@@ -0,0 +1,94 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Fixed memory histogram for time intervals
+*/
+
+#ifndef _mtsIntervalHistogram_h
+#define _mtsIntervalHistogram_h
+
+#include <cstddef>
+
+#include <cisstMultiTask/mtsExport.h>
+
+/*!
+  \ingroup cisstMultiTask
+
+  Histogram of time intervals used to compute percentiles (e.g. p99)
+  of task periods and compute times, see mtsIntervalStatistics.
+
+  Values are recorded in nanoseconds using log-linear buckets (similar
+  to HDR histograms).  Values below 64 ns use one bucket per
+  nanosecond.  Above, each power of 2 is divided in 32 buckets so the
+  relative error on a percentile is less than 1/32 (about 3%).  The
+  highest bucket covers values up to about 275 seconds, larger values
+  are counted in the last bucket.  Memory is allocated with the
+  object, Add doesn't allocate and runs in constant time.
+*/
+class CISST_EXPORT mtsIntervalHistogram
+{
+public:
+    enum {
+        /*! Number of bits for the linear part of buckets */
+        SUB_BUCKET_BITS = 6,
+        SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS,
+        SUB_BUCKET_HALF_COUNT = SUB_BUCKET_COUNT / 2,
+        /*! Maximum shift, highest bucket is for 2^(SUB_BUCKET_BITS + MAXIMUM_SHIFT) ns */
+        MAXIMUM_SHIFT = 32,
+        NUMBER_OF_BUCKETS = SUB_BUCKET_COUNT + MAXIMUM_SHIFT * SUB_BUCKET_HALF_COUNT
+    };
+
+    typedef unsigned long long ValueType;
+
+private:
+    unsigned int Counts[NUMBER_OF_BUCKETS];
+    unsigned int NumberOfSamples;
+    ValueType MinValue;
+    ValueType MaxValue;
+
+    /*! Index of bucket for a value in nanoseconds */
+    static size_t BucketIndex(const ValueType value);
+
+    /*! Highest value, in nanoseconds, counted in a given bucket */
+    static ValueType BucketUpperBound(const size_t index);
+
+public:
+    mtsIntervalHistogram(void);
+
+    /*! Remove all samples */
+    void Reset(void);
+
+    /*! Add a sample, in seconds.  Negative values are counted as 0. */
+    void Add(const double valueInSeconds);
+
+    /*! Number of samples added since last reset */
+    inline unsigned int GetNumberOfSamples(void) const {
+        return NumberOfSamples;
+    }
+
+    /*! Value, in seconds, below which a given percentage of the
+      samples fall, e.g. Percentile(99.0).  The value returned is the
+      upper bound of the bucket containing the percentile, bounded by
+      the minimum and maximum values added.  Returns 0 if there is no
+      sample. */
+    double Percentile(const double percentage) const;
+};
+
+#endif // _mtsIntervalHistogram_h
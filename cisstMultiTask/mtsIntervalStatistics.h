@@ -5,7 +5,7 @@
   Author(s):  Marcin Balicki, Anton Deguet
   Created on: 2010-03-31
 
-  (C) Copyright 2010-2018 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2010-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -32,6 +32,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstCommon/cmnGenericObjectProxy.h>
 #include <cisstOSAbstraction/osaTimeServer.h>
 #include <cisstMultiTask/mtsTaskManager.h>
+#include <cisstMultiTask/mtsIntervalHistogram.h>
 
 #include <cisstMultiTask/mtsExport.h>
 
@@ -41,6 +42,21 @@ http://www.cisst.org/cisst/license.txt.
    Calculate the statistics (avg,std,min,max) on the vector of data that is added one sample at time.
    AddSample checks if the statistics need to be recalculated after a given period elapses (eg 1sec).
 
+   Percentiles (50, 90, 99 and 99.9) for the period and compute time
+   can be computed using fixed size histograms (see
+   mtsIntervalHistogram).  Percentiles are disabled by default, see
+   SetPercentilesEnabled.  The histograms are allocated when
+   percentiles are enabled and are not copied, copies only contain
+   the results of the last interval.  This avoids storing histograms
+   in each element of the state table history.  If Update is called
+   on a copy with percentiles enabled, new histograms are allocated.
+
+   The text output is the same as before percentiles were introduced
+   unless percentiles are enabled.  The serialized data is also the
+   same unless percentiles are enabled.  In this case, the statistics
+   interval is replaced by NaN used as a tag, followed by the actual
+   statistics interval and the percentiles.
+
  */
 class CISST_EXPORT mtsIntervalStatistics : public mtsGenericObject {
 
@@ -93,6 +109,46 @@ public:
         return mComputeTimeMax;
     }
 
+    /*! The 50th percentile (median) of the measured period. */
+    inline const double & PeriodP50(void) const {
+        return mPeriodP50;
+    }
+
+    /*! The 90th percentile of the measured period. */
+    inline const double & PeriodP90(void) const {
+        return mPeriodP90;
+    }
+
+    /*! The 99th percentile of the measured period. */
+    inline const double & PeriodP99(void) const {
+        return mPeriodP99;
+    }
+
+    /*! The 99.9th percentile of the measured period. */
+    inline const double & PeriodP999(void) const {
+        return mPeriodP999;
+    }
+
+    /*! The 50th percentile (median) of the compute time. */
+    inline const double & ComputeTimeP50(void) const {
+        return mComputeTimeP50;
+    }
+
+    /*! The 90th percentile of the compute time. */
+    inline const double & ComputeTimeP90(void) const {
+        return mComputeTimeP90;
+    }
+
+    /*! The 99th percentile of the compute time. */
+    inline const double & ComputeTimeP99(void) const {
+        return mComputeTimeP99;
+    }
+
+    /*! The 99.9th percentile of the compute time. */
+    inline const double & ComputeTimeP999(void) const {
+        return mComputeTimeP999;
+    }
+
     /*! Get number of samples used for time window */
     inline const unsigned int & NumberOfSamples(void) const {
         return mNumberOfSamples;
@@ -114,11 +170,48 @@ public:
         return mStatisticsInterval;
     }
 
+    /*! Enable or disable the computation of percentiles.  Enabling
+      percentiles allocates the histograms so this should be called
+      while configuring the component, not while Update is called by
+      another thread.  Percentiles are 0 when disabled. */
+    void SetPercentilesEnabled(const bool enabled);
+
+    /*! Check if percentiles are computed. */
+    inline const bool & PercentilesEnabled(void) const {
+        return mPercentilesEnabled;
+    }
+
     /*! Add one sample to compute statistics */
     void Update(const double sample, const double computeTime);
 
 private:
 
+    /*! Histograms used to compute percentiles.  Copying an object
+      doesn't copy the histograms and assigning an object keeps the
+      histograms of the left operand. */
+    class Histograms {
+    public:
+        mtsIntervalHistogram * Period;
+        mtsIntervalHistogram * ComputeTime;
+        inline Histograms(void): Period(0), ComputeTime(0) {}
+        inline Histograms(const Histograms &): Period(0), ComputeTime(0) {}
+        inline Histograms & operator = (const Histograms &) { return *this; }
+        inline ~Histograms() {
+            delete Period;
+            delete ComputeTime;
+        }
+        inline void Allocate(void) {
+            if (!Period) {
+                Period = new mtsIntervalHistogram;
+            }
+            if (!ComputeTime) {
+                ComputeTime = new mtsIntervalHistogram;
+            }
+        }
+    };
+
+    Histograms mHistograms;
+
     /*! Internal variables for statistics calculations */
     double mPeriodSum;
     double mPeriodSumSquares;
@@ -144,11 +237,20 @@ private:
     double mComputeTimeStdDev;
     double mComputeTimeMin;
     double mComputeTimeMax;
+    double mPeriodP50;
+    double mPeriodP90;
+    double mPeriodP99;
+    double mPeriodP999;
+    double mComputeTimeP50;
+    double mComputeTimeP90;
+    double mComputeTimeP99;
+    double mComputeTimeP999;
     unsigned int mNumberOfSamples;
     unsigned int mNumberOfOverruns;
 
     /*! configuration. */
     double mStatisticsInterval;
+    bool mPercentilesEnabled;
 
 
 public:
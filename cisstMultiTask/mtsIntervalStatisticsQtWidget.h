@@ -5,7 +5,7 @@
   Author(s):  Anton Deguet
   Created on: 2013-07-14
 
-  (C) Copyright 2013-2017 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2013-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -44,12 +44,15 @@ protected:
     QTableWidgetItem * QTWIPeriodAverage;
     QTableWidgetItem * QTWIPeriodHz;
     QTableWidgetItem * QTWIPeriodRange;
+    QTableWidgetItem * QTWIPeriodPercentiles;
     QTableWidgetItem * QTWILoadAverage;
     QTableWidgetItem * QTWILoadPercent;
     QTableWidgetItem * QTWILoadRange;
+    QTableWidgetItem * QTWILoadPercentiles;
     QTableWidgetItem * QTWIInterval;
     QTableWidgetItem * QTWINumberOfSamples;
     QTableWidgetItem * QTWINumberOfOverruns;
+    QTableWidgetItem * QTWIPercentiles;
 };
 
 // Widget with a component, can be used directly with cisstMultiTask component manager
@@ -6,7 +6,7 @@
   Author(s):  Peter Kazanzides
   Created on: 2007-09-05
 
-  (C) Copyright 2007-2014 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2007-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -27,6 +27,7 @@ http://www.cisst.org/cisst/license.txt.
 #define _mtsMailBox_h
 
 #include <cisstMultiTask/mtsQueue.h>
+#include <cisstMultiTask/mtsMailBoxReadyList.h>
 
 // Always include last
 #include <cisstMultiTask/mtsExport.h>
@@ -35,6 +36,8 @@ class mtsExecutionResult;
 
 class CISST_EXPORT mtsMailBox
 {
+    friend class mtsMailBoxReadyList;
+
     mtsQueue<mtsCommandBase *> CommandQueue;
 
     /*! Name provided for logs */
@@ -46,6 +49,17 @@ class CISST_EXPORT mtsMailBox
       thread. */
     mtsCallableVoidBase * PostCommandQueuedCallable;
 
+    /*! Optional ready list shared by all mailboxes of a task.  When
+      set, the mailbox is scheduled on the ready list after a command
+      is queued and the ready list's doorbell replaces the post
+      command queued callable. */
+    mtsMailBoxReadyList * ReadyList;
+
+    /*! Flag and link used by mtsMailBoxReadyList, a scheduled mailbox
+      is not added again to the ready list. */
+    std::atomic<bool> ReadyScheduled;
+    mtsMailBox * ReadyNext;
+
     /*! Command executed after a command is de-queued.  This is
       used for blocking commands in order to trigger an event sent
       back to the caller.  The caller's required interface needs to
@@ -66,6 +80,10 @@ class CISST_EXPORT mtsMailBox
     void TriggerFinishedEventIfNeeded(const std::string &commandName, mtsCommandWriteBase *finishedEvent,
                                       mtsGenericObject *resultPointer, const mtsExecutionResult &result) const;
 
+    /*! Record the end of execution and the finished event, if any,
+      when the command tracer is enabled (see mtsCommandTracer). */
+    void TraceCompletion(const mtsCommandBase * command, const mtsCommandWriteBase * finishedEvent) const;
+
 public:
     mtsMailBox(const std::string & name,
                size_t size,
@@ -73,6 +91,14 @@ public:
 
     ~mtsMailBox(void);
 
+    /*! Set the ready list to use to notify the owner that commands
+      have been queued.  This method is not thread safe and should be
+      used before any command is queued. */
+    void SetReadyList(mtsMailBoxReadyList * readyList);
+
+    /*! Get the ready list used by this mailbox, 0 if none */
+    mtsMailBoxReadyList * GetReadyList(void) const;
+
     /*! Get the mailbox's name */
     const std::string & GetName(void) const;
 
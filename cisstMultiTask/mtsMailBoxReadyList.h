@@ -0,0 +1,133 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Defines a list of mailboxes with pending commands.
+*/
+
+
+#ifndef _mtsMailBoxReadyList_h
+#define _mtsMailBoxReadyList_h
+
+#include <atomic>
+#include <string>
+
+#include <cisstOSAbstraction/osaMutex.h>
+
+#include <cisstMultiTask/mtsForwardDeclarations.h>
+
+// Always include last
+#include <cisstMultiTask/mtsExport.h>
+
+class mtsMailBox;
+
+/*!
+  \ingroup cisstMultiTask
+
+  Multiple producers, single consumer list of mailboxes with pending
+  commands.  A task can use a single ready list for all the mailboxes
+  of its provided interfaces so that processing the queued commands
+  only touches the mailboxes that actually received commands instead
+  of walking all end-user interfaces.
+
+  Each mailbox remains a single producer, single consumer queue so
+  commands from a given client are still executed in FIFO order.
+  When a command is written in a mailbox that is not already
+  scheduled, the mailbox is pushed on the ready list (lock-free).  If
+  the ready list was empty, the doorbell callable is executed.  This
+  is used by mtsTaskFromSignal to wake up its thread only once per
+  batch of commands instead of once per command.
+
+  Schedule can be called from any thread.  ExecuteAll must be called
+  by the thread owning the mailboxes (consumer).  Remove can be called
+  from any thread, it waits for the consumer to finish the current
+  batch of commands.  It can also be called by a command executed by
+  ExecuteAll, as long as the mailbox removed is not the one executing
+  the command.
+*/
+class CISST_EXPORT mtsMailBoxReadyList
+{
+    /*! Top of the intrusive stack of scheduled mailboxes, linked
+      using mtsMailBox::ReadyNext. */
+    std::atomic<mtsMailBox *> Top;
+
+    /*! Name provided for logs */
+    std::string Name;
+
+    /*! Callable executed when a mailbox is scheduled on an empty list. */
+    mtsCallableVoidBase * DoorBellCallable;
+
+    /*! Mutex locked by ExecuteAll and Remove so a mailbox can't be
+      removed while the consumer processes it. */
+    osaMutex ConsumerMutex;
+
+    /*! Mailboxes taken by ExecuteAll and not processed yet */
+    mtsMailBox * Pending;
+
+    /*! Take all scheduled mailboxes, returns them in the order they
+      have been scheduled. */
+    mtsMailBox * TakeAll(void);
+
+    /*! Push back a list of mailboxes, used if an exception is thrown
+      while processing or when removing a mailbox. */
+    void PushAll(mtsMailBox * first);
+
+    /*! Remove a mailbox from a list of mailboxes linked using
+      mtsMailBox::ReadyNext, returns the new first mailbox. */
+    static mtsMailBox * Unlink(mtsMailBox * first, mtsMailBox * mailBox);
+
+private:
+    /*! Ready lists can't be copied */
+    mtsMailBoxReadyList(const mtsMailBoxReadyList & other);
+    mtsMailBoxReadyList & operator = (const mtsMailBoxReadyList & other);
+
+public:
+    mtsMailBoxReadyList(const std::string & name,
+                        mtsCallableVoidBase * doorBellCallable = 0);
+
+    ~mtsMailBoxReadyList(void);
+
+    /*! Get the ready list's name */
+    const std::string & GetName(void) const;
+
+    /*! Set the callable executed when the list goes from empty to
+      non empty. */
+    void SetDoorBellCallable(mtsCallableVoidBase * doorBellCallable);
+
+    /*! Add a mailbox to the list of mailboxes with pending commands
+      if it is not already scheduled.  Called by mtsMailBox::Write,
+      i.e. by the client's thread.  Returns true if the mailbox has
+      been added. */
+    bool Schedule(mtsMailBox * mailBox);
+
+    /*! Execute all queued commands for all scheduled mailboxes.
+      Mailboxes are processed in the order they have been scheduled.
+      Returns the number of commands executed. */
+    size_t ExecuteAll(void);
+
+    /*! Remove a mailbox from the list, used before a mailbox is
+      removed (e.g. end-user interface removed).  Can be called from
+      any thread. */
+    void Remove(mtsMailBox * mailBox);
+
+    /*! Returns true if no mailbox is scheduled. */
+    bool IsEmpty(void) const;
+};
+
+#endif // _mtsMailBoxReadyList_h
@@ -6,7 +6,7 @@
   Author(s):  Min Yang Jung
   Created on: 2009-11-12
 
-  (C) Copyright 2009-2019 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -114,6 +114,14 @@ protected:
     typedef std::map<ConnectionIDType, mtsConnection> ConnectionMapType;
     ConnectionMapType ConnectionMap;
 
+    /*! Index of the connection map by required interface:
+        key=(interface UID of the required interface, see GetInterfaceUID),
+        value=(connection id).  A required interface can only have one
+        connection so this is used to find a connection without
+        scanning the connection map.  Updated along with ConnectionMap. */
+    typedef std::map<std::string, ConnectionIDType> ConnectionByClientMapType;
+    ConnectionByClientMapType ConnectionByClient;
+
     /*! Instance of connected local component manager. Note that the global
         component manager communicates with the only one instance of
         mtsManagerLocalInterface regardless of connection type (standalone
@@ -5,7 +5,7 @@
   Author(s):  Min Yang Jung
   Created on: 2009-12-07
 
-  (C) Copyright 2009-2019 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -64,6 +64,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstMultiTask/mtsManagerLocalInterface.h>
 #include <cisstMultiTask/mtsManagerGlobalInterface.h>
 
+#include <map>
 #include <stack>
 
 #include <cisstMultiTask/mtsExport.h>
@@ -166,6 +167,15 @@ private:
     /*! Mutex to use ComponentMap safely */
     osaMutex ComponentMapChange;
 
+    /*! Revision of the interfaces of each component when they were last
+        registered to the global component manager: key is component
+        name, value is mtsComponent::GetInterfacesRevision.  Used by
+        RegisterInterfaces to skip components whose interfaces haven't
+        changed. */
+    typedef std::map<std::string, unsigned int> InterfacesRegisteredMapType;
+    InterfacesRegisteredMapType InterfacesRegistered;
+    osaMutex InterfacesRegisteredChange;
+
     /*! Mutex for thread-safe transition of configuration from standalone mode to
         networked mode */
     static osaMutex ConfigurationChange;
@@ -272,6 +282,26 @@ protected:
     bool RegisterInterfaces(mtsComponent * component);
     bool RegisterInterfaces(const std::string & componentName);
 
+    /*! \brief Register a single required interface, used when a
+               required interface has just been added to a component
+               with many interfaces (e.g. manager component client).
+        \param component Component object instance
+        \param interfaceName Name of the new required interface
+        \param previousRevision Revision of the component's interfaces
+               before the interface was added */
+    bool RegisterInterfaceRequired(mtsComponent * component, const std::string & interfaceName,
+                                   const unsigned int previousRevision);
+
+    /*! \brief Get all components sorted so that servers come before
+               their clients.  Dependencies are found using the
+               connections of the required interfaces, connections to
+               the manager components are ignored.  Components with
+               circular dependencies are placed after all the others,
+               in the component map order.  Caller should hold
+               ComponentMapChange.
+        \param components Sorted list of components */
+    void GetComponentsInStartupOrder(std::vector<mtsComponent *> & components) const;
+
     // PK: following two methods were part of Connect method
     ConnectionIDType ConnectSetup(const std::string & clientComponentName, const std::string & clientInterfaceRequiredName,
                                   const std::string & serverComponentName, const std::string & serverInterfaceProvidedName);
@@ -434,14 +464,19 @@ public:
     bool WaitForStateAll(mtsComponentState desiredState, double timeout = 3.0 * cmn_minute) const;
 
     /*! \brief Create all components. If a component is of type mtsTask,
-      mtsTask::Create() is called internally. */
+      mtsTask::Create() is called internally.  Components are created
+      in dependency order, servers before their clients (see
+      GetComponentsInStartupOrder).  Tasks with their own thread
+      initialize in parallel, use WaitForStateAll to wait for all of
+      them. */
     void CreateAll(void);
 
     /*! Call CreateAll method followed by WaitForStateAll. */
     bool CreateAllAndWait(double timeoutInSeconds);
 
     /*! \brief Start all components. If a component is of type mtsTask,
-      mtsTask::Start() is called internally. */
+      mtsTask::Start() is called internally.  Components are started in
+      dependency order so a server is started before its clients. */
     void StartAll(void);
 
     /*! Call StartAll method followed by WaitForStateAll. */
@@ -6,7 +6,7 @@
   Author(s):	Anton Deguet
   Created on:   2009-04-29
 
-  (C) Copyright 2009-2014 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -128,6 +128,19 @@ public:
         MatrixType::DeSerializeRaw(inputStream);
     }
 
+    /*! Exchange the matrix memory with another matrix of the same type,
+      no element is copied. */
+    bool Swap(mtsGenericObject & other)
+    {
+        ThisType * otherTyped = dynamic_cast<ThisType *>(&other);
+        if (!otherTyped) {
+            return false;
+        }
+        MatrixType::SwapData(*otherTyped);
+        mtsGenericObject::SwapGenericObject(other);
+        return true;
+    }
+
 };
 
 
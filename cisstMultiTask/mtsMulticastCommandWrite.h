@@ -5,7 +5,7 @@
   Author(s):  Ankur Kapoor, Peter Kazanzides, Anton Deguet
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2014 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -74,11 +74,7 @@ public:
             return mtsExecutionResult::INVALID_INPUT_TYPE;
         }
         // if cast succeeded call using actual type
-        size_t index;
-        const size_t commandsSize = Commands.size();
-        for (index = 0; index < commandsSize; index++) {
-            Commands[index]->Execute(*data, MTS_NOT_BLOCKING);
-        }
+        this->ExecuteAll(*data);
         return mtsExecutionResult::COMMAND_SUCCEEDED;
     }
 
@@ -120,11 +116,7 @@ public:
             return mtsExecutionResult::INVALID_INPUT_TYPE;
         }
         // if cast succeeded call using actual type
-        size_t index;
-        const size_t commandsSize = Commands.size();
-        for (index = 0; index < commandsSize; index++) {
-            Commands[index]->Execute(argument, MTS_NOT_BLOCKING);
-        }
+        this->ExecuteAll(argument);
         return mtsExecutionResult::COMMAND_SUCCEEDED;
     }
 
@@ -6,7 +6,7 @@
   Author(s):  Ankur Kapoor, Peter Kazanzides, Anton Deguet
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2013 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -34,11 +34,21 @@ http://www.cisst.org/cisst/license.txt.
 // Always include last
 #include <cisstMultiTask/mtsExport.h>
 
+class mtsCommandQueuedWriteBase;
+class mtsSharedArgument;
+
 /*!
   \ingroup cisstMultiTask
 
   This class contains a vector of two or more command objects.
   The primary use of this class is to send events to all observers.
+
+  When two or more observers use queued commands, the argument is
+  copied once in a reference counted buffer (see mtsSharedArgument)
+  and each queued command only stores a pointer.  Buffers are
+  recycled once all observers have processed them.  As for other
+  commands, the multicast command should be executed by a single
+  thread, i.e. the component owning the event.
  */
 class CISST_EXPORT mtsMulticastCommandWriteBase: public mtsCommandWriteBase
 {
@@ -49,14 +59,37 @@ public:
 protected:
     VectorType Commands;
 
+    /*! Queued commands, parallel to Commands with null pointers for
+      commands which are not queued. */
+    typedef std::vector<mtsCommandQueuedWriteBase *> QueuedVectorType;
+    QueuedVectorType QueuedCommands;
+    size_t NumberOfQueuedCommands;
+
+    /*! Shared arguments created so far, the multicast command holds
+      one reference on each of them. */
+    typedef std::vector<mtsSharedArgument *> SharedArgumentsType;
+    SharedArgumentsType SharedArguments;
+    size_t SharedArgumentsIndex;
+
+    /*! Find a shared argument not used by any queued command and copy
+      the argument in it, creates a new one if all are in use. */
+    mtsSharedArgument * GetSharedArgument(const mtsGenericObject & argument);
+
+    /*! Execute all commands, the argument type must have been checked
+      by the caller. */
+    void ExecuteAll(const mtsGenericObject & argument);
+
 public:
     /*! Default constructor. Does nothing. */
     mtsMulticastCommandWriteBase(const std::string & name):
-        BaseType(name)
+        BaseType(name),
+        NumberOfQueuedCommands(0),
+        SharedArgumentsIndex(0)
     {}
 
-    /*! Default destructor. Does nothing. */
-    ~mtsMulticastCommandWriteBase() {}
+    /*! Destructor, releases the shared arguments.  Arguments still
+      queued are deleted by the last queued command using them. */
+    ~mtsMulticastCommandWriteBase();
 
     /*! Add a command to the composite. */
     virtual bool AddCommand(BaseType * command);
@@ -68,6 +101,12 @@ public:
     virtual mtsExecutionResult Execute(const mtsGenericObject & argument,
                                        mtsBlockingType blocking) = 0;
 
+    /*! Number of shared arguments allocated, i.e. maximum number of
+      events queued at once for the queued observers. */
+    inline size_t GetNumberOfSharedArguments(void) const {
+        return SharedArguments.size();
+    }
+
     /* documented in base class */
     virtual void ToStream(std::ostream & outputStream) const;
 };
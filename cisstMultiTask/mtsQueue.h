@@ -6,7 +6,7 @@
   Author(s):  Peter Kazanzides, Anton Deguet
   Created on: 2007-09-05
 
-  (C) Copyright 2007-2010 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2007-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -27,14 +27,68 @@ http://www.cisst.org/cisst/license.txt.
 #ifndef _mtsQueue_h
 #define _mtsQueue_h
 
+#include <atomic>
+
 #include <cisstMultiTask/mtsGenericObjectProxy.h>
 
+/*! Size in bytes used to separate the producer and consumer indices
+  of mtsQueue and mtsQueueGeneric.  64 bytes is the cache line size of
+  most x86 and ARM processors. */
+#ifndef MTS_QUEUE_CACHE_LINE_SIZE
+#define MTS_QUEUE_CACHE_LINE_SIZE 64
+#endif
+
+/*!
+  \ingroup cisstMultiTask
+
+  Index used by mtsQueue and mtsQueueGeneric.  Value is the index
+  shared between the producer and the consumer while Cache is the last
+  known value of the opposite index, only accessed by the thread
+  owning this index.  The padding guarantees that the producer's and
+  consumer's indices never share a cache line, regardless of the
+  alignment of the queue itself (no false sharing).
+*/
+class mtsQueueIndex
+{
+public:
+    typedef size_t index_type;
+
+    std::atomic<index_type> Value;
+    mutable index_type Cache;
+
+    inline mtsQueueIndex(void):
+        Value(0),
+        Cache(0)
+    {}
+
+    inline void Reset(void) {
+        Value.store(0, std::memory_order_relaxed);
+        Cache = 0;
+    }
+
+private:
+    char Padding[MTS_QUEUE_CACHE_LINE_SIZE];
+
+    /*! Indices can't be copied */
+    mtsQueueIndex(const mtsQueueIndex & other);
+    mtsQueueIndex & operator = (const mtsQueueIndex & other);
+};
+
+
 /*!
   \ingroup cisstMultiTask
 
-  Defines a queue that can be accessed in a thread-safe manner,
-  assuming that there is only one reader and one writer and that
-  pointer updates are atomic.
+  Defines a lock-free queue that can be accessed in a thread-safe
+  manner, assuming that there is only one reader (consumer) and one
+  writer (producer).  The head index is only modified by the writer
+  and the tail index is only modified by the reader.  Elements are
+  published with release semantics and observed with acquire
+  semantics so the queue is safe on weakly ordered processors (ARM,
+  PowerPC).  The writer and reader indices are padded to avoid false
+  sharing.
+
+  Put, PutMany, IsFull must be called by the writer.  Peek, Get,
+  GetMany must be called by the reader.  SetSize is not thread safe.
 */
 template<class _elementType>
 class mtsQueue
@@ -50,10 +104,10 @@ public:
 
 protected:
     pointer Data;
-    pointer Head;
-    pointer Tail;
-    pointer Sentinel;  // end marker
     size_type Size;
+    char Padding[MTS_QUEUE_CACHE_LINE_SIZE];
+    mtsQueueIndex Head; // written by producer, Head.Cache is last known tail
+    mtsQueueIndex Tail; // written by consumer, Tail.Cache is last known head
 
     // private method, can only be used once by constructor.  Doesn't support resize!
     void Allocate(size_type size, const_reference value) {
@@ -68,18 +122,35 @@ protected:
             this->Data = 0;
         }
         // head == tail implies empty queue
-        this->Head = this->Data;
-        this->Tail = this->Data;
-        this->Sentinel = this->Data + this->Size;
+        this->Head.Reset();
+        this->Tail.Reset();
     }
 
+    /*! Index following a given index, wraps around end of buffer */
+    inline index_type Next(index_type index) const {
+        index++;
+        return (index >= this->Size) ? 0 : index;
+    }
+
+    /*! Number of slots the producer can use, given head and tail */
+    inline size_type Free(index_type head, index_type tail) const {
+        return (tail > head) ? (tail - head - 1) : (this->Size - 1 - head + tail);
+    }
+
+    /*! Number of slots the consumer can read, given head and tail */
+    inline size_type Used(index_type head, index_type tail) const {
+        return (head >= tail) ? (head - tail) : (this->Size - tail + head);
+    }
+
+private:
+    /*! Queues can't be copied */
+    mtsQueue(const mtsQueue & other);
+    mtsQueue & operator = (const mtsQueue & other);
+
 public:
 
     inline mtsQueue(void):
         Data(0),
-        Head(0),
-        Tail(0),
-        Sentinel(0),
         Size(0)
     {}
 
@@ -95,7 +166,7 @@ public:
 
 
     /*! Sets the size of the queue (destructive, i.e. won't preserve
-      previously queued elements). */
+      previously queued elements).  This method is not thread safe. */
     inline void SetSize(size_type size, const_reference value) {
         delete [] Data;
         this->Allocate(size, value);
@@ -112,27 +183,28 @@ public:
       of slots used. */
     inline size_type GetAvailable(void) const
     {
-        ptrdiff_t available = Head - Tail;
-        if (available < 0) {
-            available += Size;
+        if (this->Size == 0) {
+            return 0;
         }
-        return available;
+        return this->Used(this->Head.Value.load(std::memory_order_acquire),
+                          this->Tail.Value.load(std::memory_order_acquire));
     }
 
 
     /*! Returns true if queue is full. */
     inline bool IsFull(void) const {
-        pointer oneAfterHead = this->Head + 1;
-        if (oneAfterHead >= this->Sentinel) {
-            oneAfterHead = this->Data;
+        if (this->Size == 0) {
+            return true;
         }
-        return oneAfterHead == this->Tail;
+        return this->Next(this->Head.Value.load(std::memory_order_acquire))
+            == this->Tail.Value.load(std::memory_order_acquire);
     }
 
 
     /*! Returns true if queue is empty. */
     inline bool IsEmpty(void) const {
-        return Head == Tail;
+        return this->Head.Value.load(std::memory_order_acquire)
+            == this->Tail.Value.load(std::memory_order_acquire);
     }
 
 
@@ -145,19 +217,54 @@ public:
     //then we use the ProxyBase instead, so that we can also accept ProxyRef objects.
     inline const_pointer Put(const typename mtsGenericTypesUnwrap<value_type>::BaseType &newObject)
     {
-        pointer newHead = this->Head + 1;
-        // test if end of buffer (same as IsFull method)
-        if (newHead >= this->Sentinel) {
-            newHead = this->Data;
+        if (this->Size == 0) {
+            return 0;
         }
-        // test if full
-        if (newHead == this->Tail) {
-            return 0;    // queue full
+        const index_type head = this->Head.Value.load(std::memory_order_relaxed);
+        const index_type newHead = this->Next(head);
+        // test if full, only reload tail from consumer if needed
+        if (newHead == this->Head.Cache) {
+            this->Head.Cache = this->Tail.Value.load(std::memory_order_acquire);
+            if (newHead == this->Head.Cache) {
+                return 0;    // queue full
+            }
         }
-        // queue new object and move head
-        *(this->Head) = newObject;
-        this->Head = newHead;
-        return this->Head;
+        // queue new object and publish head
+        this->Data[head] = newObject;
+        this->Head.Value.store(newHead, std::memory_order_release);
+        return this->Data + head;
+    }
+
+
+    /*! Copy multiple objects to the queue.  The head is published once
+      for the whole batch.
+      \param newObjects array of objects to be copied
+      \param count number of objects in the array
+      \result Number of objects actually queued, can be less than count if the queue is full
+    */
+    inline size_type PutMany(const_pointer newObjects, size_type count)
+    {
+        if ((this->Size == 0) || (count == 0)) {
+            return 0;
+        }
+        index_type head = this->Head.Value.load(std::memory_order_relaxed);
+        size_type available = this->Free(head, this->Head.Cache);
+        if (available < count) {
+            this->Head.Cache = this->Tail.Value.load(std::memory_order_acquire);
+            available = this->Free(head, this->Head.Cache);
+        }
+        if (count > available) {
+            count = available;
+        }
+        size_type index;
+        for (index = 0; index < count; index++) {
+            this->Data[head] = newObjects[index];
+            head = this->Next(head);
+        }
+        if (count > 0) {
+            this->Head.Value.store(head, std::memory_order_release);
+        }
+        return count;
     }
 
 
@@ -166,33 +273,74 @@ public:
         \result Pointer to top element in queue (use iterator instead?)
      */
     inline pointer Peek(void) const {
-        if (this->IsEmpty()) {
-            return 0;
+        const index_type tail = this->Tail.Value.load(std::memory_order_relaxed);
+        if (tail == this->Tail.Cache) {
+            this->Tail.Cache = this->Head.Value.load(std::memory_order_acquire);
+            if (tail == this->Tail.Cache) {
+                return 0;
+            }
         }
-        return this->Tail;
+        return this->Data + tail;
     }
 
 
-    /*! Pop the next object to be read from the queue.
+    /*! Pop the next object to be read from the queue.  The element
+        pointed to remains valid until the producer wraps around the
+        queue.
         \result Pointer to element just popped (use iterator instead?)
      */
     inline pointer Get(void) {
-        if (this->IsEmpty()) {
-            return 0;
-        }
-        pointer result = this->Tail;
-        this->Tail++;
-        if (this->Tail >= this->Sentinel) {
-            this->Tail = this->Data;
+        pointer result = this->Peek();
+        if (result) {
+            this->Tail.Value.store(this->Next(static_cast<index_type>(result - this->Data)),
+                                   std::memory_order_release);
         }
         return result;
     }
 
+
+    /*! Pop multiple objects from the queue.  Objects are copied to the
+      destination array and the slots are released to the producer
+      once for the whole batch.
+      \param destination array to copy the objects to
+      \param maxCount maximum number of objects to retrieve
+      \result Number of objects actually retrieved
+    */
+    inline size_type GetMany(pointer destination, size_type maxCount) {
+        if ((this->Size == 0) || (maxCount == 0)) {
+            return 0;
+        }
+        index_type tail = this->Tail.Value.load(std::memory_order_relaxed);
+        size_type available = this->Used(this->Tail.Cache, tail);
+        if (available < maxCount) {
+            this->Tail.Cache = this->Head.Value.load(std::memory_order_acquire);
+            available = this->Used(this->Tail.Cache, tail);
+        }
+        if (maxCount > available) {
+            maxCount = available;
+        }
+        size_type index;
+        for (index = 0; index < maxCount; index++) {
+            destination[index] = this->Data[tail];
+            tail = this->Next(tail);
+        }
+        if (maxCount > 0) {
+            this->Tail.Value.store(tail, std::memory_order_release);
+        }
+        return maxCount;
+    }
 };
 
 
 
+/*!
+  \ingroup cisstMultiTask
 
+  Single producer, single consumer lock-free queue of generic objects.
+  Objects are created using the class services of the prototype
+  provided to SetSize or the constructor, i.e. all elements have the
+  same dynamic type.  See mtsQueue for thread safety rules.
+*/
 class mtsQueueGeneric
 {
 public:
@@ -207,10 +355,10 @@ public:
 protected:
     const cmnClassServicesBase * ClassServices;
     pointer * Data;
-    pointer * Head;
-    pointer * Tail;
-    pointer * Sentinel;  // end marker
     size_type Size;
+    char Padding[MTS_QUEUE_CACHE_LINE_SIZE];
+    mtsQueueIndex Head; // written by producer, Head.Cache is last known tail
+    mtsQueueIndex Tail; // written by consumer, Tail.Cache is last known head
 
     // private method, can only be used once by constructor.  Doesn't support resize!
     void Allocate(size_type size, const_reference value) {
@@ -233,9 +381,8 @@ protected:
             this->Data = 0;
         }
         // head == tail implies empty queue
-        this->Head = this->Data;
-        this->Tail = this->Data;
-        this->Sentinel = this->Data + this->Size;
+        this->Head.Reset();
+        this->Tail.Reset();
     }
 
     void Free(void) {
@@ -247,14 +394,32 @@ protected:
         this->Data = 0;
     }
 
+    /*! Index following a given index, wraps around end of buffer */
+    inline index_type Next(index_type index) const {
+        index++;
+        return (index >= this->Size) ? 0 : index;
+    }
+
+    /*! Number of slots the producer can use, given head and tail */
+    inline size_type FreeSlots(index_type head, index_type tail) const {
+        return (tail > head) ? (tail - head - 1) : (this->Size - 1 - head + tail);
+    }
+
+    /*! Number of slots the consumer can read, given head and tail */
+    inline size_type Used(index_type head, index_type tail) const {
+        return (head >= tail) ? (head - tail) : (this->Size - tail + head);
+    }
+
+private:
+    /*! Queues can't be copied */
+    mtsQueueGeneric(const mtsQueueGeneric & other);
+    mtsQueueGeneric & operator = (const mtsQueueGeneric & other);
+
 public:
 
     inline mtsQueueGeneric(void):
         ClassServices(0),
         Data(0),
-        Head(0),
-        Tail(0),
-        Sentinel(0),
         Size(1)
     {}
 
@@ -274,7 +439,7 @@ public:
 
 
     /*! Sets the size of the queue (destructive, i.e. won't preserve
-        previously queued elements). */
+        previously queued elements).  This method is not thread safe. */
     inline void SetSize(size_type size, const_reference value) {
         if (this->ClassServices != 0) { // if non zero, it has already been set
             if (this->ClassServices != value.Services()) {
@@ -303,27 +468,22 @@ public:
       of slots used. */
     inline size_type GetAvailable(void) const
     {
-        ptrdiff_t available = Head - Tail;
-        if (available < 0) {
-            available += Size;
-        }
-        return available;
+        return this->Used(this->Head.Value.load(std::memory_order_acquire),
+                          this->Tail.Value.load(std::memory_order_acquire));
     }
 
 
     /*! Returns true if queue is full. */
     inline bool IsFull(void) const {
-        pointer * oneAfterHead = this->Head + 1;
-        if (oneAfterHead >= this->Sentinel) {
-            oneAfterHead = this->Data;
-        }
-        return oneAfterHead == this->Tail;
+        return this->Next(this->Head.Value.load(std::memory_order_acquire))
+            == this->Tail.Value.load(std::memory_order_acquire);
     }
 
 
     /*! Returns true if queue is empty. */
     inline bool IsEmpty(void) const {
-        return Head == Tail;
+        return this->Head.Value.load(std::memory_order_acquire)
+            == this->Tail.Value.load(std::memory_order_acquire);
     }
 
 
@@ -332,24 +492,96 @@ public:
       \result Pointer to element in queue (use iterator instead?)
     */
     inline const_pointer Put(const_reference newObject) {
-        pointer * newHead = this->Head + 1;
-        // test if end of buffer (same as IsFull method)
-        if (newHead >= this->Sentinel) {
-            newHead = this->Data;
+        if (!this->Data) {
+            return 0;
         }
-        // test if full
-        if (newHead == this->Tail) {
-            return 0;    // queue full
+        const index_type head = this->Head.Value.load(std::memory_order_relaxed);
+        const index_type newHead = this->Next(head);
+        // test if full, only reload tail from consumer if needed
+        if (newHead == this->Head.Cache) {
+            this->Head.Cache = this->Tail.Value.load(std::memory_order_acquire);
+            if (newHead == this->Head.Cache) {
+                return 0;    // queue full
+            }
         }
         // queue new object and move head
         // using in place new to make sure copy constructor is used
-        if (!this->ClassServices->Create(*(this->Head), newObject)) {
-            // if Create fails, it does not modify the input parameter (this->Head)
+        if (!this->ClassServices->Create(this->Data[head], newObject)) {
+            // if Create fails, it does not modify the input parameter (this->Data[head])
             CMN_LOG_RUN_ERROR << "mtsQueueGeneric::Put failed for " << newObject.Services()->GetName() << std::endl;
             return 0;
         }
-        this->Head = newHead;
-        return *(this->Head);
+        this->Head.Value.store(newHead, std::memory_order_release);
+        return this->Data[head];
+    }
+
+
+    /*! Hand an object off to the queue.  The content of the object is
+      exchanged with the content of the free slot (see
+      mtsGenericObject::Swap) so the caller gets back the memory of an
+      object previously consumed, i.e. the free slots of the queue are
+      used as a pool of recycled buffers.  If the object type doesn't
+      support swap, the object is copied as in Put.
+      \param in reference to the object to be handed off, content is
+      unspecified after the call
+      \result Pointer to element in queue
+    */
+    inline const_pointer PutSwap(reference newObject) {
+        if (!this->Data) {
+            return 0;
+        }
+        const index_type head = this->Head.Value.load(std::memory_order_relaxed);
+        const index_type newHead = this->Next(head);
+        if (newHead == this->Head.Cache) {
+            this->Head.Cache = this->Tail.Value.load(std::memory_order_acquire);
+            if (newHead == this->Head.Cache) {
+                return 0;    // queue full
+            }
+        }
+        if ((this->Data[head]->Services() != newObject.Services())
+            || !this->Data[head]->Swap(newObject)) {
+            if (!this->ClassServices->Create(this->Data[head], newObject)) {
+                CMN_LOG_RUN_ERROR << "mtsQueueGeneric::PutSwap failed for " << newObject.Services()->GetName() << std::endl;
+                return 0;
+            }
+        }
+        this->Head.Value.store(newHead, std::memory_order_release);
+        return this->Data[head];
+    }
+
+
+    /*! Copy multiple objects to the queue.  The head is published once
+      for the whole batch.  Copy stops at the first object that can't
+      be created in place.
+      \param newObjects array of pointers on objects to be copied
+      \param count number of objects in the array
+      \result Number of objects actually queued
+    */
+    inline size_type PutMany(const const_pointer * newObjects, size_type count) {
+        if (!this->Data || (count == 0)) {
+            return 0;
+        }
+        index_type head = this->Head.Value.load(std::memory_order_relaxed);
+        size_type available = this->FreeSlots(head, this->Head.Cache);
+        if (available < count) {
+            this->Head.Cache = this->Tail.Value.load(std::memory_order_acquire);
+            available = this->FreeSlots(head, this->Head.Cache);
+        }
+        if (count > available) {
+            count = available;
+        }
+        size_type index;
+        for (index = 0; index < count; index++) {
+            if (!this->ClassServices->Create(this->Data[head], *(newObjects[index]))) {
+                CMN_LOG_RUN_ERROR << "mtsQueueGeneric::PutMany failed for " << newObjects[index]->Services()->GetName() << std::endl;
+                break;
+            }
+            head = this->Next(head);
+        }
+        if (index > 0) {
+            this->Head.Value.store(head, std::memory_order_release);
+        }
+        return index;
     }
 
 
@@ -358,30 +590,68 @@ public:
         \result Pointer to top element in queue (use iterator instead?)
      */
     inline pointer Peek(void) const {
-        if (this->IsEmpty()) {
-            return 0;
+        const index_type tail = this->Tail.Value.load(std::memory_order_relaxed);
+        if (tail == this->Tail.Cache) {
+            this->Tail.Cache = this->Head.Value.load(std::memory_order_acquire);
+            if (tail == this->Tail.Cache) {
+                return 0;
+            }
         }
-        return *(this->Tail);
+        return this->Data[tail];
     }
 
 
-    /*! Pop the next object to be read from the queue.
+    /*! Pop the next object to be read from the queue.  The object
+        pointed to remains valid until the producer wraps around the
+        queue.
         \result Pointer to element just popped (use iterator instead?)
      */
     inline pointer Get(void) {
-        if (this->IsEmpty()) {
+        const index_type tail = this->Tail.Value.load(std::memory_order_relaxed);
+        if (tail == this->Tail.Cache) {
+            this->Tail.Cache = this->Head.Value.load(std::memory_order_acquire);
+            if (tail == this->Tail.Cache) {
+                return 0;
+            }
+        }
+        pointer result = this->Data[tail];
+        this->Tail.Value.store(this->Next(tail), std::memory_order_release);
+        return result;
+    }
+
+
+    /*! Pop multiple objects from the queue.  Pointers on the queued
+      objects are copied to the destination array, they remain valid
+      until the producer wraps around the queue.
+      \param destination array of pointers to fill
+      \param maxCount maximum number of objects to retrieve
+      \result Number of objects actually retrieved
+    */
+    inline size_type GetMany(pointer * destination, size_type maxCount) {
+        if (!this->Data || (maxCount == 0)) {
             return 0;
         }
-        pointer result = *(this->Tail);
-        this->Tail++;
-        if (this->Tail >= this->Sentinel) {
-            this->Tail = this->Data;
+        index_type tail = this->Tail.Value.load(std::memory_order_relaxed);
+        size_type available = this->Used(this->Tail.Cache, tail);
+        if (available < maxCount) {
+            this->Tail.Cache = this->Head.Value.load(std::memory_order_acquire);
+            available = this->Used(this->Tail.Cache, tail);
         }
-        return result;
+        if (maxCount > available) {
+            maxCount = available;
+        }
+        size_type index;
+        for (index = 0; index < maxCount; index++) {
+            destination[index] = this->Data[tail];
+            tail = this->Next(tail);
+        }
+        if (maxCount > 0) {
+            this->Tail.Value.store(tail, std::memory_order_release);
+        }
+        return maxCount;
     }
 
 };
 
 
 #endif // _mtsQueue_h
-
@@ -0,0 +1,93 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Defines a reference counted argument shared by queued commands
+*/
+
+#ifndef _mtsSharedArgument_h
+#define _mtsSharedArgument_h
+
+#include <cisstMultiTask/mtsGenericObject.h>
+
+#include <atomic>
+
+// Always include last
+#include <cisstMultiTask/mtsExport.h>
+
+/*!
+  \ingroup cisstMultiTask
+
+  Immutable copy of a command argument shared by multiple queued
+  commands.  This is used by mtsMulticastCommandWriteBase to copy an
+  event payload once and queue a pointer in the argument queue of
+  each observer instead of a full copy per observer.
+
+  The object is deleted when the last reference is released.  The
+  creator keeps one reference so the object can be recycled: when
+  the creator holds the only reference, no queued command uses the
+  argument anymore and it can be overwritten with Set.
+ */
+class CISST_EXPORT mtsSharedArgument
+{
+protected:
+    std::atomic<size_t> ReferenceCount;
+    mtsGenericObject * Argument;
+
+    /*! Use Release */
+    ~mtsSharedArgument();
+
+private:
+    /*! Private copy constructor to prevent copies */
+    mtsSharedArgument(const mtsSharedArgument & other);
+    mtsSharedArgument & operator = (const mtsSharedArgument & other);
+
+public:
+    /*! Constructor, creates a copy of the argument using dynamic
+      creation.  The reference count is set to one. */
+    mtsSharedArgument(const mtsGenericObject & argument);
+
+    /*! Check if the copy of the argument could be created */
+    inline bool IsValid(void) const {
+        return (this->Argument != 0);
+    }
+
+    inline const mtsGenericObject & GetArgument(void) const {
+        return *(this->Argument);
+    }
+
+    /*! Replace the argument, this should only be used when the caller
+      holds the only reference.  Returns false if the types don't
+      match. */
+    bool Set(const mtsGenericObject & argument);
+
+    inline void AddReference(void) {
+        this->ReferenceCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /*! Release a reference, the object is deleted when there is no
+      reference left. */
+    void Release(void);
+
+    inline size_t GetReferenceCount(void) const {
+        return this->ReferenceCount.load(std::memory_order_acquire);
+    }
+};
+
+#endif // _mtsSharedArgument_h
@@ -6,7 +6,7 @@
   Author(s):  Peter Kazanzides
   Created on: 2013-08-06
 
-  (C) Copyright 2013-2014 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2013-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -28,6 +28,7 @@ http://www.cisst.org/cisst/license.txt.
 #define _mtsSocketProxyClient_h
 
 #include <cisstOSAbstraction/osaSocket.h>
+#include <cisstOSAbstraction/osaSharedMemoryRing.h>
 #include <cisstMultiTask/mtsTaskContinuous.h>
 
 #include <cisstMultiTask/mtsSocketProxyCommon.h>
@@ -80,6 +81,20 @@ class CISST_EXPORT mtsSocketProxyClient : public mtsTaskContinuous
 
     mtsSocketProxyInitData ServerData;
 
+    /*! Shared memory used instead of the socket when the server is on
+        the same computer (see SOCKET_PROXY_VERSION 1).  Commands are
+        sent in the server's ring and responses and events are received
+        in the client's ring. */
+    bool UseSharedMemory;
+    osaSharedMemoryRing SharedMemoryRequests;
+    osaSharedMemoryRing SharedMemoryResponses;
+    /*! Identifier assigned by the server, 0 if shared memory is not used */
+    unsigned long long SharedMemoryClientId;
+
+    /*! Attach to the server's shared memory if the server is on the same
+        computer.  Returns false if the socket should be used. */
+    bool AttachSharedMemory(void);
+
     // For memory cleanup
     std::vector<mtsCommandBase *> EventGenerators;
 
@@ -98,9 +113,18 @@ class CISST_EXPORT mtsSocketProxyClient : public mtsTaskContinuous
     // For use by MulticastCommandVoidProxy and MulticastCommandWriteProxy
     mtsCommandWriteBase *EventEnableCommand;
     mtsCommandWriteBase *EventDisableCommand;
-    void EventEnable(const std::string &eventName, const char *handle);
+    void EventEnable(const std::string &eventName, const char *handle, const std::string &argumentClassName = "");
     void EventDisable(const std::string &eventName, const char *handle);
-    
+
+    /*! Events received in compact format (see SOCKET_PROXY_VERSION 2), the
+        event identifier is the index in CompactEvents.  The command used to
+        enable compact events is null if the server doesn't support them. */
+    mtsCommandWriteBase *EventEnableCompactCommand;
+    std::vector<mtsCommandBase *> CompactEvents;
+    unsigned short CompactEventsSequence;
+    bool CompactEventsReceived;
+    void ProcessCompactEvents(const std::string &message);
+
     void CheckForEvents(double timeoutInSec);
 
     friend class CommandWrapperBase;
@@ -112,8 +136,11 @@ class CISST_EXPORT mtsSocketProxyClient : public mtsTaskContinuous
         \param name Name of the client proxy component
         \param ip IP address for corresponding server proxy
         \param port Port for corresponding server proxy (UDP socket)
+        \param useSharedMemory Use shared memory instead of the socket if the
+        server is on the same computer
     */
-    mtsSocketProxyClient(const std::string &name, const std::string &ip, short port);
+    mtsSocketProxyClient(const std::string &name, const std::string &ip, short port,
+                         bool useSharedMemory = true);
 
     mtsSocketProxyClient(const mtsSocketProxyClientConstructorArg &arg);
 
@@ -129,11 +156,26 @@ class CISST_EXPORT mtsSocketProxyClient : public mtsTaskContinuous
 
     void Cleanup(void);
 
+    /*! True if messages are exchanged with the server using shared memory */
+    inline bool IsUsingSharedMemory(void) const {
+        return (SharedMemoryClientId != 0);
+    }
+
     // Following used by command wrappers
     bool CheckForEventsImmediate(double timeoutInSec);
     bool Serialize(const mtsGenericObject & originalObject, std::string & serializedObject);
     bool DeSerialize(const std::string & serializedObject, mtsGenericObject & originalObject);
     mtsGenericObject * DeSerialize(const std::string & serializedObject);
+    bool DeSerializeRaw(const char * serializedObject, size_t length, mtsGenericObject & originalObject);
+
+    /*! Send a message to the server using shared memory if attached, the socket otherwise */
+    bool SendToServer(const char *buffer, size_t length);
+    bool SendToServer(const std::string &buffer);
+
+    /*! Serialize the argument after the header and send to the server.  When
+        shared memory is used, the argument is serialized directly in the ring
+        if possible. */
+    bool SendToServer(const char *header, size_t headerLength, const mtsGenericObject &arg);
 };
 
 CMN_DECLARE_SERVICES_INSTANTIATION(mtsSocketProxyClient)
@@ -6,7 +6,7 @@
   Author(s):  Peter Kazanzides
   Created on: 2013-09-08
 
-  (C) Copyright 2013-2014 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2013-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -39,8 +39,16 @@ class mtsFunctionQualifiedRead;
 
 namespace mtsSocketProxy {
 
-    const unsigned int SOCKET_PROXY_VERSION = 0;
+    // Version 1 adds the shared memory transport for clients on the same computer
+    // Version 2 adds compact event messages (see CompactEventHeader)
+    const unsigned int SOCKET_PROXY_VERSION = 2;
     const unsigned int SOCKET_PROXY_PACKET_SIZE = 512;
+    // Size of the shared memory rings, in bytes
+    const unsigned int SOCKET_PROXY_SHARED_MEMORY_SIZE = 1024 * 1024;
+    // Size of the client identifier sent before each message in shared memory
+    const unsigned int SOCKET_PROXY_SHARED_MEMORY_ID_SIZE = sizeof(unsigned long long);
+    // First character of a message containing compact events
+    const char SOCKET_PROXY_COMPACT_EVENTS = '#';
 
 };
 
@@ -76,6 +84,32 @@ struct CISST_EXPORT CommandHandle {
     bool operator != (const CommandHandle & other) const;
 };
 
+// Header of a compact event. Compact events are used once the client has negotiated an
+// event identifier and the argument type (see mtsSocketProxyServer::EventEnableCompact).
+// The header is followed by the raw serialized argument (no class services), multiple
+// events can be sent in the same message after the SOCKET_PROXY_COMPACT_EVENTS character.
+struct CISST_EXPORT CompactEventHeader {
+    unsigned short eventId;
+    unsigned short sequence;     // per client, used to detect lost events
+    unsigned int length;         // size of the serialized argument
+
+    // Size of serialized version of the CompactEventHeader
+    enum {COMPACT_EVENT_HEADER_SIZE = 2*sizeof(unsigned short) + sizeof(unsigned int) };
+
+    CompactEventHeader() : eventId(0), sequence(0), length(0) {}
+    CompactEventHeader(unsigned short id, unsigned short seq, unsigned int len) :
+        eventId(id), sequence(seq), length(len) {}
+    ~CompactEventHeader() {}
+
+    // Serializes the header, make sure the buffer is at least COMPACT_EVENT_HEADER_SIZE.
+    // Returns number of bytes serialized.
+    int ToString(char *str) const;
+
+    // Deserializes the header. Returns number of bytes deserialized (COMPACT_EVENT_HEADER_SIZE
+    // on success, 0 if the buffer is too small).
+    int FromString(const char *str, size_t size);
+};
+
 class CISST_EXPORT mtsSocketProxyInitData : public mtsGenericObject
 {
     CMN_DECLARE_SERVICES(CMN_NO_DYNAMIC_CREATION, CMN_LOG_ALLOW_DEFAULT);
@@ -91,13 +125,17 @@ class CISST_EXPORT mtsSocketProxyInitData : public mtsGenericObject
     char getHandleWriteReturn[CommandHandle::COMMAND_HANDLE_STRING_SIZE];
     char eventEnable[CommandHandle::COMMAND_HANDLE_STRING_SIZE];
     char eventDisable[CommandHandle::COMMAND_HANDLE_STRING_SIZE];
+    // Name of the server's shared memory ring, empty if not available (version 1)
+    char sharedMemoryName[64];
+    // Handle used to enable compact events (version 2)
+    char eventEnableCompact[CommandHandle::COMMAND_HANDLE_STRING_SIZE];
 
 public:
     mtsSocketProxyInitData();
     mtsSocketProxyInitData(unsigned int psize, mtsFunctionRead *gid, mtsFunctionQualifiedRead *ghv,
                            mtsFunctionQualifiedRead *ghr, mtsFunctionQualifiedRead *ghw, mtsFunctionQualifiedRead *ghqr,
                            mtsFunctionQualifiedRead *ghvr, mtsFunctionQualifiedRead *ghwr,
-                           mtsFunctionWrite *ee, mtsFunctionWrite *ed);
+                           mtsFunctionWrite *ee, mtsFunctionWrite *ed, mtsFunctionWrite *eec = 0);
     ~mtsSocketProxyInitData() {}
 
     unsigned int InterfaceVersion(void) const { return version; }
@@ -111,6 +149,9 @@ public:
     const char *GetHandleWriteReturn(void) const { return getHandleWriteReturn; }
     const char *EventEnable(void) const { return eventEnable; }
     const char *EventDisable(void) const { return eventDisable; }
+    const char *SharedMemoryName(void) const { return sharedMemoryName; }
+    const char *EventEnableCompact(void) const { return eventEnableCompact; }
+    void SetSharedMemoryName(const std::string &name);
 
     void SerializeRaw(std::ostream & outputStream) const;
     void DeSerializeRaw(std::istream & inputStream);
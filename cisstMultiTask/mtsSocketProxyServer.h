@@ -6,7 +6,7 @@
   Author(s):  Peter Kazanzides
   Created on: 2013-08-06
 
-  (C) Copyright 2013-2014 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2013-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -28,6 +28,7 @@ http://www.cisst.org/cisst/license.txt.
 #define _mtsSocketProxyServer_h
 
 #include <cisstOSAbstraction/osaSocket.h>
+#include <cisstOSAbstraction/osaSharedMemoryRing.h>
 #include <cisstMultiTask/mtsTaskContinuous.h>
 
 #include <cisstMultiTask/mtsForwardDeclarations.h>
@@ -116,6 +117,42 @@ class CISST_EXPORT mtsSocketProxyServer : public mtsTaskContinuous
     // List of connected clients
     ClientMapType                     ClientMap;
 
+    /*! Ring used by clients on the same computer to send commands,
+        see SOCKET_PROXY_VERSION 1. Each message starts with the
+        client identifier assigned when the client attached its own
+        ring, used for the responses and events. */
+    osaSharedMemoryRing SharedMemory;
+
+    /*! Clients using shared memory, identified by their pseudo address
+        "shm:<identifier>" in ClientMap and event senders */
+    struct SharedMemoryClient {
+        osaSharedMemoryRing *Ring;
+        osaIPandPort Address;
+    };
+    typedef std::map<unsigned long long, SharedMemoryClient> SharedMemoryClientMapType;
+    SharedMemoryClientMapType SharedMemoryClients;
+    unsigned long long SharedMemoryNextClient;
+
+    /*! Serializers of shared memory clients that detached, deleted
+        once no finished event refers to them */
+    std::vector<mtsProxySerializer *> DetachedSerializers;
+
+    /*! Address of the client which sent the command being processed */
+    osaIPandPort CurrentClient;
+
+    /*! Compact events waiting to be sent to a client, see SOCKET_PROXY_VERSION 2.
+        Events are coalesced in a single message until the message is full or
+        the coalescing window expires. */
+    struct CompactEventBuffer {
+        std::string Data;
+        unsigned short Sequence;
+        double StartTime;
+        CompactEventBuffer() : Sequence(0), StartTime(0.0) {}
+    };
+    typedef std::map<osaIPandPort, CompactEventBuffer> CompactEventBufferMapType;
+    CompactEventBufferMapType CompactEventBuffers;
+    double EventCoalescingWindow;
+
     FinishedEventList *FinishedEvents;
  
     // For memory cleanup
@@ -136,6 +173,23 @@ class CISST_EXPORT mtsSocketProxyServer : public mtsTaskContinuous
     bool GetHandleWriteReturn(const std::string &commandName, std::string &handleString) const;
     void EventEnable(const std::string &eventHandleAndName);
     void EventDisable(const std::string &eventHandleAndName);
+    void EventEnableCompact(const std::string &eventHandleIdAndName);
+
+    /*! Send the compact events queued for a client */
+    void FlushCompactEvents(const osaIPandPort &ip_port, CompactEventBuffer &buffer);
+
+    void InitSharedMemory(unsigned short port);
+    void CloseSharedMemory(void);
+    void ProcessSharedMemoryMessage(const char *message, size_t length);
+
+    /*! Remove a client from all event senders and from ClientMap */
+    void RemoveClient(const osaIPandPort &ip_port);
+
+    /*! Delete the serializers of detached clients that are not used anymore */
+    void DeleteDetachedSerializers(void);
+
+    /*! Process a command received from CurrentClient */
+    void ProcessRequest(std::string &inputArgString);
 
     void AddSpecialCommands(void);
     mtsExecutionResult GetInitData(std::string &outputArgSerialized, mtsProxySerializer *serializer) const;
@@ -176,6 +230,28 @@ class CISST_EXPORT mtsSocketProxyServer : public mtsTaskContinuous
 
     mtsCommandWriteBase *AllocateFinishedEvent(const std::string &eventHandle);
 
+    /*! Send a message to a client, using the client's shared memory ring if
+        the client is on the same computer or the socket otherwise.
+        \return Number of bytes sent, 0 or -1 on failure
+    */
+    int SendToClient(const osaIPandPort &ip_port, const char *buffer, size_t length, double timeoutSec);
+    int SendToClient(const osaIPandPort &ip_port, const std::string &buffer, double timeoutSec);
+
+    /*! Queue a compact event for a client, i.e. a CompactEventHeader followed by the
+        argument serialized without class services (length is 0 for void events).
+        Events are sent immediately if the coalescing window is 0.
+    */
+    void SendCompactEvent(const osaIPandPort &ip_port, unsigned short eventId, const char *argument, size_t length);
+
+    /*! Set the time window, in seconds, used to coalesce compact events sent to the
+        same client in a single message.  The default is 0, i.e. each event is sent
+        as soon as it is received by the server proxy.  A small window (e.g. 1 ms)
+        reduces the number of messages when many events are enabled, at the cost
+        of latency.
+    */
+    void SetEventCoalescingWindow(double windowInSeconds);
+    double GetEventCoalescingWindow(void) const;
+
 };
 
 CMN_DECLARE_SERVICES_INSTANTIATION(mtsSocketProxyServer)
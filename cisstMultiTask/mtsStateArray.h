@@ -6,7 +6,7 @@
   Author(s):  Ankur Kapoor
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2009 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -41,6 +41,9 @@ http://www.cisst.org/cisst/license.txt.
   the following template, where _elementType represents the type of
   data used by the particular state element. It is assumed that
   _elementType is derived from mtsGenericObject.
+
+  For proxies of trivially copyable types, mtsStateTable uses
+  mtsStateArrayPOD instead (see mtsStateArrayTraits).
  */
 
 template <class _elementType>
@@ -63,7 +66,9 @@ public:
 	inline mtsStateArray(const value_type & objectExample,
                          size_type size = 0):
         Data(size, objectExample)
-    {}
+    {
+        this->DataClassServices = objectExample.Services();
+    }
 
 	/*! Default destructor. */
 	virtual ~mtsStateArray() {}
@@ -83,6 +88,28 @@ public:
     const value_type & Element(index_type index) const { return Data[index]; }
     value_type & Element(index_type index) { return Data[index]; }
 
+    /*! Copy data at index in an object of the element type, same
+      interface as mtsStateArrayPOD::GetElement. */
+    inline void GetElement(index_type index, value_type & data) const { data = Data[index]; }
+
+    /*! Pointer on element at index, same interface as
+      mtsStateArrayPOD::ElementPointer. */
+    inline const value_type * ElementPointer(index_type index) const { return &(Data[index]); }
+
+    /*! Documented in base class */
+    inline mtsGenericObject * CreateElement(void) const {
+        if (Data.empty()) {
+            return 0;
+        }
+        return new value_type(Data[0]);
+    }
+
+    /*! Documented in base class, returns the object stored and
+      doesn't use the buffer. */
+    inline const mtsGenericObject & Element(index_type index, mtsGenericObject & CMN_UNUSED(buffer)) const {
+        return Data[index];
+    }
+
 	/*! Overloaded [] operator. Returns data at index (of type mtsGenericObject).
         Currently used for data collection (mtsCollectorState). */
 	inline mtsGenericObject & operator[](index_type index){ return Data[index]; }
@@ -6,7 +6,7 @@
   Author(s):  Ankur Kapoor
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2008 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -42,7 +42,9 @@ http://www.cisst.org/cisst/license.txt.
 class mtsStateArrayBase {
 protected:
     /*! Protected constructor. Does nothing. */
-    inline mtsStateArrayBase(void){};
+    inline mtsStateArrayBase(void):
+        DataClassServices(0)
+    {};
 
     /*! Class services associated to the element contained */
     const cmnClassServicesBase * DataClassServices;
@@ -60,6 +62,18 @@ public:
 	/*! Overloaded subscript operator. */
 	virtual const mtsGenericObject & operator[](index_type index) const = 0;
 
+    /*! Create an object of the element type that can be used with
+      Element(index, buffer).  The caller owns the object created.
+      Returns 0 if the array is empty. */
+    virtual mtsGenericObject * CreateElement(void) const = 0;
+
+    /*! Element at index.  Arrays storing objects (mtsStateArray)
+      return the object stored and ignore the buffer.  Other arrays
+      (mtsStateArrayPOD) copy the element in the buffer provided by the
+      caller and return it.  The buffer must have been created using
+      CreateElement.  Used for data collection (mtsCollectorState). */
+    virtual const mtsGenericObject & Element(index_type index, mtsGenericObject & buffer) const = 0;
+
 	/*! Create the array of data.  This is currently unused. */
 	virtual mtsStateArrayBase * Create(const mtsGenericObject * objectExample, size_type size) = 0;
 
@@ -74,6 +88,11 @@ public:
 
     virtual bool SetDataSize(const size_t size) = 0;
 
+    /*! Class services of the elements contained */
+    inline const cmnClassServicesBase * GetDataClassServices(void) const {
+        return this->DataClassServices;
+    }
+
     bool SetSize(const size_t size){
         return SetDataSize(size);
     }
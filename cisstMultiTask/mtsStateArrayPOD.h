@@ -0,0 +1,383 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Defines a state data array for trivially copyable data.
+*/
+
+#ifndef _mtsStateArrayPOD_h
+#define _mtsStateArrayPOD_h
+
+#include <cisstCommon/cmnLogger.h>
+#include <cisstVector/vctForwardDeclarations.h>
+#include <cisstMultiTask/mtsGenericObjectProxy.h>
+#include <cisstMultiTask/mtsStateArrayBase.h>
+#include <cisstMultiTask/mtsStateArray.h>
+
+#include <vector>
+#include <string.h>
+#include <type_traits>
+
+/*!
+  \ingroup cisstMultiTask
+
+  Defines if a payload type can be copied using memcpy in a state
+  array.  By default this relies on std::is_trivially_copyable.
+  Fixed size vectors and matrices are not trivially copyable as they
+  define their own assignment operators but their storage is a plain
+  array of elements so they can be copied as such if the elements
+  can.
+*/
+template <class _payloadType>
+class mtsStateArrayPayloadIsPOD
+{
+public:
+    enum {Value = std::is_trivially_copyable<_payloadType>::value};
+};
+
+template <class _elementType, vct::size_type _size>
+class mtsStateArrayPayloadIsPOD<vctFixedSizeVector<_elementType, _size> >
+{
+public:
+    enum {Value = mtsStateArrayPayloadIsPOD<_elementType>::Value};
+};
+
+template <class _elementType, vct::size_type _rows, vct::size_type _cols, bool _rowMajor>
+class mtsStateArrayPayloadIsPOD<vctFixedSizeMatrix<_elementType, _rows, _cols, _rowMajor> >
+{
+public:
+    enum {Value = mtsStateArrayPayloadIsPOD<_elementType>::Value};
+};
+
+
+/*!
+  \ingroup cisstMultiTask
+
+  Selects the state array type used by mtsStateTable for a given
+  element type.  Proxies (mtsGenericObjectProxy) of trivially copyable
+  types such as mtsDouble or vctDouble3 use mtsStateArrayPOD, all other
+  types use mtsStateArray.
+*/
+template <class _elementType>
+class mtsStateArrayTraits
+{
+public:
+    enum {IsPOD = false};
+    typedef mtsStateArray<_elementType> ArrayType;
+};
+
+
+template <class _elementType, bool _isPOD>
+class mtsStateArrayTraitsProxy
+{
+public:
+    enum {IsPOD = false};
+    typedef mtsStateArray<mtsGenericObjectProxy<_elementType> > ArrayType;
+};
+
+
+template <class _payloadType>
+class mtsStateArrayPOD;
+
+template <class _elementType>
+class mtsStateArrayTraitsProxy<_elementType, true>
+{
+public:
+    enum {IsPOD = true};
+    typedef mtsStateArrayPOD<_elementType> ArrayType;
+};
+
+
+template <class _elementType>
+class mtsStateArrayTraits<mtsGenericObjectProxy<_elementType> >:
+    public mtsStateArrayTraitsProxy<_elementType, mtsStateArrayPayloadIsPOD<_elementType>::Value>
+{
+};
+
+
+/*!
+  \ingroup cisstMultiTask
+
+  State array for proxies of trivially copyable types (see
+  mtsStateArrayPayloadIsPOD).  Instead of a std::vector of
+  mtsGenericObjectProxy objects, the payloads are stored in a
+  contiguous ring of raw data, the first payload being aligned on a
+  cache line.  Timestamps and valid flags are stored in separate
+  arrays.  Payloads are read and written using memcpy so reading or
+  writing a row touches as few cache lines as possible.
+
+  Get and Set identify the type of the object provided using the class
+  services (virtual method) instead of dynamic_cast.  Both
+  mtsGenericObjectProxy and mtsGenericObjectProxyRef return the same
+  class services so the object is accessed through their common base
+  class.
+
+  Element, ElementPointer and the subscript operator return a proxy
+  view of the row.  Each row has its own view, the view is updated
+  from the ring each time it is accessed and changes made to the view
+  are not written back.  Since the state table writer can overwrite
+  the row at any time, GetElement, Get and Element(index, buffer)
+  should be preferred to copy the row in an object provided by the
+  caller.
+
+  \sa mtsStateArray
+*/
+template <class _payloadType>
+class mtsStateArrayPOD: public mtsStateArrayBase
+{
+public:
+    typedef _payloadType payload_type;
+    typedef mtsGenericObjectProxy<_payloadType> value_type;
+    typedef mtsGenericObjectProxyBase<_payloadType> ProxyBaseType;
+
+    enum {CACHE_LINE_SIZE = 64};
+
+protected:
+    /*! Memory used for the payloads, over allocated to align the
+      first payload */
+    std::vector<char> Buffer;
+
+    /*! First payload, aligned on CACHE_LINE_SIZE */
+    payload_type * Payloads;
+
+    /*! Timestamp of each row */
+    std::vector<double> Timestamps;
+
+    /*! Valid flag of each row, not using std::vector<bool> so each
+      flag can be written independently */
+    std::vector<char> ValidFlags;
+
+    /*! Proxy view of each row, see View */
+    mutable std::vector<value_type> Views;
+
+    /*! Number of rows */
+    size_type Size;
+
+    /*! Allocate the buffers for a given number of rows and copy as
+      many rows as possible from the previous buffers.  Rows added are
+      initialized using the object example if provided, the first row
+      otherwise. */
+    void Allocate(const size_type size, const ProxyBaseType * objectExample = 0) {
+        const size_type toCopy = objectExample ? 0 : ((size < this->Size) ? size : this->Size);
+        if (!objectExample && (toCopy == 0)) {
+            this->Release();
+            return;
+        }
+        std::vector<char> newBuffer(size * sizeof(payload_type) + CACHE_LINE_SIZE);
+        const size_t address = reinterpret_cast<size_t>(&(newBuffer[0]));
+        const size_t offset = (CACHE_LINE_SIZE - (address % CACHE_LINE_SIZE)) % CACHE_LINE_SIZE;
+        payload_type * newPayloads = reinterpret_cast<payload_type *>(&(newBuffer[offset]));
+        std::vector<double> newTimestamps(size);
+        std::vector<char> newValidFlags(size);
+        if (toCopy > 0) {
+            memcpy(newPayloads, this->Payloads, toCopy * sizeof(payload_type));
+            memcpy(&(newTimestamps[0]), &(this->Timestamps[0]), toCopy * sizeof(double));
+            memcpy(&(newValidFlags[0]), &(this->ValidFlags[0]), toCopy * sizeof(char));
+        }
+        // example used for the rows added and the views
+        value_type example;
+        if (objectExample) {
+            memcpy(&(example.Data), &(objectExample->GetData()), sizeof(payload_type));
+            example.SetTimestamp(objectExample->Timestamp());
+            example.SetValid(objectExample->Valid());
+        } else {
+            this->GetRow(0, example);
+        }
+        for (index_type index = toCopy; index < size; ++index) {
+            memcpy(&(newPayloads[index]), &(example.Data), sizeof(payload_type));
+            newTimestamps[index] = example.Timestamp();
+            newValidFlags[index] = example.Valid();
+        }
+        this->Buffer.swap(newBuffer);
+        this->Payloads = newPayloads;
+        this->Timestamps.swap(newTimestamps);
+        this->ValidFlags.swap(newValidFlags);
+        this->Views.assign(size, example);
+        this->Size = size;
+    }
+
+    /*! Release all the buffers */
+    void Release(void) {
+        this->Buffer.clear();
+        this->Payloads = 0;
+        this->Timestamps.clear();
+        this->ValidFlags.clear();
+        this->Views.clear();
+        this->Size = 0;
+    }
+
+    /*! Write an object in a row */
+    inline void SetRow(index_type index, const ProxyBaseType & object) {
+        memcpy(&(this->Payloads[index]), &(object.GetData()), sizeof(payload_type));
+        this->Timestamps[index] = object.Timestamp();
+        this->ValidFlags[index] = object.Valid();
+    }
+
+    /*! Read a row in an object */
+    inline void GetRow(index_type index, ProxyBaseType & object) const {
+        memcpy(&(object.GetData()), &(this->Payloads[index]), sizeof(payload_type));
+        object.SetTimestamp(this->Timestamps[index]);
+        object.SetValid(this->ValidFlags[index] != 0);
+    }
+
+    /*! Update the proxy view of a row and return it */
+    inline value_type & View(index_type index) const {
+        value_type & view = this->Views[index];
+        this->GetRow(index, view);
+        return view;
+    }
+
+    /*! Check if an object can be used with this array, i.e. is a
+      proxy or proxy ref for the payload type. */
+    inline static bool IsCompatible(const mtsGenericObject & object) {
+        return (object.Services() == value_type::ClassServices());
+    }
+
+private:
+    /*! Payloads point to the buffer, copies are not allowed */
+    mtsStateArrayPOD(const mtsStateArrayPOD & other);
+    mtsStateArrayPOD & operator = (const mtsStateArrayPOD & other);
+
+public:
+    inline mtsStateArrayPOD(const value_type & objectExample,
+                            size_type size = 0):
+        Payloads(0),
+        Size(0)
+    {
+        this->DataClassServices = value_type::ClassServices();
+        this->Allocate(size, &objectExample);
+    }
+
+    virtual ~mtsStateArrayPOD() {}
+
+    bool SetDataSize(const size_t size) {
+        if (this->Size == 0) {
+            return false;
+        }
+        this->Allocate(size);
+        return true;
+    }
+
+    /*! Number of rows */
+    inline size_type size(void) const {
+        return this->Size;
+    }
+
+    /*! Raw payload, can be used to copy many payloads at once since
+      they are contiguous. */
+    inline const payload_type & Payload(index_type index) const {
+        return this->Payloads[index];
+    }
+
+    /*! Copy data at index in an object of the element type, this is
+      used by mtsStateTable::Accessor and doesn't require any
+      dynamic_cast. */
+    inline void GetElement(index_type index, value_type & data) const {
+        this->GetRow(index, data);
+    }
+
+    /*! Access element at index.  This returns the proxy view of the
+      row, see class documentation. */
+    inline const value_type & Element(index_type index) const {
+        return this->View(index);
+    }
+    inline value_type & Element(index_type index) {
+        return this->View(index);
+    }
+
+    /*! Pointer on element at index, same interface as
+      mtsStateArray::ElementPointer.  This returns the proxy view of
+      the row, see class documentation. */
+    inline const value_type * ElementPointer(index_type index) const {
+        return &(this->View(index));
+    }
+
+    /*! Overloaded [] operator.  Returns the proxy view of the row at
+      index (of type mtsGenericObject). */
+    inline mtsGenericObject & operator[](index_type index) { return this->View(index); }
+    inline const mtsGenericObject & operator[](index_type index) const { return this->View(index); }
+
+    /*! Documented in base class */
+    inline mtsGenericObject * CreateElement(void) const {
+        if (this->Size == 0) {
+            return 0;
+        }
+        value_type * element = new value_type;
+        this->GetRow(0, *element);
+        return element;
+    }
+
+    /*! Documented in base class, copies the row in the buffer. */
+    inline const mtsGenericObject & Element(index_type index, mtsGenericObject & buffer) const {
+        this->GetRow(index, static_cast<ProxyBaseType &>(buffer));
+        return buffer;
+    }
+
+    /* Create the array of data. This is currently unused. */
+    inline mtsStateArrayBase * Create(const mtsGenericObject * objectExample,
+                                      size_type size) {
+        if (!IsCompatible(*objectExample)) {
+            CMN_LOG_INIT_ERROR << "mtsStateArrayPOD: Create used with an object example of the wrong type, received: "
+                               << objectExample->Services()->GetName()
+                               << " while expecting "
+                               << value_type::ClassServices()->GetName()
+                               << std::endl;
+            return 0;
+        }
+        this->Allocate(size, static_cast<const ProxyBaseType *>(objectExample));
+        return this;
+    }
+
+    /*! Copy data from one index to another within the same array. */
+    inline void Copy(index_type indexTo, index_type indexFrom) {
+        if (indexTo != indexFrom) {
+            memcpy(&(this->Payloads[indexTo]), &(this->Payloads[indexFrom]), sizeof(payload_type));
+            this->Timestamps[indexTo] = this->Timestamps[indexFrom];
+            this->ValidFlags[indexTo] = this->ValidFlags[indexFrom];
+        }
+    }
+
+    /*! Get and Set data from array.  The object must be a proxy or
+      proxy reference for the payload type. */
+    //@{
+    bool Get(index_type index, mtsGenericObject & object) const {
+        if (IsCompatible(object)) {
+            this->GetRow(index, static_cast<ProxyBaseType &>(object));
+            return true;
+        }
+        CMN_LOG_RUN_ERROR << "mtsStateArrayPOD::Get -- type mismatch, expected "
+                          << value_type::ClassServices()->GetName()
+                          << ", received " << object.Services()->GetName() << std::endl;
+        return false;
+    }
+
+    bool Set(index_type index, const mtsGenericObject & object) {
+        if (IsCompatible(object)) {
+            this->SetRow(index, static_cast<const ProxyBaseType &>(object));
+            return true;
+        }
+        CMN_LOG_RUN_ERROR << "mtsStateArrayPOD::Set -- type mismatch, expected "
+                          << value_type::ClassServices()->GetName()
+                          << ", received " << object.Services()->GetName() << std::endl;
+        return false;
+    }
+    //@}
+};
+
+#endif // _mtsStateArrayPOD_h
@@ -5,7 +5,7 @@
   Author(s):  Ankur Kapoor, Min Yang Jung, Peter Kazanzides
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2014 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -30,6 +30,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstMultiTask/mtsForwardDeclarations.h>
 #include <cisstMultiTask/mtsStateArrayBase.h>
 #include <cisstMultiTask/mtsStateArray.h>
+#include <cisstMultiTask/mtsStateArrayPOD.h>
 #include <cisstMultiTask/mtsStateIndex.h>
 #include <cisstMultiTask/mtsFunctionVoid.h>
 #include <cisstMultiTask/mtsFunctionRead.h>
@@ -39,12 +40,14 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <vector>
 #include <iostream>
+#include <atomic>
 
 // Always include last
 #include <cisstMultiTask/mtsExport.h>
 
 // Forward declaration
 class osaTimeServer;
+class mtsStateTableFlightRecorder;
 
 
 /*! mtsStateDataId.  Unique identifier for the columns of the State
@@ -63,6 +66,13 @@ typedef int mtsStateDataId;
   assumption here that there is only one writer, though there can be
   multiple readers. State Data Table is also refered as Data Table or
   State Table elsewhere in the documentation.
+
+  Each row has a sequence number (seqlock) incremented by the writer
+  before and after the row is written in Advance, i.e. the sequence is
+  odd while the row is being written.  Readers record the sequence,
+  copy the data and check that the sequence hasn't changed.  This is
+  used by GetSnapshot to read multiple elements from the same row
+  consistently without locking the writer.
  */
 class CISST_EXPORT mtsStateTable: public cmnGenericObject {
 
@@ -73,6 +83,7 @@ class CISST_EXPORT mtsStateTable: public cmnGenericObject {
     friend class mtsTaskTest;
     friend class mtsStateTableTest;
     friend class mtsCollectorBaseTest;
+    friend class mtsStateTableFlightRecorder;
 
  public:
     /*! Collection is performed by batches, this requires to save
@@ -170,12 +181,13 @@ public:
         typedef typename mtsGenericTypes<_elementType>::FinalType value_type;
         typedef typename mtsGenericTypes<_elementType>::FinalRefType value_ref_type;
         typedef typename mtsStateTable::Accessor<_elementType> ThisType;
-        const mtsStateArray<value_type> & History;
+        typedef typename mtsStateArrayTraits<value_type>::ArrayType HistoryType;
+        const HistoryType & History;
         value_ref_type * Current;
 
     public:
         Accessor(const mtsStateTable & table, mtsStateDataId id,
-                 const mtsStateArray<value_type> * history, value_ref_type * data):
+                 const HistoryType * history, value_ref_type * data):
             AccessorBase(table, id), History(*history), Current(data) {}
 
         void ToStream(std::ostream & outputStream, const mtsStateIndex & when) const {
@@ -183,20 +195,34 @@ public:
         }
 
         bool Get(const mtsStateIndex & when, value_type & data) const {
-            data = History.Element(when.Index());
-            return Table.ValidateReadIndex(when);
+            const unsigned int sequence = Table.ReadBegin(when);
+            if (sequence & 1) {
+                return false;
+            }
+            History.GetElement(when.Index(), data);
+            return Table.ReadEnd(when, sequence);
         }
 
         //This should be used with caution because
         //the state table mechanism could override the data that the pointer is pointing to.
+        //For trivially copyable types, the pointer is on a view of the row updated
+        //by each call (see mtsStateArrayPOD).
         const value_type * GetPointer(const mtsStateIndex & when) const {
             if (!Table.ValidateReadIndex(when))
                 return 0;
             else
-                return  &(History.Element(when.Index()));
+                return History.ElementPointer(when.Index());
         }
 
         bool Get(const mtsStateIndex & when, mtsGenericObject & data) const {
+            // state array for trivially copyable types doesn't need dynamic_cast
+            if (mtsStateArrayTraits<value_type>::IsPOD) {
+                const unsigned int sequence = Table.ReadBegin(when);
+                if ((sequence & 1) || !History.Get(when.Index(), data)) {
+                    return false;
+                }
+                return Table.ReadEnd(when, sequence);
+            }
             value_type* pdata = dynamic_cast<value_type*>(&data);
             if (pdata) {
                 return Get(when, *pdata);
@@ -208,11 +234,23 @@ public:
             return false;
         }
 
+        /*! Get latest value, if the row is overwritten while
+          copying, retry with the new latest row. */
         bool GetLatest(value_type & data) const {
-            return Get(Table.GetIndexReader(), data);
+            for (size_t attempt = 0; attempt < mtsStateTable::SNAPSHOT_MAXIMUM_ATTEMPTS; ++attempt) {
+                if (Get(Table.GetIndexReader(), data)) {
+                    return true;
+                }
+            }
+            return false;
         }
         bool GetLatest(mtsGenericObject & data) const {
-            return Get(Table.GetIndexReader(), data);
+            for (size_t attempt = 0; attempt < mtsStateTable::SNAPSHOT_MAXIMUM_ATTEMPTS; ++attempt) {
+                if (Get(Table.GetIndexReader(), data)) {
+                    return true;
+                }
+            }
+            return false;
         }
 
         bool GetDelayed(value_type & data) const {
@@ -253,9 +291,20 @@ public:
       default. */
     bool AutomaticAdvanceFlag;
 
+    /*! Replay time flag.  Set by ReplayStart, when true Advance uses
+      Tic for Toc instead of reading the time server so the table
+      follows the replay virtual clock. */
+    bool ReplayTimeFlag;
+
 	/*! The vector contains pointers to individual columns. */
 	std::vector<mtsStateArrayBase *> StateVector;
 
+    /*! Create one object per column to be used with
+      mtsStateArrayBase::Element(index, buffer), see Debug and
+      CSVWrite. */
+    void CreateElementBuffers(std::vector<mtsGenericObject *> & buffers) const;
+    void DeleteElementBuffers(std::vector<mtsGenericObject *> & buffers) const;
+
     /*! The vector contains pointers to the current values
       of elements that are to be added to the state when we
       advance.
@@ -274,6 +323,24 @@ public:
 	  period of the task that the state table is associated with. */
 	std::vector<mtsStateIndex::TimeTicksType> Ticks;
 
+    /*! Sequence number for each row, odd while the row is being
+      written by Advance.  See ReadBegin and ReadEnd. */
+    std::vector<std::atomic<unsigned int> > RowSequences;
+
+    /*! Sequence number of the row before reading it, the row is being
+      written if the value returned is odd. */
+    inline unsigned int ReadBegin(const mtsStateIndex & timeIndex) const {
+        return RowSequences[timeIndex.Index()].load(std::memory_order_acquire);
+    }
+
+    /*! Check that the row hasn't been modified since ReadBegin and
+      that the row still corresponds to the requested index. */
+    inline bool ReadEnd(const mtsStateIndex & timeIndex, const unsigned int sequence) const {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return ((RowSequences[timeIndex.Index()].load(std::memory_order_relaxed) == sequence)
+                && ValidateReadIndex(timeIndex));
+    }
+
     /*! The state table indices for Tic, Toc, and Period. */
     mtsStateDataId TicId, TocId;
     mtsStateDataId PeriodId;
@@ -308,6 +375,16 @@ public:
       mtsCollectorState. */
     DataCollectionInfo DataCollection;
 
+    /*! Flight recorder, 0 unless FlightRecorderEnable has been
+      called.  Read by the writer in Advance and by any thread in
+      FlightRecorderTrigger. */
+    std::atomic<mtsStateTableFlightRecorder *> FlightRecorder;
+
+    /*! Number of threads using the flight recorder, i.e. in Advance
+      or FlightRecorderTrigger.  FlightRecorderDisable waits for this
+      to drop to 0 before deleting the flight recorder. */
+    std::atomic<unsigned int> FlightRecorderUsers;
+
 	/*! Write specified data. */
 	bool Write(mtsStateDataId id, const mtsGenericObject & obj);
 
@@ -344,6 +421,28 @@ public:
         return (Ticks[timeIndex.Index()] == timeIndex.Ticks());
     }
 
+    /*! Maximum number of attempts for GetLatestSnapshot and
+      Accessor::GetLatest when the latest row is overwritten while
+      reading. */
+    enum {SNAPSHOT_MAXIMUM_ATTEMPTS = 8};
+
+    /*! Read multiple elements from the same row.  The data objects
+      must have the same type as the elements added with NewElement.
+      Returns false if any of the ids is invalid or if the row has been
+      overwritten before or while reading, in which case the content
+      of the data objects is undefined. */
+    bool GetSnapshot(const mtsStateIndex & timeIndex,
+                     const std::vector<mtsStateDataId> & ids,
+                     const std::vector<mtsGenericObject *> & data) const;
+
+    /*! Read multiple elements from the latest row.  If the writer
+      overwrites the row while reading, the read is restarted using the
+      new latest row.  The index of the row read is returned in
+      timeIndex. */
+    bool GetLatestSnapshot(const std::vector<mtsStateDataId> & ids,
+                           const std::vector<mtsGenericObject *> & data,
+                           mtsStateIndex & timeIndex) const;
+
     /*! Get method for auto advance flag. See AutomaticAdvanceFlag */
     inline const bool & AutomaticAdvance(void) const {
         return this->AutomaticAdvanceFlag;
@@ -409,6 +508,13 @@ public:
     /*! Start if automatic advance is set and does nothing otherwise. */
     void StartIfAutomatic(void);
 
+    /*! Start the current cycle using a time provided by the caller
+      instead of the time server, used to replay logged data (see
+      mtsCollectorReplay).  Once this method has been called, Advance
+      sets Toc to Tic so the table only depends on the replayed
+      times. */
+    void ReplayStart(const double tic);
+
     /*! Advance the pointers of the circular buffer. Note that since
       there is only a single writer, it is not necessary to use mutual
       exclusion primitives; the critical section can be handled by
@@ -478,6 +584,36 @@ public:
     void DataCollectionStart(const mtsDouble & delay);
     void DataCollectionStop(const mtsDouble & delay);
     //@}
+
+    /*! Enable the flight recorder mode.  The table keeps at least the
+      last preTriggerDuration seconds of data and, when triggered
+      (see FlightRecorderTrigger), saves the pre-trigger window and the
+      following postTriggerDuration seconds in a columnar log file
+      (see mtsStateTableFlightRecorder).  The expected period of the
+      task is used to resize the table if needed so this method must
+      be called before the table is used, e.g. in the component's
+      constructor.  Files are named using the prefix provided, by
+      default "FlightRecorder-" followed by the table name. */
+    bool FlightRecorderEnable(const double preTriggerDuration,
+                              const double postTriggerDuration,
+                              const double expectedPeriod,
+                              const std::string & filePrefix = "");
+
+    /*! Disable the flight recorder, waits for the current dump if
+      any.  This method can be called while the table is advanced, it
+      waits for Advance and FlightRecorderTrigger to stop using the
+      flight recorder before deleting it.  It is also called by the
+      state table destructor. */
+    void FlightRecorderDisable(void);
+
+    /*! Request a flight recorder capture, can be called from any
+      thread.  Ignored if the flight recorder is not enabled. */
+    void FlightRecorderTrigger(void);
+
+    /*! Flight recorder, 0 if not enabled */
+    inline mtsStateTableFlightRecorder * GetFlightRecorder(void) {
+        return this->FlightRecorder.load();
+    }
 };
 
 CMN_DECLARE_SERVICES_INSTANTIATION(mtsStateTable);
@@ -501,8 +637,8 @@ template <class _elementType>
 mtsStateDataId mtsStateTable::NewElement(const std::string & name, _elementType * element) {
     typedef typename mtsGenericTypes<_elementType>::FinalType FinalType;
     typedef typename mtsGenericTypes<_elementType>::FinalRefType FinalRefType;
-    mtsStateArray<FinalType> * elementHistory =
-        new mtsStateArray<FinalType>(*element, HistoryLength);
+    typedef typename mtsStateArrayTraits<FinalType>::ArrayType ArrayType;
+    ArrayType * elementHistory = new ArrayType(*element, HistoryLength);
     StateVector.push_back(elementHistory);
     FinalRefType *pdata = mtsGenericTypes<_elementType>::ConditionalWrap(*element);
     StateVectorElements.push_back(pdata);
@@ -0,0 +1,167 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Pre-trigger capture of state table data
+*/
+
+#ifndef _mtsStateTableFlightRecorder_h
+#define _mtsStateTableFlightRecorder_h
+
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstOSAbstraction/osaThreadSignal.h>
+#include <cisstOSAbstraction/osaMutex.h>
+#include <cisstMultiTask/mtsStateIndex.h>
+
+#include <atomic>
+#include <string>
+
+// Always include last
+#include <cisstMultiTask/mtsExport.h>
+
+class mtsStateTable;
+
+/*!
+  \ingroup cisstMultiTask
+
+  Flight recorder for a state table, see
+  mtsStateTable::FlightRecorderEnable.
+
+  The state table is already a ring buffer so the recorder doesn't
+  copy any data until a trigger is received.  The table is resized so
+  it can hold the pre-trigger and post-trigger windows as well as a
+  margin for the dump itself.  When Trigger is called (from any
+  thread), the next call to Update (from the state table writer, at
+  the end of Advance) records the trigger time.  Once the post-trigger
+  window has elapsed, the range of rows is handed to a dedicated thread
+  which copies the rows from the table and saves them in a columnar
+  log file (see mtsCollectorColumnarWriter) while the table keeps
+  advancing.  The margin rows give the dump thread time to copy the
+  oldest rows before they are overwritten.  Rows are read using the
+  table's row sequences so a row overwritten while being copied is
+  detected and the dump is truncated.
+
+  Triggers received while a capture or a dump is in progress are
+  ignored and counted.
+*/
+class CISST_EXPORT mtsStateTableFlightRecorder
+{
+public:
+    typedef mtsStateIndex::TimeTicksType TimeTicksType;
+
+    /*! State of the recorder */
+    typedef enum {
+        IDLE = 0,
+        TRIGGERED,
+        DUMPING
+    } StateType;
+
+protected:
+    mtsStateTable & Table;
+    double PreTriggerDuration;
+    double PostTriggerDuration;
+    std::string FilePrefix;
+
+    std::atomic<bool> TriggerRequested;
+    std::atomic<int> State;
+
+    /*! Set by Update when the trigger is processed */
+    TimeTicksType TriggerTicks;
+    double TriggerTime;
+    size_t PreTriggerRows;
+
+    /*! Range to dump, set by Update before the dump thread is
+      signaled */
+    TimeTicksType FirstTicks;
+    TimeTicksType LastTicks;
+
+    /*! Statistics, updated by the dump thread except for
+      NumberOfTriggersIgnored */
+    std::atomic<unsigned int> NumberOfDumps;
+    std::atomic<unsigned int> NumberOfTriggersIgnored;
+    std::atomic<unsigned int> NumberOfDumpsTruncated;
+    std::string LastFileName;
+    mutable osaMutex LastFileNameMutex;
+
+    /*! Dump thread */
+    osaThread Thread;
+    osaThreadSignal DumpSignal;
+    osaThreadSignal DumpDoneSignal;
+    std::atomic<bool> StopRequested;
+
+    void * DumpThread(int);
+
+    /*! Copy rows from the table and write the file */
+    bool Dump(const TimeTicksType firstTicks, const TimeTicksType lastTicks);
+
+private:
+    /*! Recorders can't be copied */
+    mtsStateTableFlightRecorder(const mtsStateTableFlightRecorder & other);
+    mtsStateTableFlightRecorder & operator = (const mtsStateTableFlightRecorder & other);
+
+public:
+    /*! Constructor, starts the dump thread.  The durations are in
+      seconds and preTriggerRows is the number of rows expected in the
+      pre-trigger window.  Files are named using the prefix, state
+      table name and date. */
+    mtsStateTableFlightRecorder(mtsStateTable & table,
+                                const double preTriggerDuration,
+                                const double postTriggerDuration,
+                                const size_t preTriggerRows,
+                                const std::string & filePrefix);
+
+    /*! Destructor, waits for the current dump if any and stops the
+      dump thread. */
+    ~mtsStateTableFlightRecorder();
+
+    /*! Request a capture, can be called from any thread. */
+    void Trigger(void);
+
+    /*! Called by the state table writer at the end of Advance. */
+    void Update(void);
+
+    /*! Current state */
+    inline StateType GetState(void) const {
+        return static_cast<StateType>(this->State.load(std::memory_order_acquire));
+    }
+
+    /*! Wait until the recorder is idle, i.e. the current capture if
+      any has been written.  Returns false if the timeout (in seconds)
+      is reached first. */
+    bool WaitForIdle(const double timeout);
+
+    inline unsigned int GetNumberOfDumps(void) const {
+        return this->NumberOfDumps.load();
+    }
+
+    inline unsigned int GetNumberOfTriggersIgnored(void) const {
+        return this->NumberOfTriggersIgnored.load();
+    }
+
+    /*! Number of dumps for which some rows were overwritten before
+      they could be copied */
+    inline unsigned int GetNumberOfDumpsTruncated(void) const {
+        return this->NumberOfDumpsTruncated.load();
+    }
+
+    /*! Name of the last file written */
+    std::string GetLastFileName(void) const;
+};
+
+#endif // _mtsStateTableFlightRecorder_h
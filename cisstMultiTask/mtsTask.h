@@ -6,7 +6,7 @@
   Author(s):  Ankur Kapoor, Peter Kazanzides, Anton Deguet, Min Yang Jung
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2013 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -104,6 +104,13 @@ protected:
     /*! Callable object used when queueing. */
     mtsCallableVoidBase * InterfaceProvidedToManagerCallable;
 
+    /*! Execution context set by the user, see SetExecutionContext. */
+    const void * ExecutionContext;
+
+    /*! Heap allocation detector for the Run method, see
+      EnableAllocationMonitor. */
+    osaAllocationMonitor * AllocationMonitor;
+
     /******************** ExecIn interface *************************/
 
     /*! ExecIn required interface. */
@@ -255,6 +262,17 @@ public:
                                                                    mtsInterfaceQueueingPolicy queueingPolicy = MTS_COMPONENT_POLICY,
                                                                    bool isProxy = false);
 
+    /*! Use a single ready list for the mailboxes of all queued
+      provided interfaces.  Once enabled, clients post their commands
+      in their own mailbox (FIFO per client) and the mailbox is added
+      to the task's ready list so ProcessQueuedCommands only visits
+      mailboxes with pending commands, i.e. the cost doesn't depend
+      on the number of connected clients.  This should be called
+      before the task is connected, e.g. in the derived class
+      constructor.  The internal interface used for component
+      management is not affected. */
+    virtual void EnableMailBoxReadyList(void);
+
     /********************* Methods for task synchronization ***************/
 
     /*! Wait for task to start.
@@ -286,6 +304,41 @@ public:
     /*! Returns true if currently executing in thread-space of component. */
     bool CheckForOwnThread(void) const;
 
+    /*! Set the execution context for tasks sharing a thread not known
+      by cisstMultiTask, e.g. tasks driven by the same external
+      callback (see mtsTaskFromCallback).  Tasks with the same context
+      must be executed sequentially by the same thread.  This must be
+      set before the tasks are connected, 0 (default) means the task
+      uses its own thread. */
+    inline void SetExecutionContext(const void * context) {
+        this->ExecutionContext = context;
+    }
+
+    /*! Returns the execution context of the task the ExecIn interface
+      is connected to, otherwise the context set by the user (see
+      SetExecutionContext) or this task, i.e. its own thread.  The
+      ExecIn interface must be connected before the other interfaces
+      to use direct calls. */
+    const void * GetExecutionContext(void) const;
+
+    /********************* Methods for heap allocation detection **********/
+
+    /*! Mark the Run method as a real-time section and count the heap
+      allocations performed in it, including the queued commands
+      processed by Run.  The counters and the call stacks of the
+      allocations are available using GetAllocationMonitor and
+      reported when the task is cleaned up.  Allocations are only
+      detected if cisst has been compiled with the CMake option
+      CISST_OSA_ALLOCATION_MONITOR (see osaAllocationMonitor).  This
+      should be called before the task is started, e.g. in the derived
+      class constructor. */
+    void EnableAllocationMonitor(void);
+
+    /*! Allocation monitor used for the Run method, 0 if not enabled */
+    inline const osaAllocationMonitor * GetAllocationMonitor(void) const {
+        return this->AllocationMonitor;
+    }
+
     /********************* Methods for task period and overrun ************/
 
     /*! Return true if thread is periodic. */
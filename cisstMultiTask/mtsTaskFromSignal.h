@@ -88,6 +88,12 @@ class CISST_EXPORT mtsTaskFromSignal: public mtsTaskContinuous
                                                                    mtsInterfaceQueueingPolicy queueingPolicy = MTS_COMPONENT_POLICY,
                                                                    bool isProxy = false);
 
+    /*! Use a single ready list for all queued provided interfaces
+      (see mtsTask::EnableMailBoxReadyList).  The thread is woken up
+      by the ready list's doorbell, i.e. only when the first mailbox
+      is scheduled instead of once per queued command. */
+    void EnableMailBoxReadyList(void);
+
 };
 
 
@@ -5,7 +5,7 @@
   Author(s):  Ankur Kapoor, Peter Kazanzides, Anton Deguet
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2017 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -30,6 +30,8 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstOSAbstraction/osaThreadBuddy.h>
 #include <cisstOSAbstraction/osaTimeServer.h>
 
+class mtsTaskPeriodicExecutor;
+
 // Always include last
 #include <cisstMultiTask/mtsExport.h>
 
@@ -46,6 +48,7 @@ class CISST_EXPORT mtsTaskPeriodic : public mtsTaskContinuous
     CMN_DECLARE_SERVICES(CMN_NO_DYNAMIC_CREATION, CMN_LOG_ALLOW_DEFAULT);
 
     friend class mtsTaskManager;
+    friend class mtsTaskPeriodicExecutor;
 
  public:
     typedef mtsTaskContinuous BaseType;
@@ -65,6 +68,15 @@ class CISST_EXPORT mtsTaskPeriodic : public mtsTaskContinuous
 	  time systems. */
 	bool IsHardRealTime;
 
+    /*! Executor used instead of a dedicated thread, 0 by default (see
+      mtsTaskPeriodicExecutor::AddTask). */
+    mtsTaskPeriodicExecutor * Executor;
+
+    /*! Overruns and skipped periods counted by the executor, the
+      thread buddy counts them when the task has its own thread. */
+    unsigned long long ExecutorNumberOfOverruns;
+    unsigned long long ExecutorNumberOfSkippedPeriods;
+
     /********************* Methods that call user methods *****************/
 
 	/*! The member function that is passed as 'start routine' argument for
@@ -83,6 +95,10 @@ class CISST_EXPORT mtsTaskPeriodic : public mtsTaskContinuous
     /*! Called from Start */
     void StartInternal(void);
 
+    /*! Called by the executor at each period, performs a single step
+      of RunInternal. */
+    void RunFromExecutor(void);
+
  public:
     /********************* Task constructor and destructor *****************/
 
@@ -117,11 +133,20 @@ class CISST_EXPORT mtsTaskPeriodic : public mtsTaskContinuous
 	virtual ~mtsTaskPeriodic();
 
     /********************* Methods to change task status *****************/
-    /* (use Start, Create and Kill methods from base classes)            */
+    /* (use Start and Kill methods from base classes)                    */
+
+    /*! Create the thread, or schedule the task with its executor if
+      any (see mtsTaskPeriodicExecutor). */
+    void Create(void * data = 0);
 
 	/*! Suspend the execution of the task */
 	void Suspend(void);
 
+    /*! Executor used by this task, 0 if the task has its own thread */
+    inline mtsTaskPeriodicExecutor * GetExecutor(void) const {
+        return this->Executor;
+    }
+
     /********************* Methods for task period and overrun ************/
 
     /*! Return the periodicity of the task, in seconds */
@@ -131,6 +156,17 @@ class CISST_EXPORT mtsTaskPeriodic : public mtsTaskContinuous
       the thread was created with a period > 0. */
     bool IsPeriodic(void) const;
 
+    /*! Set the policy used when the task misses the deadline of a
+      period, see osaThreadBuddy::CatchUpPolicyType. */
+    void SetCatchUpPolicy(const osaThreadBuddy::CatchUpPolicyType policy);
+
+    /*! Number of periods for which the task missed its deadline, as
+      reported by the thread buddy. */
+    unsigned long long GetNumberOfOverruns(void) const;
+
+    /*! Number of periods skipped to catch up after overruns. */
+    unsigned long long GetNumberOfSkippedPeriods(void) const;
+
 };
 
 
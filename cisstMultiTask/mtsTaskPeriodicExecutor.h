@@ -0,0 +1,183 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Execution of many periodic tasks on a few threads
+*/
+
+#ifndef _mtsTaskPeriodicExecutor_h
+#define _mtsTaskPeriodicExecutor_h
+
+#include <cisstCommon/cmnUnits.h>
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstOSAbstraction/osaThreadSignal.h>
+#include <cisstOSAbstraction/osaMutex.h>
+
+#include <string>
+#include <vector>
+
+// Always include last
+#include <cisstMultiTask/mtsExport.h>
+
+class mtsTaskPeriodic;
+
+/*!
+  \ingroup cisstMultiTask
+
+  Executor for low rate periodic tasks.  By default, each
+  mtsTaskPeriodic creates its own thread.  Tasks added to an executor
+  (see AddTask) don't, their Run method is called by one of the
+  executor's threads.  Each thread uses a hashed timer wheel to find
+  the tasks due at each tick and sleeps until the next non empty slot.
+  A task is always executed by the same executor thread (tasks are
+  assigned to the least loaded thread, i.e. the thread with the lowest
+  sum of rates) so the single reader assumption of mailboxes still
+  holds.  Tasks assigned to the same thread share the same execution
+  context (see mtsTask::SetExecutionContext), so the functions of a
+  task connected to another task of the same thread use the non queued
+  commands once the latter is active.
+
+  Tasks go through the same states as tasks with their own thread:
+  the first tick after Create calls Startup, state tables are started
+  and advanced around each call to Run and queued commands are
+  processed by the task (ProcessQueuedCommands), the period
+  statistics of the state table are updated as usual.  Deadlines are
+  computed from the previous deadline and missed deadlines are handled
+  using the task's catch up policy (see
+  mtsTaskPeriodic::SetCatchUpPolicy).  The timing accuracy is limited
+  by the wheel resolution and, since tasks share threads, a task can
+  delay the other tasks of its thread.  Tasks using an executor should
+  not block nor sleep in Run and can't be hard real-time.
+
+  The executor must be created before the tasks are added and should
+  be deleted after the tasks have been killed.
+*/
+class CISST_EXPORT mtsTaskPeriodicExecutor
+{
+    friend class mtsTaskPeriodic;
+
+protected:
+    /*! Task scheduled on a wheel */
+    class Entry {
+    public:
+        mtsTaskPeriodic * Task;
+        double Period;
+        double Deadline;
+        long long DeadlineTick;
+        /*! Set by Remove while the entry is due, the worker deletes
+          the entry instead of running the task */
+        bool Removed;
+        /*! Set by the worker when the task terminated */
+        bool Terminated;
+    };
+
+    /*! Thread with its own timer wheel */
+    class Worker {
+    public:
+        mtsTaskPeriodicExecutor * Executor;
+        std::vector<std::vector<Entry *> > Slots;
+        /*! Tasks added since the last tick, scheduled by the worker */
+        std::vector<Entry *> Added;
+        /*! Tasks due for the current tick, only modified by the
+          worker */
+        std::vector<Entry *> Due;
+        /*! Tasks assigned to this worker */
+        std::vector<mtsTaskPeriodic *> Tasks;
+        /*! Sum of the rates of the tasks assigned */
+        double Load;
+        long long LastTick;
+        osaThread Thread;
+        osaThreadSignal WakeSignal;
+        /*! Protects the wheel, the lists of tasks and the Removed
+          flags.  It is not held while the tasks run. */
+        osaMutex Mutex;
+        /*! Held by the worker while the due tasks run, used by
+          RemoveTask to wait for the end of the current batch */
+        osaMutex RunMutex;
+        bool StopRequested;
+
+        void * Run(int index);
+        void Schedule(Entry * entry);
+        bool Execute(Entry * entry, const double now);
+        long long NextTick(void) const;
+        bool Remove(const mtsTaskPeriodic * task);
+        static bool CompareDeadlines(const Entry * first, const Entry * second);
+    };
+
+    std::string Name;
+    double Resolution;
+    double TimeOrigin;
+    std::vector<Worker *> Workers;
+
+    /*! Convert a time to a tick of the wheels */
+    long long Tick(const double time) const;
+
+    /*! Find the worker a task is assigned to, 0 if none.  Workers are
+      only added and removed by the constructor and destructor. */
+    Worker * FindWorker(const mtsTaskPeriodic * task) const;
+
+    /*! Called by mtsTaskPeriodic::Create, the task's startup is called
+      by the worker on the next tick. */
+    bool Schedule(mtsTaskPeriodic * task);
+
+private:
+    /*! Executors can't be copied */
+    mtsTaskPeriodicExecutor(const mtsTaskPeriodicExecutor & other);
+    mtsTaskPeriodicExecutor & operator = (const mtsTaskPeriodicExecutor & other);
+
+public:
+    /*! Constructor, starts the executor threads.  The resolution is
+      the duration of a wheel tick, in seconds, and the number of
+      slots the number of ticks covered by one turn of a wheel. */
+    mtsTaskPeriodicExecutor(const std::string & name,
+                            const size_t numberOfThreads = 1,
+                            const double resolution = 1.0 * cmn_ms,
+                            const size_t numberOfSlots = 256);
+
+    /*! Destructor, stops the threads.  Tasks still using the executor
+      are cleaned up. */
+    ~mtsTaskPeriodicExecutor();
+
+    /*! Add a task, this must be done before the task is created.
+      Returns false if the task is already using an executor or has
+      already been created. */
+    bool AddTask(mtsTaskPeriodic * task);
+
+    /*! Remove a task, the task is not executed anymore once this
+      method returns.  If called from a thread other than the
+      executor's, this method waits until the tasks currently running
+      on the task's executor thread are done. */
+    bool RemoveTask(mtsTaskPeriodic * task);
+
+    inline const std::string & GetName(void) const {
+        return this->Name;
+    }
+
+    inline size_t GetNumberOfThreads(void) const {
+        return this->Workers.size();
+    }
+
+    inline double GetResolution(void) const {
+        return this->Resolution;
+    }
+
+    size_t GetNumberOfTasks(void) const;
+};
+
+#endif // _mtsTaskPeriodicExecutor_h
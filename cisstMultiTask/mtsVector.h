@@ -6,7 +6,7 @@
   Author(s):	Anton Deguet
   Created on:   2008-02-05
 
-  (C) Copyright 2008 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2008-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -119,6 +119,19 @@ public:
         mtsGenericObject::DeSerializeRaw(inputStream);
         VectorType::DeSerializeRaw(inputStream);
     }
+
+    /*! Exchange the vector memory with another vector of the same type,
+      no element is copied. */
+    bool Swap(mtsGenericObject & other)
+    {
+        ThisType * otherTyped = dynamic_cast<ThisType *>(&other);
+        if (!otherTyped) {
+            return false;
+        }
+        VectorType::SwapData(*otherTyped);
+        mtsGenericObject::SwapGenericObject(other);
+        return true;
+    }
 };
 
 
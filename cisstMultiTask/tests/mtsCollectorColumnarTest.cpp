@@ -0,0 +1,234 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include "mtsCollectorColumnarTest.h"
+
+#include <cisstMultiTask/mtsCollectorColumnarWriter.h>
+#include <cisstMultiTask/mtsCollectorColumnarReader.h>
+#include <cisstMultiTask/mtsFixedSizeVectorTypes.h>
+#include <cisstMultiTask/mtsGenericObjectProxy.h>
+
+#include <cstdio>
+#include <sstream>
+#include <vector>
+
+
+static std::string mtsCollectorColumnarTestString(const size_t row)
+{
+    std::stringstream stream;
+    stream << "row-" << row;
+    if (row % 3 == 0) {
+        stream << "-longer";
+    }
+    return stream.str();
+}
+
+
+void mtsCollectorColumnarTest::WriteFile(const std::string & fileName, const size_t numberOfRows,
+                                         const size_t chunkSize, const bool compression)
+{
+    std::vector<std::string> names, classNames;
+    names.push_back("Counter");
+    classNames.push_back(mtsDouble::ClassServices()->GetName());
+    names.push_back("Position");
+    classNames.push_back(mtsDouble3::ClassServices()->GetName());
+    names.push_back("Label");
+    classNames.push_back(mtsStdString::ClassServices()->GetName());
+
+    mtsCollectorColumnarWriter writer;
+    writer.SetChunkSize(chunkSize);
+    writer.SetCompression(compression);
+    CPPUNIT_ASSERT(writer.Open(fileName, "component", "table", "2026-10-18", 12.5, names, classNames));
+    CPPUNIT_ASSERT(writer.IsOpen());
+
+    mtsDouble counter;
+    mtsDouble3 position;
+    mtsStdString label;
+    for (size_t row = 0; row < numberOfRows; ++row) {
+        counter = static_cast<double>(row);
+        counter.SetTimestamp(0.001 * row);
+        counter.SetValid(true);
+        position.Assign(1.0, 2.0, 0.5 * row);
+        label = mtsCollectorColumnarTestString(row);
+        writer.BeginRow(1000 + row, 0.001 * row);
+        writer.AddElement(counter);
+        writer.AddElement(position);
+        writer.AddElement(label);
+        writer.EndRow();
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long long>(numberOfRows), writer.GetNumberOfRows());
+    CPPUNIT_ASSERT(writer.Close());
+    CPPUNIT_ASSERT(!writer.IsOpen());
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>((numberOfRows + chunkSize - 1) / chunkSize),
+                         writer.GetNumberOfChunks());
+}
+
+
+void mtsCollectorColumnarTest::TestEncodeDecode(void)
+{
+    // slowly varying doubles compress
+    std::vector<double> values(500);
+    for (size_t index = 0; index < values.size(); ++index) {
+        values[index] = 100.0 + static_cast<double>(index / 10);
+    }
+    const char * input = reinterpret_cast<const char *>(&(values[0]));
+    const size_t size = values.size() * sizeof(double);
+    std::vector<char> encoded, decoded;
+    CPPUNIT_ASSERT(mtsCollectorColumnar::Encode(input, size, sizeof(double), encoded));
+    CPPUNIT_ASSERT(encoded.size() < size / 4);
+    CPPUNIT_ASSERT(mtsCollectorColumnar::Decode(&(encoded[0]), encoded.size(), size, sizeof(double), decoded));
+    CPPUNIT_ASSERT_EQUAL(size, decoded.size());
+    CPPUNIT_ASSERT(memcmp(input, &(decoded[0]), size) == 0);
+
+    // random bytes don't compress
+    std::vector<char> noise(1000);
+    unsigned int seed = 12345;
+    for (size_t index = 0; index < noise.size(); ++index) {
+        seed = seed * 1103515245 + 12345;
+        noise[index] = static_cast<char>(seed >> 16);
+    }
+    CPPUNIT_ASSERT(!mtsCollectorColumnar::Encode(&(noise[0]), noise.size(), 4, encoded));
+
+    // corrupted data is detected
+    CPPUNIT_ASSERT(mtsCollectorColumnar::Encode(input, size, sizeof(double), encoded));
+    CPPUNIT_ASSERT(!mtsCollectorColumnar::Decode(&(encoded[0]), encoded.size() - 1, size, sizeof(double), decoded));
+    CPPUNIT_ASSERT(!mtsCollectorColumnar::Decode(&(encoded[0]), encoded.size(), size - sizeof(double), sizeof(double), decoded));
+}
+
+
+void mtsCollectorColumnarTest::TestWriteRead(void)
+{
+    const std::string fileName = "mtsCollectorColumnarTest.ccol";
+    for (int compression = 0; compression < 2; ++compression) {
+        const size_t numberOfRows = 1000;
+        WriteFile(fileName, numberOfRows, 128, compression == 1);
+
+        mtsCollectorColumnarReader reader;
+        CPPUNIT_ASSERT(reader.Open(fileName));
+        CPPUNIT_ASSERT(!reader.GetIndexRecovered());
+        CPPUNIT_ASSERT_EQUAL(std::string("component"), reader.GetComponentName());
+        CPPUNIT_ASSERT_EQUAL(std::string("table"), reader.GetStateTableName());
+        CPPUNIT_ASSERT_EQUAL(12.5, reader.GetTimeOrigin());
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), reader.GetNumberOfSignals());
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(8), reader.GetNumberOfChunks());
+        CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long long>(numberOfRows), reader.GetNumberOfRows());
+        size_t signal;
+        CPPUNIT_ASSERT(reader.GetSignalIndex("Position", signal));
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), signal);
+        CPPUNIT_ASSERT(!reader.GetSignalIndex("Unknown", signal));
+
+        mtsDouble counter;
+        mtsDouble3 position;
+        mtsStdString label;
+        unsigned long long ticks;
+        double time;
+        // read backward to force chunk reloads
+        for (size_t row = numberOfRows; row > 0; --row) {
+            const size_t index = row - 1;
+            CPPUNIT_ASSERT(reader.GetTicks(index, ticks));
+            CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long long>(1000 + index), ticks);
+            CPPUNIT_ASSERT(reader.GetTime(index, time));
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(0.001 * index, time, 1e-12);
+            CPPUNIT_ASSERT(reader.GetSignal(0, index, counter));
+            CPPUNIT_ASSERT_EQUAL(static_cast<double>(index), counter.Data);
+            CPPUNIT_ASSERT_DOUBLES_EQUAL(0.001 * index, counter.Timestamp(), 1e-12);
+            CPPUNIT_ASSERT(counter.Valid());
+            CPPUNIT_ASSERT(reader.GetSignal(1, index, position));
+            CPPUNIT_ASSERT_EQUAL(0.5 * index, position.Z());
+            CPPUNIT_ASSERT(reader.GetSignal(2, index, label));
+            CPPUNIT_ASSERT_EQUAL(mtsCollectorColumnarTestString(index), label.Data);
+        }
+        // type mismatch and out of range
+        CPPUNIT_ASSERT(!reader.GetSignal(0, 0, position));
+        CPPUNIT_ASSERT(!reader.GetSignal(3, 0, counter));
+        CPPUNIT_ASSERT(!reader.GetTicks(numberOfRows, ticks));
+
+        // dynamic creation
+        mtsGenericObject * object = reader.CreateSignalObject(2);
+        CPPUNIT_ASSERT(object);
+        CPPUNIT_ASSERT(reader.GetSignal(2, 3, *object));
+        CPPUNIT_ASSERT_EQUAL(mtsCollectorColumnarTestString(3), dynamic_cast<mtsStdString *>(object)->Data);
+        delete object;
+        reader.Close();
+    }
+    remove(fileName.c_str());
+}
+
+
+void mtsCollectorColumnarTest::TestFindRows(void)
+{
+    const std::string fileName = "mtsCollectorColumnarTest.ccol";
+    WriteFile(fileName, 1000, 100, true);
+    mtsCollectorColumnarReader reader;
+    CPPUNIT_ASSERT(reader.Open(fileName));
+    unsigned long long first, end;
+    // range across chunks, rows have time 0.001 * row
+    CPPUNIT_ASSERT(reader.FindRows(0.0955, 0.3505, first, end));
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long long>(96), first);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long long>(351), end);
+    // whole file
+    CPPUNIT_ASSERT(reader.FindRows(-1.0, 10.0, first, end));
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long long>(0), first);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long long>(1000), end);
+    // single row
+    CPPUNIT_ASSERT(reader.FindRows(0.4995, 0.5005, first, end));
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long long>(500), first);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long long>(501), end);
+    // no rows
+    CPPUNIT_ASSERT(!reader.FindRows(2.0, 3.0, first, end));
+    CPPUNIT_ASSERT(!reader.FindRows(0.5001, 0.5009, first, end));
+    reader.Close();
+    remove(fileName.c_str());
+}
+
+
+void mtsCollectorColumnarTest::TestRecoverIndex(void)
+{
+    const std::string fileName = "mtsCollectorColumnarTest.ccol";
+    WriteFile(fileName, 250, 100, true);
+
+    // load file and remove footer as well as part of the last chunk
+    std::vector<char> content;
+    FILE * file = fopen(fileName.c_str(), "rb");
+    CPPUNIT_ASSERT(file);
+    char buffer[4096];
+    size_t read;
+    while ((read = fread(buffer, 1, sizeof(buffer), file)) > 0) {
+        content.insert(content.end(), buffer, buffer + read);
+    }
+    fclose(file);
+    const size_t footerSize = 3 * mtsCollectorColumnar::ChunkIndexEntrySize()
+        + mtsCollectorColumnar::FooterTrailerSize();
+    file = fopen(fileName.c_str(), "wb");
+    CPPUNIT_ASSERT(file);
+    fwrite(&(content[0]), 1, content.size() - footerSize - 10, file);
+    fclose(file);
+
+    mtsCollectorColumnarReader reader;
+    CPPUNIT_ASSERT(reader.Open(fileName));
+    CPPUNIT_ASSERT(reader.GetIndexRecovered());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), reader.GetNumberOfChunks());
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long long>(200), reader.GetNumberOfRows());
+    mtsDouble counter;
+    CPPUNIT_ASSERT(reader.GetSignal(0, 199, counter));
+    CPPUNIT_ASSERT_EQUAL(199.0, counter.Data);
+    reader.Close();
+    remove(fileName.c_str());
+}
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(mtsCollectorColumnarTest);
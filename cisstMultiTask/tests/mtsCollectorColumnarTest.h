@@ -0,0 +1,57 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <string>
+
+class mtsCollectorColumnarTest: public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(mtsCollectorColumnarTest);
+    {
+        CPPUNIT_TEST(TestEncodeDecode);
+        CPPUNIT_TEST(TestWriteRead);
+        CPPUNIT_TEST(TestFindRows);
+        CPPUNIT_TEST(TestRecoverIndex);
+    }
+    CPPUNIT_TEST_SUITE_END();
+
+protected:
+    /*! Write a file with a given number of rows, time is 0.001 * row */
+    void WriteFile(const std::string & fileName, const size_t numberOfRows,
+                   const size_t chunkSize, const bool compression);
+
+public:
+    void setUp(void) {
+    }
+
+    void tearDown(void) {
+    }
+
+    /*! Test column codec round trip */
+    void TestEncodeDecode(void);
+
+    /*! Test writer and reader round trip */
+    void TestWriteRead(void);
+
+    /*! Test search of rows by time */
+    void TestFindRows(void);
+
+    /*! Test reading a file without footer */
+    void TestRecoverIndex(void);
+};
@@ -0,0 +1,352 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include "mtsCollectorReplayTest.h"
+
+#include <cisstMultiTask/mtsCollectorReplay.h>
+#include <cisstMultiTask/mtsCollectorColumnarWriter.h>
+#include <cisstMultiTask/mtsManagerLocal.h>
+#include <cisstMultiTask/mtsStateTable.h>
+#include <cisstMultiTask/mtsInterfaceProvided.h>
+#include <cisstMultiTask/mtsInterfaceRequired.h>
+
+#include <cstdio>
+#include <sstream>
+#include <vector>
+
+
+class mtsCollectorReplayTestComponent: public mtsComponent
+{
+public:
+    mtsStateTable StateTable;
+    mtsDouble Value;
+
+    mtsCollectorReplayTestComponent(const std::string & name):
+        mtsComponent(name),
+        StateTable(100, "Data")
+    {
+        StateTable.AddData(Value, "Value");
+        AddStateTable(&StateTable);
+        SetReplayMode();
+    }
+};
+
+
+class mtsCollectorReplayTestEventsComponent: public mtsCollectorReplayTestComponent
+{
+public:
+    mtsFunctionVoid EventVoid;
+    mtsFunctionWrite EventWrite;
+
+    mtsCollectorReplayTestEventsComponent(const std::string & name):
+        mtsCollectorReplayTestComponent(name)
+    {
+        mtsInterfaceProvided * interfaceProvided = AddInterfaceProvided("Events");
+        interfaceProvided->AddEventVoid(EventVoid, "Void");
+        interfaceProvided->AddEventWrite(EventWrite, "Write", mtsDouble());
+    }
+};
+
+
+class mtsCollectorReplayTestObserver: public mtsComponent
+{
+public:
+    /*! Events received, -1 for void events, payload otherwise */
+    std::vector<double> Received;
+    /*! Value of the replayed state table when an event is received */
+    std::vector<double> Values;
+    mtsCollectorReplayTestComponent * Observed;
+
+    mtsCollectorReplayTestObserver(const std::string & name,
+                                   mtsCollectorReplayTestComponent * observed):
+        mtsComponent(name),
+        Observed(observed)
+    {
+        mtsInterfaceRequired * interfaceRequired = AddInterfaceRequired("Events");
+        interfaceRequired->AddEventHandlerVoid(&mtsCollectorReplayTestObserver::VoidHandler, this,
+                                               "Void", MTS_EVENT_NOT_QUEUED);
+        interfaceRequired->AddEventHandlerWrite(&mtsCollectorReplayTestObserver::WriteHandler, this,
+                                                "Write", MTS_EVENT_NOT_QUEUED);
+    }
+
+    void VoidHandler(void) {
+        Received.push_back(-1.0);
+        Values.push_back(Observed->Value.Data);
+    }
+
+    void WriteHandler(const mtsDouble & payload) {
+        Received.push_back(payload.Data);
+        Values.push_back(Observed->Value.Data);
+    }
+};
+
+
+void mtsCollectorReplayTest::WriteFile(const std::string & fileName, const std::string & componentName,
+                                       const size_t numberOfRows, const double firstTime, const double period,
+                                       const double offset)
+{
+    std::vector<std::string> names, classNames;
+    names.push_back("Tic");
+    classNames.push_back(mtsDouble::ClassServices()->GetName());
+    names.push_back("Value");
+    classNames.push_back(mtsDouble::ClassServices()->GetName());
+    names.push_back("Unknown");
+    classNames.push_back(mtsDouble::ClassServices()->GetName());
+
+    mtsCollectorColumnarWriter writer;
+    writer.SetChunkSize(16);
+    CPPUNIT_ASSERT(writer.Open(fileName, componentName, "Data", "2026-10-18", 0.0, names, classNames));
+    mtsDouble tic, value, unknown;
+    for (size_t row = 0; row < numberOfRows; ++row) {
+        const double time = firstTime + row * period;
+        tic = time;
+        value = offset + row;
+        value.SetTimestamp(time);
+        writer.BeginRow(row, time);
+        writer.AddElement(tic);
+        writer.AddElement(value);
+        writer.AddElement(unknown);
+        writer.EndRow();
+    }
+    CPPUNIT_ASSERT(writer.Close());
+}
+
+
+void mtsCollectorReplayTest::WriteEventFile(const std::string & fileName, const std::string & componentName,
+                                            const size_t numberOfRows, const double firstTime, const double period)
+{
+    std::vector<std::string> names, classNames;
+    names.push_back("Component");
+    names.push_back("Interface");
+    names.push_back("Event");
+    classNames.resize(names.size(), mtsStdString::ClassServices()->GetName());
+    names.push_back("Payload");
+    classNames.push_back(mtsStdCharVecProxy::ClassServices()->GetName());
+
+    mtsCollectorColumnarWriter writer;
+    writer.SetChunkSize(16);
+    CPPUNIT_ASSERT(writer.Open(fileName, "EventCollector", "Events", "2026-10-18", 0.0, names, classNames));
+    mtsStdString component(componentName), interfaceName("Events"), eventName;
+    mtsStdCharVecProxy payload;
+    for (size_t row = 0; row < numberOfRows; ++row) {
+        const double time = firstTime + row * period;
+        payload.Data.clear();
+        if (row % 2) {
+            eventName = std::string("Write");
+            mtsDouble value(static_cast<double>(row));
+            std::stringstream stream;
+            value.SerializeRaw(stream);
+            const std::string serialized = stream.str();
+            payload.Data.assign(serialized.begin(), serialized.end());
+        } else {
+            eventName = std::string("Void");
+        }
+        writer.BeginRow(row, time);
+        writer.AddElement(component);
+        writer.AddElement(interfaceName);
+        writer.AddElement(eventName);
+        writer.AddElement(payload);
+        writer.EndRow();
+    }
+    CPPUNIT_ASSERT(writer.Close());
+}
+
+
+void mtsCollectorReplayTest::TestAddSource(void)
+{
+    mtsManagerLocal * manager = mtsManagerLocal::GetInstance();
+    WriteFile("mtsCollectorReplayTestA.ccol", "mtsCollectorReplayTestA", 10, 0.0, 0.01, 0.0);
+
+    mtsCollectorReplay replay("mtsCollectorReplayTest");
+    // component doesn't exist
+    CPPUNIT_ASSERT(!replay.AddSource("mtsCollectorReplayTestA.ccol"));
+    // component not in replay mode
+    mtsComponent notReplay("mtsCollectorReplayTestA");
+    CPPUNIT_ASSERT(manager->AddComponent(&notReplay));
+    CPPUNIT_ASSERT(!replay.AddSource("mtsCollectorReplayTestA.ccol"));
+    CPPUNIT_ASSERT(manager->RemoveComponent(&notReplay));
+    // file doesn't exist
+    CPPUNIT_ASSERT(!replay.AddSource("mtsCollectorReplayTestMissing.ccol"));
+
+    mtsCollectorReplayTestComponent component("mtsCollectorReplayTestA");
+    CPPUNIT_ASSERT(manager->AddComponent(&component));
+    // wrong state table
+    CPPUNIT_ASSERT(!replay.AddSource("mtsCollectorReplayTestA.ccol", "", "NoTable"));
+    CPPUNIT_ASSERT(replay.AddSource("mtsCollectorReplayTestA.ccol"));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), replay.GetNumberOfSources());
+    CPPUNIT_ASSERT(!component.StateTable.AutomaticAdvance());
+    CPPUNIT_ASSERT(!replay.IsFinished());
+    CPPUNIT_ASSERT(manager->RemoveComponent(&component));
+    remove("mtsCollectorReplayTestA.ccol");
+}
+
+
+void mtsCollectorReplayTest::TestStep(void)
+{
+    mtsManagerLocal * manager = mtsManagerLocal::GetInstance();
+    const size_t numberOfRows = 40;
+    WriteFile("mtsCollectorReplayTestA.ccol", "mtsCollectorReplayTestA", numberOfRows, 100.0, 0.01, 10.0);
+
+    mtsCollectorReplayTestComponent component("mtsCollectorReplayTestA");
+    CPPUNIT_ASSERT(manager->AddComponent(&component));
+    mtsCollectorReplay replay("mtsCollectorReplayTest");
+    CPPUNIT_ASSERT(replay.AddSource("mtsCollectorReplayTestA.ccol"));
+
+    const mtsStateTable::Accessor<mtsDouble> * accessor =
+        dynamic_cast<const mtsStateTable::Accessor<mtsDouble> *>(component.StateTable.GetAccessor(component.Value));
+    CPPUNIT_ASSERT(accessor);
+    mtsDouble value;
+    for (size_t row = 0; row < 10; ++row) {
+        CPPUNIT_ASSERT(replay.Step());
+        const double time = 100.0 + row * 0.01;
+        CPPUNIT_ASSERT_EQUAL(time, replay.GetVirtualTime());
+        CPPUNIT_ASSERT_EQUAL(time, component.StateTable.GetTic());
+        CPPUNIT_ASSERT_EQUAL(time, component.StateTable.GetToc());
+        CPPUNIT_ASSERT(accessor->Get(component.StateTable.GetIndexReader(), value));
+        CPPUNIT_ASSERT_EQUAL(10.0 + row, value.Data);
+        // timestamp is the logged one
+        CPPUNIT_ASSERT_EQUAL(time, value.Timestamp());
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long long>(10), replay.GetNumberOfRowsReplayed());
+
+    // replay up to a given time, included
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(10), replay.StepUntil(100.195));
+    CPPUNIT_ASSERT_EQUAL(29.0, component.Value.Data);
+
+    // seek backward and forward
+    CPPUNIT_ASSERT(replay.Seek(100.05));
+    CPPUNIT_ASSERT(replay.Step());
+    CPPUNIT_ASSERT_EQUAL(15.0, component.Value.Data);
+    CPPUNIT_ASSERT(replay.Seek(100.3));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(10), replay.StepUntil(1000.0));
+    CPPUNIT_ASSERT_EQUAL(49.0, component.Value.Data);
+    CPPUNIT_ASSERT(replay.IsFinished());
+    CPPUNIT_ASSERT(!replay.Step());
+    CPPUNIT_ASSERT(!replay.Seek(200.0));
+    CPPUNIT_ASSERT(replay.IsFinished());
+
+    CPPUNIT_ASSERT(manager->RemoveComponent(&component));
+    remove("mtsCollectorReplayTestA.ccol");
+}
+
+
+void mtsCollectorReplayTest::TestDeterministic(void)
+{
+    mtsManagerLocal * manager = mtsManagerLocal::GetInstance();
+    // B has rows between and at the same time as A
+    WriteFile("mtsCollectorReplayTestA.ccol", "mtsCollectorReplayTestA", 20, 0.0, 0.01, 0.0);
+    WriteFile("mtsCollectorReplayTestB.ccol", "mtsCollectorReplayTestB", 40, 0.0, 0.005, 1000.0);
+
+    mtsCollectorReplayTestComponent componentA("mtsCollectorReplayTestA");
+    mtsCollectorReplayTestComponent componentB("mtsCollectorReplayTestB");
+    CPPUNIT_ASSERT(manager->AddComponent(&componentA));
+    CPPUNIT_ASSERT(manager->AddComponent(&componentB));
+
+    mtsCollectorReplay replay("mtsCollectorReplayTest");
+    CPPUNIT_ASSERT(replay.AddSource("mtsCollectorReplayTestA.ccol"));
+    CPPUNIT_ASSERT(replay.AddSource("mtsCollectorReplayTestB.ccol"));
+
+    // first row of A and B at time 0, A was added first
+    componentA.Value = -1.0;
+    componentB.Value = -1.0;
+    CPPUNIT_ASSERT(replay.Step());
+    CPPUNIT_ASSERT_EQUAL(0.0, componentA.Value.Data);
+    CPPUNIT_ASSERT_EQUAL(-1.0, componentB.Value.Data);
+    CPPUNIT_ASSERT(replay.Step());
+    CPPUNIT_ASSERT_EQUAL(1000.0, componentB.Value.Data);
+
+    // run twice from the same state and compare sequences of values
+    std::vector<double> first, second;
+    componentA.Value = -1.0;
+    componentB.Value = -1.0;
+    CPPUNIT_ASSERT(replay.Seek(0.0));
+    double previousTime = -1.0;
+    while (replay.Step()) {
+        CPPUNIT_ASSERT(replay.GetVirtualTime() >= previousTime);
+        previousTime = replay.GetVirtualTime();
+        first.push_back(componentA.Value.Data + componentB.Value.Data);
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(60), first.size());
+    componentA.Value = -1.0;
+    componentB.Value = -1.0;
+    CPPUNIT_ASSERT(replay.Seek(0.0));
+    while (replay.Step()) {
+        second.push_back(componentA.Value.Data + componentB.Value.Data);
+    }
+    CPPUNIT_ASSERT(first == second);
+
+    CPPUNIT_ASSERT(manager->RemoveComponent(&componentA));
+    CPPUNIT_ASSERT(manager->RemoveComponent(&componentB));
+    remove("mtsCollectorReplayTestA.ccol");
+    remove("mtsCollectorReplayTestB.ccol");
+}
+
+
+void mtsCollectorReplayTest::TestEvents(void)
+{
+    mtsManagerLocal * manager = mtsManagerLocal::GetInstance();
+    // state rows at 0, 0.01, 0.02... and events at 0.005, 0.015...
+    WriteFile("mtsCollectorReplayTestA.ccol", "mtsCollectorReplayTestA", 10, 0.0, 0.01, 0.0);
+    WriteEventFile("mtsCollectorReplayTestEvents.ccol", "mtsCollectorReplayTestA", 6, 0.005, 0.01);
+
+    mtsCollectorReplayTestEventsComponent component("mtsCollectorReplayTestA");
+    mtsCollectorReplayTestObserver observer("mtsCollectorReplayTestObserver", &component);
+    CPPUNIT_ASSERT(manager->AddComponent(&component));
+    CPPUNIT_ASSERT(manager->AddComponent(&observer));
+    CPPUNIT_ASSERT(manager->Connect(observer.GetName(), "Events", component.GetName(), "Events"));
+
+    mtsCollectorReplay replay("mtsCollectorReplayTest");
+    // a state table log is not an event log
+    CPPUNIT_ASSERT(!replay.AddEventSource("mtsCollectorReplayTestA.ccol"));
+    CPPUNIT_ASSERT(!replay.AddEventSource("mtsCollectorReplayTestMissing.ccol"));
+    CPPUNIT_ASSERT(replay.AddSource("mtsCollectorReplayTestA.ccol"));
+    CPPUNIT_ASSERT(replay.AddEventSource("mtsCollectorReplayTestEvents.ccol"));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), replay.GetNumberOfSources());
+
+    // events are triggered at their time, after the state table row
+    // logged just before
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), replay.StepUntil(0.005));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), observer.Received.size());
+    CPPUNIT_ASSERT_EQUAL(-1.0, observer.Received[0]);
+    CPPUNIT_ASSERT_EQUAL(0.0, observer.Values[0]);
+    while (replay.Step()) {
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long long>(16), replay.GetNumberOfRowsReplayed());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(6), observer.Received.size());
+    for (size_t row = 0; row < 6; ++row) {
+        CPPUNIT_ASSERT_EQUAL((row % 2) ? static_cast<double>(row) : -1.0, observer.Received[row]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<double>(row), observer.Values[row]);
+    }
+
+    // same sequence after seek
+    const std::vector<double> first = observer.Received;
+    observer.Received.clear();
+    observer.Values.clear();
+    CPPUNIT_ASSERT(replay.Seek(0.0));
+    while (replay.Step()) {
+    }
+    CPPUNIT_ASSERT(first == observer.Received);
+
+    CPPUNIT_ASSERT(manager->Disconnect(observer.GetName(), "Events", component.GetName(), "Events"));
+    CPPUNIT_ASSERT(manager->RemoveComponent(&observer));
+    CPPUNIT_ASSERT(manager->RemoveComponent(&component));
+    remove("mtsCollectorReplayTestA.ccol");
+    remove("mtsCollectorReplayTestEvents.ccol");
+}
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(mtsCollectorReplayTest);
@@ -0,0 +1,64 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <string>
+
+class mtsCollectorReplayTest: public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(mtsCollectorReplayTest);
+    {
+        CPPUNIT_TEST(TestAddSource);
+        CPPUNIT_TEST(TestStep);
+        CPPUNIT_TEST(TestDeterministic);
+        CPPUNIT_TEST(TestEvents);
+    }
+    CPPUNIT_TEST_SUITE_END();
+
+protected:
+    /*! Write a file with a single signal "Value", rows at
+      firstTime + row * period with value offset + row */
+    void WriteFile(const std::string & fileName, const std::string & componentName,
+                   const size_t numberOfRows, const double firstTime, const double period,
+                   const double offset);
+
+    /*! Write an event log with alternating void and write events,
+      rows at firstTime + row * period, write events payload is row */
+    void WriteEventFile(const std::string & fileName, const std::string & componentName,
+                        const size_t numberOfRows, const double firstTime, const double period);
+
+public:
+    void setUp(void) {
+    }
+
+    void tearDown(void) {
+    }
+
+    /*! Test matching of sources with components */
+    void TestAddSource(void);
+
+    /*! Test replayed values and virtual time */
+    void TestStep(void);
+
+    /*! Test order of rows from multiple sources */
+    void TestDeterministic(void);
+
+    /*! Test replay of event logs */
+    void TestEvents(void);
+};
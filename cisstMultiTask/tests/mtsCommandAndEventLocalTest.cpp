@@ -491,6 +491,50 @@ void mtsCommandAndEventLocalTest::TestFromSignalFromSignalBlocking_int(void) {
 }
 
 
+void mtsCommandAndEventLocalTest::TestBlockingResults(void)
+{
+    mtsTestContinuous1<int> * client = new mtsTestContinuous1<int>("mtsTestContinuous1Client");
+    mtsTestContinuous1<int> * server = new mtsTestContinuous1<int>("mtsTestContinuous1Server");
+
+    mtsManagerLocal * manager = mtsManagerLocal::GetInstance();
+    manager->RemoveAllUserComponents();
+
+    // add to manager and start all
+    CPPUNIT_ASSERT(manager->AddComponent(client));
+    CPPUNIT_ASSERT(manager->AddComponent(server));
+    CPPUNIT_ASSERT(manager->Connect(client->GetName(), "r1", server->GetName(), "p1"));
+    manager->CreateAll();
+    CPPUNIT_ASSERT(manager->WaitForStateAll(mtsComponentState::READY, StateTransitionMaximumDelay));
+    manager->StartAll();
+    CPPUNIT_ASSERT(manager->WaitForStateAll(mtsComponentState::ACTIVE, StateTransitionMaximumDelay));
+
+    // the server replies right away so the caller is woken up while
+    // the result is being sent back
+    mtsExecutionResult executionResult;
+    const int valueWrite = 4;
+    int valueRead;
+    for (unsigned int index = 0; index < 1000; index++) {
+        executionResult = client->InterfaceRequired1.FunctionVoid.ExecuteBlocking();
+        CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_SUCCEEDED, executionResult.GetResult());
+        executionResult = client->InterfaceRequired1.FunctionWrite.ExecuteBlocking(valueWrite);
+        CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_SUCCEEDED, executionResult.GetResult());
+        valueRead = 0;
+        executionResult = client->InterfaceRequired1.FunctionVoidReturn(valueRead);
+        CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_SUCCEEDED, executionResult.GetResult());
+        CPPUNIT_ASSERT_EQUAL(1, valueRead); // number was positive
+    }
+
+    // stop all and cleanup
+    manager->KillAll();
+    CPPUNIT_ASSERT(manager->WaitForStateAll(mtsComponentState::FINISHED, StateTransitionMaximumDelay));
+    CPPUNIT_ASSERT(manager->Disconnect(client->GetName(), "r1", server->GetName(), "p1"));
+    CPPUNIT_ASSERT(manager->RemoveComponent(client));
+    CPPUNIT_ASSERT(manager->RemoveComponent(server));
+    delete client;
+    delete server;
+}
+
+
 template <class _elementType>
 void mtsCommandAndEventLocalTest::TestArgumentPrototypes(void)
 {
@@ -55,6 +55,8 @@ private:
         CPPUNIT_TEST(TestFromSignalFromSignalBlocking_mtsInt);
         CPPUNIT_TEST(TestFromSignalFromSignalBlocking_int);
 
+        CPPUNIT_TEST(TestBlockingResults);
+
         CPPUNIT_TEST(TestArgumentPrototypes_mtsInt);
         CPPUNIT_TEST(TestArgumentPrototypes_int);
     }
@@ -107,6 +109,10 @@ public:
     void TestFromSignalFromSignalBlocking_mtsInt(void);
     void TestFromSignalFromSignalBlocking_int(void);
 
+    /*! Repeat blocking commands without delay to make sure the
+      result is always received by the caller */
+    void TestBlockingResults(void);
+
     template <class _elementType> void TestArgumentPrototypes(void);
     void TestArgumentPrototypes_mtsInt(void);
     void TestArgumentPrototypes_int(void);
@@ -0,0 +1,183 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include "mtsIntervalStatisticsTest.h"
+
+#include <cisstCommon/cmnUnits.h>
+#include <cisstMultiTask/mtsIntervalHistogram.h>
+#include <cisstMultiTask/mtsIntervalStatistics.h>
+
+#include <sstream>
+
+
+void mtsIntervalStatisticsTest::TestHistogramPercentiles(void)
+{
+    mtsIntervalHistogram histogram;
+    CPPUNIT_ASSERT_EQUAL(0u, histogram.GetNumberOfSamples());
+    CPPUNIT_ASSERT_EQUAL(0.0, histogram.Percentile(50.0));
+
+    // 1 to 10000 microseconds
+    for (unsigned int index = 1; index <= 10000; ++index) {
+        histogram.Add(index * cmn_us);
+    }
+    CPPUNIT_ASSERT_EQUAL(10000u, histogram.GetNumberOfSamples());
+    const double tolerance = 1.0 / 32.0; // relative
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(5000.0 * cmn_us, histogram.Percentile(50.0), 5000.0 * cmn_us * tolerance);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(9900.0 * cmn_us, histogram.Percentile(99.0), 9900.0 * cmn_us * tolerance);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(9990.0 * cmn_us, histogram.Percentile(99.9), 9990.0 * cmn_us * tolerance);
+    // percentiles never exceed min/max
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(10000.0 * cmn_us, histogram.Percentile(100.0), 1.0 * cmn_ns);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0 * cmn_us, histogram.Percentile(0.0), 1.0 * cmn_us * tolerance);
+
+    // one outlier shows in p99.9 but not in p99
+    histogram.Reset();
+    for (unsigned int index = 0; index < 999; ++index) {
+        histogram.Add(1.0 * cmn_ms);
+    }
+    histogram.Add(50.0 * cmn_ms);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0 * cmn_ms, histogram.Percentile(99.0), 1.0 * cmn_ms * tolerance);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1.0 * cmn_ms, histogram.Percentile(99.9), 1.0 * cmn_ms * tolerance);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(50.0 * cmn_ms, histogram.Percentile(99.95), 50.0 * cmn_ms * tolerance);
+}
+
+
+void mtsIntervalStatisticsTest::TestHistogramRange(void)
+{
+    mtsIntervalHistogram histogram;
+    histogram.Add(-1.0);
+    CPPUNIT_ASSERT_EQUAL(0.0, histogram.Percentile(50.0));
+    histogram.Reset();
+    histogram.Add(10.0 * cmn_ns);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(10.0 * cmn_ns, histogram.Percentile(50.0), 0.5 * cmn_ns);
+    histogram.Reset();
+    // larger than highest bucket, percentile is bounded by max
+    histogram.Add(1000.0 * cmn_s);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1000.0 * cmn_s, histogram.Percentile(50.0), 1.0 * cmn_ms);
+}
+
+
+void mtsIntervalStatisticsTest::TestPercentiles(void)
+{
+    mtsIntervalStatistics statistics;
+    statistics.SetPercentilesEnabled(true);
+    // accumulate with long interval, then force update
+    statistics.SetStatisticsInterval(1000.0 * cmn_s);
+    for (unsigned int index = 1; index <= 1000; ++index) {
+        statistics.Update(index * cmn_us, 0.5 * index * cmn_us);
+    }
+    CPPUNIT_ASSERT_EQUAL(0.0, statistics.PeriodP99());
+    statistics.SetStatisticsInterval(-1.0);
+    statistics.Update(1000.0 * cmn_us, 500.0 * cmn_us);
+    CPPUNIT_ASSERT_EQUAL(1001u, statistics.NumberOfSamples());
+    const double tolerance = 1.0 / 32.0;
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(500.0 * cmn_us, statistics.PeriodP50(), 500.0 * cmn_us * tolerance);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(900.0 * cmn_us, statistics.PeriodP90(), 900.0 * cmn_us * tolerance);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(990.0 * cmn_us, statistics.PeriodP99(), 990.0 * cmn_us * tolerance);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(1000.0 * cmn_us, statistics.PeriodP999(), 1000.0 * cmn_us * tolerance);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(250.0 * cmn_us, statistics.ComputeTimeP50(), 250.0 * cmn_us * tolerance);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(495.0 * cmn_us, statistics.ComputeTimeP99(), 495.0 * cmn_us * tolerance);
+
+    // copies keep results and can be updated
+    mtsIntervalStatistics copy(statistics);
+    CPPUNIT_ASSERT_EQUAL(statistics.PeriodP99(), copy.PeriodP99());
+    copy.Update(2.0 * cmn_ms, 1.0 * cmn_ms);
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(2.0 * cmn_ms, copy.PeriodP50(), 1.0 * cmn_ns);
+
+    // histograms are reset for each interval
+    statistics.Update(3.0 * cmn_ms, 1.0 * cmn_ms);
+    CPPUNIT_ASSERT_EQUAL(1u, statistics.NumberOfSamples());
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(3.0 * cmn_ms, statistics.PeriodP50(), 1.0 * cmn_ns);
+}
+
+
+void mtsIntervalStatisticsTest::TestPercentilesDisabled(void)
+{
+    mtsIntervalStatistics statistics, result;
+    CPPUNIT_ASSERT(!statistics.PercentilesEnabled());
+    statistics.SetStatisticsInterval(-1.0);
+    statistics.Update(1.0 * cmn_ms, 0.25 * cmn_ms);
+    CPPUNIT_ASSERT_EQUAL(1u, statistics.NumberOfSamples());
+    CPPUNIT_ASSERT_EQUAL(0.0, statistics.PeriodP50());
+    CPPUNIT_ASSERT_EQUAL(0.0, statistics.ComputeTimeP999());
+
+    // timestamp, 8 statistics, number of samples and overruns and
+    // interval, same as before percentiles were introduced
+    std::stringstream stream;
+    statistics.SerializeRaw(stream);
+    CPPUNIT_ASSERT_EQUAL(9 * sizeof(double) + 2 * sizeof(unsigned int) + sizeof(double),
+                         stream.str().size());
+    result.SetPercentilesEnabled(true);
+    result.DeSerializeRaw(stream);
+    CPPUNIT_ASSERT(!result.PercentilesEnabled());
+    CPPUNIT_ASSERT_EQUAL(1u, result.NumberOfSamples());
+    CPPUNIT_ASSERT_EQUAL(statistics.PeriodAvg(), result.PeriodAvg());
+    CPPUNIT_ASSERT_EQUAL(0.0, result.PeriodP50());
+
+    // no percentiles in text output
+    std::stringstream text;
+    statistics.ToStreamRaw(text, ',', true);
+    CPPUNIT_ASSERT(text.str().find("P50") == std::string::npos);
+}
+
+
+void mtsIntervalStatisticsTest::TestSerializeRaw(void)
+{
+    mtsIntervalStatistics statistics, result;
+    statistics.SetPercentilesEnabled(true);
+    statistics.SetStatisticsInterval(-1.0);
+    statistics.Update(1.0 * cmn_ms, 0.25 * cmn_ms);
+    std::stringstream stream;
+    statistics.SerializeRaw(stream);
+
+    // number of samples is serialized as is, after timestamp and 8 statistics
+    std::stringstream fields(stream.str());
+    double value;
+    for (size_t index = 0; index < 9; ++index) {
+        cmnDeSerializeRaw(fields, value);
+    }
+    unsigned int numberOfSamples;
+    cmnDeSerializeRaw(fields, numberOfSamples);
+    CPPUNIT_ASSERT_EQUAL(1u, numberOfSamples);
+    // overruns, tag, interval and 8 percentiles
+    unsigned int numberOfOverruns;
+    cmnDeSerializeRaw(fields, numberOfOverruns);
+    cmnDeSerializeRaw(fields, value);
+    CPPUNIT_ASSERT(cmnTypeTraits<double>::IsNaN(value));
+    cmnDeSerializeRaw(fields, value);
+    CPPUNIT_ASSERT_EQUAL(-1.0, value);
+    for (size_t index = 0; index < 8; ++index) {
+        cmnDeSerializeRaw(fields, value);
+    }
+    CPPUNIT_ASSERT(fields.good());
+    CPPUNIT_ASSERT_EQUAL(static_cast<int>(std::char_traits<char>::eof()), fields.peek());
+
+    result.DeSerializeRaw(stream);
+    CPPUNIT_ASSERT(result.PercentilesEnabled());
+    CPPUNIT_ASSERT_EQUAL(1u, result.NumberOfSamples());
+    CPPUNIT_ASSERT_EQUAL(statistics.PeriodP50(), result.PeriodP50());
+    CPPUNIT_ASSERT_EQUAL(statistics.PeriodP90(), result.PeriodP90());
+    CPPUNIT_ASSERT_EQUAL(statistics.PeriodP99(), result.PeriodP99());
+    CPPUNIT_ASSERT_EQUAL(statistics.PeriodP999(), result.PeriodP999());
+    CPPUNIT_ASSERT_EQUAL(statistics.ComputeTimeP50(), result.ComputeTimeP50());
+    CPPUNIT_ASSERT_EQUAL(statistics.ComputeTimeP90(), result.ComputeTimeP90());
+    CPPUNIT_ASSERT_EQUAL(statistics.ComputeTimeP99(), result.ComputeTimeP99());
+    CPPUNIT_ASSERT_EQUAL(statistics.ComputeTimeP999(), result.ComputeTimeP999());
+    CPPUNIT_ASSERT_EQUAL(statistics.StatisticsInterval(), result.StatisticsInterval());
+}
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(mtsIntervalStatisticsTest);
@@ -0,0 +1,55 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class mtsIntervalStatisticsTest: public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(mtsIntervalStatisticsTest);
+    {
+        CPPUNIT_TEST(TestHistogramPercentiles);
+        CPPUNIT_TEST(TestHistogramRange);
+        CPPUNIT_TEST(TestPercentiles);
+        CPPUNIT_TEST(TestPercentilesDisabled);
+        CPPUNIT_TEST(TestSerializeRaw);
+    }
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp(void) {
+    }
+
+    void tearDown(void) {
+    }
+
+    /*! Check percentiles on uniform distribution */
+    void TestHistogramPercentiles(void);
+
+    /*! Check very small, very large and negative values */
+    void TestHistogramRange(void);
+
+    /*! Check percentiles computed by mtsIntervalStatistics::Update */
+    void TestPercentiles(void);
+
+    /*! Check that default serialization is unchanged when percentiles
+      are disabled */
+    void TestPercentilesDisabled(void);
+
+    /*! Check that percentiles are serialized */
+    void TestSerializeRaw(void);
+};
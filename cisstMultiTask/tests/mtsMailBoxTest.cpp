@@ -0,0 +1,483 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include "mtsMailBoxTest.h"
+
+#include <cisstMultiTask/mtsCallableVoidMethod.h>
+#include <cisstMultiTask/mtsCommandQueuedVoid.h>
+#include <cisstMultiTask/mtsCommandWrite.h>
+#include <cisstMultiTask/mtsCommandQueuedWriteLatest.h>
+#include <cisstMultiTask/mtsCommandTracer.h>
+#include <cisstMultiTask/mtsMulticastCommandWrite.h>
+#include <cisstMultiTask/mtsSharedArgument.h>
+#include <cisstMultiTask/mtsGenericObjectProxy.h>
+#include <cisstCommon/cmnUnits.h>
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstOSAbstraction/osaSleep.h>
+
+#include <sstream>
+#include <vector>
+
+// records the order in which commands are executed
+class mtsMailBoxTestRecorder
+{
+public:
+    std::vector<int> Executed;
+    size_t DoorBellCounter;
+    mtsMailBox * MailBoxToRemove;
+
+    mtsMailBoxTestRecorder(void):
+        DoorBellCounter(0),
+        MailBoxToRemove(0)
+    {}
+
+    void DoorBell(void) {
+        DoorBellCounter++;
+    }
+    void Command0(void) {
+        Executed.push_back(0);
+    }
+    void Command1(void) {
+        Executed.push_back(1);
+    }
+    void Command2(void) {
+        Executed.push_back(2);
+    }
+    void CommandRemove(void) {
+        Executed.push_back(-1);
+        MailBoxToRemove->SetReadyList(0);
+    }
+    std::vector<double> Values;
+    void Value(const mtsDouble & value) {
+        Values.push_back(value.Data);
+    }
+};
+
+
+void mtsMailBoxTest::TestReadyList(void)
+{
+    mtsMailBoxTestRecorder recorder;
+    mtsCallableVoidMethod<mtsMailBoxTestRecorder> doorBell(&mtsMailBoxTestRecorder::DoorBell, &recorder);
+    mtsCallableVoidMethod<mtsMailBoxTestRecorder> callable0(&mtsMailBoxTestRecorder::Command0, &recorder);
+    mtsCallableVoidMethod<mtsMailBoxTestRecorder> callable1(&mtsMailBoxTestRecorder::Command1, &recorder);
+    mtsCallableVoidMethod<mtsMailBoxTestRecorder> callable2(&mtsMailBoxTestRecorder::Command2, &recorder);
+
+    const size_t size = 10;
+    mtsMailBoxReadyList readyList("readyList", &doorBell);
+    mtsMailBox mailBox0("mailBox0", size);
+    mtsMailBox mailBox1("mailBox1", size);
+    mtsMailBox mailBox2("mailBox2", size);
+    mailBox0.SetReadyList(&readyList);
+    mailBox1.SetReadyList(&readyList);
+    mailBox2.SetReadyList(&readyList);
+    mtsCommandQueuedVoid command0(&callable0, "command0", &mailBox0, size);
+    mtsCommandQueuedVoid command1(&callable1, "command1", &mailBox1, size);
+    mtsCommandQueuedVoid command2(&callable2, "command2", &mailBox2, size);
+
+    CPPUNIT_ASSERT(readyList.IsEmpty());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), readyList.ExecuteAll());
+
+    // first command on empty list rings the doorbell
+    command1.Execute(MTS_NOT_BLOCKING);
+    CPPUNIT_ASSERT(!readyList.IsEmpty());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), recorder.DoorBellCounter);
+    // more commands, no more doorbell
+    command1.Execute(MTS_NOT_BLOCKING);
+    command0.Execute(MTS_NOT_BLOCKING);
+    command1.Execute(MTS_NOT_BLOCKING);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), recorder.DoorBellCounter);
+
+    // mailboxes processed in scheduling order, mailBox2 untouched
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(4), readyList.ExecuteAll());
+    CPPUNIT_ASSERT(readyList.IsEmpty());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(4), recorder.Executed.size());
+    CPPUNIT_ASSERT_EQUAL(1, recorder.Executed[0]);
+    CPPUNIT_ASSERT_EQUAL(1, recorder.Executed[1]);
+    CPPUNIT_ASSERT_EQUAL(1, recorder.Executed[2]);
+    CPPUNIT_ASSERT_EQUAL(0, recorder.Executed[3]);
+    CPPUNIT_ASSERT(mailBox0.IsEmpty());
+    CPPUNIT_ASSERT(mailBox1.IsEmpty());
+
+    // mailboxes can be scheduled again
+    recorder.Executed.clear();
+    command2.Execute(MTS_NOT_BLOCKING);
+    command0.Execute(MTS_NOT_BLOCKING);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), recorder.DoorBellCounter);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), readyList.ExecuteAll());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), recorder.Executed.size());
+    CPPUNIT_ASSERT_EQUAL(2, recorder.Executed[0]);
+    CPPUNIT_ASSERT_EQUAL(0, recorder.Executed[1]);
+}
+
+
+void mtsMailBoxTest::TestReadyListRemove(void)
+{
+    mtsMailBoxTestRecorder recorder;
+    mtsCallableVoidMethod<mtsMailBoxTestRecorder> callable0(&mtsMailBoxTestRecorder::Command0, &recorder);
+    mtsCallableVoidMethod<mtsMailBoxTestRecorder> callable1(&mtsMailBoxTestRecorder::Command1, &recorder);
+
+    const size_t size = 10;
+    mtsMailBoxReadyList readyList("readyList");
+    mtsMailBox mailBox0("mailBox0", size);
+    mtsMailBox mailBox1("mailBox1", size);
+    mailBox0.SetReadyList(&readyList);
+    mailBox1.SetReadyList(&readyList);
+    mtsCommandQueuedVoid command0(&callable0, "command0", &mailBox0, size);
+    mtsCommandQueuedVoid command1(&callable1, "command1", &mailBox1, size);
+
+    command0.Execute(MTS_NOT_BLOCKING);
+    command1.Execute(MTS_NOT_BLOCKING);
+    // removing the ready list from a mailbox removes it from the list
+    mailBox0.SetReadyList(0);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), readyList.ExecuteAll());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), recorder.Executed.size());
+    CPPUNIT_ASSERT_EQUAL(1, recorder.Executed[0]);
+    CPPUNIT_ASSERT(!mailBox0.IsEmpty());
+    CPPUNIT_ASSERT(readyList.IsEmpty());
+}
+
+
+void mtsMailBoxTest::TestReadyListRemoveFromCommand(void)
+{
+    mtsMailBoxTestRecorder recorder;
+    mtsCallableVoidMethod<mtsMailBoxTestRecorder> callable0(&mtsMailBoxTestRecorder::CommandRemove, &recorder);
+    mtsCallableVoidMethod<mtsMailBoxTestRecorder> callable1(&mtsMailBoxTestRecorder::Command1, &recorder);
+    mtsCallableVoidMethod<mtsMailBoxTestRecorder> callable2(&mtsMailBoxTestRecorder::Command2, &recorder);
+
+    const size_t size = 10;
+    mtsMailBoxReadyList readyList("readyList");
+    mtsMailBox mailBox0("mailBox0", size);
+    mtsMailBox mailBox1("mailBox1", size);
+    mtsMailBox mailBox2("mailBox2", size);
+    mailBox0.SetReadyList(&readyList);
+    mailBox1.SetReadyList(&readyList);
+    mailBox2.SetReadyList(&readyList);
+    mtsCommandQueuedVoid command0(&callable0, "command0", &mailBox0, size);
+    mtsCommandQueuedVoid command1(&callable1, "command1", &mailBox1, size);
+    mtsCommandQueuedVoid command2(&callable2, "command2", &mailBox2, size);
+
+    // first command removes mailBox1, taken by ExecuteAll but not processed yet
+    recorder.MailBoxToRemove = &mailBox1;
+    command0.Execute(MTS_NOT_BLOCKING);
+    command1.Execute(MTS_NOT_BLOCKING);
+    command2.Execute(MTS_NOT_BLOCKING);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), readyList.ExecuteAll());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), recorder.Executed.size());
+    CPPUNIT_ASSERT_EQUAL(-1, recorder.Executed[0]);
+    CPPUNIT_ASSERT_EQUAL(2, recorder.Executed[1]);
+    CPPUNIT_ASSERT(!mailBox1.IsEmpty());
+    CPPUNIT_ASSERT(readyList.IsEmpty());
+    CPPUNIT_ASSERT(mailBox1.GetReadyList() == 0);
+}
+
+
+void mtsMailBoxTest::TestReadyListFull(void)
+{
+    mtsMailBoxTestRecorder recorder;
+    mtsCallableVoidMethod<mtsMailBoxTestRecorder> doorBell(&mtsMailBoxTestRecorder::DoorBell, &recorder);
+    mtsCallableVoidMethod<mtsMailBoxTestRecorder> callable0(&mtsMailBoxTestRecorder::Command0, &recorder);
+
+    const size_t size = 2;
+    mtsMailBoxReadyList readyList("readyList", &doorBell);
+    mtsMailBox mailBox0("mailBox0", size);
+    mtsCommandQueuedVoid command0(&callable0, "command0", &mailBox0, size);
+
+    // fill the mailbox before it uses the ready list
+    size_t queued = 0;
+    while (mailBox0.Write(&command0)) {
+        queued++;
+    }
+    CPPUNIT_ASSERT(queued > 0);
+    mailBox0.SetReadyList(&readyList);
+
+    // command can't be queued, mailbox is not scheduled
+    CPPUNIT_ASSERT(!mailBox0.Write(&command0));
+    CPPUNIT_ASSERT(readyList.IsEmpty());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), recorder.DoorBellCounter);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), readyList.ExecuteAll());
+}
+
+
+void mtsMailBoxTest::TestTracerQueueFull(void)
+{
+    mtsMailBoxTestRecorder recorder;
+    mtsCallableVoidMethod<mtsMailBoxTestRecorder> callable0(&mtsMailBoxTestRecorder::Command0, &recorder);
+
+    const size_t size = 2;
+    mtsMailBox mailBox0("mailBox0", size);
+    mtsCommandQueuedVoid command0(&callable0, "tracerCommand0", &mailBox0, size);
+
+    mtsCommandTracer::Clear();
+    mtsCommandTracer::Start();
+    size_t queued = 0;
+    while (mailBox0.Write(&command0)) {
+        queued++;
+    }
+    mtsCommandTracer::Stop();
+    CPPUNIT_ASSERT(queued > 0);
+
+    // one ENQUEUE per write and one ENQUEUE_FAILED
+    CPPUNIT_ASSERT_EQUAL(queued + 2, mtsCommandTracer::GetNumberOfRecords());
+    mtsCommandTracer::StatisticsType statistics;
+    mtsCommandTracer::GetStatistics(statistics);
+    const mtsCommandTracer::CommandStatistics & command = statistics["tracerCommand0"];
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), command.QueueFull);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), command.Queue.Count);
+
+    // the rejected call is shown as an instant, not a flow
+    std::stringstream trace;
+    mtsCommandTracer::ExportChromeTrace(trace);
+    CPPUNIT_ASSERT(trace.str().find("\"queue full\"") != std::string::npos);
+    size_t flows = 0;
+    for (size_t position = trace.str().find("\"ph\":\"s\"");
+         position != std::string::npos;
+         position = trace.str().find("\"ph\":\"s\"", position + 1)) {
+        flows++;
+    }
+    CPPUNIT_ASSERT_EQUAL(queued, flows);
+    mtsCommandTracer::Clear();
+}
+
+
+class mtsMailBoxTestTracedWriter
+{
+public:
+    mtsCommandQueuedVoid * Command;
+    bool Written;
+
+    void * Run(int CMN_UNUSED(dummy)) {
+        Written = Command->Execute(MTS_NOT_BLOCKING).IsOK();
+        return 0;
+    }
+};
+
+
+void mtsMailBoxTest::TestTracerThreadBuffers(void)
+{
+    mtsMailBoxTestRecorder recorder;
+    mtsCallableVoidMethod<mtsMailBoxTestRecorder> callable0(&mtsMailBoxTestRecorder::Command0, &recorder);
+
+    const size_t size = 4;
+    mtsMailBox mailBox0("mailBox0", size);
+    mtsCommandQueuedVoid command0(&callable0, "tracerCommand0", &mailBox0, size);
+
+    mtsCommandTracer::Clear();
+    mtsCommandTracer::Start();
+    // make sure the current thread has a buffer
+    CPPUNIT_ASSERT(command0.Execute(MTS_NOT_BLOCKING).IsOK());
+    CPPUNIT_ASSERT(mailBox0.ExecuteNext());
+    const size_t buffers = mtsCommandTracer::GetNumberOfBuffers();
+
+    // threads running one after another reuse the same buffer
+    mtsMailBoxTestTracedWriter writer;
+    writer.Command = &command0;
+    for (size_t index = 0; index < 10; ++index) {
+        writer.Written = false;
+        osaThread thread;
+        thread.Create<mtsMailBoxTestTracedWriter, int>(&writer, &mtsMailBoxTestTracedWriter::Run, 0);
+        thread.Wait();
+        CPPUNIT_ASSERT(writer.Written);
+        CPPUNIT_ASSERT(mailBox0.ExecuteNext());
+    }
+    mtsCommandTracer::Stop();
+    CPPUNIT_ASSERT(mtsCommandTracer::GetNumberOfBuffers() <= buffers + 1);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(11), recorder.Executed.size());
+    mtsCommandTracer::Clear();
+}
+
+
+void mtsMailBoxTest::TestQueuedWriteLatest(void)
+{
+    mtsMailBoxTestRecorder recorder;
+    const size_t size = 10;
+    mtsMailBox mailBox("mailBox", size);
+    mtsCommandWrite<mtsMailBoxTestRecorder, mtsDouble> actualCommand(&mtsMailBoxTestRecorder::Value, &recorder,
+                                                                     "Value", mtsDouble());
+    mtsCommandQueuedWriteLatest latest(&mailBox, &actualCommand);
+    mtsCommandWriteBase & command = latest;
+
+    // more calls than the mailbox size, only one entry used
+    for (size_t index = 0; index < 3 * size; ++index) {
+        CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_QUEUED,
+                             command.Execute(mtsDouble(static_cast<double>(index)), MTS_NOT_BLOCKING).GetResult());
+    }
+    CPPUNIT_ASSERT(mailBox.ExecuteNext());
+    CPPUNIT_ASSERT(mailBox.IsEmpty());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), recorder.Values.size());
+    CPPUNIT_ASSERT_EQUAL(static_cast<double>(3 * size - 1), recorder.Values[0]);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long long>(3 * size - 1), latest.GetNumberOfConflated());
+
+    // processed values are not processed again
+    CPPUNIT_ASSERT(!mailBox.ExecuteNext());
+    command.Execute(mtsDouble(100.0), MTS_NOT_BLOCKING);
+    CPPUNIT_ASSERT(mailBox.ExecuteNext());
+    CPPUNIT_ASSERT(!mailBox.ExecuteNext());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), recorder.Values.size());
+    CPPUNIT_ASSERT_EQUAL(100.0, recorder.Values[1]);
+
+    // clone used for end user interfaces
+    mtsMailBox otherMailBox("otherMailBox", size);
+    mtsCommandQueuedWriteBase * clone = latest.Clone(&otherMailBox, size);
+    CPPUNIT_ASSERT(dynamic_cast<mtsCommandQueuedWriteLatest *>(clone));
+    clone->Execute(mtsDouble(1.0), MTS_NOT_BLOCKING);
+    clone->Execute(mtsDouble(2.0), MTS_NOT_BLOCKING);
+    CPPUNIT_ASSERT(otherMailBox.ExecuteNext());
+    CPPUNIT_ASSERT(otherMailBox.IsEmpty());
+    CPPUNIT_ASSERT_EQUAL(2.0, recorder.Values.back());
+    delete clone;
+
+    // wrong argument type
+    CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::INVALID_INPUT_TYPE,
+                         command.Execute(mtsInt(1), MTS_NOT_BLOCKING).GetResult());
+}
+
+
+class mtsMailBoxTestWriter
+{
+public:
+    mtsCommandWriteBase * Command;
+    size_t NumberOfValues;
+
+    void * Run(int CMN_UNUSED(dummy)) {
+        for (size_t index = 1; index <= NumberOfValues; ++index) {
+            Command->Execute(mtsDouble(static_cast<double>(index)), MTS_NOT_BLOCKING);
+            if ((index % 100) == 0) {
+                osaSleep(10.0 * cmn_us);
+            }
+        }
+        return 0;
+    }
+};
+
+
+void mtsMailBoxTest::TestQueuedWriteLatestThreads(void)
+{
+    mtsMailBoxTestRecorder recorder;
+    mtsMailBox mailBox("mailBox", 4);
+    mtsCommandWrite<mtsMailBoxTestRecorder, mtsDouble> actualCommand(&mtsMailBoxTestRecorder::Value, &recorder,
+                                                                     "Value", mtsDouble());
+    mtsCommandQueuedWriteLatest command(&mailBox, &actualCommand);
+
+    mtsMailBoxTestWriter writer;
+    writer.Command = &command;
+    writer.NumberOfValues = 100000;
+    osaThread thread;
+    thread.Create<mtsMailBoxTestWriter, int>(&writer, &mtsMailBoxTestWriter::Run, 0);
+    // slow reader
+    while (recorder.Values.empty()
+           || (recorder.Values.back() != static_cast<double>(writer.NumberOfValues))) {
+        while (mailBox.ExecuteNext()) {}
+        osaSleep(100.0 * cmn_us);
+    }
+    thread.Wait();
+    while (mailBox.ExecuteNext()) {}
+
+    // values are processed once and in order, the last one is always processed
+    for (size_t index = 1; index < recorder.Values.size(); ++index) {
+        CPPUNIT_ASSERT(recorder.Values[index] > recorder.Values[index - 1]);
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<double>(writer.NumberOfValues), recorder.Values.back());
+    CPPUNIT_ASSERT(recorder.Values.size() < writer.NumberOfValues);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned long long>(writer.NumberOfValues - recorder.Values.size()),
+                         command.GetNumberOfConflated());
+}
+
+
+void mtsMailBoxTest::TestMulticastSharedArgument(void)
+{
+    const size_t numberOfObservers = 12;
+    const size_t size = 8;
+    mtsMulticastCommandWriteGeneric multicast("Value", mtsDouble());
+    std::vector<mtsMailBoxTestRecorder> recorders(numberOfObservers + 2);
+    std::vector<mtsMailBox *> mailBoxes;
+    std::vector<mtsCommandWriteBase *> commands;
+    size_t index;
+    for (index = 0; index < numberOfObservers; ++index) {
+        mtsMailBox * mailBox = new mtsMailBox("mailBox", size);
+        mtsCommandWriteBase * actualCommand =
+            new mtsCommandWrite<mtsMailBoxTestRecorder, mtsDouble>(&mtsMailBoxTestRecorder::Value, &recorders[index],
+                                                                   "Value", mtsDouble());
+        mtsCommandQueuedWriteGeneric * queued = new mtsCommandQueuedWriteGeneric(mailBox, actualCommand, size);
+        CPPUNIT_ASSERT(multicast.AddCommand(queued));
+        mailBoxes.push_back(mailBox);
+        commands.push_back(actualCommand);
+        commands.push_back(queued);
+    }
+    // observers which don't share the argument
+    mtsMailBox latestMailBox("latestMailBox", size);
+    mtsCommandWrite<mtsMailBoxTestRecorder, mtsDouble> latestActual(&mtsMailBoxTestRecorder::Value, &recorders[numberOfObservers],
+                                                                    "Value", mtsDouble());
+    mtsCommandQueuedWriteLatest latest(&latestMailBox, &latestActual);
+    CPPUNIT_ASSERT(multicast.AddCommand(&latest));
+    mtsCommandWrite<mtsMailBoxTestRecorder, mtsDouble> direct(&mtsMailBoxTestRecorder::Value, &recorders[numberOfObservers + 1],
+                                                              "Value", mtsDouble());
+    CPPUNIT_ASSERT(multicast.AddCommand(&direct));
+
+    // one copy per event, not per observer
+    CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_SUCCEEDED,
+                         multicast.Execute(mtsDouble(1.0), MTS_NOT_BLOCKING).GetResult());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), multicast.GetNumberOfSharedArguments());
+    CPPUNIT_ASSERT_EQUAL(1.0, recorders[numberOfObservers + 1].Values.back());
+    multicast.Execute(mtsDouble(2.0), MTS_NOT_BLOCKING);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), multicast.GetNumberOfSharedArguments());
+
+    // arguments copied in the queue and shared arguments are processed in order
+    CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_QUEUED,
+                         commands[1]->Execute(mtsDouble(3.0), MTS_NOT_BLOCKING).GetResult());
+    multicast.Execute(mtsDouble(4.0), MTS_NOT_BLOCKING);
+    for (index = 0; index < numberOfObservers; ++index) {
+        while (mailBoxes[index]->ExecuteNext()) {}
+    }
+    while (latestMailBox.ExecuteNext()) {}
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(4), recorders[0].Values.size());
+    CPPUNIT_ASSERT_EQUAL(1.0, recorders[0].Values[0]);
+    CPPUNIT_ASSERT_EQUAL(2.0, recorders[0].Values[1]);
+    CPPUNIT_ASSERT_EQUAL(3.0, recorders[0].Values[2]);
+    CPPUNIT_ASSERT_EQUAL(4.0, recorders[0].Values[3]);
+    for (index = 1; index < numberOfObservers; ++index) {
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), recorders[index].Values.size());
+        CPPUNIT_ASSERT_EQUAL(4.0, recorders[index].Values.back());
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), recorders[numberOfObservers].Values.size());
+    CPPUNIT_ASSERT_EQUAL(4.0, recorders[numberOfObservers].Values.back());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), recorders[numberOfObservers + 1].Values.size());
+
+    // all processed, shared arguments are recycled
+    for (index = 0; index < 10 * size; ++index) {
+        multicast.Execute(mtsDouble(static_cast<double>(index)), MTS_NOT_BLOCKING);
+        for (size_t observer = 0; observer < numberOfObservers; ++observer) {
+            CPPUNIT_ASSERT(mailBoxes[observer]->ExecuteNext());
+        }
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), multicast.GetNumberOfSharedArguments());
+    CPPUNIT_ASSERT_EQUAL(static_cast<double>(10 * size - 1), recorders[numberOfObservers - 1].Values.back());
+
+    // full queues, events are dropped and references released
+    for (index = 0; index < 2 * size; ++index) {
+        multicast.Execute(mtsDouble(static_cast<double>(index)), MTS_NOT_BLOCKING);
+    }
+    CPPUNIT_ASSERT(multicast.GetNumberOfSharedArguments() <= 2 * size);
+
+    // queued commands release their references when deleted
+    for (index = 0; index < commands.size(); ++index) {
+        delete commands[index];
+    }
+    for (index = 0; index < mailBoxes.size(); ++index) {
+        delete mailBoxes[index];
+    }
+}
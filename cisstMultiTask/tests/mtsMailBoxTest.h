@@ -0,0 +1,81 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights
+  Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cisstMultiTask/mtsMailBox.h>
+#include <cisstMultiTask/mtsMailBoxReadyList.h>
+
+
+class mtsMailBoxTest: public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(mtsMailBoxTest);
+
+    CPPUNIT_TEST(TestReadyList);
+    CPPUNIT_TEST(TestReadyListRemove);
+    CPPUNIT_TEST(TestReadyListRemoveFromCommand);
+    CPPUNIT_TEST(TestReadyListFull);
+    CPPUNIT_TEST(TestTracerQueueFull);
+    CPPUNIT_TEST(TestTracerThreadBuffers);
+    CPPUNIT_TEST(TestQueuedWriteLatest);
+    CPPUNIT_TEST(TestQueuedWriteLatestThreads);
+    CPPUNIT_TEST(TestMulticastSharedArgument);
+
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp(void) {}
+
+    void tearDown(void) {}
+
+    /*! Test that only scheduled mailboxes are processed, in order,
+      and that the doorbell is only used when the list was empty. */
+    void TestReadyList(void);
+
+    /*! Test removal of a scheduled mailbox */
+    void TestReadyListRemove(void);
+
+    /*! Test removal of a pending mailbox by a command executed by
+      the ready list */
+    void TestReadyListRemoveFromCommand(void);
+
+    /*! Test that a mailbox is not scheduled if its queue is full */
+    void TestReadyListFull(void);
+
+    /*! Test that the tracer doesn't count commands rejected by a full
+      mailbox as queued */
+    void TestTracerQueueFull(void);
+
+    /*! Test that the tracer reuses the buffers of threads that ended */
+    void TestTracerThreadBuffers(void);
+
+    /*! Test that queued write commands with latest only policy keep
+      only the most recent argument and use one mailbox entry */
+    void TestQueuedWriteLatest(void);
+
+    /*! Test with a fast writer thread and a slow reader */
+    void TestQueuedWriteLatestThreads(void);
+
+    /*! Test that multicast commands share one copy of the argument
+      between queued observers and recycle it once processed */
+    void TestMulticastSharedArgument(void);
+};
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(mtsMailBoxTest);
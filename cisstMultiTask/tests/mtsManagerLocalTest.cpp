@@ -6,7 +6,7 @@
   Author(s):  Min Yang Jung, Anton Deguet
   Created on: 2009-11-17
 
-  (C) Copyright 2009-2019 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -22,9 +22,13 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstMultiTask/mtsManagerGlobal.h>
 #include <cisstMultiTask/mtsManagerLocal.h>
 #include <cisstMultiTask/mtsStateTable.h>
+#include <cisstOSAbstraction/osaGetTime.h>
 
 #include "mtsTestComponents.h"
 
+#include <algorithm>
+#include <sstream>
+
 #define P1 "P1"
 #define P2 "P2"
 #define P1_OBJ localManager1
@@ -427,6 +431,96 @@ void mtsManagerLocalTest::TestConnectLocally(void)
     CPPUNIT_ASSERT_EQUAL(clientPtr->GetName(), mtsInterfaceProvided::GenerateEndUserInterfaceName(serverPtr, "r1"));
 }
 
+void mtsManagerLocalTest::TestStartupOrder(void)
+{
+    mtsManagerLocal * localManager = mtsManagerLocal::GetInstance();
+    localManager->RemoveAllUserComponents();  // Clean up from previous tests
+
+    // names are sorted so clients come first in the component map
+    mtsTestDevice2<mtsInt> * device1 = new mtsTestDevice2<mtsInt>("StartupOrder1");
+    mtsTestDevice2<mtsInt> * device2 = new mtsTestDevice2<mtsInt>("StartupOrder2");
+    mtsTestDevice2<mtsInt> * device3 = new mtsTestDevice2<mtsInt>("StartupOrder3");
+    CPPUNIT_ASSERT(localManager->AddComponent(device1));
+    CPPUNIT_ASSERT(localManager->AddComponent(device2));
+    CPPUNIT_ASSERT(localManager->AddComponent(device3));
+
+    // 1 uses 2 which uses 3
+    CPPUNIT_ASSERT(localManager->Connect(device1->GetName(), "r1", device2->GetName(), "p1"));
+    CPPUNIT_ASSERT(localManager->Connect(device2->GetName(), "r1", device3->GetName(), "p1"));
+
+    std::vector<mtsComponent *> components;
+    localManager->GetComponentsInStartupOrder(components);
+    CPPUNIT_ASSERT_EQUAL(localManager->ComponentMap.size(), components.size());
+    const std::vector<mtsComponent *>::const_iterator begin = components.begin();
+    const std::vector<mtsComponent *>::const_iterator end = components.end();
+    const std::vector<mtsComponent *>::const_iterator position1 = std::find(begin, end, device1);
+    const std::vector<mtsComponent *>::const_iterator position2 = std::find(begin, end, device2);
+    const std::vector<mtsComponent *>::const_iterator position3 = std::find(begin, end, device3);
+    CPPUNIT_ASSERT(position3 < position2);
+    CPPUNIT_ASSERT(position2 < position1);
+    CPPUNIT_ASSERT(position1 != end);
+
+    // circular dependency, all components are still in the list
+    CPPUNIT_ASSERT(localManager->Connect(device3->GetName(), "r1", device1->GetName(), "p1"));
+    localManager->GetComponentsInStartupOrder(components);
+    CPPUNIT_ASSERT_EQUAL(localManager->ComponentMap.size(), components.size());
+    CPPUNIT_ASSERT(std::find(components.begin(), components.end(), device1) != components.end());
+    CPPUNIT_ASSERT(std::find(components.begin(), components.end(), device2) != components.end());
+    CPPUNIT_ASSERT(std::find(components.begin(), components.end(), device3) != components.end());
+}
+
+
+void mtsManagerLocalTest::TestStartupBenchmark(void)
+{
+    mtsManagerLocal * localManager = mtsManagerLocal::GetInstance();
+    localManager->RemoveAllUserComponents();  // Clean up from previous tests
+
+    // chain of components, each one using the next one
+    const size_t numberOfComponents = 500;
+    std::vector<mtsComponent *> devices;
+    double startTime = osaGetTime();
+    for (size_t index = 0; index < numberOfComponents; ++index) {
+        std::stringstream name;
+        name << "StartupBenchmark" << index;
+        devices.push_back(new mtsTestDevice2<mtsInt>(name.str()));
+        CPPUNIT_ASSERT(localManager->AddComponent(devices.back()));
+    }
+    const double addTime = osaGetTime() - startTime;
+
+    startTime = osaGetTime();
+    for (size_t index = 0; index < (numberOfComponents - 1); ++index) {
+        CPPUNIT_ASSERT(localManager->Connect(devices[index]->GetName(), "r1", devices[index + 1]->GetName(), "p1"));
+    }
+    const double connectTime = osaGetTime() - startTime;
+
+    startTime = osaGetTime();
+    std::vector<mtsComponent *> components;
+    localManager->GetComponentsInStartupOrder(components);
+    const double orderTime = osaGetTime() - startTime;
+
+    // last component of the chain has to be started first
+    CPPUNIT_ASSERT_EQUAL(localManager->ComponentMap.size(), components.size());
+    std::vector<size_t> positions(numberOfComponents);
+    for (size_t index = 0; index < components.size(); ++index) {
+        for (size_t device = 0; device < numberOfComponents; ++device) {
+            if (components[index] == devices[device]) {
+                positions[device] = index;
+            }
+        }
+    }
+    for (size_t index = 0; index < (numberOfComponents - 1); ++index) {
+        CPPUNIT_ASSERT(positions[index + 1] < positions[index]);
+    }
+
+    CMN_LOG_INIT_VERBOSE << "TestStartupBenchmark: " << numberOfComponents << " components, add: "
+                         << addTime << "s, connect: " << connectTime << "s, order: " << orderTime << "s" << std::endl;
+
+    // generous bounds for slow or loaded machines
+    CPPUNIT_ASSERT(addTime < 10.0);
+    CPPUNIT_ASSERT(connectTime < 10.0);
+    CPPUNIT_ASSERT(orderTime < 1.0);
+}
+
 #if CISST_MTS_HAS_ICE
 void mtsManagerLocalTest::TestGetIPAddressList(void)
 {
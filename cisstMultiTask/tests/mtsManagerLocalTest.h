@@ -46,6 +46,8 @@ private:
 
         CPPUNIT_TEST(TestConnectLocally);
         CPPUNIT_TEST(TestConnectDisconnect);
+        CPPUNIT_TEST(TestStartupOrder);
+        CPPUNIT_TEST(TestStartupBenchmark);
 
 #if CISST_MTS_HAS_ICE
         CPPUNIT_TEST(TestGetIPAddressList);
@@ -84,6 +86,8 @@ public:
 
     void TestConnectLocally(void);
     void TestConnectDisconnect(void);
+    void TestStartupOrder(void);
+    void TestStartupBenchmark(void);
 
 #if CISST_MTS_HAS_ICE
     void TestGetIPAddressList(void);
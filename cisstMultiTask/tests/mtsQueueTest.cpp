@@ -6,7 +6,7 @@
   Author(s):  Anton Deguet
   Created on: 2009-04-29
 
-  (C) Copyright 2009 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -20,7 +20,15 @@ http://www.cisst.org/cisst/license.txt.
 
 #include "mtsQueueTest.h"
 #include "mtsMacrosTestClasses.h"
+#include <cisstMultiTask/mtsVector.h>
+#include <cisstMultiTask/mtsStateIndex.h>
 #include <cisstVector/vctRandom.h>
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstOSAbstraction/osaStopwatch.h>
+#include <cisstOSAbstraction/osaSleep.h>
+
+#include <vector>
+#include <algorithm>
 
 void mtsQueueTest::TestQueue_mtsDouble(void)
 {
@@ -147,3 +155,280 @@ void mtsQueueTest::TestConstructorDestructorCalls(void)
     CPPUNIT_ASSERT_EQUAL(mtsMacrosTestClassB::CopyConstructorCalls, static_cast<size_t>(0));
     CPPUNIT_ASSERT_EQUAL(mtsMacrosTestClassB::DestructorCalls, 2 * size + 1);
 }
+
+
+void mtsQueueTest::TestPutManyGetMany(void)
+{
+    // mtsQueue uses one slot to detect full queue
+    const size_t size = 11;
+    mtsQueue<int> queue(size, 0);
+    std::vector<int> input(size), output(size);
+    size_t index, iteration, count;
+
+    // batch larger than queue
+    for (index = 0; index < size; index++) {
+        input[index] = static_cast<int>(index);
+    }
+    CPPUNIT_ASSERT_EQUAL(size - 1, queue.PutMany(&(input[0]), size));
+    CPPUNIT_ASSERT(queue.IsFull());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), queue.PutMany(&(input[0]), 1));
+    CPPUNIT_ASSERT_EQUAL(size - 1, queue.GetMany(&(output[0]), size));
+    CPPUNIT_ASSERT(queue.IsEmpty());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), queue.GetMany(&(output[0]), 1));
+    for (index = 0; index < size - 1; index++) {
+        CPPUNIT_ASSERT_EQUAL(input[index], output[index]);
+    }
+
+    // odd sized batches to force wrap around within a batch
+    int next = 0, expected = 0;
+    for (iteration = 0; iteration < 10 * size; iteration++) {
+        count = (iteration % 4) + 1;
+        for (index = 0; index < count; index++) {
+            input[index] = next + static_cast<int>(index);
+        }
+        CPPUNIT_ASSERT_EQUAL(count, queue.PutMany(&(input[0]), count));
+        next += static_cast<int>(count);
+        CPPUNIT_ASSERT_EQUAL(count, queue.GetAvailable());
+        // mix single element and batch reads
+        if (iteration % 2) {
+            CPPUNIT_ASSERT_EQUAL(count, queue.GetMany(&(output[0]), size));
+            for (index = 0; index < count; index++) {
+                CPPUNIT_ASSERT_EQUAL(expected, output[index]);
+                expected++;
+            }
+        } else {
+            for (index = 0; index < count; index++) {
+                int * element = queue.Get();
+                CPPUNIT_ASSERT(element);
+                CPPUNIT_ASSERT_EQUAL(expected, *element);
+                expected++;
+            }
+        }
+        CPPUNIT_ASSERT(queue.IsEmpty());
+    }
+}
+
+
+void mtsQueueTest::TestGenericPutManyGetMany(void)
+{
+    const size_t size = 10;
+    mtsQueueGeneric queue(size, mtsDouble(0.0));
+    std::vector<mtsDouble> elements(size + 1);
+    std::vector<const mtsGenericObject *> input(size + 1);
+    std::vector<mtsGenericObject *> output(size + 1);
+    size_t index, iteration;
+    for (index = 0; index < size + 1; index++) {
+        elements[index] = static_cast<double>(index);
+        input[index] = &(elements[index]);
+    }
+
+    // batch larger than queue
+    CPPUNIT_ASSERT_EQUAL(size, queue.PutMany(&(input[0]), size + 1));
+    CPPUNIT_ASSERT(queue.IsFull());
+    CPPUNIT_ASSERT_EQUAL(size, queue.GetMany(&(output[0]), size + 1));
+    CPPUNIT_ASSERT(queue.IsEmpty());
+    for (index = 0; index < size; index++) {
+        mtsDouble * retrieved = dynamic_cast<mtsDouble *>(output[index]);
+        CPPUNIT_ASSERT(retrieved);
+        CPPUNIT_ASSERT_EQUAL(static_cast<double>(index), retrieved->Data);
+    }
+
+    // small batches to test wrap around
+    for (iteration = 0; iteration < 3 * size; iteration++) {
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), queue.PutMany(&(input[iteration % 4]), 3));
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), queue.GetMany(&(output[0]), 3));
+        for (index = 0; index < 3; index++) {
+            mtsDouble * retrieved = dynamic_cast<mtsDouble *>(output[index]);
+            CPPUNIT_ASSERT(retrieved);
+            CPPUNIT_ASSERT_EQUAL(static_cast<double>(iteration % 4 + index), retrieved->Data);
+        }
+    }
+}
+
+
+void mtsQueueTest::TestGenericPutSwap(void)
+{
+    const size_t size = 4;
+    const size_t length = 1000;
+    mtsQueueGeneric queue(size, mtsDoubleVec());
+    mtsDoubleVec vector;
+    std::vector<const double *> sent;
+    size_t index, allocations = 0;
+    for (index = 0; index < 5 * size; index++) {
+        if (vector.size() != length) {
+            vector.SetSize(length);
+            allocations++;
+        }
+        vector.SetAll(static_cast<double>(index));
+        vector.SetTimestamp(static_cast<double>(index));
+        const double * pointer = vector.Pointer();
+        const mtsDoubleVec * queued = dynamic_cast<const mtsDoubleVec *>(queue.PutSwap(vector));
+        CPPUNIT_ASSERT(queued);
+        // memory is handed off, not copied
+        CPPUNIT_ASSERT(queued->Pointer() == pointer);
+        CPPUNIT_ASSERT(vector.Pointer() != pointer);
+        mtsDoubleVec * retrieved = dynamic_cast<mtsDoubleVec *>(queue.Get());
+        CPPUNIT_ASSERT(retrieved == queued);
+        CPPUNIT_ASSERT_EQUAL(length, retrieved->size());
+        CPPUNIT_ASSERT_EQUAL(static_cast<double>(index), retrieved->Element(length - 1));
+        CPPUNIT_ASSERT_EQUAL(static_cast<double>(index), retrieved->Timestamp());
+        sent.push_back(pointer);
+    }
+    // buffers are allocated until all slots (size + 1) have been used once
+    CPPUNIT_ASSERT(allocations <= size + 2);
+    CPPUNIT_ASSERT(std::find(sent.begin(), sent.end(), vector.Pointer()) != sent.end());
+
+    // queue full
+    for (index = 0; index < size; index++) {
+        CPPUNIT_ASSERT(queue.PutSwap(vector));
+    }
+    CPPUNIT_ASSERT(!queue.PutSwap(vector));
+
+    // types without swap are copied
+    mtsQueueGeneric indexQueue(size, mtsStateIndex());
+    mtsStateIndex stateIndex(1.0, 3, 7, 16);
+    const mtsStateIndex * queuedIndex = dynamic_cast<const mtsStateIndex *>(indexQueue.PutSwap(stateIndex));
+    CPPUNIT_ASSERT(queuedIndex);
+    CPPUNIT_ASSERT_EQUAL(3, queuedIndex->Index());
+    CPPUNIT_ASSERT_EQUAL(3, stateIndex.Index());
+}
+
+
+// helper classes for multi-threaded tests
+class mtsQueueTestProducer
+{
+public:
+    mtsQueue<size_t> * Queue;
+    size_t NumberOfElements;
+    size_t BatchSize;
+    size_t Retries;
+
+    void * Run(int CMN_UNUSED(dummy)) {
+        std::vector<size_t> batch(BatchSize);
+        size_t next = 0;
+        size_t index, count;
+        Retries = 0;
+        while (next < NumberOfElements) {
+            if (BatchSize == 1) {
+                if (Queue->Put(next)) {
+                    next++;
+                } else {
+                    Retries++;
+                    osaSleep(1.0 * cmn_us); // yield to consumer
+                }
+            } else {
+                count = NumberOfElements - next;
+                if (count > BatchSize) {
+                    count = BatchSize;
+                }
+                for (index = 0; index < count; index++) {
+                    batch[index] = next + index;
+                }
+                count = Queue->PutMany(&(batch[0]), count);
+                if (count == 0) {
+                    Retries++;
+                    osaSleep(1.0 * cmn_us); // yield to consumer
+                }
+                next += count;
+            }
+        }
+        return 0;
+    }
+};
+
+
+class mtsQueueTestConsumer
+{
+public:
+    mtsQueue<size_t> * Queue;
+    size_t NumberOfElements;
+    size_t BatchSize;
+    size_t Errors;
+
+    void * Run(int CMN_UNUSED(dummy)) {
+        std::vector<size_t> batch(BatchSize);
+        size_t expected = 0;
+        size_t index, count;
+        size_t * element;
+        Errors = 0;
+        while (expected < NumberOfElements) {
+            if (BatchSize == 1) {
+                element = Queue->Peek();
+                if (element) {
+                    if (*element != expected) {
+                        Errors++;
+                    }
+                    Queue->Get();
+                    expected++;
+                } else {
+                    osaSleep(1.0 * cmn_us); // yield to producer
+                }
+            } else {
+                count = Queue->GetMany(&(batch[0]), BatchSize);
+                if (count == 0) {
+                    osaSleep(1.0 * cmn_us); // yield to producer
+                }
+                for (index = 0; index < count; index++) {
+                    if (batch[index] != expected) {
+                        Errors++;
+                    }
+                    expected++;
+                }
+            }
+        }
+        return 0;
+    }
+};
+
+
+static double mtsQueueTestRun(size_t queueSize, size_t numberOfElements, size_t batchSize, size_t & errors)
+{
+    mtsQueue<size_t> queue(queueSize, 0);
+    mtsQueueTestProducer producer;
+    producer.Queue = &queue;
+    producer.NumberOfElements = numberOfElements;
+    producer.BatchSize = batchSize;
+    mtsQueueTestConsumer consumer;
+    consumer.Queue = &queue;
+    consumer.NumberOfElements = numberOfElements;
+    consumer.BatchSize = batchSize;
+
+    osaStopwatch timer;
+    timer.Reset();
+    timer.Start();
+    osaThread producerThread, consumerThread;
+    consumerThread.Create<mtsQueueTestConsumer, int>(&consumer, &mtsQueueTestConsumer::Run, 0, "consumer");
+    producerThread.Create<mtsQueueTestProducer, int>(&producer, &mtsQueueTestProducer::Run, 0, "producer");
+    producerThread.Wait();
+    consumerThread.Wait();
+    timer.Stop();
+    errors = consumer.Errors;
+    return timer.GetElapsedTime();
+}
+
+
+void mtsQueueTest::TestSingleProducerSingleConsumer(void)
+{
+    size_t errors;
+    // small queue to force many full/empty transitions
+    mtsQueueTestRun(7, 200000, 1, errors);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), errors);
+    mtsQueueTestRun(7, 200000, 3, errors);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), errors);
+    mtsQueueTestRun(64, 200000, 16, errors);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), errors);
+}
+
+
+void mtsQueueTest::TestThroughput(void)
+{
+    const size_t numberOfElements = 1000000;
+    size_t errors;
+    double single = mtsQueueTestRun(256, numberOfElements, 1, errors);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), errors);
+    double batch = mtsQueueTestRun(256, numberOfElements, 32, errors);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), errors);
+    CMN_LOG_INIT_VERBOSE << "mtsQueueTest::TestThroughput: "
+                         << numberOfElements / single << " elements/s (Put/Get), "
+                         << numberOfElements / batch << " elements/s (PutMany/GetMany)" << std::endl;
+}
@@ -31,6 +31,11 @@ class mtsQueueTest: public CppUnit::TestFixture
 
     CPPUNIT_TEST(TestQueue_mtsDouble);
     CPPUNIT_TEST(TestConstructorDestructorCalls);
+    CPPUNIT_TEST(TestPutManyGetMany);
+    CPPUNIT_TEST(TestGenericPutManyGetMany);
+    CPPUNIT_TEST(TestGenericPutSwap);
+    CPPUNIT_TEST(TestSingleProducerSingleConsumer);
+    CPPUNIT_TEST(TestThroughput);
 
     CPPUNIT_TEST_SUITE_END();
     
@@ -44,6 +49,22 @@ public:
 
     /*! Tests calls to constructors and detructors */
     void TestConstructorDestructorCalls(void);
+
+    /*! Tests batch operations, including wrap around */
+    void TestPutManyGetMany(void);
+
+    /*! Tests batch operations for generic queue */
+    void TestGenericPutManyGetMany(void);
+
+    /*! Tests handoff of objects to generic queue */
+    void TestGenericPutSwap(void);
+
+    /*! Stress test with one writer thread and one reader thread */
+    void TestSingleProducerSingleConsumer(void);
+
+    /*! Measure throughput with one writer thread and one reader
+      thread, single element and batch operations */
+    void TestThroughput(void);
 };
 
 
@@ -6,7 +6,7 @@
   Author(s):  Peter Kazanzides
   Created on: 2013-09-23
   
-  (C) Copyright 2013 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2013-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -19,6 +19,15 @@ http://www.cisst.org/cisst/license.txt.
 
 #include "mtsSocketProxyTest.h"
 #include <cisstMultiTask/mtsSocketProxyCommon.h>
+#include <cisstMultiTask/mtsSocketProxyClient.h>
+#include <cisstMultiTask/mtsSocketProxyServer.h>
+#include <cisstMultiTask/mtsGenericObjectProxy.h>
+#include <cisstMultiTask/mtsManagerLocal.h>
+#include <cisstCommon/cmnSerializer.h>
+#include <cisstCommon/cmnDeSerializer.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+
+#include "mtsTestComponents.h"
 
 void mtsSocketProxyTest::TestCommandHandle(void)
 {
@@ -47,3 +56,208 @@ void mtsSocketProxyTest::TestCommandHandle(void)
     CPPUNIT_ASSERT(handle == testHandle);
 }
 
+void mtsSocketProxyTest::TestInitData(void)
+{
+    mtsSocketProxyInitData init;
+    CPPUNIT_ASSERT(init.InterfaceVersion() == mtsSocketProxy::SOCKET_PROXY_VERSION);
+    CPPUNIT_ASSERT(std::string(init.SharedMemoryName()).empty());
+    init.SetSharedMemoryName("/cisstSocketProxy1234");
+
+    // Shared memory name is sent to the client
+    std::stringstream stream;
+    cmnSerializer serializer(stream);
+    serializer.Serialize(init);
+    mtsSocketProxyInitData received;
+    cmnDeSerializer deserializer(stream);
+    deserializer.DeSerialize(received);
+    CPPUNIT_ASSERT(received.InterfaceVersion() == mtsSocketProxy::SOCKET_PROXY_VERSION);
+    CPPUNIT_ASSERT(received.PacketSize() == mtsSocketProxy::SOCKET_PROXY_PACKET_SIZE);
+    CPPUNIT_ASSERT_EQUAL(std::string("/cisstSocketProxy1234"), std::string(received.SharedMemoryName()));
+    // Compact events not available unless the server provides the handle
+    CPPUNIT_ASSERT(received.EventEnableCompact()[0] == 0);
+
+    // Names too long are truncated
+    init.SetSharedMemoryName(std::string(100, 'x'));
+    CPPUNIT_ASSERT(std::string(init.SharedMemoryName()).size() < 100);
+}
+
+void mtsSocketProxyTest::TestCompactEventHeader(void)
+{
+    CompactEventHeader header(12, 65535, 24);
+    char buffer[CompactEventHeader::COMPACT_EVENT_HEADER_SIZE];
+    CPPUNIT_ASSERT_EQUAL(static_cast<int>(sizeof(buffer)), header.ToString(buffer));
+    CompactEventHeader received;
+    CPPUNIT_ASSERT_EQUAL(static_cast<int>(sizeof(buffer)), received.FromString(buffer, sizeof(buffer)));
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(12), received.eventId);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(65535), received.sequence);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned int>(24), received.length);
+
+    // Buffer too small, e.g. padding at the end of a message
+    CPPUNIT_ASSERT_EQUAL(0, received.FromString(buffer, sizeof(buffer) - 1));
+
+    // Message with two events, the second one without argument (void event)
+    std::string message(1, mtsSocketProxy::SOCKET_PROXY_COMPACT_EVENTS);
+    mtsDouble argument(3.5);
+    std::stringstream argumentStream;
+    argument.SerializeRaw(argumentStream);
+    std::string argumentString = argumentStream.str();
+    CompactEventHeader(1, 7, static_cast<unsigned int>(argumentString.size())).ToString(buffer);
+    message.append(buffer, sizeof(buffer));
+    message.append(argumentString);
+    CompactEventHeader(2, 8, 0).ToString(buffer);
+    message.append(buffer, sizeof(buffer));
+    message.append(" ");
+
+    size_t pos = 1;
+    CPPUNIT_ASSERT(received.FromString(message.data() + pos, message.size() - pos) != 0);
+    pos += CompactEventHeader::COMPACT_EVENT_HEADER_SIZE;
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(1), received.eventId);
+    CPPUNIT_ASSERT_EQUAL(argumentString.size(), static_cast<size_t>(received.length));
+    mtsDouble receivedArgument;
+    std::stringstream receivedStream(message.substr(pos, received.length));
+    receivedArgument.DeSerializeRaw(receivedStream);
+    CPPUNIT_ASSERT_EQUAL(3.5, receivedArgument.Data);
+    pos += received.length;
+    CPPUNIT_ASSERT(received.FromString(message.data() + pos, message.size() - pos) != 0);
+    pos += CompactEventHeader::COMPACT_EVENT_HEADER_SIZE;
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(2), received.eventId);
+    CPPUNIT_ASSERT_EQUAL(static_cast<unsigned short>(8), received.sequence);
+    CPPUNIT_ASSERT_EQUAL(0u, received.length);
+    CPPUNIT_ASSERT_EQUAL(0, received.FromString(message.data() + pos, message.size() - pos));
+}
+
+// server proxy giving access to the clients it knows
+class mtsSocketProxyTestServerProxy: public mtsSocketProxyServer
+{
+public:
+    mtsSocketProxyTestServerProxy(const std::string & name, const std::string & componentName,
+                                  const std::string & providedInterfaceName, unsigned short port):
+        mtsSocketProxyServer(name, componentName, providedInterfaceName, port)
+    {}
+
+    size_t GetNumberOfClients(void) const {
+        return ClientMap.size();
+    }
+};
+
+void mtsSocketProxyTest::TestSharedMemoryCommandsAndEvents(void)
+{
+    if (!osaSharedMemoryRing::IsSupported()) {
+        return;
+    }
+    const unsigned short port = 11734;
+    const double eventDelay = 1.0 * cmn_s;
+
+    mtsManagerLocal * manager = mtsManagerLocal::GetInstance();
+    manager->RemoveAllUserComponents();
+
+    // proxies query their server when constructed, start the server side first
+    mtsTestPeriodic1<mtsInt> * server = new mtsTestPeriodic1<mtsInt>("mtsSocketProxyTestServer");
+    CPPUNIT_ASSERT(manager->AddComponent(server));
+    mtsSocketProxyTestServerProxy * serverProxy = new mtsSocketProxyTestServerProxy("mtsSocketProxyTestServerProxy",
+                                                                                    server->GetName(), "p1", port);
+    CPPUNIT_ASSERT(manager->AddComponent(serverProxy));
+    CPPUNIT_ASSERT(manager->Connect(serverProxy->GetName(), "Required", server->GetName(), "p1"));
+    manager->CreateAll();
+    CPPUNIT_ASSERT(manager->WaitForStateAll(mtsComponentState::READY, StateTransitionMaximumDelay));
+    manager->StartAll();
+    CPPUNIT_ASSERT(manager->WaitForStateAll(mtsComponentState::ACTIVE, StateTransitionMaximumDelay));
+
+    mtsSocketProxyClient * clientProxy = new mtsSocketProxyClient("mtsSocketProxyTestClientProxy", "127.0.0.1", port);
+    CPPUNIT_ASSERT(clientProxy->IsUsingSharedMemory());
+    mtsTestDevice1<mtsInt> * client = new mtsTestDevice1<mtsInt>("mtsSocketProxyTestClient");
+    CPPUNIT_ASSERT(manager->AddComponent(clientProxy));
+    CPPUNIT_ASSERT(manager->AddComponent(client));
+    CPPUNIT_ASSERT(manager->Connect(client->GetName(), "r1", clientProxy->GetName(), "Provided"));
+    // server side is already active
+    CPPUNIT_ASSERT(clientProxy->CreateAndWait(StateTransitionMaximumDelay));
+    CPPUNIT_ASSERT(client->CreateAndWait(StateTransitionMaximumDelay));
+    CPPUNIT_ASSERT(clientProxy->StartAndWait(StateTransitionMaximumDelay));
+    CPPUNIT_ASSERT(client->StartAndWait(StateTransitionMaximumDelay));
+
+    mtsTestInterfaceRequired<mtsInt> & required = client->InterfaceRequired1;
+    mtsExecutionResult executionResult;
+    mtsInt valueWrite, valueRead;
+
+    // once the manager components are active, connections are established asynchronously
+    double startTime = osaGetTime();
+    while (!required.FunctionWrite.IsValid() && (osaGetTime() - startTime < StateTransitionMaximumDelay)) {
+        osaSleep(1.0 * cmn_ms);
+    }
+    CPPUNIT_ASSERT(required.FunctionWrite.IsValid());
+
+    // commands
+    valueWrite = 12;
+    required.FunctionWrite.ExecuteBlocking(valueWrite);
+    CPPUNIT_ASSERT_EQUAL(12, server->InterfaceProvided1.GetValue());
+    executionResult = required.FunctionRead(valueRead);
+    CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_SUCCEEDED, executionResult.GetResult());
+    CPPUNIT_ASSERT(valueRead == 12);
+    executionResult = required.FunctionQualifiedRead(valueWrite, valueRead);
+    CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_SUCCEEDED, executionResult.GetResult());
+    CPPUNIT_ASSERT(valueRead == 13);
+    executionResult = required.FunctionVoidReturn(valueRead);
+    CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_SUCCEEDED, executionResult.GetResult());
+    CPPUNIT_ASSERT(valueRead == 1);
+    CPPUNIT_ASSERT_EQUAL(-12, server->InterfaceProvided1.GetValue());
+    valueWrite = 7;
+    executionResult = required.FunctionWriteReturn(valueWrite, valueRead);
+    CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_SUCCEEDED, executionResult.GetResult());
+    CPPUNIT_ASSERT(valueRead == -1);
+    CPPUNIT_ASSERT_EQUAL(7, server->InterfaceProvided1.GetValue());
+    required.FunctionVoid.ExecuteBlocking();
+    CPPUNIT_ASSERT_EQUAL(0, server->InterfaceProvided1.GetValue());
+    // non blocking command
+    valueWrite = 5;
+    CPPUNIT_ASSERT(required.FunctionWrite(valueWrite).IsOK());
+    startTime = osaGetTime();
+    while ((server->InterfaceProvided1.GetValue() != 5) && (osaGetTime() - startTime < eventDelay)) {
+        osaSleep(1.0 * cmn_ms);
+    }
+    CPPUNIT_ASSERT_EQUAL(5, server->InterfaceProvided1.GetValue());
+
+    // events
+    valueWrite = 21;
+    server->InterfaceProvided1.EventWrite(valueWrite);
+    startTime = osaGetTime();
+    while ((required.GetValue() != 21) && (osaGetTime() - startTime < eventDelay)) {
+        osaSleep(1.0 * cmn_ms);
+    }
+    CPPUNIT_ASSERT_EQUAL(21, required.GetValue());
+    server->InterfaceProvided1.EventVoid();
+    startTime = osaGetTime();
+    while ((required.GetValue() != 0) && (osaGetTime() - startTime < eventDelay)) {
+        osaSleep(1.0 * cmn_ms);
+    }
+    CPPUNIT_ASSERT_EQUAL(0, required.GetValue());
+    CPPUNIT_ASSERT(clientProxy->IsUsingSharedMemory());
+
+    // client proxy detaches when it stops, server proxy forgets it
+    const size_t numberOfClients = serverProxy->GetNumberOfClients();
+    CPPUNIT_ASSERT(numberOfClients > 0);
+    CPPUNIT_ASSERT(client->KillAndWait(StateTransitionMaximumDelay));
+    CPPUNIT_ASSERT(clientProxy->KillAndWait(StateTransitionMaximumDelay));
+    startTime = osaGetTime();
+    while ((serverProxy->GetNumberOfClients() != (numberOfClients - 1)) && (osaGetTime() - startTime < eventDelay)) {
+        osaSleep(1.0 * cmn_ms);
+    }
+    CPPUNIT_ASSERT_EQUAL(numberOfClients - 1, serverProxy->GetNumberOfClients());
+    // events are not sent to the detached client anymore
+    server->InterfaceProvided1.EventVoid();
+    server->InterfaceProvided1.EventWrite(valueWrite);
+    osaSleep(0.1 * cmn_s);
+
+    // stop all and cleanup
+    manager->KillAll();
+    CPPUNIT_ASSERT(manager->WaitForStateAll(mtsComponentState::FINISHED, StateTransitionMaximumDelay));
+    CPPUNIT_ASSERT(manager->Disconnect(client->GetName(), "r1", clientProxy->GetName(), "Provided"));
+    CPPUNIT_ASSERT(manager->Disconnect(serverProxy->GetName(), "Required", server->GetName(), "p1"));
+    CPPUNIT_ASSERT(manager->RemoveComponent(client));
+    CPPUNIT_ASSERT(manager->RemoveComponent(clientProxy));
+    CPPUNIT_ASSERT(manager->RemoveComponent(serverProxy));
+    CPPUNIT_ASSERT(manager->RemoveComponent(server));
+    delete client;
+    delete clientProxy;
+    delete serverProxy;
+    delete server;
+}
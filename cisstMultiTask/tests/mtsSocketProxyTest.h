@@ -6,7 +6,7 @@
   Author(s):  Peter Kazanzides
   Created on: 2013-09-23
   
-  (C) Copyright 2013 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2013-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -25,6 +25,9 @@ class mtsSocketProxyTest: public CppUnit::TestFixture
     CPPUNIT_TEST_SUITE(mtsSocketProxyTest);
 
     CPPUNIT_TEST(TestCommandHandle);
+    CPPUNIT_TEST(TestInitData);
+    CPPUNIT_TEST(TestCompactEventHeader);
+    CPPUNIT_TEST(TestSharedMemoryCommandsAndEvents);
 
     CPPUNIT_TEST_SUITE_END();
     
@@ -35,6 +38,14 @@ public:
     
     void TestCommandHandle(void);
 
+    void TestInitData(void);
+
+    void TestCompactEventHeader(void);
+
+    /*! Test commands and events between a client and a server proxy
+      in the same process, i.e. using shared memory */
+    void TestSharedMemoryCommandsAndEvents(void);
+
 };
 
 
@@ -6,7 +6,7 @@
   Author(s):  Min Yang Jung
   Created on: 2009-03-05
 
-  (C) Copyright 2009-2010 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -18,11 +18,19 @@ http://www.cisst.org/cisst/license.txt.
 --- end cisst license ---
 */
 
+#include <cisstVector/vctFixedSizeVectorTypes.h>
+#include <cisstOSAbstraction/osaSleep.h>
+#include <cisstOSAbstraction/osaThread.h>
 #include <cisstMultiTask/mtsStateTable.h>
+#include <cisstMultiTask/mtsStateTableFlightRecorder.h>
+#include <cisstMultiTask/mtsCollectorColumnarReader.h>
 
 #include "mtsStateTableTest.h"
 
+#include <atomic>
+#include <cstdio>
 #include <string>
+#include <vector>
 
 void mtsStateTableTest::setUp(void)
 {
@@ -64,4 +72,303 @@ void mtsStateTableTest::TestGetStateVectorID(void)
     }
 }
 
+
+void mtsStateTableTest::TestGetSnapshot(void)
+{
+    mtsStateTable stateTable(10, "Test");
+    mtsDouble position, velocity;
+    const mtsStateDataId positionId = stateTable.NewElement("Position", &position);
+    const mtsStateDataId velocityId = stateTable.NewElement("Velocity", &velocity);
+
+    std::vector<mtsStateDataId> ids;
+    ids.push_back(positionId);
+    ids.push_back(velocityId);
+    mtsDouble positionRead, velocityRead;
+    std::vector<mtsGenericObject *> data;
+    data.push_back(&positionRead);
+    data.push_back(&velocityRead);
+
+    mtsStateIndex index;
+    for (size_t i = 1; i < 25; ++i) {
+        stateTable.Start();
+        position = static_cast<double>(i);
+        velocity = 2.0 * static_cast<double>(i);
+        stateTable.Advance();
+        CPPUNIT_ASSERT(stateTable.GetLatestSnapshot(ids, data, index));
+        CPPUNIT_ASSERT_EQUAL(static_cast<double>(i), positionRead.Data);
+        CPPUNIT_ASSERT_EQUAL(2.0 * static_cast<double>(i), velocityRead.Data);
+        CPPUNIT_ASSERT(stateTable.GetSnapshot(index, ids, data));
+    }
+
+    // mismatched sizes and invalid ids
+    data.pop_back();
+    CPPUNIT_ASSERT(!stateTable.GetSnapshot(index, ids, data));
+    data.push_back(&velocityRead);
+    ids[1] = 1000;
+    CPPUNIT_ASSERT(!stateTable.GetSnapshot(index, ids, data));
+}
+
+
+void mtsStateTableTest::TestGetSnapshotOverwritten(void)
+{
+    mtsStateTable stateTable(5, "Test");
+    mtsDouble position, velocity;
+    std::vector<mtsStateDataId> ids;
+    ids.push_back(stateTable.NewElement("Position", &position));
+    ids.push_back(stateTable.NewElement("Velocity", &velocity));
+    mtsDouble positionRead, velocityRead;
+    std::vector<mtsGenericObject *> data;
+    data.push_back(&positionRead);
+    data.push_back(&velocityRead);
+
+    position = 1.0;
+    velocity = 2.0;
+    stateTable.Advance();
+    const mtsStateIndex index = stateTable.GetIndexReader();
+    CPPUNIT_ASSERT(stateTable.GetSnapshot(index, ids, data));
+
+    mtsStateTable::Accessor<mtsDouble> * accessor =
+        dynamic_cast<mtsStateTable::Accessor<mtsDouble> *>(stateTable.GetAccessor("Position"));
+    CPPUNIT_ASSERT(accessor);
+    mtsDouble value;
+    CPPUNIT_ASSERT(accessor->Get(index, value));
+    CPPUNIT_ASSERT_EQUAL(1.0, value.Data);
+
+    // simulate writer in the middle of writing the row
+    stateTable.RowSequences[index.Index()]++;
+    CPPUNIT_ASSERT(!stateTable.GetSnapshot(index, ids, data));
+    CPPUNIT_ASSERT(!accessor->Get(index, value));
+    stateTable.RowSequences[index.Index()]++;
+    CPPUNIT_ASSERT(stateTable.GetSnapshot(index, ids, data));
+
+    // row rewritten by writer
+    for (size_t i = 0; i < stateTable.GetHistoryLength(); ++i) {
+        stateTable.Advance();
+    }
+    CPPUNIT_ASSERT(!stateTable.GetSnapshot(index, ids, data));
+    CPPUNIT_ASSERT(!accessor->Get(index, value));
+    CPPUNIT_ASSERT(accessor->GetLatest(value));
+}
+
+
+void mtsStateTableTest::TestStateArrayPOD(void)
+{
+    // type selection
+    CPPUNIT_ASSERT(mtsStateArrayTraits<mtsDouble>::IsPOD);
+    CPPUNIT_ASSERT(mtsStateArrayTraits<mtsGenericObjectProxy<vctDouble3> >::IsPOD);
+    CPPUNIT_ASSERT(!mtsStateArrayTraits<mtsStdString>::IsPOD);
+    CPPUNIT_ASSERT(!mtsStateArrayTraits<mtsIntervalStatistics>::IsPOD);
+
+    mtsStateTable stateTable(5, "Test");
+    vctDouble3 position;
+    const mtsStateDataId positionId = stateTable.NewElement("Position", &position);
+    mtsStateArrayPOD<vctDouble3> * history =
+        dynamic_cast<mtsStateArrayPOD<vctDouble3> *>(stateTable.StateVector[positionId]);
+    CPPUNIT_ASSERT(history);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0),
+                         reinterpret_cast<size_t>(&(history->Payload(0))) % mtsStateArrayPOD<vctDouble3>::CACHE_LINE_SIZE);
+    // payloads are contiguous
+    CPPUNIT_ASSERT_EQUAL(sizeof(vctDouble3),
+                         static_cast<size_t>(reinterpret_cast<const char *>(&(history->Payload(1)))
+                                             - reinterpret_cast<const char *>(&(history->Payload(0)))));
+    CPPUNIT_ASSERT_EQUAL(stateTable.GetHistoryLength(), history->size());
+
+    for (size_t i = 1; i < 8; ++i) {
+        stateTable.Start();
+        position.SetAll(static_cast<double>(i));
+        stateTable.Advance();
+    }
+    const mtsStateIndex index = stateTable.GetIndexReader();
+
+    // read using proxy, proxy ref and typed accessor
+    mtsGenericObjectProxy<vctDouble3> proxy;
+    CPPUNIT_ASSERT(history->Get(index.Index(), proxy));
+    CPPUNIT_ASSERT(proxy.Data.Equal(position));
+    CPPUNIT_ASSERT(proxy.Valid());
+    CPPUNIT_ASSERT_EQUAL(stateTable.Tic.Data, proxy.Timestamp());
+
+    vctDouble3 raw(0.0);
+    mtsGenericObjectProxyRef<vctDouble3> proxyRef(raw);
+    CPPUNIT_ASSERT(history->Get(index.Index(), proxyRef));
+    CPPUNIT_ASSERT(raw.Equal(position));
+
+    mtsStateTable::Accessor<vctDouble3> * accessor =
+        dynamic_cast<mtsStateTable::Accessor<vctDouble3> *>(stateTable.GetAccessor("Position"));
+    CPPUNIT_ASSERT(accessor);
+    proxy.Data.SetAll(0.0);
+    CPPUNIT_ASSERT(accessor->Get(index, proxy));
+    CPPUNIT_ASSERT(proxy.Data.Equal(position));
+    proxy.Data.SetAll(0.0);
+    CPPUNIT_ASSERT(accessor->Get(index, static_cast<mtsGenericObject &>(proxy)));
+    CPPUNIT_ASSERT(proxy.Data.Equal(position));
+    CPPUNIT_ASSERT(history->Element(index.Index()).Data.Equal(position));
+    CPPUNIT_ASSERT(history->Payload(index.Index()).Equal(position));
+    // pointer and subscript operator use the same view for a given row
+    const mtsGenericObjectProxy<vctDouble3> * pointer = accessor->GetPointer(index);
+    CPPUNIT_ASSERT(pointer);
+    CPPUNIT_ASSERT(pointer->Data.Equal(position));
+    CPPUNIT_ASSERT(pointer->Valid());
+    CPPUNIT_ASSERT_EQUAL(stateTable.Tic.Data, pointer->Timestamp());
+    CPPUNIT_ASSERT(accessor->GetPointer(index) == pointer);
+    const mtsStateArrayBase & constBase = *history;
+    CPPUNIT_ASSERT(&(constBase[index.Index()]) == pointer);
+    CPPUNIT_ASSERT(history->ElementPointer((index.Index() + 1) % history->size()) != pointer);
+
+    // element access through base class uses a buffer provided by caller
+    const mtsStateArrayBase * base = history;
+    mtsGenericObject * buffer = base->CreateElement();
+    CPPUNIT_ASSERT(buffer);
+    CPPUNIT_ASSERT(buffer->Services() == mtsGenericObjectProxy<vctDouble3>::ClassServices());
+    const mtsGenericObject & element = base->Element(index.Index(), *buffer);
+    CPPUNIT_ASSERT(&element == buffer);
+    CPPUNIT_ASSERT(dynamic_cast<mtsGenericObjectProxy<vctDouble3> *>(buffer)->Data.Equal(position));
+    delete buffer;
+
+    // wrong type
+    mtsDouble wrongType;
+    CPPUNIT_ASSERT(!history->Get(index.Index(), wrongType));
+    CPPUNIT_ASSERT(!history->Set(index.Index(), wrongType));
+    CPPUNIT_ASSERT(!accessor->Get(index, static_cast<mtsGenericObject &>(wrongType)));
+
+    // copy and resize keep existing rows
+    history->Copy(0, index.Index());
+    CPPUNIT_ASSERT(history->Element(0).Data.Equal(position));
+    CPPUNIT_ASSERT(history->SetSize(10));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(10), history->size());
+    CPPUNIT_ASSERT(history->Element(index.Index()).Data.Equal(position));
+    CPPUNIT_ASSERT(history->Element(9).Data.Equal(history->Element(0).Data));
+}
+
+
+
+void mtsStateTableTest::TestFlightRecorder(void)
+{
+    const double period = 1.0 * cmn_ms;
+    const double preTrigger = 50.0 * cmn_ms;
+    const double postTrigger = 20.0 * cmn_ms;
+    mtsStateTable stateTable(10, "Test");
+    mtsDouble counter;
+    stateTable.NewElement("Counter", &counter);
+    CPPUNIT_ASSERT(stateTable.FlightRecorderEnable(preTrigger, postTrigger, period, "mtsStateTableTestFlightRecorder"));
+    CPPUNIT_ASSERT(stateTable.HistoryLength > 70);
+    mtsStateTableFlightRecorder * recorder = stateTable.GetFlightRecorder();
+    CPPUNIT_ASSERT(recorder);
+
+    // fill the table well past the pre-trigger window
+    size_t row;
+    for (row = 0; row < 200; ++row) {
+        stateTable.Start();
+        counter = static_cast<double>(row);
+        stateTable.Advance();
+        osaSleep(period);
+    }
+    CPPUNIT_ASSERT_EQUAL(mtsStateTableFlightRecorder::IDLE, recorder->GetState());
+
+    // trigger is processed by next Advance
+    stateTable.FlightRecorderTrigger();
+    stateTable.Start();
+    counter = static_cast<double>(row);
+    stateTable.Advance();
+    ++row;
+    const double triggerTime = stateTable.Tic.Data;
+    CPPUNIT_ASSERT_EQUAL(mtsStateTableFlightRecorder::TRIGGERED, recorder->GetState());
+    stateTable.FlightRecorderTrigger();
+    CPPUNIT_ASSERT_EQUAL(1u, recorder->GetNumberOfTriggersIgnored());
+
+    // keep advancing while the post-trigger window is captured and dumped
+    const size_t lastRow = row + 200;
+    for (; row < lastRow; ++row) {
+        stateTable.Start();
+        counter = static_cast<double>(row);
+        stateTable.Advance();
+        osaSleep(period);
+    }
+    CPPUNIT_ASSERT(recorder->WaitForIdle(5.0));
+    CPPUNIT_ASSERT_EQUAL(1u, recorder->GetNumberOfDumps());
+    CPPUNIT_ASSERT_EQUAL(0u, recorder->GetNumberOfDumpsTruncated());
+
+    mtsCollectorColumnarReader reader;
+    const std::string fileName = recorder->GetLastFileName();
+    CPPUNIT_ASSERT(reader.Open(fileName));
+    CPPUNIT_ASSERT_EQUAL(std::string("Test"), reader.GetStateTableName());
+    size_t counterSignal;
+    CPPUNIT_ASSERT(reader.GetSignalIndex("Counter", counterSignal));
+    const unsigned long long numberOfRows = reader.GetNumberOfRows();
+    CPPUNIT_ASSERT(numberOfRows > 10);
+    double time, firstTime, lastTime;
+    unsigned long long ticks;
+    CPPUNIT_ASSERT(reader.GetTime(0, firstTime));
+    CPPUNIT_ASSERT(reader.GetTime(numberOfRows - 1, lastTime));
+    // pre-trigger window is complete and post-trigger window is covered
+    CPPUNIT_ASSERT(firstTime >= triggerTime - preTrigger);
+    CPPUNIT_ASSERT(firstTime <= triggerTime - preTrigger + 10.0 * period);
+    CPPUNIT_ASSERT(lastTime >= triggerTime + postTrigger);
+    for (unsigned long long index = 0; index < numberOfRows; ++index) {
+        CPPUNIT_ASSERT(reader.GetTicks(index, ticks));
+        CPPUNIT_ASSERT(reader.GetTime(index, time));
+        CPPUNIT_ASSERT(reader.GetSignal(counterSignal, index, counter));
+        // counter was set to ticks for each row
+        CPPUNIT_ASSERT_EQUAL(static_cast<double>(ticks), counter.Data);
+        if (index > 0) {
+            CPPUNIT_ASSERT(time > firstTime);
+        }
+    }
+    reader.Close();
+    remove(fileName.c_str());
+
+    // can be triggered again
+    stateTable.FlightRecorderTrigger();
+    stateTable.Start();
+    stateTable.Advance();
+    CPPUNIT_ASSERT_EQUAL(mtsStateTableFlightRecorder::TRIGGERED, recorder->GetState());
+    stateTable.FlightRecorderDisable();
+    CPPUNIT_ASSERT(!stateTable.GetFlightRecorder());
+}
+
+
+// advance a state table until stopped
+class mtsStateTableTestAdvancer
+{
+public:
+    mtsStateTable * StateTable;
+    std::atomic<bool> Stop;
+    size_t NumberOfAdvances;
+
+    void * Run(int) {
+        NumberOfAdvances = 0;
+        while (!Stop) {
+            StateTable->Start();
+            StateTable->Advance();
+            ++NumberOfAdvances;
+        }
+        return 0;
+    }
+};
+
+
+void mtsStateTableTest::TestFlightRecorderDisable(void)
+{
+    mtsStateTable stateTable(10, "Test");
+    mtsDouble counter;
+    stateTable.NewElement("Counter", &counter);
+    CPPUNIT_ASSERT(stateTable.FlightRecorderEnable(0.0, 0.0, 1.0 * cmn_ms, "mtsStateTableTestFlightRecorderDisable"));
+
+    // disable while another thread advances the table
+    mtsStateTableTestAdvancer advancer;
+    advancer.StateTable = &stateTable;
+    advancer.Stop = false;
+    osaThread thread;
+    thread.Create<mtsStateTableTestAdvancer, int>(&advancer, &mtsStateTableTestAdvancer::Run, 0);
+    osaSleep(10.0 * cmn_ms);
+    stateTable.FlightRecorderDisable();
+    CPPUNIT_ASSERT(!stateTable.GetFlightRecorder());
+    // ignored
+    stateTable.FlightRecorderTrigger();
+    osaSleep(10.0 * cmn_ms);
+    advancer.Stop = true;
+    thread.Wait();
+    CPPUNIT_ASSERT(advancer.NumberOfAdvances > 0);
+}
+
+
 CPPUNIT_TEST_SUITE_REGISTRATION(mtsStateTableTest);
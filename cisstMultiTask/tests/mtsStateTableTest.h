@@ -6,7 +6,7 @@
   Author(s):  Min Yang Jung
   Created on: 2009-03-05
 
-  (C) Copyright 2009 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -30,6 +30,11 @@ class mtsStateTableTest: public CppUnit::TestFixture
     CPPUNIT_TEST_SUITE(mtsStateTableTest);
     {
         CPPUNIT_TEST(TestGetStateVectorID);
+        CPPUNIT_TEST(TestGetSnapshot);
+        CPPUNIT_TEST(TestGetSnapshotOverwritten);
+        CPPUNIT_TEST(TestStateArrayPOD);
+        CPPUNIT_TEST(TestFlightRecorder);
+        CPPUNIT_TEST(TestFlightRecorderDisable);
     }
     CPPUNIT_TEST_SUITE_END();
 
@@ -39,4 +44,20 @@ public:
     void tearDown(void);
 
     void TestGetStateVectorID(void);
+
+    /*! Test consistent reads of multiple elements */
+    void TestGetSnapshot(void);
+
+    /*! Test reads of rows overwritten or being written */
+    void TestGetSnapshotOverwritten(void);
+
+    /*! Test state arrays for trivially copyable types */
+    void TestStateArrayPOD(void);
+
+    /*! Test pre-trigger capture */
+    void TestFlightRecorder(void);
+
+    /*! Test that the flight recorder can be disabled while the table
+      is advanced */
+    void TestFlightRecorderDisable(void);
 };
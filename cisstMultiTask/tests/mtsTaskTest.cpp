@@ -6,7 +6,7 @@
   Author(s):  Min Yang Jung
   Created on: 2009-03-05
   
-  (C) Copyright 2009 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -19,11 +19,26 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 #include <cisstCommon/cmnUnits.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstOSAbstraction/osaSleep.h>
+#include <cisstOSAbstraction/osaAllocationMonitor.h>
 #include <cisstMultiTask/mtsStateTable.h>
+#include <cisstMultiTask/mtsVector.h>
+#include <cisstMultiTask/mtsInterfaceProvided.h>
+#include <cisstMultiTask/mtsInterfaceRequired.h>
+#include <cisstMultiTask/mtsCommandQueuedVoid.h>
+#include <cisstMultiTask/mtsCommandQueuedWriteBase.h>
+#include <cisstMultiTask/mtsCommandQueuedWriteLatest.h>
+#include <cisstMultiTask/mtsCommandTracer.h>
+#include <cisstMultiTask/mtsTaskPeriodicExecutor.h>
+#include <cisstMultiTask/mtsManagerLocal.h>
 
 #include "mtsTaskTest.h"
 
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 CMN_IMPLEMENT_SERVICES(mtsTaskTestTask);
 
@@ -51,4 +66,503 @@ void mtsTaskTest::TestGetStateVectorID(void)
     task.TestGetStateVectorID();
 }
 
+
+class mtsTaskTestCounterTask: public mtsTaskPeriodic {
+public:
+    int NumberOfRuns;
+    int NumberOfStartups;
+    int NumberOfCleanups;
+    int Sum;
+    const double * VectorPointer;
+    double VectorSum;
+    mtsFunctionWrite Added;
+    bool AllocateInRun;
+    bool ThrowInRun;
+    std::string LastMessage;
+    double RunDuration;
+
+    mtsTaskTestCounterTask(const std::string & name, double period):
+        mtsTaskPeriodic(name, period, false, 50),
+        NumberOfRuns(0),
+        NumberOfStartups(0),
+        NumberOfCleanups(0),
+        Sum(0),
+        VectorPointer(0),
+        VectorSum(0.0),
+        AllocateInRun(false),
+        ThrowInRun(false),
+        RunDuration(0.0)
+    {
+        mtsInterfaceProvided * interfaceProvided = AddInterfaceProvided("Counter");
+        interfaceProvided->AddCommandWrite(&mtsTaskTestCounterTask::Add, this, "Add");
+        interfaceProvided->AddCommandVoid(&mtsTaskTestCounterTask::Reset, this, "Reset");
+        interfaceProvided->AddCommandWrite(&mtsTaskTestCounterTask::SetVector, this, "SetVector");
+        interfaceProvided->AddCommandWrite(&mtsTaskTestCounterTask::Add, this, "AddLatest", MTS_COMMAND_QUEUED_LATEST);
+        interfaceProvided->AddEventWrite(Added, "Added", mtsInt());
+    }
+
+    void Add(const mtsInt & value) {
+        Sum += value.Data;
+    }
+
+    void Reset(void) {
+        Sum = 0;
+    }
+
+    void SetVector(const mtsDoubleVec & vector) {
+        VectorPointer = vector.Pointer();
+        VectorSum = vector.SumOfElements();
+    }
+
+    size_t ProcessCommands(void) {
+        return ProcessQueuedCommands();
+    }
+
+    void Startup(void) {
+        NumberOfStartups++;
+    }
+
+    void Run(void) {
+        ProcessQueuedCommands();
+        if (RunDuration > 0.0) {
+            osaSleep(RunDuration);
+        }
+        NumberOfRuns++;
+        if (AllocateInRun) {
+            std::stringstream message;
+            message << "allocation in Run, iteration " << NumberOfRuns;
+            LastMessage = message.str();
+        }
+        if (ThrowInRun) {
+            throw std::runtime_error("exception in Run");
+        }
+    }
+
+    void RunOnce(void) {
+        DoRunInternal();
+    }
+
+    /*! Mark the task as active without starting its thread */
+    void SetActive(void) {
+        ChangeState(mtsComponentState::ACTIVE);
+    }
+
+    void Cleanup(void) {
+        NumberOfCleanups++;
+    }
+};
+
+void mtsTaskTest::TestExecutor(void)
+{
+    const size_t numberOfTasks = 6;
+    mtsTaskPeriodicExecutor * executor = new mtsTaskPeriodicExecutor("executor", 2);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), executor->GetNumberOfThreads());
+    std::vector<mtsTaskTestCounterTask *> tasks;
+    for (size_t index = 0; index < numberOfTasks; ++index) {
+        std::stringstream name;
+        name << "counter" << index;
+        tasks.push_back(new mtsTaskTestCounterTask(name.str(), (10.0 + 5.0 * index) * cmn_ms));
+        CPPUNIT_ASSERT(executor->AddTask(tasks[index]));
+    }
+    CPPUNIT_ASSERT(!executor->AddTask(tasks[0]));
+    CPPUNIT_ASSERT_EQUAL(numberOfTasks, executor->GetNumberOfTasks());
+
+    for (size_t index = 0; index < numberOfTasks; ++index) {
+        tasks[index]->Create();
+    }
+    for (size_t index = 0; index < numberOfTasks; ++index) {
+        tasks[index]->Start();
+        CPPUNIT_ASSERT(tasks[index]->IsRunning());
+        CPPUNIT_ASSERT_EQUAL(1, tasks[index]->NumberOfStartups);
+    }
+
+    // queued commands are executed by the task's Run
+    mtsInterfaceProvided * interfaceProvided = tasks[0]->GetInterfaceProvided("Counter");
+    CPPUNIT_ASSERT(interfaceProvided);
+    mtsInterfaceProvided * endUserInterface = interfaceProvided->GetEndUserInterface("test");
+    CPPUNIT_ASSERT(endUserInterface);
+    mtsCommandWriteBase * command = endUserInterface->GetCommandWrite("Add");
+    CPPUNIT_ASSERT(command);
+    command->Execute(mtsInt(3), MTS_NOT_BLOCKING);
+    command->Execute(mtsInt(4), MTS_NOT_BLOCKING);
+
+    const double duration = 0.5 * cmn_s;
+    const double start = osaGetTime();
+    osaSleep(duration);
+    tasks[1]->Suspend();
+    const int suspendedRuns = tasks[1]->NumberOfRuns;
+    osaSleep(0.1 * cmn_s);
+    const double elapsed = osaGetTime() - start;
+
+    for (size_t index = 0; index < numberOfTasks; ++index) {
+        tasks[index]->Kill();
+    }
+    for (size_t index = 0; index < numberOfTasks; ++index) {
+        CPPUNIT_ASSERT(tasks[index]->WaitToTerminate(1.0 * cmn_s));
+        CPPUNIT_ASSERT(tasks[index]->IsTerminated());
+        CPPUNIT_ASSERT_EQUAL(1, tasks[index]->NumberOfCleanups);
+        if (index == 1) {
+            continue;
+        }
+        // expected number of runs and state table periods
+        const double period = tasks[index]->GetPeriodicity();
+        const double expected = elapsed / period;
+        // bounds are loose so loaded machines don't fail the test
+        CPPUNIT_ASSERT(tasks[index]->NumberOfRuns > 0.5 * expected);
+        CPPUNIT_ASSERT(tasks[index]->NumberOfRuns < 1.5 * expected + 2);
+        CPPUNIT_ASSERT_DOUBLES_EQUAL(period, tasks[index]->GetAveragePeriod(), 0.5 * period);
+    }
+    CPPUNIT_ASSERT_EQUAL(suspendedRuns, tasks[1]->NumberOfRuns);
+    CPPUNIT_ASSERT_EQUAL(7, tasks[0]->Sum);
+
+    // terminated tasks are removed from the wheels, not from executor
+    CPPUNIT_ASSERT_EQUAL(numberOfTasks, executor->GetNumberOfTasks());
+    delete tasks[0];
+    CPPUNIT_ASSERT_EQUAL(numberOfTasks - 1, executor->GetNumberOfTasks());
+    delete executor;
+    for (size_t index = 1; index < numberOfTasks; ++index) {
+        CPPUNIT_ASSERT(!tasks[index]->GetExecutor());
+        delete tasks[index];
+    }
+}
+
+void mtsTaskTest::TestExecutorRemove(void)
+{
+    mtsTaskPeriodicExecutor executor("executor", 1);
+    mtsTaskTestCounterTask slow("slow", 10.0 * cmn_ms);
+    slow.RunDuration = 0.2 * cmn_s;
+    CPPUNIT_ASSERT(executor.AddTask(&slow));
+    slow.Create();
+    slow.Start();
+    // wait for the first run, the task is then always running
+    const double timeout = osaGetTime() + 2.0 * cmn_s;
+    while ((slow.NumberOfRuns == 0) && (osaGetTime() < timeout)) {
+        osaSleep(1.0 * cmn_ms);
+    }
+    CPPUNIT_ASSERT(slow.NumberOfRuns > 0);
+
+    // executor can be used while the task runs
+    double start = osaGetTime();
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), executor.GetNumberOfTasks());
+    CPPUNIT_ASSERT(osaGetTime() - start < 0.1 * cmn_s);
+
+    // remove waits for the end of the current run
+    CPPUNIT_ASSERT(executor.RemoveTask(&slow));
+    const int runs = slow.NumberOfRuns;
+    CPPUNIT_ASSERT(!slow.GetExecutor());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), executor.GetNumberOfTasks());
+    osaSleep(0.3 * cmn_s);
+    CPPUNIT_ASSERT_EQUAL(runs, slow.NumberOfRuns);
+}
+
+class mtsTaskTestClientTask: public mtsTaskPeriodic {
+public:
+    mtsFunctionWrite Add;
+    mtsFunctionVoid Reset;
+    mtsFunctionWrite SetVector;
+    mtsFunctionWrite AddLatest;
+    std::vector<int> AddedValues;
+
+    mtsTaskTestClientTask(const std::string & name):
+        mtsTaskPeriodic(name, 10.0 * cmn_ms, false, 50)
+    {
+        mtsInterfaceRequired * interfaceRequired = AddInterfaceRequired("Counter");
+        interfaceRequired->AddFunction("Add", Add);
+        interfaceRequired->AddFunction("Reset", Reset);
+        interfaceRequired->AddFunction("SetVector", SetVector);
+        interfaceRequired->AddFunction("AddLatest", AddLatest, MTS_OPTIONAL);
+        interfaceRequired->AddEventHandlerWrite(&mtsTaskTestClientTask::AddedHandler, this, "Added", MTS_EVENT_QUEUED_LATEST);
+    }
+
+    void AddedHandler(const mtsInt & value) {
+        AddedValues.push_back(value.Data);
+    }
+
+    size_t ProcessEvents(void) {
+        return ProcessQueuedEvents();
+    }
+
+    void Startup(void) {}
+    void Run(void) {}
+    void Cleanup(void) {}
+};
+
+void mtsTaskTest::TestDirectCall(void)
+{
+    mtsTaskTestCounterTask counter("counter", 10.0 * cmn_ms);
+    mtsTaskTestClientTask client("client");
+    mtsInterfaceProvided * interfaceProvided = counter.GetInterfaceProvided("Counter");
+    mtsInterfaceRequired * interfaceRequired = client.GetInterfaceRequired("Counter");
+    CPPUNIT_ASSERT(interfaceProvided);
+    CPPUNIT_ASSERT(interfaceRequired);
+
+    // tasks with their own threads, commands are queued
+    CPPUNIT_ASSERT(client.GetExecutionContext() != 0);
+    CPPUNIT_ASSERT(counter.GetExecutionContext() != 0);
+    CPPUNIT_ASSERT(client.GetExecutionContext() != counter.GetExecutionContext());
+    CPPUNIT_ASSERT(interfaceRequired->ConnectTo(interfaceProvided));
+    CPPUNIT_ASSERT(dynamic_cast<mtsCommandQueuedWriteBase *>(client.Add.GetCommand()));
+    CPPUNIT_ASSERT(dynamic_cast<mtsCommandQueuedVoid *>(client.Reset.GetCommand()));
+    CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_QUEUED, client.Add(mtsInt(3)).GetResult());
+    CPPUNIT_ASSERT_EQUAL(0, counter.Sum);
+    counter.ProcessCommands();
+    CPPUNIT_ASSERT_EQUAL(3, counter.Sum);
+
+    // tasks sharing a thread but server not active, commands are queued
+    mtsTaskTestClientTask notActiveClient("notActiveClient");
+    int context;
+    notActiveClient.SetExecutionContext(&context);
+    counter.SetExecutionContext(&context);
+    CPPUNIT_ASSERT(notActiveClient.GetExecutionContext() == counter.GetExecutionContext());
+    CPPUNIT_ASSERT(notActiveClient.GetInterfaceRequired("Counter")->ConnectTo(interfaceProvided));
+    CPPUNIT_ASSERT(dynamic_cast<mtsCommandQueuedWriteBase *>(notActiveClient.Add.GetCommand()));
+
+    // same connection once the server is active, commands are executed by the caller
+    counter.SetActive();
+    CPPUNIT_ASSERT(!dynamic_cast<mtsCommandQueuedWriteBase *>(notActiveClient.Add.GetCommand()));
+    CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_SUCCEEDED, notActiveClient.Add(mtsInt(1)).GetResult());
+    CPPUNIT_ASSERT_EQUAL(4, counter.Sum);
+    CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_SUCCEEDED, notActiveClient.Reset().GetResult());
+    CPPUNIT_ASSERT_EQUAL(0, counter.Sum);
+    CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_SUCCEEDED, notActiveClient.Add(mtsInt(3)).GetResult());
+    CPPUNIT_ASSERT_EQUAL(3, counter.Sum);
+
+    // task connected to itself, commands are queued
+    mtsFunctionWrite selfAdd;
+    mtsInterfaceRequired * selfRequired = counter.AddInterfaceRequired("Self");
+    CPPUNIT_ASSERT(selfRequired);
+    CPPUNIT_ASSERT(selfRequired->AddFunction("Add", selfAdd));
+    CPPUNIT_ASSERT(selfRequired->ConnectTo(interfaceProvided));
+    CPPUNIT_ASSERT(dynamic_cast<mtsCommandQueuedWriteBase *>(selfAdd.GetCommand()));
+
+    // tasks sharing a thread, commands are executed by the caller
+    mtsTaskTestClientTask sameThreadClient("sameThreadClient");
+    sameThreadClient.SetExecutionContext(&context);
+    interfaceRequired = sameThreadClient.GetInterfaceRequired("Counter");
+    CPPUNIT_ASSERT(interfaceRequired->ConnectTo(interfaceProvided));
+    CPPUNIT_ASSERT(!dynamic_cast<mtsCommandQueuedWriteBase *>(sameThreadClient.Add.GetCommand()));
+    CPPUNIT_ASSERT(!dynamic_cast<mtsCommandQueuedVoid *>(sameThreadClient.Reset.GetCommand()));
+    CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_SUCCEEDED, sameThreadClient.Add(mtsInt(4)).GetResult());
+    CPPUNIT_ASSERT_EQUAL(7, counter.Sum);
+    // blocking calls don't wait for the task
+    CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_SUCCEEDED, sameThreadClient.Reset.ExecuteBlocking().GetResult());
+    CPPUNIT_ASSERT_EQUAL(0, counter.Sum);
+    // existing connection still uses the queue
+    CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_QUEUED, client.Reset().GetResult());
+
+    // tasks using the same executor thread share their context
+    mtsTaskPeriodicExecutor executor("executor", 1);
+    mtsTaskTestCounterTask executorCounter("executorCounter", 10.0 * cmn_ms);
+    mtsTaskTestClientTask executorClient("executorClient");
+    CPPUNIT_ASSERT(executor.AddTask(&executorCounter));
+    CPPUNIT_ASSERT(executor.AddTask(&executorClient));
+    CPPUNIT_ASSERT(executorClient.GetExecutionContext() == executorCounter.GetExecutionContext());
+    executorCounter.Create();
+    executorCounter.Start();
+    CPPUNIT_ASSERT(executorCounter.IsRunning());
+    CPPUNIT_ASSERT(executorClient.GetInterfaceRequired("Counter")->ConnectTo(executorCounter.GetInterfaceProvided("Counter")));
+    CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_SUCCEEDED, executorClient.Add(mtsInt(5)).GetResult());
+    CPPUNIT_ASSERT_EQUAL(5, executorCounter.Sum);
+    CPPUNIT_ASSERT(executor.RemoveTask(&executorClient));
+    CPPUNIT_ASSERT(executorClient.GetExecutionContext() != executorCounter.GetExecutionContext());
+    executorCounter.Kill();
+    CPPUNIT_ASSERT(executorCounter.WaitToTerminate(1.0 * cmn_s));
+    CPPUNIT_ASSERT(executor.RemoveTask(&executorCounter));
+}
+
+void mtsTaskTest::TestDirectCallExecIn(void)
+{
+    mtsManagerLocal * manager = mtsManagerLocal::GetInstance();
+    mtsTaskTestCounterTask * owner = new mtsTaskTestCounterTask("directCallOwner", 10.0 * cmn_ms);
+    mtsTaskTestClientTask * child = new mtsTaskTestClientTask("directCallChild");
+    CPPUNIT_ASSERT(manager->AddComponent(owner));
+    CPPUNIT_ASSERT(manager->AddComponent(child));
+
+    // usual order, connect then create and start
+    CPPUNIT_ASSERT(manager->Connect(child->GetName(), "ExecIn", owner->GetName(), "ExecOut"));
+    CPPUNIT_ASSERT(manager->Connect(child->GetName(), "Counter", owner->GetName(), "Counter"));
+    // connections might be established by the manager component client
+    const double timeout = osaGetTime() + 5.0 * cmn_s;
+    while (!child->Add.IsValid() && (osaGetTime() < timeout)) {
+        osaSleep(1.0 * cmn_ms);
+    }
+    CPPUNIT_ASSERT(child->Add.IsValid());
+    // child uses the thread of its owner
+    CPPUNIT_ASSERT(owner->GetExecutionContext() != 0);
+    CPPUNIT_ASSERT(child->GetExecutionContext() == owner->GetExecutionContext());
+    // owner not started yet, commands are queued
+    CPPUNIT_ASSERT(dynamic_cast<mtsCommandQueuedWriteBase *>(child->Add.GetCommand()));
+
+    manager->CreateAll();
+    CPPUNIT_ASSERT(manager->WaitForStateAll(mtsComponentState::READY, 5.0 * cmn_s));
+    manager->StartAll();
+    CPPUNIT_ASSERT(manager->WaitForStateAll(mtsComponentState::ACTIVE, 5.0 * cmn_s));
+
+    // owner is active, commands are executed by the caller
+    CPPUNIT_ASSERT(!dynamic_cast<mtsCommandQueuedWriteBase *>(child->Add.GetCommand()));
+    CPPUNIT_ASSERT(!dynamic_cast<mtsCommandQueuedVoid *>(child->Reset.GetCommand()));
+    CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_SUCCEEDED, child->Reset().GetResult());
+    CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_SUCCEEDED, child->Add(mtsInt(6)).GetResult());
+    CPPUNIT_ASSERT_EQUAL(6, owner->Sum);
+
+    // child is cleaned up by the thread of its owner, kill it first
+    CPPUNIT_ASSERT(child->KillAndWait(5.0 * cmn_s));
+    owner->Kill();
+    CPPUNIT_ASSERT(owner->WaitToTerminate(5.0 * cmn_s));
+    CPPUNIT_ASSERT(manager->Disconnect(child->GetName(), "Counter", owner->GetName(), "Counter"));
+    CPPUNIT_ASSERT(manager->Disconnect(child->GetName(), "ExecIn", owner->GetName(), "ExecOut"));
+    CPPUNIT_ASSERT(manager->RemoveComponent(child));
+    CPPUNIT_ASSERT(manager->RemoveComponent(owner));
+    delete child;
+    delete owner;
+}
+
+void mtsTaskTest::TestWriteSwap(void)
+{
+    mtsTaskTestCounterTask counter("counter", 10.0 * cmn_ms);
+    mtsTaskTestClientTask client("client");
+    CPPUNIT_ASSERT(client.GetInterfaceRequired("Counter")->ConnectTo(counter.GetInterfaceProvided("Counter")));
+
+    // handler receives the caller's buffer, caller gets recycled buffers
+    const size_t length = 10000;
+    const size_t iterations = 3 * mtsInterfaceProvided::DEFAULT_MAIL_BOX_AND_ARGUMENT_QUEUES_SIZE;
+    mtsDoubleVec vector;
+    size_t allocations = 0;
+    for (size_t index = 0; index < iterations; ++index) {
+        if (vector.size() != length) {
+            vector.SetSize(length);
+            allocations++;
+        }
+        vector.SetAll(static_cast<double>(index));
+        const double * pointer = vector.Pointer();
+        CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_QUEUED, client.SetVector.ExecuteSwap(vector).GetResult());
+        counter.ProcessCommands();
+        CPPUNIT_ASSERT(counter.VectorPointer == pointer);
+        CPPUNIT_ASSERT_EQUAL(static_cast<double>(index * length), counter.VectorSum);
+    }
+    CPPUNIT_ASSERT(allocations <= mtsInterfaceProvided::DEFAULT_MAIL_BOX_AND_ARGUMENT_QUEUES_SIZE + 2);
+
+    // non queued commands use the argument without modifying it
+    mtsTaskTestClientTask sameThreadClient("sameThreadClient");
+    int context;
+    sameThreadClient.SetExecutionContext(&context);
+    counter.SetExecutionContext(&context);
+    counter.SetActive();
+    CPPUNIT_ASSERT(sameThreadClient.GetInterfaceRequired("Counter")->ConnectTo(counter.GetInterfaceProvided("Counter")));
+    vector.SetSize(length);
+    vector.SetAll(1.0);
+    const double * pointer = vector.Pointer();
+    CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_SUCCEEDED, sameThreadClient.SetVector.ExecuteSwap(vector).GetResult());
+    CPPUNIT_ASSERT(vector.Pointer() == pointer);
+    CPPUNIT_ASSERT_EQUAL(static_cast<double>(length), counter.VectorSum);
+
+    // function not bound
+    mtsFunctionWrite unbound;
+    CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::FUNCTION_NOT_BOUND, unbound.ExecuteSwap(vector).GetResult());
+}
+
+void mtsTaskTest::TestQueuedLatest(void)
+{
+    mtsTaskTestCounterTask counter("counter", 10.0 * cmn_ms);
+    mtsTaskTestClientTask client("client");
+    CPPUNIT_ASSERT(client.GetInterfaceRequired("Counter")->ConnectTo(counter.GetInterfaceProvided("Counter")));
+    CPPUNIT_ASSERT(dynamic_cast<mtsCommandQueuedWriteLatest *>(client.AddLatest.GetCommand()));
+
+    // only the last argument is processed by the provided interface
+    for (int index = 1; index <= 100; ++index) {
+        CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_QUEUED, client.AddLatest(mtsInt(index)).GetResult());
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), counter.ProcessCommands());
+    CPPUNIT_ASSERT_EQUAL(100, counter.Sum);
+
+    // only the last payload is processed by the event handler
+    for (int index = 1; index <= 100; ++index) {
+        counter.Added(mtsInt(index));
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), client.ProcessEvents());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), client.AddedValues.size());
+    CPPUNIT_ASSERT_EQUAL(100, client.AddedValues[0]);
+    counter.Added(mtsInt(101));
+    client.ProcessEvents();
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), client.AddedValues.size());
+    CPPUNIT_ASSERT_EQUAL(101, client.AddedValues[1]);
+}
+
+void mtsTaskTest::TestCommandTracer(void)
+{
+    mtsTaskTestCounterTask counter("counter", 10.0 * cmn_ms);
+    mtsTaskTestClientTask client("client");
+    CPPUNIT_ASSERT(client.GetInterfaceRequired("Counter")->ConnectTo(counter.GetInterfaceProvided("Counter")));
+
+    mtsCommandTracer::Clear();
+    mtsCommandTracer::Start();
+    CPPUNIT_ASSERT(mtsCommandTracer::IsEnabled());
+    for (int index = 0; index < 3; ++index) {
+        CPPUNIT_ASSERT_EQUAL(mtsExecutionResult::COMMAND_QUEUED, client.Add(mtsInt(index)).GetResult());
+    }
+    counter.ProcessCommands();
+    mtsCommandTracer::Stop();
+    // not recorded once stopped
+    client.Add(mtsInt(1));
+    counter.ProcessCommands();
+
+    // begin, end, enqueue, dequeue and complete for each call
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(15), mtsCommandTracer::GetNumberOfRecords());
+    mtsCommandTracer::StatisticsType statistics;
+    mtsCommandTracer::GetStatistics(statistics);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), statistics.size());
+    const mtsCommandTracer::CommandStatistics & add = statistics["Add"];
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), add.Call.Count);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), add.Queue.Count);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), add.Execution.Count);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), add.Return.Count);
+    CPPUNIT_ASSERT(add.Queue.Max >= add.Queue.Average());
+    CPPUNIT_ASSERT(add.Queue.Average() >= 0.0);
+
+    std::stringstream trace;
+    mtsCommandTracer::ExportChromeTrace(trace);
+    CPPUNIT_ASSERT(trace.str().find("\"traceEvents\"") != std::string::npos);
+    CPPUNIT_ASSERT(trace.str().find("\"ph\":\"X\"") != std::string::npos);
+    CPPUNIT_ASSERT(trace.str().find("\"ph\":\"s\"") != std::string::npos);
+    CPPUNIT_ASSERT(trace.str().find("\"ph\":\"f\"") != std::string::npos);
+
+    mtsCommandTracer::Clear();
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), mtsCommandTracer::GetNumberOfRecords());
+}
+
+void mtsTaskTest::TestAllocationMonitor(void)
+{
+    mtsTaskTestCounterTask counter("counter", 10.0 * cmn_ms);
+    CPPUNIT_ASSERT(counter.GetAllocationMonitor() == 0);
+    counter.EnableAllocationMonitor();
+    const osaAllocationMonitor * monitor = counter.GetAllocationMonitor();
+    CPPUNIT_ASSERT(monitor);
+
+    counter.RunOnce();
+    counter.RunOnce();
+    CPPUNIT_ASSERT_EQUAL(2, counter.NumberOfRuns);
+    CPPUNIT_ASSERT_EQUAL(2ULL, monitor->GetNumberOfSections());
+    CPPUNIT_ASSERT_EQUAL(0ULL, monitor->GetNumberOfSectionsWithAllocations());
+    CPPUNIT_ASSERT(osaAllocationMonitor::GetCurrent() == 0);
+
+    counter.AllocateInRun = true;
+    counter.RunOnce();
+    counter.AllocateInRun = false;
+    counter.RunOnce();
+    CPPUNIT_ASSERT_EQUAL(4ULL, monitor->GetNumberOfSections());
+    if (osaAllocationMonitor::IsAvailable()) {
+        CPPUNIT_ASSERT_EQUAL(1ULL, monitor->GetNumberOfSectionsWithAllocations());
+        CPPUNIT_ASSERT(monitor->GetNumberOfAllocations() > 0);
+    } else {
+        CPPUNIT_ASSERT_EQUAL(0ULL, monitor->GetNumberOfAllocations());
+    }
+
+    // section is ended when Run throws
+    counter.ThrowInRun = true;
+    counter.RunOnce();
+    counter.ThrowInRun = false;
+    CPPUNIT_ASSERT_EQUAL(5ULL, monitor->GetNumberOfSections());
+    CPPUNIT_ASSERT(osaAllocationMonitor::GetCurrent() == 0);
+}
+
 CPPUNIT_TEST_SUITE_REGISTRATION(mtsTaskTest);
@@ -6,7 +6,7 @@
   Author(s):  Min Yang Jung
   Created on: 2009-03-05
   
-  (C) Copyright 2009 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2009-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -49,6 +49,14 @@ class mtsTaskTest: public CppUnit::TestFixture
     CPPUNIT_TEST_SUITE(mtsTaskTest);
 	{
 		CPPUNIT_TEST(TestGetStateVectorID);
+        CPPUNIT_TEST(TestExecutor);
+        CPPUNIT_TEST(TestExecutorRemove);
+        CPPUNIT_TEST(TestDirectCall);
+        CPPUNIT_TEST(TestDirectCallExecIn);
+        CPPUNIT_TEST(TestWriteSwap);
+        CPPUNIT_TEST(TestQueuedLatest);
+        CPPUNIT_TEST(TestCommandTracer);
+        CPPUNIT_TEST(TestAllocationMonitor);
     }
     CPPUNIT_TEST_SUITE_END();
 	
@@ -58,4 +66,29 @@ public:
     void tearDown(void) {}
 
 	void TestGetStateVectorID(void);
+
+    /*! Test periodic tasks sharing executor threads */
+    void TestExecutor(void);
+
+    /*! Test executor methods called while tasks are running */
+    void TestExecutorRemove(void);
+
+    /*! Test functions bound to non queued commands for tasks sharing a thread */
+    void TestDirectCall(void);
+
+    /*! Test direct calls from a task using the thread of its owner,
+      connected before the tasks are created and started. */
+    void TestDirectCallExecIn(void);
+
+    /*! Test queued write with handoff of the argument */
+    void TestWriteSwap(void);
+
+    /*! Test commands and event handlers keeping only the latest argument */
+    void TestQueuedLatest(void);
+
+    /*! Test tracing of queued commands */
+    void TestCommandTracer(void);
+
+    /*! Test detection of heap allocations in Run */
+    void TestAllocationMonitor(void);
 };
@@ -0,0 +1,257 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstOSAbstraction/osaAllocationMonitor.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+#if CISST_OSA_HAS_EXECINFO
+#include <execinfo.h>
+#endif
+
+// monitor used by the current thread, plain pointer so it can be
+// used by operator new at any time (static initialization, thread exit)
+static thread_local osaAllocationMonitor * osaAllocationMonitorCurrent = 0;
+
+
+osaAllocationMonitor::osaAllocationMonitor(const std::string & name):
+    Name(name),
+    NumberOfSections(0),
+    NumberOfSectionsWithAllocations(0),
+    NumberOfAllocations(0),
+    NumberOfDeallocations(0),
+    NumberOfBytes(0),
+    NumberOfUnrecordedAllocations(0),
+    AllocationsAtBegin(0),
+    Previous(0)
+{
+    for (size_t index = 0; index < MAXIMUM_NUMBER_OF_CALL_SITES; ++index) {
+        this->CallSites[index].Used = false;
+        this->CallSites[index].NumberOfAllocations = 0;
+        this->CallSites[index].NumberOfBytes = 0;
+        this->CallSites[index].NumberOfFrames = 0;
+    }
+#if CISST_OSA_HAS_EXECINFO
+    // the first call to backtrace might load a library and allocate
+    void * frames[1];
+    backtrace(frames, 1);
+#endif
+}
+
+
+osaAllocationMonitor::~osaAllocationMonitor()
+{
+    if (osaAllocationMonitorCurrent == this) {
+        osaAllocationMonitorCurrent = this->Previous;
+    }
+}
+
+
+bool osaAllocationMonitor::IsAvailable(void)
+{
+    return (CISST_OSA_HAS_ALLOCATION_MONITOR != 0);
+}
+
+
+void osaAllocationMonitor::Begin(void)
+{
+    this->Previous = osaAllocationMonitorCurrent;
+    this->AllocationsAtBegin = this->NumberOfAllocations.load(std::memory_order_relaxed);
+    this->NumberOfSections.fetch_add(1, std::memory_order_relaxed);
+    osaAllocationMonitorCurrent = this;
+}
+
+
+void osaAllocationMonitor::End(void)
+{
+    osaAllocationMonitorCurrent = this->Previous;
+    this->Previous = 0;
+    if (this->NumberOfAllocations.load(std::memory_order_relaxed) != this->AllocationsAtBegin) {
+        this->NumberOfSectionsWithAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+
+osaAllocationMonitor * osaAllocationMonitor::GetCurrent(void)
+{
+    return osaAllocationMonitorCurrent;
+}
+
+
+size_t osaAllocationMonitor::GetNumberOfCallSites(void) const
+{
+    size_t index = 0;
+    while ((index < MAXIMUM_NUMBER_OF_CALL_SITES)
+           && this->CallSites[index].Used.load(std::memory_order_acquire)) {
+        ++index;
+    }
+    return index;
+}
+
+
+void osaAllocationMonitor::RecordAllocation(size_t size)
+{
+    // disable monitoring while recording in case backtrace allocates
+    osaAllocationMonitorCurrent = 0;
+    this->NumberOfAllocations.fetch_add(1, std::memory_order_relaxed);
+    this->NumberOfBytes.fetch_add(size, std::memory_order_relaxed);
+#if CISST_OSA_HAS_EXECINFO
+    // skip this method and operator new
+    const int skip = 2;
+    void * frames[MAXIMUM_NUMBER_OF_FRAMES + skip];
+    int numberOfFrames = backtrace(frames, MAXIMUM_NUMBER_OF_FRAMES + skip) - skip;
+    if (numberOfFrames < 0) {
+        numberOfFrames = 0;
+    }
+    size_t index;
+    for (index = 0; index < MAXIMUM_NUMBER_OF_CALL_SITES; ++index) {
+        CallSite & site = this->CallSites[index];
+        if (!site.Used.load(std::memory_order_relaxed)) {
+            // new call site, published once filled
+            site.NumberOfFrames = numberOfFrames;
+            memcpy(site.Frames, frames + skip, numberOfFrames * sizeof(void *));
+            site.NumberOfAllocations.store(1, std::memory_order_relaxed);
+            site.NumberOfBytes.store(size, std::memory_order_relaxed);
+            site.Used.store(true, std::memory_order_release);
+            break;
+        }
+        if ((site.NumberOfFrames == numberOfFrames)
+            && (memcmp(site.Frames, frames + skip, numberOfFrames * sizeof(void *)) == 0)) {
+            site.NumberOfAllocations.fetch_add(1, std::memory_order_relaxed);
+            site.NumberOfBytes.fetch_add(size, std::memory_order_relaxed);
+            break;
+        }
+    }
+    if (index == MAXIMUM_NUMBER_OF_CALL_SITES) {
+        this->NumberOfUnrecordedAllocations.fetch_add(1, std::memory_order_relaxed);
+    }
+#else
+    this->NumberOfUnrecordedAllocations.fetch_add(1, std::memory_order_relaxed);
+#endif
+    osaAllocationMonitorCurrent = this;
+}
+
+
+void osaAllocationMonitor::RecordDeallocation(void)
+{
+    this->NumberOfDeallocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+void osaAllocationMonitor::ToStream(std::ostream & outputStream) const
+{
+    // don't report allocations performed by this method
+    osaAllocationMonitor * current = osaAllocationMonitorCurrent;
+    osaAllocationMonitorCurrent = 0;
+    outputStream << "osaAllocationMonitor \"" << this->Name << "\": "
+                 << this->GetNumberOfSectionsWithAllocations() << "/" << this->GetNumberOfSections()
+                 << " section(s) with allocations, "
+                 << this->GetNumberOfAllocations() << " allocation(s) for "
+                 << this->GetNumberOfBytes() << " byte(s), "
+                 << this->GetNumberOfDeallocations() << " deallocation(s)";
+    if (!IsAvailable()) {
+        outputStream << " (not available, compile with CISST_OSA_ALLOCATION_MONITOR)";
+    }
+    const unsigned long long unrecorded = this->NumberOfUnrecordedAllocations.load(std::memory_order_relaxed);
+    if (unrecorded != 0) {
+        outputStream << ", " << unrecorded << " allocation(s) without call site";
+    }
+    const size_t numberOfCallSites = this->GetNumberOfCallSites();
+    for (size_t index = 0; index < numberOfCallSites; ++index) {
+        const CallSite & site = this->CallSites[index];
+        outputStream << std::endl << "  call site " << index << ": "
+                     << site.NumberOfAllocations.load(std::memory_order_relaxed) << " allocation(s) for "
+                     << site.NumberOfBytes.load(std::memory_order_relaxed) << " byte(s)";
+#if CISST_OSA_HAS_EXECINFO
+        char ** symbols = backtrace_symbols(site.Frames, site.NumberOfFrames);
+        for (int frame = 0; frame < site.NumberOfFrames; ++frame) {
+            outputStream << std::endl << "    ";
+            if (symbols) {
+                outputStream << symbols[frame];
+            } else {
+                outputStream << site.Frames[frame];
+            }
+        }
+        free(symbols);
+#endif
+    }
+    osaAllocationMonitorCurrent = current;
+}
+
+
+#if CISST_OSA_HAS_ALLOCATION_MONITOR
+
+// replacements of the global operators new and delete, the other
+// forms (nothrow, sized delete) are implemented by the standard
+// library using these
+static void * osaAllocationMonitorMalloc(size_t size)
+{
+    if (size == 0) {
+        size = 1;
+    }
+    void * result;
+    while (!(result = malloc(size))) {
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+    return result;
+}
+
+void * operator new(size_t size)
+{
+    void * result = osaAllocationMonitorMalloc(size);
+    osaAllocationMonitor * current = osaAllocationMonitorCurrent;
+    if (current) {
+        current->RecordAllocation(size);
+    }
+    return result;
+}
+
+void * operator new[](size_t size)
+{
+    void * result = osaAllocationMonitorMalloc(size);
+    osaAllocationMonitor * current = osaAllocationMonitorCurrent;
+    if (current) {
+        current->RecordAllocation(size);
+    }
+    return result;
+}
+
+void operator delete(void * pointer) noexcept
+{
+    osaAllocationMonitor * current = osaAllocationMonitorCurrent;
+    if (current && pointer) {
+        current->RecordDeallocation();
+    }
+    free(pointer);
+}
+
+void operator delete[](void * pointer) noexcept
+{
+    osaAllocationMonitor * current = osaAllocationMonitorCurrent;
+    if (current && pointer) {
+        current->RecordDeallocation();
+    }
+    free(pointer);
+}
+
+#endif // CISST_OSA_HAS_ALLOCATION_MONITOR
@@ -0,0 +1,690 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstCommon/cmnLogger.h>
+#include <cisstOSAbstraction/osaAsynchronousLogger.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+    enum {RECORD = 0, WRAP = 1, BINARY = 2};
+
+    /*! Header stored before each record, records are aligned on the
+      header size */
+    struct RecordHeader {
+        unsigned int Size;
+        cmnLogLevel Level;
+        short Type;
+        unsigned long long Sequence;
+    };
+
+    const size_t HEADER_SIZE = sizeof(RecordHeader);
+
+    inline size_t AlignedSize(size_t size) {
+        return ((size + HEADER_SIZE - 1) / HEADER_SIZE) * HEADER_SIZE;
+    }
+
+    /*! Sequence number shared by all threads to write records in order */
+    std::atomic<unsigned long long> osaAsynchronousLoggerSequence(0);
+
+    std::atomic<unsigned long long> osaAsynchronousLoggerGeneration(0);
+
+    /*! Number used to identify threads in binary messages */
+    std::atomic<unsigned int> osaAsynchronousLoggerNumberOfThreads(0);
+    thread_local unsigned int osaAsynchronousLoggerThreadNumber = 0;
+
+    /*! Content of a binary record, followed by the arguments */
+    struct BinaryRecordHeader {
+        const cmnLogBinarySite * Site;
+        double Time;
+        unsigned int Thread;
+    };
+
+    std::atomic<osaAsynchronousLogger *> osaAsynchronousLoggerRunning(0);
+
+    /*! Signals handled to flush the records before a crash */
+    const int osaAsynchronousLoggerSignals[] = {
+        SIGSEGV, SIGABRT, SIGFPE, SIGILL
+#ifdef SIGBUS
+        , SIGBUS
+#endif
+    };
+
+    const size_t osaAsynchronousLoggerNumberOfSignals =
+        sizeof(osaAsynchronousLoggerSignals) / sizeof(int);
+
+    typedef void (*SignalHandlerType)(int);
+
+    SignalHandlerType osaAsynchronousLoggerPreviousHandlers[osaAsynchronousLoggerNumberOfSignals];
+}
+
+
+/*! Single producer, single consumer ring buffer.  The head is only
+  modified by the thread owning the buffer and the tail by the thread
+  draining the buffers. */
+struct osaAsynchronousLoggerBuffer
+{
+    std::vector<char> Data;
+    std::atomic<unsigned long long> Head;
+    std::atomic<unsigned long long> Tail;
+    std::atomic<unsigned long long> NumberOfRecords;
+    std::atomic<unsigned long long> NumberOfDroppedRecords;
+    /*! One reference for the logger, one for the thread using it */
+    std::atomic<int> References;
+    std::atomic<bool> InUse;
+    /*! Characters of the current line, owning thread only */
+    std::string Pending;
+    cmnLogLevel PendingLevel;
+    size_t MaximumRecordSize;
+    osaAsynchronousLoggerBuffer * Next;
+
+    osaAsynchronousLoggerBuffer(size_t size):
+        Data(AlignedSize(size)),
+        Head(0),
+        Tail(0),
+        NumberOfRecords(0),
+        NumberOfDroppedRecords(0),
+        References(2),
+        InUse(true),
+        PendingLevel(CMN_LOG_LEVEL_NONE),
+        MaximumRecordSize(Data.size() / 4),
+        Next(0)
+    {
+        Pending.reserve(256);
+    }
+
+    void Release(void) {
+        if (References.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete this;
+        }
+    }
+
+    /*! Copy the pending characters in the ring */
+    void Publish(void) {
+        if (Pending.empty()) {
+            return;
+        }
+        PublishRecord(RECORD, PendingLevel, Pending.data(), Pending.size());
+        Pending.clear();
+    }
+
+    /*! Copy a record in the ring */
+    void PublishRecord(short type, cmnLogLevel level, const char * data, size_t size) {
+        const size_t capacity = Data.size();
+        const size_t needed = HEADER_SIZE + AlignedSize(size);
+        const unsigned long long head = Head.load(std::memory_order_relaxed);
+        const unsigned long long tail = Tail.load(std::memory_order_acquire);
+        const size_t offset = static_cast<size_t>(head % capacity);
+        const size_t contiguous = capacity - offset;
+        const size_t wrap = (contiguous < needed) ? contiguous : 0;
+        if ((needed > capacity) || (head + wrap + needed - tail > capacity)) {
+            NumberOfDroppedRecords.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        RecordHeader header;
+        if (wrap) {
+            header.Size = 0;
+            header.Level = CMN_LOG_LEVEL_NONE;
+            header.Type = WRAP;
+            header.Sequence = 0;
+            memcpy(&(Data[offset]), &header, HEADER_SIZE);
+        }
+        const size_t position = static_cast<size_t>((head + wrap) % capacity);
+        header.Size = static_cast<unsigned int>(size);
+        header.Level = level;
+        header.Type = type;
+        header.Sequence = osaAsynchronousLoggerSequence.fetch_add(1, std::memory_order_relaxed);
+        memcpy(&(Data[position]), &header, HEADER_SIZE);
+        memcpy(&(Data[position + HEADER_SIZE]), data, size);
+        Head.store(head + wrap + needed, std::memory_order_release);
+        NumberOfRecords.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /*! Find the next record, skipping wrap markers.  Returns false if
+      the buffer is empty. */
+    bool Peek(RecordHeader & header) {
+        const size_t capacity = Data.size();
+        unsigned long long tail = Tail.load(std::memory_order_relaxed);
+        const unsigned long long head = Head.load(std::memory_order_acquire);
+        while (tail < head) {
+            const size_t offset = static_cast<size_t>(tail % capacity);
+            memcpy(&header, &(Data[offset]), HEADER_SIZE);
+            if (header.Type != WRAP) {
+                return true;
+            }
+            tail += capacity - offset;
+            Tail.store(tail, std::memory_order_release);
+        }
+        return false;
+    }
+
+    /*! Pointer on the characters of the record found by Peek */
+    const char * GetRecordData(void) const {
+        const size_t offset = static_cast<size_t>(Tail.load(std::memory_order_relaxed) % Data.size());
+        return &(Data[offset + HEADER_SIZE]);
+    }
+
+    /*! Remove the record found by Peek */
+    void Pop(const RecordHeader & header) {
+        Tail.store(Tail.load(std::memory_order_relaxed) + HEADER_SIZE + AlignedSize(header.Size),
+                   std::memory_order_release);
+    }
+};
+
+
+namespace {
+    /*! Buffer used by the current thread, the buffer is released when
+      the thread ends or when another logger is started */
+    class ThreadBuffer {
+    public:
+        unsigned long long Generation;
+        osaAsynchronousLoggerBuffer * Buffer;
+
+        ThreadBuffer(void):
+            Generation(0),
+            Buffer(0)
+        {}
+
+        ~ThreadBuffer() {
+            Release();
+        }
+
+        void Release(void) {
+            if (Buffer) {
+                Buffer->Publish();
+                Buffer->InUse.store(false, std::memory_order_release);
+                Buffer->Release();
+                Buffer = 0;
+            }
+        }
+    };
+
+    thread_local ThreadBuffer osaAsynchronousLoggerThreadBuffer;
+}
+
+
+osaAsynchronousLogger::osaAsynchronousLogger(size_t bufferSize):
+    BufferSize(bufferSize),
+    FrontEnd(0),
+    Period(0.01),
+    FlushOnSignal(false),
+    StopRequested(false),
+    SyncRequested(false),
+    Draining(false),
+    Buffers(0),
+    Generation(0),
+    NumberOfRecordsReleased(0),
+    NumberOfDroppedRecordsReleased(0)
+{
+}
+
+
+osaAsynchronousLogger::~osaAsynchronousLogger()
+{
+    Stop();
+    CloseBinaryFile();
+}
+
+
+bool osaAsynchronousLogger::Start(MultiplexerType * frontEnd,
+                                  double periodInSeconds,
+                                  bool flushOnSignal)
+{
+    if (!frontEnd) {
+        frontEnd = cmnLogger::GetMultiplexer();
+    }
+    osaAsynchronousLogger * expected = 0;
+    if (!osaAsynchronousLoggerRunning.compare_exchange_strong(expected, this)) {
+        CMN_LOG_INIT_ERROR << "osaAsynchronousLogger::Start: an asynchronous logger is already running" << std::endl;
+        return false;
+    }
+
+    // take over the front end's channels
+    const ChannelContainerType channels = frontEnd->GetChannels();
+    ConstIteratorType channel;
+    const ConstIteratorType end = channels.end();
+    for (channel = channels.begin(); channel != end; ++channel) {
+        this->AddChannel(channel->first, channel->second);
+        frontEnd->RemoveChannel(channel->first);
+    }
+
+    this->Generation = osaAsynchronousLoggerGeneration.fetch_add(1) + 1;
+    this->NumberOfRecordsReleased = 0;
+    this->NumberOfDroppedRecordsReleased = 0;
+    this->Period = periodInSeconds;
+    this->FlushOnSignal = flushOnSignal;
+    this->StopRequested = false;
+    this->FrontEnd = frontEnd;
+    frontEnd->AddMultiplexer(this);
+    UpdateBinarySink();
+
+    Thread.Create<osaAsynchronousLogger, void *>(this, &osaAsynchronousLogger::Run, 0, "Logger");
+
+    if (flushOnSignal) {
+        for (size_t index = 0; index < osaAsynchronousLoggerNumberOfSignals; ++index) {
+            osaAsynchronousLoggerPreviousHandlers[index] =
+                std::signal(osaAsynchronousLoggerSignals[index], osaAsynchronousLogger::SignalHandler);
+        }
+    }
+
+    static bool exitHandlerRegistered = false;
+    if (!exitHandlerRegistered) {
+        atexit(osaAsynchronousLogger::ExitHandler);
+        exitHandlerRegistered = true;
+    }
+    return true;
+}
+
+
+void osaAsynchronousLogger::Stop(void)
+{
+    MultiplexerType * frontEnd = this->FrontEnd;
+    if (!frontEnd) {
+        return;
+    }
+    frontEnd->RemoveMultiplexer(this);
+    this->FrontEnd = 0;
+    UpdateBinarySink();
+    PublishPending();
+    this->StopRequested = true;
+    Signal.Raise();
+    Thread.Wait();
+    Drain();
+
+    if (this->FlushOnSignal) {
+        for (size_t index = 0; index < osaAsynchronousLoggerNumberOfSignals; ++index) {
+            std::signal(osaAsynchronousLoggerSignals[index], osaAsynchronousLoggerPreviousHandlers[index]);
+        }
+    }
+
+    // give the channels back
+    ConstIteratorType channel;
+    const ConstIteratorType end = this->Channels.end();
+    for (channel = this->Channels.begin(); channel != end; ++channel) {
+        frontEnd->AddChannel(channel->first, channel->second);
+    }
+    this->RemoveAllChannels();
+    ReleaseBuffers();
+    osaAsynchronousLoggerRunning = 0;
+}
+
+
+void osaAsynchronousLogger::Flush(void)
+{
+    PublishPending();
+    Drain();
+}
+
+
+unsigned long long osaAsynchronousLogger::GetNumberOfRecords(void) const
+{
+    unsigned long long result = this->NumberOfRecordsReleased;
+    for (const osaAsynchronousLoggerBuffer * buffer = Buffers.load(std::memory_order_acquire);
+         buffer;
+         buffer = buffer->Next) {
+        result += buffer->NumberOfRecords.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+
+unsigned long long osaAsynchronousLogger::GetNumberOfDroppedRecords(void) const
+{
+    unsigned long long result = this->NumberOfDroppedRecordsReleased;
+    for (const osaAsynchronousLoggerBuffer * buffer = Buffers.load(std::memory_order_acquire);
+         buffer;
+         buffer = buffer->Next) {
+        result += buffer->NumberOfDroppedRecords.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+
+size_t osaAsynchronousLogger::GetNumberOfBuffers(void) const
+{
+    size_t result = 0;
+    for (const osaAsynchronousLoggerBuffer * buffer = Buffers.load(std::memory_order_acquire);
+         buffer;
+         buffer = buffer->Next) {
+        result++;
+    }
+    return result;
+}
+
+
+osaAsynchronousLogger * osaAsynchronousLogger::GetRunning(void)
+{
+    return osaAsynchronousLoggerRunning;
+}
+
+
+std::streamsize osaAsynchronousLogger::xsputn(const char * s, std::streamsize n, cmnLogLevel level)
+{
+    Append(s, n, level);
+    return n;
+}
+
+
+int osaAsynchronousLogger::sync(void)
+{
+    // flushing the channels is left to the thread draining the buffers
+    PublishPending();
+    this->SyncRequested = true;
+    return 0;
+}
+
+
+osaAsynchronousLogger::int_type osaAsynchronousLogger::overflow(int_type c, cmnLogLevel level)
+{
+    if (traits_type::eq_int_type(traits_type::eof(), c)) {
+        return traits_type::not_eof(c);
+    }
+    const char character = traits_type::to_char_type(c);
+    Append(&character, 1, level);
+    return traits_type::not_eof(c);
+}
+
+
+std::streamsize osaAsynchronousLogger::xsputn(const char * s, std::streamsize n)
+{
+    // no level of detail, written to all channels
+    Append(s, n, CMN_LOG_LEVEL_NONE);
+    return n;
+}
+
+
+osaAsynchronousLogger::int_type osaAsynchronousLogger::overflow(int_type c)
+{
+    return overflow(c, CMN_LOG_LEVEL_NONE);
+}
+
+
+void osaAsynchronousLogger::Append(const char * s, std::streamsize n, cmnLogLevel level)
+{
+    osaAsynchronousLoggerBuffer * buffer = GetBuffer();
+    if (!buffer->Pending.empty() && (buffer->PendingLevel != level)) {
+        buffer->Publish();
+    }
+    buffer->PendingLevel = level;
+    while (n > 0) {
+        const char * endOfLine = static_cast<const char *>(memchr(s, '\n', static_cast<size_t>(n)));
+        if (!endOfLine) {
+            buffer->Pending.append(s, static_cast<size_t>(n));
+            if (buffer->Pending.size() >= buffer->MaximumRecordSize) {
+                buffer->Publish();
+            }
+            return;
+        }
+        const std::streamsize length = (endOfLine - s) + 1;
+        buffer->Pending.append(s, static_cast<size_t>(length));
+        buffer->Publish();
+        s += length;
+        n -= length;
+    }
+}
+
+
+void osaAsynchronousLogger::PublishPending(void)
+{
+    ThreadBuffer & current = osaAsynchronousLoggerThreadBuffer;
+    if (current.Buffer && (current.Generation == this->Generation)) {
+        current.Buffer->Publish();
+    }
+}
+
+
+bool osaAsynchronousLogger::Drain(bool fromSignal)
+{
+    if (!LockDrain(fromSignal)) {
+        return false;
+    }
+
+    // write records from all buffers in sequence order
+    bool written = false;
+    bool writtenBinary = false;
+    RecordHeader header, nextHeader;
+    while (true) {
+        osaAsynchronousLoggerBuffer * next = 0;
+        for (osaAsynchronousLoggerBuffer * buffer = Buffers.load(std::memory_order_acquire);
+             buffer;
+             buffer = buffer->Next) {
+            if (buffer->Peek(header)
+                && (!next || (header.Sequence < nextHeader.Sequence))) {
+                next = buffer;
+                nextHeader = header;
+            }
+        }
+        if (!next) {
+            break;
+        }
+        const char * data = next->GetRecordData();
+        if (nextHeader.Type == BINARY) {
+            WriteBinary(data, nextHeader.Size);
+            writtenBinary = true;
+        } else if (nextHeader.Level == CMN_LOG_LEVEL_NONE) {
+            MultiplexerType::xsputn(data, nextHeader.Size);
+            written = true;
+        } else {
+            MultiplexerType::xsputn(data, nextHeader.Size, nextHeader.Level);
+            written = true;
+        }
+        next->Pop(nextHeader);
+    }
+    if (SyncRequested.exchange(false) || written) {
+        MultiplexerType::sync();
+    }
+    if (writtenBinary && BinaryFile.is_open()) {
+        BinaryFile.flush();
+    }
+
+    UnlockDrain();
+    return true;
+}
+
+
+bool osaAsynchronousLogger::LockDrain(bool fromSignal)
+{
+    bool expected = false;
+    size_t attempts = 0;
+    while (!Draining.compare_exchange_weak(expected, true, std::memory_order_acquire)) {
+        expected = false;
+        // the thread draining might have been interrupted by a signal
+        attempts++;
+        if (fromSignal && (attempts > 1000000)) {
+            return false;
+        }
+        osaCurrentThreadYield();
+    }
+    return true;
+}
+
+
+void osaAsynchronousLogger::UnlockDrain(void)
+{
+    Draining.store(false, std::memory_order_release);
+}
+
+
+bool osaAsynchronousLogger::OpenBinaryFile(const std::string & fileName)
+{
+    CloseBinaryFile();
+    LockDrain();
+    BinaryFile.open(fileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    const bool opened = BinaryFile.is_open();
+    if (opened) {
+        cmnLogBinaryFormat::WriteHeader(BinaryFile);
+        BinarySites.clear();
+    }
+    UnlockDrain();
+    if (!opened) {
+        CMN_LOG_INIT_ERROR << "osaAsynchronousLogger::OpenBinaryFile: can't create \"" << fileName << "\"" << std::endl;
+        return false;
+    }
+    UpdateBinarySink();
+    return true;
+}
+
+
+void osaAsynchronousLogger::CloseBinaryFile(void)
+{
+    if (!BinaryFile.is_open()) {
+        return;
+    }
+    // stop sending binary messages and write the pending ones
+    cmnLogger::RemoveBinarySink(this);
+    Flush();
+    LockDrain();
+    BinaryFile.close();
+    UnlockDrain();
+}
+
+
+void osaAsynchronousLogger::Write(const cmnLogBinarySite & site, const char * arguments, size_t size)
+{
+    if (osaAsynchronousLoggerThreadNumber == 0) {
+        osaAsynchronousLoggerThreadNumber = osaAsynchronousLoggerNumberOfThreads.fetch_add(1) + 1;
+    }
+    char record[sizeof(BinaryRecordHeader) + cmnLogBinaryArguments::MAXIMUM_SIZE];
+    BinaryRecordHeader header;
+    header.Site = &site;
+    header.Time = osaGetTime();
+    header.Thread = osaAsynchronousLoggerThreadNumber;
+    if (size > cmnLogBinaryArguments::MAXIMUM_SIZE) {
+        size = cmnLogBinaryArguments::MAXIMUM_SIZE;
+    }
+    memcpy(record, &header, sizeof(BinaryRecordHeader));
+    memcpy(record + sizeof(BinaryRecordHeader), arguments, size);
+    GetBuffer()->PublishRecord(BINARY, site.Level, record, sizeof(BinaryRecordHeader) + size);
+}
+
+
+void osaAsynchronousLogger::WriteBinary(const char * data, size_t size)
+{
+    if (!BinaryFile.is_open() || (size < sizeof(BinaryRecordHeader))) {
+        return;
+    }
+    BinaryRecordHeader header;
+    memcpy(&header, data, sizeof(BinaryRecordHeader));
+    // write the call site the first time it is used
+    unsigned int siteIndex;
+    const BinarySitesType::const_iterator found = BinarySites.find(header.Site);
+    if (found == BinarySites.end()) {
+        siteIndex = static_cast<unsigned int>(BinarySites.size());
+        BinarySites[header.Site] = siteIndex;
+        cmnLogBinaryFormat::WriteSite(BinaryFile, siteIndex, *(header.Site));
+    } else {
+        siteIndex = found->second;
+    }
+    cmnLogBinaryFormat::WriteMessage(BinaryFile, siteIndex, header.Time, header.Thread,
+                                     data + sizeof(BinaryRecordHeader),
+                                     size - sizeof(BinaryRecordHeader));
+}
+
+
+void osaAsynchronousLogger::UpdateBinarySink(void)
+{
+    if (this->FrontEnd && BinaryFile.is_open()) {
+        cmnLogger::SetBinarySink(this);
+    } else {
+        cmnLogger::RemoveBinarySink(this);
+    }
+}
+
+
+void * osaAsynchronousLogger::Run(void * CMN_UNUSED(argument))
+{
+    while (!this->StopRequested) {
+        Signal.Wait(this->Period);
+        Drain();
+    }
+    return 0;
+}
+
+
+osaAsynchronousLoggerBuffer * osaAsynchronousLogger::GetBuffer(void)
+{
+    ThreadBuffer & current = osaAsynchronousLoggerThreadBuffer;
+    if (current.Buffer && (current.Generation == this->Generation)) {
+        return current.Buffer;
+    }
+    current.Release();
+    current.Generation = this->Generation;
+
+    // reuse a buffer released by a thread that ended
+    osaAsynchronousLoggerBuffer * buffer;
+    for (buffer = Buffers.load(std::memory_order_acquire);
+         buffer;
+         buffer = buffer->Next) {
+        bool inUse = false;
+        if (buffer->InUse.compare_exchange_strong(inUse, true)) {
+            buffer->References.fetch_add(1);
+            current.Buffer = buffer;
+            return buffer;
+        }
+    }
+
+    buffer = new osaAsynchronousLoggerBuffer(this->BufferSize);
+    buffer->Next = Buffers.load(std::memory_order_relaxed);
+    while (!Buffers.compare_exchange_weak(buffer->Next, buffer, std::memory_order_release)) {
+    }
+    current.Buffer = buffer;
+    return buffer;
+}
+
+
+void osaAsynchronousLogger::ReleaseBuffers(void)
+{
+    osaAsynchronousLoggerBuffer * buffer = Buffers.exchange(0);
+    while (buffer) {
+        osaAsynchronousLoggerBuffer * next = buffer->Next;
+        this->NumberOfRecordsReleased += buffer->NumberOfRecords;
+        this->NumberOfDroppedRecordsReleased += buffer->NumberOfDroppedRecords;
+        buffer->Release();
+        buffer = next;
+    }
+}
+
+
+void osaAsynchronousLogger::SignalHandler(int signalNumber)
+{
+    osaAsynchronousLogger * logger = osaAsynchronousLoggerRunning;
+    if (logger) {
+        logger->Drain(true);
+    }
+    // restore the previous handler and raise the signal again
+    for (size_t index = 0; index < osaAsynchronousLoggerNumberOfSignals; ++index) {
+        if (osaAsynchronousLoggerSignals[index] == signalNumber) {
+            std::signal(signalNumber, osaAsynchronousLoggerPreviousHandlers[index]);
+        }
+    }
+    std::raise(signalNumber);
+}
+
+
+void osaAsynchronousLogger::ExitHandler(void)
+{
+    osaAsynchronousLogger * logger = osaAsynchronousLoggerRunning;
+    if (logger) {
+        logger->Stop();
+    }
+}
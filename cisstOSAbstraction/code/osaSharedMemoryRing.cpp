@@ -0,0 +1,465 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstCommon/cmnAssert.h>
+#include <cisstCommon/cmnLogger.h>
+#include <cisstOSAbstraction/osaSharedMemoryRing.h>
+#include <cisstOSAbstraction/osaConfig.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstOSAbstraction/osaSleep.h>
+
+#include <atomic>
+#include <cstring>
+#include <new>
+#include <sstream>
+
+#if (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_LINUX_XENOMAI) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS) || (CISST_OS == CISST_QNX)
+#define OSA_SHARED_MEMORY_RING_SUPPORTED 1
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define OSA_SHARED_MEMORY_RING_SUPPORTED 0
+#endif
+
+// doorbells use a futex on plain Linux, other systems poll
+#if (CISST_OS == CISST_LINUX) && CISST_OSA_HAS_FUTEX
+#define OSA_SHARED_MEMORY_RING_USE_FUTEX 1
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#else
+#define OSA_SHARED_MEMORY_RING_USE_FUTEX 0
+#endif
+
+// data shared between processes, positions are in bytes since
+// creation and only increase
+struct osaSharedMemoryRingHeader
+{
+    std::atomic<unsigned int> Magic;
+    unsigned int Version;
+    unsigned long long Capacity;
+    std::atomic<int> WriterLock;
+
+    // updated by writers
+    alignas(64) std::atomic<unsigned long long> Head;
+    std::atomic<int> DataDoorbell;
+    std::atomic<int> ReaderWaiting;
+
+    // updated by the reader
+    alignas(64) std::atomic<unsigned long long> Tail;
+    std::atomic<int> SpaceDoorbell;
+    std::atomic<int> WriterWaiting;
+};
+
+// each message starts with a record header, records are aligned on 8
+// bytes.  A wrap record fills the end of the buffer when a message
+// doesn't fit.
+struct osaSharedMemoryRingRecord
+{
+    unsigned int Length;
+    unsigned int Flags;
+};
+
+const unsigned int OSA_SHARED_MEMORY_RING_MAGIC = 0x63525347;  // "GSRc"
+const unsigned int OSA_SHARED_MEMORY_RING_VERSION = 1;
+const unsigned int OSA_SHARED_MEMORY_RING_WRAP = 1;
+const size_t OSA_SHARED_MEMORY_RING_HEADER_SIZE = (sizeof(osaSharedMemoryRingHeader) + 63) & ~static_cast<size_t>(63);
+
+static inline unsigned long long osaSharedMemoryRingAlign(const unsigned long long size)
+{
+    return (size + 7) & ~7ULL;
+}
+
+
+#if OSA_SHARED_MEMORY_RING_SUPPORTED
+
+static std::string osaSharedMemoryRingFullName(const std::string & name)
+{
+    if (!name.empty() && (name[0] == '/')) {
+        return name;
+    }
+    return "/" + name;
+}
+
+// wait until the doorbell changes from value or the deadline is
+// reached, returns false if the deadline has been reached
+static bool osaSharedMemoryRingWait(std::atomic<int> * doorbell, const int value, const double deadline)
+{
+    const double remaining = deadline - osaGetTime();
+    if (remaining <= 0.0) {
+        return false;
+    }
+#if OSA_SHARED_MEMORY_RING_USE_FUTEX
+    struct timespec timeout;
+    timeout.tv_sec = static_cast<time_t>(remaining);
+    timeout.tv_nsec = static_cast<long>((remaining - static_cast<double>(timeout.tv_sec)) * 1.0e9);
+    // not private, the futex is shared between processes
+    syscall(SYS_futex, reinterpret_cast<int *>(doorbell), FUTEX_WAIT, value, &timeout, 0, 0);
+#else
+    if (doorbell->load() == value) {
+        osaSleep((remaining < 100.0e-6) ? remaining : 100.0e-6);
+    }
+#endif
+    return true;
+}
+
+#if OSA_SHARED_MEMORY_RING_USE_FUTEX
+static void osaSharedMemoryRingWake(std::atomic<int> * doorbell)
+{
+    syscall(SYS_futex, reinterpret_cast<int *>(doorbell), FUTEX_WAKE, INT_MAX, 0, 0, 0);
+}
+#else
+// waiting threads poll the doorbell
+static void osaSharedMemoryRingWake(std::atomic<int> * CMN_UNUSED(doorbell))
+{
+}
+#endif
+
+#endif // OSA_SHARED_MEMORY_RING_SUPPORTED
+
+
+osaSharedMemoryRing::osaSharedMemoryRing(void):
+    Owner(false),
+    Header(0),
+    Data(0),
+    MappedSize(0),
+    ReservedPosition(0),
+    PeekedSize(0)
+{
+}
+
+
+osaSharedMemoryRing::~osaSharedMemoryRing()
+{
+    this->Close();
+}
+
+
+bool osaSharedMemoryRing::IsSupported(void)
+{
+    return (OSA_SHARED_MEMORY_RING_SUPPORTED != 0);
+}
+
+
+std::string osaSharedMemoryRing::GetUniqueName(const std::string & prefix)
+{
+    static std::atomic<unsigned int> counter(0);
+    std::stringstream name;
+    name << prefix;
+#if OSA_SHARED_MEMORY_RING_SUPPORTED
+    name << static_cast<long>(getpid()) << "-";
+#endif
+    name << counter.fetch_add(1);
+    return name.str();
+}
+
+
+bool osaSharedMemoryRing::Map(int fileDescriptor, size_t size)
+{
+#if OSA_SHARED_MEMORY_RING_SUPPORTED
+    void * address = mmap(0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+    close(fileDescriptor);
+    if (address == MAP_FAILED) {
+        CMN_LOG_INIT_ERROR << "osaSharedMemoryRing: failed to map \"" << this->Name << "\": "
+                           << strerror(errno) << std::endl;
+        return false;
+    }
+    this->Header = static_cast<osaSharedMemoryRingHeader *>(address);
+    this->Data = static_cast<char *>(address) + OSA_SHARED_MEMORY_RING_HEADER_SIZE;
+    this->MappedSize = size;
+    return true;
+#else
+    return false;
+#endif
+}
+
+
+bool osaSharedMemoryRing::Create(const std::string & name, size_t capacity)
+{
+    this->Close();
+#if OSA_SHARED_MEMORY_RING_SUPPORTED
+    this->Name = osaSharedMemoryRingFullName(name);
+    const unsigned long long dataSize = osaSharedMemoryRingAlign((capacity > 64) ? capacity : 64);
+    const size_t size = OSA_SHARED_MEMORY_RING_HEADER_SIZE + static_cast<size_t>(dataSize);
+    // remove segment left by a process that didn't close its ring
+    shm_unlink(this->Name.c_str());
+    const int fileDescriptor = shm_open(this->Name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (fileDescriptor < 0) {
+        CMN_LOG_INIT_ERROR << "osaSharedMemoryRing::Create: failed to create \"" << this->Name << "\": "
+                           << strerror(errno) << std::endl;
+        return false;
+    }
+    if (ftruncate(fileDescriptor, static_cast<off_t>(size)) != 0) {
+        CMN_LOG_INIT_ERROR << "osaSharedMemoryRing::Create: failed to resize \"" << this->Name << "\": "
+                           << strerror(errno) << std::endl;
+        close(fileDescriptor);
+        shm_unlink(this->Name.c_str());
+        return false;
+    }
+    if (!this->Map(fileDescriptor, size)) {
+        shm_unlink(this->Name.c_str());
+        return false;
+    }
+    this->Owner = true;
+    new (this->Header) osaSharedMemoryRingHeader;
+    this->Header->Version = OSA_SHARED_MEMORY_RING_VERSION;
+    this->Header->Capacity = dataSize;
+    this->Header->WriterLock.store(0);
+    this->Header->Head.store(0);
+    this->Header->DataDoorbell.store(0);
+    this->Header->ReaderWaiting.store(0);
+    this->Header->Tail.store(0);
+    this->Header->SpaceDoorbell.store(0);
+    this->Header->WriterWaiting.store(0);
+    // set last, Open checks the magic number
+    this->Header->Magic.store(OSA_SHARED_MEMORY_RING_MAGIC, std::memory_order_release);
+    return true;
+#else
+    CMN_LOG_INIT_ERROR << "osaSharedMemoryRing::Create: not supported on this platform, \"" << name << "\"" << std::endl;
+    return false;
+#endif
+}
+
+
+bool osaSharedMemoryRing::Open(const std::string & name)
+{
+    this->Close();
+#if OSA_SHARED_MEMORY_RING_SUPPORTED
+    this->Name = osaSharedMemoryRingFullName(name);
+    const int fileDescriptor = shm_open(this->Name.c_str(), O_RDWR, 0);
+    if (fileDescriptor < 0) {
+        CMN_LOG_INIT_WARNING << "osaSharedMemoryRing::Open: failed to open \"" << this->Name << "\": "
+                             << strerror(errno) << std::endl;
+        return false;
+    }
+    struct stat status;
+    if ((fstat(fileDescriptor, &status) != 0)
+        || (static_cast<size_t>(status.st_size) <= OSA_SHARED_MEMORY_RING_HEADER_SIZE)) {
+        CMN_LOG_INIT_ERROR << "osaSharedMemoryRing::Open: invalid segment \"" << this->Name << "\"" << std::endl;
+        close(fileDescriptor);
+        return false;
+    }
+    if (!this->Map(fileDescriptor, static_cast<size_t>(status.st_size))) {
+        return false;
+    }
+    if ((this->Header->Magic.load(std::memory_order_acquire) != OSA_SHARED_MEMORY_RING_MAGIC)
+        || (this->Header->Version != OSA_SHARED_MEMORY_RING_VERSION)
+        || (OSA_SHARED_MEMORY_RING_HEADER_SIZE + this->Header->Capacity > this->MappedSize)) {
+        CMN_LOG_INIT_ERROR << "osaSharedMemoryRing::Open: \"" << this->Name
+                           << "\" is not initialized or has an incompatible version" << std::endl;
+        this->Close();
+        return false;
+    }
+    return true;
+#else
+    CMN_LOG_INIT_ERROR << "osaSharedMemoryRing::Open: not supported on this platform, \"" << name << "\"" << std::endl;
+    return false;
+#endif
+}
+
+
+void osaSharedMemoryRing::Close(void)
+{
+#if OSA_SHARED_MEMORY_RING_SUPPORTED
+    if (this->Header) {
+        munmap(this->Header, this->MappedSize);
+        if (this->Owner) {
+            shm_unlink(this->Name.c_str());
+        }
+    }
+#endif
+    this->Owner = false;
+    this->Header = 0;
+    this->Data = 0;
+    this->MappedSize = 0;
+    this->ReservedPosition = 0;
+    this->PeekedSize = 0;
+}
+
+
+size_t osaSharedMemoryRing::GetMaximumMessageSize(void) const
+{
+    if (!this->Header) {
+        return 0;
+    }
+    // a message might need the end of the buffer for a wrap record
+    return static_cast<size_t>(this->Header->Capacity / 2 - sizeof(osaSharedMemoryRingRecord));
+}
+
+
+char * osaSharedMemoryRing::Reserve(size_t length, double timeoutSec)
+{
+#if OSA_SHARED_MEMORY_RING_SUPPORTED
+    if (!this->Header || (length > this->GetMaximumMessageSize())) {
+        return 0;
+    }
+    osaSharedMemoryRingHeader * header = this->Header;
+    const double deadline = osaGetTime() + timeoutSec;
+    while (header->WriterLock.exchange(1, std::memory_order_acquire) != 0) {
+        if (osaGetTime() > deadline) {
+            return 0;
+        }
+        osaSleep(10.0e-6);
+    }
+
+    const unsigned long long capacity = header->Capacity;
+    const unsigned long long needed = osaSharedMemoryRingAlign(sizeof(osaSharedMemoryRingRecord) + length);
+    const unsigned long long head = header->Head.load(std::memory_order_relaxed);
+    const unsigned long long contiguous = capacity - (head % capacity);
+    const unsigned long long total = (contiguous < needed) ? (contiguous + needed) : needed;
+    while (capacity - (head - header->Tail.load(std::memory_order_acquire)) < total) {
+        const int doorbell = header->SpaceDoorbell.load();
+        header->WriterWaiting.store(1);
+        const bool full = (capacity - (head - header->Tail.load()) < total);
+        if (full && !osaSharedMemoryRingWait(&(header->SpaceDoorbell), doorbell, deadline)) {
+            header->WriterWaiting.store(0);
+            header->WriterLock.store(0, std::memory_order_release);
+            return 0;
+        }
+        header->WriterWaiting.store(0);
+    }
+
+    this->ReservedPosition = head;
+    if (contiguous < needed) {
+        osaSharedMemoryRingRecord * wrap = reinterpret_cast<osaSharedMemoryRingRecord *>(this->Data + (head % capacity));
+        wrap->Length = 0;
+        wrap->Flags = OSA_SHARED_MEMORY_RING_WRAP;
+        this->ReservedPosition = head + contiguous;
+    }
+    return this->Data + (this->ReservedPosition % capacity) + sizeof(osaSharedMemoryRingRecord);
+#else
+    return 0;
+#endif
+}
+
+
+void osaSharedMemoryRing::Commit(size_t length)
+{
+#if OSA_SHARED_MEMORY_RING_SUPPORTED
+    CMN_ASSERT(this->Header);
+    osaSharedMemoryRingHeader * header = this->Header;
+    osaSharedMemoryRingRecord * record =
+        reinterpret_cast<osaSharedMemoryRingRecord *>(this->Data + (this->ReservedPosition % header->Capacity));
+    record->Length = static_cast<unsigned int>(length);
+    record->Flags = 0;
+    header->Head.store(this->ReservedPosition + osaSharedMemoryRingAlign(sizeof(osaSharedMemoryRingRecord) + length));
+    header->DataDoorbell.fetch_add(1);
+    if (header->ReaderWaiting.load() != 0) {
+        osaSharedMemoryRingWake(&(header->DataDoorbell));
+    }
+    header->WriterLock.store(0, std::memory_order_release);
+#else
+#endif
+}
+
+
+void osaSharedMemoryRing::Cancel(void)
+{
+#if OSA_SHARED_MEMORY_RING_SUPPORTED
+    CMN_ASSERT(this->Header);
+    // a wrap record written by Reserve is beyond head, readers ignore it
+    this->Header->WriterLock.store(0, std::memory_order_release);
+#endif
+}
+
+
+bool osaSharedMemoryRing::Send(const char * data, size_t length, double timeoutSec)
+{
+    char * buffer = this->Reserve(length, timeoutSec);
+    if (!buffer) {
+        return false;
+    }
+    memcpy(buffer, data, length);
+    this->Commit(length);
+    return true;
+}
+
+
+const char * osaSharedMemoryRing::Peek(size_t & length, double timeoutSec)
+{
+#if OSA_SHARED_MEMORY_RING_SUPPORTED
+    if (!this->Header) {
+        return 0;
+    }
+    osaSharedMemoryRingHeader * header = this->Header;
+    const unsigned long long capacity = header->Capacity;
+    const double deadline = osaGetTime() + timeoutSec;
+    while (true) {
+        const unsigned long long tail = header->Tail.load(std::memory_order_relaxed);
+        if (header->Head.load(std::memory_order_acquire) != tail) {
+            const osaSharedMemoryRingRecord * record =
+                reinterpret_cast<const osaSharedMemoryRingRecord *>(this->Data + (tail % capacity));
+            if (record->Flags & OSA_SHARED_MEMORY_RING_WRAP) {
+                // skip to the beginning of the buffer
+                header->Tail.store(tail + (capacity - (tail % capacity)));
+                header->SpaceDoorbell.fetch_add(1);
+                if (header->WriterWaiting.load() != 0) {
+                    osaSharedMemoryRingWake(&(header->SpaceDoorbell));
+                }
+                continue;
+            }
+            length = record->Length;
+            this->PeekedSize = osaSharedMemoryRingAlign(sizeof(osaSharedMemoryRingRecord) + length);
+            return reinterpret_cast<const char *>(record + 1);
+        }
+        const int doorbell = header->DataDoorbell.load();
+        header->ReaderWaiting.store(1);
+        const bool empty = (header->Head.load() == tail);
+        if (empty && !osaSharedMemoryRingWait(&(header->DataDoorbell), doorbell, deadline)) {
+            header->ReaderWaiting.store(0);
+            return 0;
+        }
+        header->ReaderWaiting.store(0);
+    }
+#else
+    return 0;
+#endif
+}
+
+
+void osaSharedMemoryRing::Release(void)
+{
+#if OSA_SHARED_MEMORY_RING_SUPPORTED
+    if (!this->Header || (this->PeekedSize == 0)) {
+        return;
+    }
+    osaSharedMemoryRingHeader * header = this->Header;
+    header->Tail.store(header->Tail.load(std::memory_order_relaxed) + this->PeekedSize);
+    this->PeekedSize = 0;
+    header->SpaceDoorbell.fetch_add(1);
+    if (header->WriterWaiting.load() != 0) {
+        osaSharedMemoryRingWake(&(header->SpaceDoorbell));
+    }
+#endif
+}
+
+
+bool osaSharedMemoryRing::Receive(std::string & message, double timeoutSec)
+{
+    size_t length;
+    const char * data = this->Peek(length, timeoutSec);
+    if (!data) {
+        return false;
+    }
+    message.assign(data, length);
+    this->Release();
+    return true;
+}
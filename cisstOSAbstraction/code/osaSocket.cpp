@@ -6,7 +6,7 @@
 Author(s):  Peter Kazanzides
 Created on: 2009
 
-(C) Copyright 2007-2015 Johns Hopkins University (JHU), All Rights Reserved.
+(C) Copyright 2007-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -18,6 +18,7 @@ http://www.cisst.org/cisst/license.txt.
 */
 
 #include <cisstOSAbstraction/osaSocket.h>
+#include <cisstCommon/cmnDataBinaryWriter.h>
 
 #if (CISST_OS == CISST_WINDOWS)
 #define WIN32_LEAN_AND_MEAN
@@ -30,6 +31,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <netinet/in.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h> // for sendmsg
 #include <errno.h>
 #include <string.h>  // for memset
 #include <unistd.h> // for gethostname
@@ -528,6 +530,89 @@ int osaSocket::Send(const std::string & bufsend, double timeoutSec)
     return Send(bufsend.data(), static_cast<int>(bufsend.length()), timeoutSec);
 }
 
+int osaSocket::Send(const cmnDataBinaryWriter & writer, double timeoutSec)
+{
+#if (CISST_OS == CISST_WINDOWS)
+    std::string buffer;
+    writer.ToString(buffer);
+    return Send(buffer, timeoutSec);
+#else
+    // maximum number of segments sent per call to sendmsg
+    const size_t maxSegments = 64;
+
+    const cmnDataBinaryWriter::SegmentsType & segments = writer.GetSegments();
+    // a datagram can't be sent in multiple calls
+    if ((SocketType == UDP) && (segments.size() > maxSegments)) {
+        std::string buffer;
+        writer.ToString(buffer);
+        return Send(buffer, timeoutSec);
+    }
+
+    if (!Connected && (SocketType == TCP)) {
+        CMN_LOG_CLASS_RUN_WARNING << "Send: Not Connected " << std::endl;
+        return -1;
+    }
+
+    fd_set writefds;
+    FD_ZERO(&writefds);
+    FD_SET(SocketFD, &writefds);
+    time_t sec = static_cast<time_t>(floor(timeoutSec));
+    suseconds_t usec = static_cast<suseconds_t>((timeoutSec - sec) * 1e6);
+    timeval timeout = { sec, usec };
+    if (select(SocketFD + 1, NULL, &writefds, NULL, &timeout) == SOCKET_ERROR) {
+        CMN_LOG_CLASS_RUN_ERROR << "Send: failed to send because socket is not ready " << SocketFD << " Error: " << errno << std::endl;
+        if (SocketType == TCP) {
+            Close();
+        }
+        return -1;
+    }
+
+    struct iovec vectors[maxSegments];
+    struct msghdr message;
+    memset(&message, 0, sizeof(message));
+    if (SocketType == UDP) {
+        message.msg_name = &SERVER_ADDR;
+        message.msg_namelen = sizeof(SERVER_ADDR);
+    }
+    message.msg_iov = vectors;
+
+    int numSent = 0;
+    size_t index = 0;
+    const size_t numberOfSegments = segments.size();
+    while (index < numberOfSegments) {
+        size_t numberOfVectors = 0;
+        size_t expected = 0;
+        for (; (index < numberOfSegments) && (numberOfVectors < maxSegments); ++index, ++numberOfVectors) {
+            vectors[numberOfVectors].iov_base = const_cast<char *>(segments[index].Data);
+            vectors[numberOfVectors].iov_len = segments[index].Size;
+            expected += segments[index].Size;
+        }
+        message.msg_iovlen = numberOfVectors;
+        const ssize_t retval = sendmsg(SocketFD, &message, 0);
+        if (retval == SOCKET_ERROR) {
+            if (errno == EWOULDBLOCK) {
+                CMN_LOG_CLASS_RUN_WARNING << "Send: failed to send the whole message, missing "
+                                          << writer.GetSize() - numSent << " bytes" << std::endl;
+                return numSent;
+            }
+            CMN_LOG_CLASS_RUN_ERROR << "Send: failed to send with Error: " << errno << std::endl;
+            if (SocketType == TCP) {
+                Close();
+            }
+            return -1;
+        }
+        numSent += static_cast<int>(retval);
+        if (static_cast<size_t>(retval) != expected) {
+            CMN_LOG_CLASS_RUN_WARNING << "Send: failed to send the whole message, missing "
+                                      << writer.GetSize() - numSent << " bytes" << std::endl;
+            return numSent;
+        }
+    }
+    CMN_LOG_CLASS_RUN_DEBUG << "Send: sent " << numSent << " bytes" << std::endl;
+    return numSent;
+#endif
+}
+
 int osaSocket::SendAsPackets(const char * bufsend, unsigned int msglen, unsigned int packetSize, double timeoutSec)
 {
     unsigned int nPackets = 1 + (msglen-1)/packetSize;
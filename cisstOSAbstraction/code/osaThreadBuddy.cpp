@@ -6,7 +6,7 @@
   Author(s): Ankur Kapoor, Min Yang Jung
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2010 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -54,6 +54,11 @@ http://www.cisst.org/cisst/license.txt.
     #include <sys/time.h>
     #include <sys/select.h>
     #include <unistd.h>
+#if (CISST_OS == CISST_LINUX)
+    #include <time.h> // for clock_nanosleep
+    #include <errno.h>
+    #include <string.h> // for strerror
+#endif
 #endif
 
 #if (CISST_OS == CISST_LINUX_RTAI)
@@ -256,11 +261,31 @@ struct osaThreadBuddyInternals {
 #else
     struct timeval DueTime;
     char Name[6];
+#if (CISST_OS == CISST_LINUX)
+    // absolute time of the next wake up on CLOCK_MONOTONIC, in
+    // nanoseconds.  0 until first call to WaitForRemainingPeriod
+    long long NextWakeTime;
+#endif
 #endif // end of others
 };
 
+#if (CISST_OS == CISST_LINUX)
+static inline long long osaThreadBuddyMonotonicTime(void)
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return static_cast<long long>(now.tv_sec) * 1000000000LL + now.tv_nsec;
+}
+#endif
+
 // Constructor. Allocates memory for thread buddy internal data.
-osaThreadBuddy::osaThreadBuddy() {
+osaThreadBuddy::osaThreadBuddy():
+    Period(0.0),
+    CatchUpPolicy(CATCH_UP_SKIP),
+    NumberOfOverruns(0),
+    NumberOfSkippedPeriods(0),
+    MaximumLateness(0.0)
+{
     Data = new osaThreadBuddyInternals;
 }
 
@@ -294,6 +319,7 @@ void osaThreadBuddy::Create(const char *name, const osaAbsoluteTime& tv, int CMN
    
     Period = tv.sec*1000000000 + tv.nsec;
     Data->IsSuspended = false;
+    ResetOverrunCounters();
 
 #if (CISST_OS == CISST_LINUX_RTAI)
     // nam2num converts the character string 'name' to a long, using just the first
@@ -388,6 +414,9 @@ void osaThreadBuddy::Create(const char *name, const osaAbsoluteTime& tv, int CMN
 #else // default unix
     Data->DueTime.tv_sec = 0;
     Data->DueTime.tv_usec = 0;
+#if (CISST_OS == CISST_LINUX)
+    Data->NextWakeTime = 0;
+#endif
     for (unsigned int i = 0; i < sizeof(Data->Name); i++) Data->Name[i] = name[i];
     Data->Name[sizeof(Data->Name)-1] = 0;
 #endif    
@@ -480,6 +509,10 @@ void osaThreadBuddy::WaitForRemainingPeriod(void)
         unsigned long overruns=0;
         int retval = 0;
         retval = rt_task_wait_period( &overruns );
+        if (overruns > 0) {
+            NumberOfOverruns++;
+            NumberOfSkippedPeriods += overruns;
+        }
 
         if( retval != 0 ){            
             std::string errstr;
@@ -566,6 +599,69 @@ void osaThreadBuddy::WaitForRemainingPeriod(void)
     struct _pulse pulse;
     MsgReceivePulse( Data->chid, &pulse, sizeof(pulse), NULL );
 
+#elif (CISST_OS == CISST_LINUX)
+    if (!IsPeriodic()) {
+        return;
+    }
+    const long long period = static_cast<long long>(Period);
+    long long now = osaThreadBuddyMonotonicTime();
+    if (Data->NextWakeTime == 0) {
+        // first call, start first period now
+        Data->NextWakeTime = now;
+    }
+    do {
+        // deadlines are computed from the previous deadline, not from
+        // the time the thread woke up, to avoid drifting
+        Data->NextWakeTime += period;
+        if (now >= Data->NextWakeTime) {
+            const long long lateness = now - Data->NextWakeTime;
+            NumberOfOverruns++;
+            if (lateness * 1.0e-9 > MaximumLateness) {
+                MaximumLateness = lateness * 1.0e-9;
+            }
+            // when suspended we need to wait, burst would spin
+            CatchUpPolicyType policy = CatchUpPolicy;
+            if (Data->IsSuspended && (policy == CATCH_UP_BURST)) {
+                policy = CATCH_UP_SKIP;
+            }
+            switch (policy) {
+            case CATCH_UP_SKIP:
+                {
+                    // move to first deadline in the future
+                    const long long missed = lateness / period + 1;
+                    Data->NextWakeTime += missed * period;
+                    NumberOfSkippedPeriods += missed;
+                }
+                break;
+            case CATCH_UP_BURST:
+                // run next period right away, deadlines are unchanged
+                return;
+            case CATCH_UP_REALIGN:
+                // next period starts now
+                Data->NextWakeTime = now;
+                if (!Data->IsSuspended) {
+                    return;
+                }
+                Data->NextWakeTime += period;
+                break;
+            }
+        }
+        struct timespec wakeTime;
+        wakeTime.tv_sec = static_cast<time_t>(Data->NextWakeTime / 1000000000LL);
+        wakeTime.tv_nsec = static_cast<long>(Data->NextWakeTime % 1000000000LL);
+        int retval;
+        do {
+            retval = clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wakeTime, 0);
+        } while (retval == EINTR);
+        if (retval != 0) {
+            CMN_LOG_RUN_ERROR << CMN_LOG_DETAILS
+                              << "clock_nanosleep failed. "
+                              << strerror(retval) << ": " << retval
+                              << std::endl;
+        }
+        now = osaThreadBuddyMonotonicTime();
+    } while (Data->IsSuspended);
+
 #else // default unix
     if (!IsPeriodic()) {
         return;
@@ -597,6 +693,38 @@ void osaThreadBuddy::WaitForRemainingPeriod(void)
 #endif
 }
 
+void osaThreadBuddy::SetCatchUpPolicy(const CatchUpPolicyType policy)
+{
+    CatchUpPolicy = policy;
+}
+
+osaThreadBuddy::CatchUpPolicyType osaThreadBuddy::GetCatchUpPolicy(void) const
+{
+    return CatchUpPolicy;
+}
+
+unsigned long long osaThreadBuddy::GetNumberOfOverruns(void) const
+{
+    return NumberOfOverruns;
+}
+
+unsigned long long osaThreadBuddy::GetNumberOfSkippedPeriods(void) const
+{
+    return NumberOfSkippedPeriods;
+}
+
+double osaThreadBuddy::GetMaximumLateness(void) const
+{
+    return MaximumLateness;
+}
+
+void osaThreadBuddy::ResetOverrunCounters(void)
+{
+    NumberOfOverruns = 0;
+    NumberOfSkippedPeriods = 0;
+    MaximumLateness = 0.0;
+}
+
 void osaThreadBuddy::MakeHardRealTime(void) 
 {
 #if (CISST_OS == CISST_LINUX_RTAI)
@@ -7,7 +7,7 @@
              Min Yang Jung
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2012 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -22,6 +22,22 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstCommon/cmnPortability.h>
 #include <cisstOSAbstraction/osaThreadSignal.h>
 #include <cisstOSAbstraction/osaThread.h>
+#include <cisstOSAbstraction/osaConfig.h>
+#include <cisstOSAbstraction/osaCPUAffinity.h>
+
+#include <atomic>
+
+// futex is only used for plain Linux, RTAI and Xenomai rely on pthread
+#if (CISST_OS == CISST_LINUX) && CISST_OSA_HAS_FUTEX
+#define OSA_THREAD_SIGNAL_USE_FUTEX 1
+#include <climits>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#else
+#define OSA_THREAD_SIGNAL_USE_FUTEX 0
+#endif
 
 #if (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS) || (CISST_OS == CISST_QNX)
 //PK: Probably some of these include files are not needed
@@ -224,7 +240,15 @@ struct osaThreadSignalInternals
     HANDLE hEvent;
 #endif
 
-#if (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS) || (CISST_OS == CISST_QNX)
+#if OSA_THREAD_SIGNAL_USE_FUTEX
+    // futex word, bit 0 is set when the signal is raised, other bits
+    // are a sequence number incremented by each Raise
+    std::atomic<int> State;
+    // number of threads blocked (or about to block) on the futex
+    std::atomic<int> NumberOfWaiters;
+    // running average of spin iterations needed by successful spins
+    std::atomic<unsigned int> SpinEstimate;
+#elif (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS) || (CISST_OS == CISST_QNX)
     pthread_mutex_t gnuMutex;
     pthread_cond_t gnuCondition;
     int ConditionState;
@@ -239,8 +263,43 @@ struct osaThreadSignalInternals
     int ConditionState;
 #endif
 
+    std::atomic<unsigned int> SpinCount;
+    std::atomic<unsigned long long> NumberOfSpins;
+    std::atomic<unsigned long long> NumberOfSleeps;
+    std::atomic<unsigned long long> NumberOfWakeups;
 };
 
+
+#if OSA_THREAD_SIGNAL_USE_FUTEX
+
+static inline int osaThreadSignalFutex(std::atomic<int> * address, int operation, int value,
+                                       const struct timespec * timeout)
+{
+    // std::atomic<int> is lock-free and has the same representation as int
+    return static_cast<int>(syscall(SYS_futex, reinterpret_cast<int *>(address),
+                                    operation | FUTEX_PRIVATE_FLAG, value, timeout,
+                                    0, FUTEX_BITSET_MATCH_ANY));
+}
+
+static inline void osaThreadSignalCPURelax(void)
+{
+#if defined(__i386__) || defined(__x86_64__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    __asm__ __volatile__("yield");
+#else
+    __asm__ __volatile__("" ::: "memory");
+#endif
+}
+
+// clear the raised bit, keeps the sequence number
+static inline void osaThreadSignalReset(osaThreadSignalInternals * internals)
+{
+    internals->State.fetch_and(~1, std::memory_order_acq_rel);
+}
+
+#endif // OSA_THREAD_SIGNAL_USE_FUTEX
+
 static osaThreadId CallbackThreadId;
 
 void (*osaThreadSignal::PreCallback)(void) = 0;
@@ -252,14 +311,22 @@ void (*osaThreadSignal::PostCallback)(void) = 0;
 
 osaThreadSignal::osaThreadSignal()
 {
-    this->Internals = new osaThreadSignalInternals;
-    memset(Internals, 0, sizeof(*Internals));
+    // value initialization sets all members to 0
+    this->Internals = new osaThreadSignalInternals();
+
+    // spinning only makes sense if the thread raising the signal can
+    // run while we spin
+    Internals->SpinCount = (osaCPUGetCount() > 1) ? 100 : 0;
 
 #if (CISST_OS == CISST_WINDOWS)
 	Internals->hEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
 #endif
 
-#if (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS) || (CISST_OS == CISST_QNX)
+#if OSA_THREAD_SIGNAL_USE_FUTEX
+    Internals->State = 0;
+    Internals->NumberOfWaiters = 0;
+    Internals->SpinEstimate = 0;
+#elif (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS) || (CISST_OS == CISST_QNX)
     int retval = pthread_mutex_init(&(Internals->gnuMutex), 0);
     if( retval != 0 ) {
         CMN_LOG_INIT_ERROR << CMN_LOG_DETAILS
@@ -331,7 +398,9 @@ osaThreadSignal::~osaThreadSignal()
 	CloseHandle(Internals->hEvent);
 #endif
 
-#if (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS) || (CISST_OS == CISST_QNX)
+#if OSA_THREAD_SIGNAL_USE_FUTEX
+    // nothing to release
+#elif (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS) || (CISST_OS == CISST_QNX)
     int retval = pthread_cond_destroy(&(Internals->gnuCondition));
     if( retval != 0 ) {
         CMN_LOG_INIT_ERROR << CMN_LOG_DETAILS
@@ -399,7 +468,27 @@ void osaThreadSignal::Raise(void)
     ::SetEvent(Internals->hEvent);
 #endif
 
-#if (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS) || (CISST_OS == CISST_QNX)
+#if OSA_THREAD_SIGNAL_USE_FUTEX
+    // set raised bit and increment sequence number in one step so
+    // waiters can't miss the transition
+    int state = Internals->State.load(std::memory_order_relaxed);
+    int newState;
+    do {
+        newState = static_cast<int>((static_cast<unsigned int>(state) + 2u) | 1u);
+    } while (!Internals->State.compare_exchange_weak(state, newState,
+                                                     std::memory_order_seq_cst,
+                                                     std::memory_order_relaxed));
+    // avoid system call if no thread is blocked, seq_cst pairs with
+    // waiters incrementing the counter before checking the state
+    if (Internals->NumberOfWaiters.load(std::memory_order_seq_cst) > 0) {
+        if (osaThreadSignalFutex(&(Internals->State), FUTEX_WAKE, INT_MAX, 0) == -1) {
+            CMN_LOG_INIT_ERROR << CMN_LOG_DETAILS
+                               << "futex wake failed. "
+                               << strerror(errno) << ": " << errno
+                               << std::endl;
+        }
+    }
+#elif (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS) || (CISST_OS == CISST_QNX)
     int retval = pthread_mutex_lock(&(Internals->gnuMutex));
     if( retval != 0 ) {
         CMN_LOG_INIT_ERROR << CMN_LOG_DETAILS
@@ -531,17 +620,110 @@ bool osaThreadSignal::Wait(double timeoutInSec)
     if (do_callback) {
         PreCallback();
     }
+#if !OSA_THREAD_SIGNAL_USE_FUTEX
     unsigned int millisec = (unsigned int)(timeoutInSec * 1000);
+#endif
 #if (CISST_OS == CISST_WINDOWS)
+    Internals->NumberOfSleeps.fetch_add(1, std::memory_order_relaxed);
     if (WaitForSingleObject(Internals->hEvent, millisec) == WAIT_TIMEOUT) {
         if (do_callback) {
             PostCallback();
         }
         return false;
     }
+    Internals->NumberOfWakeups.fetch_add(1, std::memory_order_relaxed);
 #endif
 
-#if (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS) || (CISST_OS == CISST_QNX)
+#if OSA_THREAD_SIGNAL_USE_FUTEX
+    int state = Internals->State.load(std::memory_order_acquire);
+    // signal already raised, consume it
+    while (state & 1) {
+        if (Internals->State.compare_exchange_weak(state, state & ~1,
+                                                  std::memory_order_acq_rel,
+                                                  std::memory_order_acquire)) {
+            if (do_callback) {
+                PostCallback();
+            }
+            return true;
+        }
+    }
+
+    // spin phase, limit is adapted based on previous successful spins
+    // (same heuristic as glibc adaptive mutexes)
+    const unsigned int spinCount = Internals->SpinCount.load(std::memory_order_relaxed);
+    if (spinCount > 0) {
+        const unsigned int estimate = Internals->SpinEstimate.load(std::memory_order_relaxed);
+        unsigned int spinLimit = 2 * estimate + 10;
+        if (spinLimit > spinCount) {
+            spinLimit = spinCount;
+        }
+        unsigned int spin = 0;
+        bool raised = false;
+        while (spin < spinLimit) {
+            if (Internals->State.load(std::memory_order_acquire) != state) {
+                raised = true;
+                break;
+            }
+            osaThreadSignalCPURelax();
+            ++spin;
+        }
+        const int delta = (static_cast<int>(spin) - static_cast<int>(estimate)) / 8;
+        Internals->SpinEstimate.store(static_cast<unsigned int>(static_cast<int>(estimate) + delta),
+                                      std::memory_order_relaxed);
+        if (raised) {
+            Internals->NumberOfSpins.fetch_add(1, std::memory_order_relaxed);
+            osaThreadSignalReset(Internals);
+            if (do_callback) {
+                PostCallback();
+            }
+            return true;
+        }
+    }
+
+    // absolute deadline so interruptions don't extend the timeout
+    struct timespec deadline;
+    clock_gettime(CLOCK_MONOTONIC, &deadline);
+    double deadlineSeconds;
+    const double deadlineFraction = modf(timeoutInSec, &deadlineSeconds);
+    deadline.tv_sec += static_cast<time_t>(deadlineSeconds);
+    deadline.tv_nsec += static_cast<long>(deadlineFraction * 1.0e9);
+    while (deadline.tv_nsec >= 1000000000L) {
+        ++deadline.tv_sec;
+        deadline.tv_nsec -= 1000000000L;
+    }
+
+    bool timedOut = false;
+    Internals->NumberOfWaiters.fetch_add(1, std::memory_order_seq_cst);
+    while (Internals->State.load(std::memory_order_seq_cst) == state) {
+        Internals->NumberOfSleeps.fetch_add(1, std::memory_order_relaxed);
+        // FUTEX_WAIT_BITSET uses an absolute timeout on CLOCK_MONOTONIC
+        if (osaThreadSignalFutex(&(Internals->State), FUTEX_WAIT_BITSET, state, &deadline) == -1) {
+            if (errno == ETIMEDOUT) {
+                timedOut = (Internals->State.load(std::memory_order_seq_cst) == state);
+                break;
+            }
+            if ((errno != EINTR) && (errno != EAGAIN)) {
+                CMN_LOG_INIT_ERROR << CMN_LOG_DETAILS
+                                   << "futex wait failed. "
+                                   << strerror(errno) << ": " << errno
+                                   << std::endl;
+                timedOut = true;
+                break;
+            }
+        }
+    }
+    Internals->NumberOfWaiters.fetch_sub(1, std::memory_order_seq_cst);
+
+    if (timedOut) {
+        if (do_callback) {
+            PostCallback();
+        }
+        return false;
+    }
+    Internals->NumberOfWakeups.fetch_add(1, std::memory_order_relaxed);
+    osaThreadSignalReset(Internals);
+
+#elif (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS) || (CISST_OS == CISST_QNX)
     int retval = pthread_mutex_lock(&(Internals->gnuMutex));
     if( retval != 0 ) {
         CMN_LOG_INIT_ERROR << CMN_LOG_DETAILS
@@ -581,6 +763,7 @@ bool osaThreadSignal::Wait(double timeoutInSec)
         timeout.tv_sec = sec;
         timeout.tv_nsec = usec * 1000;
 #endif
+        Internals->NumberOfSleeps.fetch_add(1, std::memory_order_relaxed);
         ret = pthread_cond_timedwait(&(Internals->gnuCondition), &(Internals->gnuMutex), &timeout);
 
         if (ret == ETIMEDOUT) {
@@ -596,6 +779,7 @@ bool osaThreadSignal::Wait(double timeoutInSec)
             }
             return false;
         }
+        Internals->NumberOfWakeups.fetch_add(1, std::memory_order_relaxed);
     }
 
     // AUTOMATIC RESET:
@@ -712,6 +896,7 @@ bool osaThreadSignal::Wait(double timeoutInSec)
         timeout.tv_sec = sec;
         timeout.tv_nsec = usec * 1000;
 
+        Internals->NumberOfSleeps.fetch_add(1, std::memory_order_relaxed);
         ret = pthread_cond_timedwait(&(Internals->gnuCondition), &(Internals->gnuMutex), &timeout);
 
         if (ret == ETIMEDOUT) {
@@ -727,6 +912,7 @@ bool osaThreadSignal::Wait(double timeoutInSec)
             }
             return false;
         }
+        Internals->NumberOfWakeups.fetch_add(1, std::memory_order_relaxed);
     }
 
     // AUTOMATIC RESET:
@@ -773,7 +959,12 @@ void osaThreadSignal::ToStream(std::ostream & outputStream) const
 #if (CISST_OS == CISST_WINDOWS)
     outputStream << "handle = " << Internals->hEvent << std::endl;
 #endif
-#if (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS) || (CISST_OS == CISST_QNX)
+#if OSA_THREAD_SIGNAL_USE_FUTEX
+    outputStream << "condition_state = " << (Internals->State.load() & 1)
+                 << ", spins = " << GetNumberOfSpins()
+                 << ", sleeps = " << GetNumberOfSleeps()
+                 << ", wakeups = " << GetNumberOfWakeups() << std::endl;
+#elif (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_DARWIN) || (CISST_OS == CISST_SOLARIS) || (CISST_OS == CISST_QNX)
     outputStream << "condition_state = " << Internals->ConditionState << std::endl;
 #endif
 #if (CISST_OS == CISST_LINUX_XENOMAI)
@@ -788,3 +979,41 @@ void osaThreadSignal::SetWaitCallbacks(const osaThreadId &threadId, void (*pre)(
     PreCallback = pre;
     PostCallback = post;
 }
+
+
+void osaThreadSignal::SetSpinCount(unsigned int spinCount)
+{
+    Internals->SpinCount.store(spinCount, std::memory_order_relaxed);
+}
+
+
+unsigned int osaThreadSignal::GetSpinCount(void) const
+{
+    return Internals->SpinCount.load(std::memory_order_relaxed);
+}
+
+
+unsigned long long osaThreadSignal::GetNumberOfSpins(void) const
+{
+    return Internals->NumberOfSpins.load(std::memory_order_relaxed);
+}
+
+
+unsigned long long osaThreadSignal::GetNumberOfSleeps(void) const
+{
+    return Internals->NumberOfSleeps.load(std::memory_order_relaxed);
+}
+
+
+unsigned long long osaThreadSignal::GetNumberOfWakeups(void) const
+{
+    return Internals->NumberOfWakeups.load(std::memory_order_relaxed);
+}
+
+
+void osaThreadSignal::ResetCounters(void)
+{
+    Internals->NumberOfSpins.store(0, std::memory_order_relaxed);
+    Internals->NumberOfSleeps.store(0, std::memory_order_relaxed);
+    Internals->NumberOfWakeups.store(0, std::memory_order_relaxed);
+}
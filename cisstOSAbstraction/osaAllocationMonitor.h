@@ -0,0 +1,208 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Declaration of osaAllocationMonitor
+  \ingroup cisstOSAbstraction
+ */
+
+#ifndef _osaAllocationMonitor_h
+#define _osaAllocationMonitor_h
+
+#include <cisstCommon/cmnPortability.h>
+#include <cisstOSAbstraction/osaConfig.h>
+
+#include <atomic>
+#include <string>
+#include <iostream>
+
+// Always include last
+#include <cisstOSAbstraction/osaExport.h>
+
+/*!
+  \brief Heap allocation detector for real-time sections
+
+  Counts the heap allocations and deallocations performed by a thread
+  between Begin and End, i.e. in a section of code which should not
+  use the heap such as the body of a real-time loop.  For each
+  allocation, the call stack is recorded and identical call stacks
+  are aggregated so the call sites can be displayed using ToStream.
+
+  Allocations are detected by replacing the global operators new and
+  delete (no LD_PRELOAD needed).  This has to be enabled at compile
+  time with the CMake option CISST_OSA_ALLOCATION_MONITOR, see
+  IsAvailable.  Memory allocated with malloc directly is not counted.
+  Call stacks are only recorded on platforms providing backtrace
+  (glibc and Mac OS).
+
+  Begin, End and the recording are performed by the monitored thread
+  without locks nor allocations.  Other threads can read the counters
+  and call sites at any time.
+
+  \code
+  osaAllocationMonitor monitor("loop");
+  while (running) {
+      monitor.Begin();
+      ComputeControl();
+      monitor.End();
+  }
+  std::cout << monitor << std::endl;
+  \endcode
+*/
+class CISST_EXPORT osaAllocationMonitor
+{
+public:
+    enum {MAXIMUM_NUMBER_OF_CALL_SITES = 32, MAXIMUM_NUMBER_OF_FRAMES = 16};
+
+    /*! Call stack of allocations within the section, identical call
+      stacks share the same call site. */
+    struct CallSite {
+        std::atomic<bool> Used;
+        std::atomic<unsigned long long> NumberOfAllocations;
+        std::atomic<unsigned long long> NumberOfBytes;
+        int NumberOfFrames;
+        void * Frames[MAXIMUM_NUMBER_OF_FRAMES];
+    };
+
+protected:
+    std::string Name;
+    std::atomic<unsigned long long> NumberOfSections;
+    std::atomic<unsigned long long> NumberOfSectionsWithAllocations;
+    std::atomic<unsigned long long> NumberOfAllocations;
+    std::atomic<unsigned long long> NumberOfDeallocations;
+    std::atomic<unsigned long long> NumberOfBytes;
+    std::atomic<unsigned long long> NumberOfUnrecordedAllocations;
+
+    /*! Number of allocations when Begin was called, used to count
+      sections with allocations */
+    unsigned long long AllocationsAtBegin;
+
+    CallSite CallSites[MAXIMUM_NUMBER_OF_CALL_SITES];
+
+    /*! Monitor active on the calling thread before Begin, restored by
+      End */
+    osaAllocationMonitor * Previous;
+
+private:
+    /*! Private copy constructor to prevent copies */
+    osaAllocationMonitor(const osaAllocationMonitor & other);
+    osaAllocationMonitor & operator = (const osaAllocationMonitor & other);
+
+public:
+    osaAllocationMonitor(const std::string & name);
+
+    ~osaAllocationMonitor();
+
+    inline const std::string & GetName(void) const {
+        return this->Name;
+    }
+
+    /*! Check if the global operators new and delete have been
+      replaced, i.e. cisst was compiled with the CMake option
+      CISST_OSA_ALLOCATION_MONITOR.  If not, Begin and End can be
+      used but no allocation is ever detected. */
+    static bool IsAvailable(void);
+
+    /*! Start monitoring allocations performed by the calling thread */
+    void Begin(void);
+
+    /*! Stop monitoring, must be called by the thread which called
+      Begin */
+    void End(void);
+
+    /*! Scope guard calling Begin on construction and End on
+      destruction, so End is only called if Begin was and even if an
+      exception is thrown.  The monitor can be 0, in which case
+      nothing is done. */
+    class Section {
+        osaAllocationMonitor * Monitor;
+        Section(const Section & other);
+        Section & operator = (const Section & other);
+    public:
+        inline explicit Section(osaAllocationMonitor * monitor):
+            Monitor(monitor)
+        {
+            if (this->Monitor) {
+                this->Monitor->Begin();
+            }
+        }
+
+        inline ~Section() {
+            if (this->Monitor) {
+                this->Monitor->End();
+            }
+        }
+    };
+
+    /*! Monitor active for the calling thread, 0 if none */
+    static osaAllocationMonitor * GetCurrent(void);
+
+    /*! Number of times Begin was called */
+    inline unsigned long long GetNumberOfSections(void) const {
+        return this->NumberOfSections.load(std::memory_order_relaxed);
+    }
+
+    /*! Number of sections with at least one allocation */
+    inline unsigned long long GetNumberOfSectionsWithAllocations(void) const {
+        return this->NumberOfSectionsWithAllocations.load(std::memory_order_relaxed);
+    }
+
+    inline unsigned long long GetNumberOfAllocations(void) const {
+        return this->NumberOfAllocations.load(std::memory_order_relaxed);
+    }
+
+    inline unsigned long long GetNumberOfDeallocations(void) const {
+        return this->NumberOfDeallocations.load(std::memory_order_relaxed);
+    }
+
+    /*! Total number of bytes allocated */
+    inline unsigned long long GetNumberOfBytes(void) const {
+        return this->NumberOfBytes.load(std::memory_order_relaxed);
+    }
+
+    /*! Number of call sites recorded */
+    size_t GetNumberOfCallSites(void) const;
+
+    /*! Call site, index must be lesser than GetNumberOfCallSites */
+    inline const CallSite & GetCallSite(size_t index) const {
+        return this->CallSites[index];
+    }
+
+    /*! Print counters and call sites, frames are converted to symbols
+      when possible.  This method allocates memory and should not be
+      used in a real-time section. */
+    void ToStream(std::ostream & outputStream) const;
+
+    /*! Methods used by the replacements of operators new and delete */
+    //@{
+    void RecordAllocation(size_t size);
+    void RecordDeallocation(void);
+    //@}
+};
+
+
+/*! Stream out operator. */
+inline
+std::ostream & operator << (std::ostream & output,
+                            const osaAllocationMonitor & monitor) {
+    monitor.ToStream(output);
+    return output;
+}
+
+#endif // _osaAllocationMonitor_h
@@ -0,0 +1,234 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Declaration of osaAsynchronousLogger
+  \ingroup cisstOSAbstraction
+ */
+
+#ifndef _osaAsynchronousLogger_h
+#define _osaAsynchronousLogger_h
+
+#include <cisstCommon/cmnLODMultiplexerStreambuf.h>
+#include <cisstCommon/cmnLogBinary.h>
+#include <cisstOSAbstraction/osaThread.h>
+#include <cisstOSAbstraction/osaThreadSignal.h>
+
+#include <atomic>
+#include <fstream>
+#include <map>
+
+// Always include last
+#include <cisstOSAbstraction/osaExport.h>
+
+/* forward declaration for the per thread buffers */
+struct osaAsynchronousLoggerBuffer;
+
+/*!
+  \brief Asynchronous backend for cmnLogger
+
+  By default, the messages sent using the CMN_LOG macros are written
+  to all the output channels (log file, std::cerr...) by the thread
+  sending the message.  Once started, this multiplexer takes over the
+  channels of the cmnLogger multiplexer (or any other multiplexer
+  provided to Start).  The thread sending a message only formats it
+  and copies it in a lock free ring buffer owned by the thread.  A
+  dedicated thread drains the buffers and writes the messages to the
+  output channels.
+
+  \code
+  osaAsynchronousLogger asynchronousLogger;
+  asynchronousLogger.Start();
+  CMN_LOG_RUN_VERBOSE << "formatted by the caller, written later" << std::endl;
+  asynchronousLogger.Stop(); // or Flush()
+  \endcode
+
+  Messages are buffered per thread until the end of line (or a flush)
+  and written as one record so lines from different threads are not
+  interleaved.  Records are written in the order they were sent.  If
+  a thread's buffer is full, the record is dropped and counted (see
+  GetNumberOfDroppedRecords).
+
+  Pending records are written when Stop is called, when the program
+  exits and, unless disabled in Start, when the program receives a
+  crash signal (SIGSEGV, SIGABRT, SIGFPE, SIGILL and SIGBUS).
+
+  The asynchronous logger can also write the messages sent with
+  #CMN_LOG_BINARY to a binary file (see OpenBinaryFile).  The time
+  and a thread number are added by the sending thread, the call sites
+  and messages are written to the file by the draining thread.  The
+  file can be decoded using the cisstLogDecoder application.  Threads
+  sending binary messages use the logger without lock, messages sent
+  after CloseBinaryFile or Stop are ignored but the logger itself must
+  not be destroyed before all these threads are done.
+
+  Channels and multiplexers should not be added or removed while the
+  asynchronous logger is running.  Channels added to the cmnLogger
+  multiplexer after Start are written synchronously.  Only one
+  asynchronous logger can run at a time.
+*/
+class CISST_EXPORT osaAsynchronousLogger: public cmnLODMultiplexerStreambuf<char>,
+                                          public cmnLogBinarySink
+{
+public:
+    typedef cmnLODMultiplexerStreambuf<char> MultiplexerType;
+
+    /*! Constructor, the buffer size is the size in bytes of the
+      buffer allocated for each thread sending messages. */
+    osaAsynchronousLogger(size_t bufferSize = 256 * 1024);
+
+    /*! Destructor, stops the logger if needed */
+    ~osaAsynchronousLogger();
+
+    /*! Take over the channels of the front end multiplexer and start
+      the thread writing the messages.  If no multiplexer is provided,
+      uses the cmnLogger multiplexer.  The thread checks for new
+      messages at the given period.  Returns false if this or another
+      asynchronous logger is already running. */
+    bool Start(MultiplexerType * frontEnd = 0,
+               double periodInSeconds = 0.01,
+               bool flushOnSignal = true);
+
+    /*! Write all pending messages, stop the thread and give the
+      channels back to the front end multiplexer. */
+    void Stop(void);
+
+    inline bool IsRunning(void) const {
+        return (this->FrontEnd != 0);
+    }
+
+    /*! Write all the messages sent so far, the messages are written
+      by the calling thread. */
+    void Flush(void);
+
+    /*! Number of records (lines) sent */
+    unsigned long long GetNumberOfRecords(void) const;
+
+    /*! Number of records dropped because a buffer was full */
+    unsigned long long GetNumberOfDroppedRecords(void) const;
+
+    /*! Number of per thread buffers allocated */
+    size_t GetNumberOfBuffers(void) const;
+
+    /*! Asynchronous logger currently running, 0 if none */
+    static osaAsynchronousLogger * GetRunning(void);
+
+    /*! Open the file used to write binary messages.  While the file
+      is open and the logger is running, the logger is used as the
+      cmnLogger binary sink.  Returns false if the file can't be
+      created. */
+    bool OpenBinaryFile(const std::string & fileName);
+
+    /*! Write pending binary messages and close the binary file */
+    void CloseBinaryFile(void);
+
+    inline bool IsBinaryFileOpen(void) const {
+        return this->BinaryFile.is_open();
+    }
+
+    /*! Copy a binary message in the calling thread's buffer, called
+      by #CMN_LOG_BINARY */
+    void Write(const cmnLogBinarySite & site, const char * arguments, size_t size);
+
+protected:
+    typedef MultiplexerType::int_type int_type;
+
+    /*! Overloaded methods called by the front end multiplexer, the
+      characters are copied in the calling thread's buffer. */
+    //@{
+    std::streamsize xsputn(const char * s, std::streamsize n, cmnLogLevel level);
+    int sync(void);
+    int_type overflow(int_type c, cmnLogLevel level);
+    std::streamsize xsputn(const char * s, std::streamsize n);
+    int_type overflow(int_type c = traits_type::eof());
+    //@}
+
+    /*! Copy characters in the calling thread's buffer, records are
+      published at the end of each line. */
+    void Append(const char * s, std::streamsize n, cmnLogLevel level);
+
+    /*! Publish the characters buffered by the calling thread */
+    void PublishPending(void);
+
+    /*! Write all published records to the channels.  Returns false if
+      the buffers are being drained by another thread and the wait
+      timed out. */
+    bool Drain(bool fromSignal = false);
+
+    /*! Get exclusive access to the buffers' content, the channels and
+      the binary file.  Returns false if the wait timed out. */
+    bool LockDrain(bool fromSignal = false);
+    void UnlockDrain(void);
+
+    /*! Write a binary record to the binary file, draining thread only */
+    void WriteBinary(const char * data, size_t size);
+
+    /*! Use this logger as cmnLogger's binary sink if the logger is
+      running and the binary file is open, remove it otherwise */
+    void UpdateBinarySink(void);
+
+    /*! Body of the thread writing the messages */
+    void * Run(void * argument);
+
+    /*! Get or create the calling thread's buffer */
+    osaAsynchronousLoggerBuffer * GetBuffer(void);
+
+    /*! Release all buffers, used when stopped */
+    void ReleaseBuffers(void);
+
+    static void SignalHandler(int signalNumber);
+    static void ExitHandler(void);
+
+    size_t BufferSize;
+    MultiplexerType * FrontEnd;
+    double Period;
+    bool FlushOnSignal;
+
+    osaThread Thread;
+    osaThreadSignal Signal;
+    std::atomic<bool> StopRequested;
+    std::atomic<bool> SyncRequested;
+
+    /*! Set by the thread draining the buffers */
+    std::atomic<bool> Draining;
+
+    /*! List of buffers, buffers are only added while running so the
+      list can be traversed without lock */
+    std::atomic<osaAsynchronousLoggerBuffer *> Buffers;
+
+    /*! Generation used to identify the thread buffers created for
+      this run */
+    unsigned long long Generation;
+
+    /*! Binary file and index of call sites already written */
+    std::ofstream BinaryFile;
+    typedef std::map<const cmnLogBinarySite *, unsigned int> BinarySitesType;
+    BinarySitesType BinarySites;
+
+    /*! Counters of the buffers already released */
+    unsigned long long NumberOfRecordsReleased;
+    unsigned long long NumberOfDroppedRecordsReleased;
+
+private:
+    /*! Private copy constructor to prevent copies */
+    osaAsynchronousLogger(const osaAsynchronousLogger & other);
+    osaAsynchronousLogger & operator = (const osaAsynchronousLogger & other);
+};
+
+#endif // _osaAsynchronousLogger_h
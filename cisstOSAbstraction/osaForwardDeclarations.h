@@ -6,7 +6,7 @@
   Author(s):	Anton Deguet
   Created on:	2007-10-07
 
-  (C) Copyright 2007-2009 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2007-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -27,6 +27,8 @@ http://www.cisst.org/cisst/license.txt.
   \brief Forward declarations and \#define for cisstOSAbstraction
 */
 
+class osaAllocationMonitor;
+class osaAsynchronousLogger;
 class osaMutex;
 class osaThreadSignal;
 class osaTimeServer;
@@ -0,0 +1,148 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+
+/*!
+  \file
+  \brief Declaration of osaSharedMemoryRing
+  \ingroup cisstOSAbstraction
+ */
+
+#ifndef _osaSharedMemoryRing_h
+#define _osaSharedMemoryRing_h
+
+#include <cisstCommon/cmnPortability.h>
+
+#include <string>
+
+// Always include last
+#include <cisstOSAbstraction/osaExport.h>
+
+/* forward declaration for data stored in shared memory */
+struct osaSharedMemoryRingHeader;
+
+/*!
+  \brief Message ring buffer in shared memory
+
+  Ring buffer used to exchange messages between processes running on
+  the same computer.  One process creates the ring (see Create) and
+  the other processes open it by name (see Open).  The segment is
+  removed when the process that created it closes the ring.
+
+  Messages are stored contiguously so they can be written in place
+  (see Reserve and Commit) and read in place (see Peek and Release).
+  A single process should read from the ring.  Multiple processes or
+  threads can write in the ring, writers are serialized using a lock
+  stored in the shared memory.  A writer holding the lock when its
+  process is killed would block the other writers.
+
+  Readers and writers waiting for data or space use a futex on Linux
+  (doorbell), writers only issue a wake system call if a reader is
+  blocked.  Other POSIX systems poll the ring with short sleeps.  The
+  ring is not supported on Windows, Create and Open fail.
+*/
+class CISST_EXPORT osaSharedMemoryRing
+{
+public:
+    osaSharedMemoryRing(void);
+
+    /*! Destructor, closes the ring */
+    ~osaSharedMemoryRing();
+
+    /*! Create a ring with the given name and capacity in bytes.  An
+      existing segment with the same name is replaced.  Names should
+      not contain '/', a leading '/' is added if needed. */
+    bool Create(const std::string & name, size_t capacity);
+
+    /*! Open a ring created by another process */
+    bool Open(const std::string & name);
+
+    /*! Unmap the ring, the segment is removed if this object created
+      it. */
+    void Close(void);
+
+    inline bool IsOpen(void) const {
+        return (this->Header != 0);
+    }
+
+    inline const std::string & GetName(void) const {
+        return this->Name;
+    }
+
+    /*! Largest message that can be sent */
+    size_t GetMaximumMessageSize(void) const;
+
+    /*! Reserve contiguous space for a message of at most length bytes,
+      waiting up to timeoutSec for space.  Returns a pointer to write
+      the message in place or 0 if the message is too large or the
+      ring remained full.  The writer lock is held until Commit is
+      called. */
+    char * Reserve(size_t length, double timeoutSec = 0.0);
+
+    /*! Publish the message written after Reserve, length can be
+      smaller than the reserved length. */
+    void Commit(size_t length);
+
+    /*! Release the space reserved without publishing a message */
+    void Cancel(void);
+
+    /*! Copy and publish a message */
+    bool Send(const char * data, size_t length, double timeoutSec = 0.0);
+
+    /*! Wait up to timeoutSec for a message.  Returns a pointer to the
+      message in the ring and sets length, 0 if no message is
+      available.  The message stays in the ring until Release is
+      called. */
+    const char * Peek(size_t & length, double timeoutSec = 0.0);
+
+    /*! Remove the message returned by Peek */
+    void Release(void);
+
+    /*! Copy and remove the next message, returns false if no message
+      was received before the timeout. */
+    bool Receive(std::string & message, double timeoutSec = 0.0);
+
+    /*! Check if shared memory rings are supported on this platform */
+    static bool IsSupported(void);
+
+    /*! Name unique on this computer made of the prefix, the process
+      identifier and a counter. */
+    static std::string GetUniqueName(const std::string & prefix);
+
+protected:
+    std::string Name;
+    bool Owner;
+    osaSharedMemoryRingHeader * Header;
+    char * Data;
+    size_t MappedSize;
+
+    /*! Position of the message being written, between Reserve and
+      Commit */
+    unsigned long long ReservedPosition;
+
+    /*! Size used by the message returned by Peek */
+    unsigned long long PeekedSize;
+
+    bool Map(int fileDescriptor, size_t size);
+
+private:
+    /*! Private copy constructor to prevent copies */
+    osaSharedMemoryRing(const osaSharedMemoryRing & other);
+    osaSharedMemoryRing & operator = (const osaSharedMemoryRing & other);
+};
+
+#endif // _osaSharedMemoryRing_h
@@ -6,7 +6,7 @@
   Author(s):  Peter Kazanzides, Ali Uneri
   Created on: 2009
 
-  (C) Copyright 2007-2013 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2007-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -60,6 +60,10 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstCommon/cmnGenericObject.h>
 #include <cisstCommon/cmnLogger.h>
 #include <cisstCommon/cmnPortability.h>
+
+// forward declaration for scatter/gather send
+class cmnDataBinaryWriter;
+
 // Always include last
 #include <cisstOSAbstraction/osaExport.h>
 
@@ -273,6 +277,16 @@ class CISST_EXPORT osaSocket : public cmnGenericObject
         \return Number of bytes sent (-1 if error) */
     int Send(const std::string & bufsend, double timeoutSec = 0.0 );
 
+    /*! \brief Send the segments of a binary writer via the socket
+               without copying them in a single buffer (see cmnDataBinaryWriter).
+               For UDP, all segments are sent in a single datagram.
+        \param writer Binary writer holding the segments to be sent
+        \param timeoutSec is the longest time we should wait to send something
+        \return Number of bytes sent (-1 if error)
+        \note On Windows, the segments are copied in a single buffer and sent using Send.
+    */
+    int Send(const cmnDataBinaryWriter & writer, double timeoutSec = 0.0);
+
     /*! \brief Send a byte array via the socket, possibly in multiple packets based on the specified
                maximum packet_size. This method can be used with both UDP and TCP, though it
                is intended for UDP.
@@ -44,6 +44,10 @@ http://www.cisst.org/cisst/license.txt.
 #include <pthread.h>
 #endif
 
+#if (CISST_OS == CISST_LINUX) || (CISST_OS == CISST_LINUX_RTAI) || (CISST_OS == CISST_LINUX_XENOMAI) || (CISST_OS == CISST_QNX)
+#include <sched.h> // SCHED_FIFO, not always included by other system headers
+#endif
+
 /*!
   \brief PriorityType and SchedulingPolicyType.
 
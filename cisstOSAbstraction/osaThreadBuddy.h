@@ -6,7 +6,7 @@
   Author(s): Ankur Kapoor, Min Yang Jung
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2010 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -61,12 +61,46 @@ struct osaThreadBuddyInternals;
   it easy to provide Soft Real Time tasks in Vanila Linux flavor.
  */
 class CISST_EXPORT osaThreadBuddy {
-
+public:
+    /*! Policy used by WaitForRemainingPeriod when the deadline for
+      the current period has already passed (overrun).
+      <ul>
+      <li>CATCH_UP_SKIP: skip the missed periods and wait for the next
+      deadline, i.e. the phase of the periodic loop is preserved.</li>
+      <li>CATCH_UP_BURST: don't wait, the following periods are
+      executed back to back until the loop catches up with the
+      deadlines.  No period is lost.</li>
+      <li>CATCH_UP_REALIGN: don't wait and use the current time as the
+      start of the next period, i.e. the phase is reset.</li>
+      </ul>
+      The policy is only used on platforms where the periodic loop is
+      based on absolute deadlines (Linux). */
+    enum CatchUpPolicyType {
+        CATCH_UP_SKIP,
+        CATCH_UP_BURST,
+        CATCH_UP_REALIGN
+    };
+
+private:
     osaThreadBuddyInternals* Data;
 
     /*! Thread period (if > 0) */
     double Period;
 
+    /*! Policy used after an overrun */
+    CatchUpPolicyType CatchUpPolicy;
+
+    /*! Number of calls to WaitForRemainingPeriod made after the
+      deadline */
+    unsigned long long NumberOfOverruns;
+
+    /*! Number of periods skipped because of overruns */
+    unsigned long long NumberOfSkippedPeriods;
+
+    /*! Maximum delay observed between a deadline and the call to
+      WaitForRemainingPeriod, in seconds */
+    double MaximumLateness;
+
 public:
     /*! Constructor. Allocates internal data. */
     osaThreadBuddy();
@@ -98,8 +132,33 @@ public:
     void WaitForPeriod(void);
 
     /*! Suspend the execution of the real time thread for the
-      remainder of the current period. */
+      remainder of the current period.  On Linux, the thread sleeps
+      until an absolute deadline based on CLOCK_MONOTONIC so the
+      periodic loop doesn't drift.  If the deadline has already
+      passed, the overrun is counted and the catch-up policy is
+      applied (see SetCatchUpPolicy). */
     void WaitForRemainingPeriod(void);
+
+    /*! Set the policy used when a deadline is missed.  Default is
+      CATCH_UP_SKIP. */
+    void SetCatchUpPolicy(const CatchUpPolicyType policy);
+
+    /*! Get the policy used when a deadline is missed. */
+    CatchUpPolicyType GetCatchUpPolicy(void) const;
+
+    /*! Number of overruns, i.e. number of calls to
+      WaitForRemainingPeriod after the deadline of the period. */
+    unsigned long long GetNumberOfOverruns(void) const;
+
+    /*! Number of periods skipped because of overruns. */
+    unsigned long long GetNumberOfSkippedPeriods(void) const;
+
+    /*! Maximum delay between a deadline and the call to
+      WaitForRemainingPeriod, in seconds. */
+    double GetMaximumLateness(void) const;
+
+    /*! Reset overruns, skipped periods and maximum lateness. */
+    void ResetOverrunCounters(void);
     
     /*! Make a thread hard real time. */
     void MakeHardRealTime(void);
@@ -6,7 +6,7 @@
   Author(s): Ankur Kapoor, Peter Kazanzides, Balazs Vagvolgyi, Anton Deguet
   Created on: 2004-04-30
 
-  (C) Copyright 2004-2012 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -37,6 +37,22 @@ class osaThreadId;
 /* forward declaration for OS dependent internals */
 struct osaThreadSignalInternals;
 
+/*!
+  \brief Thread signal (event)
+
+  Raise wakes up all the threads currently waiting on the signal.  If
+  no thread is waiting, the signal remains raised and the next call
+  to Wait returns immediately (auto-reset).
+
+  On Linux, the signal is implemented using a futex.  Wait first polls
+  the signal for a short period (spin phase) before blocking in the
+  kernel.  The number of iterations is adapted based on how long
+  previous waits had to spin before the signal was raised and is
+  bounded by the spin count (see SetSpinCount).  Timed waits use
+  absolute deadlines based on CLOCK_MONOTONIC so changes of the wall
+  clock don't affect the timeouts.  Other operating systems use
+  condition variables or events and don't spin.
+*/
 class CISST_EXPORT osaThreadSignal
 {
 public:
@@ -49,6 +65,30 @@ public:
 
     static void SetWaitCallbacks(const osaThreadId &threadId, void (*pre)(void), void (*post)(void));
 
+    /*! Set the maximum number of iterations used to poll the signal
+      before blocking.  Use 0 to block immediately.  Default is 0 on
+      single CPU systems and 100 otherwise.  This is ignored if the
+      implementation doesn't support spinning. */
+    void SetSpinCount(unsigned int spinCount);
+
+    /*! Get the maximum number of iterations used to poll the signal
+      before blocking. */
+    unsigned int GetSpinCount(void) const;
+
+    /*! Number of waits satisfied during the spin phase, i.e. without
+      blocking. */
+    unsigned long long GetNumberOfSpins(void) const;
+
+    /*! Number of times a waiting thread blocked in the kernel. */
+    unsigned long long GetNumberOfSleeps(void) const;
+
+    /*! Number of blocking waits ended by Raise, i.e. that didn't
+      time out. */
+    unsigned long long GetNumberOfWakeups(void) const;
+
+    /*! Reset spins, sleeps and wakeups counters. */
+    void ResetCounters(void);
+
     /*! Print to stream */
     void ToStream(std::ostream & outputStream) const;
 
@@ -0,0 +1,156 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstCommon/cmnUnits.h>
+#include <cisstOSAbstraction/osaSleep.h>
+#include <cisstOSAbstraction/osaThread.h>
+
+#include "osaAllocationMonitorTest.h"
+
+#include <cisstOSAbstraction/osaAllocationMonitor.h>
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+
+// allocate and deallocate in a separate function so all calls share
+// the same call stack, the global prevents the compiler from removing
+// the allocation
+std::string * osaAllocationMonitorTestString = 0;
+
+static void osaAllocationMonitorTestAllocate(size_t size)
+{
+    osaAllocationMonitorTestString = new std::string(size, 'x');
+    delete osaAllocationMonitorTestString;
+    osaAllocationMonitorTestString = 0;
+}
+
+
+void osaAllocationMonitorTest::TestSections(void)
+{
+    osaAllocationMonitor monitor("sections");
+    CPPUNIT_ASSERT(osaAllocationMonitor::GetCurrent() == 0);
+
+    // outside a section
+    osaAllocationMonitorTestAllocate(100);
+    CPPUNIT_ASSERT_EQUAL(0ULL, monitor.GetNumberOfAllocations());
+
+    // section without allocation
+    monitor.Begin();
+    CPPUNIT_ASSERT(osaAllocationMonitor::GetCurrent() == &monitor);
+    double sum = 0.0;
+    for (size_t index = 0; index < 10; ++index) {
+        sum += index;
+    }
+    monitor.End();
+    CPPUNIT_ASSERT(osaAllocationMonitor::GetCurrent() == 0);
+    CPPUNIT_ASSERT_EQUAL(45.0, sum);
+    CPPUNIT_ASSERT_EQUAL(1ULL, monitor.GetNumberOfSections());
+    CPPUNIT_ASSERT_EQUAL(0ULL, monitor.GetNumberOfSectionsWithAllocations());
+    CPPUNIT_ASSERT_EQUAL(0ULL, monitor.GetNumberOfAllocations());
+
+    // section with allocation and deallocation
+    monitor.Begin();
+    osaAllocationMonitorTestAllocate(100);
+    monitor.End();
+    CPPUNIT_ASSERT_EQUAL(2ULL, monitor.GetNumberOfSections());
+    if (!osaAllocationMonitor::IsAvailable()) {
+        CPPUNIT_ASSERT_EQUAL(0ULL, monitor.GetNumberOfAllocations());
+        return;
+    }
+    CPPUNIT_ASSERT_EQUAL(1ULL, monitor.GetNumberOfSectionsWithAllocations());
+    // the string object and its buffer
+    CPPUNIT_ASSERT_EQUAL(2ULL, monitor.GetNumberOfAllocations());
+    CPPUNIT_ASSERT_EQUAL(2ULL, monitor.GetNumberOfDeallocations());
+    CPPUNIT_ASSERT(monitor.GetNumberOfBytes() > 100);
+
+    // nested sections
+    osaAllocationMonitor inner("inner");
+    monitor.Begin();
+    inner.Begin();
+    osaAllocationMonitorTestAllocate(100);
+    inner.End();
+    CPPUNIT_ASSERT(osaAllocationMonitor::GetCurrent() == &monitor);
+    monitor.End();
+    CPPUNIT_ASSERT_EQUAL(2ULL, inner.GetNumberOfAllocations());
+    CPPUNIT_ASSERT_EQUAL(2ULL, monitor.GetNumberOfAllocations());
+}
+
+
+void osaAllocationMonitorTest::TestCallSites(void)
+{
+    osaAllocationMonitor monitor("callSites");
+    for (size_t index = 0; index < 10; ++index) {
+        monitor.Begin();
+        osaAllocationMonitorTestAllocate(100);
+        monitor.End();
+    }
+    std::stringstream report;
+    report << monitor;
+    CPPUNIT_ASSERT(report.str().find("callSites") != std::string::npos);
+    if (!osaAllocationMonitor::IsAvailable()) {
+        return;
+    }
+    CPPUNIT_ASSERT_EQUAL(10ULL, monitor.GetNumberOfSectionsWithAllocations());
+    CPPUNIT_ASSERT_EQUAL(20ULL, monitor.GetNumberOfAllocations());
+#if CISST_OSA_HAS_EXECINFO
+    // one for the string object, one for its buffer
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), monitor.GetNumberOfCallSites());
+    CPPUNIT_ASSERT_EQUAL(10ULL, monitor.GetCallSite(0).NumberOfAllocations.load());
+    CPPUNIT_ASSERT_EQUAL(10ULL, monitor.GetCallSite(1).NumberOfAllocations.load());
+    CPPUNIT_ASSERT(monitor.GetCallSite(0).NumberOfFrames > 0);
+    CPPUNIT_ASSERT(report.str().find("call site 1") != std::string::npos);
+#endif
+}
+
+
+class osaAllocationMonitorTestThread
+{
+public:
+    osaAllocationMonitor * Monitor;
+    unsigned long long NumberOfAllocations;
+
+    void * Run(int CMN_UNUSED(dummy)) {
+        // allocations in this thread are not counted by the main thread's monitor
+        std::vector<std::string> values;
+        for (size_t index = 0; index < 100; ++index) {
+            values.push_back(std::string(100, 'y'));
+        }
+        NumberOfAllocations = Monitor->GetNumberOfAllocations();
+        return 0;
+    }
+};
+
+
+void osaAllocationMonitorTest::TestThreads(void)
+{
+    osaAllocationMonitor monitor("threads");
+    osaAllocationMonitorTestThread threadData;
+    threadData.Monitor = &monitor;
+    threadData.NumberOfAllocations = 1;
+    monitor.Begin();
+    osaThread thread;
+    thread.Create<osaAllocationMonitorTestThread, int>(&threadData, &osaAllocationMonitorTestThread::Run, 0);
+    thread.Wait();
+    monitor.End();
+    // the thread creation might allocate, not the thread itself
+    CPPUNIT_ASSERT(threadData.NumberOfAllocations < 100);
+}
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(osaAllocationMonitorTest);
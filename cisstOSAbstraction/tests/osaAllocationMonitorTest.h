@@ -0,0 +1,46 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class osaAllocationMonitorTest: public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(osaAllocationMonitorTest);
+    {
+        CPPUNIT_TEST(TestSections);
+        CPPUNIT_TEST(TestCallSites);
+        CPPUNIT_TEST(TestThreads);
+    }
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp(void) {
+    }
+
+    void tearDown(void) {
+    }
+
+    /*! Count allocations only between Begin and End */
+    void TestSections(void);
+
+    /*! Allocations from the same call stack share a call site */
+    void TestCallSites(void);
+
+    /*! Allocations from other threads are not counted */
+    void TestThreads(void);
+};
@@ -0,0 +1,271 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstCommon/cmnLODOutputMultiplexer.h>
+#include <cisstOSAbstraction/osaThread.h>
+
+#include "osaAsynchronousLoggerTest.h"
+
+#include <cisstOSAbstraction/osaAsynchronousLogger.h>
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+typedef cmnLODMultiplexerStreambuf<char> osaAsynchronousLoggerTestMultiplexer;
+
+
+void osaAsynchronousLoggerTest::TestStartStop(void)
+{
+    osaAsynchronousLoggerTestMultiplexer frontEnd;
+    std::stringstream output;
+    frontEnd.AddChannel(output, CMN_LOG_ALLOW_ALL);
+
+    osaAsynchronousLogger logger;
+    CPPUNIT_ASSERT(!logger.IsRunning());
+    CPPUNIT_ASSERT(logger.Start(&frontEnd));
+    CPPUNIT_ASSERT(logger.IsRunning());
+    CPPUNIT_ASSERT(osaAsynchronousLogger::GetRunning() == &logger);
+    CPPUNIT_ASSERT(frontEnd.GetChannels().empty());
+    CPPUNIT_ASSERT_EQUAL(size_t(1), logger.GetChannels().size());
+
+    // only one logger can run
+    osaAsynchronousLogger other;
+    osaAsynchronousLoggerTestMultiplexer otherFrontEnd;
+    CPPUNIT_ASSERT(!other.Start(&otherFrontEnd));
+
+    cmnLODOutputMultiplexer(&frontEnd, CMN_LOG_LEVEL_RUN_ERROR).Ref() << "first " << 1 << std::endl;
+    cmnLODOutputMultiplexer(&frontEnd, CMN_LOG_LEVEL_RUN_ERROR).Ref() << "second " << 2 << std::endl;
+    logger.Flush();
+    CPPUNIT_ASSERT_EQUAL(std::string("first 1\nsecond 2\n"), output.str());
+    CPPUNIT_ASSERT_EQUAL(1ULL * 2, logger.GetNumberOfRecords());
+    CPPUNIT_ASSERT_EQUAL(size_t(1), logger.GetNumberOfBuffers());
+
+    // pending records are written by stop
+    cmnLODOutputMultiplexer(&frontEnd, CMN_LOG_LEVEL_RUN_ERROR).Ref() << "third" << std::endl;
+    cmnLODOutputMultiplexer(&frontEnd, CMN_LOG_LEVEL_RUN_ERROR).Ref() << "no end of line";
+    logger.Stop();
+    CPPUNIT_ASSERT(!logger.IsRunning());
+    CPPUNIT_ASSERT(osaAsynchronousLogger::GetRunning() == 0);
+    CPPUNIT_ASSERT_EQUAL(std::string("first 1\nsecond 2\nthird\nno end of line"), output.str());
+    CPPUNIT_ASSERT_EQUAL(1ULL * 4, logger.GetNumberOfRecords());
+    CPPUNIT_ASSERT_EQUAL(0ULL, logger.GetNumberOfDroppedRecords());
+    CPPUNIT_ASSERT(logger.GetChannels().empty());
+    CPPUNIT_ASSERT_EQUAL(size_t(1), frontEnd.GetChannels().size());
+
+    // synchronous again
+    cmnLODOutputMultiplexer(&frontEnd, CMN_LOG_LEVEL_RUN_ERROR).Ref() << std::endl << "fourth" << std::endl;
+    CPPUNIT_ASSERT_EQUAL(std::string("first 1\nsecond 2\nthird\nno end of line\nfourth\n"), output.str());
+
+    // the logger can be restarted
+    CPPUNIT_ASSERT(other.Start(&otherFrontEnd));
+    other.Stop();
+    CPPUNIT_ASSERT(logger.Start(&frontEnd));
+    cmnLODOutputMultiplexer(&frontEnd, CMN_LOG_LEVEL_RUN_ERROR).Ref() << "fifth" << std::endl;
+    logger.Stop();
+    CPPUNIT_ASSERT_EQUAL(std::string("first 1\nsecond 2\nthird\nno end of line\nfourth\nfifth\n"), output.str());
+    CPPUNIT_ASSERT_EQUAL(1ULL, logger.GetNumberOfRecords());
+}
+
+
+void osaAsynchronousLoggerTest::TestMasks(void)
+{
+    osaAsynchronousLoggerTestMultiplexer frontEnd;
+    std::stringstream errors, all;
+    frontEnd.AddChannel(errors, CMN_LOG_ALLOW_ERRORS);
+    frontEnd.AddChannel(all, CMN_LOG_ALLOW_ALL);
+
+    osaAsynchronousLogger logger;
+    CPPUNIT_ASSERT(logger.Start(&frontEnd));
+    cmnLODOutputMultiplexer(&frontEnd, CMN_LOG_LEVEL_INIT_ERROR).Ref() << "error" << std::endl;
+    cmnLODOutputMultiplexer(&frontEnd, CMN_LOG_LEVEL_RUN_DEBUG).Ref() << "debug" << std::endl;
+    // message without level of detail, sent to all channels
+    std::ostream stream(&frontEnd);
+    stream << "any" << std::endl;
+    logger.Stop();
+    CPPUNIT_ASSERT_EQUAL(std::string("error\nany\n"), errors.str());
+    CPPUNIT_ASSERT_EQUAL(std::string("error\ndebug\nany\n"), all.str());
+}
+
+
+class osaAsynchronousLoggerTestWriter {
+public:
+    osaAsynchronousLoggerTestMultiplexer * FrontEnd;
+    size_t Index;
+    size_t NumberOfLines;
+    osaThread Thread;
+
+    void * Run(int CMN_UNUSED(argument)) {
+        for (size_t line = 0; line < NumberOfLines; ++line) {
+            // line sent in multiple pieces
+            cmnLODOutputMultiplexer(FrontEnd, CMN_LOG_LEVEL_RUN_VERBOSE).Ref()
+                << "thread " << Index << " line " << line << std::endl;
+        }
+        return 0;
+    }
+};
+
+
+void osaAsynchronousLoggerTest::TestThreads(void)
+{
+    osaAsynchronousLoggerTestMultiplexer frontEnd;
+    std::stringstream output;
+    frontEnd.AddChannel(output, CMN_LOG_ALLOW_ALL);
+
+    osaAsynchronousLogger logger;
+    CPPUNIT_ASSERT(logger.Start(&frontEnd, 0.001));
+
+    const size_t numberOfThreads = 4;
+    const size_t numberOfLines = 2000;
+    std::vector<osaAsynchronousLoggerTestWriter> writers(numberOfThreads);
+    size_t index;
+    for (index = 0; index < numberOfThreads; ++index) {
+        writers[index].FrontEnd = &frontEnd;
+        writers[index].Index = index;
+        writers[index].NumberOfLines = numberOfLines;
+        writers[index].Thread.Create<osaAsynchronousLoggerTestWriter, int>(&(writers[index]),
+                                                                          &osaAsynchronousLoggerTestWriter::Run, 0);
+    }
+    for (index = 0; index < numberOfThreads; ++index) {
+        writers[index].Thread.Wait();
+    }
+    logger.Stop();
+    CPPUNIT_ASSERT_EQUAL(0ULL, logger.GetNumberOfDroppedRecords());
+    CPPUNIT_ASSERT_EQUAL(1ULL * numberOfThreads * numberOfLines, logger.GetNumberOfRecords());
+
+    // each line is whole and lines of a thread are in order
+    std::vector<size_t> nextLine(numberOfThreads, 0);
+    std::string text;
+    size_t numberOfReadLines = 0;
+    while (std::getline(output, text)) {
+        std::stringstream line(text);
+        std::string word;
+        size_t thread, lineNumber;
+        line >> word >> thread;
+        CPPUNIT_ASSERT_EQUAL(std::string("thread"), word);
+        line >> word >> lineNumber;
+        CPPUNIT_ASSERT_EQUAL(std::string("line"), word);
+        CPPUNIT_ASSERT(thread < numberOfThreads);
+        CPPUNIT_ASSERT_EQUAL(nextLine[thread], lineNumber);
+        nextLine[thread]++;
+        numberOfReadLines++;
+    }
+    CPPUNIT_ASSERT_EQUAL(numberOfThreads * numberOfLines, numberOfReadLines);
+}
+
+
+void osaAsynchronousLoggerTest::TestOverflow(void)
+{
+    osaAsynchronousLoggerTestMultiplexer frontEnd;
+    std::stringstream output;
+    frontEnd.AddChannel(output, CMN_LOG_ALLOW_ALL);
+
+    // small buffer and long period so the buffer fills up
+    osaAsynchronousLogger logger(1024);
+    CPPUNIT_ASSERT(logger.Start(&frontEnd, 10.0));
+    const std::string text(100, 'x');
+    const size_t numberOfLines = 100;
+    for (size_t line = 0; line < numberOfLines; ++line) {
+        cmnLODOutputMultiplexer(&frontEnd, CMN_LOG_LEVEL_RUN_ERROR).Ref() << text << std::endl;
+    }
+    const unsigned long long dropped = logger.GetNumberOfDroppedRecords();
+    CPPUNIT_ASSERT(dropped > 0);
+    CPPUNIT_ASSERT_EQUAL(1ULL * numberOfLines, logger.GetNumberOfRecords() + dropped);
+
+    // space is available after a flush
+    logger.Flush();
+    cmnLODOutputMultiplexer(&frontEnd, CMN_LOG_LEVEL_RUN_ERROR).Ref() << "last" << std::endl;
+    logger.Stop();
+    CPPUNIT_ASSERT_EQUAL(dropped, logger.GetNumberOfDroppedRecords());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>((numberOfLines - dropped) * (text.size() + 1) + 5),
+                         output.str().size());
+    CPPUNIT_ASSERT_EQUAL(std::string("last\n"), output.str().substr(output.str().size() - 5));
+}
+
+
+void osaAsynchronousLoggerTest::TestBinary(void)
+{
+    osaAsynchronousLoggerTestMultiplexer frontEnd;
+    std::stringstream output;
+    frontEnd.AddChannel(output, CMN_LOG_ALLOW_ALL);
+    const cmnLogMask previousMask = cmnLogger::GetMask();
+    const cmnLogMask previousMaskFunction = cmnLogger::GetMaskFunction();
+    cmnLogger::SetMask(CMN_LOG_ALLOW_ALL);
+    cmnLogger::SetMaskFunction(CMN_LOG_ALLOW_ALL);
+
+    const std::string fileName = "osaAsynchronousLoggerTest.bin";
+    osaAsynchronousLogger logger;
+    CPPUNIT_ASSERT(logger.OpenBinaryFile(fileName));
+    CPPUNIT_ASSERT(logger.IsBinaryFileOpen());
+    // the logger is only used once running
+    CPPUNIT_ASSERT(cmnLogger::GetBinarySink() == 0);
+    CPPUNIT_ASSERT(logger.Start(&frontEnd));
+    CPPUNIT_ASSERT(cmnLogger::GetBinarySink() == &logger);
+
+    const size_t numberOfMessages = 10;
+    for (size_t index = 0; index < numberOfMessages; ++index) {
+        CMN_LOG_BINARY(CMN_LOG_LEVEL_RUN_VERBOSE, "message %d of %d: %s", index, numberOfMessages, "binary");
+        // text messages still go to the channels
+        cmnLODOutputMultiplexer(&frontEnd, CMN_LOG_LEVEL_RUN_ERROR).Ref() << "text " << index << std::endl;
+    }
+    CMN_LOG_BINARY(CMN_LOG_LEVEL_RUN_ERROR, "done");
+    logger.Stop();
+    CPPUNIT_ASSERT(cmnLogger::GetBinarySink() == 0);
+    // not running, ignored
+    CMN_LOG_BINARY(CMN_LOG_LEVEL_RUN_ERROR, "ignored");
+    logger.CloseBinaryFile();
+    CPPUNIT_ASSERT(!logger.IsBinaryFileOpen());
+    cmnLogger::SetMask(previousMask);
+    cmnLogger::SetMaskFunction(previousMaskFunction);
+
+    std::string text;
+    size_t numberOfLines = 0;
+    while (std::getline(output, text)) {
+        numberOfLines++;
+    }
+    CPPUNIT_ASSERT_EQUAL(numberOfMessages, numberOfLines);
+
+    std::ifstream input(fileName.c_str(), std::ios::in | std::ios::binary);
+    CPPUNIT_ASSERT(input.is_open());
+    cmnLogBinaryDecoder decoder(input);
+    CPPUNIT_ASSERT(decoder.IsValid());
+    cmnLogBinaryDecoder::Message message;
+    double previousTime = 0.0;
+    for (size_t index = 0; index < numberOfMessages; ++index) {
+        CPPUNIT_ASSERT(decoder.Next(message));
+        std::stringstream expected;
+        expected << "message " << index << " of " << numberOfMessages << ": binary";
+        CPPUNIT_ASSERT_EQUAL(expected.str(), message.Text);
+        CPPUNIT_ASSERT_EQUAL(CMN_LOG_LEVEL_RUN_VERBOSE, message.Level);
+        CPPUNIT_ASSERT(message.File.find("osaAsynchronousLoggerTest.cpp") != std::string::npos);
+        CPPUNIT_ASSERT(message.Time >= previousTime);
+        previousTime = message.Time;
+    }
+    const unsigned int thread = message.Thread;
+    CPPUNIT_ASSERT(decoder.Next(message));
+    CPPUNIT_ASSERT_EQUAL(std::string("done"), message.Text);
+    CPPUNIT_ASSERT_EQUAL(thread, message.Thread);
+    CPPUNIT_ASSERT(!decoder.Next(message));
+    CPPUNIT_ASSERT(decoder.GetError().empty());
+    input.close();
+    std::remove(fileName.c_str());
+}
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(osaAsynchronousLoggerTest);
@@ -0,0 +1,54 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class osaAsynchronousLoggerTest: public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(osaAsynchronousLoggerTest);
+    {
+        CPPUNIT_TEST(TestStartStop);
+        CPPUNIT_TEST(TestMasks);
+        CPPUNIT_TEST(TestThreads);
+        CPPUNIT_TEST(TestOverflow);
+        CPPUNIT_TEST(TestBinary);
+    }
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp(void) {
+    }
+
+    void tearDown(void) {
+    }
+
+    /*! Channels are moved to the logger and back */
+    void TestStartStop(void);
+
+    /*! Channel masks are applied when records are written */
+    void TestMasks(void);
+
+    /*! Lines from multiple threads are written whole and in order */
+    void TestThreads(void);
+
+    /*! Records are dropped and counted when a buffer is full */
+    void TestOverflow(void);
+
+    /*! Binary messages are written to the binary file */
+    void TestBinary(void);
+};
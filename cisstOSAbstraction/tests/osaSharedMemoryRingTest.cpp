@@ -0,0 +1,190 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cisstCommon/cmnUnits.h>
+#include <cisstOSAbstraction/osaGetTime.h>
+#include <cisstOSAbstraction/osaThread.h>
+
+#include "osaSharedMemoryRingTest.h"
+
+#include <cisstOSAbstraction/osaSharedMemoryRing.h>
+
+#include <sstream>
+#include <string.h>
+
+
+static std::string osaSharedMemoryRingTestName(const std::string & suffix)
+{
+    std::stringstream name;
+    name << "osaSharedMemoryRingTest" << suffix << static_cast<long long>(osaGetTime() * 1.0e6);
+    return name.str();
+}
+
+
+void osaSharedMemoryRingTest::TestSendReceive(void)
+{
+    if (!osaSharedMemoryRing::IsSupported()) {
+        return;
+    }
+    osaSharedMemoryRing reader, writer;
+    CPPUNIT_ASSERT(reader.Create(osaSharedMemoryRingTestName("SendReceive"), 256));
+    CPPUNIT_ASSERT(writer.Open(reader.GetName()));
+    CPPUNIT_ASSERT(reader.IsOpen());
+    CPPUNIT_ASSERT(writer.IsOpen());
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(120), writer.GetMaximumMessageSize());
+    CPPUNIT_ASSERT(!writer.Send("x", writer.GetMaximumMessageSize() + 1));
+
+    // messages of different sizes so some wrap around
+    std::string received;
+    for (size_t index = 0; index < 100; ++index) {
+        const std::string message(index % 97, static_cast<char>('a' + index % 26));
+        CPPUNIT_ASSERT(writer.Send(message.data(), message.size()));
+        CPPUNIT_ASSERT(reader.Receive(received));
+        CPPUNIT_ASSERT(received == message);
+    }
+
+    // the segment can't be opened once closed by its creator
+    const std::string name = reader.GetName();
+    reader.Close();
+    CPPUNIT_ASSERT(!reader.IsOpen());
+    osaSharedMemoryRing other;
+    CPPUNIT_ASSERT(!other.Open(name));
+}
+
+
+void osaSharedMemoryRingTest::TestReserveCommit(void)
+{
+    if (!osaSharedMemoryRing::IsSupported()) {
+        return;
+    }
+    osaSharedMemoryRing reader, writer;
+    CPPUNIT_ASSERT(reader.Create(osaSharedMemoryRingTestName("ReserveCommit"), 1024));
+    CPPUNIT_ASSERT(writer.Open(reader.GetName()));
+
+    // reserve more than needed and commit the actual size
+    char * buffer = writer.Reserve(100);
+    CPPUNIT_ASSERT(buffer);
+    strcpy(buffer, "in place");
+    writer.Commit(strlen("in place"));
+
+    size_t length = 0;
+    const char * data = reader.Peek(length);
+    CPPUNIT_ASSERT(data);
+    CPPUNIT_ASSERT_EQUAL(strlen("in place"), length);
+    CPPUNIT_ASSERT(memcmp(data, "in place", length) == 0);
+    // the message stays until released
+    CPPUNIT_ASSERT(reader.Peek(length) == data);
+    reader.Release();
+    CPPUNIT_ASSERT(!reader.Peek(length));
+
+    // cancelled messages are not published
+    buffer = writer.Reserve(100);
+    CPPUNIT_ASSERT(buffer);
+    writer.Cancel();
+    CPPUNIT_ASSERT(!reader.Peek(length));
+    CPPUNIT_ASSERT(writer.Send("next", 4));
+    CPPUNIT_ASSERT(reader.Peek(length));
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(4), length);
+    reader.Release();
+
+    CPPUNIT_ASSERT(osaSharedMemoryRing::GetUniqueName("ring") != osaSharedMemoryRing::GetUniqueName("ring"));
+}
+
+
+void osaSharedMemoryRingTest::TestTimeouts(void)
+{
+    if (!osaSharedMemoryRing::IsSupported()) {
+        return;
+    }
+    osaSharedMemoryRing reader, writer;
+    CPPUNIT_ASSERT(reader.Create(osaSharedMemoryRingTestName("Timeouts"), 256));
+    CPPUNIT_ASSERT(writer.Open(reader.GetName()));
+
+    std::string received;
+    double start = osaGetTime();
+    CPPUNIT_ASSERT(!reader.Receive(received, 20.0 * cmn_ms));
+    CPPUNIT_ASSERT(osaGetTime() - start >= 15.0 * cmn_ms);
+
+    // fill the ring
+    const std::string message(100, 'm');
+    size_t sent = 0;
+    while (writer.Send(message.data(), message.size())) {
+        sent++;
+        CPPUNIT_ASSERT(sent < 10);
+    }
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(2), sent);
+    start = osaGetTime();
+    CPPUNIT_ASSERT(!writer.Send(message.data(), message.size(), 20.0 * cmn_ms));
+    CPPUNIT_ASSERT(osaGetTime() - start >= 15.0 * cmn_ms);
+
+    // space is available once a message is read
+    CPPUNIT_ASSERT(reader.Receive(received));
+    CPPUNIT_ASSERT(writer.Send(message.data(), message.size()));
+}
+
+
+class osaSharedMemoryRingTestWriter {
+public:
+    std::string Name;
+    size_t NumberOfMessages;
+    void * Run(int CMN_UNUSED(data)) {
+        osaSharedMemoryRing writer;
+        if (!writer.Open(this->Name)) {
+            return 0;
+        }
+        for (size_t index = 0; index < this->NumberOfMessages; ++index) {
+            if (!writer.Send(reinterpret_cast<const char *>(&index), sizeof(index), 5.0)) {
+                return 0;
+            }
+        }
+        return 0;
+    }
+};
+
+
+void osaSharedMemoryRingTest::TestThreads(void)
+{
+    if (!osaSharedMemoryRing::IsSupported()) {
+        return;
+    }
+    osaSharedMemoryRing reader;
+    CPPUNIT_ASSERT(reader.Create(osaSharedMemoryRingTestName("Threads"), 512));
+
+    osaSharedMemoryRingTestWriter writer;
+    writer.Name = reader.GetName();
+    writer.NumberOfMessages = 20000;
+    osaThread thread;
+    thread.Create<osaSharedMemoryRingTestWriter, int>(&writer, &osaSharedMemoryRingTestWriter::Run, 0);
+
+    size_t expected = 0;
+    size_t length;
+    const char * data;
+    while ((expected < writer.NumberOfMessages)
+           && ((data = reader.Peek(length, 5.0)) != 0)) {
+        CPPUNIT_ASSERT_EQUAL(sizeof(size_t), length);
+        size_t value;
+        memcpy(&value, data, sizeof(value));
+        CPPUNIT_ASSERT_EQUAL(expected, value);
+        reader.Release();
+        expected++;
+    }
+    thread.Wait();
+    CPPUNIT_ASSERT_EQUAL(writer.NumberOfMessages, expected);
+}
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(osaSharedMemoryRingTest);
@@ -0,0 +1,52 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class osaSharedMemoryRingTest: public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(osaSharedMemoryRingTest);
+    {
+        CPPUNIT_TEST(TestSendReceive);
+        CPPUNIT_TEST(TestReserveCommit);
+        CPPUNIT_TEST(TestTimeouts);
+        CPPUNIT_TEST(TestThreads);
+    }
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp(void) {
+    }
+
+    void tearDown(void) {
+    }
+
+    /*! Send and receive messages, including messages wrapping around
+      the end of the buffer */
+    void TestSendReceive(void);
+
+    /*! Write and read messages in place */
+    void TestReserveCommit(void);
+
+    /*! Check timeouts on empty and full rings */
+    void TestTimeouts(void);
+
+    /*! Send messages from one thread to another, the receiver blocks
+      on the doorbell */
+    void TestThreads(void);
+};
@@ -19,6 +19,8 @@ http://www.cisst.org/cisst/license.txt.
 
 #include <string.h>
 
+#include <cisstCommon/cmnDataBinaryWriter.h>
+
 #include <cisstOSAbstraction/osaSleep.h>
 #include <cisstOSAbstraction/osaSocket.h>
 #include <cisstOSAbstraction/osaSocketServer.h>
@@ -49,6 +51,21 @@ void osaSocketTest::TestUDP(void)
     bytes = serverSocket.Receive(buffer, sizeof(buffer));
     CPPUNIT_ASSERT_EQUAL(7, bytes);
     CPPUNIT_ASSERT(strcmp("testing", buffer) == 0);
+
+    // segments of a binary writer are sent in a single datagram
+    cmnDataBinaryWriter writer(16, 8);
+    const char referenced[] = "segments";
+    writer.Copy("testing ", 8);
+    writer.Reference(referenced, sizeof(referenced));
+    bytes = clientSocket.Send(writer);
+    CPPUNIT_ASSERT_EQUAL(17, bytes);
+
+    osaSleep(10.0 * cmn_ms);
+
+    buffer[0] = '\0';
+    bytes = serverSocket.Receive(buffer, sizeof(buffer));
+    CPPUNIT_ASSERT_EQUAL(17, bytes);
+    CPPUNIT_ASSERT(strcmp("testing segments", buffer) == 0);
 }
 
 
@@ -92,6 +109,20 @@ void osaSocketTest::TestTCP(void)
     CPPUNIT_ASSERT_EQUAL(7, bytes);
     CPPUNIT_ASSERT(strcmp("testing", buffer) == 0);
 
+    cmnDataBinaryWriter writer(16, 8);
+    const char referenced[] = "segments";
+    writer.Copy("testing ", 8);
+    writer.Reference(referenced, sizeof(referenced));
+    bytes = clientSocket.Send(writer);
+    CPPUNIT_ASSERT_EQUAL(17, bytes);
+
+    osaSleep(10.0 * cmn_ms);
+
+    buffer[0] = '\0';
+    bytes = serverSocket->Receive(buffer, sizeof(buffer));
+    CPPUNIT_ASSERT_EQUAL(17, bytes);
+    CPPUNIT_ASSERT(strcmp("testing segments", buffer) == 0);
+
 //    clientSocket.Close();
 //
 //    osaSleep(1.0 * cmn_s);
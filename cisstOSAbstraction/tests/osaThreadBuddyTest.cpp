@@ -0,0 +1,136 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include "osaThreadBuddyTest.h"
+
+#include <cisstCommon/cmnUnits.h>
+#include <cisstOSAbstraction/osaThreadBuddy.h>
+#include <cisstOSAbstraction/osaStopwatch.h>
+#include <cisstOSAbstraction/osaSleep.h>
+
+
+void osaThreadBuddyTest::TestNoDrift(void)
+{
+#if (CISST_OS == CISST_LINUX)
+    const double period = 10.0 * cmn_ms;
+    const unsigned int nbPeriods = 20;
+    osaThreadBuddy buddy;
+    buddy.Create("TBDrft", period / cmn_ns);
+    osaStopwatch timer;
+    timer.Reset();
+    timer.Start();
+    for (unsigned int index = 0; index < nbPeriods; index++) {
+        // simulate some computation, less than a period
+        osaSleep(3.0 * cmn_ms);
+        buddy.WaitForRemainingPeriod();
+    }
+    timer.Stop();
+    // with deadlines relative to the last wake up, each period would
+    // be extended by the wake up latency
+    CPPUNIT_ASSERT_DOUBLES_EQUAL(nbPeriods * period, timer.GetElapsedTime(), 2.0 * period);
+    CPPUNIT_ASSERT(timer.GetElapsedTime() >= (nbPeriods - 1) * period);
+    buddy.Delete();
+#endif
+}
+
+
+void osaThreadBuddyTest::TestCatchUpSkip(void)
+{
+#if (CISST_OS == CISST_LINUX)
+    const double period = 10.0 * cmn_ms;
+    osaThreadBuddy buddy;
+    CPPUNIT_ASSERT_EQUAL(osaThreadBuddy::CATCH_UP_SKIP, buddy.GetCatchUpPolicy());
+    buddy.Create("TBSkip", period / cmn_ns);
+    buddy.WaitForRemainingPeriod();
+    CPPUNIT_ASSERT_EQUAL(0ull, buddy.GetNumberOfOverruns());
+    // miss 2 deadlines
+    osaSleep(2.5 * period);
+    osaStopwatch timer;
+    timer.Reset();
+    timer.Start();
+    buddy.WaitForRemainingPeriod();
+    timer.Stop();
+    CPPUNIT_ASSERT_EQUAL(1ull, buddy.GetNumberOfOverruns());
+    CPPUNIT_ASSERT(buddy.GetNumberOfSkippedPeriods() >= 2);
+    CPPUNIT_ASSERT(buddy.GetMaximumLateness() >= 1.0 * period);
+    // waited for the next deadline
+    CPPUNIT_ASSERT(timer.GetElapsedTime() < period);
+    buddy.ResetOverrunCounters();
+    CPPUNIT_ASSERT_EQUAL(0ull, buddy.GetNumberOfOverruns());
+    CPPUNIT_ASSERT_EQUAL(0ull, buddy.GetNumberOfSkippedPeriods());
+    buddy.Delete();
+#endif
+}
+
+
+void osaThreadBuddyTest::TestCatchUpBurst(void)
+{
+#if (CISST_OS == CISST_LINUX)
+    const double period = 10.0 * cmn_ms;
+    osaThreadBuddy buddy;
+    buddy.SetCatchUpPolicy(osaThreadBuddy::CATCH_UP_BURST);
+    buddy.Create("TBBrst", period / cmn_ns);
+    buddy.WaitForRemainingPeriod();
+    osaSleep(3.5 * period);
+    // next 3 periods are late and shouldn't wait
+    osaStopwatch timer;
+    timer.Reset();
+    timer.Start();
+    buddy.WaitForRemainingPeriod();
+    buddy.WaitForRemainingPeriod();
+    buddy.WaitForRemainingPeriod();
+    timer.Stop();
+    CPPUNIT_ASSERT(timer.GetElapsedTime() < 0.5 * period);
+    CPPUNIT_ASSERT_EQUAL(3ull, buddy.GetNumberOfOverruns());
+    CPPUNIT_ASSERT_EQUAL(0ull, buddy.GetNumberOfSkippedPeriods());
+    // back on schedule, waits for the following deadline
+    buddy.WaitForRemainingPeriod();
+    buddy.Delete();
+#endif
+}
+
+
+void osaThreadBuddyTest::TestCatchUpRealign(void)
+{
+#if (CISST_OS == CISST_LINUX)
+    const double period = 10.0 * cmn_ms;
+    osaThreadBuddy buddy;
+    buddy.SetCatchUpPolicy(osaThreadBuddy::CATCH_UP_REALIGN);
+    buddy.Create("TBRlgn", period / cmn_ns);
+    buddy.WaitForRemainingPeriod();
+    osaSleep(2.5 * period);
+    osaStopwatch timer;
+    timer.Reset();
+    timer.Start();
+    // late, returns right away
+    buddy.WaitForRemainingPeriod();
+    timer.Stop();
+    CPPUNIT_ASSERT(timer.GetElapsedTime() < 0.5 * period);
+    CPPUNIT_ASSERT_EQUAL(1ull, buddy.GetNumberOfOverruns());
+    // new phase, next call waits for a full period
+    timer.Reset();
+    timer.Start();
+    buddy.WaitForRemainingPeriod();
+    timer.Stop();
+    CPPUNIT_ASSERT(timer.GetElapsedTime() >= 0.9 * period);
+    CPPUNIT_ASSERT_EQUAL(1ull, buddy.GetNumberOfOverruns());
+    buddy.Delete();
+#endif
+}
+
+
+CPPUNIT_TEST_SUITE_REGISTRATION(osaThreadBuddyTest);
@@ -0,0 +1,51 @@
+/* -*- Mode: C++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*-    */
+/* ex: set filetype=cpp softtabstop=4 shiftwidth=4 tabstop=4 cindent expandtab: */
+
+/*
+  Created on: 2026-10-18
+
+  (C) Copyright 2026 Johns Hopkins University (JHU), All Rights Reserved.
+
+--- begin cisst license - do not edit ---
+
+This software is provided "as is" under an open source license, with
+no warranty.  The complete license can be found in license.txt and
+http://www.cisst.org/cisst/license.txt.
+
+--- end cisst license ---
+*/
+
+#include <cppunit/TestCase.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class osaThreadBuddyTest: public CppUnit::TestFixture
+{
+    CPPUNIT_TEST_SUITE(osaThreadBuddyTest);
+    {
+        CPPUNIT_TEST(TestNoDrift);
+        CPPUNIT_TEST(TestCatchUpSkip);
+        CPPUNIT_TEST(TestCatchUpBurst);
+        CPPUNIT_TEST(TestCatchUpRealign);
+    }
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+    void setUp(void) {
+    }
+
+    void tearDown(void) {
+    }
+
+    /*! Check that time spent in the loop doesn't delay following
+      periods */
+    void TestNoDrift(void);
+
+    /*! Check overrun counters and skip policy */
+    void TestCatchUpSkip(void);
+
+    /*! Check burst policy */
+    void TestCatchUpBurst(void);
+
+    /*! Check realign policy */
+    void TestCatchUpRealign(void);
+};
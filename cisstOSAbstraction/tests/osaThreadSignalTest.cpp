@@ -126,4 +126,67 @@ void osaThreadSignalTest::TestWaitBlocks(void) {
 }
 
 
+void osaThreadSignalTest::TestRaiseBeforeWait(void) {
+    osaThreadSignal threadSignal;
+    threadSignal.Raise();
+    CPPUNIT_ASSERT(threadSignal.Wait(1.0 * cmn_s));
+    // signal has been reset by previous wait
+    CPPUNIT_ASSERT(!threadSignal.Wait(10.0 * cmn_ms));
+    // multiple raises without waiter are not accumulated
+    threadSignal.Raise();
+    threadSignal.Raise();
+    CPPUNIT_ASSERT(threadSignal.Wait(1.0 * cmn_s));
+    CPPUNIT_ASSERT(!threadSignal.Wait(10.0 * cmn_ms));
+}
+
+
+void osaThreadSignalTest::TestWaitTimeout(void) {
+    osaThreadSignal threadSignal;
+    osaStopwatch timer;
+    const double timeout = 50.0 * cmn_ms;
+    timer.Reset();
+    timer.Start();
+    CPPUNIT_ASSERT(!threadSignal.Wait(timeout));
+    timer.Stop();
+    CPPUNIT_ASSERT(timer.GetElapsedTime() >= 0.9 * timeout);
+    CPPUNIT_ASSERT(timer.GetElapsedTime() < 10.0 * timeout);
+}
+
+
+class ThreadSignalRaiseHolder {
+public:
+    void * Method(osaThreadSignal * threadSignal) {
+        osaSleep(50.0 * cmn_ms);
+        threadSignal->Raise();
+        return 0;
+    }
+};
+
+
+void osaThreadSignalTest::TestCounters(void) {
+    osaThreadSignal threadSignal;
+    threadSignal.SetSpinCount(0);
+    CPPUNIT_ASSERT_EQUAL(0u, threadSignal.GetSpinCount());
+
+    // timeout, thread sleeps but is not woken up
+    CPPUNIT_ASSERT(!threadSignal.Wait(10.0 * cmn_ms));
+    CPPUNIT_ASSERT_EQUAL(0ull, threadSignal.GetNumberOfSpins());
+    CPPUNIT_ASSERT(threadSignal.GetNumberOfSleeps() >= 1);
+    CPPUNIT_ASSERT_EQUAL(0ull, threadSignal.GetNumberOfWakeups());
+
+    // raised by another thread while blocked
+    threadSignal.ResetCounters();
+    CPPUNIT_ASSERT_EQUAL(0ull, threadSignal.GetNumberOfSleeps());
+    ThreadSignalRaiseHolder holder;
+    osaThread thread;
+    thread.Create<ThreadSignalRaiseHolder, osaThreadSignal *>(&holder, &ThreadSignalRaiseHolder::Method,
+                                                              &threadSignal, "raise");
+    CPPUNIT_ASSERT(threadSignal.Wait(5.0 * cmn_s));
+    thread.Wait();
+    CPPUNIT_ASSERT_EQUAL(0ull, threadSignal.GetNumberOfSpins());
+    CPPUNIT_ASSERT(threadSignal.GetNumberOfSleeps() >= 1);
+    CPPUNIT_ASSERT_EQUAL(1ull, threadSignal.GetNumberOfWakeups());
+}
+
+
 CPPUNIT_TEST_SUITE_REGISTRATION(osaThreadSignalTest);
@@ -26,6 +26,9 @@ class osaThreadSignalTest: public CppUnit::TestFixture
     CPPUNIT_TEST_SUITE(osaThreadSignalTest);
     {
         CPPUNIT_TEST(TestWaitBlocks);
+        CPPUNIT_TEST(TestRaiseBeforeWait);
+        CPPUNIT_TEST(TestWaitTimeout);
+        CPPUNIT_TEST(TestCounters);
     }
     CPPUNIT_TEST_SUITE_END();
 
@@ -38,4 +41,14 @@ public:
 
     /*! Check that waits do block */
     void TestWaitBlocks(void);
+
+    /*! Check that a signal raised before waiting is not lost and is
+      reset by the wait */
+    void TestRaiseBeforeWait(void);
+
+    /*! Check that timed waits return false after the timeout */
+    void TestWaitTimeout(void);
+
+    /*! Check spins, sleeps and wakeups counters */
+    void TestCounters(void);
 };
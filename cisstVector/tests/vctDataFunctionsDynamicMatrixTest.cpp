@@ -22,6 +22,7 @@ http://www.cisst.org/cisst/license.txt.
 #include "vctDataFunctionsDynamicMatrixTest.h"
 
 #include <cisstCommon/cmnDataFunctionsString.h>
+#include <cisstCommon/cmnDataBinaryWriter.h>
 
 #include <cisstVector/vctDynamicMatrix.h>
 #include <cisstVector/vctDataFunctionsDynamicMatrix.h>
@@ -56,6 +57,44 @@ void vctDataFunctionsDynamicMatrixTest::TestBinarySerializationStream(void)
 }
 
 
+void vctDataFunctionsDynamicMatrixTest::TestBinarySerializationWriter(void)
+{
+    typedef vctDynamicMatrix<double> DataType;
+    DataType rowMajor(12, 23, VCT_ROW_MAJOR);
+    DataType columnMajor(12, 23, VCT_COL_MAJOR);
+    vctRandom(rowMajor, -10.0, 10.0);
+    columnMajor.Assign(rowMajor);
+
+    std::stringstream stream;
+    cmnData<DataType>::SerializeBinary(rowMajor, stream);
+    const std::string expected = stream.str();
+
+    // compact row major, memory is referenced
+    cmnDataBinaryWriter writer;
+    writer.SerializeBinary(rowMajor);
+    std::string result;
+    writer.ToString(result);
+    CPPUNIT_ASSERT_EQUAL(expected, result);
+    CPPUNIT_ASSERT_EQUAL(rowMajor.size() * sizeof(double), writer.GetReferencedSize());
+
+    // column major, elements are copied
+    writer.Reset();
+    writer.SerializeBinary(columnMajor);
+    writer.ToString(result);
+    CPPUNIT_ASSERT_EQUAL(expected, result);
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), writer.GetReferencedSize());
+
+    // buffer
+    const size_t size = cmnData<DataType>::SerializeBinaryByteSize(columnMajor);
+    CPPUNIT_ASSERT_EQUAL(expected.size(), size);
+    std::string buffer(size, ' ');
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0),
+                         cmnData<DataType>::SerializeBinary(columnMajor, &(buffer[0]), size - 1));
+    CPPUNIT_ASSERT_EQUAL(size, cmnData<DataType>::SerializeBinary(columnMajor, &(buffer[0]), size));
+    CPPUNIT_ASSERT_EQUAL(expected, buffer);
+}
+
+
 void vctDataFunctionsDynamicMatrixTest::TestTextSerializationStream(void)
 {
     std::stringstream stream;
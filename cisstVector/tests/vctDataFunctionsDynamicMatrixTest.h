@@ -28,6 +28,7 @@ class vctDataFunctionsDynamicMatrixTest : public CppUnit::TestFixture
     {
         CPPUNIT_TEST(TestDataCopy);
         CPPUNIT_TEST(TestBinarySerializationStream);
+        CPPUNIT_TEST(TestBinarySerializationWriter);
         CPPUNIT_TEST(TestTextSerializationStream);
         CPPUNIT_TEST(TestScalar);
     }
@@ -42,6 +43,7 @@ class vctDataFunctionsDynamicMatrixTest : public CppUnit::TestFixture
 
     void TestDataCopy(void);
     void TestBinarySerializationStream(void);
+    void TestBinarySerializationWriter(void);
     void TestTextSerializationStream(void);
     void TestScalar(void);
 };
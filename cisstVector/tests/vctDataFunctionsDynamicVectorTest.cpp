@@ -21,9 +21,12 @@ http://www.cisst.org/cisst/license.txt.
 #include "vctDataFunctionsDynamicVectorTest.h"
 
 #include <cisstCommon/cmnDataFunctionsString.h>
+#include <cisstCommon/cmnDataBinaryWriter.h>
 
 #include <cisstVector/vctDynamicVector.h>
 #include <cisstVector/vctDataFunctionsDynamicVector.h>
+#include <cisstVector/vctFixedSizeVector.h>
+#include <cisstVector/vctDataFunctionsFixedSizeVector.h>
 #include <cisstVector/vctRandomDynamicVector.h>
 
 void vctDataFunctionsDynamicVectorTest::TestDataCopy(void)
@@ -57,6 +60,41 @@ void vctDataFunctionsDynamicVectorTest::TestBinarySerializationStream(void)
 }
 
 
+void vctDataFunctionsDynamicVectorTest::TestBinarySerializationWriter(void)
+{
+    typedef vctDynamicVector<double> DataType;
+    DataType v1(100);
+    vctRandom(v1, -10.0, 10.0);
+    vctFixedSizeVector<double, 3> v2(1.0, 2.0, 3.0);
+    vctDynamicVector<std::string> v3(2);
+    v3[0] = "zero";
+    v3[1] = "one";
+
+    std::stringstream stream;
+    cmnData<DataType>::SerializeBinary(v1, stream);
+    cmnData<vctFixedSizeVector<double, 3> >::SerializeBinary(v2, stream);
+    cmnData<vctDynamicVector<std::string> >::SerializeBinary(v3, stream);
+
+    cmnDataBinaryWriter writer;
+    writer.SerializeBinary(v1);
+    writer.SerializeBinary(v2);
+    writer.SerializeBinary(v3);
+    std::string result;
+    writer.ToString(result);
+    CPPUNIT_ASSERT_EQUAL(stream.str(), result);
+    // only the first vector is large enough to be referenced
+    CPPUNIT_ASSERT_EQUAL(v1.size() * sizeof(double), writer.GetReferencedSize());
+
+    // buffer
+    const size_t size = cmnData<DataType>::SerializeBinaryByteSize(v1);
+    CPPUNIT_ASSERT_EQUAL(sizeof(size_t) + v1.size() * sizeof(double), size);
+    std::string buffer(size, ' ');
+    CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), cmnData<DataType>::SerializeBinary(v1, &(buffer[0]), size - 1));
+    CPPUNIT_ASSERT_EQUAL(size, cmnData<DataType>::SerializeBinary(v1, &(buffer[0]), size));
+    CPPUNIT_ASSERT_EQUAL(result.substr(0, size), buffer);
+}
+
+
 void vctDataFunctionsDynamicVectorTest::TestTextSerializationStream(void)
 {
     std::stringstream stream;
@@ -5,7 +5,7 @@
   Author(s):  Anton Deguet
   Created on: 2012-07-09
 
-  (C) Copyright 2012-2018 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2012-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -24,6 +24,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstCommon/cmnDataFunctions.h>
 #include <cisstVector/vctDynamicMatrixBase.h>
 #include <cisstCommon/cmnDataFunctionsMatrixHelpers.h>
+#include <cisstCommon/cmnDataBinaryWriter.h>
 
 #if CISST_HAS_JSON
 #include <cisstVector/vctDataFunctionsDynamicMatrixJSON.h>
@@ -58,6 +59,25 @@ public:
         cmnDataMatrixSerializeBinary(data, outputStream);
     }
 
+    static size_t SerializeBinaryByteSize(const DataType & data)
+    {
+        return cmnData<size_t>::SerializeBinaryByteSize(data.rows())
+            + cmnData<size_t>::SerializeBinaryByteSize(data.cols())
+            + cmnDataMatrixSerializeBinaryByteSize(data);
+    }
+
+    static size_t SerializeBinary(const DataType & data, char * buffer, size_t bufferSize)
+    {
+        if (bufferSize < SerializeBinaryByteSize(data)) {
+            return 0;
+        }
+        const vct::size_type myRows = data.rows();
+        const vct::size_type myCols = data.cols();
+        size_t result = cmnData<size_t>::SerializeBinary(myRows, buffer, bufferSize);
+        result += cmnData<size_t>::SerializeBinary(myCols, buffer + result, bufferSize - result);
+        return result + cmnDataMatrixSerializeBinary(data, buffer + result, bufferSize - result);
+    }
+
     static void DeSerializeBinary(DataType & data, std::istream & inputStream,
                                   const cmnDataFormat & localFormat, const cmnDataFormat & remoteFormat)
         CISST_THROW(std::runtime_error)
@@ -114,6 +134,23 @@ public:
     }
 };
 
+// the memory of compact row major matrices of native types is referenced
+template <typename _elementType>
+class cmnDataBinaryGather<vctDynamicMatrix<_elementType> >
+{
+public:
+    typedef vctDynamicMatrix<_elementType> DataType;
+    static void SerializeBinary(cmnDataBinaryWriter & writer, const DataType & data) {
+        const vct::size_type myRows = data.rows();
+        const vct::size_type myCols = data.cols();
+        cmnDataBinaryGather<size_t>::SerializeBinary(writer, myRows);
+        cmnDataBinaryGather<size_t>::SerializeBinary(writer, myCols);
+        const bool contiguous = data.IsCompact() && data.IsRowMajor() && (data.size() > 0);
+        cmnDataBinaryGatherElements<_elementType>::SerializeBinary(writer, data.begin(), data.end(),
+                                                                   contiguous ? data.Pointer() : 0);
+    }
+};
+
 // ---------------------- older functions, to be deprecated
 template <typename _elementType>
 inline void cmnDeSerializeRaw(std::istream & inputStream,
@@ -5,7 +5,7 @@
   Author(s):  Anton Deguet
   Created on: 2012-07-09
 
-  (C) Copyright 2012-2018 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2012-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -24,6 +24,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstCommon/cmnDataFunctions.h>
 #include <cisstVector/vctDynamicVectorBase.h>
 #include <cisstCommon/cmnDataFunctionsVectorHelpers.h>
+#include <cisstCommon/cmnDataBinaryWriter.h>
 
 #if CISST_HAS_JSON
 #include <cisstVector/vctDataFunctionsDynamicVectorJSON.h>
@@ -57,6 +58,22 @@ public:
         cmnDataVectorSerializeBinary(data, outputStream);
     }
 
+    static size_t SerializeBinaryByteSize(const DataType & data)
+    {
+        return cmnData<size_t>::SerializeBinaryByteSize(data.size())
+            + cmnDataVectorSerializeBinaryByteSize(data);
+    }
+
+    static size_t SerializeBinary(const DataType & data, char * buffer, size_t bufferSize)
+    {
+        if (bufferSize < SerializeBinaryByteSize(data)) {
+            return 0;
+        }
+        const vct::size_type mySize = data.size();
+        const size_t sizeOfSize = cmnData<size_t>::SerializeBinary(mySize, buffer, bufferSize);
+        return sizeOfSize + cmnDataVectorSerializeBinary(data, buffer + sizeOfSize, bufferSize - sizeOfSize);
+    }
+
     static void DeSerializeBinary(DataType & data,
                                   std::istream & inputStream,
                                   const cmnDataFormat & localFormat,
@@ -124,6 +141,20 @@ public:
     }
 };
 
+// the memory of compact vectors of native types is referenced
+template <typename _elementType>
+class cmnDataBinaryGather<vctDynamicVector<_elementType> >
+{
+public:
+    typedef vctDynamicVector<_elementType> DataType;
+    static void SerializeBinary(cmnDataBinaryWriter & writer, const DataType & data) {
+        const vct::size_type mySize = data.size();
+        cmnDataBinaryGather<size_t>::SerializeBinary(writer, mySize);
+        cmnDataBinaryGatherElements<_elementType>::SerializeBinary(writer, data.begin(), data.end(),
+                                                                   (data.IsCompact() && (mySize > 0)) ? data.Pointer() : 0);
+    }
+};
+
 // ---------------------- older functions, to be deprecated
 template <typename _elementType>
 inline void cmnDeSerializeRaw(std::istream & inputStream,
@@ -5,7 +5,7 @@
   Author(s):  Anton Deguet
   Created on: 2012-07-09
 
-  (C) Copyright 2012-2018 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2012-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -24,6 +24,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstCommon/cmnDataFunctions.h>
 #include <cisstVector/vctFixedSizeMatrixBase.h>
 #include <cisstCommon/cmnDataFunctionsMatrixHelpers.h>
+#include <cisstCommon/cmnDataBinaryWriter.h>
 
 #if CISST_HAS_JSON
 #include <cisstVector/vctDataFunctionsFixedSizeMatrixJSON.h>
@@ -53,6 +54,19 @@ public:
         cmnDataMatrixSerializeBinary(data, outputStream);
     }
 
+    static size_t SerializeBinaryByteSize(const DataType & data)
+    {
+        return cmnDataMatrixSerializeBinaryByteSize(data);
+    }
+
+    static size_t SerializeBinary(const DataType & data, char * buffer, size_t bufferSize)
+    {
+        if (bufferSize < SerializeBinaryByteSize(data)) {
+            return 0;
+        }
+        return cmnDataMatrixSerializeBinary(data, buffer, bufferSize);
+    }
+
     static void DeSerializeBinary(DataType & data,
                                   std::istream & inputStream,
                                   const cmnDataFormat & localFormat,
@@ -110,6 +124,52 @@ public:
     }
 };
 
+// the memory of row major matrices of native types is referenced
+template <class _elementType, vct::size_type _rows, vct::size_type _cols, bool _rowMajor>
+class cmnDataBinaryGather<vctFixedSizeMatrix<_elementType, _rows, _cols, _rowMajor> >
+{
+public:
+    typedef vctFixedSizeMatrix<_elementType, _rows, _cols, _rowMajor> DataType;
+    static void SerializeBinary(cmnDataBinaryWriter & writer, const DataType & data) {
+        cmnDataBinaryGatherElements<_elementType>::SerializeBinary(writer, data.begin(), data.end(),
+                                                                   _rowMajor ? data.Pointer() : 0);
+    }
+};
+
+// elements are serialized in row major order
+template <class _elementType, vct::size_type _rows, vct::size_type _cols, bool _rowMajor>
+class cmnDataBinaryFixedSize<vctFixedSizeMatrix<_elementType, _rows, _cols, _rowMajor> >
+{
+public:
+    typedef vctFixedSizeMatrix<_elementType, _rows, _cols, _rowMajor> DataType;
+    enum {IS_FIXED = cmnDataBinaryFixedSize<_elementType>::IS_FIXED};
+    enum {BYTE_SIZE = _rows * _cols * cmnDataBinaryFixedSize<_elementType>::BYTE_SIZE};
+
+    static char * SerializeBinary(const DataType & data, char * buffer) {
+        if (_rowMajor) {
+            return cmnDataBinaryFixedSizeElements<_elementType>::SerializeBinary(data.Pointer(), _rows * _cols, buffer);
+        }
+        for (vct::size_type row = 0; row < _rows; ++row) {
+            for (vct::size_type col = 0; col < _cols; ++col) {
+                buffer = cmnDataBinaryFixedSize<_elementType>::SerializeBinary(data.Element(row, col), buffer);
+            }
+        }
+        return buffer;
+    }
+
+    static const char * DeSerializeBinary(DataType & data, const char * buffer) {
+        if (_rowMajor) {
+            return cmnDataBinaryFixedSizeElements<_elementType>::DeSerializeBinary(data.Pointer(), _rows * _cols, buffer);
+        }
+        for (vct::size_type row = 0; row < _rows; ++row) {
+            for (vct::size_type col = 0; col < _cols; ++col) {
+                buffer = cmnDataBinaryFixedSize<_elementType>::DeSerializeBinary(data.Element(row, col), buffer);
+            }
+        }
+        return buffer;
+    }
+};
+
 // ---------------------- older functions, to be deprecated
 template <typename _elementType, vct::size_type _rows, vct::size_type _cols>
 inline void cmnDeSerializeRaw(std::istream & inputStream,
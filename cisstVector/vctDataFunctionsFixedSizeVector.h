@@ -5,7 +5,7 @@
   Author(s):  Anton Deguet
   Created on: 2012-07-09
 
-  (C) Copyright 2012-201 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2012-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -24,6 +24,7 @@ http://www.cisst.org/cisst/license.txt.
 #include <cisstCommon/cmnDataFunctions.h>
 #include <cisstVector/vctFixedSizeVectorBase.h>
 #include <cisstCommon/cmnDataFunctionsVectorHelpers.h>
+#include <cisstCommon/cmnDataBinaryWriter.h>
 
 #if CISST_HAS_JSON
 #include <cisstVector/vctDataFunctionsFixedSizeVectorJSON.h>
@@ -53,6 +54,19 @@ public:
         cmnDataVectorSerializeBinary(data, outputStream);
     }
 
+    static size_t SerializeBinaryByteSize(const DataType & data)
+    {
+        return cmnDataVectorSerializeBinaryByteSize(data);
+    }
+
+    static size_t SerializeBinary(const DataType & data, char * buffer, size_t bufferSize)
+    {
+        if (bufferSize < SerializeBinaryByteSize(data)) {
+            return 0;
+        }
+        return cmnDataVectorSerializeBinary(data, buffer, bufferSize);
+    }
+
     static void DeSerializeBinary(DataType & data, std::istream & inputStream,
                                   const cmnDataFormat & localFormat,
                                   const cmnDataFormat & remoteFormat)
@@ -105,6 +119,35 @@ public:
     }
 };
 
+// the memory of vectors of native types is referenced
+template <class _elementType, vct::size_type _size>
+class cmnDataBinaryGather<vctFixedSizeVector<_elementType, _size> >
+{
+public:
+    typedef vctFixedSizeVector<_elementType, _size> DataType;
+    static void SerializeBinary(cmnDataBinaryWriter & writer, const DataType & data) {
+        cmnDataBinaryGatherElements<_elementType>::SerializeBinary(writer, data.begin(), data.end(),
+                                                                   data.Pointer());
+    }
+};
+
+template <class _elementType, vct::size_type _size>
+class cmnDataBinaryFixedSize<vctFixedSizeVector<_elementType, _size> >
+{
+public:
+    typedef vctFixedSizeVector<_elementType, _size> DataType;
+    enum {IS_FIXED = cmnDataBinaryFixedSize<_elementType>::IS_FIXED};
+    enum {BYTE_SIZE = _size * cmnDataBinaryFixedSize<_elementType>::BYTE_SIZE};
+
+    static char * SerializeBinary(const DataType & data, char * buffer) {
+        return cmnDataBinaryFixedSizeElements<_elementType>::SerializeBinary(data.Pointer(), _size, buffer);
+    }
+
+    static const char * DeSerializeBinary(DataType & data, const char * buffer) {
+        return cmnDataBinaryFixedSizeElements<_elementType>::DeSerializeBinary(data.Pointer(), _size, buffer);
+    }
+};
+
 // ---------------------- older functions, to be deprecated
 template <typename _elementType, vct::size_type _size>
 inline void cmnDeSerializeRaw(std::istream & inputStream,
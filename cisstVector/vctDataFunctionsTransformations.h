@@ -5,7 +5,7 @@
   Author(s):  Anton Deguet
   Created on: 2012-07-09
 
-  (C) Copyright 2012-2018 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2012-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -128,6 +128,27 @@ public:
     }
 };
 
+template <class _rotationType>
+class cmnDataBinaryFixedSize<vctFrameBase<_rotationType> >
+{
+public:
+    typedef vctFrameBase<_rotationType> DataType;
+    typedef cmnDataBinaryFixedSize<typename DataType::TranslationType> TranslationFixedSize;
+    typedef cmnDataBinaryFixedSize<typename DataType::RotationType> RotationFixedSize;
+    enum {IS_FIXED = TranslationFixedSize::IS_FIXED && RotationFixedSize::IS_FIXED};
+    enum {BYTE_SIZE = TranslationFixedSize::BYTE_SIZE + RotationFixedSize::BYTE_SIZE};
+
+    static char * SerializeBinary(const DataType & data, char * buffer) {
+        buffer = TranslationFixedSize::SerializeBinary(data.Translation(), buffer);
+        return RotationFixedSize::SerializeBinary(data.Rotation(), buffer);
+    }
+
+    static const char * DeSerializeBinary(DataType & data, const char * buffer) {
+        buffer = TranslationFixedSize::DeSerializeBinary(data.Translation(), buffer);
+        return RotationFixedSize::DeSerializeBinary(data.Rotation(), buffer);
+    }
+};
+
 // pass through class for rotation matrix
 template <class _elementType, bool _rowMajor>
 class cmnData<vctMatrixRotation3<_elementType, _rowMajor> >
@@ -204,6 +225,24 @@ public:
     }
 };
 
+template <class _elementType, bool _rowMajor>
+class cmnDataBinaryFixedSize<vctMatrixRotation3<_elementType, _rowMajor> >
+{
+public:
+    typedef vctMatrixRotation3<_elementType, _rowMajor> DataType;
+    typedef cmnDataBinaryFixedSize<typename DataType::ContainerType> ContainerFixedSize;
+    enum {IS_FIXED = ContainerFixedSize::IS_FIXED};
+    enum {BYTE_SIZE = ContainerFixedSize::BYTE_SIZE};
+
+    static char * SerializeBinary(const DataType & data, char * buffer) {
+        return ContainerFixedSize::SerializeBinary(data, buffer);
+    }
+
+    static const char * DeSerializeBinary(DataType & data, const char * buffer) {
+        return ContainerFixedSize::DeSerializeBinary(data, buffer);
+    }
+};
+
 
 // pass through class for frame4x4
 template <class _elementType, bool _rowMajor>
@@ -281,4 +320,22 @@ public:
     }
 };
 
+template <class _elementType, bool _rowMajor>
+class cmnDataBinaryFixedSize<vctFrame4x4<_elementType, _rowMajor> >
+{
+public:
+    typedef vctFrame4x4<_elementType, _rowMajor> DataType;
+    typedef cmnDataBinaryFixedSize<typename DataType::ContainerType> ContainerFixedSize;
+    enum {IS_FIXED = ContainerFixedSize::IS_FIXED};
+    enum {BYTE_SIZE = ContainerFixedSize::BYTE_SIZE};
+
+    static char * SerializeBinary(const DataType & data, char * buffer) {
+        return ContainerFixedSize::SerializeBinary(data, buffer);
+    }
+
+    static const char * DeSerializeBinary(DataType & data, const char * buffer) {
+        return ContainerFixedSize::DeSerializeBinary(data, buffer);
+    }
+};
+
 #endif // _vctDataFunctionsTransformations_h
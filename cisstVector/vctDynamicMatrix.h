@@ -6,7 +6,7 @@
   Author(s):	Ofri Sadowsky, Anton Deguet
   Created on: 2004-07-01
 
-  (C) Copyright 2004-2007 Johns Hopkins University (JHU), All Rights
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights
   Reserved.
 
 --- begin cisst license - do not edit ---
@@ -270,6 +270,19 @@ public:
 		return *this;
     }
 
+    /*! Exchange the memory owned by this matrix with the memory owned
+      by another matrix.  No element is copied nor allocated, the
+      sizes and storage orders are exchanged as well. */
+    void SwapData(ThisType & other) {
+        const nsize_type sizes = this->sizes();
+        const bool rowMajor = this->StorageOrder();
+        pointer data = this->Matrix.Release();
+        const nsize_type otherSizes = other.sizes();
+        const bool otherRowMajor = other.StorageOrder();
+        this->Matrix.Own(otherSizes, otherRowMajor, other.Matrix.Release());
+        other.Matrix.Own(sizes, rowMajor, data);
+    }
+
     /*! Assignment from a fixed size matrix.  This operator will
       resize the left side dynamic matrix to match the right side
       fixed size matrix. */
@@ -5,7 +5,7 @@
   Author(s):  Ofri Sadowsky, Anton Deguet
   Created on: 2004-07-01
 
-  (C) Copyright 2004-2018 Johns Hopkins University (JHU), All Rights Reserved.
+  (C) Copyright 2004-2026 Johns Hopkins University (JHU), All Rights Reserved.
 
 --- begin cisst license - do not edit ---
 
@@ -258,6 +258,17 @@ public:
         return *this;
     }
 
+    /*! Exchange the memory owned by this vector with the memory owned
+      by another vector.  No element is copied nor allocated, the
+      sizes are exchanged as well. */
+    void SwapData(ThisType & other) {
+        const size_type size = this->size();
+        pointer data = this->Vector.Release();
+        const size_type otherSize = other.size();
+        this->Vector.Own(otherSize, other.Vector.Release());
+        other.Vector.Own(size, data);
+    }
+
     /*!  Assignement from a transitional vctReturnDynamicVector to a
       vctDynamicVector variable.  This specialized operation does not
       perform any element copy.  Instead it transfers ownership of the